@@ -0,0 +1,441 @@
+/*
+ * CANopen Emergency aggregator, non-standard.
+ *
+ * @file        CO_EMaggregator.c
+ * @ingroup     CO_EMaggregator
+ * @author      J-Weisberg
+ * @copyright   2026 J-Weisberg
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string.h>
+
+#include "301/CO_EMaggregator.h"
+
+#if (CO_CONFIG_EM_AGG) & CO_CONFIG_EM_AGG_ENABLE
+
+#if !((CO_CONFIG_EM) & CO_CONFIG_EM_CONSUMER)
+#error CO_CONFIG_EM_CONSUMER must be enabled for emergency aggregator!
+#endif
+#if CO_CONFIG_EM_AGG_RX_QUEUE_SIZE < 2
+#error CO_CONFIG_EM_AGG_RX_QUEUE_SIZE must be at least 2!
+#endif
+
+#define NODE_BIT(nodeId) ((uint32_t)1U << ((nodeId) & 0x1FU))
+#define NODE_WORD(nodeId) ((nodeId) >> 5)
+
+
+/*
+ * Custom function for reading received emergency message. It is called from
+ * CO_EM_receive(), inside CAN receive interrupt.
+ *
+ * Function only copies the message into the queue.
+ */
+static void CO_EMagg_receive(void *object, uint16_t ident, const uint8_t *data)
+{
+    CO_EMagg_t *agg = (CO_EMagg_t *)object;
+    uint8_t nodeId = (uint8_t)(ident & 0x7FU);
+
+    if (nodeId == 0) {
+        return;
+    }
+
+    CO_EMagg_rx_t *rx = &agg->rx[agg->rxWrPtr];
+
+    if (CO_FLAG_READ(rx->CANrxNew)) {
+        /* queue is full */
+        agg->rxOverflow++;
+        return;
+    }
+    rx->nodeId = nodeId;
+    memcpy(rx->data, data, sizeof(rx->data));
+    CO_FLAG_SET(rx->CANrxNew);
+    if (++agg->rxWrPtr >= CO_CONFIG_EM_AGG_RX_QUEUE_SIZE) {
+        agg->rxWrPtr = 0;
+    }
+
+#if (CO_CONFIG_EM_AGG) & CO_CONFIG_FLAG_CALLBACK_PRE
+    /* Optional signal to RTOS, which can resume task, which handles
+     * CO_EMagg_process(). */
+    if (agg->pFunctSignalPre != NULL) {
+        agg->pFunctSignalPre(agg->functSignalObjectPre);
+    }
+#endif
+}
+
+
+/* Home position of the node-ID and error code in the table */
+static uint16_t entryHash(CO_EMagg_t *agg, uint8_t nodeId, uint16_t errorCode)
+{
+    uint32_t key = ((uint32_t)nodeId << 16) | errorCode;
+
+    /* multiplicative (Fibonacci) hashing, upper bits are the best mixed */
+    return (uint16_t)((key * 2654435761U) >> (32U - agg->hashBits));
+}
+
+
+/* Index of the entry or CO_EM_AGG_NONE. Table is never full, so empty entry
+ * always ends the probe. */
+static uint16_t entryFind(CO_EMagg_t *agg, uint8_t nodeId, uint16_t errorCode)
+{
+    uint16_t mask = agg->entriesSize - 1U;
+    uint16_t i = entryHash(agg, nodeId, errorCode);
+
+    while (agg->entries[i].nodeId != 0) {
+        if (agg->entries[i].nodeId == nodeId
+            && agg->entries[i].errorCode == errorCode
+        ) {
+            return i;
+        }
+        i = (i + 1U) & mask;
+    }
+    return CO_EM_AGG_NONE;
+}
+
+
+/* Insert new entry and link it at the head of the node list. Return
+ * CO_EM_AGG_NONE, if table is filled up to the limit. */
+static uint16_t entryInsert(CO_EMagg_t *agg,
+                            uint8_t nodeId,
+                            uint16_t errorCode)
+{
+    uint16_t mask = agg->entriesSize - 1U;
+    uint16_t i = entryHash(agg, nodeId, errorCode);
+    CO_EMagg_node_t *node = &agg->nodes[nodeId - 1U];
+
+    if (agg->entriesUsed >= (agg->entriesSize - (agg->entriesSize >> 2))) {
+        return CO_EM_AGG_NONE;
+    }
+    while (agg->entries[i].nodeId != 0) {
+        i = (i + 1U) & mask;
+    }
+
+    CO_EMagg_entry_t *entry = &agg->entries[i];
+    memset(entry, 0, sizeof(CO_EMagg_entry_t));
+    entry->nodeId = nodeId;
+    entry->errorCode = errorCode;
+    entry->prev = CO_EM_AGG_NONE;
+    entry->next = node->head;
+    if (node->head != CO_EM_AGG_NONE) {
+        agg->entries[node->head].prev = i;
+    }
+    node->head = i;
+    node->activeCount++;
+    agg->entriesUsed++;
+    agg->active[NODE_WORD(nodeId)] |= NODE_BIT(nodeId);
+
+    return i;
+}
+
+
+/* Unlink the entry from the node list and remove it from the table. Following
+ * entries of the same probe sequence are shifted back, so no tombstones are
+ * necessary. */
+static void entryRemove(CO_EMagg_t *agg, uint16_t i) {
+    uint16_t mask = agg->entriesSize - 1U;
+    CO_EMagg_entry_t *entry = &agg->entries[i];
+    CO_EMagg_node_t *node = &agg->nodes[entry->nodeId - 1U];
+
+    if (entry->prev != CO_EM_AGG_NONE) {
+        agg->entries[entry->prev].next = entry->next;
+    }
+    else {
+        node->head = entry->next;
+    }
+    if (entry->next != CO_EM_AGG_NONE) {
+        agg->entries[entry->next].prev = entry->prev;
+    }
+    if (--node->activeCount == 0) {
+        agg->active[NODE_WORD(entry->nodeId)] &= ~NODE_BIT(entry->nodeId);
+    }
+    agg->entriesUsed--;
+
+    uint16_t j = i;
+    for (;;) {
+        agg->entries[i].nodeId = 0;
+
+        for (;;) {
+            j = (j + 1U) & mask;
+            if (agg->entries[j].nodeId == 0) {
+                return;
+            }
+            uint16_t k = entryHash(agg, agg->entries[j].nodeId,
+                                   agg->entries[j].errorCode);
+            /* entry stays, if its home position is cyclically in (i, j] */
+            bool_t stays = (i <= j) ? (i < k && k <= j) : (i < k || k <= j);
+            if (!stays) {
+                break;
+            }
+        }
+
+        /* move entry j into the hole and fix the links to it */
+        CO_EMagg_entry_t *moved = &agg->entries[i];
+        *moved = agg->entries[j];
+        if (moved->prev != CO_EM_AGG_NONE) {
+            agg->entries[moved->prev].next = i;
+        }
+        else {
+            agg->nodes[moved->nodeId - 1U].head = i;
+        }
+        if (moved->next != CO_EM_AGG_NONE) {
+            agg->entries[moved->next].prev = i;
+        }
+        i = j;
+    }
+}
+
+
+/* Remove all active errors of the node. Return true, if any was removed. */
+static bool_t nodeClear(CO_EMagg_t *agg, uint8_t nodeId) {
+    CO_EMagg_node_t *node = &agg->nodes[nodeId - 1U];
+    bool_t removed = node->head != CO_EM_AGG_NONE;
+
+    /* entryRemove() may move other entries and keeps their links, so the
+     * head is always valid */
+    while (node->head != CO_EM_AGG_NONE) {
+        entryRemove(agg, node->head);
+    }
+    return removed;
+}
+
+
+/* Update the tables with one emergency message */
+static void aggregate(CO_EMagg_t *agg, uint8_t nodeId, const uint8_t *data) {
+    CO_EMagg_node_t *node = &agg->nodes[nodeId - 1U];
+    uint16_t errorCode;
+    uint32_t infoCode;
+    uint8_t errorRegister = data[2];
+    uint8_t errorBit = data[3];
+    bool_t changed = false;
+
+    memcpy(&errorCode, &data[0], sizeof(errorCode));
+    memcpy(&infoCode, &data[4], sizeof(infoCode));
+    errorCode = CO_SWAP_16(errorCode);
+    infoCode = CO_SWAP_32(infoCode);
+
+    if (node->count == 0) {
+        node->first_ms = agg->time_ms;
+    }
+    if (node->count < 0xFFFFFFFFU) {
+        node->count++;
+    }
+    node->last_ms = agg->time_ms;
+    if (node->errorRegister != errorRegister) {
+        node->errorRegister = errorRegister;
+        changed = true;
+    }
+
+    if ((errorCode & 0xFF00U) == 0) {
+        /* error reset or no error */
+        if (errorRegister == 0) {
+            if (nodeClear(agg, nodeId)) {
+                changed = true;
+            }
+        }
+        else {
+            uint16_t i = node->head;
+            while (i != CO_EM_AGG_NONE) {
+                uint16_t next = agg->entries[i].next;
+                if (agg->entries[i].errorBit == errorBit) {
+                    entryRemove(agg, i);
+                    changed = true;
+                    /* removal may have moved the next entry */
+                    next = node->head;
+                }
+                i = next;
+            }
+        }
+    }
+    else {
+        uint16_t i = entryFind(agg, nodeId, errorCode);
+
+        if (i == CO_EM_AGG_NONE) {
+            i = entryInsert(agg, nodeId, errorCode);
+            if (i == CO_EM_AGG_NONE) {
+                if (node->lost < 0xFFFFU) {
+                    node->lost++;
+                }
+            }
+            else {
+                agg->entries[i].first_ms = agg->time_ms;
+                changed = true;
+            }
+        }
+        if (i != CO_EM_AGG_NONE) {
+            CO_EMagg_entry_t *entry = &agg->entries[i];
+            if (entry->count < 0xFFFFFFFFU) {
+                entry->count++;
+            }
+            entry->last_ms = agg->time_ms;
+            entry->errorBit = errorBit;
+            entry->infoCode = infoCode;
+        }
+    }
+
+    if (changed) {
+        agg->changed[NODE_WORD(nodeId)] |= NODE_BIT(nodeId);
+    }
+}
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_EMagg_init(CO_EMagg_t *agg,
+                               CO_EM_t *em,
+                               CO_EMagg_entry_t *entries,
+                               uint16_t entriesSize)
+{
+    /* verify arguments */
+    if (agg == NULL || em == NULL || entries == NULL || entriesSize < 2U
+        || (entriesSize & (entriesSize - 1U)) != 0
+    ) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    /* disconnect from CAN receive, while object is cleared */
+    em->pFunctSignalRxAgg = NULL;
+
+    memset(agg, 0, sizeof(CO_EMagg_t));
+    memset(entries, 0, sizeof(CO_EMagg_entry_t) * entriesSize);
+    agg->entries = entries;
+    agg->entriesSize = entriesSize;
+    while (((uint32_t)1U << agg->hashBits) < entriesSize) {
+        agg->hashBits++;
+    }
+    for (uint8_t i = 0; i < 127; i++) {
+        agg->nodes[i].head = CO_EM_AGG_NONE;
+    }
+
+    em->functSignalObjectRxAgg = (void *)agg;
+    em->pFunctSignalRxAgg = CO_EMagg_receive;
+
+    return CO_ERROR_NO;
+}
+
+
+/******************************************************************************/
+void CO_EMagg_initCallbackChanged(
+        CO_EMagg_t             *agg,
+        void                   *object,
+        void                  (*pFunctSignalChanged)(uint8_t nodeId,
+                                                     void *object))
+{
+    if (agg != NULL) {
+        agg->pFunctSignalChanged = pFunctSignalChanged;
+        agg->functSignalObjectChanged = object;
+    }
+}
+
+
+#if (CO_CONFIG_EM_AGG) & CO_CONFIG_FLAG_CALLBACK_PRE
+/******************************************************************************/
+void CO_EMagg_initCallbackPre(CO_EMagg_t *agg,
+                              void *object,
+                              void (*pFunctSignal)(void *object))
+{
+    if (agg != NULL) {
+        agg->functSignalObjectPre = object;
+        agg->pFunctSignalPre = pFunctSignal;
+    }
+}
+#endif
+
+
+/******************************************************************************/
+void CO_EMagg_process(CO_EMagg_t *agg,
+                      uint32_t timeDifference_us,
+                      uint32_t *timerNext_us)
+{
+    (void)timerNext_us; /* unused */
+
+    if (agg == NULL) {
+        return;
+    }
+
+    agg->time_us += timeDifference_us;
+    agg->time_ms += agg->time_us / 1000U;
+    agg->time_us %= 1000U;
+
+    /* empty the queue */
+    for (;;) {
+        CO_EMagg_rx_t *rx = &agg->rx[agg->rxRdPtr];
+
+        if (!CO_FLAG_READ(rx->CANrxNew)) {
+            break;
+        }
+        aggregate(agg, rx->nodeId, rx->data);
+        CO_FLAG_CLEAR(rx->CANrxNew);
+        if (++agg->rxRdPtr >= CO_CONFIG_EM_AGG_RX_QUEUE_SIZE) {
+            agg->rxRdPtr = 0;
+        }
+    }
+
+    /* signal changed nodes */
+    for (uint8_t w = 0; w < 4; w++) {
+        uint32_t changed = agg->changed[w];
+
+        agg->changed[w] = 0;
+        while (changed != 0) {
+            uint8_t b = 0;
+            while ((changed & ((uint32_t)1U << b)) == 0) {
+                b++;
+            }
+            changed &= ~((uint32_t)1U << b);
+            if (agg->pFunctSignalChanged != NULL) {
+                agg->pFunctSignalChanged((uint8_t)(w * 32U + b),
+                                         agg->functSignalObjectChanged);
+            }
+        }
+    }
+}
+
+
+/******************************************************************************/
+const CO_EMagg_entry_t *CO_EMagg_find(CO_EMagg_t *agg,
+                                      uint8_t nodeId,
+                                      uint16_t errorCode)
+{
+    if (agg == NULL || nodeId < 1 || nodeId > 127) {
+        return NULL;
+    }
+
+    uint16_t i = entryFind(agg, nodeId, errorCode);
+    return (i == CO_EM_AGG_NONE) ? NULL : &agg->entries[i];
+}
+
+
+/******************************************************************************/
+void CO_EMagg_clear(CO_EMagg_t *agg, uint8_t nodeId) {
+    if (agg == NULL || nodeId > 127) {
+        return;
+    }
+
+    uint8_t first = (nodeId == 0) ? 1 : nodeId;
+    uint8_t last = (nodeId == 0) ? 127 : nodeId;
+
+    for (uint8_t id = first; id <= last; id++) {
+        CO_EMagg_node_t *node = &agg->nodes[id - 1U];
+
+        if (nodeClear(agg, id)) {
+            agg->changed[NODE_WORD(id)] |= NODE_BIT(id);
+        }
+        memset(node, 0, sizeof(CO_EMagg_node_t));
+        node->head = CO_EM_AGG_NONE;
+    }
+}
+
+#endif /* (CO_CONFIG_EM_AGG) & CO_CONFIG_EM_AGG_ENABLE */
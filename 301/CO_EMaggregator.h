@@ -0,0 +1,374 @@
+/**
+ * CANopen Emergency aggregator, non-standard.
+ *
+ * @file        CO_EMaggregator.h
+ * @ingroup     CO_EMaggregator
+ * @author      J-Weisberg
+ * @copyright   2026 J-Weisberg
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CO_EM_AGGREGATOR_H
+#define CO_EM_AGGREGATOR_H
+
+#include "301/CO_driver.h"
+#include "301/CO_Emergency.h"
+
+/* default configuration, see CO_config.h */
+#ifndef CO_CONFIG_EM_AGG
+#define CO_CONFIG_EM_AGG (0)
+#endif
+#ifndef CO_CONFIG_EM_AGG_RX_QUEUE_SIZE
+#define CO_CONFIG_EM_AGG_RX_QUEUE_SIZE 32
+#endif
+
+#if ((CO_CONFIG_EM_AGG) & CO_CONFIG_EM_AGG_ENABLE) || defined CO_DOXYGEN
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup CO_EMaggregator Emergency aggregator
+ * CANopen Emergency aggregator, non-standard.
+ *
+ * @ingroup CO_CANopen_301
+ * @{
+ * Emergency aggregator keeps the table of active errors of all nodes on the
+ * network. It is fed by @ref CO_Emergency consumer, so
+ * @ref CO_CONFIG_EM_CONSUMER must be enabled. Callback from
+ * CO_EM_initCallbackRx() is still available to the application.
+ *
+ * Emergency messages are copied in CAN receive callback into the queue of
+ * size @ref CO_CONFIG_EM_AGG_RX_QUEUE_SIZE. CO_EMagg_process() then takes
+ * them from the queue and updates the tables:
+ *  - For each node-ID: error register from the last message, count of all
+ *    messages, time of the first and the last message and list of active
+ *    errors.
+ *  - For each active error (node-ID and error code): count of repetitions,
+ *    time of the first and the last occurrence and error status bit and
+ *    information code (bytes 3 to 7) of the last occurrence. Repeated message
+ *    with the same error code only updates the entry.
+ *
+ * Message with error code 0x00xx ("error reset or no error") clears all active
+ * errors of the node, if error register is 0. Otherwise it clears the active
+ * error, whose error status bit (byte 3 of the message) is the same, as
+ * emergency producer of CANopenNode does.
+ *
+ * Active errors are stored in the hash table with capacity, which is given by
+ * the application in CO_EMagg_init(). Table is indexed by node-ID and error
+ * code with linear probing, so processing of the message and lookup take
+ * constant time and no memory is allocated. Active errors of each node are
+ * linked into the list, so they can be walked with CO_EMagg_first() and
+ * CO_EMagg_next() without searching the table.
+ *
+ * After processing, callback from CO_EMagg_initCallbackChanged() is called
+ * once for each node, whose active errors or error register have changed.
+ * Time is in milliseconds since CO_EMagg_init(), as counted by
+ * CO_EMagg_process().
+ */
+
+/** Index, which marks the end of the list of active errors */
+#define CO_EM_AGG_NONE 0xFFFFU
+
+
+/**
+ * Active error of one node inside @ref CO_EMagg_t.
+ */
+typedef struct {
+    /** Node-ID, 0 if entry is empty */
+    uint8_t nodeId;
+    /** Error status bit, byte 3 of the last message */
+    uint8_t errorBit;
+    /** Error code, see @ref CO_EM_errorCode_t */
+    uint16_t errorCode;
+    /** Information code, bytes 4 to 7 of the last message */
+    uint32_t infoCode;
+    /** Number of received messages with this error code */
+    uint32_t count;
+    /** Time of the first message in milliseconds */
+    uint32_t first_ms;
+    /** Time of the last message in milliseconds */
+    uint32_t last_ms;
+    /** Index of the previous active error of the same node or
+     * @ref CO_EM_AGG_NONE */
+    uint16_t prev;
+    /** Index of the next active error of the same node or
+     * @ref CO_EM_AGG_NONE */
+    uint16_t next;
+} CO_EMagg_entry_t;
+
+
+/**
+ * Summary of one node inside @ref CO_EMagg_t.
+ */
+typedef struct {
+    /** Error register from the last message, see @ref CO_errorRegister_t */
+    uint8_t errorRegister;
+    /** Number of active errors */
+    uint8_t activeCount;
+    /** Index of the first active error or @ref CO_EM_AGG_NONE */
+    uint16_t head;
+    /** Number of received messages, saturated */
+    uint32_t count;
+    /** Time of the first message in milliseconds */
+    uint32_t first_ms;
+    /** Time of the last message in milliseconds */
+    uint32_t last_ms;
+    /** Number of errors, which were not stored, because table was full */
+    uint16_t lost;
+} CO_EMagg_node_t;
+
+
+/**
+ * Received emergency message in the queue of @ref CO_EMagg_t.
+ */
+typedef struct {
+    /** Indication if new message is in the slot */
+    volatile void *CANrxNew;
+    /** Node-ID of the producer */
+    uint8_t nodeId;
+    /** 8 data bytes of the message */
+    uint8_t data[8];
+} CO_EMagg_rx_t;
+
+
+/**
+ * Emergency aggregator object.
+ */
+typedef struct {
+    /** Summary for each node, index is node-ID - 1 */
+    CO_EMagg_node_t nodes[127];
+    /** Bitmap of nodes with at least one active error, bit n is node-ID n */
+    uint32_t active[4];
+    /** Bitmap of nodes changed since the last callback */
+    uint32_t changed[4];
+    /** Table of active errors, from CO_EMagg_init() */
+    CO_EMagg_entry_t *entries;
+    /** Capacity of the table, power of two, from CO_EMagg_init() */
+    uint16_t entriesSize;
+    /** Number of bits of the entries index */
+    uint8_t hashBits;
+    /** Number of used entries */
+    uint16_t entriesUsed;
+    /** Queue of received messages */
+    CO_EMagg_rx_t rx[CO_CONFIG_EM_AGG_RX_QUEUE_SIZE];
+    /** Position in the queue, where CAN receive writes */
+    uint16_t rxWrPtr;
+    /** Position in the queue, where CO_EMagg_process() reads */
+    uint16_t rxRdPtr;
+    /** Number of messages lost because of full queue, written by CAN receive */
+    uint32_t rxOverflow;
+    /** Time in milliseconds since CO_EMagg_init() */
+    uint32_t time_ms;
+    /** Microseconds, which are not yet counted in time_ms */
+    uint32_t time_us;
+    /** From CO_EMagg_initCallbackChanged() or NULL */
+    void (*pFunctSignalChanged)(uint8_t nodeId, void *object);
+    /** From CO_EMagg_initCallbackChanged() or NULL */
+    void *functSignalObjectChanged;
+#if ((CO_CONFIG_EM_AGG) & CO_CONFIG_FLAG_CALLBACK_PRE) || defined CO_DOXYGEN
+    /** From CO_EMagg_initCallbackPre() or NULL */
+    void (*pFunctSignalPre)(void *object);
+    /** From CO_EMagg_initCallbackPre() or NULL */
+    void *functSignalObjectPre;
+#endif
+} CO_EMagg_t;
+
+
+/**
+ * Initialize Emergency aggregator object.
+ *
+ * Function must be called after CO_EM_init(), in the communication reset
+ * section. All tables are cleared.
+ *
+ * @param agg This object will be initialized.
+ * @param em Emergency object with enabled consumer.
+ * @param entries Table of active errors, defined externally.
+ * @param entriesSize Number of elements in the above table, power of two, from
+ * 2 to 32768. Table is filled up to 3/4, so lookup stays short.
+ *
+ * @return #CO_ReturnError_t: CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT.
+ */
+CO_ReturnError_t CO_EMagg_init(CO_EMagg_t *agg,
+                               CO_EM_t *em,
+                               CO_EMagg_entry_t *entries,
+                               uint16_t entriesSize);
+
+
+/**
+ * Initialize callback function, which is called after change on the node.
+ *
+ * Function is called from CO_EMagg_process() once for each node, whose active
+ * errors or error register have changed since the previous call.
+ *
+ * @param agg This object.
+ * @param object Pointer to object, which will be passed to
+ * pFunctSignalChanged(). Can be NULL.
+ * @param pFunctSignalChanged Pointer to the callback function. Not called if
+ * NULL.
+ */
+void CO_EMagg_initCallbackChanged(
+        CO_EMagg_t             *agg,
+        void                   *object,
+        void                  (*pFunctSignalChanged)(uint8_t nodeId,
+                                                     void *object));
+
+
+#if ((CO_CONFIG_EM_AGG) & CO_CONFIG_FLAG_CALLBACK_PRE) || defined CO_DOXYGEN
+/**
+ * Initialize callback function, which is called after emergency message is
+ * received.
+ *
+ * Function may wake up external task, which processes CO_EMagg_process().
+ *
+ * @param agg This object.
+ * @param object Pointer to object, which will be passed to pFunctSignal().
+ * Can be NULL.
+ * @param pFunctSignal Pointer to the callback function. Not called if NULL.
+ */
+void CO_EMagg_initCallbackPre(CO_EMagg_t *agg,
+                              void *object,
+                              void (*pFunctSignal)(void *object));
+#endif
+
+
+/**
+ * Process received emergency messages.
+ *
+ * Function must be called cyclically. It updates the tables from the queue
+ * and calls change callbacks. Time resolution of the tables is the period of
+ * this function.
+ *
+ * @param agg This object.
+ * @param timeDifference_us Time difference from previous function call.
+ * @param [out] timerNext_us info to OS - see CO_process(). Not used.
+ */
+void CO_EMagg_process(CO_EMagg_t *agg,
+                      uint32_t timeDifference_us,
+                      uint32_t *timerNext_us);
+
+
+/**
+ * Find active error.
+ *
+ * @param agg This object.
+ * @param nodeId Node-ID, 1 to 127.
+ * @param errorCode Error code.
+ *
+ * @return Pointer to the entry or NULL, if error is not active.
+ */
+const CO_EMagg_entry_t *CO_EMagg_find(CO_EMagg_t *agg,
+                                      uint8_t nodeId,
+                                      uint16_t errorCode);
+
+
+/**
+ * Get the first active error of the node.
+ *
+ * @param agg This object.
+ * @param nodeId Node-ID, 1 to 127.
+ *
+ * @return Pointer to the entry or NULL, if node has no active error.
+ */
+static inline const CO_EMagg_entry_t *CO_EMagg_first(CO_EMagg_t *agg,
+                                                     uint8_t nodeId)
+{
+    if (agg == NULL || nodeId < 1 || nodeId > 127
+        || agg->nodes[nodeId - 1].head == CO_EM_AGG_NONE
+    ) {
+        return NULL;
+    }
+    return &agg->entries[agg->nodes[nodeId - 1].head];
+}
+
+
+/**
+ * Get the next active error of the same node.
+ *
+ * @param agg This object.
+ * @param entry Entry from CO_EMagg_first() or CO_EMagg_next().
+ *
+ * @return Pointer to the entry or NULL, if there are no more errors.
+ */
+static inline const CO_EMagg_entry_t *CO_EMagg_next(CO_EMagg_t *agg,
+                                                    const CO_EMagg_entry_t *entry)
+{
+    if (agg == NULL || entry == NULL || entry->next == CO_EM_AGG_NONE) {
+        return NULL;
+    }
+    return &agg->entries[entry->next];
+}
+
+
+/**
+ * Get the summary of the node.
+ *
+ * @param agg This object.
+ * @param nodeId Node-ID, 1 to 127.
+ *
+ * @return Pointer to the summary or NULL, if arguments are wrong.
+ */
+static inline const CO_EMagg_node_t *CO_EMagg_getNode(CO_EMagg_t *agg,
+                                                      uint8_t nodeId)
+{
+    if (agg == NULL || nodeId < 1 || nodeId > 127) {
+        return NULL;
+    }
+    return &agg->nodes[nodeId - 1];
+}
+
+
+/**
+ * Check, if node has active errors.
+ *
+ * @param agg This object.
+ * @param nodeId Node-ID, 1 to 127.
+ *
+ * @return True, if node has at least one active error.
+ */
+static inline bool_t CO_EMagg_isActive(CO_EMagg_t *agg, uint8_t nodeId) {
+    if (agg == NULL || nodeId < 1 || nodeId > 127) {
+        return false;
+    }
+    return (agg->active[nodeId >> 5] & ((uint32_t)1U << (nodeId & 0x1FU)))
+           != 0;
+}
+
+
+/**
+ * Clear active errors and summary of the node.
+ *
+ * If node had active errors, change is signalled in the next
+ * CO_EMagg_process().
+ *
+ * @param agg This object.
+ * @param nodeId Node-ID, 1 to 127, or 0 for all nodes.
+ */
+void CO_EMagg_clear(CO_EMagg_t *agg, uint8_t nodeId);
+
+
+/** @} */ /* CO_EMaggregator */
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+
+#endif /* (CO_CONFIG_EM_AGG) & CO_CONFIG_EM_AGG_ENABLE */
+
+#endif /* CO_EM_AGGREGATOR_H */
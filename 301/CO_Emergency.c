@@ -48,6 +48,149 @@
  *     to process   to process    to process      full                        *
  ******************************************************************************/
 
+#if ((CO_CONFIG_EM) & CO_CONFIG_EM_HISTORY_STORE) \
+    && !((CO_CONFIG_EM) & CO_CONFIG_EM_HISTORY)
+ #error CO_CONFIG_EM_HISTORY must be enabled for CO_CONFIG_EM_HISTORY_STORE!
+#endif
+
+#if ((CO_CONFIG_EM) & CO_CONFIG_EM_PROD_RATE_LIMIT) \
+    && !((CO_CONFIG_EM) & CO_CONFIG_EM_PRODUCER)
+ #error CO_CONFIG_EM_PRODUCER must be enabled for CO_CONFIG_EM_PROD_RATE_LIMIT!
+#endif
+
+#if (CO_CONFIG_EM) & (CO_CONFIG_EM_PRODUCER | CO_CONFIG_EM_HISTORY)
+ #if (CO_CONFIG_EM) & CO_CONFIG_EM_LOCK_FREE
+/* write pointer is in the lower byte of the ticket */
+#define FIFO_WR_PTR(em) ((uint8_t)CO_EM_ATOMIC_LOAD(&(em)->fifoWrTicket))
+/* entry on pp pointer may be reserved, but not written yet */
+#define FIFO_PP_READY(em, ppPtr) \
+    ((ppPtr) != FIFO_WR_PTR(em) && CO_EM_ATOMIC_LOAD(&(em)->fifo[ppPtr].ready))
+ #else
+#define FIFO_WR_PTR(em) ((em)->fifoWrPtr)
+#define FIFO_PP_READY(em, ppPtr) ((ppPtr) != (em)->fifoWrPtr)
+ #endif
+#endif
+
+#if ((CO_CONFIG_EM) & CO_CONFIG_EM_LOCK_FREE) \
+    && ((CO_CONFIG_EM) & (CO_CONFIG_EM_PRODUCER | CO_CONFIG_EM_HISTORY))
+/* Reserve fifo entry, write it and mark it ready. Multiple producers may call
+ * this function concurrently, CO_EM_process() is the only consumer. If fifo is
+ * full, overflow is indicated and false is returned. */
+static bool_t fifoPutLockFree(CO_EM_t *em, uint32_t msg, uint32_t info,
+                            bool_t setError)
+{
+    uint32_t ticket = CO_EM_ATOMIC_LOAD(&em->fifoWrTicket);
+    uint32_t ticketNext;
+    uint8_t fifoWrPtr;
+
+    (void)info; /* may be unused */
+
+    do {
+        fifoWrPtr = (uint8_t)ticket;
+        uint8_t fifoWrPtrNext = fifoWrPtr + 1;
+        if (fifoWrPtrNext >= em->fifoSize) {
+            fifoWrPtrNext = 0;
+        }
+
+        /* pp pointer only moves forward, so the old value is safe */
+        if (fifoWrPtrNext == CO_EM_ATOMIC_LOAD(&em->fifoPpPtr)) {
+            CO_EM_ATOMIC_STORE(&em->fifoOverflow, 1);
+            return false;
+        }
+        ticketNext = ((ticket + 0x100U) & 0xFFFFFF00U) | fifoWrPtrNext;
+    } while (!CO_EM_ATOMIC_CAS(&em->fifoWrTicket, &ticket, ticketNext));
+
+    /* entry is owned by this caller until it is marked ready */
+    em->fifo[fifoWrPtr].msg = msg;
+ #if (CO_CONFIG_EM) & CO_CONFIG_EM_PRODUCER
+    em->fifo[fifoWrPtr].info = info;
+ #endif
+    em->fifo[fifoWrPtr].setError = setError ? 1 : 0;
+    CO_EM_ATOMIC_STORE(&em->fifo[fifoWrPtr].ready, 1);
+
+    uint8_t count = CO_EM_ATOMIC_LOAD(&em->fifoCount);
+    while (count < (em->fifoSize - 1)
+           && !CO_EM_ATOMIC_CAS(&em->fifoCount, &count, count + 1)
+    ) { }
+    return true;
+}
+
+
+/* Update error status bit from the processed fifo entry and release the entry
+ * to producers */
+static void fifoPpRelease(CO_EM_t *em, uint8_t fifoPpPtr) {
+    CO_EM_fifo_t *entry = &em->fifo[fifoPpPtr];
+    uint8_t errorBit = (uint8_t) (entry->msg >> 24);
+
+    /* unsupported errorBit was reported with 'CO_EM_WRONG_ERROR_REPORT' */
+    if (errorBit >= CO_CONFIG_EM_ERR_STATUS_BITS_COUNT) {
+        errorBit = CO_EM_WRONG_ERROR_REPORT;
+    }
+    uint8_t bitmask = 1 << (errorBit & 0x7);
+
+    if (entry->setError != 0) {
+        em->fifoStatusBits[errorBit >> 3] |= bitmask;
+        em->fifoLastSetMsg[errorBit] = entry->msg & 0xFF00FFFFU;
+ #if (CO_CONFIG_EM) & CO_CONFIG_EM_PRODUCER
+        em->fifoLastSetInfo[errorBit] = entry->info;
+ #endif
+    }
+    else {
+        em->fifoStatusBits[errorBit >> 3] &= ~bitmask;
+    }
+    CO_EM_ATOMIC_STORE(&entry->ready, 0);
+}
+
+/* If all fifo entries are processed, then compare error status bits with the
+ * state from the last processed entries. Entry for the actual state is put into
+ * fifo again for each different bit. Bits are read before the write pointer,
+ * so bit change, whose entry is not processed yet, is not repeated. */
+static void fifoResync(CO_EM_t *em) {
+    for (uint16_t index = 0; index < (CO_CONFIG_EM_ERR_STATUS_BITS_COUNT / 8);
+         index++
+    ) {
+        uint8_t bits = CO_EM_ATOMIC_LOAD(&em->errorStatusBits[index]);
+        uint8_t diff = bits ^ em->fifoStatusBits[index];
+        if (diff == 0) {
+            continue;
+        }
+        if (CO_EM_ATOMIC_LOAD(&em->fifoPpPtr) != FIFO_WR_PTR(em)) {
+            return;
+        }
+
+        for (uint8_t i = 0; i < 8; i++) {
+            uint8_t bitmask = 1 << i;
+            uint8_t errorBit = (uint8_t) (index * 8 + i);
+            if ((diff & bitmask) == 0) {
+                continue;
+            }
+            bool_t put = true;
+            if ((bits & bitmask) == 0) {
+                put = fifoPutLockFree(em, (uint32_t) errorBit << 24
+                                      | CO_SWAP_16(CO_EMC_NO_ERROR), 0, false);
+            }
+            else if (em->fifoLastSetMsg[errorBit] != 0) {
+ #if (CO_CONFIG_EM) & CO_CONFIG_EM_PRODUCER
+                put = fifoPutLockFree(em, em->fifoLastSetMsg[errorBit],
+                                      em->fifoLastSetInfo[errorBit], true);
+ #else
+                put = fifoPutLockFree(em, em->fifoLastSetMsg[errorBit], 0,
+                                      true);
+ #endif
+            }
+            else {
+                /* message was lost in fifo overflow, nothing to repeat */
+                em->fifoStatusBits[index] |= bitmask;
+            }
+            if (!put) {
+                /* fifo is full, remaining bits are repeated on next resync */
+                return;
+            }
+        }
+    }
+}
+#endif
+
 #if (CO_CONFIG_EM) & CO_CONFIG_EM_PRODUCER
  #if (CO_CONFIG_EM) & CO_CONFIG_EM_PROD_CONFIGURABLE
 /*
@@ -202,7 +345,7 @@ static ODR_t OD_read_1003(OD_stream_t *stream, void *buf,
     else if (stream->subIndex <= em->fifoCount) {
         /* newest error is reported on subIndex 1 and is stored just behind
          * fifoWrPtr. Get correct index in FIFO buffer. */
-        int16_t index = (int16_t)em->fifoWrPtr - stream->subIndex;
+        int16_t index = (int16_t)FIFO_WR_PTR(em) - stream->subIndex;
         if (index < 0) {
             index += em->fifoSize;
         }
@@ -235,7 +378,16 @@ static ODR_t OD_write_1003(OD_stream_t *stream, const void *buf,
     CO_EM_t *em = (CO_EM_t *)stream->object;
 
     /* clear error history */
+#if (CO_CONFIG_EM) & CO_CONFIG_EM_LOCK_FREE
+    CO_EM_ATOMIC_STORE(&em->fifoCount, 0);
+#else
     em->fifoCount = 0;
+#endif
+#if (CO_CONFIG_EM) & CO_CONFIG_EM_HISTORY_STORE
+    if (em->pFunctHistoryClear != NULL) {
+        em->pFunctHistoryClear(em->functHistoryObject);
+    }
+#endif
 
     *countWritten = sizeof(uint8_t);
     return ODR_OK;
@@ -301,6 +453,11 @@ static ODR_t OD_write_statusBits(OD_stream_t *stream, const void *buf,
     }
 
     memcpy (&em->errorStatusBits[0], buf, countWrite);
+#if ((CO_CONFIG_EM) & CO_CONFIG_EM_LOCK_FREE) \
+    && ((CO_CONFIG_EM) & (CO_CONFIG_EM_PRODUCER | CO_CONFIG_EM_HISTORY))
+    /* bits written here are not reported */
+    memcpy (&em->fifoStatusBits[0], buf, countWrite);
+#endif
 
     *countWritten = countWrite;
     return ODR_OK;
@@ -317,24 +474,32 @@ static ODR_t OD_write_statusBits(OD_stream_t *stream, const void *buf,
  */
 static void CO_EM_receive(void *object, void *msg) {
     CO_EM_t *em = (CO_EM_t*)object;
+    uint16_t ident = CO_CANrxMsg_readIdent(msg);
 
-    if (em != NULL && em->pFunctSignalRx != NULL) {
-        uint16_t ident = CO_CANrxMsg_readIdent(msg);
-
-        /* ignore sync messages (necessary if sync object is not used) */
-        if (ident != 0x80) {
-            uint8_t *data = CO_CANrxMsg_readData(msg);
-            uint16_t errorCode;
-            uint32_t infoCode;
-
-            memcpy(&errorCode, &data[0], sizeof(errorCode));
-            memcpy(&infoCode, &data[4], sizeof(infoCode));
-            em->pFunctSignalRx(ident,
-                               CO_SWAP_16(errorCode),
-                               data[2],
-                               data[3],
-                               CO_SWAP_32(infoCode));
-        }
+    /* ignore sync messages (necessary if sync object is not used) */
+    if (em == NULL || ident == 0x80) {
+        return;
+    }
+
+    uint8_t *data = CO_CANrxMsg_readData(msg);
+
+#if (CO_CONFIG_EM_AGG) & CO_CONFIG_EM_AGG_ENABLE
+    if (em->pFunctSignalRxAgg != NULL) {
+        em->pFunctSignalRxAgg(em->functSignalObjectRxAgg, ident, data);
+    }
+#endif
+
+    if (em->pFunctSignalRx != NULL) {
+        uint16_t errorCode;
+        uint32_t infoCode;
+
+        memcpy(&errorCode, &data[0], sizeof(errorCode));
+        memcpy(&infoCode, &data[4], sizeof(infoCode));
+        em->pFunctSignalRx(ident,
+                           CO_SWAP_16(errorCode),
+                           data[2],
+                           data[3],
+                           CO_SWAP_32(infoCode));
     }
 }
 #endif
@@ -408,6 +573,12 @@ CO_ReturnError_t CO_EM_init(CO_EM_t *em,
 #if (CO_CONFIG_EM) & (CO_CONFIG_EM_PRODUCER | CO_CONFIG_EM_HISTORY)
     em->fifo = fifo;
     em->fifoSize = fifoSize;
+ #if (CO_CONFIG_EM) & CO_CONFIG_EM_LOCK_FREE
+    /* clear ready flags */
+    if (fifo != NULL) {
+        memset(fifo, 0, fifoSize * sizeof(CO_EM_fifo_t));
+    }
+ #endif
 #endif
 #if (CO_CONFIG_EM) & CO_CONFIG_EM_PRODUCER
     /* get initial and verify "COB-ID EMCY" from Object Dictionary */
@@ -484,6 +655,9 @@ CO_ReturnError_t CO_EM_init(CO_EM_t *em,
         OD_extension_init(OD_1015_InhTime, &em->OD_1015_extension);
     }
  #endif /* (CO_CONFIG_EM) & CO_CONFIG_EM_PROD_INHIBIT */
+ #if (CO_CONFIG_EM) & CO_CONFIG_EM_PROD_RATE_LIMIT
+    em->rateLimitWindow_us = (uint32_t)CO_CONFIG_EM_RATE_LIMIT_MS * 1000;
+ #endif
 #endif /* (CO_CONFIG_EM) & CO_CONFIG_EM_PRODUCER */
 
 
@@ -537,6 +711,81 @@ void CO_EM_initCallbackRx(CO_EM_t *em,
 }
 #endif
 
+
+#if (CO_CONFIG_EM) & CO_CONFIG_EM_HISTORY_STORE
+/******************************************************************************/
+void CO_EM_initHistoryStore(CO_EM_t *em,
+                            void *object,
+                            void (*pFunctAppend)(void *object,
+                                                 uint32_t msg,
+                                                 uint32_t info),
+                            void (*pFunctClear)(void *object))
+{
+    if (em != NULL) {
+        em->functHistoryObject = object;
+        em->pFunctHistoryAppend = pFunctAppend;
+        em->pFunctHistoryClear = pFunctClear;
+    }
+}
+
+
+/******************************************************************************/
+bool_t CO_EM_historyRestore(CO_EM_t *em, uint32_t msg, uint32_t info) {
+    bool_t ret;
+
+    if (em == NULL || em->fifoSize < 2) {
+        return false;
+    }
+
+ #if (CO_CONFIG_EM) & CO_CONFIG_EM_LOCK_FREE
+    uint32_t ticket = CO_EM_ATOMIC_LOAD(&em->fifoWrTicket);
+    uint8_t fifoWrPtr = (uint8_t)ticket;
+ #else
+    CO_LOCK_EMCY(em->CANdevTx);
+    uint8_t fifoWrPtr = em->fifoWrPtr;
+ #endif
+    uint8_t fifoWrPtrNext = fifoWrPtr + 1;
+    if (fifoWrPtrNext >= em->fifoSize) {
+        fifoWrPtrNext = 0;
+    }
+
+    /* entry is added as already processed */
+    ret = fifoWrPtr == em->fifoPpPtr;
+    if (ret) {
+        em->fifo[fifoWrPtr].msg = msg;
+ #if (CO_CONFIG_EM) & CO_CONFIG_EM_PRODUCER
+        em->fifo[fifoWrPtr].info = info;
+ #else
+        (void)info;
+ #endif
+ #if (CO_CONFIG_EM) & CO_CONFIG_EM_LOCK_FREE
+        CO_EM_ATOMIC_STORE(&em->fifoPpPtr, fifoWrPtrNext);
+        CO_EM_ATOMIC_STORE(&em->fifoWrTicket,
+                           ((ticket + 0x100U) & 0xFFFFFF00U) | fifoWrPtrNext);
+ #else
+        em->fifoPpPtr = fifoWrPtrNext;
+        em->fifoWrPtr = fifoWrPtrNext;
+ #endif
+        if (em->fifoCount < (em->fifoSize - 1)) em->fifoCount++;
+    }
+
+ #if !((CO_CONFIG_EM) & CO_CONFIG_EM_LOCK_FREE)
+    CO_UNLOCK_EMCY(em->CANdevTx);
+ #endif
+    return ret;
+}
+#endif /* (CO_CONFIG_EM) & CO_CONFIG_EM_HISTORY_STORE */
+
+
+#if (CO_CONFIG_EM) & CO_CONFIG_EM_PROD_RATE_LIMIT
+/******************************************************************************/
+void CO_EM_setRateLimit(CO_EM_t *em, uint16_t window_ms) {
+    if (em != NULL) {
+        em->rateLimitWindow_us = (uint32_t)window_ms * 1000;
+    }
+}
+#endif
+
 #if (CO_CONFIG_EM) & CO_CONFIG_FLAG_CALLBACK_PRE
 void CO_EM_initCallbackPre(CO_EM_t *em,
                            void *object,
@@ -550,6 +799,210 @@ void CO_EM_initCallbackPre(CO_EM_t *em,
 #endif
 
 
+#if (CO_CONFIG_EM) & CO_CONFIG_EM_PRODUCER
+/* Send emergency message and report it also to own emergency consumer */
+static void sendEmergency(CO_EM_t *em, uint32_t msg, uint32_t info,
+                          uint8_t errorRegister)
+{
+    (void)errorRegister; /* may be unused */
+
+    memcpy(&em->CANtxBuff->data[0], &msg, sizeof(msg));
+    memcpy(&em->CANtxBuff->data[4], &info, sizeof(info));
+    CO_CANsend(em->CANdevTx, em->CANtxBuff);
+
+ #if (CO_CONFIG_EM) & CO_CONFIG_EM_CONSUMER
+    if (em->pFunctSignalRx != NULL) {
+        em->pFunctSignalRx(0,
+                           CO_SWAP_16((uint16_t) msg),
+                           errorRegister,
+                           (uint8_t) (msg >> 24),
+                           CO_SWAP_32(info));
+    }
+ #endif
+}
+
+
+/* Release processed fifo entry, increment pp pointer and verify message
+ * buffer overflow. Returns new pp pointer. */
+static uint8_t fifoPpAdvance(CO_EM_t *em, uint8_t fifoPpPtr) {
+ #if (CO_CONFIG_EM) & CO_CONFIG_EM_LOCK_FREE
+    fifoPpRelease(em, fifoPpPtr);
+    fifoPpPtr = (++fifoPpPtr < em->fifoSize) ? fifoPpPtr : 0;
+    CO_EM_ATOMIC_STORE(&em->fifoPpPtr, fifoPpPtr);
+
+    /* verify message buffer overflow. Clear error condition if all
+     * messages from fifo buffer are processed. Producer may set
+     * overflow again at any time, so state is changed atomically. */
+    uint8_t overflow = 1;
+    if (CO_EM_ATOMIC_CAS(&em->fifoOverflow, &overflow, 2)) {
+        CO_errorReport(em, CO_EM_EMERGENCY_BUFFER_FULL,
+                       CO_EMC_GENERIC, 0);
+    }
+    else if (overflow == 2 && fifoPpPtr == FIFO_WR_PTR(em)
+             && CO_EM_ATOMIC_CAS(&em->fifoOverflow, &overflow, 0)
+    ) {
+        CO_errorReset(em, CO_EM_EMERGENCY_BUFFER_FULL, 0);
+    }
+ #else
+    fifoPpPtr = (++fifoPpPtr < em->fifoSize) ? fifoPpPtr : 0;
+    em->fifoPpPtr = fifoPpPtr;
+
+    /* verify message buffer overflow. Clear error condition if all
+     * messages from fifo buffer are processed */
+    if (em->fifoOverflow == 1) {
+        em->fifoOverflow = 2;
+        CO_errorReport(em, CO_EM_EMERGENCY_BUFFER_FULL,
+                       CO_EMC_GENERIC, 0);
+    }
+    else if (em->fifoOverflow == 2 && em->fifoPpPtr == em->fifoWrPtr) {
+        em->fifoOverflow = 0;
+        CO_errorReset(em, CO_EM_EMERGENCY_BUFFER_FULL, 0);
+    }
+ #endif
+    return fifoPpPtr;
+}
+#endif /* (CO_CONFIG_EM) & CO_CONFIG_EM_PRODUCER */
+
+
+#if (CO_CONFIG_EM) & CO_CONFIG_EM_PROD_RATE_LIMIT
+/* Post-process ready fifo entries. Entries, whose error status bit is inside
+ * the rate limit window, are counted. The first other entry is taken into the
+ * send slot and starts the window. Stop, if send slot is occupied. Returns new
+ * pp pointer. */
+static uint8_t rateLimitPoll(CO_EM_t *em, uint8_t fifoPpPtr,
+                             uint8_t errorRegister)
+{
+    while (FIFO_PP_READY(em, fifoPpPtr)) {
+        uint32_t msg = em->fifo[fifoPpPtr].msg;
+        uint8_t errorBit = (uint8_t) (msg >> 24);
+        uint8_t index = errorBit >> 3;
+        uint8_t bitmask = 1 << (errorBit & 0x7);
+        bool_t limited = false;
+
+        if (em->rateLimitWindow_us != 0
+            && index < (CO_CONFIG_EM_ERR_STATUS_BITS_COUNT / 8)
+        ) {
+            CO_EM_rateLimit_t *rl = &em->rateLimit[errorBit];
+            if ((em->rateLimitActive[index] & bitmask) != 0) {
+                if (rl->count == 0 && (em->rateLimitClock_us - rl->sent_us)
+                                      >= em->rateLimitWindow_us
+                ) {
+                    /* window elapsed without repeats, send as first message */
+                    em->rateLimitActive[index] &= ~bitmask;
+                }
+                else {
+                    limited = true;
+                }
+            }
+        }
+
+        if (!limited && em->rateLimitPendingValid) {
+            break;
+        }
+
+        /* add error register to emergency message */
+        msg |= (uint32_t) errorRegister << 16;
+        em->fifo[fifoPpPtr].msg = msg;
+ #if (CO_CONFIG_EM) & CO_CONFIG_EM_HISTORY_STORE
+        if (em->pFunctHistoryAppend != NULL) {
+            em->pFunctHistoryAppend(em->functHistoryObject, msg,
+                                    em->fifo[fifoPpPtr].info);
+        }
+ #endif
+
+        if (limited) {
+            CO_EM_rateLimit_t *rl = &em->rateLimit[errorBit];
+            rl->msg = msg;
+            if (rl->count < 0xFFFF) {
+                rl->count++;
+            }
+            em->rateLimitCoalesced++;
+        }
+        else {
+            em->rateLimitPending.msg = msg;
+            em->rateLimitPending.info = em->fifo[fifoPpPtr].info;
+            em->rateLimitPendingValid = true;
+            if (em->rateLimitWindow_us != 0
+                && index < (CO_CONFIG_EM_ERR_STATUS_BITS_COUNT / 8)
+            ) {
+                em->rateLimit[errorBit].sent_us = em->rateLimitClock_us;
+                em->rateLimitActive[index] |= bitmask;
+            }
+        }
+
+        fifoPpPtr = fifoPpAdvance(em, fifoPpPtr);
+    }
+    return fifoPpPtr;
+}
+
+
+/* Send one summary message for error status bit, whose rate limit window
+ * elapsed. Windows without counted messages are closed. Returns true, if
+ * message was sent. */
+static bool_t rateLimitSummary(CO_EM_t *em, uint8_t errorRegister) {
+    uint32_t window_us = em->rateLimitWindow_us;
+
+    for (uint16_t index = 0; index < (CO_CONFIG_EM_ERR_STATUS_BITS_COUNT / 8);
+         index++
+    ) {
+        uint8_t active = em->rateLimitActive[index];
+        for (uint8_t i = 0; active != 0; i++, active >>= 1) {
+            if ((active & 1) == 0) {
+                continue;
+            }
+            CO_EM_rateLimit_t *rl = &em->rateLimit[index * 8 + i];
+            if ((em->rateLimitClock_us - rl->sent_us) < window_us) {
+                continue;
+            }
+
+            if (rl->count == 0 || window_us == 0) {
+                em->rateLimitActive[index] &= ~(1 << i);
+            }
+            if (rl->count == 0) {
+                continue;
+            }
+
+            /* summary with actual error register and number of messages */
+            uint32_t msg = (rl->msg & 0xFF00FFFFU)
+                         | (uint32_t) errorRegister << 16;
+            uint32_t info = CO_SWAP_32((uint32_t) rl->count);
+            rl->count = 0;
+            rl->sent_us = em->rateLimitClock_us;
+            em->rateLimitSummaries++;
+
+            sendEmergency(em, msg, info, errorRegister);
+            return true;
+        }
+    }
+    return false;
+}
+
+
+ #if (CO_CONFIG_EM) & CO_CONFIG_FLAG_TIMERNEXT
+/* Time until the next summary message */
+static void rateLimitTimerNext(CO_EM_t *em, uint32_t *timerNext_us) {
+    for (uint16_t index = 0; index < (CO_CONFIG_EM_ERR_STATUS_BITS_COUNT / 8);
+         index++
+    ) {
+        uint8_t active = em->rateLimitActive[index];
+        for (uint8_t i = 0; active != 0; i++, active >>= 1) {
+            CO_EM_rateLimit_t *rl = &em->rateLimit[index * 8 + i];
+            if ((active & 1) == 0 || rl->count == 0) {
+                continue;
+            }
+            uint32_t elapsed = em->rateLimitClock_us - rl->sent_us;
+            uint32_t diff = (elapsed < em->rateLimitWindow_us)
+                          ? em->rateLimitWindow_us - elapsed : 0;
+            if (*timerNext_us > diff) {
+                *timerNext_us = diff;
+            }
+        }
+    }
+}
+ #endif
+#endif /* (CO_CONFIG_EM) & CO_CONFIG_EM_PROD_RATE_LIMIT */
+
+
 /******************************************************************************/
 void CO_EM_process(CO_EM_t *em,
                    bool_t NMTisPreOrOperational,
@@ -634,48 +1087,52 @@ void CO_EM_process(CO_EM_t *em,
             em->inhibitEmTimer += timeDifference_us;
         }
 
-        if (fifoPpPtr != em->fifoWrPtr && !em->CANtxBuff->bufferFull
-            && em->inhibitEmTimer >= em->inhibitEmTime_us
-        ) {
-            em->inhibitEmTimer = 0;
+        bool_t txReady = !em->CANtxBuff->bufferFull
+                         && em->inhibitEmTimer >= em->inhibitEmTime_us;
  #else
-        if (fifoPpPtr != em->fifoWrPtr && !em->CANtxBuff->bufferFull) {
+        bool_t txReady = !em->CANtxBuff->bufferFull;
  #endif
-            /* add error register to emergency message */
-            em->fifo[fifoPpPtr].msg |= (uint32_t) errorRegister << 16;
 
-            /* send emergency message */
-            memcpy(em->CANtxBuff->data, &em->fifo[fifoPpPtr].msg,
-                sizeof(em->CANtxBuff->data));
-            CO_CANsend(em->CANdevTx, em->CANtxBuff);
+ #if (CO_CONFIG_EM) & CO_CONFIG_EM_PROD_RATE_LIMIT
+        em->rateLimitClock_us += timeDifference_us;
+        fifoPpPtr = rateLimitPoll(em, fifoPpPtr, errorRegister);
 
- #if (CO_CONFIG_EM) & CO_CONFIG_EM_CONSUMER
-            /* report also own emergency messages */
-            if (em->pFunctSignalRx != NULL) {
-                uint32_t errMsg = em->fifo[fifoPpPtr].msg;
-                em->pFunctSignalRx(0,
-                                   CO_SWAP_16((uint16_t) errMsg),
-                                   errorRegister,
-                                   (uint8_t) (errMsg >> 24),
-                                   CO_SWAP_32(em->fifo[fifoPpPtr].info));
+        if (txReady && em->rateLimitPendingValid) {
+  #if (CO_CONFIG_EM) & CO_CONFIG_EM_PROD_INHIBIT
+            em->inhibitEmTimer = 0;
+  #endif
+            em->rateLimitPendingValid = false;
+            sendEmergency(em, em->rateLimitPending.msg,
+                          em->rateLimitPending.info, errorRegister);
+            /* send slot is free, take the next entry from the fifo */
+            fifoPpPtr = rateLimitPoll(em, fifoPpPtr, errorRegister);
+        }
+        else if (txReady && rateLimitSummary(em, errorRegister)) {
+  #if (CO_CONFIG_EM) & CO_CONFIG_EM_PROD_INHIBIT
+            em->inhibitEmTimer = 0;
+  #endif
+        }
+ #else
+        if (FIFO_PP_READY(em, fifoPpPtr) && txReady) {
+  #if (CO_CONFIG_EM) & CO_CONFIG_EM_PROD_INHIBIT
+            em->inhibitEmTimer = 0;
+  #endif
+            /* add error register to emergency message */
+            em->fifo[fifoPpPtr].msg |= (uint32_t) errorRegister << 16;
+  #if (CO_CONFIG_EM) & CO_CONFIG_EM_HISTORY_STORE
+            if (em->pFunctHistoryAppend != NULL) {
+                em->pFunctHistoryAppend(em->functHistoryObject,
+                                        em->fifo[fifoPpPtr].msg,
+                                        em->fifo[fifoPpPtr].info);
             }
- #endif
-
-            /* increment pointer */
-            em->fifoPpPtr = (++fifoPpPtr < em->fifoSize) ? fifoPpPtr : 0;
+  #endif
 
-            /* verify message buffer overflow. Clear error condition if all
-             * messages from fifo buffer are processed */
-            if (em->fifoOverflow == 1) {
-                em->fifoOverflow = 2;
-                CO_errorReport(em, CO_EM_EMERGENCY_BUFFER_FULL,
-                               CO_EMC_GENERIC, 0);
-            }
-            else if (em->fifoOverflow == 2 && em->fifoPpPtr == em->fifoWrPtr) {
-                em->fifoOverflow = 0;
-                CO_errorReset(em, CO_EM_EMERGENCY_BUFFER_FULL, 0);
-            }
+            /* send emergency message and increment pointer */
+            sendEmergency(em, em->fifo[fifoPpPtr].msg,
+                          em->fifo[fifoPpPtr].info, errorRegister);
+            fifoPpAdvance(em, fifoPpPtr);
         }
+ #endif
  #if (CO_CONFIG_EM) & CO_CONFIG_EM_PROD_INHIBIT
   #if (CO_CONFIG_EM) & CO_CONFIG_FLAG_TIMERNEXT
         else if (timerNext_us != NULL
@@ -688,20 +1145,43 @@ void CO_EM_process(CO_EM_t *em,
             }
         }
   #endif
+ #endif
+ #if ((CO_CONFIG_EM) & CO_CONFIG_EM_PROD_RATE_LIMIT) \
+     && ((CO_CONFIG_EM) & CO_CONFIG_FLAG_TIMERNEXT)
+        if (timerNext_us != NULL) {
+            rateLimitTimerNext(em, timerNext_us);
+        }
+ #endif
+ #if (CO_CONFIG_EM) & CO_CONFIG_EM_LOCK_FREE
+        fifoResync(em);
  #endif
     }
 #elif (CO_CONFIG_EM) & CO_CONFIG_EM_HISTORY
     if (em->fifoSize >= 2) {
         uint8_t fifoPpPtr = em->fifoPpPtr;
-        while (fifoPpPtr != em->fifoWrPtr) {
+        while (FIFO_PP_READY(em, fifoPpPtr)) {
             /* add error register to emergency message and increment pointers */
             em->fifo[fifoPpPtr].msg |= (uint32_t) errorRegister << 16;
+ #if (CO_CONFIG_EM) & CO_CONFIG_EM_HISTORY_STORE
+            if (em->pFunctHistoryAppend != NULL) {
+                em->pFunctHistoryAppend(em->functHistoryObject,
+                                        em->fifo[fifoPpPtr].msg, 0);
+            }
+ #endif
+ #if (CO_CONFIG_EM) & CO_CONFIG_EM_LOCK_FREE
+            fifoPpRelease(em, fifoPpPtr);
+ #endif
 
             if (++fifoPpPtr >= em->fifoSize) {
                 fifoPpPtr = 0;
             }
         }
+ #if (CO_CONFIG_EM) & CO_CONFIG_EM_LOCK_FREE
+        CO_EM_ATOMIC_STORE(&em->fifoPpPtr, fifoPpPtr);
+        fifoResync(em);
+ #else
         em->fifoPpPtr = fifoPpPtr;
+ #endif
     }
 #endif /* (CO_CONFIG_EM) & CO_CONFIG_EM_PRODUCER, #elif CO_CONFIG_EM_HISTORY */
 
@@ -727,6 +1207,24 @@ void CO_error(CO_EM_t *em, bool_t setError, const uint8_t errorBit,
     }
 
     uint8_t *errorStatusBits = &em->errorStatusBits[index];
+
+#if (CO_CONFIG_EM) & CO_CONFIG_EM_LOCK_FREE
+    /* Toggle bit atomically. Only the caller, which changed it, continues with
+     * error indication. */
+    if (setError) {
+        if ((CO_EM_ATOMIC_FETCH_OR(errorStatusBits, bitmask) & bitmask) != 0) {
+            return;
+        }
+    }
+    else {
+        if ((CO_EM_ATOMIC_FETCH_AND(errorStatusBits, (uint8_t)~bitmask)
+             & bitmask) == 0
+        ) {
+            return;
+        }
+        errorCode = CO_EMC_NO_ERROR;
+    }
+#else
     uint8_t errorStatusBitMasked = *errorStatusBits & bitmask;
 
     /* If error is already set (or unset), return without further actions,
@@ -742,6 +1240,7 @@ void CO_error(CO_EM_t *em, bool_t setError, const uint8_t errorBit,
         }
         errorCode = CO_EMC_NO_ERROR;
     }
+#endif
 
 #if (CO_CONFIG_EM) & (CO_CONFIG_EM_PRODUCER | CO_CONFIG_EM_HISTORY)
     /* prepare emergency message. Error register will be added in post-process*/
@@ -751,6 +1250,19 @@ void CO_error(CO_EM_t *em, bool_t setError, const uint8_t errorBit,
  #endif
 #endif
 
+#if (CO_CONFIG_EM) & CO_CONFIG_EM_LOCK_FREE
+ #if (CO_CONFIG_EM) & (CO_CONFIG_EM_PRODUCER | CO_CONFIG_EM_HISTORY)
+    if (em->fifoSize >= 2) {
+        /* On overflow fifoOverflow is set and fifoCount is left unchanged, as
+         * in locked path. Lost state is repeated later by fifoResync(). */
+  #if (CO_CONFIG_EM) & CO_CONFIG_EM_PRODUCER
+        (void)fifoPutLockFree(em, errMsg, infoCodeSwapped, setError);
+  #else
+        (void)fifoPutLockFree(em, errMsg, 0, setError);
+  #endif
+    }
+ #endif
+#else
     /* safely write data, and increment pointers */
     CO_LOCK_EMCY(em->CANdevTx);
     if (setError) *errorStatusBits |= bitmask;
@@ -779,6 +1291,7 @@ void CO_error(CO_EM_t *em, bool_t setError, const uint8_t errorBit,
 #endif /* (CO_CONFIG_EM) & (CO_CONFIG_EM_PRODUCER | CO_CONFIG_EM_HISTORY) */
 
     CO_UNLOCK_EMCY(em->CANdevTx);
+#endif /* (CO_CONFIG_EM) & CO_CONFIG_EM_LOCK_FREE */
 
 #if (CO_CONFIG_EM) & CO_CONFIG_FLAG_CALLBACK_PRE
  #if (CO_CONFIG_EM) & CO_CONFIG_EM_PRODUCER
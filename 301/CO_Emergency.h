@@ -36,9 +36,15 @@
                       CO_CONFIG_GLOBAL_FLAG_CALLBACK_PRE | \
                       CO_CONFIG_GLOBAL_FLAG_TIMERNEXT)
 #endif
+#ifndef CO_CONFIG_EM_AGG
+#define CO_CONFIG_EM_AGG (0)
+#endif
 #ifndef CO_CONFIG_EM_ERR_STATUS_BITS_COUNT
 #define CO_CONFIG_EM_ERR_STATUS_BITS_COUNT (10*8)
 #endif
+#ifndef CO_CONFIG_EM_RATE_LIMIT_MS
+#define CO_CONFIG_EM_RATE_LIMIT_MS 100
+#endif
 #ifndef CO_CONFIG_ERR_CONDITION_GENERIC
 #define CO_CONFIG_ERR_CONDITION_GENERIC (em->errorStatusBits[5] != 0)
 #endif
@@ -51,6 +57,37 @@
                                            || em->errorStatusBits[9])
 #endif
 
+#if ((CO_CONFIG_EM) & CO_CONFIG_EM_LOCK_FREE) || defined CO_DOXYGEN
+/* Default atomic operations use GCC builtins. They may be overridden in
+ * CO_driver_target.h, for example with C11 <stdatomic.h>. */
+#ifndef CO_EM_ATOMIC_LOAD
+/** Atomic load of the variable, with acquire semantics */
+#define CO_EM_ATOMIC_LOAD(ptr) __atomic_load_n(ptr, __ATOMIC_ACQUIRE)
+#endif
+#ifndef CO_EM_ATOMIC_STORE
+/** Atomic store to the variable, with release semantics */
+#define CO_EM_ATOMIC_STORE(ptr, val) \
+    __atomic_store_n(ptr, val, __ATOMIC_RELEASE)
+#endif
+#ifndef CO_EM_ATOMIC_CAS
+/** Atomic compare and swap. If *ptr equals *expected, then desired is written
+ * and true returned. Otherwise *expected is updated with *ptr. */
+#define CO_EM_ATOMIC_CAS(ptr, expected, desired) \
+    __atomic_compare_exchange_n(ptr, expected, desired, false, \
+                                __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)
+#endif
+#ifndef CO_EM_ATOMIC_FETCH_OR
+/** Atomic bitwise or, returns previous value */
+#define CO_EM_ATOMIC_FETCH_OR(ptr, val) \
+    __atomic_fetch_or(ptr, val, __ATOMIC_ACQ_REL)
+#endif
+#ifndef CO_EM_ATOMIC_FETCH_AND
+/** Atomic bitwise and, returns previous value */
+#define CO_EM_ATOMIC_FETCH_AND(ptr, val) \
+    __atomic_fetch_and(ptr, val, __ATOMIC_ACQ_REL)
+#endif
+#endif /* (CO_CONFIG_EM) & CO_CONFIG_EM_LOCK_FREE */
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -98,7 +135,56 @@ extern "C" {
  *
  * ### Emergency consumer
  * If @ref CO_CONFIG_EM has CO_CONFIG_EM_CONSUMER enabled, then callback can be
- * registered by @ref CO_EM_initCallbackRx() function.
+ * registered by @ref CO_EM_initCallbackRx() function. Table of active errors of
+ * all nodes on the network is kept by @ref CO_EMaggregator.
+ *
+ * ### Lock-free error reporting
+ * If @ref CO_CONFIG_EM has CO_CONFIG_EM_LOCK_FREE enabled, then CO_error() may
+ * be called from many threads without CO_LOCK_EMCY(). Error status bit is
+ * changed with atomic or/and, so only one caller reports the change. Fifo
+ * entry is then reserved by compare-and-swap of the write pointer and marked
+ * ready after it is written. CO_EM_process() (single consumer) sends entries
+ * in reservation order and waits on entry, which is reserved but not yet
+ * ready. Bit change and reservation are two steps, so entries of different
+ * threads for the same error bit may be reserved in different order than the
+ * bit was changed. CO_EM_process() therefore keeps the state of each bit from
+ * the last processed entry. When all entries are processed and error bit
+ * differs from it, the entry for actual state is put into fifo again: the last
+ * processed message, which set the bit, or message with error code 0. Final
+ * state on the bus then always matches the error bit, but messages in between
+ * may come in different order or once more. Fifo overflow is handled as
+ * without the option.
+ *
+ * ### Persistent error history
+ * If @ref CO_CONFIG_EM has CO_CONFIG_EM_HISTORY_STORE enabled, then each entry
+ * of the error history is passed to the callback from
+ * CO_EM_initHistoryStore(), after it is post-processed by CO_EM_process().
+ * Callback is also called, when history is cleared by writing 0 to 0x1003,00.
+ * After reset, stored history is put back by CO_EM_historyRestore(). See
+ * @ref CO_storage_emHistory for the implementation, which writes the history
+ * into the storage.
+ *
+ * ### Rate limiting
+ * Inhibit time (OD object 0x1015) is common to all emergency messages. Error,
+ * which is set and reset very often, may fill the fifo, so other messages are
+ * delayed or lost by fifo overflow. If @ref CO_CONFIG_EM has
+ * CO_CONFIG_EM_PROD_RATE_LIMIT enabled, then CO_EM_process() limits messages
+ * per error status bit (@ref CO_EM_errorStatusBits_t):
+ * - The first message of the error status bit is sent as usual and starts
+ *   the rate limit window, see CO_EM_setRateLimit().
+ * - Further messages of the same error status bit inside the window are not
+ *   sent. They are counted and removed from the fifo immediately, so the
+ *   fifo does not overflow. They are still recorded in the error history.
+ * - When the window elapses and messages were counted, a summary message is
+ *   sent and the new window is started. Summary contains bytes 0..3 of the
+ *   last counted message (error code of the last set or reset, actual error
+ *   register and error status bit). Bytes 4..7 contain number of counted
+ *   messages, uint32_t, instead of the information code.
+ *
+ * Message, which must be sent, is taken from the fifo into the send slot,
+ * where it waits for the inhibit time. So messages behind it are counted and
+ * do not fill the fifo. Messages from the fifo have priority over summary
+ * messages. All are sent with respect to the inhibit time.
  */
 
 
@@ -370,9 +456,30 @@ typedef struct {
 #if ((CO_CONFIG_EM) & CO_CONFIG_EM_PRODUCER) || defined CO_DOXYGEN
     uint32_t info;
 #endif
+#if ((CO_CONFIG_EM) & CO_CONFIG_EM_LOCK_FREE) || defined CO_DOXYGEN
+    /** Set by CO_error() after entry is written, cleared by CO_EM_process()
+     * after entry is processed */
+    uint8_t ready;
+    /** True, if entry sets the error status bit, false if it resets it */
+    uint8_t setError;
+#endif
 } CO_EM_fifo_t;
 #endif
 
+#if ((CO_CONFIG_EM) & CO_CONFIG_EM_PROD_RATE_LIMIT) || defined CO_DOXYGEN
+/**
+ * Rate limit state of one error status bit
+ */
+typedef struct {
+    /** Time of the last sent message, compared with rateLimitClock_us */
+    uint32_t sent_us;
+    /** Bytes 0..3 of the last counted emergency message */
+    uint32_t msg;
+    /** Number of messages counted since the last sent message */
+    uint16_t count;
+} CO_EM_rateLimit_t;
+#endif
+
 
 /**
  * Emergency object.
@@ -398,9 +505,16 @@ typedef struct {
     CO_EM_fifo_t *fifo;
     /** Size of the above buffer, specified by @ref CO_EM_init(). */
     uint8_t fifoSize;
+#if ((CO_CONFIG_EM) & CO_CONFIG_EM_LOCK_FREE) || defined CO_DOXYGEN
+    /** Pointer for the fifo buffer, where next emergency message will be
+     * reserved by @ref CO_error() function, in bits 0..7. Bits 8..31 count
+     * reservations, so compare-and-swap doesn't succeed with stale value. */
+    uint32_t fifoWrTicket;
+#else
     /** Pointer for the fifo buffer, where next emergency message will be
      * written by @ref CO_error() function. */
     uint8_t fifoWrPtr;
+#endif
     /** Pointer for the fifo, where next emergency message has to be
      * post-processed by @ref CO_EM_process() function. If equal to bufWrPtr,
      * then all messages has been post-processed. */
@@ -409,6 +523,18 @@ typedef struct {
     uint8_t fifoOverflow;
     /** Count of emergency messages in fifo, used for OD object 0x1003 */
     uint8_t fifoCount;
+#if ((CO_CONFIG_EM) & CO_CONFIG_EM_LOCK_FREE) || defined CO_DOXYGEN
+    /** Error status bits, as set or reset by the last processed fifo entry
+     * for each bit. Compared with errorStatusBits by CO_EM_process(). */
+    uint8_t fifoStatusBits[CO_CONFIG_EM_ERR_STATUS_BITS_COUNT / 8];
+    /** Bytes 0..3 of the last processed message, which set the error status
+     * bit, for each bit, 0 if none. Error register is not included. */
+    uint32_t fifoLastSetMsg[CO_CONFIG_EM_ERR_STATUS_BITS_COUNT];
+ #if ((CO_CONFIG_EM) & CO_CONFIG_EM_PRODUCER) || defined CO_DOXYGEN
+    /** Bytes 4..7 of the message in fifoLastSetMsg */
+    uint32_t fifoLastSetInfo[CO_CONFIG_EM_ERR_STATUS_BITS_COUNT];
+ #endif
+#endif
 #endif /* (CO_CONFIG_EM) & (CO_CONFIG_EM_PRODUCER | CO_CONFIG_EM_HISTORY) */
 
 #if ((CO_CONFIG_EM) & CO_CONFIG_EM_PRODUCER) || defined CO_DOXYGEN
@@ -434,6 +560,24 @@ typedef struct {
     /** Extension for OD object */
     OD_extension_t OD_1015_extension;
  #endif
+ #if ((CO_CONFIG_EM) & CO_CONFIG_EM_PROD_RATE_LIMIT) || defined CO_DOXYGEN
+    /** Rate limit state for each error status bit */
+    CO_EM_rateLimit_t rateLimit[CO_CONFIG_EM_ERR_STATUS_BITS_COUNT];
+    /** Bitfield of error status bits with the rate limit window running */
+    uint8_t rateLimitActive[CO_CONFIG_EM_ERR_STATUS_BITS_COUNT / 8];
+    /** Rate limit window, 0 if disabled, from CO_EM_setRateLimit() */
+    uint32_t rateLimitWindow_us;
+    /** Free running time, incremented by CO_EM_process() */
+    uint32_t rateLimitClock_us;
+    /** Next message to send, taken from the fifo */
+    CO_EM_fifo_t rateLimitPending;
+    /** True, if rateLimitPending contains the message */
+    bool_t rateLimitPendingValid;
+    /** Number of messages, which were counted and not sent */
+    uint32_t rateLimitCoalesced;
+    /** Number of sent summary messages */
+    uint32_t rateLimitSummaries;
+ #endif
 #endif /* (CO_CONFIG_EM) & CO_CONFIG_EM_PRODUCER */
 
 #if ((CO_CONFIG_EM) & CO_CONFIG_EM_HISTORY) || defined CO_DOXYGEN
@@ -455,6 +599,24 @@ typedef struct {
                            const uint32_t infoCode);
 #endif
 
+#if ((CO_CONFIG_EM_AGG) & CO_CONFIG_EM_AGG_ENABLE) || defined CO_DOXYGEN
+    /** Receive hook of @ref CO_EMaggregator, set by CO_EMagg_init() */
+    void (*pFunctSignalRxAgg)(void *object,
+                              uint16_t ident,
+                              const uint8_t *data);
+    /** Object for pFunctSignalRxAgg(), set by CO_EMagg_init() */
+    void *functSignalObjectRxAgg;
+#endif
+
+#if ((CO_CONFIG_EM) & CO_CONFIG_EM_HISTORY_STORE) || defined CO_DOXYGEN
+    /** From CO_EM_initHistoryStore() or NULL */
+    void (*pFunctHistoryAppend)(void *object, uint32_t msg, uint32_t info);
+    /** From CO_EM_initHistoryStore() or NULL */
+    void (*pFunctHistoryClear)(void *object);
+    /** From CO_EM_initHistoryStore() or NULL */
+    void *functHistoryObject;
+#endif
+
 #if ((CO_CONFIG_EM) & CO_CONFIG_FLAG_CALLBACK_PRE) || defined CO_DOXYGEN
     /** From CO_EM_initCallbackPre() or NULL */
     void (*pFunctSignalPre)(void *object);
@@ -573,6 +735,67 @@ void CO_EM_initCallbackRx(CO_EM_t *em,
 #endif
 
 
+#if ((CO_CONFIG_EM) & CO_CONFIG_EM_HISTORY_STORE) || defined CO_DOXYGEN
+/**
+ * Initialize callback functions for persistent error history.
+ *
+ * pFunctAppend() is called from CO_EM_process() for each new entry of the
+ * error history, after error register is added to it. Arguments _msg_ and
+ * _info_ are the same as in @ref CO_EM_fifo_t, _info_ is 0, if
+ * CO_CONFIG_EM_PRODUCER is not enabled. pFunctClear() is called, when error
+ * history is cleared by writing 0 to OD object 0x1003,00. Both functions
+ * should be fast, actual storing should be done outside CO_EM_process().
+ *
+ * Callbacks are cleared by CO_EM_init().
+ *
+ * @param em This object.
+ * @param object Pointer to object, which will be passed to the callbacks. Can
+ * be NULL.
+ * @param pFunctAppend Pointer to the callback function. Not called if NULL.
+ * @param pFunctClear Pointer to the callback function. Not called if NULL.
+ */
+void CO_EM_initHistoryStore(CO_EM_t *em,
+                            void *object,
+                            void (*pFunctAppend)(void *object,
+                                                 uint32_t msg,
+                                                 uint32_t info),
+                            void (*pFunctClear)(void *object));
+
+
+/**
+ * Put stored entry back into the error history.
+ *
+ * Function must be called after CO_EM_init(), for each stored entry from the
+ * oldest to the newest, before errors are reported. Entry is added to OD
+ * object 0x1003 as already processed, so emergency message is not sent and
+ * callback from CO_EM_initHistoryStore() is not called.
+ *
+ * @param em This object.
+ * @param msg Entry of the error history, as in @ref CO_EM_fifo_t.
+ * @param info Information code, as in @ref CO_EM_fifo_t.
+ *
+ * @return True on success or false, if there are not processed messages in
+ * the fifo.
+ */
+bool_t CO_EM_historyRestore(CO_EM_t *em, uint32_t msg, uint32_t info);
+#endif
+
+
+#if ((CO_CONFIG_EM) & CO_CONFIG_EM_PROD_RATE_LIMIT) || defined CO_DOXYGEN
+/**
+ * Set rate limit window for emergency messages.
+ *
+ * See @ref CO_Emergency, Rate limiting. CO_EM_init() sets the window to
+ * @ref CO_CONFIG_EM_RATE_LIMIT_MS. Counted messages are kept, if window is
+ * changed. If window is disabled, they are sent as summary messages.
+ *
+ * @param em This object.
+ * @param window_ms Window in milliseconds, 0 disables rate limiting.
+ */
+void CO_EM_setRateLimit(CO_EM_t *em, uint16_t window_ms);
+#endif
+
+
 /**
  * Process Error control and Emergency object.
  *
@@ -602,7 +825,8 @@ void CO_EM_process(CO_EM_t *em,
  * before). If changed, then Emergency message is prepared and record in history
  * is added. Emergency message is later sent by CO_EM_process() function.
  *
- * Function is short and thread safe.
+ * Function is short and thread safe. With CO_CONFIG_EM_LOCK_FREE it is also
+ * lock-free, see @ref CO_Emergency.
  *
  * @param em Emergency object.
  * @param setError True if error occurred or false if error resolved.
@@ -33,6 +33,7 @@
 #error CO_CONFIG_HB_CONS_CALLBACK_CHANGE and CO_CONFIG_HB_CONS_CALLBACK_MULTI cannot be set simultaneously!
 #endif
 
+#if !((CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_NODE_INDEXED)
 /*
  * Read received message from CAN module.
  *
@@ -57,6 +58,364 @@ static void CO_HBcons_receive(void *object, void *msg) {
 #endif
     }
 }
+#else /* (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_NODE_INDEXED */
+
+
+/*
+ * Read received message from CAN module, node-ID indexed variant.
+ *
+ * All Heartbeat messages are received here and monitored node is found by
+ * node-ID. Messages from other nodes are forwarded. For description of
+ * parameters see file CO_driver.h.
+ */
+static void CO_HBcons_receiveIndexed(void *object, void *msg) {
+    CO_HBconsumer_t *HBcons = object;
+    uint8_t DLC = CO_CANrxMsg_readDLC(msg);
+    uint8_t *data = CO_CANrxMsg_readData(msg);
+    uint8_t nodeId = (uint8_t)(CO_CANrxMsg_readIdent(msg) & 0x7FU);
+    uint8_t idx = HBcons->idxByNodeId[nodeId];
+
+    if (DLC == 1 && idx != CO_HBCONS_IDX_NONE) {
+        CO_HBconsNode_t *HBconsNode = &HBcons->monitoredNodes[idx];
+
+        /* copy data and set 'new message' flag, then the group flag */
+        HBconsNode->NMTstate = (CO_NMT_internalState_t)data[0];
+        CO_FLAG_SET(HBconsNode->CANrxNew);
+        CO_FLAG_SET(HBcons->CANrxPending[idx / CO_HBCONS_PENDING_GROUP]);
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_FLAG_CALLBACK_PRE
+        /* Optional signal to RTOS, which can resume task, which handles HBcons. */
+        if (HBconsNode->pFunctSignalPre != NULL) {
+            HBconsNode->pFunctSignalPre(HBconsNode->functSignalObjectPre);
+        }
+#endif
+    }
+    else if (idx == CO_HBCONS_IDX_NONE && HBcons->pFunctForward != NULL) {
+        HBcons->pFunctForward(HBcons->functForwardObject, msg);
+    }
+}
+
+
+/* Timer heap helpers. Heap keeps active monitored nodes ordered by deadline,
+ * deadlines are compared with overflow of the timer. */
+static inline bool_t deadlineBefore(CO_HBconsumer_t *HBcons,
+                                    uint8_t idxA, uint8_t idxB)
+{
+    return (int32_t)(HBcons->monitoredNodes[idxA].deadline_us
+                     - HBcons->monitoredNodes[idxB].deadline_us) < 0;
+}
+
+static inline void heapPlace(CO_HBconsumer_t *HBcons,
+                             uint8_t pos, uint8_t idx)
+{
+    HBcons->timerHeap[pos] = idx;
+    HBcons->monitoredNodes[idx].heapPos = pos;
+}
+
+static void heapSiftUp(CO_HBconsumer_t *HBcons, uint8_t pos) {
+    uint8_t idx = HBcons->timerHeap[pos];
+
+    while (pos > 0) {
+        uint8_t parent = (uint8_t)((pos - 1U) / 2U);
+        if (!deadlineBefore(HBcons, idx, HBcons->timerHeap[parent])) {
+            break;
+        }
+        heapPlace(HBcons, pos, HBcons->timerHeap[parent]);
+        pos = parent;
+    }
+    heapPlace(HBcons, pos, idx);
+}
+
+static void heapSiftDown(CO_HBconsumer_t *HBcons, uint8_t pos) {
+    uint8_t idx = HBcons->timerHeap[pos];
+
+    for (;;) {
+        uint16_t child = (uint16_t)pos * 2U + 1U;
+        if (child >= HBcons->timerHeapCount) {
+            break;
+        }
+        if (child + 1U < HBcons->timerHeapCount
+            && deadlineBefore(HBcons, HBcons->timerHeap[child + 1U],
+                              HBcons->timerHeap[child])
+        ) {
+            child++;
+        }
+        if (!deadlineBefore(HBcons, HBcons->timerHeap[child], idx)) {
+            break;
+        }
+        heapPlace(HBcons, pos, HBcons->timerHeap[child]);
+        pos = (uint8_t)child;
+    }
+    heapPlace(HBcons, pos, idx);
+}
+
+/* Set new deadline of the monitored node and add it to the timer heap */
+static void timerSet(CO_HBconsumer_t *HBcons,
+                     uint8_t idx, uint32_t deadline_us)
+{
+    CO_HBconsNode_t *monitoredNode = &HBcons->monitoredNodes[idx];
+
+    monitoredNode->deadline_us = deadline_us;
+    if (monitoredNode->heapPos == CO_HBCONS_IDX_NONE) {
+        heapPlace(HBcons, HBcons->timerHeapCount++, idx);
+    }
+    heapSiftUp(HBcons, monitoredNode->heapPos);
+    heapSiftDown(HBcons, monitoredNode->heapPos);
+}
+
+/* Remove the monitored node from the timer heap, if it is there */
+static void timerRemove(CO_HBconsumer_t *HBcons, uint8_t idx) {
+    CO_HBconsNode_t *monitoredNode = &HBcons->monitoredNodes[idx];
+    uint8_t pos = monitoredNode->heapPos;
+
+    if (pos == CO_HBCONS_IDX_NONE) {
+        return;
+    }
+    monitoredNode->heapPos = CO_HBCONS_IDX_NONE;
+    HBcons->timerHeapCount--;
+    if (pos < HBcons->timerHeapCount) {
+        /* move the last node to the free position */
+        uint8_t idxLast = HBcons->timerHeap[HBcons->timerHeapCount];
+        heapPlace(HBcons, pos, idxLast);
+        heapSiftUp(HBcons, pos);
+        heapSiftDown(HBcons, HBcons->monitoredNodes[idxLast].heapPos);
+    }
+}
+
+/* Update counters of active and NMT operational nodes after state change */
+static void countersUpdate(CO_HBconsumer_t *HBcons, uint8_t idx) {
+    CO_HBconsNode_t *monitoredNode = &HBcons->monitoredNodes[idx];
+    bool_t active = monitoredNode->HBstate == CO_HBconsumer_ACTIVE;
+    bool_t operational = monitoredNode->NMTstate == CO_NMT_OPERATIONAL;
+
+    if (active != monitoredNode->countedActive) {
+        if (active) HBcons->countActive++;
+        else HBcons->countActive--;
+        monitoredNode->countedActive = active;
+    }
+    if (operational != monitoredNode->countedOperational) {
+        if (operational) HBcons->countOperational++;
+        else HBcons->countOperational--;
+        monitoredNode->countedOperational = operational;
+    }
+}
+#endif /* (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_NODE_INDEXED */
+
+
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_STATE_TRACKER
+/* Write tracked states of the monitored node into the bitmaps and mark the
+ * node as changed. States may be non-zero only for valid node-ID. */
+static void trackerWrite(CO_HBconsumer_t *HBcons, uint8_t idx, uint8_t states) {
+    CO_HBconsNode_t * const monitoredNode = &HBcons->monitoredNodes[idx];
+    uint8_t diff = states ^ monitoredNode->trackedStates;
+
+    if (diff == 0) {
+        return;
+    }
+
+    uint8_t w = (monitoredNode->nodeId >> 5) & 3U;
+    uint32_t bit = (uint32_t)1U << (monitoredNode->nodeId & 0x1FU);
+    for (uint8_t i = 0; i < CO_HBCONS_TRACK_COUNT; i++) {
+        if ((diff & (1U << i)) != 0) {
+            HBcons->tracker.state[i].w[w] ^= bit;
+        }
+    }
+    HBcons->trackerChanged.w[w] |= bit;
+    monitoredNode->trackedStates = states;
+    monitoredNode->transitions++;
+}
+
+/* Update tracked states of the monitored node from its HB and NMT state */
+static void trackerUpdate(CO_HBconsumer_t *HBcons, uint8_t idx) {
+    CO_HBconsNode_t * const monitoredNode = &HBcons->monitoredNodes[idx];
+    uint8_t states = 0;
+
+    if (monitoredNode->nodeId == 0 || monitoredNode->nodeId > 127U
+        || monitoredNode->HBstate == CO_HBconsumer_UNCONFIGURED
+    ) {
+        /* node is not tracked */
+    }
+    else if (monitoredNode->HBstate == CO_HBconsumer_ACTIVE) {
+        states = (1U << CO_HBCONS_TRACK_CONFIGURED)
+               | (1U << CO_HBCONS_TRACK_ACTIVE);
+        switch (monitoredNode->NMTstate) {
+            case CO_NMT_PRE_OPERATIONAL:
+                states |= 1U << CO_HBCONS_TRACK_PRE_OPERATIONAL; break;
+            case CO_NMT_OPERATIONAL:
+                states |= 1U << CO_HBCONS_TRACK_OPERATIONAL; break;
+            case CO_NMT_STOPPED:
+                states |= 1U << CO_HBCONS_TRACK_STOPPED; break;
+            default: break;
+        }
+    }
+    else if (monitoredNode->HBstate == CO_HBconsumer_TIMEOUT) {
+        states = (1U << CO_HBCONS_TRACK_CONFIGURED)
+               | (1U << CO_HBCONS_TRACK_TIMEOUT);
+    }
+    else {
+        states = 1U << CO_HBCONS_TRACK_CONFIGURED;
+    }
+    trackerWrite(HBcons, idx, states);
+}
+
+/* Notify all changes since the previous notification at once */
+static void trackerNotify(CO_HBconsumer_t *HBcons) {
+    uint32_t changed = 0;
+
+    for (uint8_t i = 0; i < CO_HBCONS_BITMAP_WORDS; i++) {
+        changed |= HBcons->trackerChanged.w[i];
+    }
+    if (changed == 0) {
+        return;
+    }
+
+    HBcons->tracker.changed = HBcons->trackerChanged;
+    memset(&HBcons->trackerChanged, 0, sizeof(HBcons->trackerChanged));
+    HBcons->tracker.sequence++;
+    if (HBcons->pFunctSignalStateChanged != NULL) {
+        HBcons->pFunctSignalStateChanged(&HBcons->tracker,
+                                         HBcons->functSignalObjectStateChanged);
+    }
+}
+#endif /* (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_STATE_TRACKER */
+
+
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_STATISTICS
+/* Add interval since the previous Heartbeat to the statistics */
+static void statUpdate(CO_HBconsumer_t *HBcons, CO_HBconsNode_t *monitoredNode)
+{
+    CO_HBconsStat_t *stat = &monitoredNode->stat;
+    uint32_t interval = HBcons->timer_us - stat->lastRx_us;
+    uint32_t bin = CO_HBCONS_STAT_BINS - 1U;
+
+    stat->lastRx_us = HBcons->timer_us;
+    if (!stat->lastRxValid) {
+        /* first Heartbeat, no interval yet */
+        stat->lastRxValid = true;
+        return;
+    }
+
+    if (stat->count == 0) {
+        stat->intervalMin_us = interval;
+        stat->intervalMax_us = interval;
+        stat->intervalAvg_us = interval;
+    }
+    else {
+        if (interval < stat->intervalMin_us) stat->intervalMin_us = interval;
+        if (interval > stat->intervalMax_us) stat->intervalMax_us = interval;
+        if (interval > stat->intervalAvg_us) {
+            stat->intervalAvg_us += (interval - stat->intervalAvg_us) >> 3;
+        }
+        else {
+            stat->intervalAvg_us -= (stat->intervalAvg_us - interval) >> 3;
+        }
+    }
+    stat->count++;
+
+    /* interval is shorter than consumer time, so multiplication can't
+     * overflow */
+    if (interval < monitoredNode->time_us) {
+        bin = (interval * CO_HBCONS_STAT_BINS) / monitoredNode->time_us;
+    }
+    if (stat->histogram[bin] < 0xFFFFU) {
+        stat->histogram[bin]++;
+    }
+    if (bin >= CO_HBCONS_STAT_LATE_BIN && stat->late < 0xFFFFU) {
+        stat->late++;
+    }
+}
+
+
+/*
+ * Custom function for reading OD object with Heartbeat statistics
+ *
+ * For more information see file CO_ODinterface.h, OD_IO_t.
+ */
+static ODR_t OD_read_statistics(OD_stream_t *stream, void *buf,
+                                OD_size_t count, OD_size_t *countRead)
+{
+    if (stream == NULL || buf == NULL || countRead == NULL) {
+        return ODR_DEV_INCOMPAT;
+    }
+
+    CO_HBconsumer_t *HBcons = stream->object;
+    uint8_t statBuf[CO_HBCONS_STAT_OD_SIZE];
+    uint8_t *b = statBuf;
+
+    if (stream->subIndex == 0) {
+        return OD_readOriginal(stream, buf, count, countRead);
+    }
+    if (stream->subIndex > HBcons->numberOfMonitoredNodes) {
+        return ODR_SUB_NOT_EXIST;
+    }
+
+    const CO_HBconsStat_t *stat =
+        &HBcons->monitoredNodes[stream->subIndex - 1].stat;
+    b += CO_setUint32(b, stat->count);
+    b += CO_setUint32(b, stat->intervalMin_us);
+    b += CO_setUint32(b, stat->intervalAvg_us);
+    b += CO_setUint32(b, stat->intervalMax_us);
+    b += CO_setUint16(b, stat->late);
+    for (uint8_t i = 0; i < CO_HBCONS_STAT_BINS; i++) {
+        b += CO_setUint16(b, stat->histogram[i]);
+    }
+
+    /* statistics may be read in several segments */
+    OD_size_t offset = stream->dataOffset;
+    OD_size_t len = CO_HBCONS_STAT_OD_SIZE - offset;
+    ODR_t returnCode = ODR_OK;
+
+    if (offset >= CO_HBCONS_STAT_OD_SIZE) {
+        return ODR_DEV_INCOMPAT;
+    }
+    stream->dataLength = CO_HBCONS_STAT_OD_SIZE;
+    if (len > count) {
+        len = count;
+        stream->dataOffset += len;
+        returnCode = ODR_PARTIAL;
+    }
+    else {
+        stream->dataOffset = 0;
+    }
+    memcpy(buf, &statBuf[offset], len);
+
+    *countRead = len;
+    return returnCode;
+}
+
+
+/* Statistics are read only */
+static ODR_t OD_write_statistics(OD_stream_t *stream, const void *buf,
+                                 OD_size_t count, OD_size_t *countWritten)
+{
+    (void)stream; (void)buf; (void)count; (void)countWritten;
+    return ODR_READONLY;
+}
+#endif /* (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_STATISTICS */
+
+
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_CALLBACK_CHANGE \
+    || (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_CALLBACK_MULTI
+/* Verify, if NMT state of monitored node changed and signal it */
+static void nmtChangedSignal(CO_HBconsumer_t *HBcons, uint8_t idx) {
+    CO_HBconsNode_t * const monitoredNode = &HBcons->monitoredNodes[idx];
+
+    if(monitoredNode->NMTstate != monitoredNode->NMTstatePrev) {
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_CALLBACK_CHANGE
+        if (HBcons->pFunctSignalNmtChanged != NULL) {
+            HBcons->pFunctSignalNmtChanged(
+                monitoredNode->nodeId, idx, monitoredNode->NMTstate,
+                HBcons->pFunctSignalObjectNmtChanged);
+#else
+        if (monitoredNode->pFunctSignalNmtChanged != NULL) {
+            monitoredNode->pFunctSignalNmtChanged(
+                monitoredNode->nodeId, idx, monitoredNode->NMTstate,
+                monitoredNode->pFunctSignalObjectNmtChanged);
+#endif
+        }
+        monitoredNode->NMTstatePrev = monitoredNode->NMTstate;
+    }
+}
+#endif
 
 
 /*
@@ -142,6 +501,36 @@ CO_ReturnError_t CO_HBconsumer_init(CO_HBconsumer_t *HBcons,
         OD_1016_HBcons->subEntriesCount-1 < monitoredNodesCount ?
         OD_1016_HBcons->subEntriesCount-1 : monitoredNodesCount;
 
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_NODE_INDEXED
+    /* all nodes are unconfigured, heartbeats are received by one buffer */
+    memset(HBcons->idxByNodeId, CO_HBCONS_IDX_NONE,
+           sizeof(HBcons->idxByNodeId));
+    for (uint8_t i = 0; i < HBcons->numberOfMonitoredNodes; i++) {
+        CO_HBconsNode_t *monitoredNode = &monitoredNodes[i];
+        monitoredNode->HBstate = CO_HBconsumer_UNCONFIGURED;
+        monitoredNode->heapPos = CO_HBCONS_IDX_NONE;
+        monitoredNode->countedActive = false;
+        monitoredNode->countedOperational = false;
+    }
+    CO_ReturnError_t retRx = CO_CANrxBufferInit(CANdevRx,
+                                                CANdevRxIdxStart,
+                                                CO_CAN_ID_HEARTBEAT,
+                                                0x780,
+                                                0,
+                                                (void*)HBcons,
+                                                CO_HBcons_receiveIndexed);
+    if (retRx != CO_ERROR_NO) {
+        return retRx;
+    }
+#endif
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_STATE_TRACKER
+    for (uint8_t i = 0; i < HBcons->numberOfMonitoredNodes; i++) {
+        monitoredNodes[i].lastSeen_us = 0;
+        monitoredNodes[i].transitions = 0;
+        monitoredNodes[i].trackedStates = 0;
+    }
+#endif
+
     for (uint8_t i = 0; i < HBcons->numberOfMonitoredNodes; i++) {
         uint32_t val;
         odRet = OD_get_u32(OD_1016_HBcons, i + 1, &val, true);
@@ -192,12 +581,21 @@ static CO_ReturnError_t CO_HBconsumer_initEntry(CO_HBconsumer_t *HBcons,
 
     /* verify for duplicate entries */
     if(consumerTime_ms != 0 && nodeId != 0) {
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_NODE_INDEXED
+        if (nodeId > CO_HBCONS_NODES_MAX
+            || (HBcons->idxByNodeId[nodeId] != CO_HBCONS_IDX_NONE
+                && HBcons->idxByNodeId[nodeId] != idx)
+        ) {
+            ret = CO_ERROR_OD_PARAMETERS;
+        }
+#else
         for (uint8_t i = 0; i < HBcons->numberOfMonitoredNodes; i++) {
             CO_HBconsNode_t node = HBcons->monitoredNodes[i];
             if(idx != i && node.time_us != 0 && node.nodeId == nodeId) {
                 ret = CO_ERROR_OD_PARAMETERS;
             }
         }
+#endif
     }
 
     /* Configure one monitored node */
@@ -205,12 +603,30 @@ static CO_ReturnError_t CO_HBconsumer_initEntry(CO_HBconsumer_t *HBcons,
         uint16_t COB_ID;
 
         CO_HBconsNode_t * monitoredNode = &HBcons->monitoredNodes[idx];
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_STATE_TRACKER
+        /* remove the previous node-ID from the bitmaps */
+        trackerWrite(HBcons, idx, 0);
+#endif
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_NODE_INDEXED
+        /* remove previous configuration of the node */
+        if (monitoredNode->HBstate != CO_HBconsumer_UNCONFIGURED) {
+            HBcons->idxByNodeId[monitoredNode->nodeId] = CO_HBCONS_IDX_NONE;
+            HBcons->countConfigured--;
+        }
+        timerRemove(HBcons, idx);
+        monitoredNode->HBstate = CO_HBconsumer_UNCONFIGURED;
+        monitoredNode->NMTstate = CO_NMT_UNKNOWN;
+        countersUpdate(HBcons, idx);
+#endif
         monitoredNode->nodeId = nodeId;
         monitoredNode->time_us = (int32_t)consumerTime_ms * 1000;
         monitoredNode->NMTstate = CO_NMT_UNKNOWN;
 #if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_CALLBACK_CHANGE \
     || (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_CALLBACK_MULTI
         monitoredNode->NMTstatePrev = CO_NMT_UNKNOWN;
+#endif
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_STATISTICS
+        memset(&monitoredNode->stat, 0, sizeof(monitoredNode->stat));
 #endif
         CO_FLAG_CLEAR(monitoredNode->CANrxNew);
 
@@ -225,6 +641,14 @@ static CO_ReturnError_t CO_HBconsumer_initEntry(CO_HBconsumer_t *HBcons,
             monitoredNode->HBstate = CO_HBconsumer_UNCONFIGURED;
         }
 
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_NODE_INDEXED
+        /* CAN reception is common for all nodes, only index the node */
+        (void)COB_ID;
+        if (monitoredNode->HBstate != CO_HBconsumer_UNCONFIGURED) {
+            HBcons->idxByNodeId[nodeId] = idx;
+            HBcons->countConfigured++;
+        }
+#else
         /* configure Heartbeat consumer (or disable) CAN reception */
         ret = CO_CANrxBufferInit(HBcons->CANdevRx,
                                  HBcons->CANdevRxIdxStart + idx,
@@ -233,11 +657,29 @@ static CO_ReturnError_t CO_HBconsumer_initEntry(CO_HBconsumer_t *HBcons,
                                  0,
                                  (void*)&HBcons->monitoredNodes[idx],
                                  CO_HBcons_receive);
+#endif
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_STATE_TRACKER
+        trackerUpdate(HBcons, idx);
+#endif
     }
     return ret;
 }
 
 
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_NODE_INDEXED
+/******************************************************************************/
+void CO_HBconsumer_initForward(CO_HBconsumer_t *HBcons,
+                               void *object,
+                               void (*pFunctForward)(void *object, void *msg))
+{
+    if (HBcons != NULL) {
+        HBcons->functForwardObject = object;
+        HBcons->pFunctForward = pFunctForward;
+    }
+}
+#endif
+
+
 #if (CO_CONFIG_HB_CONS) & CO_CONFIG_FLAG_CALLBACK_PRE
 /******************************************************************************/
 void CO_HBconsumer_initCallbackPre(
@@ -355,6 +797,131 @@ void CO_HBconsumer_initCallbackRemoteReset(
 #endif /* (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_CALLBACK_MULTI */
 
 
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_NODE_INDEXED
+/*
+ * Process node-ID indexed Heartbeat consumer, called from
+ * CO_HBconsumer_process(). Only groups of nodes with pending flag and nodes
+ * with expired deadline from the top of the timer heap are processed.
+ */
+static void CO_HBconsumer_processIndexed(CO_HBconsumer_t *HBcons,
+                                         uint32_t *timerNext_us)
+{
+    (void)timerNext_us; /* may be unused */
+
+    /* received Heartbeat and bootup messages */
+    for (uint8_t g = 0; g < CO_HBCONS_PENDING_CNT; g++) {
+        if (!CO_FLAG_READ(HBcons->CANrxPending[g])) {
+            continue;
+        }
+        /* Flag is cleared before processing, so message received meanwhile
+         * sets it again. */
+        CO_FLAG_CLEAR(HBcons->CANrxPending[g]);
+
+        uint8_t iEnd = (uint8_t)((g + 1U) * CO_HBCONS_PENDING_GROUP);
+        if (iEnd > HBcons->numberOfMonitoredNodes) {
+            iEnd = HBcons->numberOfMonitoredNodes;
+        }
+        for (uint8_t i = g * CO_HBCONS_PENDING_GROUP; i < iEnd; i++) {
+            CO_HBconsNode_t * const monitoredNode = &HBcons->monitoredNodes[i];
+
+            if (!CO_FLAG_READ(monitoredNode->CANrxNew)) {
+                continue;
+            }
+            if (monitoredNode->NMTstate == CO_NMT_INITIALIZING) {
+                /* bootup message*/
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_CALLBACK_MULTI
+                if (monitoredNode->pFunctSignalRemoteReset != NULL) {
+                    monitoredNode->pFunctSignalRemoteReset(
+                        monitoredNode->nodeId, i,
+                        monitoredNode->functSignalObjectRemoteReset);
+                }
+#endif
+                if (monitoredNode->HBstate == CO_HBconsumer_ACTIVE) {
+                    CO_errorReport(HBcons->em,
+                                   CO_EM_HB_CONSUMER_REMOTE_RESET,
+                                   CO_EMC_HEARTBEAT, i);
+                }
+                monitoredNode->HBstate = CO_HBconsumer_UNKNOWN;
+                timerRemove(HBcons, i);
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_STATISTICS
+                monitoredNode->stat.lastRxValid = false;
+#endif
+            }
+            else {
+                /* heartbeat message */
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_CALLBACK_MULTI
+                if (monitoredNode->HBstate != CO_HBconsumer_ACTIVE &&
+                    monitoredNode->pFunctSignalHbStarted != NULL) {
+                    monitoredNode->pFunctSignalHbStarted(
+                        monitoredNode->nodeId, i,
+                        monitoredNode->functSignalObjectHbStarted);
+                }
+#endif
+                monitoredNode->HBstate = CO_HBconsumer_ACTIVE;
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_STATISTICS
+                statUpdate(HBcons, monitoredNode);
+#endif
+                /* restart timer */
+                timerSet(HBcons, i, HBcons->timer_us + monitoredNode->time_us);
+            }
+            CO_FLAG_CLEAR(monitoredNode->CANrxNew);
+            countersUpdate(HBcons, i);
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_STATE_TRACKER
+            monitoredNode->lastSeen_us = HBcons->timer_us;
+            trackerUpdate(HBcons, i);
+#endif
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_CALLBACK_CHANGE \
+    || (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_CALLBACK_MULTI
+            nmtChangedSignal(HBcons, i);
+#endif
+        }
+    }
+
+    /* expired deadlines, the earliest is on the top of the heap */
+    while (HBcons->timerHeapCount > 0) {
+        uint8_t i = HBcons->timerHeap[0];
+        CO_HBconsNode_t * const monitoredNode = &HBcons->monitoredNodes[i];
+        uint32_t diff = monitoredNode->deadline_us - HBcons->timer_us;
+
+        if ((int32_t)diff > 0) {
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_FLAG_TIMERNEXT
+            /* Calculate timerNext_us for next timeout checking. */
+            if (timerNext_us != NULL && *timerNext_us > diff) {
+                *timerNext_us = diff;
+            }
+#endif
+            break;
+        }
+
+        /* timeout expired */
+        timerRemove(HBcons, i);
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_CALLBACK_MULTI
+        if (monitoredNode->pFunctSignalTimeout!=NULL) {
+            monitoredNode->pFunctSignalTimeout(
+                monitoredNode->nodeId, i,
+                monitoredNode->functSignalObjectTimeout);
+        }
+#endif
+        CO_errorReport(HBcons->em, CO_EM_HEARTBEAT_CONSUMER,
+                       CO_EMC_HEARTBEAT, i);
+        monitoredNode->NMTstate = CO_NMT_UNKNOWN;
+        monitoredNode->HBstate = CO_HBconsumer_TIMEOUT;
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_STATISTICS
+        monitoredNode->stat.lastRxValid = false;
+#endif
+        countersUpdate(HBcons, i);
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_STATE_TRACKER
+        trackerUpdate(HBcons, i);
+#endif
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_CALLBACK_CHANGE \
+    || (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_CALLBACK_MULTI
+        nmtChangedSignal(HBcons, i);
+#endif
+    }
+}
+#endif /* (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_NODE_INDEXED */
+
+
 /******************************************************************************/
 void CO_HBconsumer_process(
         CO_HBconsumer_t        *HBcons,
@@ -367,7 +934,20 @@ void CO_HBconsumer_process(
     bool_t allMonitoredActiveCurrent = true;
     bool_t allMonitoredOperationalCurrent = true;
 
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_NODE_INDEXED \
+    || (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_STATE_TRACKER \
+    || (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_STATISTICS
+    HBcons->timer_us += timeDifference_us;
+#endif
+
     if (NMTisPreOrOperational && HBcons->NMTisPreOrOperationalPrev) {
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_NODE_INDEXED
+        CO_HBconsumer_processIndexed(HBcons, timerNext_us);
+        allMonitoredActiveCurrent =
+            HBcons->countActive == HBcons->countConfigured;
+        allMonitoredOperationalCurrent =
+            HBcons->countOperational == HBcons->countConfigured;
+#else
         for (uint8_t i=0; i<HBcons->numberOfMonitoredNodes; i++) {
             uint32_t timeDifference_us_copy = timeDifference_us;
             CO_HBconsNode_t * const monitoredNode = &HBcons->monitoredNodes[i];
@@ -393,7 +973,9 @@ void CO_HBconsumer_process(
                                        CO_EMC_HEARTBEAT, i);
                     }
                     monitoredNode->HBstate = CO_HBconsumer_UNKNOWN;
-
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_STATISTICS
+                    monitoredNode->stat.lastRxValid = false;
+#endif
                 }
                 else {
                     /* heartbeat message */
@@ -406,11 +988,18 @@ void CO_HBconsumer_process(
                     }
 #endif
                     monitoredNode->HBstate = CO_HBconsumer_ACTIVE;
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_STATISTICS
+                    statUpdate(HBcons, monitoredNode);
+#endif
                     /* reset timer */
                     monitoredNode->timeoutTimer = 0;
                     timeDifference_us_copy = 0;
                 }
                 CO_FLAG_CLEAR(monitoredNode->CANrxNew);
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_STATE_TRACKER
+                monitoredNode->lastSeen_us = HBcons->timer_us;
+                trackerUpdate(HBcons, i);
+#endif
             }
 
             /* Verify timeout */
@@ -430,6 +1019,12 @@ void CO_HBconsumer_process(
                                    CO_EMC_HEARTBEAT, i);
                     monitoredNode->NMTstate = CO_NMT_UNKNOWN;
                     monitoredNode->HBstate = CO_HBconsumer_TIMEOUT;
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_STATISTICS
+                    monitoredNode->stat.lastRxValid = false;
+#endif
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_STATE_TRACKER
+                    trackerUpdate(HBcons, i);
+#endif
                 }
 
 #if (CO_CONFIG_HB_CONS) & CO_CONFIG_FLAG_TIMERNEXT
@@ -453,23 +1048,10 @@ void CO_HBconsumer_process(
 #if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_CALLBACK_CHANGE \
     || (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_CALLBACK_MULTI
             /* Verify, if NMT state of monitored node changed */
-            if(monitoredNode->NMTstate != monitoredNode->NMTstatePrev) {
-#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_CALLBACK_CHANGE
-                if (HBcons->pFunctSignalNmtChanged != NULL) {
-                    HBcons->pFunctSignalNmtChanged(
-                        monitoredNode->nodeId, i, monitoredNode->NMTstate,
-                        HBcons->pFunctSignalObjectNmtChanged);
-#else
-                if (monitoredNode->pFunctSignalNmtChanged != NULL) {
-                    monitoredNode->pFunctSignalNmtChanged(
-                        monitoredNode->nodeId, i, monitoredNode->NMTstate,
-                        monitoredNode->pFunctSignalObjectNmtChanged);
-#endif
-                }
-                monitoredNode->NMTstatePrev = monitoredNode->NMTstate;
-            }
+            nmtChangedSignal(HBcons, i);
 #endif
         }
+#endif /* (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_NODE_INDEXED */
     }
     else if (NMTisPreOrOperational || HBcons->NMTisPreOrOperationalPrev) {
         /* (pre)operational state changed, clear variables */
@@ -484,7 +1066,26 @@ void CO_HBconsumer_process(
             if (monitoredNode->HBstate != CO_HBconsumer_UNCONFIGURED) {
                 monitoredNode->HBstate = CO_HBconsumer_UNKNOWN;
             }
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_STATISTICS
+            monitoredNode->stat.lastRxValid = false;
+#endif
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_NODE_INDEXED
+            monitoredNode->heapPos = CO_HBCONS_IDX_NONE;
+            monitoredNode->countedActive = false;
+            monitoredNode->countedOperational = false;
+#endif
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_STATE_TRACKER
+            trackerUpdate(HBcons, i);
+#endif
         }
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_NODE_INDEXED
+        HBcons->timerHeapCount = 0;
+        HBcons->countActive = 0;
+        HBcons->countOperational = 0;
+        for (uint8_t g = 0; g < CO_HBCONS_PENDING_CNT; g++) {
+            CO_FLAG_CLEAR(HBcons->CANrxPending[g]);
+        }
+#endif
         allMonitoredActiveCurrent = false;
         allMonitoredOperationalCurrent = false;
     }
@@ -499,6 +1100,10 @@ void CO_HBconsumer_process(
     HBcons->allMonitoredActive = allMonitoredActiveCurrent;
     HBcons->allMonitoredOperational = allMonitoredOperationalCurrent;
     HBcons->NMTisPreOrOperationalPrev = NMTisPreOrOperational;
+
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_STATE_TRACKER
+    trackerNotify(HBcons);
+#endif
 }
 
 
@@ -508,6 +1113,16 @@ int8_t CO_HBconsumer_getIdxByNodeId(
         CO_HBconsumer_t        *HBcons,
         uint8_t                 nodeId)
 {
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_NODE_INDEXED
+    if (HBcons == NULL || nodeId > CO_HBCONS_NODES_MAX
+        || HBcons->idxByNodeId[nodeId] == CO_HBCONS_IDX_NONE
+    ) {
+        return -1;
+    }
+
+    /* direct access by node-ID */
+    return (int8_t)HBcons->idxByNodeId[nodeId];
+#else
     uint8_t i;
     CO_HBconsNode_t *monitoredNode;
 
@@ -525,6 +1140,7 @@ int8_t CO_HBconsumer_getIdxByNodeId(
     }
     /* not found */
     return -1;
+#endif
 }
 
 
@@ -566,4 +1182,71 @@ int8_t CO_HBconsumer_getNmtState(
 }
 #endif /* (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_QUERY_FUNCT */
 
+
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_STATE_TRACKER
+/******************************************************************************/
+void CO_HBconsumer_initCallbackStateChanged(
+        CO_HBconsumer_t        *HBcons,
+        void                   *object,
+        void                  (*pFunctSignal)(const CO_HBconsSnapshot_t *snapshot,
+                                              void *object))
+{
+    if (HBcons != NULL) {
+        HBcons->pFunctSignalStateChanged = pFunctSignal;
+        HBcons->functSignalObjectStateChanged = object;
+    }
+}
+
+
+/******************************************************************************/
+void CO_HBconsumer_getSnapshot(CO_HBconsumer_t *HBcons,
+                               CO_HBconsSnapshot_t *snapshot)
+{
+    if (HBcons != NULL && snapshot != NULL) {
+        memcpy(snapshot, &HBcons->tracker, sizeof(CO_HBconsSnapshot_t));
+    }
+}
+#endif /* (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_STATE_TRACKER */
+
+
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_STATISTICS
+/******************************************************************************/
+CO_ReturnError_t CO_HBconsumer_initStatistics(CO_HBconsumer_t *HBcons,
+                                              OD_entry_t *OD_statistics,
+                                              uint32_t *errInfo)
+{
+    /* verify arguments */
+    if (HBcons == NULL || OD_statistics == NULL) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    HBcons->OD_statExtension.object = HBcons;
+    HBcons->OD_statExtension.read = OD_read_statistics;
+    HBcons->OD_statExtension.write = OD_write_statistics;
+    if (OD_extension_init(OD_statistics, &HBcons->OD_statExtension) != ODR_OK) {
+        if (errInfo != NULL) *errInfo = OD_getIndex(OD_statistics);
+        return CO_ERROR_OD_PARAMETERS;
+    }
+
+    return CO_ERROR_NO;
+}
+
+
+/******************************************************************************/
+void CO_HBconsumer_resetStatistics(CO_HBconsumer_t *HBcons, uint8_t idx) {
+    if (HBcons == NULL || idx >= HBcons->numberOfMonitoredNodes) {
+        return;
+    }
+
+    CO_HBconsStat_t *stat = &HBcons->monitoredNodes[idx].stat;
+    bool_t lastRxValid = stat->lastRxValid;
+    uint32_t lastRx_us = stat->lastRx_us;
+
+    /* keep the time of the last Heartbeat for the next interval */
+    memset(stat, 0, sizeof(CO_HBconsStat_t));
+    stat->lastRxValid = lastRxValid;
+    stat->lastRx_us = lastRx_us;
+}
+#endif /* (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_STATISTICS */
+
 #endif /* (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_ENABLE */
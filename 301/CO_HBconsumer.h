@@ -57,6 +57,25 @@ extern "C" {
  * variable _allMonitoredOperational_ inside CO_HBconsumer_t is set to true.
  * Monitoring starts after the reception of the first HeartBeat (not bootup).
  *
+ * With @ref CO_CONFIG_HB_CONS_NODE_INDEXED all Heartbeat messages are received
+ * by one CAN receive buffer and monitored nodes are indexed by node-ID.
+ * Heartbeat deadlines of active nodes are kept in a timer heap, ordered by
+ * time. CO_HBconsumer_process() then processes only groups of nodes with
+ * received message and nodes with expired deadline, so its cost doesn't depend
+ * on the number of monitored nodes. Variable _timeoutTimer_ in CO_HBconsNode_t
+ * is not updated in this mode. The wide receive buffer also takes Heartbeats of
+ * the nodes, which are not monitored. They are passed to the function from
+ * CO_HBconsumer_initForward(), network scan registers its receive function
+ * there.
+ *
+ * With @ref CO_CONFIG_HB_CONS_STATE_TRACKER Heartbeat consumer also keeps
+ * bitmaps of monitored nodes, one for each @ref CO_HBconsTrack_t state. Bit
+ * of the node-ID is set in the bitmap, if node is in that state. Application
+ * may then verify a group of nodes (a bitmap of node-IDs) with
+ * CO_HBconsumer_allInState() or CO_HBconsumer_anyInState(), without access to
+ * each node. All changes of one CO_HBconsumer_process() call are notified with
+ * a single callback, see CO_HBconsumer_initCallbackStateChanged().
+ *
  * Heartbeat set up is done by writing to the OD registers 0x1016.
  * To setup heartbeat consumer by application, use
  * @code ODR_t odRet = OD_set_u32(entry, subIndex, val, false); @endcode
@@ -64,6 +83,95 @@ extern "C" {
  * @see @ref CO_NMT_Heartbeat
  */
 
+#if ((CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_NODE_INDEXED) || defined CO_DOXYGEN
+/** Maximum number of monitored nodes in node-ID indexed Heartbeat consumer */
+#define CO_HBCONS_NODES_MAX 127U
+/** Value of index, which is not used */
+#define CO_HBCONS_IDX_NONE 0xFFU
+/** Number of monitored nodes, which share the same pending flag */
+#define CO_HBCONS_PENDING_GROUP 8U
+/** Number of pending flags for all monitored nodes */
+#define CO_HBCONS_PENDING_CNT \
+    ((CO_HBCONS_NODES_MAX + CO_HBCONS_PENDING_GROUP - 1U) \
+     / CO_HBCONS_PENDING_GROUP)
+#endif
+
+#if ((CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_STATE_TRACKER) || defined CO_DOXYGEN
+/** Number of 32-bit words in the bitmap of node-IDs */
+#define CO_HBCONS_BITMAP_WORDS 4U
+
+/**
+ * Bitmap of node-IDs. Node-ID n is bit (n % 32) in word (n / 32).
+ */
+typedef struct {
+    uint32_t w[CO_HBCONS_BITMAP_WORDS];
+} CO_HBconsBitmap_t;
+
+/**
+ * States tracked by the network state tracker, index of the bitmap in
+ * @ref CO_HBconsSnapshot_t. NMT states are valid only for active nodes.
+ */
+typedef enum {
+    CO_HBCONS_TRACK_CONFIGURED = 0,     /**< Node is monitored */
+    CO_HBCONS_TRACK_ACTIVE = 1,         /**< Heartbeat is active */
+    CO_HBCONS_TRACK_TIMEOUT = 2,        /**< Heartbeat timeout */
+    CO_HBCONS_TRACK_PRE_OPERATIONAL = 3,/**< Active, NMT pre-operational */
+    CO_HBCONS_TRACK_OPERATIONAL = 4,    /**< Active, NMT operational */
+    CO_HBCONS_TRACK_STOPPED = 5,        /**< Active, NMT stopped */
+    CO_HBCONS_TRACK_COUNT = 6           /**< Number of tracked states */
+} CO_HBconsTrack_t;
+
+/**
+ * Snapshot of the network state, see @ref CO_CONFIG_HB_CONS_STATE_TRACKER.
+ */
+typedef struct {
+    /** Bitmap of nodes for each state, indexed by @ref CO_HBconsTrack_t */
+    CO_HBconsBitmap_t state[CO_HBCONS_TRACK_COUNT];
+    /** Nodes, which changed any state in the last notified process cycle */
+    CO_HBconsBitmap_t changed;
+    /** Incremented on each process cycle with changes, it overflows */
+    uint32_t sequence;
+} CO_HBconsSnapshot_t;
+#endif
+
+#if ((CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_STATISTICS) || defined CO_DOXYGEN
+/** Number of histogram bins in @ref CO_HBconsStat_t */
+#define CO_HBCONS_STAT_BINS 8U
+/** Heartbeat interval in this or higher bin is counted as late, 3/4 of the
+ * consumer time */
+#define CO_HBCONS_STAT_LATE_BIN 6U
+/** Size of statistics of one node in OD, see CO_HBconsumer_initStatistics() */
+#define CO_HBCONS_STAT_OD_SIZE (4U * 4U + 2U + 2U * CO_HBCONS_STAT_BINS)
+
+/**
+ * Statistics of Heartbeat intervals of one monitored node.
+ *
+ * Interval is time between two consecutive Heartbeats, measured in
+ * CO_HBconsumer_process(), so its resolution is the process cycle. Boot-up
+ * message and Heartbeat timeout start the measurement again.
+ */
+typedef struct {
+    /** Number of measured intervals */
+    uint32_t count;
+    /** Shortest interval in microseconds */
+    uint32_t intervalMin_us;
+    /** Moving average of intervals in microseconds, weight of the new
+     * interval is 1/8 */
+    uint32_t intervalAvg_us;
+    /** Longest interval in microseconds */
+    uint32_t intervalMax_us;
+    /** Number of intervals in CO_HBCONS_STAT_LATE_BIN or higher bin */
+    uint16_t late;
+    /** Histogram of intervals. Bin n counts intervals from n/8 to (n+1)/8 of
+     * the consumer time, the last bin also longer intervals. */
+    uint16_t histogram[CO_HBCONS_STAT_BINS];
+    /** Value of timer_us from CO_HBconsumer_t at the previous Heartbeat */
+    uint32_t lastRx_us;
+    /** True, if lastRx_us is valid */
+    bool_t lastRxValid;
+} CO_HBconsStat_t;
+#endif
+
 /**
  * Heartbeat state of a node
  */
@@ -127,6 +235,30 @@ typedef struct {
     /** Pointer to object */
     void *functSignalObjectRemoteReset;
 #endif
+#if ((CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_NODE_INDEXED) || defined CO_DOXYGEN
+    /** Value of timer_us from CO_HBconsumer_t, when Heartbeat times out */
+    uint32_t deadline_us;
+    /** Position in the timer heap of CO_HBconsumer_t or CO_HBCONS_IDX_NONE */
+    uint8_t heapPos;
+    /** True, if node is counted as active in CO_HBconsumer_t */
+    bool_t countedActive;
+    /** True, if node is counted as NMT operational in CO_HBconsumer_t */
+    bool_t countedOperational;
+#endif
+#if ((CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_STATE_TRACKER) || defined CO_DOXYGEN
+    /** Value of timer_us from CO_HBconsumer_t, when the last Heartbeat or
+     * boot-up message was processed. Can be read by the application */
+    uint32_t lastSeen_us;
+    /** Number of tracked state changes of the node, it overflows. Can be read
+     * by the application */
+    uint16_t transitions;
+    /** Bits of @ref CO_HBconsTrack_t states, in which node is tracked */
+    uint8_t trackedStates;
+#endif
+#if ((CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_STATISTICS) || defined CO_DOXYGEN
+    /** Statistics of Heartbeat intervals. Can be read by the application */
+    CO_HBconsStat_t stat;
+#endif
 } CO_HBconsNode_t;
 
 
@@ -169,6 +301,51 @@ typedef struct {
     /** Pointer to object */
     void *pFunctSignalObjectNmtChanged;
 #endif
+#if ((CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_NODE_INDEXED) \
+    || ((CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_STATE_TRACKER) \
+    || ((CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_STATISTICS) \
+    || defined CO_DOXYGEN
+    /** Time in microseconds, sum of all timeDifference_us. It overflows. */
+    uint32_t timer_us;
+#endif
+#if ((CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_NODE_INDEXED) || defined CO_DOXYGEN
+    /** Index of monitored node for each node-ID or CO_HBCONS_IDX_NONE, if
+     * node is not monitored */
+    uint8_t idxByNodeId[CO_HBCONS_NODES_MAX + 1U];
+    /** Pending flags for groups of monitored nodes, set by CAN receive */
+    volatile void *CANrxPending[CO_HBCONS_PENDING_CNT];
+    /** Timer heap: indexes of active monitored nodes, the one with the earliest
+     * deadline_us is the first */
+    uint8_t timerHeap[CO_HBCONS_NODES_MAX];
+    /** Number of nodes in the timer heap */
+    uint8_t timerHeapCount;
+    /** Number of configured monitored nodes */
+    uint8_t countConfigured;
+    /** Number of active monitored nodes */
+    uint8_t countActive;
+    /** Number of NMT operational monitored nodes */
+    uint8_t countOperational;
+    /** From CO_HBconsumer_initForward() or NULL */
+    void (*pFunctForward)(void *object, void *msg);
+    /** From CO_HBconsumer_initForward() or NULL */
+    void *functForwardObject;
+#endif
+#if ((CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_STATE_TRACKER) || defined CO_DOXYGEN
+    /** Network state, bitmaps are always up to date, changed and sequence
+     * from the last notification. Can be read by the application */
+    CO_HBconsSnapshot_t tracker;
+    /** Nodes with changed state since the last notification */
+    CO_HBconsBitmap_t trackerChanged;
+    /** From CO_HBconsumer_initCallbackStateChanged() or NULL */
+    void (*pFunctSignalStateChanged)(const CO_HBconsSnapshot_t *snapshot,
+                                     void *object);
+    /** From CO_HBconsumer_initCallbackStateChanged() or NULL */
+    void *functSignalObjectStateChanged;
+#endif
+#if ((CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_STATISTICS) || defined CO_DOXYGEN
+    /** Extension for OD object with statistics */
+    OD_extension_t OD_statExtension;
+#endif
 } CO_HBconsumer_t;
 
 
@@ -186,7 +363,8 @@ typedef struct {
  * is required, IO extension will be applied.
  * @param CANdevRx CAN device for Heartbeat reception.
  * @param CANdevRxIdxStart Starting index of receive buffer in the above CAN
- * device. Number of used indexes is equal to monitoredNodesCount.
+ * device. Number of used indexes is equal to monitoredNodesCount or one, if
+ * @ref CO_CONFIG_HB_CONS_NODE_INDEXED is enabled.
  * @param [out] errInfo Additional information in case of error, may be NULL.
  *
  * @return @ref CO_ReturnError_t CO_ERROR_NO in case of success.
@@ -201,6 +379,27 @@ CO_ReturnError_t CO_HBconsumer_init(CO_HBconsumer_t *HBcons,
                                     uint32_t *errInfo);
 
 
+#if ((CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_NODE_INDEXED) || defined CO_DOXYGEN
+/**
+ * Initialize receive function for Heartbeats of nodes, which are not monitored.
+ *
+ * With @ref CO_CONFIG_HB_CONS_NODE_INDEXED Heartbeat consumer receives all
+ * Heartbeat and boot-up messages with one CAN receive buffer, so other receive
+ * buffers for these CAN-IDs don't get them. Messages from nodes, which are not
+ * monitored, are passed to pFunctForward() instead. It is called from the CAN
+ * receive interrupt, see CO_CANrxBufferInit().
+ *
+ * Function must be called after CO_HBconsumer_init().
+ *
+ * @param HBcons This object.
+ * @param object Pointer to object, which will be passed to pFunctForward().
+ * @param pFunctForward Pointer to the receive function. Not called if NULL.
+ */
+void CO_HBconsumer_initForward(CO_HBconsumer_t *HBcons,
+                               void *object,
+                               void (*pFunctForward)(void *object, void *msg));
+#endif
+
 #if ((CO_CONFIG_HB_CONS) & CO_CONFIG_FLAG_CALLBACK_PRE) || defined CO_DOXYGEN
 /**
  * Initialize Heartbeat consumer callback function.
@@ -323,7 +522,8 @@ void CO_HBconsumer_process(
  *
  * @param HBcons This object.
  * @param nodeId producer node ID
- * @return index. -1 if not found
+ * @return index. -1 if not found. With @ref CO_CONFIG_HB_CONS_NODE_INDEXED
+ * only index of configured node is found, without search.
  */
 int8_t CO_HBconsumer_getIdxByNodeId(
         CO_HBconsumer_t        *HBcons,
@@ -358,6 +558,140 @@ int8_t CO_HBconsumer_getNmtState(
 
 #endif /* (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_QUERY_FUNCT */
 
+#if ((CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_STATE_TRACKER) || defined CO_DOXYGEN
+/**
+ * Initialize Heartbeat consumer state changed callback function.
+ *
+ * Function initializes optional callback function, which is called at the end
+ * of CO_HBconsumer_process(), if any monitored node changed its tracked state.
+ * It is called once for all changes, changed nodes are in the bitmap
+ * _changed_ of the snapshot.
+ *
+ * @param HBcons This object.
+ * @param object Pointer to object, which will be passed to pFunctSignal(). Can
+ * be NULL
+ * @param pFunctSignal Pointer to the callback function. Not called if NULL.
+ */
+void CO_HBconsumer_initCallbackStateChanged(
+        CO_HBconsumer_t        *HBcons,
+        void                   *object,
+        void                  (*pFunctSignal)(const CO_HBconsSnapshot_t *snapshot,
+                                              void *object));
+
+/**
+ * Copy the network state snapshot.
+ *
+ * Function must be called from the same thread as CO_HBconsumer_process() or
+ * inside the lock, which protects it.
+ *
+ * @param HBcons This object.
+ * @param [out] snapshot Copy of the network state.
+ */
+void CO_HBconsumer_getSnapshot(CO_HBconsumer_t *HBcons,
+                               CO_HBconsSnapshot_t *snapshot);
+
+/**
+ * Add node-ID to the bitmap.
+ *
+ * @param bitmap Bitmap of node-IDs.
+ * @param nodeId Node-ID, 1 to 127.
+ */
+static inline void CO_HBconsumer_bitmapSet(CO_HBconsBitmap_t *bitmap,
+                                           uint8_t nodeId)
+{
+    bitmap->w[(nodeId >> 5) & 3U] |= (uint32_t)1U << (nodeId & 0x1FU);
+}
+
+/**
+ * Verify, if node-ID is in the bitmap.
+ *
+ * @param bitmap Bitmap of node-IDs.
+ * @param nodeId Node-ID, 1 to 127.
+ *
+ * @return True, if bit for node-ID is set.
+ */
+static inline bool_t CO_HBconsumer_bitmapTest(const CO_HBconsBitmap_t *bitmap,
+                                              uint8_t nodeId)
+{
+    return (bitmap->w[(nodeId >> 5) & 3U] >> (nodeId & 0x1FU)) & 1U;
+}
+
+/**
+ * Verify, if all nodes from the group are in the tracked state.
+ *
+ * @param HBcons This object.
+ * @param group Bitmap of node-IDs.
+ * @param state Tracked state.
+ *
+ * @return True, if all nodes from group are in state, also for empty group.
+ */
+static inline bool_t CO_HBconsumer_allInState(const CO_HBconsumer_t *HBcons,
+                                              const CO_HBconsBitmap_t *group,
+                                              CO_HBconsTrack_t state)
+{
+    const CO_HBconsBitmap_t *bitmap = &HBcons->tracker.state[state];
+    uint32_t missing = 0;
+
+    for (uint8_t i = 0; i < CO_HBCONS_BITMAP_WORDS; i++) {
+        missing |= group->w[i] & ~bitmap->w[i];
+    }
+    return missing == 0;
+}
+
+/**
+ * Verify, if any node from the group is in the tracked state.
+ *
+ * @param HBcons This object.
+ * @param group Bitmap of node-IDs.
+ * @param state Tracked state.
+ *
+ * @return True, if at least one node from group is in state.
+ */
+static inline bool_t CO_HBconsumer_anyInState(const CO_HBconsumer_t *HBcons,
+                                              const CO_HBconsBitmap_t *group,
+                                              CO_HBconsTrack_t state)
+{
+    const CO_HBconsBitmap_t *bitmap = &HBcons->tracker.state[state];
+    uint32_t found = 0;
+
+    for (uint8_t i = 0; i < CO_HBCONS_BITMAP_WORDS; i++) {
+        found |= group->w[i] & bitmap->w[i];
+    }
+    return found != 0;
+}
+#endif /* (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_STATE_TRACKER */
+
+#if ((CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_STATISTICS) || defined CO_DOXYGEN
+/**
+ * Initialize OD entry with Heartbeat statistics.
+ *
+ * OD entry is manufacturer specific, for example an array of DOMAIN. Its
+ * sub-index n contains statistics of the monitored node from sub-index n of
+ * OD 0x1016, CO_HBCONS_STAT_OD_SIZE bytes, little endian: count (u32),
+ * intervalMin_us (u32), intervalAvg_us (u32), intervalMax_us (u32), late
+ * (u16) and histogram (CO_HBCONS_STAT_BINS x u16). Entry is read only.
+ *
+ * Function must be called after CO_HBconsumer_init().
+ *
+ * @param HBcons This object.
+ * @param OD_statistics OD entry for statistics, IO extension will be applied.
+ * @param [out] errInfo Additional information in case of error, may be NULL.
+ *
+ * @return @ref CO_ReturnError_t CO_ERROR_NO in case of success.
+ */
+CO_ReturnError_t CO_HBconsumer_initStatistics(CO_HBconsumer_t *HBcons,
+                                              OD_entry_t *OD_statistics,
+                                              uint32_t *errInfo);
+
+/**
+ * Clear Heartbeat statistics of the monitored node.
+ *
+ * @param HBcons This object.
+ * @param idx index of the node in HBcons object
+ */
+void CO_HBconsumer_resetStatistics(CO_HBconsumer_t *HBcons, uint8_t idx);
+#endif /* (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_STATISTICS */
+
 /** @} */ /* CO_HBconsumer */
 
 #ifdef __cplusplus
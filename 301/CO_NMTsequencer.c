@@ -0,0 +1,389 @@
+/*
+ * CANopen NMT master startup sequencer, non-standard.
+ *
+ * @file        CO_NMTsequencer.c
+ * @ingroup     CO_NMTsequencer
+ * @author      J-Weisberg
+ * @copyright   2026 J-Weisberg
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string.h>
+
+#include "301/CO_NMTsequencer.h"
+
+#if (CO_CONFIG_NMT_SEQ) & CO_CONFIG_NMT_SEQ_ENABLE
+
+#if !((CO_CONFIG_NMT) & CO_CONFIG_NMT_MASTER)
+#error CO_CONFIG_NMT_MASTER must be enabled for NMT startup sequencer!
+#endif
+#if !((CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_ENABLE) \
+    || !((CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_STATE_TRACKER)
+#error CO_CONFIG_HB_CONS_STATE_TRACKER must be enabled for NMT startup sequencer!
+#endif
+
+
+/* Groups, whose dependencies are fulfilled, if groups in done are finished */
+static uint32_t groupsReady(CO_NMTseq_t *seq, uint32_t done) {
+    uint32_t ready = 0;
+
+    for (uint8_t g = 0; g < CO_NMT_SEQ_GROUPS_MAX; g++) {
+        uint32_t bit = (uint32_t)1U << g;
+
+        if ((seq->groupsUsed & bit) != 0 && (done & bit) == 0
+            && (seq->dependency[g] & seq->groupsUsed & ~done) == 0
+        ) {
+            ready |= bit;
+        }
+    }
+    return ready;
+}
+
+
+/* Start the next wave of groups. Return false, if all groups are done. */
+static bool_t waveNext(CO_NMTseq_t *seq) {
+    seq->groupsWave = groupsReady(seq, seq->groupsDone);
+    if (seq->groupsWave == 0) {
+        return false;
+    }
+    seq->waves++;
+
+    for (uint8_t i = 0; i < seq->nodesCount; i++) {
+        CO_NMTseq_node_t *node = &seq->nodes[i];
+
+        if ((seq->groupsWave & ((uint32_t)1U << node->group)) != 0
+            && node->state == CO_NMTseq_NODE_WAIT_DEPENDENCY
+        ) {
+            node->state = CO_NMTseq_NODE_WAIT_BOOT;
+            node->timer_us = 0;
+        }
+    }
+    return true;
+}
+
+
+/* Command to all nodes may be used only for the last wave, if the application
+ * confirms, that there are no other nodes, and no known node nor this node
+ * would change NMT state except the nodes of the wave. */
+static bool_t broadcastAllowed(CO_NMTseq_t *seq) {
+    const CO_HBconsSnapshot_t *tracker = &seq->HBcons->tracker;
+
+    if ((seq->flags & CO_NMT_SEQ_FLAG_BROADCAST) == 0 || seq->broadcastSent
+        || (seq->groupsUsed & ~seq->groupsDone & ~seq->groupsWave) != 0
+        || CO_NMT_getInternalState(seq->NMT) != CO_NMT_OPERATIONAL
+    ) {
+        return false;
+    }
+    for (uint8_t i = 0; i < CO_HBCONS_BITMAP_WORDS; i++) {
+        if ((tracker->state[CO_HBCONS_TRACK_CONFIGURED].w[i]
+             & ~seq->nodesAdded.w[i]
+             & ~tracker->state[CO_HBCONS_TRACK_OPERATIONAL].w[i]) != 0
+        ) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+/* Send NMT start command to one node or to all nodes (node-ID 0). Return
+ * false, if CAN transmit buffer is busy. */
+static bool_t commandStart(CO_NMTseq_t *seq, uint8_t nodeId) {
+    if (seq->NMT->NMT_TXbuff->bufferFull) {
+        return false;
+    }
+    /* If sending fails, command is repeated after timeout */
+    (void)CO_NMT_sendCommand(seq->NMT, CO_NMT_ENTER_OPERATIONAL, nodeId);
+    seq->commandsSent++;
+    return true;
+}
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_NMTseq_init(CO_NMTseq_t *seq,
+                                CO_NMT_t *NMT,
+                                CO_HBconsumer_t *HBcons)
+{
+    /* verify arguments */
+    if (seq == NULL || NMT == NULL || HBcons == NULL) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    memset(seq, 0, sizeof(CO_NMTseq_t));
+    seq->NMT = NMT;
+    seq->HBcons = HBcons;
+    seq->state = CO_NMTseq_IDLE;
+
+    return CO_ERROR_NO;
+}
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_NMTseq_addNode(CO_NMTseq_t *seq,
+                                   uint8_t nodeId,
+                                   uint8_t group)
+{
+    /* verify arguments */
+    if (seq == NULL || nodeId < 1U || nodeId > 127U
+        || group >= CO_NMT_SEQ_GROUPS_MAX || seq->state == CO_NMTseq_BUSY
+    ) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+    for (uint8_t i = 0; i < seq->nodesCount; i++) {
+        if (seq->nodes[i].nodeId == nodeId) {
+            return CO_ERROR_ILLEGAL_ARGUMENT;
+        }
+    }
+    if (seq->nodesCount >= CO_NMT_SEQ_NODES_MAX) {
+        return CO_ERROR_OUT_OF_MEMORY;
+    }
+
+    CO_NMTseq_node_t *node = &seq->nodes[seq->nodesCount++];
+    node->nodeId = nodeId;
+    node->group = group;
+    node->state = CO_NMTseq_NODE_WAIT_DEPENDENCY;
+    seq->groupsUsed |= (uint32_t)1U << group;
+    CO_HBconsumer_bitmapSet(&seq->nodesAdded, nodeId);
+
+    return CO_ERROR_NO;
+}
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_NMTseq_setDependency(CO_NMTseq_t *seq,
+                                         uint8_t group,
+                                         uint32_t groupsBefore)
+{
+    /* verify arguments */
+    if (seq == NULL || group >= CO_NMT_SEQ_GROUPS_MAX
+        || (groupsBefore & ((uint32_t)1U << group)) != 0
+        || seq->state == CO_NMTseq_BUSY
+    ) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    seq->dependency[group] = groupsBefore;
+
+    return CO_ERROR_NO;
+}
+
+
+/******************************************************************************/
+void CO_NMTseq_initCallbackConfigure(
+        CO_NMTseq_t            *seq,
+        void                   *object,
+        CO_NMTseq_config_t    (*pFunctConfigure)(uint8_t nodeId,
+                                                 void *object))
+{
+    if (seq != NULL) {
+        seq->pFunctConfigure = pFunctConfigure;
+        seq->functConfigureObject = object;
+    }
+}
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_NMTseq_start(CO_NMTseq_t *seq,
+                                 uint8_t flags,
+                                 uint16_t timeout_ms,
+                                 uint8_t retries)
+{
+    uint32_t done = 0;
+
+    /* verify arguments */
+    if (seq == NULL || timeout_ms == 0) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    /* verify, that dependencies are not circular */
+    for (;;) {
+        uint32_t ready = groupsReady(seq, done);
+        if (ready == 0) {
+            break;
+        }
+        done |= ready;
+    }
+    if (done != seq->groupsUsed) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    for (uint8_t i = 0; i < seq->nodesCount; i++) {
+        CO_NMTseq_node_t *node = &seq->nodes[i];
+        node->state = CO_NMTseq_NODE_WAIT_DEPENDENCY;
+        node->retries = retries;
+        node->timer_us = 0;
+    }
+    seq->flags = flags;
+    seq->retries = retries;
+    seq->timeout_us = (uint32_t)timeout_ms * 1000U;
+    seq->groupsDone = 0;
+    seq->groupsWave = 0;
+    seq->broadcastSent = false;
+    seq->commandsSent = 0;
+    seq->waves = 0;
+    seq->state = CO_NMTseq_BUSY;
+
+    return CO_ERROR_NO;
+}
+
+
+/******************************************************************************/
+CO_NMTseq_return_t CO_NMTseq_process(CO_NMTseq_t *seq,
+                                     uint32_t timeDifference_us,
+                                     uint32_t *timerNext_us)
+{
+    (void)timerNext_us; /* may be unused */
+
+    if (seq == NULL) {
+        return CO_NMTseq_IDLE;
+    }
+    if (seq->state != CO_NMTseq_BUSY) {
+        return seq->state;
+    }
+    if (seq->groupsWave == 0 && !waveNext(seq)) {
+        seq->state = CO_NMTseq_DONE;
+        return seq->state;
+    }
+
+    const CO_HBconsSnapshot_t *tracker = &seq->HBcons->tracker;
+    const CO_HBconsBitmap_t *mapPreOp =
+        &tracker->state[CO_HBCONS_TRACK_PRE_OPERATIONAL];
+    const CO_HBconsBitmap_t *mapOp =
+        &tracker->state[CO_HBCONS_TRACK_OPERATIONAL];
+    bool_t broadcast = broadcastAllowed(seq);
+    bool_t allOperational = true;
+    bool_t allReady = true;
+    bool_t anyReady = false;
+
+    for (uint8_t i = 0; i < seq->nodesCount; i++) {
+        CO_NMTseq_node_t *node = &seq->nodes[i];
+
+        if ((seq->groupsWave & ((uint32_t)1U << node->group)) == 0
+            || node->state == CO_NMTseq_NODE_OPERATIONAL
+        ) {
+            continue;
+        }
+        node->timer_us += timeDifference_us;
+
+        if (node->state == CO_NMTseq_NODE_WAIT_BOOT) {
+            if (CO_HBconsumer_bitmapTest(mapOp, node->nodeId)) {
+                /* node is already running */
+                node->state = CO_NMTseq_NODE_OPERATIONAL;
+                continue;
+            }
+            if (CO_HBconsumer_bitmapTest(mapPreOp, node->nodeId)) {
+                node->state = CO_NMTseq_NODE_CONFIGURE;
+                node->timer_us = 0;
+            }
+        }
+
+        if (node->state == CO_NMTseq_NODE_CONFIGURE) {
+            CO_NMTseq_config_t ret = CO_NMTseq_CONFIG_DONE;
+
+            if (seq->pFunctConfigure != NULL) {
+                ret = seq->pFunctConfigure(node->nodeId,
+                                           seq->functConfigureObject);
+            }
+            if (ret == CO_NMTseq_CONFIG_DONE) {
+                node->state = CO_NMTseq_NODE_READY;
+            }
+            else if (ret == CO_NMTseq_CONFIG_ERROR) {
+                node->state = CO_NMTseq_NODE_ERROR;
+            }
+        }
+
+        if (node->state == CO_NMTseq_NODE_READY && !broadcast
+            && commandStart(seq, node->nodeId)
+        ) {
+            node->state = CO_NMTseq_NODE_STARTING;
+            node->timer_us = 0;
+        }
+        else if (node->state == CO_NMTseq_NODE_STARTING) {
+            if (CO_HBconsumer_bitmapTest(mapOp, node->nodeId)) {
+                node->state = CO_NMTseq_NODE_OPERATIONAL;
+                continue;
+            }
+            if (node->timer_us >= seq->timeout_us) {
+                if (node->retries > 0) {
+                    /* repeat the command */
+                    node->retries--;
+                    node->state = CO_NMTseq_NODE_READY;
+                    node->timer_us = 0;
+                }
+                else {
+                    node->state = CO_NMTseq_NODE_ERROR;
+                }
+            }
+        }
+        else if (node->state != CO_NMTseq_NODE_READY
+                 && node->timer_us >= seq->timeout_us
+        ) {
+            /* no Heartbeat or configuration took too long */
+            node->state = CO_NMTseq_NODE_ERROR;
+        }
+
+        if (node->state == CO_NMTseq_NODE_ERROR) {
+            seq->state = CO_NMTseq_ERROR;
+            return seq->state;
+        }
+
+        allOperational = false;
+        if (node->state == CO_NMTseq_NODE_READY) {
+            anyReady = true;
+        }
+        else if (node->state != CO_NMTseq_NODE_STARTING) {
+            allReady = false;
+        }
+
+#if (CO_CONFIG_NMT_SEQ) & CO_CONFIG_FLAG_TIMERNEXT
+        if (timerNext_us != NULL && node->timer_us < seq->timeout_us) {
+            uint32_t diff = seq->timeout_us - node->timer_us;
+            if (*timerNext_us > diff) {
+                *timerNext_us = diff;
+            }
+        }
+#endif
+    }
+
+    if (allOperational) {
+        /* wave is finished, the next one starts in the next cycle */
+        seq->groupsDone |= seq->groupsWave;
+        seq->groupsWave = 0;
+#if (CO_CONFIG_NMT_SEQ) & CO_CONFIG_FLAG_TIMERNEXT
+        if (timerNext_us != NULL) {
+            *timerNext_us = 0;
+        }
+#endif
+    }
+    else if (broadcast && allReady && anyReady && commandStart(seq, 0)) {
+        /* single command for all nodes of the last wave */
+        seq->broadcastSent = true;
+        for (uint8_t i = 0; i < seq->nodesCount; i++) {
+            CO_NMTseq_node_t *node = &seq->nodes[i];
+
+            if (node->state == CO_NMTseq_NODE_READY) {
+                node->state = CO_NMTseq_NODE_STARTING;
+                node->timer_us = 0;
+            }
+        }
+    }
+
+    return seq->state;
+}
+
+#endif /* (CO_CONFIG_NMT_SEQ) & CO_CONFIG_NMT_SEQ_ENABLE */
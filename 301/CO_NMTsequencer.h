@@ -0,0 +1,328 @@
+/**
+ * CANopen NMT master startup sequencer, non-standard.
+ *
+ * @file        CO_NMTsequencer.h
+ * @ingroup     CO_NMTsequencer
+ * @author      J-Weisberg
+ * @copyright   2026 J-Weisberg
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CO_NMT_SEQUENCER_H
+#define CO_NMT_SEQUENCER_H
+
+#include "301/CO_driver.h"
+#include "301/CO_NMT_Heartbeat.h"
+#include "301/CO_HBconsumer.h"
+
+/* default configuration, see CO_config.h */
+#ifndef CO_CONFIG_NMT_SEQ
+#define CO_CONFIG_NMT_SEQ (0)
+#endif
+
+#if ((CO_CONFIG_NMT_SEQ) & CO_CONFIG_NMT_SEQ_ENABLE) || defined CO_DOXYGEN
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup CO_NMTsequencer NMT startup sequencer
+ * CANopen NMT master startup sequencer, non-standard.
+ *
+ * @ingroup CO_CANopen_301
+ * @{
+ * NMT startup sequencer brings the nodes of the network into NMT operational
+ * state in the order of their dependencies.
+ *
+ * Each node is added to a group with CO_NMTseq_addNode(). Group may depend on
+ * other groups, see CO_NMTseq_setDependency(). Nodes of the group are started
+ * only after all nodes of the groups, on which it depends, are operational.
+ * All groups, whose dependencies are fulfilled, are processed at the same
+ * time, as one wave.
+ *
+ * For each node in the wave sequencer:
+ *  - waits for the Heartbeat of the node in NMT pre-operational state. Node,
+ *    which is already operational, is finished without further steps.
+ *  - calls the configure callback, see CO_NMTseq_initCallbackConfigure(). It
+ *    is called cyclically, until it returns done or error, so it may run
+ *    non-blocking SDO transfers. Callback is called for all nodes of the wave
+ *    in the same cycle, application decides, how many of them it serves in
+ *    parallel.
+ *  - sends NMT command start remote node, as soon as CAN transmit buffer is
+ *    free. Command is addressed to the node-ID, so nodes, which are not added
+ *    to the sequencer, are left in their NMT state. Single command to all
+ *    nodes (node-ID 0) is used only with @ref CO_NMT_SEQ_FLAG_BROADCAST, see
+ *    there.
+ *  - waits for the Heartbeat of the node in NMT operational state. Command is
+ *    repeated on timeout, until retries are exhausted.
+ *
+ * Node states are verified by bitmaps from @ref CO_HBconsumer with
+ * @ref CO_CONFIG_HB_CONS_STATE_TRACKER. All nodes must be monitored by the
+ * Heartbeat consumer. NMT commands are sent by CO_NMT_sendCommand(), so
+ * @ref CO_CONFIG_NMT_MASTER must be enabled.
+ *
+ * Sequence is started by CO_NMTseq_start() and must then be processed
+ * cyclically by CO_NMTseq_process(), until it returns other value than
+ * CO_NMTseq_BUSY. State of each node is in the nodes array of
+ * @ref CO_NMTseq_t.
+ */
+
+/** Maximum number of nodes in the sequencer */
+#define CO_NMT_SEQ_NODES_MAX 127U
+/** Maximum number of groups, group numbers are 0 to CO_NMT_SEQ_GROUPS_MAX-1 */
+#define CO_NMT_SEQ_GROUPS_MAX 32U
+
+/** Flags for CO_NMTseq_start() */
+typedef enum {
+    /** Application confirms, that all nodes on the network are added to the
+     * sequencer. Then the last wave is started with single NMT command to all
+     * nodes, if all its remaining nodes are ready at the same time, this node
+     * is operational and all other nodes monitored by the Heartbeat consumer
+     * are operational. Otherwise, and for repeated commands, each node is
+     * started with its own command. */
+    CO_NMT_SEQ_FLAG_BROADCAST = 0x01U
+} CO_NMTseq_flag_t;
+
+
+/**
+ * State of one node in the @ref CO_NMTseq_t.
+ */
+typedef enum {
+    /** Waiting for the groups, on which the node depends */
+    CO_NMTseq_NODE_WAIT_DEPENDENCY = 0,
+    /** Waiting for the Heartbeat in NMT pre-operational state */
+    CO_NMTseq_NODE_WAIT_BOOT = 1,
+    /** Configure callback is in progress */
+    CO_NMTseq_NODE_CONFIGURE = 2,
+    /** Configured, waiting for the NMT start command */
+    CO_NMTseq_NODE_READY = 3,
+    /** NMT start command sent, waiting for the Heartbeat confirmation */
+    CO_NMTseq_NODE_STARTING = 4,
+    /** Node is NMT operational */
+    CO_NMTseq_NODE_OPERATIONAL = 5,
+    /** Node timed out or configure callback failed */
+    CO_NMTseq_NODE_ERROR = 6
+} CO_NMTseq_nodeState_t;
+
+
+/**
+ * Return values from configure callback, see
+ * CO_NMTseq_initCallbackConfigure().
+ */
+typedef enum {
+    /** Node is configured */
+    CO_NMTseq_CONFIG_DONE = 0,
+    /** Configuration is in progress, callback will be called again */
+    CO_NMTseq_CONFIG_BUSY = 1,
+    /** Configuration failed, sequence is aborted */
+    CO_NMTseq_CONFIG_ERROR = -1
+} CO_NMTseq_config_t;
+
+
+/**
+ * Return values from CO_NMTseq_process().
+ */
+typedef enum {
+    /** Sequence is not started */
+    CO_NMTseq_IDLE = 0,
+    /** Sequence is in progress */
+    CO_NMTseq_BUSY = 1,
+    /** All nodes are operational */
+    CO_NMTseq_DONE = 2,
+    /** Sequence is aborted, see nodes with state CO_NMTseq_NODE_ERROR */
+    CO_NMTseq_ERROR = -1
+} CO_NMTseq_return_t;
+
+
+/**
+ * One node inside @ref CO_NMTseq_t.
+ */
+typedef struct {
+    /** Node-ID, from CO_NMTseq_addNode() */
+    uint8_t nodeId;
+    /** Group of the node, from CO_NMTseq_addNode() */
+    uint8_t group;
+    /** State of the node, see @ref CO_NMTseq_nodeState_t */
+    CO_NMTseq_nodeState_t state;
+    /** Remaining repetitions of the NMT start command */
+    uint8_t retries;
+    /** Time in the current state in microseconds */
+    uint32_t timer_us;
+} CO_NMTseq_node_t;
+
+
+/**
+ * NMT startup sequencer object.
+ */
+typedef struct {
+    /** Nodes in the order of CO_NMTseq_addNode() */
+    CO_NMTseq_node_t nodes[CO_NMT_SEQ_NODES_MAX];
+    /** Number of added nodes */
+    uint8_t nodesCount;
+    /** For each group bitmask of groups, which must be operational first */
+    uint32_t dependency[CO_NMT_SEQ_GROUPS_MAX];
+    /** Bitmask of groups with at least one node */
+    uint32_t groupsUsed;
+    /** Bitmask of groups with all nodes operational */
+    uint32_t groupsDone;
+    /** Bitmask of groups in the current wave */
+    uint32_t groupsWave;
+    /** Bitmap of added nodes */
+    CO_HBconsBitmap_t nodesAdded;
+    /** True, if command to all nodes was sent in the current sequence */
+    bool_t broadcastSent;
+    /** Return value of the last CO_NMTseq_process() */
+    CO_NMTseq_return_t state;
+    /** From CO_NMTseq_start() */
+    uint8_t flags;
+    /** From CO_NMTseq_start() */
+    uint8_t retries;
+    /** From CO_NMTseq_start(), in microseconds */
+    uint32_t timeout_us;
+    /** Number of NMT commands sent in the current sequence */
+    uint16_t commandsSent;
+    /** Number of waves in the current sequence */
+    uint8_t waves;
+    /** From CO_NMTseq_init() */
+    CO_NMT_t *NMT;
+    /** From CO_NMTseq_init() */
+    CO_HBconsumer_t *HBcons;
+    /** From CO_NMTseq_initCallbackConfigure() or NULL */
+    CO_NMTseq_config_t (*pFunctConfigure)(uint8_t nodeId, void *object);
+    /** From CO_NMTseq_initCallbackConfigure() or NULL */
+    void *functConfigureObject;
+} CO_NMTseq_t;
+
+
+/**
+ * Initialize NMT startup sequencer object.
+ *
+ * Function may be called in the communication reset section. All nodes and
+ * dependencies are cleared.
+ *
+ * @param seq This object will be initialized.
+ * @param NMT NMT object, used for sending NMT commands.
+ * @param HBcons Heartbeat consumer, which monitors all nodes of the sequencer.
+ *
+ * @return #CO_ReturnError_t: CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT.
+ */
+CO_ReturnError_t CO_NMTseq_init(CO_NMTseq_t *seq,
+                                CO_NMT_t *NMT,
+                                CO_HBconsumer_t *HBcons);
+
+
+/**
+ * Add node to the sequencer.
+ *
+ * @param seq This object.
+ * @param nodeId Node-ID, 1 to 127, each node may be added only once.
+ * @param group Group of the node, 0 to CO_NMT_SEQ_GROUPS_MAX-1.
+ *
+ * @return #CO_ReturnError_t: CO_ERROR_NO, CO_ERROR_ILLEGAL_ARGUMENT or
+ * CO_ERROR_OUT_OF_MEMORY.
+ */
+CO_ReturnError_t CO_NMTseq_addNode(CO_NMTseq_t *seq,
+                                   uint8_t nodeId,
+                                   uint8_t group);
+
+
+/**
+ * Set dependency of the group.
+ *
+ * @param seq This object.
+ * @param group Group, 0 to CO_NMT_SEQ_GROUPS_MAX-1.
+ * @param groupsBefore Bitmask of groups (bit 0 is group 0), which must be
+ * operational, before nodes of the group are configured and started. Groups
+ * without nodes are ignored. Group may not depend on itself.
+ *
+ * @return #CO_ReturnError_t: CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT.
+ */
+CO_ReturnError_t CO_NMTseq_setDependency(CO_NMTseq_t *seq,
+                                         uint8_t group,
+                                         uint32_t groupsBefore);
+
+
+/**
+ * Initialize configure callback function.
+ *
+ * Function is called cyclically from CO_NMTseq_process() for the node in NMT
+ * pre-operational state, until it returns CO_NMTseq_CONFIG_DONE or
+ * CO_NMTseq_CONFIG_ERROR. It may verify or write configuration of the node,
+ * for example with non-blocking SDO client. Without callback nodes are not
+ * configured.
+ *
+ * @param seq This object.
+ * @param object Pointer to object, which will be passed to pFunctConfigure().
+ * Can be NULL.
+ * @param pFunctConfigure Pointer to the callback function. Not called if NULL.
+ */
+void CO_NMTseq_initCallbackConfigure(
+        CO_NMTseq_t            *seq,
+        void                   *object,
+        CO_NMTseq_config_t    (*pFunctConfigure)(uint8_t nodeId,
+                                                 void *object));
+
+
+/**
+ * Start NMT startup sequence.
+ *
+ * Sequence may be restarted, while it is in progress. Nodes, which are already
+ * operational, are not started again.
+ *
+ * @param seq This object.
+ * @param flags Combination of @ref CO_NMTseq_flag_t.
+ * @param timeout_ms Timeout for the Heartbeat of each node, for its
+ * configuration and for the confirmation of NMT start command.
+ * @param retries Number of repetitions of the NMT start command after timeout.
+ *
+ * @return #CO_ReturnError_t: CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT, if a
+ * group dependency can never be fulfilled.
+ */
+CO_ReturnError_t CO_NMTseq_start(CO_NMTseq_t *seq,
+                                 uint8_t flags,
+                                 uint16_t timeout_ms,
+                                 uint8_t retries);
+
+
+/**
+ * Process NMT startup sequence.
+ *
+ * Function must be called cyclically after CO_NMTseq_start(), after
+ * CO_HBconsumer_process().
+ *
+ * @param seq This object.
+ * @param timeDifference_us Time difference from previous function call.
+ * @param [out] timerNext_us info to OS - see CO_process().
+ *
+ * @return @ref CO_NMTseq_return_t.
+ */
+CO_NMTseq_return_t CO_NMTseq_process(CO_NMTseq_t *seq,
+                                     uint32_t timeDifference_us,
+                                     uint32_t *timerNext_us);
+
+
+/** @} */ /* CO_NMTsequencer */
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+
+#endif /* (CO_CONFIG_NMT_SEQ) & CO_CONFIG_NMT_SEQ_ENABLE */
+
+#endif /* CO_NMT_SEQUENCER_H */
@@ -26,6 +26,15 @@
 #define OD_DEFINITION
 #include "301/CO_ODinterface.h"
 
+#if (CO_CONFIG_OD) & CO_CONFIG_OD_DOMAIN_FILE
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
 
 /******************************************************************************/
 ODR_t OD_readOriginal(OD_stream_t *stream, void *buf,
@@ -351,3 +360,228 @@ void *OD_getPtr(const OD_entry_t *entry, uint8_t subIndex, OD_size_t len,
 
     return errCopy == ODR_OK ? stream->dataOrig : NULL;
 }
+
+
+#if (CO_CONFIG_OD) & CO_CONFIG_OD_DOMAIN_FILE
+/* Write all data to the file, repeat on partial write or interrupt. */
+static bool_t domainFileWrite(int fd, const uint8_t *data, size_t len) {
+    while (len > 0) {
+        ssize_t n = write(fd, data, len);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        data += n;
+        len -= (size_t)n;
+    }
+    return true;
+}
+
+/******************************************************************************/
+ODR_t OD_domainFile_init(OD_domainFile_t *df,
+                         OD_entry_t *entry,
+                         const char *fileName,
+                         uint8_t *writeBuf,
+                         OD_size_t writeBufSize)
+{
+    if (df == NULL || fileName == NULL
+        || (writeBuf != NULL && writeBufSize == 0)
+        || strlen(fileName) + sizeof(".tmp") > sizeof(df->tmpName)
+    ) {
+        return ODR_DEV_INCOMPAT;
+    }
+
+    memset(df, 0, sizeof(OD_domainFile_t));
+    df->fileName = fileName;
+    strcpy(df->tmpName, fileName);
+    strcat(df->tmpName, ".tmp");
+    df->fd = -1;
+    df->buf = writeBuf;
+    df->bufSize = writeBufSize;
+
+    df->extension.object = df;
+    df->extension.read = OD_domainFile_read;
+    df->extension.write = writeBuf != NULL ? OD_domainFile_write : NULL;
+
+    return OD_extension_init(entry, &df->extension);
+}
+
+/******************************************************************************/
+ODR_t OD_domainFile_read(OD_stream_t *stream, void *buf,
+                         OD_size_t count, OD_size_t *countRead)
+{
+    if (stream == NULL || stream->object == NULL || buf == NULL
+        || countRead == NULL
+    ) {
+        return ODR_DEV_INCOMPAT;
+    }
+
+    OD_domainFile_t *df = (OD_domainFile_t *)stream->object;
+
+    /* start of the transfer, map the file and indicate its size */
+    if (stream->dataOffset == 0) {
+        struct stat st;
+
+        OD_domainFile_close(df);
+        df->fd = open(df->fileName, O_RDONLY);
+        if (df->fd < 0) {
+            return ODR_NO_DATA;
+        }
+        if (fstat(df->fd, &st) != 0 || st.st_size < 0
+            || (uint64_t)st.st_size > (OD_size_t)(-1)
+        ) {
+            OD_domainFile_close(df);
+            return ODR_HW;
+        }
+        df->mapSize = (OD_size_t)st.st_size;
+        if (df->mapSize > 0) {
+            void *map = mmap(NULL, df->mapSize, PROT_READ, MAP_SHARED,
+                             df->fd, 0);
+            if (map == MAP_FAILED) {
+                OD_domainFile_close(df);
+                return ODR_HW;
+            }
+            df->map = (uint8_t *)map;
+            (void)madvise(map, df->mapSize, MADV_SEQUENTIAL);
+        }
+        stream->dataLength = df->mapSize;
+    }
+    else if (df->fd < 0 || stream->dataOffset > df->mapSize) {
+        /* file was closed in the middle of the transfer */
+        return ODR_DATA_DEV_STATE;
+    }
+
+    OD_size_t remain = df->mapSize - stream->dataOffset;
+    OD_size_t countCopy = remain > count ? count : remain;
+
+    if (countCopy > 0) {
+        memcpy(buf, df->map + stream->dataOffset, countCopy);
+    }
+    *countRead = countCopy;
+
+    if (countCopy < remain) {
+        stream->dataOffset += countCopy;
+        return ODR_PARTIAL;
+    }
+
+    /* read finished */
+    OD_domainFile_close(df);
+    stream->dataOffset = 0;
+    return ODR_OK;
+}
+
+/******************************************************************************/
+ODR_t OD_domainFile_write(OD_stream_t *stream, const void *buf,
+                          OD_size_t count, OD_size_t *countWritten)
+{
+    if (stream == NULL || stream->object == NULL || buf == NULL
+        || countWritten == NULL
+    ) {
+        return ODR_DEV_INCOMPAT;
+    }
+
+    OD_domainFile_t *df = (OD_domainFile_t *)stream->object;
+
+    if (df->buf == NULL) {
+        return ODR_READONLY;
+    }
+
+    /* start of the transfer, data are written to the temporary file */
+    if (stream->dataOffset == 0) {
+        OD_domainFile_close(df);
+        df->fd = open(df->tmpName, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (df->fd < 0) {
+            return ODR_DATA_TRANSF;
+        }
+        df->writing = true;
+    }
+    else if (df->fd < 0 || !df->writing) {
+        /* file was closed in the middle of the transfer */
+        return ODR_DATA_DEV_STATE;
+    }
+
+    /* Append data to the buffer, write it to the file, when the buffer is
+     * full. Large data are written directly, if the buffer is empty. */
+    const uint8_t *data = (const uint8_t *)buf;
+    OD_size_t remain = count;
+    while (remain > 0) {
+        if (df->bufCount == 0 && remain >= df->bufSize) {
+            if (!domainFileWrite(df->fd, data, remain)) {
+                OD_domainFile_close(df);
+                return ODR_HW;
+            }
+            break;
+        }
+
+        OD_size_t countCopy = df->bufSize - df->bufCount;
+        if (countCopy > remain) {
+            countCopy = remain;
+        }
+        memcpy(df->buf + df->bufCount, data, countCopy);
+        df->bufCount += countCopy;
+        data += countCopy;
+        remain -= countCopy;
+
+        if (df->bufCount == df->bufSize) {
+            df->bufCount = 0;
+            if (!domainFileWrite(df->fd, df->buf, df->bufSize)) {
+                OD_domainFile_close(df);
+                return ODR_HW;
+            }
+        }
+    }
+
+    stream->dataOffset += count;
+    *countWritten = count;
+
+    /* SDO server indicates the end of data with stream->dataLength */
+    if (stream->dataLength == 0 || stream->dataOffset < stream->dataLength) {
+        return ODR_PARTIAL;
+    }
+
+    /* write finished, write remaining data, synchronize the temporary file
+     * and replace the original file with it */
+    bool_t ok = domainFileWrite(df->fd, df->buf, df->bufCount)
+                && fsync(df->fd) == 0;
+    if (close(df->fd) != 0) {
+        ok = false;
+    }
+    df->fd = -1;
+    df->writing = false;
+    df->bufCount = 0;
+    if (ok && rename(df->tmpName, df->fileName) != 0) {
+        ok = false;
+    }
+    if (!ok) {
+        (void)unlink(df->tmpName);
+    }
+    stream->dataOffset = 0;
+
+    return ok ? ODR_OK : ODR_HW;
+}
+
+/******************************************************************************/
+void OD_domainFile_close(OD_domainFile_t *df) {
+    if (df == NULL) {
+        return;
+    }
+
+    if (df->map != NULL) {
+        (void)munmap(df->map, df->mapSize);
+        df->map = NULL;
+    }
+    if (df->fd >= 0) {
+        (void)close(df->fd);
+        df->fd = -1;
+        /* discard data of unfinished write */
+        if (df->writing) {
+            (void)unlink(df->tmpName);
+        }
+    }
+    df->writing = false;
+    df->mapSize = 0;
+    df->bufCount = 0;
+}
+#endif /* (CO_CONFIG_OD) & CO_CONFIG_OD_DOMAIN_FILE */
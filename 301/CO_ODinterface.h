@@ -28,6 +28,11 @@
 
 #include "301/CO_driver.h"
 
+/* default configuration, see CO_config.h */
+#ifndef CO_CONFIG_OD
+#define CO_CONFIG_OD (0)
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -511,7 +516,7 @@ static inline void OD_requestTPDO(uint8_t *flagsPDO, uint8_t subIndex) {
 #if OD_FLAGS_PDO_SIZE > 0
     if (flagsPDO != NULL && subIndex < (OD_FLAGS_PDO_SIZE * 8)) {
         /* clear subIndex-th bit */
-        uint8_t mask = static_cast<uint8_t>(~(1U << (subIndex & 0x07U)));
+        uint8_t mask = (uint8_t)~(1U << (subIndex & 0x07U));
         flagsPDO[subIndex >> 3] &= mask;
     }
 #endif
@@ -795,6 +800,136 @@ void *OD_getPtr(const OD_entry_t *entry, uint8_t subIndex, OD_size_t len,
 /** @} */ /* CO_ODgetSetters */
 
 
+#if ((CO_CONFIG_OD) & CO_CONFIG_OD_DOMAIN_FILE) || defined CO_DOXYGEN
+/**
+ * @defgroup CO_ODdomainFile DOMAIN objects stored in files
+ * @{
+ *
+ * Read and write functions for OD extension, which connect DOMAIN object to a
+ * file
+ *
+ * Large data, such as firmware images, data logs or configuration blobs, are
+ * usually accessed as DOMAIN objects via SDO segmented or block transfer. Object
+ * Dictionary has no memory for such objects (dataOrig is NULL and dataLength is
+ * 0 in OD). Functions here transfer data directly between SDO buffer and file:
+ * - Read (SDO upload) maps the file into memory with mmap. Size of the file is
+ *   written to stream->dataLength in first read call, so SDO server indicates
+ *   the size to the client. Data are then copied from the mapped memory at
+ *   position stream->dataOffset.
+ * - Write (SDO download) creates temporary file "<fileName>.tmp" in first
+ *   write call. Data are then appended to the write buffer and written to the
+ *   temporary file, when the buffer is full. When SDO server indicates end of
+ *   data (stream->dataLength is set and reached), remaining data are written,
+ *   temporary file is synchronized with fsync, closed and renamed to fileName.
+ *   So the file always contains complete data, from previous or from new
+ *   download.
+ *
+ * Read or write is started, when stream->dataOffset is zero. If previous
+ * transfer was not finished (SDO abort, for example), its file is closed first.
+ * Temporary file of unfinished download is deleted, when it is closed. Only
+ * one transfer at a time is possible on one object.
+ *
+ * Example for OD object 0x2100, which is DOMAIN:
+ * @code{.c}
+static uint8_t fwBuf[4096];
+static OD_domainFile_t fwDomain;
+
+OD_domainFile_init(&fwDomain, OD_find(OD, 0x2100), "/var/lib/fw.bin",
+                   fwBuf, sizeof(fwBuf));
+ * @endcode
+ */
+
+#ifndef OD_DOMAIN_FILE_NAME_SIZE
+/** Size of the buffer for the name of the temporary file inside
+ * @ref OD_domainFile_t, including ".tmp" suffix and terminating zero. */
+#define OD_DOMAIN_FILE_NAME_SIZE 256
+#endif
+
+/**
+ * DOMAIN object stored in file, object for @ref OD_extension_t
+ */
+typedef struct {
+    /** Extension for OD object */
+    OD_extension_t extension;
+    /** Name of the file, from @ref OD_domainFile_init() */
+    const char *fileName;
+    /** File descriptor of the open file or -1 */
+    int fd;
+    /** Memory mapped file for reading or NULL */
+    uint8_t *map;
+    /** Size of the memory mapped file */
+    OD_size_t mapSize;
+    /** Write buffer, from @ref OD_domainFile_init() */
+    uint8_t *buf;
+    /** Size of the write buffer */
+    OD_size_t bufSize;
+    /** Number of bytes in the write buffer, which are not written yet */
+    OD_size_t bufCount;
+    /** True, if fd is the temporary file of unfinished write */
+    bool_t writing;
+    /** Name of the temporary file for write, fileName with ".tmp" suffix */
+    char tmpName[OD_DOMAIN_FILE_NAME_SIZE];
+} OD_domainFile_t;
+
+
+/**
+ * Initialize DOMAIN object stored in file and connect it to OD entry
+ *
+ * Function initializes extension on OD entry with @ref OD_domainFile_read()
+ * and @ref OD_domainFile_write() functions. OD object must be DOMAIN or other
+ * object without memory in Object Dictionary.
+ *
+ * @param df This object will be initialized. It must exist permanently.
+ * @param entry OD entry returned by @ref OD_find().
+ * @param fileName Name of the file, string must exist permanently. It must be
+ * shorter than @ref OD_DOMAIN_FILE_NAME_SIZE - 4 characters.
+ * @param writeBuf Buffer for data written to the file. If NULL, object is
+ * read only. Larger buffer means less write system calls.
+ * @param writeBufSize Size of the writeBuf in bytes.
+ *
+ * @return "ODR_OK" on success, "ODR_IDX_NOT_EXIST" if OD object doesn't exist,
+ * "ODR_DEV_INCOMPAT" in case of wrong arguments.
+ */
+ODR_t OD_domainFile_init(OD_domainFile_t *df,
+                         OD_entry_t *entry,
+                         const char *fileName,
+                         uint8_t *writeBuf,
+                         OD_size_t writeBufSize);
+
+
+/**
+ * Read function for DOMAIN object stored in file, see @ref OD_IO_t.
+ *
+ * stream->object must be @ref OD_domainFile_t.
+ */
+ODR_t OD_domainFile_read(OD_stream_t *stream, void *buf,
+                         OD_size_t count, OD_size_t *countRead);
+
+
+/**
+ * Write function for DOMAIN object stored in file, see @ref OD_IO_t.
+ *
+ * stream->object must be @ref OD_domainFile_t.
+ */
+ODR_t OD_domainFile_write(OD_stream_t *stream, const void *buf,
+                          OD_size_t count, OD_size_t *countWritten);
+
+
+/**
+ * Close the file of unfinished transfer
+ *
+ * It is not necessary to call this function, file is closed automatically at
+ * the end of transfer or at the start of the next transfer. Function may be
+ * called after SDO abort, to release the file immediately. Temporary file of
+ * unfinished write is deleted, original file stays unchanged.
+ *
+ * @param df DOMAIN object stored in file.
+ */
+void OD_domainFile_close(OD_domainFile_t *df);
+/** @} */ /* CO_ODdomainFile */
+#endif /* (CO_CONFIG_OD) & CO_CONFIG_OD_DOMAIN_FILE */
+
+
 #if defined OD_DEFINITION || defined CO_DOXYGEN
 /**
  * @defgroup CO_ODdefinition OD definition objects
@@ -437,6 +437,23 @@ static ODR_t OD_read_PDO_commParam(OD_stream_t *stream, void *buf,
 #endif /* (CO_CONFIG_PDO) & CO_CONFIG_FLAG_OD_DYNAMIC */
 
 
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_CALLBACK_EVENT
+/******************************************************************************/
+void CO_PDO_initCallbackEvent(CO_PDO_common_t *PDO,
+                              void *object,
+                              void (*pFunctSignalEvent)(void *object,
+                                                        const uint8_t *data,
+                                                        CO_PDO_size_t
+                                                            dataLength))
+{
+    if (PDO != NULL) {
+        PDO->functSignalObjectEvent = object;
+        PDO->pFunctSignalEvent = pFunctSignalEvent;
+    }
+}
+#endif
+
+
 /*******************************************************************************
  *      R P D O
  ******************************************************************************/
@@ -873,6 +890,13 @@ void CO_RPDO_process(CO_RPDO_t *RPDO,
             }
 #endif /* (CO_CONFIG_PDO) & CO_CONFIG_PDO_OD_IO_ACCESS */
 
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_CALLBACK_EVENT
+            if (PDO->pFunctSignalEvent != NULL) {
+                PDO->pFunctSignalEvent(PDO->functSignalObjectEvent,
+                                       RPDO->CANrxData[bufNo],
+                                       PDO->dataLength);
+            }
+#endif
         } /* while (CO_FLAG_READ(RPDO->CANrxNew[bufNo])) */
 
         /* verify RPDO timeout */
@@ -1310,7 +1334,18 @@ static CO_ReturnError_t CO_TPDOsend(CO_TPDO_t *TPDO) {
     TPDO->eventTimer = TPDO->eventTime_us;
     TPDO->inhibitTimer = TPDO->inhibitTime_us;
 #endif
+#if (CO_CONFIG_PDO) & CO_CONFIG_PDO_CALLBACK_EVENT
+    CO_ReturnError_t ret = CO_CANsend(PDO->CANdev, TPDO->CANtxBuff);
+
+    if (ret == CO_ERROR_NO && PDO->pFunctSignalEvent != NULL) {
+        PDO->pFunctSignalEvent(PDO->functSignalObjectEvent,
+                               TPDO->CANtxBuff->data,
+                               PDO->dataLength);
+    }
+    return ret;
+#else
     return CO_CANsend(PDO->CANdev, TPDO->CANtxBuff);
+#endif
 }
 
 
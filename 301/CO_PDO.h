@@ -235,9 +235,43 @@ typedef struct {
     /** Extension for OD object */
     OD_extension_t OD_mappingParam_extension;
 #endif
+#if ((CO_CONFIG_PDO) & CO_CONFIG_PDO_CALLBACK_EVENT) || defined CO_DOXYGEN
+    /** From CO_PDO_initCallbackEvent() or NULL */
+    void (*pFunctSignalEvent)(void *object,
+                              const uint8_t *data,
+                              CO_PDO_size_t dataLength);
+    /** From CO_PDO_initCallbackEvent() or NULL */
+    void *functSignalObjectEvent;
+#endif
 } CO_PDO_common_t;
 
 
+#if ((CO_CONFIG_PDO) & CO_CONFIG_PDO_CALLBACK_EVENT) || defined CO_DOXYGEN
+/**
+ * Initialize PDO event callback function.
+ *
+ * Function initializes optional callback function, which is called after RPDO
+ * data are written to the Object Dictionary variables (from CO_RPDO_process())
+ * or after TPDO is sent (from CO_TPDO_process()). Callback is called from the
+ * same thread as processing function and should be short.
+ *
+ * Callback is cleared by CO_RPDO_init() or CO_TPDO_init(), so it must be
+ * initialized after them.
+ *
+ * @param PDO PDO common properties, first element of CO_RPDO_t or CO_TPDO_t.
+ * @param object Pointer to object, which will be passed to pFunctSignalEvent().
+ * @param pFunctSignalEvent Pointer to the callback function. Not called if
+ * NULL. Arguments are object, PDO data and its length.
+ */
+void CO_PDO_initCallbackEvent(CO_PDO_common_t *PDO,
+                              void *object,
+                              void (*pFunctSignalEvent)(void *object,
+                                                        const uint8_t *data,
+                                                        CO_PDO_size_t
+                                                            dataLength));
+#endif
+
+
 /*******************************************************************************
  *      R P D O
  ******************************************************************************/
@@ -46,12 +46,120 @@
   #error CO_CONFIG_FIFO_CRC16_CCITT must be enabled.
  #endif
 #endif
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_BLOCK_ADAPTIVE
+ #if !((CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_BLOCK)
+  #error CO_CONFIG_SDO_CLI_BLOCK must be enabled.
+ #endif
+#endif
 
 /* default 'protocol switch threshold' size for block transfer */
 #ifndef CO_CONFIG_SDO_CLI_PST
 #define CO_CONFIG_SDO_CLI_PST 21
 #endif
 
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_BLOCK_ADAPTIVE
+/* bit in block_serverCap: server does not support block transfer */
+#define CO_SDO_CLI_CAP_NO_BLOCK 0x80U
+/* bits in block_serverCap: blksize for the next block upload */
+#define CO_SDO_CLI_CAP_BLKSIZE 0x7FU
+#define CO_SDO_CLI_BLKSIZE_MIN 8U
+/* number of clean sub-blocks in a row, after which blksize grows */
+#define CO_SDO_CLI_BLKSIZE_GROW 4U
+/* number of clean sub-blocks in a row just below the failed blksize, after
+ * which the failed blksize is raised by one */
+#define CO_SDO_CLI_BLKSIZE_DECAY 1024U
+
+/* Get remembered capabilities of the current SDO server */
+static inline uint8_t *serverCap(CO_SDOclient_t *SDO_C) {
+    return &SDO_C->block_serverCap[SDO_C->block_capIdx];
+}
+
+/* Select remembered capabilities of the SDO server with given CAN-ID. If server
+ * is not known, oldest entry is replaced and capabilities are unknown. */
+static void serverCapSelect(CO_SDOclient_t *SDO_C, uint16_t CanIdC2S) {
+    uint8_t i;
+
+    for (i = 0; i < CO_CONFIG_SDO_CLI_SERVER_CAP_COUNT; i++) {
+        if (SDO_C->block_capCanId[i] == CanIdC2S) {
+            SDO_C->block_capIdx = i;
+            return;
+        }
+    }
+    i = SDO_C->block_capNext;
+    SDO_C->block_capNext = (i + 1) % CO_CONFIG_SDO_CLI_SERVER_CAP_COUNT;
+    SDO_C->block_capCanId[i] = CanIdC2S;
+    SDO_C->block_serverCap[i] = 0;
+    SDO_C->block_capBlksizeFail[i] = 0;
+    SDO_C->block_capClean[i] = 0;
+    SDO_C->block_capIdx = i;
+}
+
+/*
+ * Calculate blksize for the next block upload from the current SDO server.
+ *
+ * Sub-block, which ended before all blksize segments were received, indicates
+ * lost segments (for example receive buffer overrun), which must be
+ * retransmitted. In that case failed blksize is remembered and blksize is
+ * reduced to the number of segments received successfully, but not below
+ * half. If no segment was received, loss is not related to blksize, which is
+ * then left unchanged.
+ *
+ * After CO_SDO_CLI_BLKSIZE_GROW clean sub-blocks in a row blksize grows back
+ * towards 127, but stays below the failed blksize. Failed blksize is raised by
+ * one after CO_SDO_CLI_BLKSIZE_DECAY clean sub-blocks in a row just below it,
+ * so server is probed with larger blksize only rarely.
+ */
+static uint8_t adaptBlksize(CO_SDOclient_t *SDO_C, bool_t retransmit) {
+    uint8_t *cap = serverCap(SDO_C);
+    uint8_t *blksizeFail = &SDO_C->block_capBlksizeFail[SDO_C->block_capIdx];
+    uint16_t *clean = &SDO_C->block_capClean[SDO_C->block_capIdx];
+    uint8_t blksize = *cap & CO_SDO_CLI_CAP_BLKSIZE;
+    uint8_t blksizeMax;
+
+    if (blksize == 0) {
+        blksize = 127;
+    }
+    if (retransmit) {
+        *clean = 0;
+        if (SDO_C->block_seqno > 0) {
+            uint8_t half = blksize / 2;
+            blksize = (SDO_C->block_seqno > half) ? SDO_C->block_seqno : half;
+            if (SDO_C->block_blksize > CO_SDO_CLI_BLKSIZE_MIN) {
+                *blksizeFail = SDO_C->block_blksize;
+                if (blksize >= *blksizeFail) {
+                    blksize = *blksizeFail - 1;
+                }
+            }
+            if (blksize < CO_SDO_CLI_BLKSIZE_MIN) {
+                blksize = CO_SDO_CLI_BLKSIZE_MIN;
+            }
+        }
+        *cap = (*cap & CO_SDO_CLI_CAP_NO_BLOCK) | blksize;
+        return blksize;
+    }
+
+    if (*clean < 0xFFFFU) {
+        (*clean)++;
+    }
+    blksizeMax = (*blksizeFail != 0) ? *blksizeFail - 1 : 127;
+    if (blksize >= blksizeMax) {
+        /* decay the failed blksize */
+        if (*blksizeFail != 0 && *clean >= CO_SDO_CLI_BLKSIZE_DECAY) {
+            *blksizeFail = (*blksizeFail < 127) ? *blksizeFail + 1 : 0;
+            *clean = 0;
+        }
+    }
+    else if (*clean >= CO_SDO_CLI_BLKSIZE_GROW) {
+        uint8_t inc = blksize / 16 + 1;
+        blksize = (blksize > (blksizeMax - inc)) ? blksizeMax : blksize + inc;
+        *clean = 0;
+    }
+
+    *cap = (*cap & CO_SDO_CLI_CAP_NO_BLOCK) | blksize;
+    return blksize;
+}
+#endif
+
 
 /*
  * Read received message from CAN module.
@@ -283,6 +391,15 @@ CO_ReturnError_t CO_SDOclient_init(CO_SDOclient_t *SDO_C,
     /* prepare circular fifo buffer */
     CO_fifo_init(&SDO_C->bufFifo, SDO_C->buf,
                  CO_CONFIG_SDO_CLI_BUFFER_SIZE + 1);
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_BLOCK_ADAPTIVE
+    memset(SDO_C->block_capCanId, 0, sizeof(SDO_C->block_capCanId));
+    memset(SDO_C->block_serverCap, 0, sizeof(SDO_C->block_serverCap));
+    memset(SDO_C->block_capBlksizeFail, 0,
+           sizeof(SDO_C->block_capBlksizeFail));
+    memset(SDO_C->block_capClean, 0, sizeof(SDO_C->block_capClean));
+    SDO_C->block_capIdx = 0;
+    SDO_C->block_capNext = 0;
+#endif
 
     /* Get parameters from Object Dictionary (initial values) */
     uint8_t maxSubIndex, nodeIDOfTheSDOServer;
@@ -341,6 +458,64 @@ void CO_SDOclient_initCallbackPre(CO_SDOclient_t *SDOclient,
 }
 #endif
 
+/******************************************************************************/
+void CO_SDOclient_receiveForward(CO_SDOclient_t *SDO_C, void *msg) {
+    if (SDO_C->CANrxIdent != 0
+        && CO_CANrxMsg_readIdent(msg) == SDO_C->CANrxIdent
+    ) {
+        CO_SDOclient_receive((void*)SDO_C, msg);
+    }
+}
+
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_LOCAL
+/*
+ * Find entry in own Object Dictionary for local transfer and verify access.
+ * Called once at the beginning of the transfer. On error OD_IO functions are
+ * cleared.
+ *
+ * @param SDO_C This object.
+ * @param download True for download, false for upload.
+ *
+ * @return CO_SDO_AB_NONE on success, otherwise reason of error.
+ */
+static CO_SDO_abortCode_t localFindOD(CO_SDOclient_t *SDO_C,
+                                      bool_t download)
+{
+    CO_SDO_abortCode_t abortCode = CO_SDO_AB_NONE;
+    ODR_t odRet = OD_getSub(OD_find(SDO_C->OD, SDO_C->index),
+                            SDO_C->subIndex, &SDO_C->OD_IO, false);
+
+    if (odRet != ODR_OK) {
+        abortCode = (CO_SDO_abortCode_t)OD_getSDOabCode(odRet);
+    }
+    else if ((SDO_C->OD_IO.stream.attribute & ODA_SDO_RW) == 0) {
+        abortCode = CO_SDO_AB_UNSUPPORTED_ACCESS;
+    }
+    else if (download) {
+        if ((SDO_C->OD_IO.stream.attribute & ODA_SDO_W) == 0) {
+            abortCode = CO_SDO_AB_READONLY;
+        }
+        else if (SDO_C->OD_IO.write == NULL) {
+            abortCode = CO_SDO_AB_DEVICE_INCOMPAT;
+        }
+    }
+    else {
+        if ((SDO_C->OD_IO.stream.attribute & ODA_SDO_R) == 0) {
+            abortCode = CO_SDO_AB_WRITEONLY;
+        }
+        else if (SDO_C->OD_IO.read == NULL) {
+            abortCode = CO_SDO_AB_DEVICE_INCOMPAT;
+        }
+    }
+
+    if (abortCode != CO_SDO_AB_NONE) {
+        SDO_C->OD_IO.read = NULL;
+        SDO_C->OD_IO.write = NULL;
+    }
+    return abortCode;
+}
+#endif
+
 #if ((CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_LOCAL) && defined CO_BIG_ENDIAN
 static inline void reverseBytes(void *start, OD_size_t size) {
     uint8_t *lo = (uint8_t *)start;
@@ -396,6 +571,12 @@ CO_SDO_return_t CO_SDOclient_setup(CO_SDOclient_t *SDO_C,
         CanIdS2C = 0;
         SDO_C->valid = false;
     }
+    SDO_C->CANrxIdent = CanIdS2C;
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_BLOCK_ADAPTIVE
+    if (SDO_C->valid) {
+        serverCapSelect(SDO_C, CanIdC2S);
+    }
+#endif
 
     /* configure SDO client CAN reception */
     CO_ReturnError_t ret = CO_CANrxBufferInit(
@@ -451,6 +632,12 @@ CO_SDO_return_t CO_SDOclientDownloadInitiate(CO_SDOclient_t *SDO_C,
     SDO_C->timeoutTimer = 0;
     CO_fifo_reset(&SDO_C->bufFifo);
 
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_BLOCK_ADAPTIVE
+    if ((*serverCap(SDO_C) & CO_SDO_CLI_CAP_NO_BLOCK) != 0) {
+        blockEnable = false;
+    }
+#endif
+
 #if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_LOCAL
     /* if node-ID of the SDO server is the same as node-ID of this node, then
      * transfer data within this node */
@@ -509,6 +696,111 @@ size_t CO_SDOclientDownloadBufWrite(CO_SDOclient_t *SDO_C,
 }
 
 
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_LOCAL
+/******************************************************************************/
+CO_SDO_return_t CO_SDOclientDownloadLocal(CO_SDOclient_t *SDO_C,
+                                          const uint8_t *buf,
+                                          size_t count,
+                                          CO_SDO_abortCode_t *SDOabortCode)
+{
+    CO_SDO_return_t ret = CO_SDO_RT_endedWithClientAbort;
+    CO_SDO_abortCode_t abortCode;
+
+    /* only before the first pass of the local transfer */
+    if (SDO_C == NULL || buf == NULL || !SDO_C->valid
+        || SDO_C->state != CO_SDO_ST_DOWNLOAD_LOCAL_TRANSFER
+        || SDO_C->OD_IO.write != NULL
+        || CO_fifo_getOccupied(&SDO_C->bufFifo) != 0
+    ) {
+        return CO_SDO_RT_wrongArguments;
+    }
+
+    abortCode = localFindOD(SDO_C, true);
+
+    if (abortCode != CO_SDO_AB_NONE) {
+        /* error already set */
+    }
+    else if (count == 0) {
+        abortCode = CO_SDO_AB_DEVICE_INCOMPAT;
+    }
+    else if (SDO_C->sizeInd > 0 && count != SDO_C->sizeInd) {
+        abortCode = (count > SDO_C->sizeInd) ?
+                    CO_SDO_AB_DATA_LONG : CO_SDO_AB_DATA_SHORT;
+    }
+    else {
+        OD_size_t sizeInOd = SDO_C->OD_IO.stream.dataLength;
+        const uint8_t *data = buf;
+        uint8_t zeros[2] = {0, 0};
+        OD_size_t countZeros = 0;
+
+#ifdef CO_BIG_ENDIAN
+        /* swap int16_t .. uint64_t data if necessary */
+        uint8_t bufSwap[8];
+        if ((SDO_C->OD_IO.stream.attribute & ODA_MB) != 0
+            && count <= sizeof(bufSwap)
+        ) {
+            memcpy(bufSwap, buf, count);
+            reverseBytes(bufSwap, (OD_size_t)count);
+            data = bufSwap;
+        }
+#endif
+        /* If dataType is string and data are shorter than OD data buffer, then
+         * terminate (unicode) string with two zero bytes, written after data.
+         * Shorten also OD data size, see CO_SDOclientDownload(). */
+        if ((SDO_C->OD_IO.stream.attribute & ODA_STR) != 0
+            && (sizeInOd == 0 || count < sizeInOd)
+        ) {
+            countZeros = (sizeInOd == 0 || sizeInOd > count + 1) ? 2 : 1;
+            SDO_C->OD_IO.stream.dataLength = (OD_size_t)count + countZeros;
+        }
+        /* Indicate OD data size, if necessary. Used for EOF check. */
+        else if (sizeInOd == 0) {
+            SDO_C->OD_IO.stream.dataLength = (OD_size_t)count;
+        }
+        /* Verify if size of data matches data size in OD. */
+        else if (count != sizeInOd) {
+            abortCode = (count > sizeInOd) ?
+                        CO_SDO_AB_DATA_LONG : CO_SDO_AB_DATA_SHORT;
+        }
+
+        if (abortCode == CO_SDO_AB_NONE) {
+            OD_size_t countWritten = 0;
+            bool_t lock = OD_mappable(&SDO_C->OD_IO.stream);
+
+            /* write all data to Object Dictionary in one pass */
+            if (lock) { CO_LOCK_OD(SDO_C->CANdevTx); }
+            ODR_t odRet = SDO_C->OD_IO.write(&SDO_C->OD_IO.stream, data,
+                                             (OD_size_t)count, &countWritten);
+            if (odRet == ODR_PARTIAL && countZeros > 0) {
+                odRet = SDO_C->OD_IO.write(&SDO_C->OD_IO.stream, zeros,
+                                           countZeros, &countWritten);
+            }
+            if (lock) { CO_UNLOCK_OD(SDO_C->CANdevTx); }
+
+            if (odRet == ODR_PARTIAL) {
+                abortCode = CO_SDO_AB_DATA_SHORT;
+            }
+            else if (odRet != ODR_OK) {
+                abortCode = (CO_SDO_abortCode_t)OD_getSDOabCode(odRet);
+                ret = CO_SDO_RT_endedWithServerAbort;
+            }
+            else {
+                SDO_C->sizeTran = count + countZeros;
+                ret = CO_SDO_RT_ok_communicationEnd;
+            }
+        }
+    }
+
+    SDO_C->state = CO_SDO_ST_IDLE;
+    if (SDOabortCode != NULL) {
+        *SDOabortCode = abortCode;
+    }
+
+    return ret;
+}
+#endif
+
+
 /******************************************************************************/
 CO_SDO_return_t CO_SDOclientDownload(CO_SDOclient_t *SDO_C,
                                      uint32_t timeDifference_us,
@@ -535,25 +827,8 @@ CO_SDO_return_t CO_SDOclientDownload(CO_SDOclient_t *SDO_C,
     else if (SDO_C->state == CO_SDO_ST_DOWNLOAD_LOCAL_TRANSFER && !abort) {
         /* search object dictionary in first pass */
         if (SDO_C->OD_IO.write == NULL) {
-            ODR_t odRet;
-
-            odRet = OD_getSub(OD_find(SDO_C->OD, SDO_C->index), SDO_C->subIndex,
-                              &SDO_C->OD_IO, false);
-
-            if (odRet != ODR_OK) {
-                abortCode = (CO_SDO_abortCode_t)OD_getSDOabCode(odRet);
-                ret = CO_SDO_RT_endedWithClientAbort;
-            }
-            else if ((SDO_C->OD_IO.stream.attribute & ODA_SDO_RW) == 0) {
-                abortCode = CO_SDO_AB_UNSUPPORTED_ACCESS;
-                ret = CO_SDO_RT_endedWithClientAbort;
-            }
-            else if ((SDO_C->OD_IO.stream.attribute & ODA_SDO_W) == 0) {
-                abortCode = CO_SDO_AB_READONLY;
-                ret = CO_SDO_RT_endedWithClientAbort;
-            }
-            else if (SDO_C->OD_IO.write == NULL) {
-                abortCode = CO_SDO_AB_DEVICE_INCOMPAT;
+            abortCode = localFindOD(SDO_C, true);
+            if (abortCode != CO_SDO_AB_NONE) {
                 ret = CO_SDO_RT_endedWithClientAbort;
             }
         }
@@ -677,8 +952,22 @@ CO_SDO_return_t CO_SDOclientDownload(CO_SDOclient_t *SDO_C,
             uint32_t code;
             memcpy(&code, &SDO_C->CANrxData[4], sizeof(code));
             abortCode = (CO_SDO_abortCode_t)CO_SWAP_32(code);
-            SDO_C->state = CO_SDO_ST_IDLE;
-            ret = CO_SDO_RT_endedWithServerAbort;
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_BLOCK_ADAPTIVE
+            /* server does not support block transfer, remember that and
+             * repeat the request with regular transfer */
+            if (SDO_C->state == CO_SDO_ST_DOWNLOAD_BLK_INITIATE_RSP
+                && abortCode == CO_SDO_AB_CMD && !abort
+            ) {
+                *serverCap(SDO_C) |= CO_SDO_CLI_CAP_NO_BLOCK;
+                abortCode = CO_SDO_AB_NONE;
+                SDO_C->state = CO_SDO_ST_DOWNLOAD_INITIATE_REQ;
+            }
+            else
+#endif
+            {
+                SDO_C->state = CO_SDO_ST_IDLE;
+                ret = CO_SDO_RT_endedWithServerAbort;
+            }
         }
         else if (abort) {
             abortCode = (SDOabortCode != NULL)
@@ -878,6 +1167,17 @@ CO_SDO_return_t CO_SDOclientDownload(CO_SDOclient_t *SDO_C,
         size_t count;
         memset((void *)&SDO_C->CANtxBuff->data[0], 0, 8);
 
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_BLOCK_ADAPTIVE
+        /* Size was not indicated, but all data are already in the buffer. If
+         * data are short, regular transfer is faster than block transfer. */
+        if (SDO_C->state == CO_SDO_ST_DOWNLOAD_BLK_INITIATE_REQ
+            && SDO_C->sizeInd == 0 && !bufferPartial
+            && CO_fifo_getOccupied(&SDO_C->bufFifo) <= CO_CONFIG_SDO_CLI_PST
+        ) {
+            SDO_C->state = CO_SDO_ST_DOWNLOAD_INITIATE_REQ;
+        }
+#endif
+
         switch (SDO_C->state) {
         case CO_SDO_ST_DOWNLOAD_INITIATE_REQ: {
             SDO_C->CANtxBuff->data[0] = 0x20;
@@ -1123,6 +1423,12 @@ CO_SDO_return_t CO_SDOclientUploadInitiate(CO_SDOclient_t *SDO_C,
     SDO_C->block_SDOtimeoutTime_us = (uint32_t)SDOtimeoutTime_ms * 700;
 #endif
 
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_BLOCK_ADAPTIVE
+    if ((*serverCap(SDO_C) & CO_SDO_CLI_CAP_NO_BLOCK) != 0) {
+        blockEnable = false;
+    }
+#endif
+
 #if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_LOCAL
     /* if node-ID of the SDO server is the same as node-ID of this node, then
      * transfer data within this node */
@@ -1176,25 +1482,8 @@ CO_SDO_return_t CO_SDOclientUpload(CO_SDOclient_t *SDO_C,
     else if (SDO_C->state == CO_SDO_ST_UPLOAD_LOCAL_TRANSFER && !abort) {
         /* search object dictionary in first pass */
         if (SDO_C->OD_IO.read == NULL) {
-            ODR_t odRet;
-
-            odRet = OD_getSub(OD_find(SDO_C->OD, SDO_C->index), SDO_C->subIndex,
-                              &SDO_C->OD_IO, false);
-
-            if (odRet != ODR_OK) {
-                abortCode = (CO_SDO_abortCode_t)OD_getSDOabCode(odRet);
-                ret = CO_SDO_RT_endedWithClientAbort;
-            }
-            else if ((SDO_C->OD_IO.stream.attribute & ODA_SDO_RW) == 0) {
-                abortCode = CO_SDO_AB_UNSUPPORTED_ACCESS;
-                ret = CO_SDO_RT_endedWithClientAbort;
-            }
-            else if ((SDO_C->OD_IO.stream.attribute & ODA_SDO_R) == 0) {
-                abortCode = CO_SDO_AB_WRITEONLY;
-                ret = CO_SDO_RT_endedWithClientAbort;
-            }
-            else if (SDO_C->OD_IO.read == NULL) {
-                abortCode = CO_SDO_AB_DEVICE_INCOMPAT;
+            abortCode = localFindOD(SDO_C, false);
+            if (abortCode != CO_SDO_AB_NONE) {
                 ret = CO_SDO_RT_endedWithClientAbort;
             }
         }
@@ -1289,8 +1578,22 @@ CO_SDO_return_t CO_SDOclientUpload(CO_SDOclient_t *SDO_C,
             uint32_t code;
             memcpy(&code, &SDO_C->CANrxData[4], sizeof(code));
             abortCode = (CO_SDO_abortCode_t)CO_SWAP_32(code);
-            SDO_C->state = CO_SDO_ST_IDLE;
-            ret = CO_SDO_RT_endedWithServerAbort;
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_BLOCK_ADAPTIVE
+            /* server does not support block transfer, remember that and
+             * repeat the request with regular transfer */
+            if (SDO_C->state == CO_SDO_ST_UPLOAD_BLK_INITIATE_RSP
+                && abortCode == CO_SDO_AB_CMD && !abort
+            ) {
+                *serverCap(SDO_C) |= CO_SDO_CLI_CAP_NO_BLOCK;
+                abortCode = CO_SDO_AB_NONE;
+                SDO_C->state = CO_SDO_ST_UPLOAD_INITIATE_REQ;
+            }
+            else
+#endif
+            {
+                SDO_C->state = CO_SDO_ST_IDLE;
+                ret = CO_SDO_RT_endedWithServerAbort;
+            }
         }
         else if (abort) {
             abortCode = (SDOabortCode != NULL)
@@ -1663,6 +1966,14 @@ CO_SDO_return_t CO_SDOclientUpload(CO_SDOclient_t *SDO_C,
                 SDO_C->state = CO_SDO_ST_ABORT;
                 break;
             }
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_BLOCK_ADAPTIVE
+            /* use blksize from previous block upload from the same server */
+            if ((*serverCap(SDO_C) & CO_SDO_CLI_CAP_BLKSIZE) != 0
+                && count > (*serverCap(SDO_C) & CO_SDO_CLI_CAP_BLKSIZE)
+            ) {
+                count = *serverCap(SDO_C) & CO_SDO_CLI_CAP_BLKSIZE;
+            }
+#endif
             SDO_C->block_blksize = (uint8_t)count;
             SDO_C->CANtxBuff->data[4] = SDO_C->block_blksize;
             SDO_C->CANtxBuff->data[5] = CO_CONFIG_SDO_CLI_PST;
@@ -1735,6 +2046,16 @@ CO_SDO_return_t CO_SDOclientUpload(CO_SDOclient_t *SDO_C,
 #endif
                     break;
                 }
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_BLOCK_ADAPTIVE
+                {
+                    bool_t retransmit =
+                        SDO_C->block_seqno < SDO_C->block_blksize;
+                    uint8_t blksizeMax = adaptBlksize(SDO_C, retransmit);
+                    if (count > blksizeMax) {
+                        count = blksizeMax;
+                    }
+                }
+#endif
                 SDO_C->block_blksize = (uint8_t)count;
                 SDO_C->block_seqno = 0;
                 /* Block segments will be received in different thread. Make
@@ -1811,6 +2132,92 @@ CO_SDO_return_t CO_SDOclientUpload(CO_SDOclient_t *SDO_C,
 }
 
 
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_LOCAL
+/******************************************************************************/
+CO_SDO_return_t CO_SDOclientUploadLocal(CO_SDOclient_t *SDO_C,
+                                        uint8_t *buf,
+                                        size_t count,
+                                        size_t *countRead,
+                                        CO_SDO_abortCode_t *SDOabortCode)
+{
+    CO_SDO_return_t ret = CO_SDO_RT_endedWithClientAbort;
+    CO_SDO_abortCode_t abortCode;
+
+    /* only before the first pass of the local transfer */
+    if (SDO_C == NULL || buf == NULL || countRead == NULL || !SDO_C->valid
+        || SDO_C->state != CO_SDO_ST_UPLOAD_LOCAL_TRANSFER
+        || SDO_C->OD_IO.read != NULL
+    ) {
+        return CO_SDO_RT_wrongArguments;
+    }
+
+    *countRead = 0;
+    abortCode = localFindOD(SDO_C, false);
+
+    if (abortCode == CO_SDO_AB_NONE) {
+        OD_size_t countRd = 0;
+        bool_t lock = OD_mappable(&SDO_C->OD_IO.stream);
+
+        /* read data from Object Dictionary directly into the caller buffer */
+        if (lock) { CO_LOCK_OD(SDO_C->CANdevTx); }
+        ODR_t odRet = SDO_C->OD_IO.read(&SDO_C->OD_IO.stream, buf,
+                                        (OD_size_t)count, &countRd);
+        if (lock) { CO_UNLOCK_OD(SDO_C->CANdevTx); }
+
+        if (odRet != ODR_OK && odRet != ODR_PARTIAL) {
+            abortCode = (CO_SDO_abortCode_t)OD_getSDOabCode(odRet);
+            ret = CO_SDO_RT_endedWithServerAbort;
+        }
+        else {
+            /* if data is string, return only data up to null termination */
+            if (countRd > 0
+                && (SDO_C->OD_IO.stream.attribute & ODA_STR) != 0
+            ) {
+                const uint8_t *end = memchr(buf, 0, countRd);
+                OD_size_t countStr = (end != NULL)
+                                   ? (OD_size_t)(end - buf) : countRd;
+                if (countStr == 0) countStr = 1; /* no zero length */
+                if (countStr < countRd) {
+                    /* string terminator found, finish read, shorten data */
+                    countRd = countStr;
+                    odRet = ODR_OK;
+                    SDO_C->OD_IO.stream.dataLength = countRd;
+                }
+            }
+
+            *countRead = countRd;
+            SDO_C->sizeTran = countRd;
+            SDO_C->sizeInd = SDO_C->OD_IO.stream.dataLength;
+
+            /* verify size of data uploaded */
+            if (SDO_C->sizeInd > 0 && SDO_C->sizeTran > SDO_C->sizeInd) {
+                abortCode = CO_SDO_AB_DATA_LONG;
+            }
+            else if (odRet == ODR_PARTIAL) {
+                /* buf is full, rest of data will be streamed */
+                ret = CO_SDO_RT_uploadDataBufferFull;
+            }
+            else if (SDO_C->sizeInd > 0 && SDO_C->sizeTran < SDO_C->sizeInd) {
+                abortCode = CO_SDO_AB_DATA_SHORT;
+            }
+            else {
+                ret = CO_SDO_RT_ok_communicationEnd;
+            }
+        }
+    }
+
+    if (ret != CO_SDO_RT_uploadDataBufferFull) {
+        SDO_C->state = CO_SDO_ST_IDLE;
+    }
+    if (SDOabortCode != NULL) {
+        *SDOabortCode = abortCode;
+    }
+
+    return ret;
+}
+#endif
+
+
 /******************************************************************************/
 size_t CO_SDOclientUploadBufRead(CO_SDOclient_t *SDO_C,
                                  uint8_t *buf,
@@ -43,6 +43,9 @@
   #define CO_CONFIG_SDO_CLI_BUFFER_SIZE 32
  #endif
 #endif
+#ifndef CO_CONFIG_SDO_CLI_SERVER_CAP_COUNT
+#define CO_CONFIG_SDO_CLI_SERVER_CAP_COUNT 4
+#endif
 
 #if ((CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_ENABLE) || defined CO_DOXYGEN
 
@@ -192,6 +195,9 @@ typedef struct {
     uint16_t CANdevTxIdx;
     /** CAN transmit buffer inside CANdevTx for CAN tx message */
     CO_CANtx_t *CANtxBuff;
+    /** CAN identifier of the received SDO response, 0 if not valid, see
+     * CO_SDOclient_receiveForward() */
+    uint16_t CANrxIdent;
 #if ((CO_CONFIG_SDO_CLI) & CO_CONFIG_FLAG_OD_DYNAMIC) || defined CO_DOXYGEN
     /** Copy of CANopen COB_ID Client -> Server, meaning of the specific bits:
         - Bit 0...10: 11-bit CAN identifier.
@@ -262,6 +268,25 @@ typedef struct {
     /** Calculated CRC checksum */
     uint16_t block_crc;
 #endif
+#if ((CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_BLOCK_ADAPTIVE) || defined CO_DOXYGEN
+    /** CAN-IDs of the client to server messages of recently used SDO servers,
+     * 0 if entry is not used */
+    uint16_t block_capCanId[CO_CONFIG_SDO_CLI_SERVER_CAP_COUNT];
+    /** Remembered capabilities of SDO servers from block_capCanId. Bits 0..6:
+     * blksize for the next block upload from the server, 0 if not known yet.
+     * Bit 7: server does not support block transfer. */
+    uint8_t block_serverCap[CO_CONFIG_SDO_CLI_SERVER_CAP_COUNT];
+    /** Last blksize, at which sub-block from the server in block_capCanId
+     * ended early, 0 if none. Blksize for block upload does not grow to it. */
+    uint8_t block_capBlksizeFail[CO_CONFIG_SDO_CLI_SERVER_CAP_COUNT];
+    /** Number of sub-blocks in a row received without retransmission from the
+     * server in block_capCanId */
+    uint16_t block_capClean[CO_CONFIG_SDO_CLI_SERVER_CAP_COUNT];
+    /** Index of the current SDO server in block_serverCap */
+    uint8_t block_capIdx;
+    /** Index of the entry, which will be replaced by the next new server */
+    uint8_t block_capNext;
+#endif
 } CO_SDOclient_t;
 
 
@@ -318,6 +343,21 @@ void CO_SDOclient_initCallbackPre(CO_SDOclient_t *SDOclient,
 #endif
 
 
+/**
+ * Pass received CAN message to SDO client.
+ *
+ * Used by objects with own CAN receive buffer for a range of SDO server
+ * responses, placed before the buffers of SDO clients (see @ref CO_nodeScan).
+ * They pass the messages, which they don't use, here. Message is processed
+ * only, if its CAN-ID matches the SDO client setup. Function may be called
+ * from the CAN receive interrupt, see CO_CANrxBufferInit().
+ *
+ * @param SDO_C This object.
+ * @param msg Received CAN message, see CO_CANrxMsg_readIdent().
+ */
+void CO_SDOclient_receiveForward(CO_SDOclient_t *SDO_C, void *msg);
+
+
 /**
  * Setup SDO client object.
  *
@@ -362,7 +402,10 @@ CO_SDO_return_t CO_SDOclient_setup(CO_SDOclient_t *SDO_C,
  * message will be generated.
  * - If sizeIndicated is 0, then actual data size will not be verified.
  * @param SDOtimeoutTime_ms Timeout time for SDO communication in milliseconds.
- * @param blockEnable Try to initiate block transfer.
+ * @param blockEnable Try to initiate block transfer. If
+ * @ref CO_CONFIG_SDO_CLI_BLOCK_ADAPTIVE is enabled, then segmented transfer is
+ * used for servers, which are known not to support block transfer, and for
+ * short data.
  *
  * @return #CO_SDO_return_t
  */
@@ -450,6 +493,37 @@ CO_SDO_return_t CO_SDOclientDownload(CO_SDOclient_t *SDO_C,
                                      uint32_t *timerNext_us);
 
 
+#if ((CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_LOCAL) || defined CO_DOXYGEN
+/**
+ * Download data into own Object Dictionary directly from the caller buffer.
+ *
+ * Alternative to CO_SDOclientDownloadBufWrite() and CO_SDOclientDownload()
+ * for local transfer, when node-ID of the SDO server is the same as node-ID of
+ * this node. Object Dictionary entry is searched once and data are written
+ * into it with single OD_IO.write() call, without copying into the internal
+ * buffer of the SDO client and without multiple passes.
+ *
+ * Function may be called after CO_SDOclientDownloadInitiate(), before any data
+ * are written into SDO client buffer. buf must contain all data.
+ *
+ * @param SDO_C This object.
+ * @param buf Buffer with all data to be written.
+ * @param count Size of data in buf.
+ * @param [out] SDOabortCode In case of error, SDO abort code contains reason
+ * of error. Ignored if NULL.
+ *
+ * @return #CO_SDO_RT_ok_communicationEnd on success, value less than 0 on
+ * error. In both cases state becomes idle. #CO_SDO_RT_wrongArguments is
+ * returned also, if transfer is not local or has already started. In that
+ * case state is not changed and regular functions must be used.
+ */
+CO_SDO_return_t CO_SDOclientDownloadLocal(CO_SDOclient_t *SDO_C,
+                                          const uint8_t *buf,
+                                          size_t count,
+                                          CO_SDO_abortCode_t *SDOabortCode);
+#endif
+
+
 /**
  * Initiate SDO upload communication.
  *
@@ -461,7 +535,9 @@ CO_SDO_return_t CO_SDOclientDownload(CO_SDOclient_t *SDO_C,
  * @param index Index of object in object dictionary in remote node.
  * @param subIndex Subindex of object in object dictionary in remote node.
  * @param SDOtimeoutTime_ms Timeout time for SDO communication in milliseconds.
- * @param blockEnable Try to initiate block transfer.
+ * @param blockEnable Try to initiate block transfer. If
+ * @ref CO_CONFIG_SDO_CLI_BLOCK_ADAPTIVE is enabled, then segmented transfer is
+ * used for servers, which are known not to support block transfer.
  *
  * @return #CO_SDO_return_t
  */
@@ -511,6 +587,43 @@ CO_SDO_return_t CO_SDOclientUpload(CO_SDOclient_t *SDO_C,
                                    uint32_t *timerNext_us);
 
 
+#if ((CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_LOCAL) || defined CO_DOXYGEN
+/**
+ * Upload data from own Object Dictionary directly into the caller buffer.
+ *
+ * Alternative to CO_SDOclientUpload() and CO_SDOclientUploadBufRead() for
+ * local transfer, when node-ID of the SDO server is the same as node-ID of
+ * this node. Object Dictionary entry is searched once and data are read from
+ * it with single OD_IO.read() call, without copying through the internal
+ * buffer of the SDO client.
+ *
+ * Function may be called after CO_SDOclientUploadInitiate(), before
+ * CO_SDOclientUpload(). If data do not fit into buf (large domain), buf is
+ * filled and #CO_SDO_RT_uploadDataBufferFull is returned. Rest of the data
+ * must then be streamed with CO_SDOclientUpload() and
+ * CO_SDOclientUploadBufRead().
+ *
+ * @param SDO_C This object.
+ * @param buf Buffer into which data will be copied.
+ * @param count Size of buf.
+ * @param [out] countRead Number of bytes copied into buf.
+ * @param [out] SDOabortCode In case of error, SDO abort code contains reason
+ * of error. Ignored if NULL.
+ *
+ * @return #CO_SDO_RT_ok_communicationEnd on success or value less than 0 on
+ * error, state becomes idle in both cases. #CO_SDO_RT_uploadDataBufferFull, if
+ * more data follow. #CO_SDO_RT_wrongArguments is returned also, if transfer is
+ * not local or has already started. In that case state is not changed and
+ * regular functions must be used.
+ */
+CO_SDO_return_t CO_SDOclientUploadLocal(CO_SDOclient_t *SDO_C,
+                                        uint8_t *buf,
+                                        size_t count,
+                                        size_t *countRead,
+                                        CO_SDO_abortCode_t *SDOabortCode);
+#endif
+
+
 /**
  * Read data from SDO client buffer.
  *
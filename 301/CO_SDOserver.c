@@ -151,6 +151,15 @@ static void CO_SDO_receive(void *object, void *msg) {
              * CO_SDOserver_process() */
             memcpy(SDO->CANrxData, data, DLC);
             CO_FLAG_SET(SDO->CANrxNew);
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_INDEXED
+            /* signal to CO_process(), that this SDO server must be processed */
+            if (SDO->CANrxPending != NULL) {
+                CO_FLAG_SET(*SDO->CANrxPending);
+            }
+            if (SDO->CANrxPendingAny != NULL) {
+                CO_FLAG_SET(*SDO->CANrxPendingAny);
+            }
+#endif
 #if (CO_CONFIG_SDO_SRV) & CO_CONFIG_FLAG_CALLBACK_PRE
             /* Optional signal to RTOS, which can resume task, which handles
             * SDO server processing. */
@@ -343,6 +352,10 @@ CO_ReturnError_t CO_SDOserver_init(CO_SDOserver_t *SDO,
     SDO->pFunctSignalPre = NULL;
     SDO->functSignalObjectPre = NULL;
 #endif
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_INDEXED
+    SDO->CANrxPending = NULL;
+    SDO->CANrxPendingAny = NULL;
+#endif
 
     /* configure CAN identifiers and SDO server parameters if available */
     uint16_t CanId_ClientToServer, CanId_ServerToClient;
@@ -448,6 +461,20 @@ void CO_SDOserver_initCallbackPre(CO_SDOserver_t *SDO,
 #endif
 
 
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_INDEXED
+/******************************************************************************/
+void CO_SDOserver_initPending(CO_SDOserver_t *SDO,
+                              volatile void **pending,
+                              volatile void **pendingAny)
+{
+    if (SDO != NULL) {
+        SDO->CANrxPending = pending;
+        SDO->CANrxPendingAny = pendingAny;
+    }
+}
+#endif
+
+
 #ifdef CO_BIG_ENDIAN
 static inline void reverseBytes(void *start, OD_size_t size) {
     uint8_t *lo = (uint8_t *)start;
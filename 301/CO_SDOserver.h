@@ -524,6 +524,12 @@ typedef struct {
     /** From CO_SDOserver_initCallbackPre() or NULL */
     void *functSignalObjectPre;
 #endif
+#if ((CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_INDEXED) || defined CO_DOXYGEN
+    /** From CO_SDOserver_initPending() or NULL */
+    volatile void **CANrxPending;
+    /** From CO_SDOserver_initPending() or NULL */
+    volatile void **CANrxPendingAny;
+#endif
 } CO_SDOserver_t;
 
 
@@ -581,6 +587,29 @@ void CO_SDOserver_initCallbackPre(CO_SDOserver_t *SDO,
 #endif
 
 
+#if ((CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_INDEXED) || defined CO_DOXYGEN
+/**
+ * Initialize pending flag for indexed dispatch of SDO servers.
+ *
+ * Pending flag is set (with CO_FLAG_SET()) each time, when SDO server receives
+ * message for processing. Flag may be shared between several SDO servers. Flag
+ * is cleared by the application, which must then call CO_SDOserver_process()
+ * for all SDO servers, which share the flag. Application must keep processing
+ * SDO server, while it is not in #CO_SDO_ST_IDLE state. Second flag is set
+ * together with the first one and may be shared by all SDO servers, so
+ * application can check for received messages with single read. Used in
+ * CO_process().
+ *
+ * @param SDO This object.
+ * @param pending Pointer to the pending flag. Not used if NULL.
+ * @param pendingAny Pointer to the common pending flag. Not used if NULL.
+ */
+void CO_SDOserver_initPending(CO_SDOserver_t *SDO,
+                              volatile void **pending,
+                              volatile void **pendingAny);
+#endif
+
+
 /**
  * Process SDO communication.
  *
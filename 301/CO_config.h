@@ -124,6 +124,25 @@ extern "C" {
 /** @} */ /* CO_STACK_CONFIG_COMMON */
 
 
+/**
+ * @defgroup CO_STACK_CONFIG_OD Object Dictionary interface
+ * Object Dictionary interface and extensions
+ * @{
+ */
+/**
+ * Configuration of @ref CO_ODinterface
+ *
+ * Possible flags, can be ORed:
+ * - CO_CONFIG_OD_DOMAIN_FILE - Enable DOMAIN objects, which are stored in
+ *   files, see @ref CO_ODdomainFile. Requires POSIX file functions and mmap.
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_OD (0)
+#endif
+#define CO_CONFIG_OD_DOMAIN_FILE 0x01
+/** @} */ /* CO_STACK_CONFIG_OD */
+
+
 /**
  * @defgroup CO_STACK_CONFIG_NMT_HB NMT master/slave and HB producer/consumer
  * Specified in standard CiA 301
@@ -165,6 +184,21 @@ extern "C" {
  *   CO_HBconsumer_initCallbackRemoteReset() functions.
  * - CO_CONFIG_HB_CONS_QUERY_FUNCT - Enable functions for query HB state or
  *   NMT state of the specific monitored node.
+ * - CO_CONFIG_HB_CONS_NODE_INDEXED - Enable node-ID indexed Heartbeat
+ *   consumer. All Heartbeat messages are received through one CAN receive
+ *   buffer (CAN-IDs 0x701 to 0x77F) and monitored node is found directly by
+ *   node-ID. Heartbeat timeouts are kept in a timer heap, so
+ *   CO_HBconsumer_process() processes only nodes with received message or with
+ *   expired timeout. Useful for many monitored nodes.
+ * - CO_CONFIG_HB_CONS_STATE_TRACKER - Enable network state tracker. Monitored
+ *   nodes are kept in bitmaps by node-ID for each Heartbeat and NMT state, so
+ *   group queries like CO_HBconsumer_allInState() need only few word
+ *   operations. Changes are notified once per CO_HBconsumer_process() by
+ *   callback configured by CO_HBconsumer_initCallbackStateChanged().
+ * - CO_CONFIG_HB_CONS_STATISTICS - Enable statistics of Heartbeat intervals
+ *   for each monitored node: minimum, average and maximum interval, histogram
+ *   and number of late Heartbeats. Statistics may be read from OD entry, see
+ *   CO_HBconsumer_initStatistics().
  * - #CO_CONFIG_FLAG_CALLBACK_PRE - Enable custom callback after preprocessing
  *   received heartbeat CAN message.
  *   Callback is configured by CO_HBconsumer_initCallbackPre().
@@ -183,6 +217,9 @@ extern "C" {
 #define CO_CONFIG_HB_CONS_CALLBACK_CHANGE 0x02
 #define CO_CONFIG_HB_CONS_CALLBACK_MULTI 0x04
 #define CO_CONFIG_HB_CONS_QUERY_FUNCT 0x08
+#define CO_CONFIG_HB_CONS_NODE_INDEXED 0x10
+#define CO_CONFIG_HB_CONS_STATE_TRACKER 0x20
+#define CO_CONFIG_HB_CONS_STATISTICS 0x40
 /** @} */ /* CO_STACK_CONFIG_NMT_HB */
 
 
@@ -205,6 +242,14 @@ extern "C" {
  *   "Pre-defined error field"
  * - CO_CONFIG_EM_CONSUMER - Enable simple emergency consumer with callback.
  * - CO_CONFIG_EM_STATUS_BITS - Access @ref CO_EM_errorStatusBits_t from OD.
+ * - CO_CONFIG_EM_LOCK_FREE - CO_error() uses atomic operations instead of
+ *   CO_LOCK_EMCY(), so it never blocks. Fifo entries are reserved with
+ *   compare-and-swap, see @ref CO_EM_ATOMIC_CAS.
+ * - CO_CONFIG_EM_HISTORY_STORE - Enable callbacks for persistent error history,
+ *   see CO_EM_initHistoryStore(). CO_CONFIG_EM_HISTORY must also be set.
+ * - CO_CONFIG_EM_PROD_RATE_LIMIT - Enable rate limiting of emergency messages
+ *   per error status bit, see CO_EM_setRateLimit(). CO_CONFIG_EM_PRODUCER must
+ *   also be set.
  * - #CO_CONFIG_FLAG_CALLBACK_PRE - Enable custom callback after preprocessing
  *   emergency condition by CO_errorReport() or CO_errorReset() call.
  *   Callback is configured by CO_EM_initCallbackPre().
@@ -220,6 +265,9 @@ extern "C" {
 #define CO_CONFIG_EM_HISTORY 0x08
 #define CO_CONFIG_EM_STATUS_BITS 0x10
 #define CO_CONFIG_EM_CONSUMER 0x20
+#define CO_CONFIG_EM_LOCK_FREE 0x40
+#define CO_CONFIG_EM_HISTORY_STORE 0x80
+#define CO_CONFIG_EM_PROD_RATE_LIMIT 0x100
 
 /**
  * Maximum number of @ref CO_EM_errorStatusBits_t
@@ -232,6 +280,17 @@ extern "C" {
 #define CO_CONFIG_EM_ERR_STATUS_BITS_COUNT (10*8)
 #endif
 
+/**
+ * Default rate limit window for emergency messages in milliseconds.
+ *
+ * Used, if @ref CO_CONFIG_EM has CO_CONFIG_EM_PROD_RATE_LIMIT enabled. Value
+ * is set by CO_EM_init() and may be changed by CO_EM_setRateLimit(). Default
+ * is 100.
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_EM_RATE_LIMIT_MS 100
+#endif
+
 /**
  * Condition for calculating CANopen Error register, "generic" error bit.
  *
@@ -322,6 +381,11 @@ extern "C" {
  * - CO_CONFIG_SDO_SRV_SEGMENTED - Enable SDO server segmented transfer.
  * - CO_CONFIG_SDO_SRV_BLOCK - Enable SDO server block transfer. If set, then
  *   CO_CONFIG_SDO_SRV_SEGMENTED must also be set.
+ * - CO_CONFIG_SDO_SRV_INDEXED - Enable indexed dispatch of SDO servers in
+ *   CO_process(). Only SDO servers with received message or with transfer in
+ *   progress are processed, idle servers are skipped. Useful for devices with
+ *   many SDO servers. SDO servers are signalled through
+ *   CO_SDOserver_initPending().
  * - #CO_CONFIG_FLAG_CALLBACK_PRE - Enable custom callback after preprocessing
  *   received SDO CAN message.
  *   Callback is configured by CO_SDOserver_initCallbackPre().
@@ -335,6 +399,7 @@ extern "C" {
 #endif
 #define CO_CONFIG_SDO_SRV_SEGMENTED 0x02
 #define CO_CONFIG_SDO_SRV_BLOCK 0x04
+#define CO_CONFIG_SDO_SRV_INDEXED 0x08
 
 /**
  * Size of the internal data buffer for the SDO server.
@@ -359,6 +424,13 @@ extern "C" {
  * - CO_CONFIG_SDO_CLI_LOCAL - Enable local transfer, if Node-ID of the SDO
  *   server is the same as node-ID of the SDO client. (SDO client is the same
  *   device as SDO server.) Transfer data directly without communication on CAN.
+ * - CO_CONFIG_SDO_CLI_BLOCK_ADAPTIVE - Enable adaptive block transfer. SDO
+ *   client remembers capabilities of recently used SDO servers (by COB-ID, see
+ *   @ref CO_CONFIG_SDO_CLI_SERVER_CAP_COUNT): servers without block transfer
+ *   support are accessed with segmented transfer and blksize for block upload
+ *   is adjusted according to observed sub-block retransmissions. Short
+ *   downloads with unknown size are transferred expedited or segmented. If
+ *   set, then CO_CONFIG_SDO_CLI_BLOCK must also be set.
  * - #CO_CONFIG_FLAG_CALLBACK_PRE - Enable custom callback after preprocessing
  *   received SDO CAN message.
  *   Callback is configured by CO_SDOclient_initCallbackPre().
@@ -375,6 +447,7 @@ extern "C" {
 #define CO_CONFIG_SDO_CLI_SEGMENTED 0x02
 #define CO_CONFIG_SDO_CLI_BLOCK 0x04
 #define CO_CONFIG_SDO_CLI_LOCAL 0x08
+#define CO_CONFIG_SDO_CLI_BLOCK_ADAPTIVE 0x10
 
 /**
  * Size of the internal data buffer for the SDO client.
@@ -390,6 +463,17 @@ extern "C" {
 #ifdef CO_DOXYGEN
 #define CO_CONFIG_SDO_CLI_BUFFER_SIZE 32
 #endif
+
+/**
+ * Number of SDO servers, whose capabilities are remembered by one SDO client.
+ *
+ * Used with @ref CO_CONFIG_SDO_CLI_BLOCK_ADAPTIVE. Servers are identified by
+ * the CAN-ID of the client to server message. If more servers are accessed,
+ * the oldest entry is replaced. Default value is 4.
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_SDO_CLI_SERVER_CAP_COUNT 4
+#endif
 /** @} */ /* CO_STACK_CONFIG_SDO */
 
 
@@ -458,6 +542,9 @@ extern "C" {
  *   flexibility for application program, but consumes some additional memory
  *   and processor resources. If this option is not enabled, then data from OD
  *   variables are fetched directly from memory allocated by Object dictionary.
+ * - CO_CONFIG_PDO_CALLBACK_EVENT - Enable custom callback, which is called
+ *   after RPDO data are written to the Object Dictionary or after TPDO is sent.
+ *   Callback is configured by CO_PDO_initCallbackEvent().
  * - #CO_CONFIG_FLAG_CALLBACK_PRE - Enable custom callback after preprocessing
  *   received RPDO CAN message.
  *   Callback is configured by CO_RPDO_initCallbackPre().
@@ -474,6 +561,7 @@ extern "C" {
 #define CO_CONFIG_TPDO_TIMERS_ENABLE 0x08
 #define CO_CONFIG_PDO_SYNC_ENABLE 0x10
 #define CO_CONFIG_PDO_OD_IO_ACCESS 0x20
+#define CO_CONFIG_PDO_CALLBACK_EVENT 0x40
 /** @} */ /* CO_STACK_CONFIG_SYNC_PDO */
 
 
@@ -492,6 +580,15 @@ extern "C" {
 #define CO_CONFIG_STORAGE (CO_CONFIG_STORAGE_ENABLE)
 #endif
 #define CO_CONFIG_STORAGE_ENABLE 0x01
+
+/**
+ * Number of error history records, which are collected in RAM by
+ * @ref CO_storage_emHistory before they are written into the storage in one
+ * block. Used, if @ref CO_CONFIG_EM has CO_CONFIG_EM_HISTORY_STORE enabled.
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_STORAGE_EM_HISTORY_BATCH 8
+#endif
 /** @} */ /* CO_STACK_CONFIG_STORAGE */
 
 
@@ -584,6 +681,10 @@ extern "C" {
  * - CO_CONFIG_LSS_SLAVE_FASTSCAN_DIRECT_RESPOND - Send LSS fastscan respond
  *   directly from CO_LSSslave_receive() function.
  * - CO_CONFIG_LSS_MASTER - Enable LSS master
+ * - CO_CONFIG_LSS_MASTER_FASTSCAN_ADAPTIVE - LSS master fastscan uses measured
+ *   response time of the slaves instead of the full timeout, tries values
+ *   found by previous fastscan first and keeps statistics, see
+ *   CO_LSSmaster_IdentifyFastscan().
  * - #CO_CONFIG_FLAG_CALLBACK_PRE - Enable custom callback after preprocessing
  *   received CAN message.
  *   Callback is configured by CO_LSSmaster_initCallbackPre().
@@ -594,9 +695,108 @@ extern "C" {
 #define CO_CONFIG_LSS_SLAVE 0x01
 #define CO_CONFIG_LSS_SLAVE_FASTSCAN_DIRECT_RESPOND 0x02
 #define CO_CONFIG_LSS_MASTER 0x10
+#define CO_CONFIG_LSS_MASTER_FASTSCAN_ADAPTIVE 0x20
 /** @} */ /* CO_STACK_CONFIG_LSS */
 
 
+/**
+ * @defgroup CO_STACK_CONFIG_NODE_SCAN Network scan
+ * Non standard object
+ * @{
+ */
+/**
+ * Configuration of @ref CO_nodeScan
+ *
+ * Possible flags, can be ORed:
+ * - CO_CONFIG_NODE_SCAN_ENABLE - Enable network scan, which reads identity of
+ *   all nodes concurrently, see CO_nodeScan_start().
+ * - #CO_CONFIG_FLAG_TIMERNEXT - Enable calculation of timerNext_us variable
+ *   inside CO_nodeScan_process().
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_NODE_SCAN (0)
+#endif
+#define CO_CONFIG_NODE_SCAN_ENABLE 0x01
+/** @} */ /* CO_STACK_CONFIG_NODE_SCAN */
+
+
+/**
+ * @defgroup CO_STACK_CONFIG_NMT_SEQ NMT startup sequencer
+ * Non standard object
+ * @{
+ */
+/**
+ * Configuration of @ref CO_NMTsequencer
+ *
+ * Possible flags, can be ORed:
+ * - CO_CONFIG_NMT_SEQ_ENABLE - Enable NMT startup sequencer, which starts
+ *   groups of nodes in the order of their dependencies, see
+ *   CO_NMTseq_start(). CO_CONFIG_NMT_MASTER and
+ *   CO_CONFIG_HB_CONS_STATE_TRACKER must also be set.
+ * - #CO_CONFIG_FLAG_TIMERNEXT - Enable calculation of timerNext_us variable
+ *   inside CO_NMTseq_process().
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_NMT_SEQ (0)
+#endif
+#define CO_CONFIG_NMT_SEQ_ENABLE 0x01
+/** @} */ /* CO_STACK_CONFIG_NMT_SEQ */
+
+
+/**
+ * @defgroup CO_STACK_CONFIG_EM_AGG Emergency aggregator
+ * Non standard object
+ * @{
+ */
+/**
+ * Configuration of @ref CO_EMaggregator
+ *
+ * Possible flags, can be ORed:
+ * - CO_CONFIG_EM_AGG_ENABLE - Enable emergency aggregator, which keeps active
+ *   errors of all nodes on the network, see CO_EMagg_init().
+ *   CO_CONFIG_EM_CONSUMER must also be set.
+ * - #CO_CONFIG_FLAG_CALLBACK_PRE - Enable custom callback after emergency
+ *   message is received. Callback is configured by CO_EMagg_initCallbackPre().
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_EM_AGG (0)
+#endif
+#define CO_CONFIG_EM_AGG_ENABLE 0x01
+
+/**
+ * Size of the queue of received emergency messages in emergency aggregator.
+ *
+ * Messages are copied into the queue in CAN receive callback and processed by
+ * CO_EMagg_process(). If queue is full, message is lost.
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_EM_AGG_RX_QUEUE_SIZE 32
+#endif
+/** @} */ /* CO_STACK_CONFIG_EM_AGG */
+
+
+/**
+ * @defgroup CO_STACK_CONFIG_LSS_COMM LSS batch commissioning
+ * Non standard object
+ * @{
+ */
+/**
+ * Configuration of @ref CO_LSScommission
+ *
+ * Possible flags, can be ORed:
+ * - CO_CONFIG_LSS_COMM_ENABLE - Enable LSS batch commissioning, which assigns
+ *   node-IDs to listed nodes and to nodes found by fastscan, see
+ *   CO_LSScomm_start(). CO_CONFIG_LSS_MASTER must also be set.
+ * - #CO_CONFIG_FLAG_TIMERNEXT - Enable calculation of timerNext_us variable
+ *   inside CO_LSScomm_process().
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_LSS_COMM (0)
+#endif
+#define CO_CONFIG_LSS_COMM_ENABLE 0x01
+/** @} */ /* CO_STACK_CONFIG_LSS_COMM */
+
+
 /**
  * @defgroup CO_STACK_CONFIG_GATEWAY CANopen gateway
  * Specified in standard CiA 309
@@ -625,6 +825,36 @@ extern "C" {
  *   help usage.
  * - CO_CONFIG_GTW_ASCII_PRINT_LEDS - Display "red" and "green" CANopen status
  *   LED diodes on terminal.
+ * - CO_CONFIG_GTW_ASCII_SLOTS - Enable command slots, see CO_GTWA_initSlots().
+ *   SDO upload commands for different nodes are then executed concurrently,
+ *   each with own SDO client. If set, then CO_CONFIG_GTW_ASCII_SDO must also
+ *   be set.
+ * - CO_CONFIG_GTW_ASCII_SDO_BATCH - Enable non-standard commands "rm" and "wm"
+ *   for SDO upload or download of multiple objects from the same node with
+ *   single command and single response. If set, then CO_CONFIG_GTW_ASCII_SDO
+ *   must also be set.
+ * - CO_CONFIG_GTW_ASCII_SUBSCRIBE - Enable non-standard commands "subscribe"
+ *   and "unsubscribe", see CO_GTWA_initSubscribe(). Gateway then prints
+ *   asynchronous lines on change of local OD variable or on received RPDO or
+ *   sent TPDO. If set, then CO_CONFIG_GTW_ASCII_SDO must also be set. PDO
+ *   subscriptions also need CO_CONFIG_PDO_CALLBACK_EVENT.
+ * - CO_CONFIG_GTW_ASCII_BINARY - Enable non-standard length-prefixed binary
+ *   framing of SDO and NMT commands and responses, see CO_GTWA_setBinary().
+ *   If set, then CO_CONFIG_GTW_ASCII_SDO must also be set.
+ * - CO_CONFIG_GTW_ASCII_SESSIONS - Enable multiple gateway-ascii objects as
+ *   sessions of one gateway, one for each client connection, see
+ *   CO_GTWA_initSessions(). Access to the same node and to LSS master is then
+ *   arbitrated between the sessions.
+ * - CO_CONFIG_GTW_ASCII_READV - Enable vectored read of the response, see
+ *   CO_GTWA_initReadv(). Data of binary upload response is then passed to the
+ *   application directly from the SDO client buffer.
+ * - CO_CONFIG_GTW_ASCII_SCAN - Enable non-standard command "scan", which
+ *   prints node table of the network, see CO_GTWA_initScan(). If set, then
+ *   CO_CONFIG_NODE_SCAN_ENABLE must also be set.
+ * - CO_CONFIG_GTW_ASCII_HB_STAT - Enable non-standard command "hbstat", which
+ *   prints Heartbeat interval statistics of monitored nodes, see
+ *   CO_GTWA_initHBstat(). If set, then CO_CONFIG_HB_CONS_STATISTICS must also
+ *   be set.
  */
 #ifdef CO_DOXYGEN
 #define CO_CONFIG_GTW (0)
@@ -638,6 +868,14 @@ extern "C" {
 #define CO_CONFIG_GTW_ASCII_ERROR_DESC 0x40
 #define CO_CONFIG_GTW_ASCII_PRINT_HELP 0x80
 #define CO_CONFIG_GTW_ASCII_PRINT_LEDS 0x100
+#define CO_CONFIG_GTW_ASCII_SLOTS 0x200
+#define CO_CONFIG_GTW_ASCII_SDO_BATCH 0x400
+#define CO_CONFIG_GTW_ASCII_SUBSCRIBE 0x800
+#define CO_CONFIG_GTW_ASCII_BINARY 0x1000
+#define CO_CONFIG_GTW_ASCII_SESSIONS 0x2000
+#define CO_CONFIG_GTW_ASCII_READV 0x4000
+#define CO_CONFIG_GTW_ASCII_SCAN 0x8000
+#define CO_CONFIG_GTW_ASCII_HB_STAT 0x10000
 
 /**
  * Number of loops of #CO_SDOclientDownload() in case of block download
@@ -666,6 +904,24 @@ extern "C" {
 #ifdef CO_DOXYGEN
 #define CO_CONFIG_GTWA_LOG_BUF_SIZE 2000
 #endif
+
+/**
+ * Maximum number of command slots in ASCII gateway object.
+ *
+ * Used, if CO_CONFIG_GTW_ASCII_SLOTS is set. Each slot needs own SDO client.
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_GTWA_SLOTS 4
+#endif
+
+/**
+ * Maximum number of subscriptions in ASCII gateway object.
+ *
+ * Used, if CO_CONFIG_GTW_ASCII_SUBSCRIBE is set.
+ */
+#ifdef CO_DOXYGEN
+#define CO_CONFIG_GTWA_SUBSCRIPTIONS 8
+#endif
 /** @} */ /* CO_STACK_CONFIG_GATEWAY */
 
 
@@ -714,6 +970,13 @@ extern "C" {
  *   has CO_CONFIG_GTW_ASCII and CO_CONFIG_GTW_ASCII_SDO enabled. It adds
  *   datatype transform functions between binary and ascii, which are necessary
  *   for SDO client.
+ * - CO_CONFIG_FIFO_ASCII_STRICT_RANGE - Parse integer numbers strictly: value
+ *   must fit into the range of the data type. Otherwise negative values for
+ *   UNSIGNED32 and UNSIGNED64 and values up to the unsigned maximum for
+ *   INTEGER32 and INTEGER64 are accepted and converted with two's complement,
+ *   as with strtoul() and strtol() before (for example "-1" is 0xFFFFFFFF and
+ *   "0xFFFFFFFF" is -1). 8 and 16 bit values are range checked in both cases.
+ *   If set, then CO_CONFIG_FIFO_ASCII_DATATYPES must also be set.
  */
 #ifdef CO_DOXYGEN
 #define CO_CONFIG_FIFO (0)
@@ -723,6 +986,7 @@ extern "C" {
 #define CO_CONFIG_FIFO_CRC16_CCITT 0x04
 #define CO_CONFIG_FIFO_ASCII_COMMANDS 0x08
 #define CO_CONFIG_FIFO_ASCII_DATATYPES 0x10
+#define CO_CONFIG_FIFO_ASCII_STRICT_RANGE 0x20
 /** @} */ /* CO_STACK_CONFIG_FIFO */
 
 
@@ -762,6 +1026,9 @@ extern "C" {
  *   other defined CO_DEBUG_XXX(msg) macros.
  * - CO_CONFIG_DEBUG_SDO_CLIENT - Define default CO_DEBUG_SDO_CLIENT(msg) macro.
  * - CO_CONFIG_DEBUG_SDO_SERVER - Define default CO_DEBUG_SDO_SERVER(msg) macro.
+ * - CO_CONFIG_DEBUG_GTW_TABLES - Verify in CO_GTWA_init(), that the tables of
+ *   gateway commands and data types are sorted, as required by binary search.
+ *   CO_GTWA_init() returns CO_ERROR_DATA_CORRUPT otherwise.
  */
 #ifdef CO_DOXYGEN
 #define CO_CONFIG_DEBUG (0)
@@ -769,6 +1036,7 @@ extern "C" {
 #define CO_CONFIG_DEBUG_COMMON 0x01
 #define CO_CONFIG_DEBUG_SDO_CLIENT 0x02
 #define CO_CONFIG_DEBUG_SDO_SERVER 0x04
+#define CO_CONFIG_DEBUG_GTW_TABLES 0x08
 /** @} */ /* CO_STACK_CONFIG_DEBUG */
 
 /** @} */ /* CO_STACK_CONFIG */
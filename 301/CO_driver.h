@@ -408,7 +408,8 @@ typedef struct {
  * may be called from different threads. Critical sections must be protected.
  * Either by disabling scheduler or interrupts or by mutexes or semaphores.
  * Lock/unlock macro is called with pointer to CAN module, which may be used
- * inside.
+ * inside. With CO_CONFIG_EM_LOCK_FREE CO_error() uses atomic operations and
+ * CO_LOCK_EMCY() is not used.
  *
  * #### Object Dictionary variables
  * In general, there are two threads, which accesses OD variables: mainline
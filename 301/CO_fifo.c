@@ -35,6 +35,7 @@
 #if (CO_CONFIG_FIFO) & CO_CONFIG_FIFO_ASCII_COMMANDS
 #include <stdio.h>
 #include <inttypes.h>
+#include <locale.h>
 
 /* Non-graphical character for command delimiter */
 #define DELIM_COMMAND ((uint8_t)'\n')
@@ -51,6 +52,23 @@
  #endif
 #endif
 
+/* Number of bytes, which can be written to the fifo without wrap. Data are
+ * written directly to &fifo->buf[fifo->writePtr] and then committed with
+ * spanWriteDone(). */
+static inline size_t spanWrite(const CO_fifo_t *fifo) {
+    if (fifo->readPtr > fifo->writePtr) {
+        return fifo->readPtr - fifo->writePtr - 1;
+    }
+    return fifo->bufSize - fifo->writePtr - (fifo->readPtr == 0 ? 1 : 0);
+}
+
+static inline void spanWriteDone(CO_fifo_t *fifo, size_t count) {
+    fifo->writePtr += count;
+    if (fifo->writePtr == fifo->bufSize) {
+        fifo->writePtr = 0;
+    }
+}
+
 /******************************************************************************/
 void CO_fifo_init(CO_fifo_t *fifo, uint8_t *buf, size_t bufSize) {
 
@@ -172,6 +190,133 @@ size_t CO_fifo_read(CO_fifo_t *fifo, uint8_t *buf, size_t count, bool_t *eof) {
 }
 
 
+/******************************************************************************/
+size_t CO_fifo_peek(CO_fifo_t *fifo, size_t offset, const uint8_t **buf) {
+    size_t occupied, ptr, count;
+
+    if (fifo == NULL || buf == NULL) {
+        return 0;
+    }
+
+    occupied = CO_fifo_getOccupied(fifo);
+    if (offset >= occupied) {
+        return 0;
+    }
+
+    ptr = fifo->readPtr + offset;
+    if (ptr >= fifo->bufSize) {
+        ptr -= fifo->bufSize;
+    }
+    count = occupied - offset;
+    if (count > (fifo->bufSize - ptr)) {
+        count = fifo->bufSize - ptr;
+    }
+
+    *buf = &fifo->buf[ptr];
+    return count;
+}
+
+
+/******************************************************************************/
+size_t CO_fifo_skip(CO_fifo_t *fifo, size_t count) {
+    size_t occupied;
+
+    if (fifo == NULL) {
+        return 0;
+    }
+
+    occupied = CO_fifo_getOccupied(fifo);
+    if (count > occupied) {
+        count = occupied;
+    }
+
+    fifo->readPtr += count;
+    if (fifo->readPtr >= fifo->bufSize) {
+        fifo->readPtr -= fifo->bufSize;
+    }
+
+    return count;
+}
+
+
+/******************************************************************************/
+size_t CO_fifo_cpy(CO_fifo_t *dest, CO_fifo_t *src, size_t count) {
+    size_t copied = 0;
+
+    if (dest == NULL || src == NULL) {
+        return 0;
+    }
+
+    while (copied < count) {
+        const uint8_t *data = NULL;
+        size_t n = CO_fifo_peek(src, 0, &data);
+        size_t space = spanWrite(dest);
+
+        if (n > count - copied) n = count - copied;
+        if (n > space) n = space;
+        if (n == 0) {
+            break;
+        }
+        memcpy(&dest->buf[dest->writePtr], data, n);
+        spanWriteDone(dest, n);
+        CO_fifo_skip(src, n);
+        copied += n;
+    }
+
+    return copied;
+}
+
+
+/******************************************************************************/
+bool_t CO_fifo_rewind(CO_fifo_t *fifo, size_t mark) {
+    size_t count;
+
+    if (fifo == NULL || mark >= fifo->bufSize) {
+        return false;
+    }
+
+    /* read data and data written since must fit into the buffer */
+    count = fifo->readPtr >= mark
+          ? fifo->readPtr - mark : fifo->readPtr + fifo->bufSize - mark;
+    if (count + CO_fifo_getOccupied(fifo) >= fifo->bufSize) {
+        return false;
+    }
+
+    fifo->readPtr = mark;
+    return true;
+}
+
+
+/* Reverse count bytes at offset from the read position */
+static void reverse(CO_fifo_t *fifo, size_t offset, size_t count) {
+    size_t lo = fifo->readPtr + offset;
+    size_t hi = lo + count;
+
+    while (lo + 1 < hi) {
+        uint8_t *a = &fifo->buf[lo % fifo->bufSize];
+        uint8_t *b = &fifo->buf[(hi - 1) % fifo->bufSize];
+        uint8_t c = *a;
+        *a = *b;
+        *b = c;
+        lo++;
+        hi--;
+    }
+}
+
+/******************************************************************************/
+bool_t CO_fifo_swap(CO_fifo_t *fifo, size_t length1, size_t length2) {
+    if (fifo == NULL || length1 + length2 > CO_fifo_getOccupied(fifo)) {
+        return false;
+    }
+
+    /* rotation by three reversals, without additional buffer */
+    reverse(fifo, 0, length1);
+    reverse(fifo, length1, length2);
+    reverse(fifo, 0, length1 + length2);
+    return true;
+}
+
+
 #if (CO_CONFIG_FIFO) & CO_CONFIG_FIFO_ALT_READ
 /******************************************************************************/
 size_t CO_fifo_altBegin(CO_fifo_t *fifo, size_t offset) {
@@ -482,12 +627,654 @@ static const uint8_t base64DecTable[] = {
    255, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40,
     41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51,255,255,255,255,255};
 
+static const char hexEncTable[] = "0123456789ABCDEF";
+
+/* Block codecs below process data directly inside the fifo buffer, span by
+ * span, and fall back to the character loop for the rest. Spans for reading
+ * are from CO_fifo_peek(), spans for writing from spanWrite(). */
+
+/* Value of the hex digit or 0xFF if c is not a hex digit */
+static inline uint8_t hexDecode(uint8_t c) {
+    if ((uint8_t)(c - '0') <= 9U) {
+        return (uint8_t)(c - '0');
+    }
+    c |= 0x20; /* lower case */
+    if ((uint8_t)(c - 'a') <= 5U) {
+        return (uint8_t)(c - 'a' + 10);
+    }
+    return 0xFF;
+}
+
+/* Two decimal digits of each number from 0 to 99 */
+static const char decPairTable[] =
+    "0001020304050607080910111213141516171819"
+    "2021222324252627282930313233343536373839"
+    "4041424344454647484950515253545556575859"
+    "6061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+/* Integer numbers below are printed and parsed without sprintf() and
+ * strtoul(), which are slow and may depend on locale. Printed string is null
+ * terminated. Print unsigned number in decimal, buf must have space for 11
+ * characters. */
+static size_t printU32(char *buf, uint32_t n) {
+    char tmp[10];
+    size_t i = sizeof(tmp);
+    size_t len;
+
+    while (n >= 100U) {
+        uint32_t d = n % 100U;
+        n /= 100U;
+        i -= 2;
+        memcpy(&tmp[i], &decPairTable[d * 2U], 2);
+    }
+    if (n >= 10U) {
+        i -= 2;
+        memcpy(&tmp[i], &decPairTable[n * 2U], 2);
+    }
+    else {
+        tmp[--i] = (char)('0' + n);
+    }
+
+    len = sizeof(tmp) - i;
+    memcpy(buf, &tmp[i], len);
+    buf[len] = '\0';
+    return len;
+}
+
+/* Print unsigned number in decimal, buf must have space for 21 characters.
+ * Large number is split into 32-bit parts of nine digits. */
+static size_t printU64(char *buf, uint64_t n) {
+    uint32_t parts[2];
+    uint8_t partsCount = 0;
+    size_t len;
+
+    while (n > UINT32_MAX) {
+        parts[partsCount++] = (uint32_t)(n % 1000000000U);
+        n /= 1000000000U;
+    }
+    len = printU32(buf, (uint32_t)n);
+    while (partsCount > 0) {
+        uint32_t part = parts[--partsCount];
+        int8_t i;
+        for (i = 8; i >= 0; i--) {
+            buf[len + (size_t)i] = (char)('0' + part % 10U);
+            part /= 10U;
+        }
+        len += 9;
+    }
+    buf[len] = '\0';
+    return len;
+}
+
+/* Print signed number in decimal, buf must have space for 21 characters. */
+static size_t printI64(char *buf, int64_t n) {
+    if (n < 0) {
+        buf[0] = '-';
+        return printU64(&buf[1], 0U - (uint64_t)n) + 1;
+    }
+    return printU64(buf, (uint64_t)n);
+}
+
+/* Print number in hexadecimal with "0x" prefix and with fixed number of
+ * digits, buf must have space for digits + 3 characters. */
+static size_t printX64(char *buf, uint64_t n, uint8_t digits) {
+    uint8_t i;
+
+    buf[0] = '0';
+    buf[1] = 'x';
+    for (i = digits + 1; i >= 2; i--) {
+        buf[i] = hexEncTable[n & 0x0F];
+        n >>= 4;
+    }
+    buf[digits + 2] = '\0';
+    return (size_t)digits + 2;
+}
+
+/* Floating point numbers below are printed without sprintf() with the
+ * shortest digits, which read back to the same value. Digits are generated
+ * with Grisu2 algorithm (F. Loitsch, "Printing Floating-Point Numbers Quickly
+ * and Accurately with Integers", 2010). Result always reads back to the same
+ * value. It is the shortest for more than 99.5 % of the values, otherwise the
+ * shortest number lies on the boundary of the rounding interval and result
+ * has a digit or two more. */
+
+/* Number f * 2^e */
+typedef struct {
+    uint64_t f;
+    int32_t e;
+} diyFp_t;
+
+/* Cached powers of ten, 10^k = grisuPowF * 2^grisuPowE, k = -348 + 8 * i */
+static const uint64_t grisuPowF[] = {
+    0xFA8FD5A0081C0288U, 0xBAAEE17FA23EBF76U, 0x8B16FB203055AC76U,
+    0xCF42894A5DCE35EAU, 0x9A6BB0AA55653B2DU, 0xE61ACF033D1A45DFU,
+    0xAB70FE17C79AC6CAU, 0xFF77B1FCBEBCDC4FU, 0xBE5691EF416BD60CU,
+    0x8DD01FAD907FFC3CU, 0xD3515C2831559A83U, 0x9D71AC8FADA6C9B5U,
+    0xEA9C227723EE8BCBU, 0xAECC49914078536DU, 0x823C12795DB6CE57U,
+    0xC21094364DFB5637U, 0x9096EA6F3848984FU, 0xD77485CB25823AC7U,
+    0xA086CFCD97BF97F4U, 0xEF340A98172AACE5U, 0xB23867FB2A35B28EU,
+    0x84C8D4DFD2C63F3BU, 0xC5DD44271AD3CDBAU, 0x936B9FCEBB25C996U,
+    0xDBAC6C247D62A584U, 0xA3AB66580D5FDAF6U, 0xF3E2F893DEC3F126U,
+    0xB5B5ADA8AAFF80B8U, 0x87625F056C7C4A8BU, 0xC9BCFF6034C13053U,
+    0x964E858C91BA2655U, 0xDFF9772470297EBDU, 0xA6DFBD9FB8E5B88FU,
+    0xF8A95FCF88747D94U, 0xB94470938FA89BCFU, 0x8A08F0F8BF0F156BU,
+    0xCDB02555653131B6U, 0x993FE2C6D07B7FACU, 0xE45C10C42A2B3B06U,
+    0xAA242499697392D3U, 0xFD87B5F28300CA0EU, 0xBCE5086492111AEBU,
+    0x8CBCCC096F5088CCU, 0xD1B71758E219652CU, 0x9C40000000000000U,
+    0xE8D4A51000000000U, 0xAD78EBC5AC620000U, 0x813F3978F8940984U,
+    0xC097CE7BC90715B3U, 0x8F7E32CE7BEA5C70U, 0xD5D238A4ABE98068U,
+    0x9F4F2726179A2245U, 0xED63A231D4C4FB27U, 0xB0DE65388CC8ADA8U,
+    0x83C7088E1AAB65DBU, 0xC45D1DF942711D9AU, 0x924D692CA61BE758U,
+    0xDA01EE641A708DEAU, 0xA26DA3999AEF774AU, 0xF209787BB47D6B85U,
+    0xB454E4A179DD1877U, 0x865B86925B9BC5C2U, 0xC83553C5C8965D3DU,
+    0x952AB45CFA97A0B3U, 0xDE469FBD99A05FE3U, 0xA59BC234DB398C25U,
+    0xF6C69A72A3989F5CU, 0xB7DCBF5354E9BECEU, 0x88FCF317F22241E2U,
+    0xCC20CE9BD35C78A5U, 0x98165AF37B2153DFU, 0xE2A0B5DC971F303AU,
+    0xA8D9D1535CE3B396U, 0xFB9B7CD9A4A7443CU, 0xBB764C4CA7A44410U,
+    0x8BAB8EEFB6409C1AU, 0xD01FEF10A657842CU, 0x9B10A4E5E9913129U,
+    0xE7109BFBA19C0C9DU, 0xAC2820D9623BF429U, 0x80444B5E7AA7CF85U,
+    0xBF21E44003ACDD2DU, 0x8E679C2F5E44FF8FU, 0xD433179D9C8CB841U,
+    0x9E19DB92B4E31BA9U, 0xEB96BF6EBADF77D9U, 0xAF87023B9BF0EE6BU
+};
+static const int16_t grisuPowE[] = {
+    -1220, -1193, -1166, -1140, -1113, -1087, -1060, -1034, -1007, -980,
+    -954, -927, -901, -874, -847, -821, -794, -768, -741, -715,
+    -688, -661, -635, -608, -582, -555, -529, -502, -475, -449,
+    -422, -396, -369, -343, -316, -289, -263, -236, -210, -183,
+    -157, -130, -103, -77, -50, -24, 3, 30, 56, 83,
+    109, 136, 162, 189, 216, 242, 269, 295, 322, 348,
+    375, 402, 428, 455, 481, 508, 534, 561, 588, 614,
+    641, 667, 694, 720, 747, 774, 800, 827, 853, 880,
+    907, 933, 960, 986, 1013, 1039, 1066
+};
+
+static const uint64_t grisuPow10[] = {
+    1U, 10U, 100U, 1000U, 10000U, 100000U, 1000000U, 10000000U, 100000000U,
+    1000000000U, 10000000000U, 100000000000U, 1000000000000U,
+    10000000000000U, 100000000000000U, 1000000000000000U,
+    10000000000000000U, 100000000000000000U, 1000000000000000000U,
+    10000000000000000000U
+};
+
+/* Shift f left, so its most significant bit is set */
+static diyFp_t diyFpNormalize(diyFp_t x) {
+    while ((x.f >> 56) == 0U) {
+        x.f <<= 8;
+        x.e -= 8;
+    }
+    while ((x.f >> 63) == 0U) {
+        x.f <<= 1;
+        x.e--;
+    }
+    return x;
+}
+
+/* Upper 64 bits of the product, rounded */
+static diyFp_t diyFpMul(diyFp_t x, diyFp_t y) {
+    uint64_t a = x.f >> 32, b = x.f & 0xFFFFFFFFU;
+    uint64_t c = y.f >> 32, d = y.f & 0xFFFFFFFFU;
+    uint64_t bd = b * d, ad = a * d, bc = b * c;
+    uint64_t tmp = (bd >> 32) + (ad & 0xFFFFFFFFU) + (bc & 0xFFFFFFFFU);
+    diyFp_t r;
+
+    tmp += 1U << 31;
+    r.f = a * c + (ad >> 32) + (bc >> 32) + (tmp >> 32);
+    r.e = x.e + y.e + 64;
+    return r;
+}
+
+/* Move the last digit closer to w, while it stays inside the interval */
+static void grisuRound(char *digits, size_t len, uint64_t delta, uint64_t rest,
+                       uint64_t tenKappa, uint64_t wpw)
+{
+    while (rest < wpw && delta - rest >= tenKappa
+           && (rest + tenKappa < wpw || wpw - rest > rest + tenKappa - wpw)
+    ) {
+        digits[len - 1]--;
+        rest += tenKappa;
+    }
+}
+
+/* Generate digits of the shortest number inside the interval from mp - delta
+ * to mp, which is the closest to w. Return number of digits, value is
+ * digits * 10^K. */
+static size_t grisuDigits(diyFp_t w, diyFp_t mp, uint64_t delta, char *digits,
+                          int32_t *K)
+{
+    uint8_t shift = (uint8_t)-mp.e;
+    uint64_t one = (uint64_t)1 << shift;
+    uint64_t wpw = mp.f - w.f;
+    uint32_t p1 = (uint32_t)(mp.f >> shift);
+    uint64_t p2 = mp.f & (one - 1U);
+    int32_t kappa = 1;
+    size_t len = 0;
+
+    while (kappa < 10 && p1 >= grisuPow10[kappa]) {
+        kappa++;
+    }
+
+    /* integral part */
+    while (kappa > 0) {
+        uint32_t pow10 = (uint32_t)grisuPow10[kappa - 1];
+        uint32_t d = p1 / pow10;
+        p1 %= pow10;
+        if (d != 0U || len != 0U) {
+            digits[len++] = (char)('0' + d);
+        }
+        kappa--;
+        uint64_t rest = ((uint64_t)p1 << shift) + p2;
+        if (rest <= delta) {
+            *K += kappa;
+            grisuRound(digits, len, delta, rest,
+                       grisuPow10[kappa] << shift, wpw);
+            return len;
+        }
+    }
+
+    /* fractional part */
+    for (;;) {
+        p2 *= 10U;
+        delta *= 10U;
+        char d = (char)(p2 >> shift);
+        if (d != 0 || len != 0U) {
+            digits[len++] = (char)('0' + d);
+        }
+        p2 &= one - 1U;
+        kappa--;
+        if (p2 < delta) {
+            *K += kappa;
+            grisuRound(digits, len, delta, p2, one, wpw * grisuPow10[-kappa]);
+            return len;
+        }
+    }
+}
+
+/* Digits of the number f * 2^e, f has hidden bit included. lowerCloser is
+ * true, if f is power of two and lower neighbour is closer. */
+static size_t grisu2(uint64_t f, int32_t e, bool_t lowerCloser, char *digits,
+                     int32_t *K)
+{
+    diyFp_t w = diyFpNormalize((diyFp_t){f, e});
+    diyFp_t mp = diyFpNormalize((diyFp_t){(f << 1) + 1U, e - 1});
+    diyFp_t mm = lowerCloser ? (diyFp_t){(f << 2) - 1U, e - 2}
+                             : (diyFp_t){(f << 1) - 1U, e - 1};
+    diyFp_t c;
+
+    mm.f <<= mm.e - mp.e;
+    mm.e = mp.e;
+
+    /* cached power c = 10^-K, so exponent of mp * c is between -60 and -32 */
+    float64_t dk = (-61 - mp.e) * 0.30102999566398114 + 347;
+    int32_t k = (int32_t)dk;
+    if (k != dk) {
+        k++;
+    }
+    uint32_t index = (uint32_t)(k >> 3) + 1U;
+    *K = 348 - (int32_t)(index << 3);
+    c.f = grisuPowF[index];
+    c.e = grisuPowE[index];
+
+    w = diyFpMul(w, c);
+    mp = diyFpMul(mp, c);
+    mm = diyFpMul(mm, c);
+    mp.f--;
+    mm.f++;
+    return grisuDigits(w, mp, mp.f - mm.f, digits, K);
+}
+
+/* Print floating point number with the shortest digits, in the format as
+ * "%g": exponential notation is used, if decimal exponent is less than -4 or
+ * not less than max(6, number of digits). Integral numbers below 1e6 are
+ * printed directly. buf must have space for 25 characters. */
+static size_t printR64(char *buf, float64_t n, bool_t float32) {
+    static const float64_t zero = 0;
+    char digits[20];
+    uint64_t f;
+    int32_t e;
+    bool_t negative, lowerCloser;
+    int32_t K = 0;
+    size_t len = 0;
+
+    if (n > -1e6 && n < 1e6 && n == (float64_t)(int32_t)n
+        && (n != 0 || memcmp(&n, &zero, sizeof(n)) == 0)
+    ) {
+        return printI64(buf, (int32_t)n);
+    }
+
+    /* split into sign, significand with hidden bit and binary exponent */
+    if (float32) {
+        float32_t n32 = (float32_t)n;
+        uint32_t u;
+        memcpy(&u, &n32, sizeof(u));
+        uint32_t biased = (u >> 23) & 0xFFU;
+        negative = (u >> 31) != 0U;
+        f = u & 0x7FFFFFU;
+        if (biased == 0xFFU) {
+            e = INT32_MAX;
+        }
+        else if (biased != 0U) {
+            f |= 0x800000U;
+            e = (int32_t)biased - 150;
+        }
+        else {
+            e = -149;
+        }
+        lowerCloser = f == 0x800000U && biased > 1U;
+    }
+    else {
+        uint64_t u;
+        memcpy(&u, &n, sizeof(u));
+        uint32_t biased = (uint32_t)(u >> 52) & 0x7FFU;
+        negative = (u >> 63) != 0U;
+        f = u & 0xFFFFFFFFFFFFFU;
+        if (biased == 0x7FFU) {
+            e = INT32_MAX;
+        }
+        else if (biased != 0U) {
+            f |= 0x10000000000000U;
+            e = (int32_t)biased - 1075;
+        }
+        else {
+            e = -1074;
+        }
+        lowerCloser = f == 0x10000000000000U && biased > 1U;
+    }
+
+    if (negative) {
+        buf[len++] = '-';
+    }
+    if (e == INT32_MAX) {
+        memcpy(&buf[len], f == 0U ? "inf" : "nan", 4);
+        return len + 3;
+    }
+    if (f == 0U) {
+        memcpy(&buf[len], "0", 2);
+        return len + 1;
+    }
+
+    size_t nd = grisu2(f, e, lowerCloser, digits, &K);
+    int32_t X = (int32_t)nd + K - 1; /* exponent of the first digit */
+
+    if (X < -4 || X >= ((int32_t)nd > 6 ? (int32_t)nd : 6)) {
+        buf[len++] = digits[0];
+        if (nd > 1U) {
+            buf[len++] = '.';
+            memcpy(&buf[len], &digits[1], nd - 1U);
+            len += nd - 1U;
+        }
+        buf[len++] = 'e';
+        buf[len++] = X < 0 ? '-' : '+';
+        if (X < 0) {
+            X = -X;
+        }
+        if (X < 10) {
+            buf[len++] = '0';
+        }
+        len += printU32(&buf[len], (uint32_t)X);
+        return len;
+    }
+    if (X < 0) {
+        buf[len++] = '0';
+        buf[len++] = '.';
+        for (int32_t i = -1; i > X; i--) {
+            buf[len++] = '0';
+        }
+        memcpy(&buf[len], digits, nd);
+        len += nd;
+    }
+    else if ((size_t)X + 1U >= nd) {
+        memcpy(&buf[len], digits, nd);
+        len += nd;
+        for (size_t i = nd; i <= (size_t)X; i++) {
+            buf[len++] = '0';
+        }
+    }
+    else {
+        memcpy(&buf[len], digits, (size_t)X + 1U);
+        len += (size_t)X + 1U;
+        buf[len++] = '.';
+        memcpy(&buf[len], &digits[X + 1], nd - (size_t)X - 1U);
+        len += nd - (size_t)X - 1U;
+    }
+    buf[len] = '\0';
+    return len;
+}
+
+/* Parse null terminated string as unsigned number: decimal, hexadecimal with
+ * "0x" prefix or octal with leading "0", same as strtoull() with base 0. If
+ * negative is not NULL, then sign is allowed and written into it. Return false,
+ * if string is not a number or if number is larger than max. */
+static bool_t parseU64(const char *s, uint64_t max, bool_t *negative,
+                       uint64_t *value)
+{
+    uint64_t v = 0;
+    uint64_t limit;
+    uint8_t limitDigit;
+    uint8_t base = 10;
+    bool_t neg = false;
+
+    if (*s == '+' || *s == '-') {
+        neg = *s == '-';
+        if (neg && negative == NULL) {
+            return false;
+        }
+        s++;
+    }
+    if (s[0] == '0' && (s[1] == 'x' || s[1] == 'X')) {
+        base = 16;
+        s += 2;
+    }
+    else if (s[0] == '0') {
+        base = 8;
+    }
+    if (*s == '\0') {
+        return false;
+    }
+
+    /* v * base + d must not exceed max */
+    limit = max / base;
+    limitDigit = (uint8_t)(max - limit * base);
+    for ( ; *s != '\0'; s++) {
+        uint8_t d = hexDecode((uint8_t)*s);
+        if (d >= base || v > limit || (v == limit && d > limitDigit)) {
+            return false;
+        }
+        v = v * base + d;
+    }
+
+    if (negative != NULL) {
+        *negative = neg;
+    }
+    *value = v;
+    return true;
+}
+
+/* Parse null terminated string as signed number, see parseU64(). Number must
+ * be between -max-1 and max. */
+static bool_t parseI64(const char *s, int64_t max, int64_t *value) {
+    bool_t neg;
+    uint64_t v;
+
+    if (!parseU64(s, (uint64_t)max + 1U, &neg, &v)
+        || (!neg && v > (uint64_t)max)
+    ) {
+        return false;
+    }
+    *value = neg ? -(int64_t)(v - 1U) - 1 : (int64_t)v;
+    return true;
+}
+
+/* Parse 32 or 64 bit unsigned number, see parseU64(). max is all ones. If
+ * CO_CONFIG_FIFO_ASCII_STRICT_RANGE is not enabled, negative number is also
+ * accepted and converted with two's complement, as by strtoul(). */
+static bool_t parseU64wrap(const char *s, uint64_t max, uint64_t *value) {
+    bool_t neg = false;
+#if (CO_CONFIG_FIFO) & CO_CONFIG_FIFO_ASCII_STRICT_RANGE
+    bool_t *negative = NULL;
+#else
+    bool_t *negative = &neg;
+#endif
+
+    if (!parseU64(s, max, negative, value)) {
+        return false;
+    }
+    if (neg) {
+        *value = (0U - *value) & max;
+    }
+    return true;
+}
+
+/* Parse 32 or 64 bit signed number, see parseI64(). If
+ * CO_CONFIG_FIFO_ASCII_STRICT_RANGE is not enabled, positive number up to the
+ * unsigned maximum is also accepted and converted with two's complement, so
+ * "0xFFFFFFFF" is -1 for 32 bit number, as by strtol(). */
+static bool_t parseI64wrap(const char *s, int64_t max, int64_t *value) {
+#if (CO_CONFIG_FIFO) & CO_CONFIG_FIFO_ASCII_STRICT_RANGE
+    return parseI64(s, max, value);
+#else
+    uint64_t umax = (uint64_t)max * 2U + 1U;
+    bool_t neg;
+    uint64_t v;
+
+    if (!parseU64(s, umax, &neg, &v) || (neg && v > (uint64_t)max + 1U)) {
+        return false;
+    }
+    if (neg) {
+        *value = -(int64_t)(v - 1U) - 1;
+    }
+    else if (v > (uint64_t)max) {
+        *value = -(int64_t)(umax - v) - 1;
+    }
+    else {
+        *value = (int64_t)v;
+    }
+    return true;
+#endif
+}
+
+/* Powers of ten, which are exact in float64_t */
+static const float64_t exactPow10[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+/* Parse null terminated string as floating point number, same as strtod() or
+ * strtof() in "C" locale. Decimal number is read into integer significand and
+ * decimal exponent. If significand is exact in float64_t (float32_t) and
+ * exponent is not larger than 22 (10), number is calculated with single
+ * correctly rounded multiplication or division (Clinger's fast path). Other
+ * numbers (long significand, large exponent, hexadecimal, inf, nan) are parsed
+ * with strtod() or strtof(), where decimal point is replaced with the first
+ * character of the decimal point of the current locale. Return false, if
+ * string is not a number. */
+static bool_t parseR64(const char *s, bool_t float32, float64_t *value) {
+    const char *p = s;
+    uint64_t m = 0;
+    int32_t e = 0;
+    uint8_t nd = 0; /* significant digits in m */
+    bool_t digits = false;
+    bool_t exact = true;
+    bool_t negative = false;
+
+    if (*p == '+' || *p == '-') {
+        negative = *p == '-';
+        p++;
+    }
+    for ( ; (uint8_t)(*p - '0') <= 9U; p++) {
+        digits = true;
+        if (nd < 19U) {
+            m = m * 10U + (uint8_t)(*p - '0');
+            if (m != 0U) nd++;
+        }
+        else {
+            e++;
+            if (*p != '0') exact = false;
+        }
+    }
+    if (*p == '.') {
+        for (p++; (uint8_t)(*p - '0') <= 9U; p++) {
+            digits = true;
+            if (nd < 19U) {
+                m = m * 10U + (uint8_t)(*p - '0');
+                if (m != 0U) nd++;
+                e--;
+            }
+            else if (*p != '0') {
+                exact = false;
+            }
+        }
+    }
+    if (digits && (*p == 'e' || *p == 'E')) {
+        const char *q = p + 1;
+        bool_t expNegative = false;
+        int32_t x = 0;
+
+        if (*q == '+' || *q == '-') {
+            expNegative = *q == '-';
+            q++;
+        }
+        if ((uint8_t)(*q - '0') <= 9U) {
+            for ( ; (uint8_t)(*q - '0') <= 9U; q++) {
+                if (x < 10000) x = x * 10 + (*q - '0');
+            }
+            e += expNegative ? -x : x;
+            p = q;
+        }
+    }
+
+    if (digits && exact && *p == '\0') {
+        uint32_t ePos = (uint32_t)(e < 0 ? -e : e);
+
+        if (float32) {
+            if (m <= 0x1000000U && ePos <= 10U) {
+                float32_t f = (float32_t)m;
+                float32_t pow = (float32_t)exactPow10[ePos];
+                f = e < 0 ? f / pow : f * pow;
+                *value = negative ? -f : f;
+                return true;
+            }
+        }
+        else if (m <= 0x20000000000000U && ePos <= 22U) {
+            float64_t f = (float64_t)m;
+            f = e < 0 ? f / exactPow10[ePos] : f * exactPow10[ePos];
+            *value = negative ? -f : f;
+            return true;
+        }
+    }
+
+    /* slow path, number must be written in the "C" locale */
+    char buf[40];
+    char *point;
+    char *sRet;
+    char localePoint = localeconv()->decimal_point[0];
+    size_t len = strlen(s);
+
+    if (len >= sizeof(buf)
+        || (localePoint != '.' && strchr(s, localePoint) != NULL)
+    ) {
+        return false;
+    }
+    memcpy(buf, s, len + 1U);
+    point = strchr(buf, '.');
+    if (point != NULL) {
+        *point = localePoint;
+    }
+    if (float32) {
+        *value = strtof(buf, &sRet);
+    }
+    else {
+        *value = strtod(buf, &sRet);
+    }
+    return len > 0U && sRet == &buf[len];
+}
+
 size_t CO_fifo_readU82a(CO_fifo_t *fifo, char *buf, size_t count, bool_t end) {
     uint8_t n=0;
 
     if (fifo != NULL && count >= 6 && CO_fifo_getOccupied(fifo) == sizeof(n)) {
         CO_fifo_read(fifo, &n, sizeof(n), NULL);
-        return sprintf(buf, "%"PRIu8, n);
+        return printU32(buf, n);
     }
     else {
         return CO_fifo_readHex2a(fifo, buf, count, end);
@@ -499,7 +1286,7 @@ size_t CO_fifo_readU162a(CO_fifo_t *fifo, char *buf, size_t count, bool_t end) {
 
     if (fifo != NULL && count >= 8 && CO_fifo_getOccupied(fifo) == sizeof(n)) {
         CO_fifo_read(fifo, (uint8_t *)&n, sizeof(n), NULL);
-        return sprintf(buf, "%"PRIu16, CO_SWAP_16(n));
+        return printU32(buf, CO_SWAP_16(n));
     }
     else {
         return CO_fifo_readHex2a(fifo, buf, count, end);
@@ -511,7 +1298,7 @@ size_t CO_fifo_readU322a(CO_fifo_t *fifo, char *buf, size_t count, bool_t end) {
 
     if (fifo != NULL && count >= 12 && CO_fifo_getOccupied(fifo) == sizeof(n)) {
         CO_fifo_read(fifo, (uint8_t *)&n, sizeof(n), NULL);
-        return sprintf(buf, "%"PRIu32, CO_SWAP_32(n));
+        return printU32(buf, CO_SWAP_32(n));
     }
     else {
         return CO_fifo_readHex2a(fifo, buf, count, end);
@@ -523,7 +1310,7 @@ size_t CO_fifo_readU642a(CO_fifo_t *fifo, char *buf, size_t count, bool_t end) {
 
     if (fifo != NULL && count >= 20 && CO_fifo_getOccupied(fifo) == sizeof(n)) {
         CO_fifo_read(fifo, (uint8_t *)&n, sizeof(n), NULL);
-        return sprintf(buf, "%"PRIu64, CO_SWAP_64(n));
+        return printU64(buf, CO_SWAP_64(n));
     }
     else {
         return CO_fifo_readHex2a(fifo, buf, count, end);
@@ -535,7 +1322,7 @@ size_t CO_fifo_readX82a(CO_fifo_t *fifo, char *buf, size_t count, bool_t end) {
 
     if (fifo != NULL && count >= 6 && CO_fifo_getOccupied(fifo) == sizeof(n)) {
         CO_fifo_read(fifo, (uint8_t *)&n, sizeof(n), NULL);
-        return sprintf(buf, "0x%02"PRIX8, n);
+        return printX64(buf, n, 2);
     }
     else {
         return CO_fifo_readHex2a(fifo, buf, count, end);
@@ -547,7 +1334,7 @@ size_t CO_fifo_readX162a(CO_fifo_t *fifo, char *buf, size_t count, bool_t end) {
 
     if (fifo != NULL && count >= 8 && CO_fifo_getOccupied(fifo) == sizeof(n)) {
         CO_fifo_read(fifo, (uint8_t *)&n, sizeof(n), NULL);
-        return sprintf(buf, "0x%04"PRIX16, CO_SWAP_16(n));
+        return printX64(buf, CO_SWAP_16(n), 4);
     }
     else {
         return CO_fifo_readHex2a(fifo, buf, count, end);
@@ -559,7 +1346,7 @@ size_t CO_fifo_readX322a(CO_fifo_t *fifo, char *buf, size_t count, bool_t end) {
 
     if (fifo != NULL && count >= 12 && CO_fifo_getOccupied(fifo) == sizeof(n)) {
         CO_fifo_read(fifo, (uint8_t *)&n, sizeof(n), NULL);
-        return sprintf(buf, "0x%08"PRIX32, CO_SWAP_32(n));
+        return printX64(buf, CO_SWAP_32(n), 8);
     }
     else {
         return CO_fifo_readHex2a(fifo, buf, count, end);
@@ -571,7 +1358,7 @@ size_t CO_fifo_readX642a(CO_fifo_t *fifo, char *buf, size_t count, bool_t end) {
 
     if (fifo != NULL && count >= 20 && CO_fifo_getOccupied(fifo) == sizeof(n)) {
         CO_fifo_read(fifo, (uint8_t *)&n, sizeof(n), NULL);
-        return sprintf(buf, "0x%016"PRIX64, CO_SWAP_64(n));
+        return printX64(buf, CO_SWAP_64(n), 16);
     }
     else {
         return CO_fifo_readHex2a(fifo, buf, count, end);
@@ -583,7 +1370,7 @@ size_t CO_fifo_readI82a(CO_fifo_t *fifo, char *buf, size_t count, bool_t end) {
 
     if (fifo != NULL && count >= 6 && CO_fifo_getOccupied(fifo) == sizeof(n)) {
         CO_fifo_read(fifo, (uint8_t *)&n, sizeof(n), NULL);
-        return sprintf(buf, "%"PRId8, n);
+        return printI64(buf, n);
     }
     else {
         return CO_fifo_readHex2a(fifo, buf, count, end);
@@ -595,7 +1382,7 @@ size_t CO_fifo_readI162a(CO_fifo_t *fifo, char *buf, size_t count, bool_t end) {
 
     if (fifo != NULL && count >= 8 && CO_fifo_getOccupied(fifo) == sizeof(n)) {
         CO_fifo_read(fifo, (uint8_t *)&n, sizeof(n), NULL);
-        return sprintf(buf, "%"PRId16, CO_SWAP_16(n));
+        return printI64(buf, CO_SWAP_16(n));
     }
     else {
         return CO_fifo_readHex2a(fifo, buf, count, end);
@@ -607,7 +1394,7 @@ size_t CO_fifo_readI322a(CO_fifo_t *fifo, char *buf, size_t count, bool_t end) {
 
     if (fifo != NULL && count >= 13 && CO_fifo_getOccupied(fifo) == sizeof(n)) {
         CO_fifo_read(fifo, (uint8_t *)&n, sizeof(n), NULL);
-        return sprintf(buf, "%"PRId32, CO_SWAP_32(n));
+        return printI64(buf, CO_SWAP_32(n));
     }
     else {
         return CO_fifo_readHex2a(fifo, buf, count, end);
@@ -619,7 +1406,7 @@ size_t CO_fifo_readI642a(CO_fifo_t *fifo, char *buf, size_t count, bool_t end) {
 
     if (fifo != NULL && count >= 23 && CO_fifo_getOccupied(fifo) == sizeof(n)) {
         CO_fifo_read(fifo, (uint8_t *)&n, sizeof(n), NULL);
-        return sprintf(buf, "%"PRId64, CO_SWAP_64(n));
+        return printI64(buf, CO_SWAP_64(n));
     }
     else {
         return CO_fifo_readHex2a(fifo, buf, count, end);
@@ -631,7 +1418,7 @@ size_t CO_fifo_readR322a(CO_fifo_t *fifo, char *buf, size_t count, bool_t end) {
 
     if (fifo != NULL && count >= 20 && CO_fifo_getOccupied(fifo) == sizeof(n)) {
         CO_fifo_read(fifo, (uint8_t *)&n, sizeof(n), NULL);
-        return sprintf(buf, "%g", (double)CO_SWAP_32(n));
+        return printR64(buf, CO_SWAP_32(n), true);
     }
     else {
         return CO_fifo_readHex2a(fifo, buf, count, end);
@@ -643,7 +1430,7 @@ size_t CO_fifo_readR642a(CO_fifo_t *fifo, char *buf, size_t count, bool_t end) {
 
     if (fifo != NULL && count >= 30 && CO_fifo_getOccupied(fifo) == sizeof(n)) {
         CO_fifo_read(fifo, (uint8_t *)&n, sizeof(n), NULL);
-        return sprintf(buf, "%g", (double)CO_SWAP_64(n));
+        return printR64(buf, CO_SWAP_64(n), false);
     }
     else {
         return CO_fifo_readHex2a(fifo, buf, count, end);
@@ -660,17 +1447,32 @@ size_t CO_fifo_readHex2a(CO_fifo_t *fifo, char *buf, size_t count, bool_t end) {
         if (!fifo->started) {
             uint8_t c;
             if(CO_fifo_getc(fifo, &c)) {
-                len = sprintf(&buf[0], "%02"PRIX8, c);
+                buf[len++] = hexEncTable[c >> 4];
+                buf[len++] = hexEncTable[c & 0x0F];
+                buf[len] = 0;
                 fifo->started = true;
             }
         }
 
+        /* up to two spans, if data wraps in the fifo buffer */
         while ((len + 3) < count) {
-            uint8_t c;
-            if(!CO_fifo_getc(fifo, &c)) {
+            const uint8_t *src;
+            size_t n = CO_fifo_peek(fifo, 0, &src);
+            size_t i;
+
+            if (n == 0) {
                 break;
             }
-            len += sprintf(&buf[len], " %02"PRIX8, c);
+            if (n > (count - len - 1) / 3) {
+                n = (count - len - 1) / 3;
+            }
+            for (i = 0; i < n; i++) {
+                buf[len++] = ' ';
+                buf[len++] = hexEncTable[src[i] >> 4];
+                buf[len++] = hexEncTable[src[i] & 0x0F];
+            }
+            buf[len] = 0;
+            (void)CO_fifo_skip(fifo, n);
         }
     }
 
@@ -689,6 +1491,12 @@ size_t CO_fifo_readVs2a(CO_fifo_t *fifo, char *buf, size_t count, bool_t end) {
 
         while ((len + 2) < count) {
             uint8_t c;
+            /* leave room for the closing '"' after the last character */
+            if (end && (len + 3) >= count
+                && CO_fifo_getOccupied(fifo) == 1
+            ) {
+                break;
+            }
             if(!CO_fifo_getc(fifo, &c)) {
                 if (end) {
                     buf[len++] = '"';
@@ -728,9 +1536,46 @@ size_t CO_fifo_readB642a(CO_fifo_t *fifo, char *buf, size_t count, bool_t end) {
             word = (uint16_t)fifo->aux;
         }
 
+        /* whole groups of three bytes from the fifo buffer, four characters
+         * each. The last byte is left for the loop below. */
+        while (step == 0) {
+            const uint8_t *src;
+            size_t n = CO_fifo_peek(fifo, 0, &src);
+            size_t i;
+
+            if (n == 0) {
+                break;
+            }
+            if (n >= CO_fifo_getOccupied(fifo)) {
+                n--;
+            }
+            n /= 3;
+            if (n > (count - len) / 4) {
+                n = (count - len) / 4;
+            }
+            if (n == 0) {
+                break;
+            }
+            for (i = 0; i < n; i++, src += 3) {
+                uint32_t group = (uint32_t)src[0] << 16
+                                 | (uint32_t)src[1] << 8 | src[2];
+                buf[len++] = base64EncTable[(group >> 18) & 0x3F];
+                buf[len++] = base64EncTable[(group >> 12) & 0x3F];
+                buf[len++] = base64EncTable[(group >> 6) & 0x3F];
+                buf[len++] = base64EncTable[group & 0x3F];
+            }
+            (void)CO_fifo_skip(fifo, n * 3);
+        }
+
         while ((len + 3) <= count) {
             uint8_t c;
 
+            /* leave room for the padding after the last byte */
+            if (end && (len + 4) > count
+                && CO_fifo_getOccupied(fifo) == 1
+            ) {
+                break;
+            }
             if(!CO_fifo_getc(fifo, &c)) {
                 /* buffer is empty, is also SDO communication finished? */
                 if (end) {
@@ -786,11 +1631,10 @@ size_t CO_fifo_cpyTok2U8(CO_fifo_t *dest, CO_fifo_t *src, CO_fifo_st *status) {
     CO_fifo_st st = (uint8_t)closed;
     if (nRd == 0 || err) st |= CO_fifo_st_errTok;
     else {
-        char *sRet;
-        uint32_t u32 = strtoul(buf, &sRet, 0);
-        if (sRet != strchr(buf, '\0') || u32 > UINT8_MAX) st |= CO_fifo_st_errVal;
+        uint64_t u64;
+        if (!parseU64(buf, UINT8_MAX, NULL, &u64)) st |= CO_fifo_st_errVal;
         else {
-            uint8_t num = (uint8_t) u32;
+            uint8_t num = (uint8_t) u64;
             nWr = CO_fifo_write(dest, &num, sizeof(num), NULL);
             if (nWr != sizeof(num)) st |= CO_fifo_st_errBuf;
         }
@@ -808,11 +1652,10 @@ size_t CO_fifo_cpyTok2U16(CO_fifo_t *dest, CO_fifo_t *src, CO_fifo_st *status) {
     CO_fifo_st st = (uint8_t)closed;
     if (nRd == 0 || err) st |= CO_fifo_st_errTok;
     else {
-        char *sRet;
-        uint32_t u32 = strtoul(buf, &sRet, 0);
-        if (sRet != strchr(buf, '\0') || u32 > UINT16_MAX) st |= CO_fifo_st_errVal;
+        uint64_t u64;
+        if (!parseU64(buf, UINT16_MAX, NULL, &u64)) st |= CO_fifo_st_errVal;
         else {
-            uint16_t num = CO_SWAP_16((uint16_t) u32);
+            uint16_t num = CO_SWAP_16((uint16_t) u64);
             nWr = CO_fifo_write(dest, (uint8_t *)&num, sizeof(num), NULL);
             if (nWr != sizeof(num)) st |= CO_fifo_st_errBuf;
         }
@@ -830,11 +1673,10 @@ size_t CO_fifo_cpyTok2U32(CO_fifo_t *dest, CO_fifo_t *src, CO_fifo_st *status) {
     CO_fifo_st st = (uint8_t)closed;
     if (nRd == 0 || err) st |= CO_fifo_st_errTok;
     else {
-        char *sRet;
-        uint32_t u32 = strtoul(buf, &sRet, 0);
-        if (sRet != strchr(buf, '\0')) st |= CO_fifo_st_errVal;
+        uint64_t u64;
+        if (!parseU64wrap(buf, UINT32_MAX, &u64)) st |= CO_fifo_st_errVal;
         else {
-            uint32_t num = CO_SWAP_32(u32);
+            uint32_t num = CO_SWAP_32((uint32_t) u64);
             nWr = CO_fifo_write(dest, (uint8_t *)&num, sizeof(num), NULL);
             if (nWr != sizeof(num)) st |= CO_fifo_st_errBuf;
         }
@@ -852,9 +1694,8 @@ size_t CO_fifo_cpyTok2U64(CO_fifo_t *dest, CO_fifo_t *src, CO_fifo_st *status) {
     CO_fifo_st st = (uint8_t)closed;
     if (nRd == 0 || err) st |= CO_fifo_st_errTok;
     else {
-        char *sRet;
-        uint64_t u64 = strtoull(buf, &sRet, 0);
-        if (sRet != strchr(buf, '\0')) st |= CO_fifo_st_errVal;
+        uint64_t u64;
+        if (!parseU64wrap(buf, UINT64_MAX, &u64)) st |= CO_fifo_st_errVal;
         else {
             uint64_t num = CO_SWAP_64(u64);
             nWr = CO_fifo_write(dest, (uint8_t *)&num, sizeof(num), NULL);
@@ -874,12 +1715,10 @@ size_t CO_fifo_cpyTok2I8(CO_fifo_t *dest, CO_fifo_t *src, CO_fifo_st *status) {
     CO_fifo_st st = (uint8_t)closed;
     if (nRd == 0 || err) st |= CO_fifo_st_errTok;
     else {
-        char *sRet;
-        int32_t i32 = strtol(buf, &sRet, 0);
-        if (sRet != strchr(buf, '\0') || i32 < INT8_MIN || i32 > INT8_MAX) {
-            st |= CO_fifo_st_errVal;
-        } else {
-            int8_t num = (int8_t) i32;
+        int64_t i64;
+        if (!parseI64(buf, INT8_MAX, &i64)) st |= CO_fifo_st_errVal;
+        else {
+            int8_t num = (int8_t) i64;
             nWr = CO_fifo_write(dest, (uint8_t *)&num, sizeof(num), NULL);
             if (nWr != sizeof(num)) st |= CO_fifo_st_errBuf;
         }
@@ -897,12 +1736,10 @@ size_t CO_fifo_cpyTok2I16(CO_fifo_t *dest, CO_fifo_t *src, CO_fifo_st *status) {
     CO_fifo_st st = (uint8_t)closed;
     if (nRd == 0 || err) st |= CO_fifo_st_errTok;
     else {
-        char *sRet;
-        int32_t i32 = strtol(buf, &sRet, 0);
-        if (sRet != strchr(buf, '\0') || i32 < INT16_MIN || i32 > INT16_MAX) {
-            st |= CO_fifo_st_errVal;
-        } else {
-            int16_t num = CO_SWAP_16((int16_t) i32);
+        int64_t i64;
+        if (!parseI64(buf, INT16_MAX, &i64)) st |= CO_fifo_st_errVal;
+        else {
+            int16_t num = CO_SWAP_16((int16_t) i64);
             nWr = CO_fifo_write(dest, (uint8_t *)&num, sizeof(num), NULL);
             if (nWr != sizeof(num)) st |= CO_fifo_st_errBuf;
         }
@@ -920,11 +1757,10 @@ size_t CO_fifo_cpyTok2I32(CO_fifo_t *dest, CO_fifo_t *src, CO_fifo_st *status) {
     CO_fifo_st st = (uint8_t)closed;
     if (nRd == 0 || err) st |= CO_fifo_st_errTok;
     else {
-        char *sRet;
-        int32_t i32 = strtol(buf, &sRet, 0);
-        if (sRet != strchr(buf, '\0')) st |= CO_fifo_st_errVal;
+        int64_t i64;
+        if (!parseI64wrap(buf, INT32_MAX, &i64)) st |= CO_fifo_st_errVal;
         else {
-            int32_t num = CO_SWAP_32(i32);
+            int32_t num = CO_SWAP_32((int32_t) i64);
             nWr = CO_fifo_write(dest, (uint8_t *)&num, sizeof(num), NULL);
             if (nWr != sizeof(num)) st |= CO_fifo_st_errBuf;
         }
@@ -942,9 +1778,8 @@ size_t CO_fifo_cpyTok2I64(CO_fifo_t *dest, CO_fifo_t *src, CO_fifo_st *status) {
     CO_fifo_st st = (uint8_t)closed;
     if (nRd == 0 || err) st |= CO_fifo_st_errTok;
     else {
-        char *sRet;
-        int64_t i64 = strtoll(buf, &sRet, 0);
-        if (sRet != strchr(buf, '\0')) st |= CO_fifo_st_errVal;
+        int64_t i64;
+        if (!parseI64wrap(buf, INT64_MAX, &i64)) st |= CO_fifo_st_errVal;
         else {
             int64_t num = CO_SWAP_64(i64);
             nWr = CO_fifo_write(dest, (uint8_t *)&num, sizeof(num), NULL);
@@ -964,11 +1799,10 @@ size_t CO_fifo_cpyTok2R32(CO_fifo_t *dest, CO_fifo_t *src, CO_fifo_st *status) {
     CO_fifo_st st = (uint8_t)closed;
     if (nRd == 0 || err) st |= CO_fifo_st_errTok;
     else {
-        char *sRet;
-        float32_t f32 = strtof(buf, &sRet);
-        if (sRet != strchr(buf, '\0')) st |= CO_fifo_st_errVal;
+        float64_t f64;
+        if (!parseR64(buf, true, &f64)) st |= CO_fifo_st_errVal;
         else {
-            float32_t num = CO_SWAP_32(f32);
+            float32_t num = CO_SWAP_32((float32_t)f64);
             nWr = CO_fifo_write(dest, (uint8_t *)&num, sizeof(num), NULL);
             if (nWr != sizeof(num)) st |= CO_fifo_st_errBuf;
         }
@@ -986,9 +1820,8 @@ size_t CO_fifo_cpyTok2R64(CO_fifo_t *dest, CO_fifo_t *src, CO_fifo_st *status) {
     CO_fifo_st st = (uint8_t)closed;
     if (nRd == 0 || err) st |= CO_fifo_st_errTok;
     else {
-        char *sRet;
-        float64_t f64 = strtof(buf, &sRet);
-        if (sRet != strchr(buf, '\0')) st |= CO_fifo_st_errVal;
+        float64_t f64;
+        if (!parseR64(buf, false, &f64)) st |= CO_fifo_st_errVal;
         else {
             float64_t num = CO_SWAP_64(f64);
             nWr = CO_fifo_write(dest, (uint8_t *)&num, sizeof(num), NULL);
@@ -1034,6 +1867,46 @@ size_t CO_fifo_cpyTok2Hex(CO_fifo_t *dest, CO_fifo_t *src, CO_fifo_st *status) {
      * and source characters available */
     while (destSpace > 0 && (st & CO_fifo_st_errMask) == 0 && !finished) {
         uint8_t c;
+
+        /* pairs of hex digits, optionally separated by single space, directly
+         * from the fifo buffers */
+        if (step == 0) {
+            const uint8_t *s;
+            uint8_t *d = &dest->buf[dest->writePtr];
+            size_t sn = CO_fifo_peek(src, 0, &s);
+            size_t dn = spanWrite(dest);
+            size_t i = 0, j = 0;
+
+            if (dn > destSpace) {
+                dn = destSpace;
+            }
+            /* next hex digit must follow in the same span */
+            while ((i + 3) < sn && j < dn) {
+                uint8_t hi = hexDecode(s[i]);
+                uint8_t lo = hexDecode(s[i + 1]);
+                if ((hi | lo) == 0xFF) {
+                    break;
+                }
+                if (hexDecode(s[i + 2]) != 0xFF) {
+                    i += 2;
+                }
+                else if (s[i + 2] == (uint8_t)' '
+                         && hexDecode(s[i + 3]) != 0xFF) {
+                    i += 3;
+                }
+                else {
+                    break;
+                }
+                d[j++] = (uint8_t)(hi << 4 | lo);
+            }
+            if (j > 0) {
+                (void)CO_fifo_skip(src, i);
+                spanWriteDone(dest, j);
+                destSpace -= j;
+                continue;
+            }
+        }
+
         if (!CO_fifo_getc(src, &c)) {
             break;
         }
@@ -1056,11 +1929,8 @@ size_t CO_fifo_cpyTok2Hex(CO_fifo_t *dest, CO_fifo_t *src, CO_fifo_st *status) {
             }
             else {
                 /* write the byte */
-                uint8_t s[3];
-                int32_t num;
-                s[0] = firstChar; s[1] = c; s[2] = 0;
-                num = strtol((char *)&s[0], NULL, 16);
-                CO_fifo_putc(dest, (uint8_t) num);
+                CO_fifo_putc(dest, (uint8_t)(hexDecode(firstChar) << 4
+                                             | hexDecode(c)));
                 destSpace--;
                 step = 0;
             }
@@ -1076,11 +1946,7 @@ size_t CO_fifo_cpyTok2Hex(CO_fifo_t *dest, CO_fifo_t *src, CO_fifo_st *status) {
             /* this is space or delimiter */
             if (step == 1) {
                 /* write the byte */
-                uint8_t s[2];
-                int32_t num;
-                s[0] = firstChar; s[1] = 0;
-                num = strtol((char *)&s[0], NULL, 16);
-                CO_fifo_putc(dest, (uint8_t) num);
+                CO_fifo_putc(dest, hexDecode(firstChar));
                 destSpace--;
                 step = 0;
             }
@@ -1304,6 +2170,42 @@ size_t CO_fifo_cpyTok2B64(CO_fifo_t *dest, CO_fifo_t *src, CO_fifo_st *status) {
      * and source characters available */
     while (destSpace >= 3 && (st & CO_fifo_st_errMask) == 0 && !finished) {
         uint8_t c;
+
+        /* whole groups of four characters directly from the fifo buffers */
+        if (step == 0) {
+            const uint8_t *s;
+            uint8_t *d = &dest->buf[dest->writePtr];
+            size_t sn = CO_fifo_peek(src, 0, &s) / 4;
+            size_t dn = spanWrite(dest);
+            size_t n;
+
+            if (dn > destSpace) {
+                dn = destSpace;
+            }
+            dn /= 3;
+            for (n = 0; n < sn && n < dn; n++, s += 4, d += 3) {
+                uint8_t c0 = base64DecTable[s[0] & 0x7F];
+                uint8_t c1 = base64DecTable[s[1] & 0x7F];
+                uint8_t c2 = base64DecTable[s[2] & 0x7F];
+                uint8_t c3 = base64DecTable[s[3] & 0x7F];
+                if (((s[0] | s[1] | s[2] | s[3]) & 0x80) != 0
+                    || ((c0 | c1 | c2 | c3) & 0xC0) != 0
+                ) {
+                    /* not base64 characters, use the loop below */
+                    break;
+                }
+                d[0] = (uint8_t)(c0 << 2 | c1 >> 4);
+                d[1] = (uint8_t)(c1 << 4 | c2 >> 2);
+                d[2] = (uint8_t)(c2 << 6 | c3);
+            }
+            if (n > 0) {
+                (void)CO_fifo_skip(src, n * 4);
+                spanWriteDone(dest, n * 3);
+                destSpace -= n * 3;
+                continue;
+            }
+        }
+
         if (!CO_fifo_getc(src, &c)) {
             break;
         }
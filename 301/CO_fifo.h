@@ -267,6 +267,93 @@ size_t CO_fifo_write(CO_fifo_t *fifo,
 size_t CO_fifo_read(CO_fifo_t *fifo, uint8_t *buf, size_t count, bool_t *eof);
 
 
+/**
+ * Get pointer to data inside CO_fifo_t buffer object without reading them
+ *
+ * Data in circular buffer may wrap, so they are accessible in up to two
+ * contiguous blocks. Second block is at offset equal to size of the first
+ * block. Data stays in fifo, it can be removed with #CO_fifo_skip.
+ *
+ * @param fifo This object
+ * @param offset Offset in bytes from the read position
+ * @param [out] buf Pointer to the data at offset will be written here
+ *
+ * @return number of contiguous bytes at buf, 0 if there is no data at offset.
+ */
+size_t CO_fifo_peek(CO_fifo_t *fifo, size_t offset, const uint8_t **buf);
+
+
+/**
+ * Remove data from CO_fifo_t buffer object without copying them
+ *
+ * @param fifo This object
+ * @param count Remove up to count bytes
+ *
+ * @return number of bytes actually removed.
+ */
+size_t CO_fifo_skip(CO_fifo_t *fifo, size_t count);
+
+
+/**
+ * Move data from one CO_fifo_t buffer object into another
+ *
+ * Data are copied directly between the buffers, in contiguous blocks, without
+ * intermediate buffer. CRC is not calculated.
+ *
+ * @param dest Destination fifo
+ * @param src Source fifo
+ * @param count Move up to count bytes
+ *
+ * @return number of bytes actually moved, limited also by data in src and
+ * free space in dest.
+ */
+size_t CO_fifo_cpy(CO_fifo_t *dest, CO_fifo_t *src, size_t count);
+
+
+/**
+ * Get read mark of CO_fifo_t buffer object
+ *
+ * Mark is the current read position. Data read after it can be returned to
+ * the fifo with #CO_fifo_rewind, for example if command is parsed, but can't
+ * be executed yet.
+ *
+ * @param fifo This object
+ *
+ * @return read mark
+ */
+static inline size_t CO_fifo_getReadMark(CO_fifo_t *fifo) {
+    return fifo->readPtr;
+}
+
+
+/**
+ * Return data read after the mark back into CO_fifo_t buffer object
+ *
+ * Data are not returned, if the space of the read data was written meanwhile.
+ *
+ * @param fifo This object
+ * @param mark Read mark from #CO_fifo_getReadMark
+ *
+ * @return true on success, false if data were overwritten.
+ */
+bool_t CO_fifo_rewind(CO_fifo_t *fifo, size_t mark);
+
+
+/**
+ * Swap two adjacent blocks of data at the beginning of CO_fifo_t object
+ *
+ * First block of length1 bytes is moved behind the second block of length2
+ * bytes. Data stay in fifo and keep the same size.
+ *
+ * @param fifo This object
+ * @param length1 Length of the first block
+ * @param length2 Length of the second block
+ *
+ * @return true on success, false if there is not enough data in fifo.
+ */
+bool_t CO_fifo_swap(CO_fifo_t *fifo, size_t length1, size_t length2);
+
+
 #if ((CO_CONFIG_FIFO) & CO_CONFIG_FIFO_ALT_READ) || defined CO_DOXYGEN
 /**
  * Initializes alternate read with #CO_fifo_altRead
@@ -0,0 +1,427 @@
+/*
+ * CANopen network scan, non-standard.
+ *
+ * @file        CO_nodeScan.c
+ * @ingroup     CO_nodeScan
+ * @author      J-Weisberg
+ * @copyright   2026 J-Weisberg
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string.h>
+
+#include "301/CO_nodeScan.h"
+
+#if (CO_CONFIG_NODE_SCAN) & CO_CONFIG_NODE_SCAN_ENABLE
+
+/* Identity object, which is read from the nodes */
+#define SCAN_INDEX 0x1018U
+#define SCAN_SUBINDEX_LAST 4U
+
+/* SDO command specifiers, see CO_SDOclient.c */
+#define SCAN_CCS_UPLOAD_INITIATE 0x40U
+#define SCAN_SCS_UPLOAD_INITIATE 0x40U
+#define SCAN_SCS_UPLOAD_EXPEDITED 0x02U
+#define SCAN_SCS_UPLOAD_SIZE 0x01U
+#define SCAN_CS_ABORT 0x80U
+
+
+/*
+ * Read received SDO response from CAN module.
+ *
+ * Function will be called (by CAN receive interrupt) every time, when CAN
+ * message with correct identifier will be received. For more information and
+ * description of parameters see file CO_driver.h.
+ */
+static void CO_nodeScan_receiveSDO(void *object, void *msg) {
+    CO_nodeScan_t *scan = (CO_nodeScan_t *)object;
+    uint8_t DLC = CO_CANrxMsg_readDLC(msg);
+    uint8_t *data = CO_CANrxMsg_readData(msg);
+    uint8_t nodeId = (uint8_t)(CO_CANrxMsg_readIdent(msg) & 0x7FU);
+    CO_nodeScan_req_t *req;
+
+    if (scan->running && DLC == 8U && nodeId >= CO_NODE_SCAN_NODE_MIN) {
+        req = &scan->req[nodeId - 1U];
+
+        /* response must match the pending request */
+        if (req->subIndex != 0U && !req->txPending
+            && !CO_FLAG_READ(req->CANrxNew)
+            && data[1] == (uint8_t)SCAN_INDEX
+            && data[2] == (uint8_t)(SCAN_INDEX >> 8)
+            && data[3] == req->subIndex
+        ) {
+            /* copy data and set 'new message' flag */
+            memcpy(req->CANrxData, data, sizeof(req->CANrxData));
+            CO_FLAG_SET(req->CANrxNew);
+            return;
+        }
+    }
+
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_ENABLE
+    /* message is not for the scan, pass it to the SDO clients */
+    if (scan->SDOclients != NULL) {
+        uint16_t i;
+        for (i = 0; i < scan->SDOclientsCount; i++) {
+            CO_SDOclient_receiveForward(&scan->SDOclients[i], msg);
+        }
+    }
+#endif
+}
+
+
+/*
+ * Read received Heartbeat or boot-up message from CAN module.
+ *
+ * For description of parameters see CO_nodeScan_receiveSDO().
+ */
+static void CO_nodeScan_receiveHB(void *object, void *msg) {
+    CO_nodeScan_t *scan = (CO_nodeScan_t *)object;
+    uint8_t DLC = CO_CANrxMsg_readDLC(msg);
+    uint8_t *data = CO_CANrxMsg_readData(msg);
+    uint8_t nodeId = (uint8_t)(CO_CANrxMsg_readIdent(msg) & 0x7FU);
+
+    if (scan->running && DLC == 1U && nodeId >= CO_NODE_SCAN_NODE_MIN) {
+        CO_nodeScan_req_t *req = &scan->req[nodeId - 1U];
+
+        req->HBrxState = data[0];
+        CO_FLAG_SET(req->HBrxNew);
+    }
+}
+
+
+/* Enable or disable CAN reception of SDO responses and Heartbeats. Disabled
+ * buffers use CAN-ID 0, which is received by NMT consumer first. */
+static CO_ReturnError_t rxConfigure(CO_nodeScan_t *scan, bool_t enable) {
+    CO_ReturnError_t ret;
+
+    ret = CO_CANrxBufferInit(scan->CANdevRx,
+                             scan->CANdevRxIdxSDO,
+                             enable ? CO_CAN_ID_SDO_SRV : 0U,
+                             enable ? 0x780U : 0x7FFU,
+                             0,
+                             (void *)scan,
+                             CO_nodeScan_receiveSDO);
+    if (ret == CO_ERROR_NO) {
+        ret = CO_CANrxBufferInit(scan->CANdevRx,
+                                 scan->CANdevRxIdxHB,
+                                 enable ? CO_CAN_ID_HEARTBEAT : 0U,
+                                 enable ? 0x780U : 0x7FFU,
+                                 0,
+                                 (void *)scan,
+                                 CO_nodeScan_receiveHB);
+    }
+    return ret;
+}
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_nodeScan_init(CO_nodeScan_t *scan,
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_ENABLE
+                                  CO_HBconsumer_t *HBcons,
+#endif
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_ENABLE
+                                  CO_SDOclient_t *SDOclients,
+                                  uint16_t SDOclientsCount,
+#endif
+                                  CO_CANmodule_t *CANdevRx,
+                                  uint16_t CANdevRxIdxSDO,
+                                  uint16_t CANdevRxIdxHB,
+                                  CO_CANmodule_t *CANdevTx,
+                                  uint16_t CANdevTxIdx)
+{
+    /* verify arguments */
+    if (scan == NULL || CANdevRx == NULL || CANdevTx == NULL) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    memset(scan, 0, sizeof(CO_nodeScan_t));
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_ENABLE
+    scan->HBcons = HBcons;
+ #if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_NODE_INDEXED
+    /* Heartbeat consumer receives all Heartbeats, get the unmonitored ones */
+    CO_HBconsumer_initForward(HBcons, (void *)scan, CO_nodeScan_receiveHB);
+ #endif
+#endif
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_ENABLE
+    scan->SDOclients = SDOclients;
+    scan->SDOclientsCount = SDOclientsCount;
+#endif
+    scan->CANdevRx = CANdevRx;
+    scan->CANdevRxIdxSDO = CANdevRxIdxSDO;
+    scan->CANdevRxIdxHB = CANdevRxIdxHB;
+    scan->CANdevTx = CANdevTx;
+    scan->CANdevTxIdx = CANdevTxIdx;
+
+    /* CAN-ID is set for each request */
+    scan->CANtxBuff = CO_CANtxBufferInit(CANdevTx, CANdevTxIdx,
+                                         CO_CAN_ID_SDO_CLI, 0, 8, 0);
+    if (scan->CANtxBuff == NULL) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    return rxConfigure(scan, false);
+}
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_nodeScan_start(CO_nodeScan_t *scan,
+                                   uint8_t nodeIdFirst,
+                                   uint8_t nodeIdLast,
+                                   uint16_t timeout_ms)
+{
+    uint8_t i;
+
+    if (scan == NULL || nodeIdFirst < CO_NODE_SCAN_NODE_MIN
+        || nodeIdLast > CO_NODE_SCAN_NODE_MAX || nodeIdFirst > nodeIdLast
+        || timeout_ms == 0U
+    ) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    /* disable reception while the tables are cleared */
+    scan->running = false;
+    (void)rxConfigure(scan, false);
+
+    for (i = 0; i < CO_NODE_SCAN_NODE_MAX; i++) {
+        CO_nodeScan_node_t *node = &scan->nodes[i];
+        CO_nodeScan_req_t *req = &scan->req[i];
+        uint8_t nodeId = i + 1U;
+        bool_t scanned = nodeId >= nodeIdFirst && nodeId <= nodeIdLast;
+
+        node->flags = 0;
+        node->NMTstate = CO_NMT_UNKNOWN;
+        memset(node->identity, 0, sizeof(node->identity));
+        req->subIndex = scanned ? 1U : 0U;
+        req->txPending = scanned;
+        req->timer_us = 0;
+        CO_FLAG_CLEAR(req->CANrxNew);
+        CO_FLAG_CLEAR(req->HBrxNew);
+    }
+    scan->nodesFound = 0;
+    scan->nodeIdFirst = nodeIdFirst;
+    scan->nodeIdLast = nodeIdLast;
+    scan->nodeIdTxNext = nodeIdFirst;
+    scan->timeout_us = (uint32_t)timeout_ms * 1000U;
+
+    scan->running = true;
+    if (rxConfigure(scan, true) != CO_ERROR_NO) {
+        scan->running = false;
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    return CO_ERROR_NO;
+}
+
+
+/* Process received SDO response of the node, return true if there is next
+ * sub-index to read. */
+static bool_t responseProcess(CO_nodeScan_node_t *node,
+                              const CO_nodeScan_req_t *req)
+{
+    const uint8_t *data = req->CANrxData;
+    uint8_t cs = data[0];
+    bool_t next = true;
+
+    node->flags |= CO_NODE_SCAN_FLAG_SDO;
+
+    if ((cs & 0xE0U) == SCAN_SCS_UPLOAD_INITIATE
+        && (cs & SCAN_SCS_UPLOAD_EXPEDITED) != 0U
+    ) {
+        /* expedited upload, size indicated or four bytes */
+        uint8_t size = (cs & SCAN_SCS_UPLOAD_SIZE) != 0U
+                     ? (uint8_t)(4U - ((cs >> 2) & 0x03U)) : 4U;
+        uint32_t value = 0;
+        uint8_t i;
+
+        for (i = 0; i < size; i++) {
+            value |= (uint32_t)data[4U + i] << (8U * i);
+        }
+        node->identity[req->subIndex - 1U] = value;
+        node->flags |= (uint8_t)(CO_NODE_SCAN_FLAG_VENDOR_ID
+                                 << (req->subIndex - 1U));
+    }
+    else if (cs != SCAN_CS_ABORT) {
+        /* Segmented upload (or other response) is not continued, SDO server
+         * will time out. Don't send new requests to it meanwhile. */
+        next = false;
+    }
+
+    return next && req->subIndex < SCAN_SUBINDEX_LAST;
+}
+
+
+/* Send pending requests, as long as CAN transmit buffer is free */
+static void requestsSend(CO_nodeScan_t *scan) {
+    uint8_t count = scan->nodeIdLast - scan->nodeIdFirst + 1U;
+    uint8_t nodeId = scan->nodeIdTxNext;
+
+    while (count-- > 0U && !scan->CANtxBuff->bufferFull) {
+        CO_nodeScan_req_t *req = &scan->req[nodeId - 1U];
+
+        if (req->txPending) {
+            uint8_t *data;
+
+            scan->CANtxBuff = CO_CANtxBufferInit(scan->CANdevTx,
+                                                 scan->CANdevTxIdx,
+                                                 CO_CAN_ID_SDO_CLI + nodeId,
+                                                 0, 8, 0);
+            data = scan->CANtxBuff->data;
+            data[0] = SCAN_CCS_UPLOAD_INITIATE;
+            data[1] = (uint8_t)SCAN_INDEX;
+            data[2] = (uint8_t)(SCAN_INDEX >> 8);
+            data[3] = req->subIndex;
+            memset(&data[4], 0, 4);
+
+            req->timer_us = 0;
+            req->txPending = false;
+            if (CO_CANsend(scan->CANdevTx, scan->CANtxBuff) != CO_ERROR_NO) {
+                /* request is sent later by the driver or again */
+                req->txPending = !scan->CANtxBuff->bufferFull;
+            }
+        }
+
+        nodeId = nodeId < scan->nodeIdLast ? nodeId + 1U : scan->nodeIdFirst;
+    }
+    scan->nodeIdTxNext = nodeId;
+}
+
+
+/* Add nodes from Heartbeat consumer and count found nodes */
+static void scanFinish(CO_nodeScan_t *scan) {
+    uint8_t i;
+
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_ENABLE
+    if (scan->HBcons != NULL) {
+        for (i = 0; i < scan->HBcons->numberOfMonitoredNodes; i++) {
+            CO_HBconsNode_t *monitoredNode = &scan->HBcons->monitoredNodes[i];
+            uint8_t nodeId = monitoredNode->nodeId;
+            CO_nodeScan_node_t *node;
+
+            if (nodeId < scan->nodeIdFirst || nodeId > scan->nodeIdLast
+                || monitoredNode->HBstate == CO_HBconsumer_UNCONFIGURED
+            ) {
+                continue;
+            }
+            node = &scan->nodes[nodeId - 1U];
+            if (monitoredNode->HBstate == CO_HBconsumer_ACTIVE) {
+                node->flags |= CO_NODE_SCAN_FLAG_HB;
+                node->NMTstate = monitoredNode->NMTstate;
+            }
+            else if (monitoredNode->NMTstate == CO_NMT_INITIALIZING) {
+                node->flags |= CO_NODE_SCAN_FLAG_BOOTUP;
+                node->NMTstate = CO_NMT_INITIALIZING;
+            }
+        }
+    }
+#endif
+
+    scan->nodesFound = 0;
+    for (i = 0; i < CO_NODE_SCAN_NODE_MAX; i++) {
+        if (scan->nodes[i].flags != 0U) {
+            scan->nodesFound++;
+        }
+    }
+}
+
+
+/******************************************************************************/
+bool_t CO_nodeScan_process(CO_nodeScan_t *scan,
+                           uint32_t timeDifference_us,
+                           uint32_t *timerNext_us)
+{
+    bool_t active = false;
+    uint8_t nodeId;
+
+    (void)timerNext_us; /* may be unused */
+
+    if (scan == NULL || !scan->running) {
+        return false;
+    }
+
+    for (nodeId = scan->nodeIdFirst; nodeId <= scan->nodeIdLast; nodeId++) {
+        CO_nodeScan_node_t *node = &scan->nodes[nodeId - 1U];
+        CO_nodeScan_req_t *req = &scan->req[nodeId - 1U];
+
+        if (CO_FLAG_READ(req->HBrxNew)) {
+            CO_NMT_internalState_t state =
+                (CO_NMT_internalState_t)req->HBrxState;
+
+            node->flags |= state == CO_NMT_INITIALIZING
+                         ? CO_NODE_SCAN_FLAG_BOOTUP : CO_NODE_SCAN_FLAG_HB;
+            node->NMTstate = state;
+            CO_FLAG_CLEAR(req->HBrxNew);
+        }
+
+        if (req->subIndex == 0U || req->txPending) {
+            active |= req->subIndex != 0U;
+            continue;
+        }
+
+        if (CO_FLAG_READ(req->CANrxNew)) {
+            if (responseProcess(node, req)) {
+                req->subIndex++;
+                req->txPending = true;
+            }
+            else {
+                req->subIndex = 0;
+            }
+            CO_FLAG_CLEAR(req->CANrxNew);
+        }
+        else {
+            req->timer_us += timeDifference_us;
+            if (req->timer_us >= scan->timeout_us) {
+                /* node is absent or doesn't have the sub-index */
+                req->subIndex = 0;
+            }
+#if (CO_CONFIG_NODE_SCAN) & CO_CONFIG_FLAG_TIMERNEXT
+            else if (timerNext_us != NULL) {
+                uint32_t diff = scan->timeout_us - req->timer_us;
+                if (*timerNext_us > diff) {
+                    *timerNext_us = diff;
+                }
+            }
+#endif
+        }
+        active |= req->subIndex != 0U;
+    }
+
+    if (active) {
+        requestsSend(scan);
+    }
+    else {
+        scan->running = false;
+        (void)rxConfigure(scan, false);
+        scanFinish(scan);
+    }
+
+    return active;
+}
+
+
+/******************************************************************************/
+void CO_nodeScan_stop(CO_nodeScan_t *scan) {
+    if (scan == NULL || !scan->running) {
+        return;
+    }
+
+    scan->running = false;
+    (void)rxConfigure(scan, false);
+    scanFinish(scan);
+}
+
+#endif /* (CO_CONFIG_NODE_SCAN) & CO_CONFIG_NODE_SCAN_ENABLE */
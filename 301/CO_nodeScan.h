@@ -0,0 +1,286 @@
+/**
+ * CANopen network scan, non-standard.
+ *
+ * @file        CO_nodeScan.h
+ * @ingroup     CO_nodeScan
+ * @author      J-Weisberg
+ * @copyright   2026 J-Weisberg
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CO_NODE_SCAN_H
+#define CO_NODE_SCAN_H
+
+#include "301/CO_driver.h"
+#include "301/CO_NMT_Heartbeat.h"
+#include "301/CO_HBconsumer.h"
+#include "301/CO_SDOclient.h"
+
+/* default configuration, see CO_config.h */
+#ifndef CO_CONFIG_NODE_SCAN
+#define CO_CONFIG_NODE_SCAN (0)
+#endif
+
+#if ((CO_CONFIG_NODE_SCAN) & CO_CONFIG_NODE_SCAN_ENABLE) || defined CO_DOXYGEN
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup CO_nodeScan Network scan
+ * CANopen network scan, non-standard.
+ *
+ * @ingroup CO_CANopen_301
+ * @{
+ * Network scan finds all nodes on the CANopen network and reads their identity
+ * (OD object 0x1018, sub-indexes 1 to 4: vendor-ID, product code, revision
+ * number and serial number).
+ *
+ * Scan sends SDO expedited upload request for 0x1018,1 to all candidate nodes
+ * at once, as fast as CAN transmit buffer allows. Each node, which responds,
+ * gets the request for the next sub-index immediately. Nodes, which don't
+ * respond within timeout, are treated as absent. So complete scan takes about
+ * one SDO timeout, not one timeout for each absent node, as with sequential
+ * SDO client requests.
+ *
+ * During the scan also Heartbeat and boot-up messages of all nodes are
+ * observed. Nodes monitored by @ref CO_HBconsumer are added from its state.
+ * Node, which sends only Heartbeat, is also included in the node table, but
+ * without identity.
+ * With @ref CO_CONFIG_HB_CONS_NODE_INDEXED Heartbeat consumer receives all
+ * Heartbeats and passes the messages from not monitored nodes to the scan, see
+ * CO_HBconsumer_initForward().
+ *
+ * Scan uses own CAN receive buffer for all SDO server responses (CAN-IDs
+ * 0x581 to 0x5FF). It must be placed before the buffers of SDO clients, so it
+ * receives responses also for nodes, which SDO clients are configured for.
+ * Messages, which are not responses to the scan requests, are passed to the
+ * SDO clients with CO_SDOclient_receiveForward(), so SDO clients may
+ * communicate during the scan. Scan only reads remote objects, SDO servers of
+ * the scanned nodes don't need any configuration.
+ *
+ * Scan is started by CO_nodeScan_start() and must then be processed
+ * cyclically by CO_nodeScan_process() until it returns false. Results are in
+ * the nodes array of @ref CO_nodeScan_t.
+ */
+
+/** Node ID of the first node, which can be scanned */
+#define CO_NODE_SCAN_NODE_MIN 1U
+/** Node ID of the last node, which can be scanned */
+#define CO_NODE_SCAN_NODE_MAX 127U
+
+/**
+ * Flags in @ref CO_nodeScan_node_t, which indicate, how node was discovered
+ * and which identity values are valid.
+ */
+typedef enum {
+    /** Node responded to SDO request */
+    CO_NODE_SCAN_FLAG_SDO = 0x01U,
+    /** Heartbeat of the node was received */
+    CO_NODE_SCAN_FLAG_HB = 0x02U,
+    /** Boot-up message of the node was received */
+    CO_NODE_SCAN_FLAG_BOOTUP = 0x04U,
+    /** Vendor-ID (0x1018,1) is valid */
+    CO_NODE_SCAN_FLAG_VENDOR_ID = 0x10U,
+    /** Product code (0x1018,2) is valid */
+    CO_NODE_SCAN_FLAG_PRODUCT_CODE = 0x20U,
+    /** Revision number (0x1018,3) is valid */
+    CO_NODE_SCAN_FLAG_REVISION_NUMBER = 0x40U,
+    /** Serial number (0x1018,4) is valid */
+    CO_NODE_SCAN_FLAG_SERIAL_NUMBER = 0x80U
+} CO_nodeScan_flag_t;
+
+
+/**
+ * One node in the node table of the @ref CO_nodeScan_t.
+ */
+typedef struct {
+    /** Combination of @ref CO_nodeScan_flag_t, 0 if node was not found */
+    uint8_t flags;
+    /** NMT state from the last Heartbeat, CO_NMT_UNKNOWN if not received */
+    CO_NMT_internalState_t NMTstate;
+    /** Identity object 0x1018, sub-indexes 1 to 4: vendor-ID, product code,
+     * revision number and serial number. Valid, if corresponding flag is set */
+    uint32_t identity[4];
+} CO_nodeScan_node_t;
+
+
+/**
+ * Scan state of one node inside @ref CO_nodeScan_t.
+ */
+typedef struct {
+    /** Sub-index of 0x1018, which is requested from the node, 0 if node is
+     * finished */
+    uint8_t subIndex;
+    /** True, if request for subIndex has to be sent */
+    bool_t txPending;
+    /** Time since the request was sent, in microseconds */
+    uint32_t timer_us;
+    /** Indication if new SDO response is received from CAN bus. */
+    volatile void *CANrxNew;
+    /** 8 data bytes of the received SDO response */
+    uint8_t CANrxData[8];
+    /** Indication if new Heartbeat or boot-up is received from CAN bus. */
+    volatile void *HBrxNew;
+    /** NMT state from received Heartbeat or boot-up */
+    uint8_t HBrxState;
+} CO_nodeScan_req_t;
+
+
+/**
+ * Network scan object.
+ */
+typedef struct {
+    /** Node table, index is node ID - 1. Valid after scan is finished. */
+    CO_nodeScan_node_t nodes[CO_NODE_SCAN_NODE_MAX];
+    /** Number of found nodes in the last scan */
+    uint8_t nodesFound;
+    /** Scan state of each node, index is node ID - 1 */
+    CO_nodeScan_req_t req[CO_NODE_SCAN_NODE_MAX];
+    /** True, if scan is in progress */
+    bool_t running;
+    /** Node ID of the first scanned node, from CO_nodeScan_start() */
+    uint8_t nodeIdFirst;
+    /** Node ID of the last scanned node, from CO_nodeScan_start() */
+    uint8_t nodeIdLast;
+    /** Node ID, where sending of the requests continues */
+    uint8_t nodeIdTxNext;
+    /** SDO response timeout in microseconds, from CO_nodeScan_start() */
+    uint32_t timeout_us;
+#if ((CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_ENABLE) || defined CO_DOXYGEN
+    /** From CO_nodeScan_init(), may be NULL */
+    CO_HBconsumer_t *HBcons;
+#endif
+#if ((CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_ENABLE) || defined CO_DOXYGEN
+    /** From CO_nodeScan_init(), may be NULL */
+    CO_SDOclient_t *SDOclients;
+    /** From CO_nodeScan_init() */
+    uint16_t SDOclientsCount;
+#endif
+    /** From CO_nodeScan_init() */
+    CO_CANmodule_t *CANdevRx;
+    /** From CO_nodeScan_init() */
+    uint16_t CANdevRxIdxSDO;
+    /** From CO_nodeScan_init() */
+    uint16_t CANdevRxIdxHB;
+    /** From CO_nodeScan_init() */
+    CO_CANmodule_t *CANdevTx;
+    /** From CO_nodeScan_init() */
+    uint16_t CANdevTxIdx;
+    /** CAN transmit buffer for SDO requests */
+    CO_CANtx_t *CANtxBuff;
+} CO_nodeScan_t;
+
+
+/**
+ * Initialize network scan object.
+ *
+ * Function must be called in the communication reset section. CAN receive
+ * buffers are disabled until scan is started.
+ *
+ * @param scan This object will be initialized.
+ * @param HBcons Heartbeat consumer object, its monitored nodes are added to
+ * the node table. May be NULL. With @ref CO_CONFIG_HB_CONS_NODE_INDEXED it must
+ * be initialized before, scan registers CO_HBconsumer_initForward() there.
+ * @param SDOclients Array of SDO client objects, which get the SDO responses
+ * not used by the scan. May be NULL.
+ * @param SDOclientsCount Number of elements in SDOclients array.
+ * @param CANdevRx CAN device for SDO response, Heartbeat and boot-up reception.
+ * @param CANdevRxIdxSDO Index of receive buffer for SDO responses in the above
+ * CAN device. It must be smaller than indexes of SDO clients.
+ * @param CANdevRxIdxHB Index of receive buffer for Heartbeat and boot-up in
+ * the above CAN device. It must be larger than indexes of Heartbeat consumer.
+ * @param CANdevTx CAN device for SDO request transmission.
+ * @param CANdevTxIdx Index of transmit buffer in the above CAN device.
+ *
+ * @return #CO_ReturnError_t: CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT.
+ */
+CO_ReturnError_t CO_nodeScan_init(CO_nodeScan_t *scan,
+#if ((CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_ENABLE) || defined CO_DOXYGEN
+                                  CO_HBconsumer_t *HBcons,
+#endif
+#if ((CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_ENABLE) || defined CO_DOXYGEN
+                                  CO_SDOclient_t *SDOclients,
+                                  uint16_t SDOclientsCount,
+#endif
+                                  CO_CANmodule_t *CANdevRx,
+                                  uint16_t CANdevRxIdxSDO,
+                                  uint16_t CANdevRxIdxHB,
+                                  CO_CANmodule_t *CANdevTx,
+                                  uint16_t CANdevTxIdx);
+
+
+/**
+ * Start network scan.
+ *
+ * Node table from the previous scan is cleared. Scan may be restarted, while
+ * it is in progress.
+ *
+ * @param scan This object.
+ * @param nodeIdFirst Node ID of the first scanned node, 1 to 127.
+ * @param nodeIdLast Node ID of the last scanned node, nodeIdFirst to 127.
+ * @param timeout_ms SDO response timeout in milliseconds. Node, which doesn't
+ * respond within this time, is treated as absent.
+ *
+ * @return #CO_ReturnError_t: CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT.
+ */
+CO_ReturnError_t CO_nodeScan_start(CO_nodeScan_t *scan,
+                                   uint8_t nodeIdFirst,
+                                   uint8_t nodeIdLast,
+                                   uint16_t timeout_ms);
+
+
+/**
+ * Process network scan.
+ *
+ * Function must be called cyclically after CO_nodeScan_start(). It processes
+ * received responses and sends new requests. When all nodes are finished, it
+ * adds nodes from Heartbeat consumer, disables CAN reception and returns
+ * false.
+ *
+ * @param scan This object.
+ * @param timeDifference_us Time difference from previous function call.
+ * @param [out] timerNext_us info to OS - see CO_process().
+ *
+ * @return True, if scan is in progress, false if finished or not started.
+ */
+bool_t CO_nodeScan_process(CO_nodeScan_t *scan,
+                           uint32_t timeDifference_us,
+                           uint32_t *timerNext_us);
+
+
+/**
+ * Stop network scan, which is in progress.
+ *
+ * Node table contains nodes found so far. Function may be called any time.
+ *
+ * @param scan This object.
+ */
+void CO_nodeScan_stop(CO_nodeScan_t *scan);
+
+
+/** @} */ /* CO_nodeScan */
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+
+#endif /* (CO_CONFIG_NODE_SCAN) & CO_CONFIG_NODE_SCAN_ENABLE */
+
+#endif /* CO_NODE_SCAN_H */
@@ -0,0 +1,566 @@
+/*
+ * CANopen LSS batch commissioning, non-standard.
+ *
+ * @file        CO_LSScommission.c
+ * @ingroup     CO_LSScommission
+ * @author      J-Weisberg
+ * @copyright   2026 J-Weisberg
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string.h>
+
+#include "305/CO_LSScommission.h"
+
+#if (CO_CONFIG_LSS_COMM) & CO_CONFIG_LSS_COMM_ENABLE
+
+/*
+ * Steps of the commissioning state machine
+ */
+typedef enum {
+    CO_LSScomm_STEP_SELECT,
+    CO_LSScomm_STEP_FASTSCAN,
+    CO_LSScomm_STEP_NODE_ID,
+    CO_LSScomm_STEP_STORE,
+    CO_LSScomm_STEP_END
+} CO_LSScomm_step_t;
+
+
+static bool_t nodeIdIsSet(const uint32_t *map, uint8_t nodeId) {
+    return (map[nodeId >> 5] & ((uint32_t)1U << (nodeId & 0x1FU))) != 0;
+}
+
+static void nodeIdSet(uint32_t *map, uint8_t nodeId) {
+    map[nodeId >> 5] |= (uint32_t)1U << (nodeId & 0x1FU);
+}
+
+
+/* Lowest free node-ID from the range or 0 */
+static uint8_t nodeIdAssign(CO_LSScomm_t *comm) {
+    for (uint8_t id = comm->nodeIdFirst; id <= comm->nodeIdLast; id++) {
+        if (!nodeIdIsSet(comm->nodeIdUsed, id)) {
+            nodeIdSet(comm->nodeIdUsed, id);
+            return id;
+        }
+    }
+    return 0;
+}
+
+
+/* Set LSS timeout, limited by minimum and maximum */
+static void timeoutSet(CO_LSScomm_t *comm, uint32_t timeout_us) {
+    if (timeout_us < comm->timeoutMin_us) {
+        timeout_us = comm->timeoutMin_us;
+    }
+    if (timeout_us > comm->timeoutMax_us) {
+        timeout_us = comm->timeoutMax_us;
+    }
+    comm->timeout_us = timeout_us;
+    comm->LSSmaster->timeout_us = timeout_us;
+}
+
+
+/* Timeout from the measured round trip time */
+static void timeoutBase(CO_LSScomm_t *comm) {
+    timeoutSet(comm, comm->rttMax_us * CO_LSS_COMM_RTT_FACTOR);
+}
+
+
+/* Confirmation of the current step is received, measure round trip time */
+static void timeoutAdapt(CO_LSScomm_t *comm) {
+    uint32_t rtt = comm->stepTimer_us;
+
+    if (rtt > comm->rttMax_us) {
+        comm->rttMax_us = rtt;
+    }
+    comm->rttSum_us += rtt;
+    comm->rttCount++;
+    timeoutBase(comm);
+}
+
+
+/* Current step is not confirmed. Double the timeout or use one of the retries
+ * with maximum timeout. Return false, if step must not be repeated. Timeout
+ * is reduced back after the step. */
+static bool_t timeoutBackoff(CO_LSScomm_t *comm) {
+    comm->timeouts++;
+    if (comm->timeout_us < comm->timeoutMax_us) {
+        timeoutSet(comm, comm->timeout_us * 2U);
+        return true;
+    }
+    if (comm->retriesLeft > 0) {
+        comm->retriesLeft--;
+        return true;
+    }
+    return false;
+}
+
+
+/* Start the next step of the current node */
+static void stepNext(CO_LSScomm_t *comm, CO_LSScomm_step_t step) {
+    comm->step = (uint8_t)step;
+    comm->stepStarted = false;
+}
+
+
+/* Next fastscans search only for nodes after the address. Nodes before it are
+ * already configured or have failed, unless fastscan predicted a value. */
+static void fastscanSkip(CO_LSScomm_t *comm, const CO_LSS_address_t *address) {
+    if (!comm->fastscanAfterValid) {
+        comm->fastscanAfterValid = true;
+        comm->fastscanAfterDone = comm->nodesDone;
+    }
+    comm->fastscanAfter = *address;
+}
+
+
+/* Finish the current node and deselect it */
+static void nodeEnd(CO_LSScomm_t *comm, CO_LSScomm_result_t result) {
+    CO_LSScomm_node_t *node = &comm->nodes[comm->nodeIndex];
+
+    node->result = result;
+    node->time_us = comm->time_us - comm->nodeStart_us;
+    if (result == CO_LSScomm_NODE_DONE) {
+        comm->nodesDone++;
+    }
+    else if (comm->nodeFastscan) {
+        /* node found by fastscan remains unconfigured, skip it next time */
+        fastscanSkip(comm, &node->address);
+    }
+    (void)CO_LSSmaster_switchStateDeselect(comm->LSSmaster);
+
+    if (comm->pFunctNode != NULL) {
+        comm->pFunctNode(comm->functNodeObject, node);
+    }
+}
+
+
+/* Select the next listed node or start the next fastscan */
+static void nodeNext(CO_LSScomm_t *comm) {
+    comm->nodeStart_us = comm->time_us;
+    comm->retriesLeft = comm->retries;
+    comm->nodeFastscan = false;
+    timeoutBase(comm);
+
+    if (comm->listIndex < comm->nodesListed) {
+        comm->nodeIndex = comm->listIndex++;
+        stepNext(comm, CO_LSScomm_STEP_SELECT);
+    }
+    else if ((comm->flags & CO_LSS_COMM_FLAG_FASTSCAN) != 0
+             && !comm->aborted
+    ) {
+        stepNext(comm, CO_LSScomm_STEP_FASTSCAN);
+    }
+    else {
+        stepNext(comm, CO_LSScomm_STEP_END);
+    }
+}
+
+
+/* Fastscan selected a node, find it in the table or add it */
+static void fastscanFound(CO_LSScomm_t *comm) {
+    const CO_LSS_address_t *found = &comm->fastscan.found;
+    CO_LSScomm_node_t *node = NULL;
+    uint8_t i;
+
+    for (i = 0; i < comm->nodesCount; i++) {
+        if (CO_LSS_ADDRESS_EQUAL(comm->nodes[i].address, (*found))) {
+            node = &comm->nodes[i];
+            break;
+        }
+    }
+    if (node == NULL) {
+        if (comm->nodesCount >= CO_LSS_COMM_NODES_MAX) {
+            (void)CO_LSSmaster_switchStateDeselect(comm->LSSmaster);
+            comm->aborted = true;
+            stepNext(comm, CO_LSScomm_STEP_END);
+            return;
+        }
+        i = comm->nodesCount++;
+        node = &comm->nodes[i];
+        memset(node, 0, sizeof(*node));
+        node->address = *found;
+    }
+    else if (node->result != CO_LSScomm_NODE_PENDING
+             && node->result != CO_LSScomm_NODE_NOT_FOUND
+    ) {
+        /* node has already failed, its result is kept, look for the others */
+        (void)CO_LSSmaster_switchStateDeselect(comm->LSSmaster);
+        fastscanSkip(comm, found);
+        nodeNext(comm);
+        return;
+    }
+
+    comm->nodeIndex = i;
+    comm->nodeFastscan = true;
+    comm->retriesLeft = comm->retries;
+    if (node->nodeId == 0) {
+        node->nodeId = nodeIdAssign(comm);
+    }
+    if (node->nodeId == 0) {
+        nodeEnd(comm, CO_LSScomm_NODE_NO_ID);
+        comm->aborted = true;
+        nodeNext(comm);
+    }
+    else {
+        stepNext(comm, CO_LSScomm_STEP_NODE_ID);
+    }
+}
+
+
+/* Call LSS master function for the current step */
+static CO_LSSmaster_return_t stepRun(CO_LSScomm_t *comm,
+                                     uint32_t timeDifference_us)
+{
+    CO_LSScomm_node_t *node = &comm->nodes[comm->nodeIndex];
+
+    switch (comm->step) {
+    case CO_LSScomm_STEP_SELECT:
+        return CO_LSSmaster_switchStateSelect(comm->LSSmaster,
+                                              timeDifference_us,
+                                              &node->address);
+    case CO_LSScomm_STEP_FASTSCAN:
+        return CO_LSSmaster_IdentifyFastscanAfter(comm->LSSmaster,
+                   timeDifference_us, &comm->fastscan,
+                   comm->fastscanAfterValid ? &comm->fastscanAfter : NULL);
+    case CO_LSScomm_STEP_NODE_ID:
+        return CO_LSSmaster_configureNodeId(comm->LSSmaster,
+                                            timeDifference_us, node->nodeId);
+    case CO_LSScomm_STEP_STORE:
+        return CO_LSSmaster_configureStore(comm->LSSmaster,
+                                           timeDifference_us);
+    default:
+        return CO_LSSmaster_INVALID_STATE;
+    }
+}
+
+
+/* Evaluate finished step and set the next one */
+static void stepResult(CO_LSScomm_t *comm, CO_LSSmaster_return_t ret) {
+    CO_LSScomm_node_t *node = &comm->nodes[comm->nodeIndex];
+
+    switch (comm->step) {
+    case CO_LSScomm_STEP_SELECT:
+        if (ret == CO_LSSmaster_OK) {
+            timeoutAdapt(comm);
+            if (node->nodeId == 0) {
+                node->nodeId = nodeIdAssign(comm);
+            }
+            if (node->nodeId != 0) {
+                stepNext(comm, CO_LSScomm_STEP_NODE_ID);
+                return;
+            }
+            nodeEnd(comm, CO_LSScomm_NODE_NO_ID);
+        }
+        else if (ret == CO_LSSmaster_TIMEOUT && timeoutBackoff(comm)) {
+            comm->stepStarted = false;
+            return;
+        }
+        else {
+            nodeEnd(comm, CO_LSScomm_NODE_NOT_FOUND);
+        }
+        break;
+
+    case CO_LSScomm_STEP_FASTSCAN:
+        if (ret == CO_LSSmaster_SCAN_FINISHED) {
+            timeoutBase(comm);
+            fastscanFound(comm);
+            return;
+        }
+        if (ret == CO_LSSmaster_SCAN_NOACK) {
+            if (comm->timeout_us >= comm->timeoutMax_us
+                && comm->fastscanAfterValid
+                && comm->fastscanAfterDone != comm->nodesDone
+            ) {
+                /* Nodes were configured after the first skipped node. There
+                 * may be nodes before it, which were passed by prediction. */
+                comm->fastscanAfterValid = false;
+                timeoutBase(comm);
+                comm->stepStarted = false;
+            }
+            else if (comm->timeout_us >= comm->timeoutMax_us) {
+                /* no more unconfigured nodes */
+                stepNext(comm, CO_LSScomm_STEP_END);
+            }
+            else {
+                /* some nodes may respond too late, look again */
+                (void)timeoutBackoff(comm);
+                comm->stepStarted = false;
+            }
+            return;
+        }
+        if (ret == CO_LSSmaster_SCAN_FAILED && timeoutBackoff(comm)) {
+            comm->stepStarted = false;
+            return;
+        }
+        (void)CO_LSSmaster_switchStateDeselect(comm->LSSmaster);
+        comm->aborted = true;
+        stepNext(comm, CO_LSScomm_STEP_END);
+        return;
+
+    case CO_LSScomm_STEP_NODE_ID:
+    case CO_LSScomm_STEP_STORE:
+        if (ret == CO_LSSmaster_OK) {
+            timeoutAdapt(comm);
+            if (comm->step == CO_LSScomm_STEP_NODE_ID
+                && (comm->flags & CO_LSS_COMM_FLAG_STORE) != 0
+            ) {
+                stepNext(comm, CO_LSScomm_STEP_STORE);
+                return;
+            }
+            nodeEnd(comm, CO_LSScomm_NODE_DONE);
+        }
+        else if (ret == CO_LSSmaster_TIMEOUT && timeoutBackoff(comm)) {
+            comm->stepStarted = false;
+            return;
+        }
+        else if (ret == CO_LSSmaster_OK_ILLEGAL_ARGUMENT
+                 || ret == CO_LSSmaster_OK_MANUFACTURER
+        ) {
+            nodeEnd(comm, comm->step == CO_LSScomm_STEP_NODE_ID
+                          ? CO_LSScomm_NODE_REJECTED
+                          : CO_LSScomm_NODE_STORE_FAILED);
+        }
+        else {
+            nodeEnd(comm, CO_LSScomm_NODE_TIMEOUT);
+        }
+        break;
+
+    default:
+        return;
+    }
+
+    nodeNext(comm);
+}
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_LSScomm_init(CO_LSScomm_t *comm,
+                                 CO_LSSmaster_t *LSSmaster)
+{
+    /* verify arguments */
+    if (comm == NULL || LSSmaster == NULL) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    memset(comm, 0, sizeof(CO_LSScomm_t));
+    comm->LSSmaster = LSSmaster;
+    comm->state = CO_LSScomm_IDLE;
+    comm->step = CO_LSScomm_STEP_END;
+    comm->fastscan.scan[CO_LSS_FASTSCAN_VENDOR_ID] = CO_LSSmaster_FS_SCAN;
+    comm->fastscan.scan[CO_LSS_FASTSCAN_PRODUCT] = CO_LSSmaster_FS_SCAN;
+    comm->fastscan.scan[CO_LSS_FASTSCAN_REV] = CO_LSSmaster_FS_SCAN;
+    comm->fastscan.scan[CO_LSS_FASTSCAN_SERIAL] = CO_LSSmaster_FS_SCAN;
+
+    return CO_ERROR_NO;
+}
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_LSScomm_addNode(CO_LSScomm_t *comm,
+                                    const CO_LSS_address_t *address,
+                                    uint8_t nodeId)
+{
+    /* verify arguments */
+    if (comm == NULL || address == NULL || nodeId > 127U
+        || comm->state == CO_LSScomm_BUSY
+        || (nodeId != 0 && nodeIdIsSet(comm->nodeIdReserved, nodeId))
+    ) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+    for (uint8_t i = 0; i < comm->nodesListed; i++) {
+        if (CO_LSS_ADDRESS_EQUAL(comm->nodes[i].address, (*address))) {
+            return CO_ERROR_ILLEGAL_ARGUMENT;
+        }
+    }
+    if (comm->nodesListed >= CO_LSS_COMM_NODES_MAX) {
+        return CO_ERROR_OUT_OF_MEMORY;
+    }
+
+    CO_LSScomm_node_t *node = &comm->nodes[comm->nodesListed++];
+    memset(node, 0, sizeof(*node));
+    node->address = *address;
+    node->nodeId = nodeId;
+    node->listed = true;
+    node->nodeIdFixed = nodeId != 0;
+    if (nodeId != 0) {
+        nodeIdSet(comm->nodeIdReserved, nodeId);
+    }
+    comm->nodesCount = comm->nodesListed;
+
+    return CO_ERROR_NO;
+}
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_LSScomm_reserveNodeId(CO_LSScomm_t *comm, uint8_t nodeId) {
+    if (comm == NULL || nodeId < 1U || nodeId > 127U
+        || comm->state == CO_LSScomm_BUSY
+    ) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    nodeIdSet(comm->nodeIdReserved, nodeId);
+    return CO_ERROR_NO;
+}
+
+
+/******************************************************************************/
+void CO_LSScomm_initCallbackNode(
+        CO_LSScomm_t           *comm,
+        void                   *object,
+        void                  (*pFunctNode)(void *object,
+                                            const CO_LSScomm_node_t *node))
+{
+    if (comm != NULL) {
+        comm->functNodeObject = object;
+        comm->pFunctNode = pFunctNode;
+    }
+}
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_LSScomm_start(CO_LSScomm_t *comm,
+                                  uint8_t flags,
+                                  uint8_t nodeIdFirst,
+                                  uint8_t nodeIdLast,
+                                  uint16_t timeoutMin_ms,
+                                  uint16_t timeoutMax_ms,
+                                  uint8_t retries)
+{
+    /* verify arguments */
+    if (comm == NULL || nodeIdFirst < 1U || nodeIdFirst > nodeIdLast
+        || nodeIdLast > 127U || timeoutMin_ms == 0
+        || timeoutMin_ms > timeoutMax_ms
+    ) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    /* keep only listed nodes, release node-IDs assigned from the range */
+    comm->nodesCount = comm->nodesListed;
+    for (uint8_t i = 0; i < comm->nodesListed; i++) {
+        CO_LSScomm_node_t *node = &comm->nodes[i];
+
+        node->result = CO_LSScomm_NODE_PENDING;
+        node->time_us = 0;
+        if (!node->nodeIdFixed) {
+            node->nodeId = 0;
+        }
+    }
+    memcpy(comm->nodeIdUsed, comm->nodeIdReserved, sizeof(comm->nodeIdUsed));
+
+    comm->flags = flags;
+    comm->nodeIdFirst = nodeIdFirst;
+    comm->nodeIdLast = nodeIdLast;
+    comm->retries = retries;
+    comm->timeoutMin_us = (uint32_t)timeoutMin_ms * 1000U;
+    comm->timeoutMax_us = (uint32_t)timeoutMax_ms * 1000U;
+    if (comm->state != CO_LSScomm_BUSY) {
+        comm->timeoutOrig_us = comm->LSSmaster->timeout_us;
+    }
+    comm->nodesDone = 0;
+    comm->listIndex = 0;
+    comm->aborted = false;
+    comm->fastscanAfterValid = false;
+    comm->time_us = 0;
+    comm->timeouts = 0;
+    comm->fastscans = 0;
+
+    (void)CO_LSSmaster_switchStateDeselect(comm->LSSmaster);
+    nodeNext(comm);
+    comm->state = CO_LSScomm_BUSY;
+
+    return CO_ERROR_NO;
+}
+
+
+/******************************************************************************/
+CO_LSScomm_return_t CO_LSScomm_process(CO_LSScomm_t *comm,
+                                       uint32_t timeDifference_us,
+                                       uint32_t *timerNext_us)
+{
+    bool_t waited = false;
+
+    (void)timerNext_us; /* may be unused */
+
+    if (comm == NULL) {
+        return CO_LSScomm_IDLE;
+    }
+    if (comm->state != CO_LSScomm_BUSY) {
+        return comm->state;
+    }
+    comm->time_us += timeDifference_us;
+
+    /* Steps are chained: when one is finished, the next one is initiated
+     * immediately. LSS master has a single response buffer, so only one
+     * confirmed service may be pending. */
+    while (comm->step != CO_LSScomm_STEP_END) {
+        CO_LSSmaster_return_t ret;
+
+        if (!comm->stepStarted) {
+            comm->stepStarted = true;
+            comm->stepTimer_us = 0;
+            if (comm->step == CO_LSScomm_STEP_FASTSCAN) {
+                comm->fastscans++;
+            }
+            ret = stepRun(comm, 0);
+        }
+        else if (!waited) {
+            waited = true;
+            comm->stepTimer_us += timeDifference_us;
+            ret = stepRun(comm, timeDifference_us);
+        }
+        else {
+            break;
+        }
+
+        if (ret == CO_LSSmaster_WAIT_SLAVE) {
+            break;
+        }
+        if (ret == CO_LSSmaster_ILLEGAL_ARGUMENT
+            || ret == CO_LSSmaster_INVALID_STATE
+        ) {
+            /* LSS master is used by someone else */
+            (void)CO_LSSmaster_switchStateDeselect(comm->LSSmaster);
+            comm->aborted = true;
+            stepNext(comm, CO_LSScomm_STEP_END);
+            break;
+        }
+        stepResult(comm, ret);
+    }
+
+    if (comm->step == CO_LSScomm_STEP_END) {
+        comm->LSSmaster->timeout_us = comm->timeoutOrig_us;
+        comm->state = (comm->nodesDone == comm->nodesCount && !comm->aborted)
+                    ? CO_LSScomm_DONE : CO_LSScomm_ERROR;
+    }
+#if (CO_CONFIG_LSS_COMM) & CO_CONFIG_FLAG_TIMERNEXT
+    else if (timerNext_us != NULL
+             && comm->LSSmaster->timeoutTimer < comm->timeout_us
+    ) {
+        uint32_t diff = comm->timeout_us - comm->LSSmaster->timeoutTimer;
+        if (*timerNext_us > diff) {
+            *timerNext_us = diff;
+        }
+    }
+#endif
+
+    return comm->state;
+}
+
+#endif /* (CO_CONFIG_LSS_COMM) & CO_CONFIG_LSS_COMM_ENABLE */
@@ -0,0 +1,371 @@
+/**
+ * CANopen LSS batch commissioning, non-standard.
+ *
+ * @file        CO_LSScommission.h
+ * @ingroup     CO_LSScommission
+ * @author      J-Weisberg
+ * @copyright   2026 J-Weisberg
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CO_LSS_COMMISSION_H
+#define CO_LSS_COMMISSION_H
+
+#include "305/CO_LSSmaster.h"
+
+/* default configuration, see CO_config.h */
+#ifndef CO_CONFIG_LSS_COMM
+#define CO_CONFIG_LSS_COMM (0)
+#endif
+
+#if ((CO_CONFIG_LSS_COMM) & CO_CONFIG_LSS_COMM_ENABLE) || defined CO_DOXYGEN
+
+#if !((CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER) && !defined CO_DOXYGEN
+#error CO_CONFIG_LSS_MASTER must be enabled for LSS batch commissioning!
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup CO_LSScommission LSS batch commissioning
+ * CANopen LSS master batch commissioning, non-standard.
+ *
+ * @ingroup CO_CANopen_305
+ * @{
+ * LSS batch commissioning assigns node-IDs to many unconfigured nodes with
+ * the services of @ref CO_LSSmaster.
+ *
+ * Nodes with known LSS address are added with CO_LSScomm_addNode(), with
+ * fixed node-ID or with node-ID from the range given to CO_LSScomm_start().
+ * They are selected directly with LSS switch state selective. If
+ * @ref CO_LSS_COMM_FLAG_FASTSCAN is set, remaining unconfigured nodes are then
+ * found one by one with LSS fastscan (criteria are in fastscan member of
+ * @ref CO_LSScomm_t) and get free node-IDs from the range. Node, found by
+ * fastscan, gets the node-ID from the list, if its LSS address is there.
+ *
+ * For each node the engine configures the node-ID, optionally stores the
+ * configuration (@ref CO_LSS_COMM_FLAG_STORE) and deselects the node. The
+ * next step is started in the same CO_LSScomm_process() call, in which the
+ * confirmation of the previous step is received. Deselect is non-confirmed, so
+ * selection of the next node follows immediately.
+ *
+ * LSS timeout is adapted to the response time of the nodes. Round trip time
+ * of each confirmed service is measured and the timeout is set to
+ * @ref CO_LSS_COMM_RTT_FACTOR times the largest measured time, but not below
+ * the minimum timeout from CO_LSScomm_start(). Fastscan waits for the timeout
+ * in each of its steps, so it benefits most. If confirmation is missing or
+ * fastscan fails, the timeout is doubled, up to the maximum from
+ * CO_LSScomm_start(), and the step is repeated. Next step starts with the
+ * timeout from the measured time again, so absent node does not slow down
+ * the others. Steps, which time out with maximum timeout, are repeated, until
+ * retries are exhausted. Fastscan without response ends the commissioning
+ * only, if timeout is at maximum, so slow nodes are not missed.
+ *
+ * Node, which fails, keeps its result and commissioning continues with the
+ * next node. Fastscan always selects the unconfigured node with the lowest LSS
+ * address, so node found by fastscan, which can not be configured, would be
+ * selected again and again. Its address is remembered and next fastscans
+ * search only for nodes after it, see CO_LSSmaster_IdentifyFastscanAfter().
+ * If nodes were configured meanwhile, fastscan is repeated from the lowest
+ * address at the end, so nodes passed by prediction of LSS master are not
+ * missed. Fastscan is aborted, if the table is full or if there is no free
+ * node-ID for the found node.
+ *
+ * LSS master must not be used by other parts of the program during the
+ * commissioning. Result of each node is in the nodes array of
+ * @ref CO_LSScomm_t, optional callback is called after each node, see
+ * CO_LSScomm_initCallbackNode().
+ */
+
+/** Maximum number of nodes in the commissioning table */
+#define CO_LSS_COMM_NODES_MAX 127U
+/** LSS timeout is this times the largest measured round trip time */
+#define CO_LSS_COMM_RTT_FACTOR 4U
+
+/** Flags for CO_LSScomm_start() */
+typedef enum {
+    /** Find unconfigured nodes by LSS fastscan after the listed nodes */
+    CO_LSS_COMM_FLAG_FASTSCAN = 0x01U,
+    /** Store configuration in each node after node-ID is configured */
+    CO_LSS_COMM_FLAG_STORE = 0x02U
+} CO_LSScomm_flag_t;
+
+
+/**
+ * Result of one node in the @ref CO_LSScomm_t.
+ */
+typedef enum {
+    /** Node is not processed yet */
+    CO_LSScomm_NODE_PENDING = 0,
+    /** Node-ID is configured (and stored) */
+    CO_LSScomm_NODE_DONE = 1,
+    /** Listed node did not confirm the selection */
+    CO_LSScomm_NODE_NOT_FOUND = 2,
+    /** Node rejected the node-ID */
+    CO_LSScomm_NODE_REJECTED = 3,
+    /** Node-ID is configured, but node failed to store it */
+    CO_LSScomm_NODE_STORE_FAILED = 4,
+    /** Node was selected, but configure or store was not confirmed */
+    CO_LSScomm_NODE_TIMEOUT = 5,
+    /** There is no free node-ID in the range */
+    CO_LSScomm_NODE_NO_ID = 6
+} CO_LSScomm_result_t;
+
+
+/**
+ * Return values from CO_LSScomm_process().
+ */
+typedef enum {
+    /** Commissioning is not started */
+    CO_LSScomm_IDLE = 0,
+    /** Commissioning is in progress */
+    CO_LSScomm_BUSY = 1,
+    /** All nodes are commissioned */
+    CO_LSScomm_DONE = 2,
+    /** Commissioning is finished or aborted, some nodes failed, see results
+     * in nodes array */
+    CO_LSScomm_ERROR = -1
+} CO_LSScomm_return_t;
+
+
+/**
+ * One node inside @ref CO_LSScomm_t.
+ */
+typedef struct {
+    /** LSS address, from CO_LSScomm_addNode() or found by fastscan */
+    CO_LSS_address_t address;
+    /** Node-ID, from CO_LSScomm_addNode() or assigned from the range. 0 if
+     * not assigned yet. */
+    uint8_t nodeId;
+    /** True, if node was added by CO_LSScomm_addNode() */
+    bool_t listed;
+    /** True, if node-ID was given to CO_LSScomm_addNode() */
+    bool_t nodeIdFixed;
+    /** Result of the node, see @ref CO_LSScomm_result_t */
+    CO_LSScomm_result_t result;
+    /** Time spent for the node in microseconds */
+    uint32_t time_us;
+} CO_LSScomm_node_t;
+
+
+/**
+ * LSS batch commissioning object.
+ */
+typedef struct {
+    /** Listed nodes in the order of CO_LSScomm_addNode(), followed by the
+     * nodes found by fastscan */
+    CO_LSScomm_node_t nodes[CO_LSS_COMM_NODES_MAX];
+    /** Number of nodes in the table */
+    uint8_t nodesCount;
+    /** Number of nodes added by CO_LSScomm_addNode() */
+    uint8_t nodesListed;
+    /** Number of nodes with result CO_LSScomm_NODE_DONE */
+    uint8_t nodesDone;
+    /** Criteria for fastscan, set to full scan by CO_LSScomm_init(). May be
+     * changed by application before CO_LSScomm_start(). */
+    CO_LSSmaster_fastscan_t fastscan;
+    /** Bitmap of node-IDs, not assigned from the range: fixed node-IDs from
+     * CO_LSScomm_addNode() and node-IDs from CO_LSScomm_reserveNodeId() */
+    uint32_t nodeIdReserved[4];
+    /** Bitmap of node-IDs in use during the commissioning */
+    uint32_t nodeIdUsed[4];
+    /** Return value of the last CO_LSScomm_process() */
+    CO_LSScomm_return_t state;
+    /** True, if fastscan was aborted: it failed, table is full or there is no
+     * free node-ID */
+    bool_t aborted;
+    /** LSS address of the last failed node found by fastscan, next fastscans
+     * search for nodes after it */
+    CO_LSS_address_t fastscanAfter;
+    /** True, if fastscanAfter is used */
+    bool_t fastscanAfterValid;
+    /** Value of nodesDone, when fastscanAfter was set first */
+    uint8_t fastscanAfterDone;
+    /** Current step of the internal state machine */
+    uint8_t step;
+    /** True, if the current step is initiated */
+    bool_t stepStarted;
+    /** Index of the current node in the nodes array */
+    uint8_t nodeIndex;
+    /** True, if the current node was selected by fastscan */
+    bool_t nodeFastscan;
+    /** Index of the next listed node to select */
+    uint8_t listIndex;
+    /** From CO_LSScomm_start() */
+    uint8_t flags;
+    /** From CO_LSScomm_start() */
+    uint8_t nodeIdFirst;
+    /** From CO_LSScomm_start() */
+    uint8_t nodeIdLast;
+    /** From CO_LSScomm_start() */
+    uint8_t retries;
+    /** Remaining repetitions of the current step with maximum timeout */
+    uint8_t retriesLeft;
+    /** From CO_LSScomm_start(), in microseconds */
+    uint32_t timeoutMin_us;
+    /** From CO_LSScomm_start(), in microseconds */
+    uint32_t timeoutMax_us;
+    /** Current LSS timeout in microseconds */
+    uint32_t timeout_us;
+    /** LSS master timeout before CO_LSScomm_start(), restored at the end */
+    uint32_t timeoutOrig_us;
+    /** Time since the current step was initiated */
+    uint32_t stepTimer_us;
+    /** Time, when the current node was started */
+    uint32_t nodeStart_us;
+    /** Time since CO_LSScomm_start() in microseconds */
+    uint32_t time_us;
+    /** Largest measured round trip time of confirmed LSS services */
+    uint32_t rttMax_us;
+    /** Sum of all measured round trip times, see rttCount */
+    uint32_t rttSum_us;
+    /** Number of measured round trip times */
+    uint16_t rttCount;
+    /** Number of LSS timeouts (doubling of timeout or retry) */
+    uint16_t timeouts;
+    /** Number of started fastscans */
+    uint16_t fastscans;
+    /** From CO_LSScomm_init() */
+    CO_LSSmaster_t *LSSmaster;
+    /** From CO_LSScomm_initCallbackNode() or NULL */
+    void (*pFunctNode)(void *object, const CO_LSScomm_node_t *node);
+    /** From CO_LSScomm_initCallbackNode() or NULL */
+    void *functNodeObject;
+} CO_LSScomm_t;
+
+
+/**
+ * Initialize LSS batch commissioning object.
+ *
+ * All nodes and reserved node-IDs are cleared, fastscan criteria are set to
+ * scan all four parts of the LSS address.
+ *
+ * @param comm This object will be initialized.
+ * @param LSSmaster LSS master object.
+ *
+ * @return #CO_ReturnError_t: CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT.
+ */
+CO_ReturnError_t CO_LSScomm_init(CO_LSScomm_t *comm,
+                                 CO_LSSmaster_t *LSSmaster);
+
+
+/**
+ * Add node with known LSS address to the commissioning table.
+ *
+ * @param comm This object.
+ * @param address LSS address of the node, each address may be added only
+ * once.
+ * @param nodeId Node-ID for the node, 1 to 127, each node-ID may be used only
+ * once. If 0, node-ID is assigned from the range given to CO_LSScomm_start().
+ *
+ * @return #CO_ReturnError_t: CO_ERROR_NO, CO_ERROR_ILLEGAL_ARGUMENT or
+ * CO_ERROR_OUT_OF_MEMORY.
+ */
+CO_ReturnError_t CO_LSScomm_addNode(CO_LSScomm_t *comm,
+                                    const CO_LSS_address_t *address,
+                                    uint8_t nodeId);
+
+
+/**
+ * Exclude node-ID from the assignment.
+ *
+ * Useful for node-IDs of already configured nodes, for example from
+ * @ref CO_nodeScan.
+ *
+ * @param comm This object.
+ * @param nodeId Node-ID, 1 to 127.
+ *
+ * @return #CO_ReturnError_t: CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT.
+ */
+CO_ReturnError_t CO_LSScomm_reserveNodeId(CO_LSScomm_t *comm, uint8_t nodeId);
+
+
+/**
+ * Initialize callback function, called after each node is finished.
+ *
+ * @param comm This object.
+ * @param object Pointer to object, which will be passed to pFunctNode(). Can
+ * be NULL.
+ * @param pFunctNode Pointer to the callback function with finished node. Not
+ * called if NULL.
+ */
+void CO_LSScomm_initCallbackNode(
+        CO_LSScomm_t           *comm,
+        void                   *object,
+        void                  (*pFunctNode)(void *object,
+                                            const CO_LSScomm_node_t *node));
+
+
+/**
+ * Start LSS batch commissioning.
+ *
+ * Results from previous commissioning are cleared, nodes found by previous
+ * fastscan are removed from the table. Measured response time is kept. All
+ * nodes are switched into LSS waiting state first.
+ *
+ * @param comm This object.
+ * @param flags Combination of @ref CO_LSScomm_flag_t.
+ * @param nodeIdFirst First node-ID of the range for nodes without fixed
+ * node-ID, 1 to 127.
+ * @param nodeIdLast Last node-ID of the range, nodeIdFirst to 127.
+ * @param timeoutMin_ms Lower limit for the adapted LSS timeout.
+ * @param timeoutMax_ms Upper limit for the adapted LSS timeout. Nodes, which
+ * do not respond within this time, are considered absent.
+ * @param retries Number of repetitions of the step, after timeout at maximum
+ * value.
+ *
+ * @return #CO_ReturnError_t: CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT.
+ */
+CO_ReturnError_t CO_LSScomm_start(CO_LSScomm_t *comm,
+                                  uint8_t flags,
+                                  uint8_t nodeIdFirst,
+                                  uint8_t nodeIdLast,
+                                  uint16_t timeoutMin_ms,
+                                  uint16_t timeoutMax_ms,
+                                  uint8_t retries);
+
+
+/**
+ * Process LSS batch commissioning.
+ *
+ * Function must be called cyclically after CO_LSScomm_start(), until it
+ * returns other value than CO_LSScomm_BUSY. Shorter interval gives more
+ * accurate measurement of the response time and shorter timeouts.
+ *
+ * @param comm This object.
+ * @param timeDifference_us Time difference from previous function call.
+ * @param [out] timerNext_us info to OS - see CO_process().
+ *
+ * @return @ref CO_LSScomm_return_t.
+ */
+CO_LSScomm_return_t CO_LSScomm_process(CO_LSScomm_t *comm,
+                                       uint32_t timeDifference_us,
+                                       uint32_t *timerNext_us);
+
+
+/** @} */ /* CO_LSScommission */
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+
+#endif /* (CO_CONFIG_LSS_COMM) & CO_CONFIG_LSS_COMM_ENABLE */
+
+#endif /* CO_LSS_COMMISSION_H */
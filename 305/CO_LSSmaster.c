@@ -64,7 +64,11 @@ typedef enum {
 typedef enum {
   CO_LSSmaster_FS_STATE_CHECK,
   CO_LSSmaster_FS_STATE_SCAN,
-  CO_LSSmaster_FS_STATE_VERIFY
+  CO_LSSmaster_FS_STATE_VERIFY,
+  CO_LSSmaster_FS_STATE_PREDICT,
+  CO_LSSmaster_FS_STATE_AFTER_RESET,
+  CO_LSSmaster_FS_STATE_AFTER_PREFIX,
+  CO_LSSmaster_FS_STATE_AFTER_QUERY
 } CO_LSSmaster_fs_t;
 
 /*
@@ -147,6 +151,13 @@ CO_ReturnError_t CO_LSSmaster_init(
     LSSmaster->timeoutTimer = 0;
     CO_FLAG_CLEAR(LSSmaster->CANrxNew);
     memset(LSSmaster->CANrxData, 0, sizeof(LSSmaster->CANrxData));
+#if (CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER_FASTSCAN_ADAPTIVE
+    LSSmaster->fsRxTime_us = 0;
+    LSSmaster->fsResponse_us = 0;
+    memset(&LSSmaster->fsPrev, 0, sizeof(LSSmaster->fsPrev));
+    LSSmaster->fsPrevValid = 0;
+    memset(&LSSmaster->fsStat, 0, sizeof(LSSmaster->fsStat));
+#endif
 #if (CO_CONFIG_LSS) & CO_CONFIG_FLAG_CALLBACK_PRE
     LSSmaster->pFunctSignal = NULL;
     LSSmaster->functSignalObject = NULL;
@@ -762,9 +773,68 @@ static void CO_LSSmaster_FsSendMsg(
     LSSmaster->TXbuff->data[6] = lssSub;
     LSSmaster->TXbuff->data[7] = lssNext;
 
+#if (CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER_FASTSCAN_ADAPTIVE
+    LSSmaster->fsRxTime_us = 0;
+    LSSmaster->fsStat.requests++;
+#endif
     CO_CANsend(LSSmaster->CANdevTx, LSSmaster->TXbuff);
 }
 
+#if (CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER_FASTSCAN_ADAPTIVE
+/*
+ * Helper function - wait for fastscan response with adaptive timing
+ *
+ * Instead of waiting for timeout on each request, received message is checked
+ * on each call. Time of the first response is measured and the longest one is
+ * kept as the fastscan response time. Request with response is finished, when
+ * response time elapses, so late responses from other slaves are still
+ * received within the same request. Request without response is finished
+ * after CO_LSSmaster_FS_RESPONSE_MARGIN times the response time, or after
+ * timeout, if fullTimeout is set or response time is not known yet.
+ *
+ * Return CO_LSSmaster_TIMEOUT, when request is finished, or
+ * CO_LSSmaster_WAIT_SLAVE. Response is then evaluated by the caller.
+ */
+static CO_LSSmaster_return_t CO_LSSmaster_FsWait(
+        CO_LSSmaster_t         *LSSmaster,
+        uint32_t                timeDifference_us,
+        bool_t                  fullTimeout)
+{
+    uint32_t window = LSSmaster->timeout_us;
+
+    LSSmaster->timeoutTimer += timeDifference_us;
+    LSSmaster->fsStat.time_us += timeDifference_us;
+    LSSmaster->fsStat.timeLast_us += timeDifference_us;
+
+    if (CO_FLAG_READ(LSSmaster->CANrxNew)) {
+        if (LSSmaster->fsRxTime_us == 0) {
+            /* first response to this request */
+            LSSmaster->fsRxTime_us = LSSmaster->timeoutTimer > 0
+                                   ? LSSmaster->timeoutTimer : 1;
+            LSSmaster->fsStat.responses++;
+            if (LSSmaster->fsRxTime_us > LSSmaster->fsResponse_us) {
+                LSSmaster->fsResponse_us = LSSmaster->fsRxTime_us;
+            }
+        }
+        if (LSSmaster->fsResponse_us < window) {
+            window = LSSmaster->fsResponse_us;
+        }
+    }
+    else if (!fullTimeout && LSSmaster->fsResponse_us > 0
+             && LSSmaster->fsResponse_us
+                < LSSmaster->timeout_us / CO_LSSmaster_FS_RESPONSE_MARGIN
+    ) {
+        window = LSSmaster->fsResponse_us * CO_LSSmaster_FS_RESPONSE_MARGIN;
+    }
+
+    if (LSSmaster->timeoutTimer >= window) {
+        LSSmaster->timeoutTimer = 0;
+        return CO_LSSmaster_TIMEOUT;
+    }
+    return CO_LSSmaster_WAIT_SLAVE;
+}
+#endif
+
 /*
  * Helper function - wait for confirmation
  */
@@ -774,7 +844,11 @@ static CO_LSSmaster_return_t CO_LSSmaster_FsCheckWait(
 {
     CO_LSSmaster_return_t ret;
 
+#if (CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER_FASTSCAN_ADAPTIVE
+    ret = CO_LSSmaster_FsWait(LSSmaster, timeDifference_us, true);
+#else
     ret = CO_LSSmaster_check_timeout(LSSmaster, timeDifference_us);
+#endif
     if (ret == CO_LSSmaster_TIMEOUT) {
         ret = CO_LSSmaster_SCAN_NOACK;
 
@@ -817,6 +891,20 @@ static CO_LSSmaster_return_t CO_LSSmaster_FsScanInitiate(
             return CO_LSSmaster_SCAN_FAILED;
     }
 
+#if (CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER_FASTSCAN_ADAPTIVE
+    if ((LSSmaster->fsPrevValid & (1U << lssSub)) != 0) {
+        /* try the value found by previous fastscan first */
+        LSSmaster->fsIdNumber = LSSmaster->fsPrev.addr[lssSub];
+        LSSmaster->fsBitChecked = CO_LSS_FASTSCAN_BIT0;
+        LSSmaster->fsState = CO_LSSmaster_FS_STATE_PREDICT;
+
+        CO_LSSmaster_FsSendMsg(LSSmaster, LSSmaster->fsIdNumber,
+            LSSmaster->fsBitChecked, LSSmaster->fsLssSub, LSSmaster->fsLssSub);
+
+        return CO_LSSmaster_WAIT_SLAVE;
+    }
+#endif
+
     LSSmaster->fsBitChecked = CO_LSS_FASTSCAN_BIT31;
 
     /* trigger scan procedure by sending first message */
@@ -847,7 +935,11 @@ static CO_LSSmaster_return_t CO_LSSmaster_FsScanWait(
             return CO_LSSmaster_SCAN_FAILED;
     }
 
+#if (CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER_FASTSCAN_ADAPTIVE
+    ret = CO_LSSmaster_FsWait(LSSmaster, timeDifference_us, false);
+#else
     ret = CO_LSSmaster_check_timeout(LSSmaster, timeDifference_us);
+#endif
     if (ret == CO_LSSmaster_TIMEOUT) {
 
         ret = CO_LSSmaster_WAIT_SLAVE;
@@ -882,6 +974,67 @@ static CO_LSSmaster_return_t CO_LSSmaster_FsScanWait(
     return ret;
 }
 
+#if (CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER_FASTSCAN_ADAPTIVE
+/*
+ * Helper function - check 32 bit part of LSS address found by previous
+ * fastscan. If it does not match, check its upper 16 bits and continue with
+ * scan of lower 16 bits. If that does not match too, do full scan.
+ */
+static CO_LSSmaster_return_t CO_LSSmaster_FsPredictWait(
+        CO_LSSmaster_t                  *LSSmaster,
+        uint32_t                         timeDifference_us)
+{
+    CO_LSSmaster_return_t ret;
+    bool_t ack = false;
+
+    ret = CO_LSSmaster_FsWait(LSSmaster, timeDifference_us, false);
+    if (ret != CO_LSSmaster_TIMEOUT) {
+        return ret;
+    }
+
+    if (CO_FLAG_READ(LSSmaster->CANrxNew)) {
+        uint8_t cs = LSSmaster->CANrxData[0];
+        CO_FLAG_CLEAR(LSSmaster->CANrxNew);
+
+        if (cs != CO_LSS_IDENT_SLAVE) {
+            /* wrong response received. Can not continue */
+            return CO_LSSmaster_SCAN_FAILED;
+        }
+        ack = true;
+    }
+
+    if (LSSmaster->fsBitChecked == CO_LSS_FASTSCAN_BIT0) {
+        if (ack) {
+            /* whole value confirmed, verify it */
+            LSSmaster->fsStat.predicted++;
+            LSSmaster->fsStat.bitsSkipped += 32U;
+            return CO_LSSmaster_SCAN_FINISHED;
+        }
+        /* check upper 16 bits */
+        LSSmaster->fsBitChecked = 16U;
+    }
+    else {
+        if (ack) {
+            /* upper 16 bits confirmed, scan the lower 16 bits */
+            LSSmaster->fsStat.bitsSkipped += 16U;
+            LSSmaster->fsIdNumber &= 0xFFFF0000UL;
+            LSSmaster->fsBitChecked = 15U;
+        }
+        else {
+            /* prediction failed, scan all 32 bits */
+            LSSmaster->fsIdNumber = 0;
+            LSSmaster->fsBitChecked = CO_LSS_FASTSCAN_BIT31;
+        }
+        LSSmaster->fsState = CO_LSSmaster_FS_STATE_SCAN;
+    }
+
+    CO_LSSmaster_FsSendMsg(LSSmaster, LSSmaster->fsIdNumber,
+        LSSmaster->fsBitChecked, LSSmaster->fsLssSub, LSSmaster->fsLssSub);
+
+    return CO_LSSmaster_WAIT_SLAVE;
+}
+#endif
+
 /*
  * Helper function - initiate check for 32 bit part of LSS address
  */
@@ -932,7 +1085,11 @@ static CO_LSSmaster_return_t CO_LSSmaster_FsVerifyWait(
         return CO_LSSmaster_SCAN_FAILED;
     }
 
+#if (CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER_FASTSCAN_ADAPTIVE
+    ret = CO_LSSmaster_FsWait(LSSmaster, timeDifference_us, true);
+#else
     ret = CO_LSSmaster_check_timeout(LSSmaster, timeDifference_us);
+#endif
     if (ret == CO_LSSmaster_TIMEOUT) {
 
         *idNumberRet = 0;
@@ -976,11 +1133,134 @@ static CO_LSS_fastscan_lss_sub_next CO_LSSmaster_FsSearchNext(
     return CO_LSS_FASTSCAN_VENDOR_ID;
 }
 
+/*
+ * Helper function - wait for response to single fastscan request, which is
+ * not part of bitwise scan
+ */
+static CO_LSSmaster_return_t CO_LSSmaster_FsAckWait(
+        CO_LSSmaster_t         *LSSmaster,
+        uint32_t                timeDifference_us,
+        bool_t                  fullTimeout)
+{
+    CO_LSSmaster_return_t ret;
+
+#if (CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER_FASTSCAN_ADAPTIVE
+    ret = CO_LSSmaster_FsWait(LSSmaster, timeDifference_us, fullTimeout);
+#else
+    (void)fullTimeout;
+    ret = CO_LSSmaster_check_timeout(LSSmaster, timeDifference_us);
+#endif
+    if (ret == CO_LSSmaster_TIMEOUT) {
+        ret = CO_LSSmaster_SCAN_NOACK;
+
+        if (CO_FLAG_READ(LSSmaster->CANrxNew)) {
+            uint8_t cs = LSSmaster->CANrxData[0];
+            CO_FLAG_CLEAR(LSSmaster->CANrxNew);
+
+            ret = (cs == CO_LSS_IDENT_SLAVE)
+                ? CO_LSSmaster_SCAN_FINISHED : CO_LSSmaster_SCAN_FAILED;
+        }
+    }
+
+    return ret;
+}
+
+/*
+ * Helper function - send request for the current candidate of the search for
+ * the node after fsAfter. Parts before the candidate are verified first, nodes
+ * with matching value switch to the next part.
+ */
+static CO_LSSmaster_return_t CO_LSSmaster_FsAfterSend(
+        CO_LSSmaster_t                  *LSSmaster,
+        CO_LSSmaster_fastscan_t         *fastscan)
+{
+    uint8_t lssSub = LSSmaster->fsAfterPos / 32U;
+    uint8_t bit = CO_LSS_FASTSCAN_BIT31 - (LSSmaster->fsAfterPos % 32U);
+    uint8_t ready = LSSmaster->fsAfterReady;
+
+    if (ready < lssSub) {
+        uint32_t value = fastscan->scan[ready] == CO_LSSmaster_FS_MATCH
+                       ? fastscan->match.addr[ready]
+                       : LSSmaster->fsAfter.addr[ready];
+
+        LSSmaster->fsLssSub = ready;
+        LSSmaster->fsIdNumber = value;
+        LSSmaster->fsState = CO_LSSmaster_FS_STATE_AFTER_PREFIX;
+        CO_LSSmaster_FsSendMsg(LSSmaster, value, CO_LSS_FASTSCAN_BIT0, ready,
+            CO_LSSmaster_FsSearchNext(LSSmaster, fastscan));
+    }
+    else {
+        /* higher bits from fsAfter, candidate bit set */
+        uint32_t mask = bit == CO_LSS_FASTSCAN_BIT31
+                      ? 0 : 0xFFFFFFFFUL << (bit + 1U);
+
+        LSSmaster->fsLssSub = lssSub;
+        LSSmaster->fsBitChecked = bit;
+        LSSmaster->fsIdNumber = (LSSmaster->fsAfter.addr[lssSub] & mask)
+                              | (1UL << bit);
+        LSSmaster->fsState = CO_LSSmaster_FS_STATE_AFTER_QUERY;
+        CO_LSSmaster_FsSendMsg(LSSmaster, LSSmaster->fsIdNumber, bit,
+            lssSub, lssSub);
+    }
+
+    return CO_LSSmaster_WAIT_SLAVE;
+}
+
+/*
+ * Helper function - continue search for the node after fsAfter with the next
+ * candidate. Candidates are the bits of the scanned parts of fsAfter, which
+ * are 0, from the last one to the first one. Node, which matches the higher
+ * bits of fsAfter and has the candidate bit set, follows fsAfter. Fastscan is
+ * reset, if candidate is in the part, which is already verified.
+ */
+static CO_LSSmaster_return_t CO_LSSmaster_FsAfterNext(
+        CO_LSSmaster_t                  *LSSmaster,
+        CO_LSSmaster_fastscan_t         *fastscan)
+{
+    uint8_t pos = LSSmaster->fsAfterPos;
+    uint8_t bit;
+
+    for (;;) {
+        if (pos == 0) {
+            /* there is no node after fsAfter */
+            return CO_LSSmaster_SCAN_NOACK;
+        }
+        pos--;
+        bit = CO_LSS_FASTSCAN_BIT31 - (pos % 32U);
+        if (fastscan->scan[pos / 32U] == CO_LSSmaster_FS_SCAN
+            && (LSSmaster->fsAfter.addr[pos / 32U] & (1UL << bit)) == 0
+        ) {
+            break;
+        }
+    }
+    LSSmaster->fsAfterPos = pos;
+
+    if (LSSmaster->fsAfterReady > pos / 32U) {
+        /* nodes have already passed the part of the candidate */
+        LSSmaster->fsState = CO_LSSmaster_FS_STATE_AFTER_RESET;
+        CO_LSSmaster_FsSendMsg(LSSmaster, 0, CO_LSS_FASTSCAN_CONFIRM, 0, 0);
+        return CO_LSSmaster_WAIT_SLAVE;
+    }
+
+    return CO_LSSmaster_FsAfterSend(LSSmaster, fastscan);
+}
+
 /******************************************************************************/
 CO_LSSmaster_return_t CO_LSSmaster_IdentifyFastscan(
         CO_LSSmaster_t          *LSSmaster,
         uint32_t                 timeDifference_us,
         CO_LSSmaster_fastscan_t *fastscan)
+{
+    return CO_LSSmaster_IdentifyFastscanAfter(LSSmaster, timeDifference_us,
+                                              fastscan, NULL);
+}
+
+/******************************************************************************/
+CO_LSSmaster_return_t CO_LSSmaster_IdentifyFastscanAfter(
+        CO_LSSmaster_t          *LSSmaster,
+        uint32_t                 timeDifference_us,
+        CO_LSSmaster_fastscan_t *fastscan,
+        const CO_LSS_address_t  *after)
 {
     uint8_t i;
     uint8_t count;
@@ -1019,6 +1299,14 @@ CO_LSSmaster_return_t CO_LSSmaster_IdentifyFastscan(
         case CO_LSSmaster_COMMAND_WAITING:
             /* start fastscan */
             LSSmaster->command = CO_LSSmaster_COMMAND_IDENTIFY_FASTSCAN;
+#if (CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER_FASTSCAN_ADAPTIVE
+            LSSmaster->fsStat.scans++;
+            LSSmaster->fsStat.timeLast_us = 0;
+#endif
+            LSSmaster->fsAfterValid = after != NULL;
+            if (after != NULL) {
+                LSSmaster->fsAfter = *after;
+            }
 
             /* check if any nodes are waiting, if yes fastscan is reset */
             LSSmaster->fsState = CO_LSSmaster_FS_STATE_CHECK;
@@ -1046,16 +1334,24 @@ CO_LSSmaster_return_t CO_LSSmaster_IdentifyFastscan(
     switch (LSSmaster->fsState) {
         case CO_LSSmaster_FS_STATE_CHECK:
             ret = CO_LSSmaster_FsCheckWait(LSSmaster, timeDifference_us);
-            if (ret == CO_LSSmaster_SCAN_FINISHED) {
+            if (ret == CO_LSSmaster_SCAN_FINISHED && LSSmaster->fsAfterValid) {
+                memset(&fastscan->found, 0, sizeof(fastscan->found));
+
+                /* start search for the node after the given one, nodes are
+                 * reset to the vendor ID part */
+                LSSmaster->fsAfterPos = (CO_LSS_FASTSCAN_SERIAL + 1U) * 32U;
+                LSSmaster->fsAfterReady = CO_LSS_FASTSCAN_VENDOR_ID;
+                ret = CO_LSSmaster_FsAfterNext(LSSmaster, fastscan);
+            }
+            else if (ret == CO_LSSmaster_SCAN_FINISHED) {
                 memset(&fastscan->found, 0, sizeof(fastscan->found));
 
                 /* start scanning procedure by triggering vendor ID scan */
+                LSSmaster->fsState = CO_LSSmaster_FS_STATE_SCAN;
                 CO_LSSmaster_FsScanInitiate(LSSmaster, timeDifference_us,
                       fastscan->scan[CO_LSS_FASTSCAN_VENDOR_ID],
                       CO_LSS_FASTSCAN_VENDOR_ID);
                 ret = CO_LSSmaster_WAIT_SLAVE;
-
-                LSSmaster->fsState = CO_LSSmaster_FS_STATE_SCAN;
             }
             break;
         case CO_LSSmaster_FS_STATE_SCAN:
@@ -1073,10 +1369,100 @@ CO_LSSmaster_return_t CO_LSSmaster_IdentifyFastscan(
                 LSSmaster->fsState = CO_LSSmaster_FS_STATE_VERIFY;
             }
             break;
+#if (CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER_FASTSCAN_ADAPTIVE
+        case CO_LSSmaster_FS_STATE_PREDICT:
+            ret = CO_LSSmaster_FsPredictWait(LSSmaster, timeDifference_us);
+            if (ret == CO_LSSmaster_SCAN_FINISHED) {
+                /* predicted value matches, verify it and switch node state */
+                next = CO_LSSmaster_FsSearchNext(LSSmaster, fastscan);
+                ret = CO_LSSmaster_FsVerifyInitiate(LSSmaster, timeDifference_us,
+                          CO_LSSmaster_FS_SCAN, 0, next);
+
+                LSSmaster->fsState = CO_LSSmaster_FS_STATE_VERIFY;
+            }
+            break;
+#endif
+        case CO_LSSmaster_FS_STATE_AFTER_RESET:
+            ret = CO_LSSmaster_FsAckWait(LSSmaster, timeDifference_us, true);
+            if (ret == CO_LSSmaster_SCAN_FINISHED) {
+                LSSmaster->fsAfterReady = CO_LSS_FASTSCAN_VENDOR_ID;
+                ret = CO_LSSmaster_FsAfterSend(LSSmaster, fastscan);
+            }
+            break;
+        case CO_LSSmaster_FS_STATE_AFTER_PREFIX:
+            ret = CO_LSSmaster_FsAckWait(LSSmaster, timeDifference_us, true);
+            if (ret == CO_LSSmaster_SCAN_FINISHED) {
+                /* nodes with matching part switched to the next part */
+                fastscan->found.addr[LSSmaster->fsLssSub] =
+                    LSSmaster->fsIdNumber;
+                LSSmaster->fsAfterReady =
+                    CO_LSSmaster_FsSearchNext(LSSmaster, fastscan);
+                ret = CO_LSSmaster_FsAfterSend(LSSmaster, fastscan);
+            }
+            else if (ret == CO_LSSmaster_SCAN_NOACK) {
+                /* no node has this part, so candidates in the following
+                 * parts can not match. Nodes wait in this part. */
+                LSSmaster->fsAfterReady = LSSmaster->fsLssSub;
+                LSSmaster->fsAfterPos = (LSSmaster->fsLssSub + 1U) * 32U;
+                ret = CO_LSSmaster_FsAfterNext(LSSmaster, fastscan);
+            }
+            break;
+        case CO_LSSmaster_FS_STATE_AFTER_QUERY:
+            ret = CO_LSSmaster_FsAckWait(LSSmaster, timeDifference_us, false);
+            if (ret == CO_LSSmaster_SCAN_FINISHED) {
+                /* the next node is found by its higher bits, scan the rest */
+                if (LSSmaster->fsBitChecked == CO_LSS_FASTSCAN_BIT0) {
+                    next = CO_LSSmaster_FsSearchNext(LSSmaster, fastscan);
+                    ret = CO_LSSmaster_FsVerifyInitiate(LSSmaster,
+                              timeDifference_us, CO_LSSmaster_FS_SCAN, 0, next);
+                    LSSmaster->fsState = CO_LSSmaster_FS_STATE_VERIFY;
+                }
+                else {
+                    LSSmaster->fsBitChecked--;
+                    LSSmaster->fsState = CO_LSSmaster_FS_STATE_SCAN;
+                    CO_LSSmaster_FsSendMsg(LSSmaster,
+                        LSSmaster->fsIdNumber, LSSmaster->fsBitChecked,
+                        LSSmaster->fsLssSub, LSSmaster->fsLssSub);
+                    ret = CO_LSSmaster_WAIT_SLAVE;
+                }
+            }
+            else if (ret == CO_LSSmaster_SCAN_NOACK) {
+                ret = CO_LSSmaster_FsAfterNext(LSSmaster, fastscan);
+            }
+            break;
         case CO_LSSmaster_FS_STATE_VERIFY:
             ret = CO_LSSmaster_FsVerifyWait(LSSmaster, timeDifference_us,
                       fastscan->scan[LSSmaster->fsLssSub],
                       &fastscan->found.addr[LSSmaster->fsLssSub]);
+#if (CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER_FASTSCAN_ADAPTIVE
+            if (fastscan->scan[LSSmaster->fsLssSub] == CO_LSSmaster_FS_SCAN) {
+                if (ret == CO_LSSmaster_SCAN_FINISHED) {
+                    LSSmaster->fsPrev.addr[LSSmaster->fsLssSub] =
+                        fastscan->found.addr[LSSmaster->fsLssSub];
+                    LSSmaster->fsPrevValid |= 1U << LSSmaster->fsLssSub;
+                }
+                else if ((ret == CO_LSSmaster_SCAN_NOACK
+                          || ret == CO_LSSmaster_SCAN_FAILED)
+                         && LSSmaster->fsResponse_us > 0
+                         && LSSmaster->fsResponse_us < LSSmaster->timeout_us
+                ) {
+                    /* Scanned value is wrong, some response was probably too
+                     * late. Wait longer and restart the fastscan. Number of
+                     * restarts is limited, because response time can not
+                     * exceed the timeout. */
+                    LSSmaster->fsResponse_us *= 2U;
+                    LSSmaster->fsStat.restarts++;
+                    LSSmaster->fsState = CO_LSSmaster_FS_STATE_CHECK;
+                    CO_LSSmaster_FsSendMsg(LSSmaster, 0,
+                                           CO_LSS_FASTSCAN_CONFIRM, 0, 0);
+                    ret = CO_LSSmaster_WAIT_SLAVE;
+                }
+                else if (ret == CO_LSSmaster_SCAN_NOACK) {
+                    /* value was scanned with full timeout */
+                    ret = CO_LSSmaster_SCAN_FAILED;
+                }
+            }
+#endif
             if (ret == CO_LSSmaster_SCAN_FINISHED) {
                 /* verification successful:
                  * - assumed node id is correct
@@ -1090,6 +1476,7 @@ CO_LSSmaster_return_t CO_LSSmaster_IdentifyFastscan(
                 }
                 else {
                     /* initiate scan for next part of LSS address */
+                    LSSmaster->fsState = CO_LSSmaster_FS_STATE_SCAN;
                     ret = CO_LSSmaster_FsScanInitiate(LSSmaster,
                               timeDifference_us, fastscan->scan[next], next);
                     if (ret == CO_LSSmaster_SCAN_FINISHED) {
@@ -1097,8 +1484,6 @@ CO_LSSmaster_return_t CO_LSSmaster_IdentifyFastscan(
                          * step in next function call */
                         ret = CO_LSSmaster_WAIT_SLAVE;
                     }
-
-                    LSSmaster->fsState = CO_LSSmaster_FS_STATE_SCAN;
                 }
             }
             break;
@@ -100,6 +100,37 @@ typedef enum {
 } CO_LSSmaster_return_t;
 
 
+#if ((CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER_FASTSCAN_ADAPTIVE) || defined CO_DOXYGEN
+/**
+ * Multiplier of the measured fastscan response time. Fastscan request without
+ * response is finished after this multiple of #CO_LSSmaster_t::fsResponse_us,
+ * but not later than after #CO_LSSmaster_t::timeout_us.
+ */
+#ifndef CO_LSSmaster_FS_RESPONSE_MARGIN
+#define CO_LSSmaster_FS_RESPONSE_MARGIN 2U
+#endif
+
+/**
+ * Statistics of LSS fastscan, see #CO_LSSmaster_IdentifyFastscan. Values are
+ * accumulated since CO_LSSmaster_init() and can be read or cleared by the
+ * application.
+ */
+typedef struct {
+    uint32_t scans;         /**< Number of started fastscans */
+    uint32_t requests;      /**< Number of sent fastscan requests */
+    uint32_t responses;     /**< Number of fastscan requests with response */
+    uint32_t predicted;     /**< Number of address parts, which were confirmed
+                                 with the value from previous fastscan */
+    uint32_t bitsSkipped;   /**< Number of address bits, which were not
+                                 scanned because of prediction */
+    uint32_t restarts;      /**< Number of fastscans restarted after failed
+                                 verification */
+    uint32_t time_us;       /**< Sum of time spent in all fastscans */
+    uint32_t timeLast_us;   /**< Time spent in the last (or current) fastscan */
+} CO_LSSmaster_fsStat_t;
+#endif
+
+
 /**
  * LSS master object.
  */
@@ -114,6 +145,30 @@ typedef struct{
     uint8_t          fsLssSub;         /**< Current state of node state machine */
     uint8_t          fsBitChecked;     /**< Current scan bit position */
     uint32_t         fsIdNumber;       /**< Current scan result */
+    CO_LSS_address_t fsAfter;          /**< LSS address, after which the
+                                            next node is searched */
+    bool_t           fsAfterValid;     /**< True, if fastscan searches for the
+                                            node after fsAfter */
+    uint8_t          fsAfterPos;       /**< Position of the current candidate
+                                            bit in fsAfter,
+                                            part * 32 + 31 - bit */
+    uint8_t          fsAfterReady;     /**< Part of LSS address, at which nodes
+                                            with matching higher parts wait */
+#if ((CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER_FASTSCAN_ADAPTIVE) \
+    || defined CO_DOXYGEN
+    uint32_t         fsRxTime_us;      /**< Time of the first response to the
+                                            current fastscan request, 0 if none
+                                            yet */
+    uint32_t         fsResponse_us;    /**< Fastscan response time, the longest
+                                            measured time of the first
+                                            response. 0 if not known yet */
+    CO_LSS_address_t fsPrev;           /**< LSS address parts found by
+                                            previous fastscans */
+    uint8_t          fsPrevValid;      /**< Bit mask of valid parts in fsPrev,
+                                            bit position is
+                                            #CO_LSS_fastscan_lss_sub_next */
+    CO_LSSmaster_fsStat_t fsStat;      /**< Fastscan statistics */
+#endif
 
     volatile void   *CANrxNew;         /**< Indication if new LSS message is received from CAN bus. It needs to be cleared when received message is completely processed. */
     uint8_t          CANrxData[8];     /**< 8 data bytes of the received message */
@@ -449,6 +504,26 @@ fastscan.scan[CO_LSS_FASTSCAN_SERIAL] = CO_LSSmaster_FS_SCAN;
  * @remark When doing partial scans, it is in the responsibility of the user
  * that the LSS address is unique.
  *
+ * If CO_CONFIG_LSS_MASTER_FASTSCAN_ADAPTIVE is enabled, the scan is faster:
+ * - Response time of the slaves is measured on each request. Request with
+ *   response is finished after the measured response time, so late responses
+ *   of other slaves do not mix with the next request. Request without response
+ *   is finished after #CO_LSSmaster_FS_RESPONSE_MARGIN times the response
+ *   time. Timeout from #CO_LSSmaster_changeTimeout() is used while the
+ *   response time is not known yet, for the initial check for unconfigured
+ *   nodes and for the verification, so end of the scan and wrong scan results
+ *   are still detected reliably. If verification of the scanned value fails,
+ *   some response was too late. Measured response time is doubled and
+ *   fastscan is restarted internally, so caller does not see the timing
+ *   miss. #CO_LSSmaster_SCAN_FAILED is returned only, if verification fails
+ *   with the response time, which already reached the timeout.
+ * - For the parts with #CO_LSSmaster_FS_SCAN, value found by previous fastscan
+ *   is tried first, then its upper 16 bits. Nodes from the same series, which
+ *   share vendor ID, product code or revision number, are this way found with
+ *   a single request per such part.
+ * - Timing and prediction statistics are available in
+ *   #CO_LSSmaster_t::fsStat.
+ *
  * This function needs that no node is selected when starting the scan process.
  *
  * Function must be called cyclically until it returns != #CO_LSSmaster_WAIT_SLAVE.
@@ -467,6 +542,39 @@ CO_LSSmaster_return_t CO_LSSmaster_IdentifyFastscan(
         uint32_t                         timeDifference_us,
         CO_LSSmaster_fastscan_t         *fastscan);
 
+/**
+ * Select the node after the given LSS address by LSS identify fastscan
+ *
+ * Same as #CO_LSSmaster_IdentifyFastscan, but only nodes, whose LSS address
+ * is higher than after, are considered. Addresses are compared by the parts
+ * with #CO_LSSmaster_FS_SCAN, vendor ID first, other parts must match.
+ * Plain fastscan always selects the unconfigured node with the lowest address
+ * (unless value from previous fastscan is predicted, see
+ * CO_CONFIG_LSS_MASTER_FASTSCAN_ADAPTIVE). If that node can not be
+ * configured, it would be selected again and again. With its address in after
+ * the other nodes are found.
+ *
+ * The search checks the bits of after, which are 0, from the last one. Node,
+ * which matches the higher bits and has this bit set, follows after. Its
+ * remaining bits are scanned as usual. Each check takes one request, checks in
+ * earlier parts of the address need to verify the parts before them again.
+ *
+ * @param LSSmaster This object.
+ * @param timeDifference_us Time difference from previous function call in
+ * [microseconds]. Zero when request is started.
+ * @param fastscan struct according to #CO_LSSmaster_fastscan_t.
+ * @param after LSS address, after which node is searched. Copied, when request
+ * is started. If NULL, function is the same as #CO_LSSmaster_IdentifyFastscan.
+ * @return #CO_LSSmaster_ILLEGAL_ARGUMENT,  #CO_LSSmaster_INVALID_STATE,
+ * #CO_LSSmaster_WAIT_SLAVE, #CO_LSSmaster_SCAN_FINISHED, #CO_LSSmaster_SCAN_NOACK,
+ * #CO_LSSmaster_SCAN_FAILED
+ */
+CO_LSSmaster_return_t CO_LSSmaster_IdentifyFastscanAfter(
+        CO_LSSmaster_t                  *LSSmaster,
+        uint32_t                         timeDifference_us,
+        CO_LSSmaster_fastscan_t         *fastscan,
+        const CO_LSS_address_t          *after);
+
 /** @} */ /*@defgroup CO_LSSmaster*/
 
 #ifdef __cplusplus
@@ -47,6 +47,10 @@
  #endif
 #endif
 
+#if (CO_CONFIG_DEBUG) & CO_CONFIG_DEBUG_GTW_TABLES
+static bool_t tablesSorted(void);
+#endif
+
 /******************************************************************************/
 CO_ReturnError_t CO_GTWA_init(CO_GTWA_t* gtwa,
 #if ((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO) || defined CO_DOXYGEN
@@ -83,6 +87,11 @@ CO_ReturnError_t CO_GTWA_init(CO_GTWA_t* gtwa,
     ) {
         return CO_ERROR_ILLEGAL_ARGUMENT;
     }
+#if (CO_CONFIG_DEBUG) & CO_CONFIG_DEBUG_GTW_TABLES
+    if (!tablesSorted()) {
+        return CO_ERROR_DATA_CORRUPT;
+    }
+#endif
 
     /* clear the object */
     memset(gtwa, 0, sizeof(CO_GTWA_t));
@@ -106,6 +115,10 @@ CO_ReturnError_t CO_GTWA_init(CO_GTWA_t* gtwa,
     gtwa->node_default = -1;
     gtwa->state = CO_GTWA_ST_IDLE;
     gtwa->respHold = false;
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_READV
+    gtwa->respFifo = NULL;
+    gtwa->respFifoCount = 0;
+#endif
 
     CO_fifo_init(&gtwa->commFifo,
                  &gtwa->commBuf[0],
@@ -121,6 +134,140 @@ CO_ReturnError_t CO_GTWA_init(CO_GTWA_t* gtwa,
 }
 
 
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SLOTS
+/******************************************************************************/
+CO_ReturnError_t CO_GTWA_initSlots(CO_GTWA_t* gtwa,
+                                   CO_SDOclient_t* SDO_C,
+                                   uint8_t count)
+{
+    uint8_t i;
+
+    /* verify arguments */
+    if (gtwa == NULL || (SDO_C == NULL && count > 0)) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    if (count > CO_CONFIG_GTWA_SLOTS) {
+        count = CO_CONFIG_GTWA_SLOTS;
+    }
+    for (i = 0; i < count; i++) {
+        CO_GTWA_slot_t *slot = &gtwa->slots[i];
+
+        memset(slot, 0, sizeof(CO_GTWA_slot_t));
+        slot->SDO_C = &SDO_C[i];
+    }
+    gtwa->slotsCount = count;
+    gtwa->slotResp = NULL;
+
+    return CO_ERROR_NO;
+}
+#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SLOTS */
+
+
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SUBSCRIBE
+/******************************************************************************/
+CO_ReturnError_t CO_GTWA_initSubscribe(CO_GTWA_t* gtwa,
+#ifdef CO_GTWA_SUBSCRIBE_RPDO
+                                       CO_RPDO_t *RPDO,
+                                       uint16_t RPDOcount,
+#endif
+#ifdef CO_GTWA_SUBSCRIBE_TPDO
+                                       CO_TPDO_t *TPDO,
+                                       uint16_t TPDOcount,
+#endif
+                                       CO_CANmodule_t *CANdev,
+                                       OD_t *OD)
+{
+    /* verify arguments */
+    if (gtwa == NULL || CANdev == NULL || OD == NULL) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    gtwa->OD = OD;
+    gtwa->subsCANdev = CANdev;
+#ifdef CO_GTWA_SUBSCRIBE_RPDO
+    gtwa->RPDO = RPDO;
+    gtwa->RPDOcount = RPDO != NULL ? RPDOcount : 0;
+#endif
+#ifdef CO_GTWA_SUBSCRIBE_TPDO
+    gtwa->TPDO = TPDO;
+    gtwa->TPDOcount = TPDO != NULL ? TPDOcount : 0;
+#endif
+
+    return CO_ERROR_NO;
+}
+#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SUBSCRIBE */
+
+
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SCAN
+/******************************************************************************/
+CO_ReturnError_t CO_GTWA_initScan(CO_GTWA_t* gtwa, CO_nodeScan_t *nodeScan) {
+    /* verify arguments */
+    if (gtwa == NULL || nodeScan == NULL) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    gtwa->nodeScan = nodeScan;
+    gtwa->scanNodeId = 0;
+
+    return CO_ERROR_NO;
+}
+#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SCAN */
+
+
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_HB_STAT
+/******************************************************************************/
+CO_ReturnError_t CO_GTWA_initHBstat(CO_GTWA_t* gtwa, CO_HBconsumer_t *HBcons) {
+    /* verify arguments */
+    if (gtwa == NULL || HBcons == NULL) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    gtwa->HBcons = HBcons;
+    gtwa->hbStatIdx = 0;
+    gtwa->hbStatNodeId = 0;
+
+    return CO_ERROR_NO;
+}
+#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_HB_STAT */
+
+
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SESSIONS
+/******************************************************************************/
+CO_ReturnError_t CO_GTWA_initSessions(CO_GTWA_t* gtwa,
+                                      uint8_t count,
+                                      CO_GTWA_sessions_t *sessions)
+{
+    uint8_t i;
+
+    /* verify arguments */
+    if (gtwa == NULL || count == 0 || sessions == NULL) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    memset(sessions, 0, sizeof(CO_GTWA_sessions_t));
+    for (i = 0; i < count; i++) {
+        gtwa[i].sessions = sessions;
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO
+        /* SDO clients are configured for the node with each command */
+        CO_SDOclient_setup(gtwa[i].SDO_C, 0x80000000L, 0x80000000L, 0);
+ #if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SLOTS
+        {
+            uint8_t j;
+            for (j = 0; j < gtwa[i].slotsCount; j++) {
+                CO_SDOclient_setup(gtwa[i].slots[j].SDO_C,
+                                   0x80000000L, 0x80000000L, 0);
+            }
+        }
+ #endif
+#endif
+    }
+
+    return CO_ERROR_NO;
+}
+#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SESSIONS */
+
+
 /******************************************************************************/
 void CO_GTWA_initRead(CO_GTWA_t* gtwa,
                       size_t (*readCallback)(void *object,
@@ -132,8 +279,29 @@ void CO_GTWA_initRead(CO_GTWA_t* gtwa,
     if (gtwa != NULL) {
         gtwa->readCallback = readCallback;
         gtwa->readCallbackObject = readCallbackObject;
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_READV
+        gtwa->readvCallback = NULL;
+#endif
+    }
+}
+
+
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_READV
+/******************************************************************************/
+void CO_GTWA_initReadv(CO_GTWA_t* gtwa,
+                       size_t (*readvCallback)(void *object,
+                                               const CO_GTWA_iovec_t *iov,
+                                               uint8_t iovCount,
+                                               uint8_t *connectionOK),
+                       void *readCallbackObject)
+{
+    if (gtwa != NULL) {
+        gtwa->readCallback = NULL;
+        gtwa->readvCallback = readvCallback;
+        gtwa->readCallbackObject = readCallbackObject;
     }
 }
+#endif
 
 
 /******************************************************************************/
@@ -158,7 +326,22 @@ void CO_GTWA_log_print(CO_GTWA_t* gtwa, const char *message) {
 static const char CO_GTWA_helpString[] =
 "\nCommand strings start with '\"[\"<sequence>\"]\"' followed by:\n" \
 "[[<net>] <node>] r[ead] <index> <subindex> [<datatype>]        # SDO upload.\n" \
-"[[<net>] <node>] w[rite] <index> <subindex> <datatype> <value> # SDO download.\n" \
+"[[<net>] <node>] w[rite] <index> <subindex> <datatype> <value> # SDO download.\n"
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO_BATCH
+"[[<net>] <node>] rm <index> <subindex> <datatype> \\\n" \
+"                    [<index> <subindex> <datatype> ...]    # SDO upload batch.\n" \
+"[[<net>] <node>] wm <index> <subindex> <datatype> <value> \\\n" \
+"                    [<index> <subindex> <datatype> <value> ...]\n" \
+"                                                # SDO download batch.\n"
+#endif
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SUBSCRIBE
+"\n" \
+"subscribe od <index> <subindex> <datatype> [<interval_ms>]\n" \
+"                                         # Subscribe to local OD variable.\n" \
+"subscribe rpdo|tpdo <number> [<interval_ms>]\n" \
+"                                         # Subscribe to RPDO or TPDO.\n" \
+"unsubscribe [<sequence>]                 # Cancel one or all subscriptions.\n"
+#endif
 "\n" \
 "[[<net>] <node>] start                   # NMT Start node.\n" \
 "[[<net>] <node>] stop                    # NMT Stop node.\n" \
@@ -169,7 +352,17 @@ static const char CO_GTWA_helpString[] =
 "[<net>] set network <value>              # Set default net.\n" \
 "[<net>] set node <value>                 # Set default node.\n" \
 "[<net>] set sdo_timeout <value>          # Configure SDO client time-out in ms.\n" \
-"[<net>] set sdo_block <0|1>              # Enable/disable SDO block transfer.\n" \
+"[<net>] set sdo_block <0|1>              # Enable/disable SDO block transfer.\n"
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_BINARY
+"set binary <0|1>                         # Switch to binary framing.\n"
+#endif
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SCAN
+"\n" \
+"[<net>] scan [<timeout_ms>]              # Scan network, print node table.\n"
+#endif
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_HB_STAT
+"[<net>] hbstat [<node>]                  # Print Heartbeat statistics.\n"
+#endif
 "\n" \
 "help [datatype|lss]                      # Print this or datatype or lss help.\n" \
 "led                                      # Print status LEDs of this device.\n" \
@@ -186,7 +379,38 @@ static const char CO_GTWA_helpString[] =
 "* 'sdo_timeout' is in milliseconds, 500 by default. Block transfer is\n" \
 "  disabled by default.\n" \
 "* If '<net>' or '<node>' is not specified within commands, then value defined\n" \
-"  by 'set network' or 'set node' command is used.\r\n";
+"  by 'set network' or 'set node' command is used."
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO_BATCH
+"\n* 'rm' and 'wm' are non-standard. Objects are transferred one after another,\n" \
+"  response is one line with space separated result of each object:\n" \
+"  <value> or OK or ERROR:<SDO-abort-code>. After syntax error in the object\n" \
+"  list, ERROR:<internal-error-code> is the last result. In 'wm' command, value\n" \
+"  of the string datatype (vs, os, us, d, hex) must be the last one."
+#endif
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SUBSCRIBE
+"\n* 'subscribe' and 'unsubscribe' are non-standard. After 'OK' response, gateway\n" \
+"  prints asynchronous lines \"[\"<sequence>\"]\" <value>, tagged with sequence of\n" \
+"  the subscribe command: on change of local OD variable (up to 8 bytes long),\n" \
+"  on received RPDO or on sent TPDO (<value> is hex PDO data). Lines are not\n" \
+"  printed more often than <interval_ms>, only the latest value is printed."
+#endif
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_BINARY
+"\n* 'set binary 1' is non-standard. After 'OK' response, commands and responses\n" \
+"  are binary frames."
+#endif
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SCAN
+"\n* 'scan' is non-standard. Identity of all nodes is read concurrently, nodes\n" \
+"  which don't respond within <timeout_ms> (100 by default) are absent. Before\n" \
+"  'OK' response, one line is printed for each found node: \"# \"<node>\n" \
+"  <NMT-state> <vendorId> <productCode> <revisionNo> <serialNo>."
+#endif
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_HB_STAT
+"\n* 'hbstat' is non-standard. Before 'OK' response, one line is printed for\n" \
+"  each monitored node (or only for <node>): \"# \"<node> <count> <min_us>\n" \
+"  <avg_us> <max_us> <late> <h0> ... <h7>. Bin <hN> counts intervals from N/8\n" \
+"  to (N+1)/8 of the consumer time, <h7> also longer ones."
+#endif
+"\r\n";
 
 static const char CO_GTWA_helpStringDatatypes[] =
 "\nDatatypes:\n" \
@@ -213,6 +437,8 @@ static const char CO_GTWA_helpStringLss[] =
 "lss_inquire_addr [<LSSSUB=0..3>]       # Inquire LSS address.\n" \
 "lss_get_node                           # Inquire node-ID.\n" \
 "_lss_fastscan [<timeout_ms>]           # Identify fastscan, non-standard.\n" \
+"_lss_unlock                            # Release LSS master for other\n" \
+"                                       # sessions, non-standard.\n" \
 "lss_allnodes [<timeout_ms> [<nodeStart=1..127> <store=0|1>\\\n" \
 "                [<scanType0> <vendorId> <scanType1> <productCode>\\\n" \
 "                 <scanType2> <revisionNo> <scanType3> <serialNo>]]]\n" \
@@ -322,42 +548,55 @@ static bool_t checkNet(CO_GTWA_t *gtwa, int32_t net,
 
 
 #if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO
-/* data types for SDO read or write */
+/* data types for SDO read or write, sorted by syntax (as strcmp) for binary
+ * search */
 static const CO_GTWA_dataType_t dataTypes[] = {
-    {"hex", 0, CO_fifo_readHex2a, CO_fifo_cpyTok2Hex},  /* hex, non-standard */
     {"b",   1, CO_fifo_readU82a,  CO_fifo_cpyTok2U8},   /* BOOLEAN */
-    {"i8",  1, CO_fifo_readI82a,  CO_fifo_cpyTok2I8},   /* INTEGER8 */
+    {"d",   0, CO_fifo_readB642a, CO_fifo_cpyTok2B64},  /* DOMAIN - base64 */
+    {"hex", 0, CO_fifo_readHex2a, CO_fifo_cpyTok2Hex},  /* hex, non-standard */
     {"i16", 2, CO_fifo_readI162a, CO_fifo_cpyTok2I16},  /* INTEGER16 */
     {"i32", 4, CO_fifo_readI322a, CO_fifo_cpyTok2I32},  /* INTEGER32 */
     {"i64", 8, CO_fifo_readI642a, CO_fifo_cpyTok2I64},  /* INTEGER64 */
-    {"u8",  1, CO_fifo_readU82a,  CO_fifo_cpyTok2U8},   /* UNSIGNED8 */
+    {"i8",  1, CO_fifo_readI82a,  CO_fifo_cpyTok2I8},   /* INTEGER8 */
+    {"os",  0, CO_fifo_readB642a, CO_fifo_cpyTok2B64},  /* OCTET_STRING base64*/
+    {"r32", 4, CO_fifo_readR322a, CO_fifo_cpyTok2R32},  /* REAL32 */
+    {"r64", 8, CO_fifo_readR642a, CO_fifo_cpyTok2R64},  /* REAL64 */
     {"u16", 2, CO_fifo_readU162a, CO_fifo_cpyTok2U16},  /* UNSIGNED16 */
     {"u32", 4, CO_fifo_readU322a, CO_fifo_cpyTok2U32},  /* UNSIGNED32 */
     {"u64", 8, CO_fifo_readU642a, CO_fifo_cpyTok2U64},  /* UNSIGNED64 */
-    {"x8",  1, CO_fifo_readX82a,  CO_fifo_cpyTok2U8},   /* UNSIGNED8 */
+    {"u8",  1, CO_fifo_readU82a,  CO_fifo_cpyTok2U8},   /* UNSIGNED8 */
+    {"us",  0, CO_fifo_readB642a, CO_fifo_cpyTok2B64},/* UNICODE_STRING base64*/
+    {"vs",  0, CO_fifo_readVs2a,  CO_fifo_cpyTok2Vs},   /* VISIBLE_STRING */
     {"x16", 2, CO_fifo_readX162a, CO_fifo_cpyTok2U16},  /* UNSIGNED16 */
     {"x32", 4, CO_fifo_readX322a, CO_fifo_cpyTok2U32},  /* UNSIGNED32 */
     {"x64", 8, CO_fifo_readX642a, CO_fifo_cpyTok2U64},  /* UNSIGNED64 */
-    {"r32", 4, CO_fifo_readR322a, CO_fifo_cpyTok2R32},  /* REAL32 */
-    {"r64", 8, CO_fifo_readR642a, CO_fifo_cpyTok2R64},  /* REAL64 */
-    {"vs",  0, CO_fifo_readVs2a,  CO_fifo_cpyTok2Vs},   /* VISIBLE_STRING */
-    {"os",  0, CO_fifo_readB642a, CO_fifo_cpyTok2B64},  /* OCTET_STRING base64*/
-    {"us",  0, CO_fifo_readB642a, CO_fifo_cpyTok2B64},/* UNICODE_STRING base64*/
-    {"d",   0, CO_fifo_readB642a, CO_fifo_cpyTok2B64}   /* DOMAIN - base64 */
+    {"x8",  1, CO_fifo_readX82a,  CO_fifo_cpyTok2U8}    /* UNSIGNED8 */
 };
 
+/* generic data type, used for SDO read, if data type is not specified */
+static const CO_GTWA_dataType_t dataTypeGeneric =
+    {"hex", 0, CO_fifo_readHex2a, CO_fifo_cpyTok2Hex};
+#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO */
+
+
+/* Compare token with the name in the table entry for bsearch(). Name must be
+ * the first member of the table entry structure. */
+static int tableCompare(const void *token, const void *entry) {
+    return strcmp((const char *)token, *(const char * const *)entry);
+}
+
 
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO
 /* get data type from token */
 static const CO_GTWA_dataType_t *CO_GTWA_getDataType(char *token, bool_t *err) {
     if (token != NULL && *err == false) {
-        int i;
-        int len = sizeof(dataTypes) / sizeof(CO_GTWA_dataType_t);
+        const CO_GTWA_dataType_t *dt;
 
-        for (i = 0; i < len; i++) {
-            const CO_GTWA_dataType_t *dt = &dataTypes[i];
-            if (strcmp(token, dt->syntax) == 0) {
-                return dt;
-            }
+        dt = (const CO_GTWA_dataType_t *)bsearch(token, dataTypes,
+                                   sizeof(dataTypes) / sizeof(dataTypes[0]),
+                                   sizeof(dataTypes[0]), tableCompare);
+        if (dt != NULL) {
+            return dt;
         }
     }
 
@@ -367,40 +606,160 @@ static const CO_GTWA_dataType_t *CO_GTWA_getDataType(char *token, bool_t *err) {
 #endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO */
 
 
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_READV
+/* Pass the rest of respBuf and respFifoCount bytes from respFifo to the
+ * application in place, return count of bytes transferred. */
+static size_t respTransferv(CO_GTWA_t *gtwa, uint8_t *connectionOK) {
+    CO_GTWA_iovec_t iov[CO_GTWA_IOV_MAX];
+    uint8_t iovCount = 0;
+    size_t offset = 0;
+
+    if (gtwa->respBufCount > 0) {
+        iov[iovCount].buf = &gtwa->respBuf[gtwa->respBufOffset];
+        iov[iovCount].count = gtwa->respBufCount;
+        iovCount++;
+    }
+    while (iovCount < CO_GTWA_IOV_MAX && offset < gtwa->respFifoCount) {
+        const uint8_t *buf;
+        size_t count = CO_fifo_peek(gtwa->respFifo, offset, &buf);
+
+        if (count == 0) {
+            break;
+        }
+        if (count > (gtwa->respFifoCount - offset)) {
+            count = gtwa->respFifoCount - offset;
+        }
+        iov[iovCount].buf = (const char *)buf;
+        iov[iovCount].count = count;
+        iovCount++;
+        offset += count;
+    }
+
+    return gtwa->readvCallback(gtwa->readCallbackObject,
+                               iov, iovCount, connectionOK);
+}
+#endif
+
+
 /* transfer response buffer and verify if all bytes was read. Return true on
  * success, or false, if communication is broken. */
 static bool_t respBufTransfer(CO_GTWA_t *gtwa) {
     uint8_t connectionOK = 1;
+    size_t countRead;
 
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_READV
+    if (gtwa->readvCallback != NULL) {
+        countRead = respTransferv(gtwa, &connectionOK);
+    }
+    else
+#endif
     if (gtwa->readCallback == NULL) {
         /* no callback registered, just purge the response */
-        gtwa->respBufOffset = 0;
-        gtwa->respBufCount = 0;
-        gtwa->respHold = false;
+        countRead = gtwa->respBufCount;
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_READV
+        countRead += gtwa->respFifoCount;
+#endif
     }
     else {
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_READV
+        /* Callback has been changed in the middle of the response, copy the
+         * rest of the data from respFifo part by part. */
+        if (gtwa->respBufCount == 0 && gtwa->respFifoCount > 0) {
+            size_t count = gtwa->respFifoCount < CO_GTWA_RESP_BUF_SIZE
+                           ? gtwa->respFifoCount : CO_GTWA_RESP_BUF_SIZE;
+            gtwa->respBufCount = CO_fifo_read(gtwa->respFifo,
+                                              (uint8_t *)gtwa->respBuf,
+                                              count, NULL);
+            gtwa->respFifoCount -= gtwa->respBufCount;
+        }
+#endif
         /* transfer response to the application */
-        size_t countRead =
+        countRead =
         gtwa->readCallback(gtwa->readCallbackObject,
                            (const char *)&gtwa->respBuf[gtwa->respBufOffset],
                            gtwa->respBufCount,
                            &connectionOK);
+    }
 
-        if (countRead < gtwa->respBufCount) {
-            gtwa->respBufOffset += countRead;
-            gtwa->respBufCount -= countRead;
-            gtwa->respHold = true;
-        }
-        else {
-            gtwa->respBufOffset = 0;
-            gtwa->respBufCount = 0;
-            gtwa->respHold = false;
+    if (countRead < gtwa->respBufCount) {
+        gtwa->respBufOffset += countRead;
+        gtwa->respBufCount -= countRead;
+        gtwa->respHold = true;
+    }
+    else {
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_READV
+        /* remove transferred data from respFifo */
+        countRead -= gtwa->respBufCount;
+        if (countRead > gtwa->respFifoCount) {
+            countRead = gtwa->respFifoCount;
         }
+        gtwa->respFifoCount -= CO_fifo_skip(gtwa->respFifo, countRead);
+        gtwa->respHold = gtwa->respFifoCount > 0;
+#else
+        gtwa->respHold = false;
+#endif
+        gtwa->respBufOffset = 0;
+        gtwa->respBufCount = 0;
     }
     return connectionOK != 0;
 }
 
 
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_BINARY
+/* Write head of the binary frame with count bytes of data into buf */
+static inline void binHead(uint8_t *buf,
+                           uint32_t sequence,
+                           CO_GTWA_binCode_t code,
+                           size_t count)
+{
+    uint32_t length = (uint32_t)(count + CO_GTWA_BIN_HEAD_SIZE - 4);
+
+    (void)CO_setUint32(&buf[0], CO_SWAP_32(length));
+    (void)CO_setUint32(&buf[4], CO_SWAP_32(sequence));
+    buf[8] = (uint8_t)code;
+}
+
+/* Transfer binary response frame with optional data */
+static void binResponse(CO_GTWA_t *gtwa,
+                        uint32_t sequence,
+                        CO_GTWA_binCode_t code,
+                        const uint8_t *data,
+                        size_t count)
+{
+    uint8_t *buf = (uint8_t *)gtwa->respBuf;
+
+    if (count > (CO_GTWA_RESP_BUF_SIZE - CO_GTWA_BIN_HEAD_SIZE)) {
+        count = CO_GTWA_RESP_BUF_SIZE - CO_GTWA_BIN_HEAD_SIZE;
+    }
+    binHead(buf, sequence, code, count);
+    if (count > 0) {
+        memcpy(&buf[CO_GTWA_BIN_HEAD_SIZE], data, count);
+    }
+    gtwa->respBufCount = CO_GTWA_BIN_HEAD_SIZE + count;
+    respBufTransfer(gtwa);
+}
+
+/* Transfer binary response with gateway error code (2 bytes) or with SDO abort
+ * code (4 bytes) */
+static void binResponseError(CO_GTWA_t *gtwa,
+                             uint32_t sequence,
+                             CO_GTWA_binCode_t code,
+                             uint32_t value)
+{
+    uint8_t data[4];
+    size_t count;
+
+    if (code == CO_GTWA_BIN_RESP_ERROR) {
+        count = CO_setUint16(data, CO_SWAP_16((uint16_t)value));
+    }
+    else {
+        count = CO_setUint32(data, CO_SWAP_32(value));
+    }
+    binResponse(gtwa, sequence, code, data, count);
+}
+#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_BINARY */
+
+
 #if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_ERROR_DESC
 #ifndef CO_CONFIG_GTW_ASCII_ERROR_DESC_STRINGS
 #define CO_CONFIG_GTW_ASCII_ERROR_DESC_STRINGS
@@ -483,6 +842,14 @@ static void responseWithError(CO_GTWA_t *gtwa,
     int len = sizeof(errorDescs) / sizeof(errorDescs_t);
     const char *desc = "-";
 
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_BINARY
+    if (gtwa->binary) {
+        binResponseError(gtwa, gtwa->sequence, CO_GTWA_BIN_RESP_ERROR,
+                         (uint32_t)respErrorCode);
+        return;
+    }
+#endif
+
     for (i = 0; i < len; i++) {
         const errorDescs_t *ed = &errorDescs[i];
         if((CO_GTWA_respErrorCode_t)ed->code == respErrorCode) {
@@ -498,6 +865,7 @@ static void responseWithError(CO_GTWA_t *gtwa,
 
 #if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO
 static void responseWithErrorSDO(CO_GTWA_t *gtwa,
+                                 uint32_t sequence,
                                  CO_SDO_abortCode_t abortCode,
                                  bool_t postponed)
 {
@@ -505,6 +873,15 @@ static void responseWithErrorSDO(CO_GTWA_t *gtwa,
     int len = sizeof(errorDescsSDO) / sizeof(errorDescs_t);
     const char *desc = "-";
 
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_BINARY
+    if (gtwa->binary) {
+        (void)postponed;
+        binResponseError(gtwa, sequence, CO_GTWA_BIN_RESP_ABORT,
+                         (uint32_t)abortCode);
+        return;
+    }
+#endif
+
     for (i = 0; i < len; i++) {
         const errorDescs_t *ed = &errorDescsSDO[i];
         if((CO_SDO_abortCode_t)ed->code == abortCode) {
@@ -515,7 +892,7 @@ static void responseWithErrorSDO(CO_GTWA_t *gtwa,
     if (!postponed) {
         gtwa->respBufCount = snprintf(gtwa->respBuf, CO_GTWA_RESP_BUF_SIZE,
                                       "[%"PRId32"] ERROR:0x%08X #%s\r\n",
-                                      gtwa->sequence, abortCode, desc);
+                                      sequence, abortCode, desc);
     }
     else {
         gtwa->respBufCount = snprintf(gtwa->respBuf, CO_GTWA_RESP_BUF_SIZE,
@@ -531,6 +908,13 @@ static void responseWithErrorSDO(CO_GTWA_t *gtwa,
 static inline void responseWithError(CO_GTWA_t *gtwa,
                                      CO_GTWA_respErrorCode_t respErrorCode)
 {
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_BINARY
+    if (gtwa->binary) {
+        binResponseError(gtwa, gtwa->sequence, CO_GTWA_BIN_RESP_ERROR,
+                         (uint32_t)respErrorCode);
+        return;
+    }
+#endif
     gtwa->respBufCount = snprintf(gtwa->respBuf, CO_GTWA_RESP_BUF_SIZE,
                                   "[%"PRId32"] ERROR:%d\r\n",
                                   gtwa->sequence, respErrorCode);
@@ -539,13 +923,22 @@ static inline void responseWithError(CO_GTWA_t *gtwa,
 
 #if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO
 static inline void responseWithErrorSDO(CO_GTWA_t *gtwa,
+                                        uint32_t sequence,
                                         CO_SDO_abortCode_t abortCode,
                                         bool_t postponed)
 {
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_BINARY
+    if (gtwa->binary) {
+        (void)postponed;
+        binResponseError(gtwa, sequence, CO_GTWA_BIN_RESP_ABORT,
+                         (uint32_t)abortCode);
+        return;
+    }
+#endif
     if (!postponed) {
         gtwa->respBufCount = snprintf(gtwa->respBuf, CO_GTWA_RESP_BUF_SIZE,
                                       "[%"PRId32"] ERROR:0x%08X\r\n",
-                                      gtwa->sequence, abortCode);
+                                      sequence, abortCode);
     }
     else {
         gtwa->respBufCount = snprintf(gtwa->respBuf, CO_GTWA_RESP_BUF_SIZE,
@@ -559,13 +952,23 @@ static inline void responseWithErrorSDO(CO_GTWA_t *gtwa,
 #endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_ERROR_DESC */
 
 
-static inline void responseWithOK(CO_GTWA_t *gtwa) {
+static void responseWithOKseq(CO_GTWA_t *gtwa, uint32_t sequence) {
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_BINARY
+    if (gtwa->binary) {
+        binResponse(gtwa, sequence, CO_GTWA_BIN_RESP_OK, NULL, 0);
+        return;
+    }
+#endif
     gtwa->respBufCount = snprintf(gtwa->respBuf, CO_GTWA_RESP_BUF_SIZE,
                                   "[%"PRId32"] OK\r\n",
-                                  gtwa->sequence);
+                                  sequence);
     respBufTransfer(gtwa);
 }
 
+static inline void responseWithOK(CO_GTWA_t *gtwa) {
+    responseWithOKseq(gtwa, gtwa->sequence);
+}
+
 
 static inline void responseWithEmpty(CO_GTWA_t *gtwa) {
     gtwa->respBufCount = snprintf(gtwa->respBuf, CO_GTWA_RESP_BUF_SIZE,
@@ -612,915 +1015,2863 @@ static inline void convertToLower(char *token, size_t maxCount) {
 }
 
 
-/*******************************************************************************
- * PROCESS FUNCTION
- ******************************************************************************/
-void CO_GTWA_process(CO_GTWA_t *gtwa,
-                     bool_t enable,
-                     uint32_t timeDifference_us,
-                     uint32_t *timerNext_us)
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_BINARY
+/* Transfer data from SDO client fifo as binary response of the upload command,
+ * see responseUpload(). Each part of the data is own frame, the last one has
+ * code CO_GTWA_BIN_RESP_OK. */
+static bool_t binResponseUpload(CO_GTWA_t *gtwa,
+                                CO_SDOclient_t *SDO_C,
+                                uint32_t sequence,
+                                bool_t end)
 {
-    (void)timerNext_us; /* may be unused */
+    uint8_t *buf = (uint8_t *)gtwa->respBuf;
+    size_t fifoRemain;
+    bool_t finished = false;
+
+    do {
+        size_t count;
+        size_t countBuf; /* count of data bytes in respBuf */
+
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_READV
+        if (gtwa->readvCallback != NULL) {
+            /* All data from the fifo in one frame, it will be passed to the
+             * application in place, after the frame head. */
+            count = CO_fifo_getOccupied(&SDO_C->bufFifo);
+            countBuf = 0;
+            gtwa->respFifo = &SDO_C->bufFifo;
+            gtwa->respFifoCount = count;
+            fifoRemain = 0;
+        }
+        else
+#endif
+        {
+            countBuf = count = CO_fifo_read(&SDO_C->bufFifo,
+                                            &buf[CO_GTWA_BIN_HEAD_SIZE],
+                                            CO_GTWA_RESP_BUF_SIZE
+                                            - CO_GTWA_BIN_HEAD_SIZE,
+                                            NULL);
+            fifoRemain = CO_fifo_getOccupied(&SDO_C->bufFifo);
+        }
 
-    bool_t err = false; /* syntax or other error, true or false, I/O variable */
-    int8_t closed; /* indication of command delimiter, I/O variable */
-    CO_GTWA_respErrorCode_t respErrorCode = CO_GTWA_respErrorNone;
+        if (end && fifoRemain == 0) {
+            finished = true;
+        }
+        else if (count == 0) {
+            break;
+        }
+        binHead(buf, sequence,
+                finished ? CO_GTWA_BIN_RESP_OK : CO_GTWA_BIN_RESP_PARTIAL,
+                count);
+        gtwa->respBufCount = CO_GTWA_BIN_HEAD_SIZE + countBuf;
+
+        if (respBufTransfer(gtwa) == false) {
+            /* broken communication, send SDO abort and force finish. */
+            CO_SDO_abortCode_t abortCode = CO_SDO_AB_DATA_TRANSF;
+            CO_SDOclientUpload(SDO_C, 0, true, &abortCode, NULL, NULL, NULL);
+            finished = true;
+            break;
+        }
+    } while (gtwa->respHold == false && fifoRemain > 0);
 
-    if (gtwa == NULL) {
-        return;
-    }
+    return finished;
+}
+#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_BINARY */
 
-    if (!enable) {
-        gtwa->state = CO_GTWA_ST_IDLE;
-        CO_fifo_reset(&gtwa->commFifo);
-        return;
+
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO
+/* Print data from SDO client fifo as ascii response of the upload command.
+ * Repeat until application runs out of space (respHold) or fifo is empty.
+ * If not last, value is followed by space instead of the end of the line.
+ * Return true, if response is finished or if communication is broken. */
+static bool_t responseUpload(CO_GTWA_t *gtwa,
+                             CO_SDOclient_t *SDO_C,
+                             const CO_GTWA_dataType_t *dataType,
+                             uint32_t sequence,
+                             bool_t *started,
+                             bool_t end,
+                             bool_t last)
+{
+    size_t fifoRemain;
+    bool_t finished = false;
+
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_BINARY
+    if (gtwa->binary) {
+        (void)dataType;
+        (void)last;
+        *started = true;
+        return binResponseUpload(gtwa, SDO_C, sequence, end);
     }
+#endif
 
-    /* If there is some more output data for application, read them first.
-     * Hold on this state, if necessary. */
-    if (gtwa->respHold) {
-        timeDifference_us += gtwa->timeDifference_us_cumulative;
+    /* write response head first */
+    if (!*started) {
+        gtwa->respBufCount = snprintf(gtwa->respBuf,
+                                      CO_GTWA_RESP_BUF_SIZE - 2,
+                                      "[%"PRId32"] ",
+                                      sequence);
+        *started = true;
+    }
 
-        respBufTransfer(gtwa);
-        if (gtwa->respHold) {
-            gtwa->timeDifference_us_cumulative = timeDifference_us;
-            return;
+    do {
+        /* read SDO fifo (partially) and print specific data type as ascii
+         * into intermediate respBuf */
+        gtwa->respBufCount += dataType->dataTypePrint(
+            &SDO_C->bufFifo,
+            &gtwa->respBuf[gtwa->respBufCount],
+            CO_GTWA_RESP_BUF_SIZE - 2 - gtwa->respBufCount,
+            end);
+        fifoRemain = CO_fifo_getOccupied(&SDO_C->bufFifo);
+
+        /* end of communication, print newline */
+        if (end && fifoRemain == 0) {
+            gtwa->respBufCount += sprintf(&gtwa->respBuf[gtwa->respBufCount],
+                                          last ? "\r\n" : " ");
+            finished = true;
         }
-        else {
-            gtwa->timeDifference_us_cumulative = 0;
+
+        /* transfer response to the application */
+        if (respBufTransfer(gtwa) == false) {
+            /* broken communication, send SDO abort and force finish. */
+            CO_SDO_abortCode_t abortCode = CO_SDO_AB_DATA_TRANSF;
+            CO_SDOclientUpload(SDO_C, 0, true, &abortCode, NULL, NULL, NULL);
+            finished = true;
+            break;
         }
-    }
+    } while (gtwa->respHold == false && fifoRemain > 0);
 
-    /***************************************************************************
-    * COMMAND PARSER
-    ***************************************************************************/
-    /* if idle, search for new command, skip comments or empty lines */
-    while (gtwa->state == CO_GTWA_ST_IDLE
-           && CO_fifo_CommSearch(&gtwa->commFifo, false)
-    ) {
-        char tok[20];
-        size_t n;
-        uint32_t ui[3];
-        int i;
-        int32_t net = gtwa->net_default;
-        int16_t node = gtwa->node_default;
+    return finished;
+}
+#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO */
 
 
-        /* parse mandatory token '"["<sequence>"]"' */
-        closed = -1;
-        n = CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok), &closed, &err);
-        /* Break if error in token or token was found, but closed with
-         * command delimiter. */
-        if (err || (n > 0 && closed != 0)) {
-            err = true;
-            break;
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO_BATCH
+/* Print result of one object of the 'rm' or 'wm' command into the response
+ * line: ERROR:<internal-error-code> if respErrorCode is set, else
+ * ERROR:<SDO-abort-code> if abortCode is set, else OK. */
+static void responseBatch(CO_GTWA_t *gtwa,
+                          CO_SDO_abortCode_t abortCode,
+                          CO_GTWA_respErrorCode_t respErrorCode)
+{
+    const char *end = gtwa->SDObatchLast ? "\r\n" : " ";
+    size_t count = 0;
+
+    if (!gtwa->SDObatchRespStarted) {
+        count = snprintf(gtwa->respBuf, CO_GTWA_RESP_BUF_SIZE,
+                         "[%"PRId32"] ", gtwa->sequence);
+        gtwa->SDObatchRespStarted = true;
+    }
+
+    if (respErrorCode != CO_GTWA_respErrorNone) {
+        count += snprintf(&gtwa->respBuf[count], CO_GTWA_RESP_BUF_SIZE - count,
+                          "ERROR:%d%s", respErrorCode, end);
+    }
+    else if (abortCode != CO_SDO_AB_NONE) {
+        count += snprintf(&gtwa->respBuf[count], CO_GTWA_RESP_BUF_SIZE - count,
+                          "ERROR:0x%08X%s", abortCode, end);
+    }
+    else {
+        count += snprintf(&gtwa->respBuf[count], CO_GTWA_RESP_BUF_SIZE - count,
+                          "OK%s", end);
+    }
+
+    gtwa->respBufCount = count;
+    respBufTransfer(gtwa);
+}
+
+/* Parse next object of the 'rm' command ('<index> <subindex> <datatype>') or
+ * of the 'wm' command ('<index> <subindex> <datatype> <value>') and initiate
+ * SDO transfer with already configured SDO client. Return false on error, in
+ * that case the rest of the command is cleared. */
+static bool_t batchStart(CO_GTWA_t *gtwa,
+                         bool_t download,
+                         CO_GTWA_respErrorCode_t *respErrorCode)
+{
+    char tok[20];
+    int8_t closed = 0;
+    bool_t err = false;
+    uint16_t idx = 0;
+    uint8_t subidx = 0;
+    CO_SDO_return_t SDO_ret;
+
+    /* index */
+    CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok), &closed, &err);
+    if (!err) {
+        idx = (uint16_t)getU32(tok, 0, 0xFFFF, &err);
+    }
+
+    /* subindex */
+    if (!err) {
+        closed = 0;
+        CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok), &closed, &err);
+        if (!err) {
+            subidx = (uint8_t)getU32(tok, 0, 0xFF, &err);
         }
-        /* If empty line or just comment, continue with next command */
-        else if (n == 0 && closed != 0) {
-            responseWithEmpty(gtwa);
-            continue;
+    }
+
+    /* data type, it closes the 'rm' command after the last object */
+    if (!err) {
+        closed = download ? 0 : -1;
+        CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok), &closed, &err);
+        if (!err) {
+            convertToLower(tok, sizeof(tok));
+            gtwa->SDOdataType = CO_GTWA_getDataType(tok, &err);
+            gtwa->SDObatchLast = closed == 1;
         }
-        if (tok[0] != '[' || tok[strlen(tok)-1] != ']') {
+    }
+
+    /* initiate transfer */
+    if (!err) {
+        if (download) {
+            SDO_ret = CO_SDOclientDownloadInitiate(gtwa->SDO_C, idx, subidx,
+                                                 gtwa->SDOdataType->length,
+                                                 gtwa->SDOtimeoutTime,
+                                                 gtwa->SDOblockTransferEnable);
+        }
+        else {
+            SDO_ret = CO_SDOclientUploadInitiate(gtwa->SDO_C, idx, subidx,
+                                                 gtwa->SDOtimeoutTime,
+                                                 gtwa->SDOblockTransferEnable);
+        }
+        if (SDO_ret != CO_SDO_RT_ok_communicationEnd) {
+            *respErrorCode = CO_GTWA_respErrorInternalState;
             err = true;
-            break;
         }
-        tok[strlen(tok)-1] = '\0';
-        gtwa->sequence = getU32(tok + 1, 0, 0xFFFFFFFF, &err);
-        if (err) break;
+    }
 
+    /* copy value from comm to the SDO buffer, according to data type */
+    if (!err && download) {
+        CO_fifo_st status;
+        size_t size = gtwa->SDOdataType->dataTypeScan(&gtwa->SDO_C->bufFifo,
+                                                      &gtwa->commFifo,
+                                                      &status);
+        closed = ((status & CO_fifo_st_closed) == 0) ? 0 : 1;
+        gtwa->SDOdataCopyStatus = (status & CO_fifo_st_partial) != 0;
+        gtwa->SDObatchLast = closed == 1;
+
+        if ((status & CO_fifo_st_errMask) != 0 || size == 0) {
+            err = true;
+        }
+        /* if data size was not known before and is known now, update SDO */
+        else if (gtwa->SDOdataType->length == 0 && !gtwa->SDOdataCopyStatus) {
+            CO_SDOclientDownloadInitiateSize(gtwa->SDO_C, size);
+        }
+    }
 
-        /* parse optional tokens '[[<net>] <node>]', both numerical. Then
-         * follows mandatory token <command>, which is not numerical. */
-        for (i = 0; i < 3; i++) {
-            closed = -1;
-            n = CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok),
-                                  &closed, &err);
-            if (err || n == 0) {
-                /* empty token, break on error */
-                err = true;
-                break;
-            } else if (isdigit((int)tok[0]) == 0) {
-                /* <command> found */
-                break;
-            } else if (closed != 0) {
-                /* numerical value must not be closed */
-                err = true;
-                break;
-            }
+    if (err) {
+        if (closed != 1) {
+            CO_fifo_CommSearch(&gtwa->commFifo, true);
+        }
+        gtwa->SDObatchLast = true;
+        gtwa->SDOdataCopyStatus = false;
+    }
+    return !err;
+}
 
-            ui[i] = getU32(tok, 0, 0xFFFFFFFF, &err);
-            if (err) break;
+/* Object of the 'rm' or 'wm' command is finished and its result is printed.
+ * Return true, if command continues with the next object. */
+static inline bool_t batchFinished(CO_GTWA_t *gtwa) {
+    gtwa->SDObatchNext = gtwa->SDObatch && !gtwa->SDObatchLast;
+    return gtwa->SDObatchNext;
+}
+
+/* Start the next object of the 'rm' or 'wm' command, if pending. It is started
+ * after the result of the previous object is transferred to the application.
+ * Return false on error, which is printed as the last result. */
+static bool_t batchNext(CO_GTWA_t *gtwa, bool_t download) {
+    CO_GTWA_respErrorCode_t respErrorCode = CO_GTWA_respErrorSyntax;
+
+    if (gtwa->SDObatch && gtwa->SDObatchNext) {
+        gtwa->SDObatchNext = false;
+        if (!batchStart(gtwa, download, &respErrorCode)) {
+            responseBatch(gtwa, CO_SDO_AB_NONE, respErrorCode);
+            return false;
         }
-        if (err) break;
+        gtwa->stateTimeoutTmr = 0;
+    }
+    return true;
+}
+#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO_BATCH */
 
-        switch(i) {
-        case 0: /* only <command> (pointed by token) */
+
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO
+/* Setup SDO client for the node. With sessions, mark the node as busy. */
+static CO_SDO_return_t clientSetup(CO_GTWA_t *gtwa,
+                                   CO_SDOclient_t *SDO_C,
+                                   uint8_t node)
+{
+    CO_SDO_return_t SDO_ret = CO_SDOclient_setup(SDO_C,
+                                                 CO_CAN_ID_SDO_CLI + node,
+                                                 CO_CAN_ID_SDO_SRV + node,
+                                                 node);
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SESSIONS
+    if (gtwa->sessions != NULL && SDO_ret == CO_SDO_RT_ok_communicationEnd) {
+        gtwa->sessions->nodeBusy[node >> 5] |= 1UL << (node & 0x1F);
+    }
+#else
+    (void)gtwa;
+#endif
+    return SDO_ret;
+}
+
+#if (CO_CONFIG_GTW) & (CO_CONFIG_GTW_ASCII_SLOTS|CO_CONFIG_GTW_ASCII_SESSIONS)
+/* Disable SDO client, so it will not receive CAN messages from the node, which
+ * may be accessed by other SDO client. */
+static void clientRelease(CO_GTWA_t *gtwa, CO_SDOclient_t *SDO_C) {
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SESSIONS
+    uint8_t node = SDO_C->nodeIDOfTheSDOServer;
+
+    if (gtwa->sessions != NULL && node >= 1 && node <= 127) {
+        gtwa->sessions->nodeBusy[node >> 5] &= ~(1UL << (node & 0x1F));
+    }
+#else
+    (void)gtwa;
+#endif
+    CO_SDOclient_setup(SDO_C, 0x80000000L, 0x80000000L, 0);
+}
+#endif
+
+/* Continue SDO upload. If SDO server is this node, data are first read from
+ * own Object Dictionary in single pass with CO_SDOclientUploadLocal() and
+ * written into the SDO buffer, as they would be with remote transfer. */
+static CO_SDO_return_t clientUpload(CO_SDOclient_t *SDO_C,
+                                    uint32_t timeDifference_us,
+                                    CO_SDO_abortCode_t *abortCode,
+                                    uint32_t *timerNext_us)
+{
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_LOCAL
+    if (SDO_C->nodeIDOfTheSDOServer == SDO_C->nodeId) {
+        uint8_t buf[CO_CONFIG_SDO_CLI_BUFFER_SIZE];
+        size_t count = CO_fifo_getSpace(&SDO_C->bufFifo);
+        size_t countRead = 0;
+        CO_SDO_return_t ret;
+
+        if (count > sizeof(buf)) {
+            count = sizeof(buf);
+        }
+        ret = CO_SDOclientUploadLocal(SDO_C, buf, count, &countRead, abortCode);
+        /* wrongArguments: transfer is already streamed by regular function */
+        if (ret != CO_SDO_RT_wrongArguments) {
+            CO_fifo_write(&SDO_C->bufFifo, buf, countRead, NULL);
+            return ret;
+        }
+    }
+#endif
+    return CO_SDOclientUpload(SDO_C, timeDifference_us, false, abortCode,
+                              NULL, NULL, timerNext_us);
+}
+
+/* Continue SDO download. If SDO server is this node and all data are in the
+ * SDO buffer, they are written to own Object Dictionary in single pass with
+ * CO_SDOclientDownloadLocal(). */
+static CO_SDO_return_t clientDownload(CO_SDOclient_t *SDO_C,
+                                      uint32_t timeDifference_us,
+                                      bool_t abort,
+                                      bool_t bufferPartial,
+                                      CO_SDO_abortCode_t *abortCode,
+                                      uint32_t *timerNext_us)
+{
+    CO_SDO_return_t ret;
+    int loop = 0;
+
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_LOCAL
+    size_t count = CO_fifo_getOccupied(&SDO_C->bufFifo);
+
+    if (SDO_C->nodeIDOfTheSDOServer == SDO_C->nodeId
+        && !abort && !bufferPartial
+        && count > 0 && count <= CO_CONFIG_SDO_CLI_BUFFER_SIZE
+    ) {
+        uint8_t buf[CO_CONFIG_SDO_CLI_BUFFER_SIZE];
+
+        count = CO_fifo_read(&SDO_C->bufFifo, buf, count, NULL);
+        ret = CO_SDOclientDownloadLocal(SDO_C, buf, count, abortCode);
+        if (ret != CO_SDO_RT_wrongArguments) {
+            return ret;
+        }
+        /* transfer is already streamed by regular function, return data */
+        CO_fifo_write(&SDO_C->bufFifo, buf, count, NULL);
+    }
+#endif
+
+    /* if OS has CANtx queue, speedup block transfer */
+    do {
+        ret = CO_SDOclientDownload(SDO_C, timeDifference_us, abort,
+                                   bufferPartial, abortCode, NULL,
+                                   timerNext_us);
+        timeDifference_us = 0;
+        if (++loop >= CO_CONFIG_GTW_BLOCK_DL_LOOP) {
             break;
-        case 1: /* <node> and <command> tokens */
-            if (ui[0] > 127) {
-                err = true;
-                respErrorCode = CO_GTWA_respErrorUnsupportedNode;
+        }
+    } while (ret == CO_SDO_RT_blockDownldInProgress);
+
+    return ret;
+}
+
+/* Return true, if node is accessed from any slot or from other session */
+static bool_t nodeBusy(CO_GTWA_t *gtwa, uint8_t node) {
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SLOTS
+    uint8_t i;
+
+    for (i = 0; i < gtwa->slotsCount; i++) {
+        if (gtwa->slots[i].node == node) {
+            return true;
+        }
+    }
+#endif
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SESSIONS
+    /* SDO client from CO_GTWA_init() may already be configured for node */
+    if (gtwa->sessions != NULL && gtwa->SDO_C->nodeIDOfTheSDOServer != node
+        && (gtwa->sessions->nodeBusy[node >> 5] & (1UL << (node & 0x1F))) != 0
+    ) {
+        return true;
+    }
+ #if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SCAN
+    /* network scan receives responses of all SDO servers */
+    if (gtwa->sessions != NULL && gtwa->sessions->scanOwner != NULL
+        && gtwa->sessions->scanOwner != gtwa
+    ) {
+        return true;
+    }
+ #endif
+#endif
+    (void)gtwa; (void)node; /* may be unused */
+    return false;
+}
+#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO */
+
+
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SLOTS
+
+/* Get free slot for the node. Return NULL, if all slots are busy or if node
+ * is already accessed from other slot. */
+static CO_GTWA_slot_t *slotGet(CO_GTWA_t *gtwa, uint8_t node) {
+    CO_GTWA_slot_t *slotFree = NULL;
+    uint8_t i;
+
+    for (i = 0; i < gtwa->slotsCount; i++) {
+        CO_GTWA_slot_t *slot = &gtwa->slots[i];
+        if (slot->node == node) {
+            return NULL;
+        }
+        if (slot->node == 0 && slotFree == NULL) {
+            slotFree = slot;
+        }
+    }
+    return slotFree;
+}
+
+static void slotRelease(CO_GTWA_t *gtwa, CO_GTWA_slot_t *slot) {
+    clientRelease(gtwa, slot->SDO_C);
+    slot->node = 0;
+    if (gtwa->slotResp == slot) {
+        gtwa->slotResp = NULL;
+    }
+}
+
+/* Process SDO upload or download in all busy slots. Response is printed, when
+ * output is available: not held and not occupied by response from other slot.
+ */
+static void slotsProcess(CO_GTWA_t *gtwa,
+                         uint32_t timeDifference_us,
+                         uint32_t *timerNext_us)
+{
+    uint8_t i;
+
+    for (i = 0; i < gtwa->slotsCount; i++) {
+        CO_GTWA_slot_t *slot = &gtwa->slots[i];
+        CO_SDO_return_t ret = CO_SDO_RT_waitingResponse;
+
+        if (slot->node == 0) {
+            continue;
+        }
+
+        if (!slot->aborted) {
+            CO_SDO_abortCode_t abortCode;
+
+            if (slot->download) {
+                ret = clientDownload(slot->SDO_C, timeDifference_us, false,
+                                     false, &abortCode, timerNext_us);
             }
             else {
-                node = (int16_t) ui[0];
-            }
-            break;
-        case 2: /* <net>, <node> and <command> tokens */
-            if (ui[0] > 0xFFFF) {
-                err = true;
-                respErrorCode = CO_GTWA_respErrorUnsupportedNet;
-            }
-            else if (ui[1] > 127) {
-                err = true;
-                respErrorCode = CO_GTWA_respErrorUnsupportedNode;
+                ret = clientUpload(slot->SDO_C, timeDifference_us,
+                                   &abortCode, timerNext_us);
             }
-            else {
-                net = (int32_t) ui[0];
-                node = (int16_t) ui[1];
+            if (ret < 0) {
+                slot->aborted = true;
+                slot->abortCode = abortCode;
             }
-            break;
-        case 3: /* <command> token contains digit */
-            err = true;
-            break;
         }
-        if (err) break;
 
-        /* command is case insensitive */
-        convertToLower(tok, sizeof(tok));
+        if (gtwa->respHold
+            || (gtwa->slotResp != NULL && gtwa->slotResp != slot)
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO_BATCH
+            || (gtwa->state != CO_GTWA_ST_IDLE && gtwa->SDObatch
+                && gtwa->SDObatchRespStarted)
+#endif
+        ) {
+            /* output is not available, data waits in SDO fifo */
+            continue;
+        }
 
-        /* set command - multiple sub commands */
-        if (strcmp(tok, "set") == 0) {
-            if (closed != 0) {
-                err = true;
-                break;
+        if (slot->aborted) {
+            responseWithErrorSDO(gtwa, slot->sequence, slot->abortCode,
+                                 slot->SDOdataCopyStatus);
+            slotRelease(gtwa, slot);
+        }
+        else if (slot->download) {
+            if (ret == CO_SDO_RT_ok_communicationEnd) {
+                responseWithOKseq(gtwa, slot->sequence);
+                slotRelease(gtwa, slot);
             }
+        }
+        else if (ret == CO_SDO_RT_uploadDataBufferFull
+                 || ret == CO_SDO_RT_ok_communicationEnd
+        ) {
+            gtwa->slotResp = slot;
+            if (responseUpload(gtwa, slot->SDO_C, slot->SDOdataType,
+                               slot->sequence, &slot->SDOdataCopyStatus,
+                               ret == CO_SDO_RT_ok_communicationEnd, true)
+            ) {
+                slotRelease(gtwa, slot);
+            }
+        }
+    }
+}
+#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SLOTS */
 
-            /* command 2 */
-            closed = -1;
-            CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok), &closed, &err);
-            if (err) break;
-
-            convertToLower(tok, sizeof(tok));
-            /* 'set network <value>' */
-            if (strcmp(tok, "network") == 0) {
-                uint16_t value;
 
-                if (closed != 0) {
-                    err = true;
-                    break;
-                }
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SUBSCRIBE
+#ifdef CO_GTWA_SUBSCRIBE_PDO
+/* PDO event callback, copy PDO data and signal new event to subsProcess().
+ * Called from the same thread as PDO processing. */
+static void subPDOevent(void *object,
+                        const uint8_t *data,
+                        CO_PDO_size_t dataLength)
+{
+    CO_GTWA_sub_t *sub = (CO_GTWA_sub_t *)object;
 
-                /* value */
-                closed = 1;
-                CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok),
-                                  &closed, &err);
-                value = (uint16_t)getU32(tok, CO_CONFIG_GTW_NET_MIN,
-                                         CO_CONFIG_GTW_NET_MAX, &err);
-                if (err) break;
+    if (dataLength > sizeof(sub->data)) {
+        dataLength = sizeof(sub->data);
+    }
+    memcpy(sub->data, data, dataLength);
+    sub->dataLength = (uint8_t)dataLength;
+    CO_FLAG_SET(sub->eventNew);
+}
+#endif
 
-                gtwa->net_default = value;
-                responseWithOK(gtwa);
-            }
-            /* 'set node <value>' */
-            else if (strcmp(tok, "node") == 0) {
-                bool_t NodeErr = checkNet(gtwa, net, &respErrorCode);
-                uint8_t value;
+static void subRelease(CO_GTWA_sub_t *sub) {
+#ifdef CO_GTWA_SUBSCRIBE_PDO
+    if (sub->PDO != NULL) {
+        CO_LOCK_OD(sub->PDO->CANdev);
+        CO_PDO_initCallbackEvent(sub->PDO, NULL, NULL);
+        CO_UNLOCK_OD(sub->PDO->CANdev);
+        sub->PDO = NULL;
+    }
+#endif
+    sub->type = CO_GTWA_SUB_FREE;
+}
 
-                if (closed != 0 || NodeErr) {
-                    err = true;
-                    break;
-                }
+/* Return true, if response of other command has started and is not finished
+ * yet. Values of subscriptions are printed between the responses. */
+static bool_t subsOutputBusy(CO_GTWA_t *gtwa) {
+    bool_t busy = gtwa->respHold
+                  || (gtwa->state == CO_GTWA_ST_READ
+                      && gtwa->SDOdataCopyStatus)
+                  || gtwa->state == CO_GTWA_ST_LOG
+                  || gtwa->state == CO_GTWA_ST_HELP
+                  || gtwa->state == CO_GTWA_ST_LED;
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SLOTS
+    busy = busy || gtwa->slotResp != NULL;
+#endif
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO_BATCH
+    busy = busy || (gtwa->state != CO_GTWA_ST_IDLE && gtwa->SDObatch
+                    && gtwa->SDObatchRespStarted);
+#endif
+    return busy;
+}
 
-                /* value */
-                closed = 1;
-                CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok),
-                                  &closed, &err);
-                value = (uint8_t)getU32(tok, 1, 127, &err);
-                if (err) break;
+/* Print value of the subscription as '"["<sequence>"]" <value>' line */
+static void subPrint(CO_GTWA_t *gtwa,
+                     CO_GTWA_sub_t *sub,
+                     const uint8_t *data,
+                     uint8_t dataLength)
+{
+    CO_fifo_t fifo;
+    uint8_t fifoBuf[sizeof(sub->data) + 1];
 
-                gtwa->node_default = value;
-                responseWithOK(gtwa);
-            }
-#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO
-            /* 'set sdo_timeout <value_ms>' */
-            else if (strcmp(tok, "sdo_timeout") == 0) {
-                bool_t NodeErr = checkNet(gtwa, net, &respErrorCode);
-                uint16_t value;
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_BINARY
+    if (gtwa->binary) {
+        binResponse(gtwa, sub->sequence, CO_GTWA_BIN_RESP_SUBSCRIPTION,
+                    data, dataLength);
+        return;
+    }
+#endif
 
-                if (closed != 0 || NodeErr) {
-                    err = true;
-                    break;
-                }
+    CO_fifo_init(&fifo, fifoBuf, sizeof(fifoBuf));
+    CO_fifo_reset(&fifo);
+    CO_fifo_write(&fifo, data, dataLength, NULL);
+
+    gtwa->respBufCount = snprintf(gtwa->respBuf, CO_GTWA_RESP_BUF_SIZE - 2,
+                                  "[%"PRId32"] ", sub->sequence);
+    gtwa->respBufCount += sub->dataType->dataTypePrint(
+        &fifo,
+        &gtwa->respBuf[gtwa->respBufCount],
+        CO_GTWA_RESP_BUF_SIZE - 2 - gtwa->respBufCount,
+        true);
+    gtwa->respBufCount += sprintf(&gtwa->respBuf[gtwa->respBufCount], "\r\n");
+    respBufTransfer(gtwa);
+}
 
-                /* value */
-                closed = 1;
-                CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok),
-                                  &closed, &err);
-                value = (uint16_t)getU32(tok, 1, 0xFFFF, &err);
-                if (err) break;
+/* Sample subscribed OD variables and print changed values or pending PDO data,
+ * if interval of the subscription expired and output is available. */
+static void subsProcess(CO_GTWA_t *gtwa,
+                        uint32_t timeDifference_us,
+                        uint32_t *timerNext_us)
+{
+    bool_t busy = subsOutputBusy(gtwa);
+    uint8_t j;
 
-                gtwa->SDOtimeoutTime = value;
-                responseWithOK(gtwa);
-            }
-            /* 'set sdo_timeout <0|1>' */
-            else if (strcmp(tok, "sdo_block") == 0) {
-                bool_t NodeErr = checkNet(gtwa, net, &respErrorCode);
-                uint16_t value;
+    for (j = 1; j <= CO_CONFIG_GTWA_SUBSCRIPTIONS; j++) {
+        uint8_t i = (gtwa->subsLast + j) % CO_CONFIG_GTWA_SUBSCRIPTIONS;
+        CO_GTWA_sub_t *sub = &gtwa->subs[i];
+        uint8_t buf[sizeof(sub->data)];
+        uint8_t bufLength = 0;
+        bool_t due = sub->type == CO_GTWA_SUB_OD;
 
-                if (closed != 0 || NodeErr) {
-                    err = true;
-                    break;
-                }
+        if (sub->type == CO_GTWA_SUB_FREE) {
+            continue;
+        }
 
-                /* value */
-                closed = 1;
-                CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok),
-                                  &closed, &err);
-                value = (uint16_t)getU32(tok, 0, 1, &err);
-                if (err) break;
+        /* timer is saturated at interval */
+        if (sub->interval_us - sub->timer_us > timeDifference_us) {
+            sub->timer_us += timeDifference_us;
+        }
+        else {
+            sub->timer_us = sub->interval_us;
+        }
 
-                gtwa->SDOblockTransferEnable = value==1 ? true : false;
-                responseWithOK(gtwa);
-            }
-#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO */
-            else {
-                respErrorCode = CO_GTWA_respErrorReqNotSupported;
-                err = true;
-                break;
+#ifdef CO_GTWA_SUBSCRIBE_PDO
+        if (sub->type != CO_GTWA_SUB_OD) {
+            due = CO_FLAG_READ(sub->eventNew);
+        }
+#endif
+        if (!due || busy) {
+            continue;
+        }
+        if (sub->timer_us < sub->interval_us) {
+            /* rate limited, sample OD variable or print PDO data later */
+            uint32_t diff = sub->interval_us - sub->timer_us;
+            if (timerNext_us != NULL && *timerNext_us > diff) {
+                *timerNext_us = diff;
             }
+            continue;
         }
 
-#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO
-        /* Upload SDO command - 'r[ead] <index> <subindex> <datatype>' */
-        else if (strcmp(tok, "r") == 0 || strcmp(tok, "read") == 0) {
-            uint16_t idx;
-            uint8_t subidx;
-            CO_SDO_return_t SDO_ret;
-            bool_t NodeErr = checkNetNode(gtwa, net, node, 1, &respErrorCode);
-
-            if (closed != 0 || NodeErr) {
-                err = true;
-                break;
+        if (sub->type == CO_GTWA_SUB_OD) {
+            OD_size_t countRd = 0;
+            ODR_t odRet;
+            bool_t lock = OD_mappable(&sub->OD_IO.stream);
+
+            if (lock) { CO_LOCK_OD(gtwa->subsCANdev); }
+            sub->OD_IO.stream.dataOffset = 0;
+            odRet = sub->OD_IO.read(&sub->OD_IO.stream, buf, sizeof(buf),
+                                    &countRd);
+            if (lock) { CO_UNLOCK_OD(gtwa->subsCANdev); }
+
+            /* sample again after the interval */
+            sub->timer_us = 0;
+            if (odRet != ODR_OK || (countRd == sub->dataLength
+                                    && memcmp(buf, sub->data, countRd) == 0)
+            ) {
+                if (timerNext_us != NULL && sub->interval_us > 0
+                    && *timerNext_us > sub->interval_us
+                ) {
+                    *timerNext_us = sub->interval_us;
+                }
+                continue;
             }
+            memcpy(sub->data, buf, countRd);
+            sub->dataLength = (uint8_t)countRd;
+            bufLength = sub->dataLength;
+        }
+#ifdef CO_GTWA_SUBSCRIBE_PDO
+        else {
+            /* PDO data may be written from other thread */
+            CO_LOCK_OD(sub->PDO->CANdev);
+            memcpy(buf, sub->data, sub->dataLength);
+            bufLength = sub->dataLength;
+            CO_FLAG_CLEAR(sub->eventNew);
+            CO_UNLOCK_OD(sub->PDO->CANdev);
+        }
+#endif
+        subPrint(gtwa, sub, buf, bufLength);
+        sub->timer_us = 0;
+        gtwa->subsLast = i;
+        busy = gtwa->respHold;
+    }
+}
+#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SUBSCRIBE */
 
-            /* index */
-            closed = 0;
-            CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok), &closed, &err);
-            idx = (uint16_t)getU32(tok, 0, 0xFFFF, &err);
-            if (err) break;
 
-            /* subindex */
-            closed = -1;
-            n = CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok),
-                                  &closed, &err);
-            subidx = (uint8_t)getU32(tok, 0, 0xFF, &err);
-            if (err || n == 0) {
-                err = true;
-                break;
-            }
+/*******************************************************************************
+ * COMMAND HANDLERS
+ ******************************************************************************/
+/* Arguments of the command handler. Handler continues parsing of the command
+ * after the command token. On error it sets err and optionally respErrorCode.
+ * It sets wait, if command was left in commFifo for later execution. */
+typedef struct {
+    int32_t net;
+    int16_t node;
+    int8_t closed;
+    bool_t err;
+    bool_t wait;
+    CO_GTWA_respErrorCode_t respErrorCode;
+    uint32_t timeDifference_us;
+    /* beginning of the command inside commFifo, see CO_fifo_getReadMark() */
+    size_t commReadPtr;
+} cmdArgs_t;
+
+/* Leave the command in commFifo and try again later. If commFifo was written
+ * over the already parsed command meanwhile, command is lost and it is an
+ * error. */
+static void commWait(CO_GTWA_t *gtwa, cmdArgs_t *args) {
+    if (CO_fifo_rewind(&gtwa->commFifo, args->commReadPtr)) {
+        args->wait = true;
+    }
+    else {
+        args->respErrorCode = CO_GTWA_respErrorInternalState;
+        args->err = true;
+    }
+}
 
-            /* optional data type */
-            if (closed == 0) {
-                closed = 1;
-                CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok),
-                                  &closed, &err);
-                convertToLower(tok, sizeof(tok));
-                gtwa->SDOdataType = CO_GTWA_getDataType(tok, &err);
-                if (err) break;
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_BINARY
+/* Respond and switch between ascii and binary framing. Wait, until responses
+ * from all slots are finished, they would be printed in wrong framing. */
+static void binSwitch(CO_GTWA_t *gtwa, cmdArgs_t *args, bool_t enable) {
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SLOTS
+    uint8_t i;
+
+    for (i = 0; i < gtwa->slotsCount; i++) {
+        if (gtwa->slots[i].node != 0) {
+            commWait(gtwa, args);
+            return;
+        }
+    }
+#else
+    (void)args;
+#endif
+    responseWithOK(gtwa);
+    CO_GTWA_setBinary(gtwa, enable);
+}
+#endif
+
+/* set command - multiple sub commands */
+static void cmdSet(CO_GTWA_t *gtwa, cmdArgs_t *args) {
+    char tok[20];
+
+    if (args->closed != 0) {
+        args->err = true;
+        return;
+    }
+
+    /* command 2 */
+    args->closed = -1;
+    CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok),
+                      &args->closed, &args->err);
+    if (args->err) return;
+
+    convertToLower(tok, sizeof(tok));
+    /* 'set network <value>' */
+    if (strcmp(tok, "network") == 0) {
+        uint16_t value;
+
+        if (args->closed != 0) {
+            args->err = true;
+            return;
+        }
+
+        /* value */
+        args->closed = 1;
+        CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok),
+                          &args->closed, &args->err);
+        value = (uint16_t)getU32(tok, CO_CONFIG_GTW_NET_MIN,
+                                 CO_CONFIG_GTW_NET_MAX, &args->err);
+        if (args->err) return;
+
+        gtwa->net_default = value;
+        responseWithOK(gtwa);
+    }
+    /* 'set node <value>' */
+    else if (strcmp(tok, "node") == 0) {
+        bool_t NodeErr = checkNet(gtwa, args->net, &args->respErrorCode);
+        uint8_t value;
+
+        if (args->closed != 0 || NodeErr) {
+            args->err = true;
+            return;
+        }
+
+        /* value */
+        args->closed = 1;
+        CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok),
+                          &args->closed, &args->err);
+        value = (uint8_t)getU32(tok, 1, 127, &args->err);
+        if (args->err) return;
+
+        gtwa->node_default = value;
+        responseWithOK(gtwa);
+    }
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO
+    /* 'set sdo_timeout <value_ms>' */
+    else if (strcmp(tok, "sdo_timeout") == 0) {
+        bool_t NodeErr = checkNet(gtwa, args->net, &args->respErrorCode);
+        uint16_t value;
+
+        if (args->closed != 0 || NodeErr) {
+            args->err = true;
+            return;
+        }
+
+        /* value */
+        args->closed = 1;
+        CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok),
+                          &args->closed, &args->err);
+        value = (uint16_t)getU32(tok, 1, 0xFFFF, &args->err);
+        if (args->err) return;
+
+        gtwa->SDOtimeoutTime = value;
+        responseWithOK(gtwa);
+    }
+    /* 'set sdo_timeout <0|1>' */
+    else if (strcmp(tok, "sdo_block") == 0) {
+        bool_t NodeErr = checkNet(gtwa, args->net, &args->respErrorCode);
+        uint16_t value;
+
+        if (args->closed != 0 || NodeErr) {
+            args->err = true;
+            return;
+        }
+
+        /* value */
+        args->closed = 1;
+        CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok),
+                          &args->closed, &args->err);
+        value = (uint16_t)getU32(tok, 0, 1, &args->err);
+        if (args->err) return;
+
+        gtwa->SDOblockTransferEnable = value==1 ? true : false;
+        responseWithOK(gtwa);
+    }
+#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO */
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_BINARY
+    /* 'set binary <0|1>' */
+    else if (strcmp(tok, "binary") == 0) {
+        uint16_t value;
+
+        if (args->closed != 0) {
+            args->err = true;
+            return;
+        }
+
+        /* value */
+        args->closed = 1;
+        CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok),
+                          &args->closed, &args->err);
+        value = (uint16_t)getU32(tok, 0, 1, &args->err);
+        if (args->err) return;
+
+        /* response is still ascii, next command is binary frame */
+        binSwitch(gtwa, args, value == 1);
+    }
+#endif
+    else {
+        args->respErrorCode = CO_GTWA_respErrorReqNotSupported;
+        args->err = true;
+    }
+}
+
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO
+/* Setup SDO client for the node and initiate upload. Command then continues in
+ * the state machine or in the free slot. Used by ascii and binary command. */
+static void readInitiate(CO_GTWA_t *gtwa,
+                         cmdArgs_t *args,
+                         uint16_t idx,
+                         uint8_t subidx)
+{
+    CO_SDO_return_t SDO_ret;
+    CO_SDOclient_t *SDO_C = gtwa->SDO_C;
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SLOTS
+    CO_GTWA_slot_t *slot = NULL;
+#endif
+
+    if (nodeBusy(gtwa, gtwa->node)) {
+        commWait(gtwa, args);
+        return;
+    }
+
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SLOTS
+    if (gtwa->slotsCount > 0) {
+        slot = slotGet(gtwa, gtwa->node);
+        if (slot == NULL) {
+            commWait(gtwa, args);
+            return;
+        }
+        SDO_C = slot->SDO_C;
+        /* SDO client from CO_GTWA_init() may still listen to node */
+        if (gtwa->SDO_C->nodeIDOfTheSDOServer == gtwa->node) {
+            clientRelease(gtwa, gtwa->SDO_C);
+        }
+    }
+#endif
+
+    /* setup client */
+    SDO_ret = clientSetup(gtwa, SDO_C, gtwa->node);
+    if (SDO_ret != CO_SDO_RT_ok_communicationEnd) {
+        args->respErrorCode = CO_GTWA_respErrorInternalState;
+        args->err = true;
+        return;
+    }
+
+    /* initiate upload */
+    SDO_ret = CO_SDOclientUploadInitiate(SDO_C, idx, subidx,
+                                         gtwa->SDOtimeoutTime,
+                                         gtwa->SDOblockTransferEnable);
+    if (SDO_ret != CO_SDO_RT_ok_communicationEnd) {
+        args->respErrorCode = CO_GTWA_respErrorInternalState;
+        args->err = true;
+        return;
+    }
+
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SLOTS
+    if (slot != NULL) {
+        /* slot continues with the command, parse the next one */
+        slot->sequence = gtwa->sequence;
+        slot->node = gtwa->node;
+        slot->SDOdataType = gtwa->SDOdataType;
+        slot->SDOdataCopyStatus = false;
+        slot->aborted = false;
+        slot->download = false;
+        return;
+    }
+#endif
+
+    /* indicate that gateway response didn't start yet */
+    gtwa->SDOdataCopyStatus = false;
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO_BATCH
+    gtwa->SDObatch = false;
+#endif
+    /* continue with state machine */
+    args->timeDifference_us = 0;
+    gtwa->state = CO_GTWA_ST_READ;
+}
+
+/* Setup SDO client for the node and initiate download of size bytes (0 if not
+ * known). SDO_C is from CO_GTWA_init() or from the slot. Return false on error
+ * or if command has to wait. Used by ascii and binary command. */
+static bool_t writeInitiate(CO_GTWA_t *gtwa,
+                            cmdArgs_t *args,
+                            CO_SDOclient_t *SDO_C,
+                            uint16_t idx,
+                            uint8_t subidx,
+                            size_t size)
+{
+    CO_SDO_return_t SDO_ret;
+
+    if (nodeBusy(gtwa, gtwa->node)) {
+        commWait(gtwa, args);
+        return false;
+    }
+
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SLOTS
+    /* SDO client from CO_GTWA_init() may still listen to node */
+    if (SDO_C != gtwa->SDO_C
+        && gtwa->SDO_C->nodeIDOfTheSDOServer == gtwa->node
+    ) {
+        clientRelease(gtwa, gtwa->SDO_C);
+    }
+#endif
+
+    /* setup client */
+    SDO_ret = clientSetup(gtwa, SDO_C, gtwa->node);
+    if (SDO_ret != CO_SDO_RT_ok_communicationEnd) {
+        args->respErrorCode = CO_GTWA_respErrorInternalState;
+        args->err = true;
+        return false;
+    }
+
+    /* initiate download */
+    SDO_ret = CO_SDOclientDownloadInitiate(SDO_C, idx, subidx, size,
+                                           gtwa->SDOtimeoutTime,
+                                           gtwa->SDOblockTransferEnable);
+    if (SDO_ret != CO_SDO_RT_ok_communicationEnd) {
+        args->respErrorCode = CO_GTWA_respErrorInternalState;
+        args->err = true;
+        return false;
+    }
+    return true;
+}
+
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SLOTS
+/* Execute ascii SDO download in the free slot, if all data of the command fit
+ * into the SDO buffer of the slot. Return false, if slots are not used or if
+ * data are too large, command then continues with the SDO client from
+ * CO_GTWA_init(). Otherwise return true, also on error or wait. */
+static bool_t writeSlot(CO_GTWA_t *gtwa,
+                        cmdArgs_t *args,
+                        uint16_t idx,
+                        uint8_t subidx)
+{
+    CO_GTWA_slot_t *slot;
+    size_t dataReadPtr = CO_fifo_getReadMark(&gtwa->commFifo);
+    CO_fifo_st status;
+    size_t size;
+
+    if (gtwa->slotsCount == 0) {
+        return false;
+    }
+    slot = slotGet(gtwa, gtwa->node);
+    if (slot == NULL) {
+        commWait(gtwa, args);
+        return true;
+    }
+    if (!writeInitiate(gtwa, args, slot->SDO_C, idx, subidx,
+                       gtwa->SDOdataType->length)
+    ) {
+        return true;
+    }
+
+    /* copy data from comm to the SDO buffer, according to data type */
+    size = gtwa->SDOdataType->dataTypeScan(&slot->SDO_C->bufFifo,
+                                           &gtwa->commFifo,
+                                           &status);
+    if ((status & CO_fifo_st_partial) != 0) {
+        /* data will be streamed by the state machine, parse them again */
+        clientRelease(gtwa, slot->SDO_C);
+        if (!CO_fifo_rewind(&gtwa->commFifo, dataReadPtr)) {
+            args->respErrorCode = CO_GTWA_respErrorInternalState;
+            args->err = true;
+            return true;
+        }
+        return false;
+    }
+    /* set to true, if command delimiter was found */
+    args->closed = ((status & CO_fifo_st_closed) == 0) ? 0 : 1;
+
+    /* is syntax error in command or size is zero or not the last token
+     * in command */
+    if ((status & CO_fifo_st_errMask) != 0 || size == 0 || args->closed != 1) {
+        clientRelease(gtwa, slot->SDO_C);
+        args->err = true;
+        return true;
+    }
+
+    /* if data size was not known before, update SDO */
+    if (gtwa->SDOdataType->length == 0) {
+        CO_SDOclientDownloadInitiateSize(slot->SDO_C, size);
+    }
+
+    /* slot continues with the command, parse the next one */
+    slot->sequence = gtwa->sequence;
+    slot->node = gtwa->node;
+    slot->SDOdataType = gtwa->SDOdataType;
+    slot->SDOdataCopyStatus = false;
+    slot->aborted = false;
+    slot->download = true;
+    return true;
+}
+#endif
+
+/* Continue with SDO download in the state machine */
+static inline void writeContinue(CO_GTWA_t *gtwa, cmdArgs_t *args) {
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO_BATCH
+    gtwa->SDObatch = false;
+#endif
+    gtwa->stateTimeoutTmr = 0;
+    args->timeDifference_us = 0;
+    gtwa->state = CO_GTWA_ST_WRITE;
+}
+
+/* Upload SDO command - 'r[ead] <index> <subindex> <datatype>' */
+static void cmdRead(CO_GTWA_t *gtwa, cmdArgs_t *args) {
+    char tok[20];
+    size_t n;
+    uint16_t idx;
+    uint8_t subidx;
+    bool_t NodeErr = checkNetNode(gtwa, args->net, args->node, 1,
+                                  &args->respErrorCode);
+
+    if (args->closed != 0 || NodeErr) {
+        args->err = true;
+        return;
+    }
+
+    /* index */
+    args->closed = 0;
+    CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok),
+                      &args->closed, &args->err);
+    idx = (uint16_t)getU32(tok, 0, 0xFFFF, &args->err);
+    if (args->err) return;
+
+    /* subindex */
+    args->closed = -1;
+    n = CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok),
+                          &args->closed, &args->err);
+    subidx = (uint8_t)getU32(tok, 0, 0xFF, &args->err);
+    if (args->err || n == 0) {
+        args->err = true;
+        return;
+    }
+
+    /* optional data type */
+    if (args->closed == 0) {
+        args->closed = 1;
+        CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok),
+                          &args->closed, &args->err);
+        convertToLower(tok, sizeof(tok));
+        gtwa->SDOdataType = CO_GTWA_getDataType(tok, &args->err);
+        if (args->err) return;
+    }
+    else {
+        gtwa->SDOdataType = &dataTypeGeneric;
+    }
+
+    readInitiate(gtwa, args, idx, subidx);
+}
+
+/* Download SDO comm. - w[rite] <index> <subindex> <datatype> <value> */
+static void cmdWrite(CO_GTWA_t *gtwa, cmdArgs_t *args) {
+    char tok[20];
+    uint16_t idx;
+    uint8_t subidx;
+    CO_fifo_st status;
+    size_t size;
+    bool_t NodeErr = checkNetNode(gtwa, args->net, args->node, 1,
+                                  &args->respErrorCode);
+
+    if (args->closed != 0 || NodeErr) {
+        args->err = true;
+        return;
+    }
+
+    /* index */
+    args->closed = 0;
+    CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok),
+                      &args->closed, &args->err);
+    idx = (uint16_t)getU32(tok, 0, 0xFFFF, &args->err);
+    if (args->err) return;
+
+    /* subindex */
+    args->closed = 0;
+    CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok),
+                      &args->closed, &args->err);
+    subidx = (uint8_t)getU32(tok, 0, 0xFF, &args->err);
+    if (args->err) return;
+
+    /* data type */
+    args->closed = 0;
+    CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok),
+                      &args->closed, &args->err);
+    convertToLower(tok, sizeof(tok));
+    gtwa->SDOdataType = CO_GTWA_getDataType(tok, &args->err);
+    if (args->err) return;
+
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SLOTS
+    if (writeSlot(gtwa, args, idx, subidx)) {
+        return;
+    }
+#endif
+    if (!writeInitiate(gtwa, args, gtwa->SDO_C, idx, subidx,
+                       gtwa->SDOdataType->length)
+    ) {
+        return;
+    }
+
+    /* copy data from comm to the SDO buffer, according to data type */
+    size = gtwa->SDOdataType->dataTypeScan(&gtwa->SDO_C->bufFifo,
+                                           &gtwa->commFifo,
+                                           &status);
+    /* set to true, if command delimiter was found */
+    args->closed = ((status & CO_fifo_st_closed) == 0) ? 0 : 1;
+    /* set to true, if data are copied only partially */
+    gtwa->SDOdataCopyStatus = (status & CO_fifo_st_partial) != 0;
+
+    /* is syntax error in command or size is zero or not the last token
+     * in command */
+    if ((status & CO_fifo_st_errMask) != 0 || size == 0
+        || (gtwa->SDOdataCopyStatus == false && args->closed != 1)
+    ) {
+        args->err = true;
+        return;
+    }
+
+    /* if data size was not known before and is known now, update SDO */
+    if (gtwa->SDOdataType->length == 0 && !gtwa->SDOdataCopyStatus) {
+        CO_SDOclientDownloadInitiateSize(gtwa->SDO_C, size);
+    }
+
+    writeContinue(gtwa, args);
+}
+#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO */
+
+
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO_BATCH
+/* SDO upload or download of multiple objects from the same node */
+static void sdoBatch(CO_GTWA_t *gtwa, cmdArgs_t *args, bool_t download) {
+    CO_SDO_return_t SDO_ret;
+    bool_t NodeErr = checkNetNode(gtwa, args->net, args->node, 1,
+                                  &args->respErrorCode);
+
+    if (args->closed != 0 || NodeErr) {
+        args->err = true;
+        return;
+    }
+
+    if (nodeBusy(gtwa, gtwa->node)) {
+        commWait(gtwa, args);
+        return;
+    }
+
+    /* setup client */
+    SDO_ret = clientSetup(gtwa, gtwa->SDO_C, gtwa->node);
+    if (SDO_ret != CO_SDO_RT_ok_communicationEnd) {
+        args->respErrorCode = CO_GTWA_respErrorInternalState;
+        args->err = true;
+        return;
+    }
+
+    /* parse and initiate the first object, response didn't start yet */
+    gtwa->SDObatch = true;
+    gtwa->SDObatchNext = false;
+    gtwa->SDObatchRespStarted = false;
+    gtwa->SDOdataCopyStatus = false;
+    if (!batchStart(gtwa, download, &args->respErrorCode)) {
+        /* rest of the command is already cleared */
+        args->closed = 1;
+        args->err = true;
+        return;
+    }
+
+    /* continue with state machine */
+    gtwa->stateTimeoutTmr = 0;
+    args->timeDifference_us = 0;
+    gtwa->state = download ? CO_GTWA_ST_WRITE : CO_GTWA_ST_READ;
+}
+
+/* Upload SDO batch - 'rm <index> <subindex> <datatype> ...' */
+static void cmdReadBatch(CO_GTWA_t *gtwa, cmdArgs_t *args) {
+    sdoBatch(gtwa, args, false);
+}
+
+/* Download SDO batch - 'wm <index> <subindex> <datatype> <value> ...' */
+static void cmdWriteBatch(CO_GTWA_t *gtwa, cmdArgs_t *args) {
+    sdoBatch(gtwa, args, true);
+}
+#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO_BATCH */
+
+
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_NMT
+/* Send NMT command and respond */
+static void nmtCommand(CO_GTWA_t *gtwa,
+                       cmdArgs_t *args,
+                       CO_NMT_command_t command2)
+{
+    CO_ReturnError_t ret;
+
+    ret = CO_NMT_sendCommand(gtwa->NMT, command2, gtwa->node);
+
+    if (ret == CO_ERROR_NO) {
+        responseWithOK(gtwa);
+    }
+    else {
+        args->respErrorCode = CO_GTWA_respErrorInternalState;
+        args->err = true;
+    }
+}
+
+/* NMT start node - 'start' */
+static void cmdStart(CO_GTWA_t *gtwa, cmdArgs_t *args) {
+    bool_t NodeErr = checkNetNode(gtwa, args->net, args->node, 0,
+                                  &args->respErrorCode);
+
+    if (args->closed != 1 || NodeErr) {
+        args->err = true;
+        return;
+    }
+    nmtCommand(gtwa, args, CO_NMT_ENTER_OPERATIONAL);
+}
+
+/* NMT stop node - 'stop' */
+static void cmdStop(CO_GTWA_t *gtwa, cmdArgs_t *args) {
+    bool_t NodeErr = checkNetNode(gtwa, args->net, args->node, 0,
+                                  &args->respErrorCode);
+
+    if (args->closed != 1 || NodeErr) {
+        args->err = true;
+        return;
+    }
+    nmtCommand(gtwa, args, CO_NMT_ENTER_STOPPED);
+}
+
+/* NMT Set node to pre-operational - 'preop[erational]' */
+static void cmdPreop(CO_GTWA_t *gtwa, cmdArgs_t *args) {
+    bool_t NodeErr = checkNetNode(gtwa, args->net, args->node, 0,
+                                  &args->respErrorCode);
+
+    if (args->closed != 1 || NodeErr) {
+        args->err = true;
+        return;
+    }
+    nmtCommand(gtwa, args, CO_NMT_ENTER_PRE_OPERATIONAL);
+}
+
+/* NMT reset (node or communication) - 'reset <node|comm[unication]>'*/
+static void cmdReset(CO_GTWA_t *gtwa, cmdArgs_t *args) {
+    char tok[20];
+    bool_t NodeErr = checkNetNode(gtwa, args->net, args->node, 0,
+                                  &args->respErrorCode);
+    CO_NMT_command_t command2;
+
+    if (args->closed != 0 || NodeErr) {
+        args->err = true;
+        return;
+    }
+
+    /* command 2 */
+    args->closed = 1;
+    CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok),
+                      &args->closed, &args->err);
+    if (args->err) return;
+
+    convertToLower(tok, sizeof(tok));
+    if (strcmp(tok, "node") == 0) {
+        command2 = CO_NMT_RESET_NODE;
+    } else if (strcmp(tok, "comm") == 0 ||
+               strcmp(tok, "communication") == 0
+    ) {
+        command2 = CO_NMT_RESET_COMMUNICATION;
+    } else {
+        args->err = true;
+        return;
+    }
+
+    nmtCommand(gtwa, args, command2);
+}
+#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_NMT */
+
+
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_LSS
+/* Release LSS master for other sessions, if held by this session */
+static void lssRelease(CO_GTWA_t *gtwa) {
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SESSIONS
+    if (gtwa->sessions != NULL && gtwa->sessions->lssOwner == gtwa) {
+        gtwa->sessions->lssOwner = NULL;
+    }
+#else
+    (void)gtwa;
+#endif
+}
+
+/* Switch state global command - 'lss_switch_glob <0|1>' */
+static void cmdLssSwitchGlob(CO_GTWA_t *gtwa, cmdArgs_t *args) {
+    char tok[20];
+    bool_t NodeErr = checkNet(gtwa, args->net, &args->respErrorCode);
+    uint8_t select;
+
+    if (args->closed != 0 || NodeErr) {
+        args->err = true;
+        return;
+    }
+
+    /* get value */
+    args->closed = 1;
+    CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok),
+                      &args->closed, &args->err);
+    select = (uint8_t)getU32(tok, 0, 1, &args->err);
+    if (args->err) return;
+
+    if (select == 0) {
+        /* send non-confirmed message */
+        CO_LSSmaster_return_t ret;
+        ret = CO_LSSmaster_switchStateDeselect(gtwa->LSSmaster);
+        if (ret == CO_LSSmaster_OK) {
+            /* all nodes are in waiting state, other sessions may continue */
+            lssRelease(gtwa);
+            responseWithOK(gtwa);
+        }
+        else {
+            args->respErrorCode = CO_GTWA_respErrorInternalState;
+            args->err = true;
+            return;
+        }
+    }
+    else {
+        /* continue with state machine */
+        gtwa->state = CO_GTWA_ST_LSS_SWITCH_GLOB;
+    }
+}
+
+/* Release LSS master for other sessions command - '_lss_unlock' */
+static void cmdLssUnlock(CO_GTWA_t *gtwa, cmdArgs_t *args) {
+    bool_t NodeErr = checkNet(gtwa, args->net, &args->respErrorCode);
+
+    if (args->closed != 1 || NodeErr) {
+        args->err = true;
+        return;
+    }
+
+    lssRelease(gtwa);
+    responseWithOK(gtwa);
+}
+
+/* Switch state selective command -
+ * 'lss_switch_sel <vendorID> <product code> <revisionNo> <serialNo>' */
+static void cmdLssSwitchSel(CO_GTWA_t *gtwa, cmdArgs_t *args) {
+    char tok[20];
+    bool_t NodeErr = checkNet(gtwa, args->net, &args->respErrorCode);
+    CO_LSS_address_t *addr = &gtwa->lssAddress;
+
+    if (args->closed != 0 || NodeErr) {
+        args->err = true;
+        return;
+    }
+
+    /* get values */
+    args->closed = 0;
+    CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok),
+                      &args->closed, &args->err);
+    addr->identity.vendorID = getU32(tok, 0, 0xFFFFFFFF, &args->err);
+    if (args->err) return;
+
+    CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok),
+                      &args->closed, &args->err);
+    addr->identity.productCode = getU32(tok, 0, 0xFFFFFFFF, &args->err);
+    if (args->err) return;
+
+    CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok),
+                      &args->closed, &args->err);
+    addr->identity.revisionNumber = getU32(tok, 0, 0xFFFFFFFF, &args->err);
+    if (args->err) return;
+
+    args->closed = 1;
+    CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok),
+                      &args->closed, &args->err);
+    addr->identity.serialNumber = getU32(tok, 0, 0xFFFFFFFF, &args->err);
+    if (args->err) return;
+
+    /* continue with state machine */
+    gtwa->state = CO_GTWA_ST_LSS_SWITCH_SEL;
+}
+
+/* LSS configure node-ID command - 'lss_set_node <node>' */
+static void cmdLssSetNode(CO_GTWA_t *gtwa, cmdArgs_t *args) {
+    char tok[20];
+    bool_t NodeErr = checkNet(gtwa, args->net, &args->respErrorCode);
+
+    if (args->closed != 0 || NodeErr) {
+        args->err = true;
+        return;
+    }
+
+    /* get value */
+    args->closed = 1;
+    CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok),
+                      &args->closed, &args->err);
+    gtwa->lssNID = (uint8_t)getU32(tok, 0, 0xFF, &args->err);
+    if (gtwa->lssNID > 0x7F && gtwa->lssNID < 0xFF) args->err = true;
+    if (args->err) return;
+
+    /* continue with state machine */
+    gtwa->state = CO_GTWA_ST_LSS_SET_NODE;
+}
+
+/* LSS configure bit-rate command -
+ * 'lss_conf_bitrate <table_selector=0> <table_index>'
+ * table_index: 0=1000 kbit/s, 1=800 kbit/s, 2=500 kbit/s, 3=250 kbit/s,
+ *   4=125 kbit/s, 6=50 kbit/s, 7=20 kbit/s, 8=10 kbit/s, 9=auto */
+static void cmdLssConfBitrate(CO_GTWA_t *gtwa, cmdArgs_t *args) {
+    char tok[20];
+    bool_t NodeErr = checkNet(gtwa, args->net, &args->respErrorCode);
+    uint8_t tableIndex;
+    int maxIndex = (sizeof(CO_LSS_bitTimingTableLookup) /
+                    sizeof(CO_LSS_bitTimingTableLookup[0])) - 1;
+
+    if (args->closed != 0 || NodeErr) {
+        args->err = true;
+        return;
+    }
+
+    /* First parameter is table selector. We only support the CiA
+     * bit timing table from CiA301 ("0") */
+    args->closed = 0;
+    CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok),
+                      &args->closed, &args->err);
+    (void)getU32(tok, 0, 0, &args->err);
+
+    /* get value */
+    args->closed = 1;
+    CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok),
+                      &args->closed, &args->err);
+    tableIndex = (uint8_t)getU32(tok, 0, maxIndex, &args->err);
+    if (tableIndex == 5) args->err = true;
+    if (args->err) return;
+    gtwa->lssBitrate = CO_LSS_bitTimingTableLookup[tableIndex];
+
+    /* continue with state machine */
+    gtwa->state = CO_GTWA_ST_LSS_CONF_BITRATE;
+}
+
+/* LSS activate new bit-rate command -
+ * 'lss_activate_bitrate <switch_delay_ms>' */
+static void cmdLssActivateBitrate(CO_GTWA_t *gtwa, cmdArgs_t *args) {
+    char tok[20];
+    bool_t NodeErr = checkNet(gtwa, args->net, &args->respErrorCode);
+    uint16_t switchDelay;
+    CO_LSSmaster_return_t ret;
+
+    if (args->closed != 0 || NodeErr) {
+        args->err = true;
+        return;
+    }
+
+    /* get value */
+    args->closed = 1;
+    CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok),
+                      &args->closed, &args->err);
+    switchDelay = (uint16_t)getU32(tok, 0, 0xFFFF, &args->err);
+    if (args->err) return;
+
+    /* send non-confirmed message */
+    ret = CO_LSSmaster_ActivateBit(gtwa->LSSmaster, switchDelay);
+    if (ret == CO_LSSmaster_OK) {
+        responseWithOK(gtwa);
+    }
+    else {
+        args->respErrorCode = CO_GTWA_respErrorInternalState;
+        args->err = true;
+    }
+}
+
+/* LSS store configuration command - 'lss_store' */
+static void cmdLssStore(CO_GTWA_t *gtwa, cmdArgs_t *args) {
+    bool_t NodeErr = checkNet(gtwa, args->net, &args->respErrorCode);
+
+    if (args->closed != 1 || NodeErr) {
+        args->err = true;
+        return;
+    }
+
+    /* continue with state machine */
+    gtwa->state = CO_GTWA_ST_LSS_STORE;
+}
+
+/* Inquire LSS address command - 'lss_inquire_addr [<LSSSUB=0..3>]' */
+static void cmdLssInquireAddr(CO_GTWA_t *gtwa, cmdArgs_t *args) {
+    char tok[20];
+    bool_t NodeErr = checkNet(gtwa, args->net, &args->respErrorCode);
+
+    if (NodeErr) {
+        args->err = true;
+        return;
+    }
+
+    if (args->closed == 0) {
+        uint8_t lsssub;
+        /* get value */
+        args->closed = 1;
+        CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok),
+                          &args->closed, &args->err);
+        lsssub = (uint8_t)getU32(tok, 0, 3, &args->err);
+        if (args->err) return;
+        switch (lsssub) {
+            case 0: gtwa->lssInquireCs = CO_LSS_INQUIRE_VENDOR; break;
+            case 1: gtwa->lssInquireCs = CO_LSS_INQUIRE_PRODUCT; break;
+            case 2: gtwa->lssInquireCs = CO_LSS_INQUIRE_REV; break;
+            default: gtwa->lssInquireCs = CO_LSS_INQUIRE_SERIAL; break;
+        }
+
+        /* continue with state machine */
+        gtwa->state = CO_GTWA_ST_LSS_INQUIRE;
+    }
+    else {
+        /* continue with state machine */
+        gtwa->state = CO_GTWA_ST_LSS_INQUIRE_ADDR_ALL;
+    }
+}
+
+/* LSS inquire node-ID command - 'lss_get_node'*/
+static void cmdLssGetNode(CO_GTWA_t *gtwa, cmdArgs_t *args) {
+    bool_t NodeErr = checkNet(gtwa, args->net, &args->respErrorCode);
+
+    if (args->closed != 1 || NodeErr) {
+        args->err = true;
+        return;
+    }
+
+    /* continue with state machine */
+    gtwa->lssInquireCs = CO_LSS_INQUIRE_NODE_ID;
+    gtwa->state = CO_GTWA_ST_LSS_INQUIRE;
+}
+
+/* LSS identify fastscan. This is a manufacturer specific command as
+ * the one in DSP309 is quite useless - '_lss_fastscan [<timeout_ms>]'*/
+static void cmdLssFastscan(CO_GTWA_t *gtwa, cmdArgs_t *args) {
+    char tok[20];
+    bool_t NodeErr = checkNet(gtwa, args->net, &args->respErrorCode);
+    uint16_t timeout_ms = 0;
+
+    if (NodeErr) {
+        args->err = true;
+        return;
+    }
+
+    if (args->closed == 0) {
+        /* get value */
+        args->closed = 1;
+        CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok),
+                          &args->closed, &args->err);
+        timeout_ms = (uint16_t)getU32(tok, 0, 0xFFFF, &args->err);
+        if (args->err) return;
+    }
+
+    /* If timeout not specified, use 100ms. Should work in most cases */
+    if (timeout_ms == 0) {
+        timeout_ms = 100;
+    }
+    CO_LSSmaster_changeTimeout(gtwa->LSSmaster, timeout_ms);
+
+    /* prepare lssFastscan, all zero */
+    memset(&gtwa->lssFastscan, 0, sizeof(gtwa->lssFastscan));
+
+    /* continue with state machine */
+    gtwa->state = CO_GTWA_ST__LSS_FASTSCAN;
+}
+
+/* LSS complete node-ID configuration command - 'lss_allnodes
+ * [<timeout_ms> [<nodeStart=1..127> <store=0|1>
+ * <scanType0=0..2> <vendorId> <scanType1=0..2> <productCode>
+ * <scanType2=0..2> <revisionNo> <scanType3=0..2> <serialNo>]]' */
+static void cmdLssAllnodes(CO_GTWA_t *gtwa, cmdArgs_t *args) {
+    /* Request node enumeration by LSS identify fastscan.
+     * This initiates node enumeration by the means of LSS fastscan
+     * mechanism. When this function is finished:
+     * - All nodes that match the given criteria are assigned a node ID
+     *   beginning with nodeId. If 127 is reached, the process
+     *   is stopped, no matter if there are nodes remaining or not.
+     * - No IDs are assigned because:
+     *   - the given criteria do not match any node,
+     *   - all nodes are already configured.
+     * This function needs that no node is selected when starting the
+     * scan process. */
+    char tok[20];
+    bool_t NodeErr = checkNet(gtwa, args->net, &args->respErrorCode);
+    uint16_t timeout_ms = 0;
+
+    if (NodeErr) {
+        args->err = true;
+        return;
+    }
+
+    if (args->closed == 0) {
+        /* get optional token timeout (non standard) */
+        args->closed = -1;
+        CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok),
+                          &args->closed, &args->err);
+        timeout_ms = (uint16_t)getU32(tok, 0, 0xFFFF, &args->err);
+        if (args->err) return;
+    }
+    /* If timeout not specified, use 100ms. Should work in most cases */
+    gtwa->lssTimeout_ms = timeout_ms == 0 ? 100 : timeout_ms;
+    CO_LSSmaster_changeTimeout(gtwa->LSSmaster, gtwa->lssTimeout_ms);
+    gtwa->lssNodeCount = 0;
+    gtwa->lssSubState = 0;
+
+    if (args->closed == 1) {
+        /* No other arguments, as by CiA specification for this command.
+         * Do full scan. */
+        /* use start node ID 2. Should work in most cases */
+        gtwa->lssNID = 2;
+        /* store node ID in node's NVM */
+        gtwa->lssStore = true;
+        /* prepare lssFastscan, all zero */
+        memset(&gtwa->lssFastscan, 0, sizeof(gtwa->lssFastscan));
+    }
+    if (args->closed == 0) {
+        /* more arguments follow */
+        CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok),
+                          &args->closed, &args->err);
+        gtwa->lssNID = (uint8_t)getU32(tok, 1, 127, &args->err);
+        if (args->err) return;
+
+        args->closed = -1;
+        CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok),
+                          &args->closed, &args->err);
+        gtwa->lssStore = (bool_t)getU32(tok, 0, 1, &args->err);
+        if (args->err) return;
+
+        if (args->closed == 1) {
+            /* No other arguments, prepare lssFastscan, all zero */
+            memset(&gtwa->lssFastscan, 0, sizeof(gtwa->lssFastscan));
+        }
+    }
+    if (args->closed == 0) {
+        /* more arguments follow */
+        CO_LSSmaster_fastscan_t *fs = &gtwa->lssFastscan;
+
+        CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok),
+                          &args->closed, &args->err);
+        fs->scan[CO_LSS_FASTSCAN_VENDOR_ID] = getU32(tok, 0, 2, &args->err);
+        if (args->err) return;
+
+        CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok),
+                          &args->closed, &args->err);
+        fs->match.identity.vendorID = getU32(tok, 0, 0xFFFFFFFF, &args->err);
+        if (args->err) return;
+
+        CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok),
+                          &args->closed, &args->err);
+        fs->scan[CO_LSS_FASTSCAN_PRODUCT] = getU32(tok, 0, 2, &args->err);
+        if (args->err) return;
+
+        CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok),
+                          &args->closed, &args->err);
+        fs->match.identity.productCode = getU32(tok,0,0xFFFFFFFF, &args->err);
+        if (args->err) return;
+
+        CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok),
+                          &args->closed, &args->err);
+        fs->scan[CO_LSS_FASTSCAN_REV] = getU32(tok, 0, 2, &args->err);
+        if (args->err) return;
+
+        CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok),
+                          &args->closed, &args->err);
+        fs->match.identity.revisionNumber=getU32(tok,0,0xFFFFFFFF,&args->err);
+        if (args->err) return;
+
+        CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok),
+                          &args->closed, &args->err);
+        fs->scan[CO_LSS_FASTSCAN_SERIAL] = getU32(tok, 0, 2, &args->err);
+        if (args->err) return;
+
+        args->closed = 1;
+        CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok),
+                          &args->closed, &args->err);
+        fs->match.identity.serialNumber = getU32(tok,0,0xFFFFFFFF,&args->err);
+        if (args->err) return;
+    }
+
+    /* continue with state machine */
+    gtwa->state = CO_GTWA_ST_LSS_ALLNODES;
+}
+#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_LSS */
+
+
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SCAN
+/* Return true, if SDO client is in use by any slot or by other session. Scan
+ * receives all SDO responses, so it must wait. */
+static bool_t scanBusy(CO_GTWA_t *gtwa) {
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SLOTS
+    uint8_t i;
+
+    for (i = 0; i < gtwa->slotsCount; i++) {
+        if (gtwa->slots[i].node != 0) {
+            return true;
+        }
+    }
+#endif
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SESSIONS
+    if (gtwa->sessions != NULL) {
+        uint8_t own = 0;
+        uint8_t j;
+
+ #if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO
+        own = gtwa->SDO_C->nodeIDOfTheSDOServer;
+ #endif
+        if (gtwa->sessions->scanOwner != NULL
+            && gtwa->sessions->scanOwner != gtwa
+        ) {
+            return true;
+        }
+        for (j = 0; j < 4; j++) {
+            uint32_t busy = gtwa->sessions->nodeBusy[j];
+            if (own != 0 && (own >> 5) == j) {
+                busy &= ~(1UL << (own & 0x1F));
             }
-            else {
-                gtwa->SDOdataType = &dataTypes[0]; /* use generic data type */
+            if (busy != 0) {
+                return true;
             }
+        }
+    }
+#endif
+    (void)gtwa; /* may be unused */
+    return false;
+}
 
-            /* setup client */
-            SDO_ret = CO_SDOclient_setup(gtwa->SDO_C,
-                                         CO_CAN_ID_SDO_CLI + gtwa->node,
-                                         CO_CAN_ID_SDO_SRV + gtwa->node,
-                                         gtwa->node);
-            if (SDO_ret != CO_SDO_RT_ok_communicationEnd) {
-                respErrorCode = CO_GTWA_respErrorInternalState;
-                err = true;
-                break;
-            }
+/* Scan network - '[<net>] scan [<timeout_ms>]' */
+static void cmdScan(CO_GTWA_t *gtwa, cmdArgs_t *args) {
+    char tok[20];
+    bool_t NodeErr = checkNet(gtwa, args->net, &args->respErrorCode);
+    uint16_t timeout_ms = 0;
+
+    if (NodeErr) {
+        args->err = true;
+        return;
+    }
+    if (gtwa->nodeScan == NULL) {
+        args->respErrorCode = CO_GTWA_respErrorReqNotSupported;
+        args->err = true;
+        return;
+    }
+    if (scanBusy(gtwa)) {
+        commWait(gtwa, args);
+        return;
+    }
+
+    if (args->closed == 0) {
+        /* get optional token timeout */
+        args->closed = 1;
+        CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok),
+                          &args->closed, &args->err);
+        timeout_ms = (uint16_t)getU32(tok, 1, 0xFFFF, &args->err);
+        if (args->err) return;
+    }
+    /* If timeout not specified, use 100ms. Should work in most cases */
+    if (timeout_ms == 0) {
+        timeout_ms = 100;
+    }
+
+    if (CO_nodeScan_start(gtwa->nodeScan, CO_NODE_SCAN_NODE_MIN,
+                          CO_NODE_SCAN_NODE_MAX, timeout_ms) != CO_ERROR_NO
+    ) {
+        args->respErrorCode = CO_GTWA_respErrorInternalState;
+        args->err = true;
+        return;
+    }
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SESSIONS
+    if (gtwa->sessions != NULL) {
+        gtwa->sessions->scanOwner = gtwa;
+    }
+#endif
+    gtwa->scanNodeId = CO_NODE_SCAN_NODE_MIN;
+
+    /* continue with state machine */
+    gtwa->state = CO_GTWA_ST_SCAN;
+}
+#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SCAN */
+
+
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_HB_STAT
+/* Heartbeat statistics - '[<net>] hbstat [<node>]' */
+static void cmdHBstat(CO_GTWA_t *gtwa, cmdArgs_t *args) {
+    char tok[20];
+    bool_t NodeErr = checkNet(gtwa, args->net, &args->respErrorCode);
+    uint8_t nodeId = 0;
+
+    if (NodeErr) {
+        args->err = true;
+        return;
+    }
+    if (gtwa->HBcons == NULL) {
+        args->respErrorCode = CO_GTWA_respErrorReqNotSupported;
+        args->err = true;
+        return;
+    }
+
+    if (args->closed == 0) {
+        /* get optional token node */
+        args->closed = 1;
+        CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok),
+                          &args->closed, &args->err);
+        nodeId = (uint8_t)getU32(tok, 1, 127, &args->err);
+        if (args->err) return;
+    }
+
+    gtwa->hbStatIdx = 0;
+    gtwa->hbStatNodeId = nodeId;
+
+    /* continue with state machine */
+    gtwa->state = CO_GTWA_ST_HBSTAT;
+}
+#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_HB_STAT */
+
+
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_LOG
+/* Print message log */
+static void cmdLog(CO_GTWA_t *gtwa, cmdArgs_t *args) {
+    if (args->closed == 0) {
+        args->err = true;
+        return;
+    }
+    gtwa->state = CO_GTWA_ST_LOG;
+}
+#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_LOG */
+
+
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_PRINT_HELP
+/* Print help */
+static void cmdHelp(CO_GTWA_t *gtwa, cmdArgs_t *args) {
+    char tok[20];
+
+    if (args->closed == 1) {
+        gtwa->helpString = CO_GTWA_helpString;
+    }
+    else {
+        /* get second token */
+        args->closed = 1;
+        CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok),
+                          &args->closed, &args->err);
+        if (args->err) return;
+
+        convertToLower(tok, sizeof(tok));
+        if (strcmp(tok, "datatype") == 0) {
+            gtwa->helpString = CO_GTWA_helpStringDatatypes;
+        }
+        else if (strcmp(tok, "lss") == 0) {
+            gtwa->helpString = CO_GTWA_helpStringLss;
+        }
+        else {
+            args->err = true;
+            return;
+        }
+    }
+    /* continue with state machine */
+    gtwa->helpStringOffset = 0;
+    gtwa->state = CO_GTWA_ST_HELP;
+}
+#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_PRINT_HELP */
+
+
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_PRINT_LEDS
+/* Print status led diodes */
+static void cmdLed(CO_GTWA_t *gtwa, cmdArgs_t *args) {
+    if (args->closed == 0) {
+        args->err = true;
+        return;
+    }
+    gtwa->ledStringPreviousIndex = 0xFF;
+    gtwa->state = CO_GTWA_ST_LED;
+}
+#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_PRINT_LEDS */
+
+
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SUBSCRIBE
+/* Subscribe - 'subscribe od <index> <subindex> <datatype> [<interval_ms>]' or
+ * 'subscribe rpdo|tpdo <number> [<interval_ms>]' */
+static void cmdSubscribe(CO_GTWA_t *gtwa, cmdArgs_t *args) {
+    char tok[20];
+    CO_GTWA_sub_t *sub = NULL;
+    CO_GTWA_subType_t type;
+    uint16_t idx = 0;
+    uint8_t subidx = 0;
+    uint32_t interval_ms = 0;
+    const CO_GTWA_dataType_t *dataType = &dataTypeGeneric;
+    uint8_t i;
+    bool_t NetErr = checkNet(gtwa, args->net, &args->respErrorCode);
+
+    if (args->closed != 0 || NetErr) {
+        args->err = true;
+        return;
+    }
+
+    /* type of the subscription */
+    args->closed = 0;
+    CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok),
+                      &args->closed, &args->err);
+    if (args->err) return;
+
+    convertToLower(tok, sizeof(tok));
+    if (strcmp(tok, "od") == 0) {
+        type = CO_GTWA_SUB_OD;
+
+        /* index */
+        args->closed = 0;
+        CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok),
+                          &args->closed, &args->err);
+        idx = (uint16_t)getU32(tok, 0, 0xFFFF, &args->err);
+        if (args->err) return;
+
+        /* subindex */
+        args->closed = 0;
+        CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok),
+                          &args->closed, &args->err);
+        subidx = (uint8_t)getU32(tok, 0, 0xFF, &args->err);
+        if (args->err) return;
+
+        /* data type */
+        args->closed = -1;
+        CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok),
+                          &args->closed, &args->err);
+        convertToLower(tok, sizeof(tok));
+        dataType = CO_GTWA_getDataType(tok, &args->err);
+        if (args->err) return;
+    }
+#ifdef CO_GTWA_SUBSCRIBE_RPDO
+    else if (strcmp(tok, "rpdo") == 0) {
+        type = CO_GTWA_SUB_RPDO;
+    }
+#endif
+#ifdef CO_GTWA_SUBSCRIBE_TPDO
+    else if (strcmp(tok, "tpdo") == 0) {
+        type = CO_GTWA_SUB_TPDO;
+    }
+#endif
+    else {
+        args->respErrorCode = CO_GTWA_respErrorReqNotSupported;
+        args->err = true;
+        return;
+    }
+
+    /* PDO number */
+    if (type != CO_GTWA_SUB_OD) {
+        args->closed = -1;
+        CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok),
+                          &args->closed, &args->err);
+        idx = (uint16_t)getU32(tok, 1, 0xFFFF, &args->err);
+        if (args->err) return;
+    }
+
+    /* optional interval */
+    if (args->closed == 0) {
+        args->closed = 1;
+        CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok),
+                          &args->closed, &args->err);
+        interval_ms = getU32(tok, 0, 0xFFFFFFFF / 1000, &args->err);
+        if (args->err) return;
+    }
+
+    /* find free subscription */
+    for (i = 0; i < CO_CONFIG_GTWA_SUBSCRIPTIONS; i++) {
+        if (gtwa->subs[i].type == CO_GTWA_SUB_FREE) {
+            sub = &gtwa->subs[i];
+            break;
+        }
+    }
+    if (sub == NULL) {
+        args->respErrorCode = CO_GTWA_respErrorRunningOutOfMemory;
+        args->err = true;
+        return;
+    }
+
+    if (type == CO_GTWA_SUB_OD) {
+        /* local OD variable, which fits into sub->data */
+        ODR_t odRet = OD_getSub(OD_find(gtwa->OD, idx), subidx,
+                                &sub->OD_IO, false);
+
+        if (odRet == ODR_OK
+            && (dataType->length == 0 || dataType->length > sizeof(sub->data)
+                || sub->OD_IO.stream.dataLength != dataType->length)
+        ) {
+            odRet = ODR_TYPE_MISMATCH;
+        }
+        if (odRet != ODR_OK) {
+            responseWithErrorSDO(gtwa, gtwa->sequence,
+                                 (CO_SDO_abortCode_t)OD_getSDOabCode(odRet),
+                                 false);
+            return;
+        }
+    }
+#ifdef CO_GTWA_SUBSCRIBE_PDO
+    else {
+        CO_PDO_common_t *PDO = NULL;
+
+ #ifdef CO_GTWA_SUBSCRIBE_RPDO
+        if (type == CO_GTWA_SUB_RPDO && idx <= gtwa->RPDOcount) {
+            PDO = &gtwa->RPDO[idx - 1].PDO_common;
+        }
+ #endif
+ #ifdef CO_GTWA_SUBSCRIBE_TPDO
+        if (type == CO_GTWA_SUB_TPDO && idx <= gtwa->TPDOcount) {
+            PDO = &gtwa->TPDO[idx - 1].PDO_common;
+        }
+ #endif
+        if (PDO == NULL) {
+            args->respErrorCode = CO_GTWA_respErrorReqNotSupported;
+            args->err = true;
+            return;
+        }
+        /* PDO event callback may be used only once */
+        if (PDO->pFunctSignalEvent != NULL) {
+            args->respErrorCode = CO_GTWA_respErrorPDOalreadyUsed;
+            args->err = true;
+            return;
+        }
+
+        sub->PDO = PDO;
+        CO_FLAG_CLEAR(sub->eventNew);
+        CO_LOCK_OD(PDO->CANdev);
+        CO_PDO_initCallbackEvent(PDO, (void *)sub, subPDOevent);
+        CO_UNLOCK_OD(PDO->CANdev);
+    }
+#endif
+
+    sub->type = type;
+    sub->sequence = gtwa->sequence;
+    sub->interval_us = interval_ms * 1000;
+    sub->timer_us = sub->interval_us;
+    sub->dataType = dataType;
+    sub->dataLength = 0;
+    responseWithOK(gtwa);
+}
+
+/* Cancel subscription - 'unsubscribe [<sequence>]' */
+static void cmdUnsubscribe(CO_GTWA_t *gtwa, cmdArgs_t *args) {
+    char tok[20];
+    uint32_t sequence = 0;
+    bool_t all = args->closed == 1;
+    bool_t found = false;
+    uint8_t i;
+
+    if (!all) {
+        args->closed = 1;
+        CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok),
+                          &args->closed, &args->err);
+        sequence = getU32(tok, 0, 0xFFFFFFFF, &args->err);
+        if (args->err) return;
+    }
+
+    for (i = 0; i < CO_CONFIG_GTWA_SUBSCRIPTIONS; i++) {
+        CO_GTWA_sub_t *sub = &gtwa->subs[i];
+        if (sub->type != CO_GTWA_SUB_FREE
+            && (all || sub->sequence == sequence)
+        ) {
+            subRelease(sub);
+            found = true;
+        }
+    }
+
+    if (found || all) {
+        responseWithOK(gtwa);
+    }
+    else {
+        args->respErrorCode = CO_GTWA_respErrorInternalState;
+        args->err = true;
+    }
+}
+#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SUBSCRIBE */
+
+
+/* Command handlers, sorted by command name (as strcmp) for binary search */
+typedef struct {
+    const char *name;
+    void (*handler)(CO_GTWA_t *gtwa, cmdArgs_t *args);
+    /* Flags of the command, CMD_LSS, CMD_SDO or 0 */
+    uint8_t flags;
+} cmdEntry_t;
+
+/* Command uses LSS master */
+#define CMD_LSS 0x01U
+/* Command uses SDO client of the node, it may wait for the busy node */
+#define CMD_SDO 0x02U
+
+static const cmdEntry_t cmdTable[] = {
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_LSS
+    {"_lss_fastscan", cmdLssFastscan, CMD_LSS},
+    {"_lss_unlock", cmdLssUnlock, 0},
+#endif
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_HB_STAT
+    {"hbstat", cmdHBstat, 0},
+#endif
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_PRINT_HELP
+    {"help", cmdHelp, 0},
+#endif
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_PRINT_LEDS
+    {"led", cmdLed, 0},
+#endif
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_LOG
+    {"log", cmdLog, 0},
+#endif
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_LSS
+    {"lss_activate_bitrate", cmdLssActivateBitrate, CMD_LSS},
+    {"lss_allnodes", cmdLssAllnodes, CMD_LSS},
+    {"lss_conf_bitrate", cmdLssConfBitrate, CMD_LSS},
+    {"lss_get_node", cmdLssGetNode, CMD_LSS},
+    {"lss_inquire_addr", cmdLssInquireAddr, CMD_LSS},
+    {"lss_set_node", cmdLssSetNode, CMD_LSS},
+    {"lss_store", cmdLssStore, CMD_LSS},
+    {"lss_switch_glob", cmdLssSwitchGlob, CMD_LSS},
+    {"lss_switch_sel", cmdLssSwitchSel, CMD_LSS},
+#endif
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_NMT
+    {"preop", cmdPreop, 0},
+    {"preoperational", cmdPreop, 0},
+#endif
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO
+    {"r", cmdRead, CMD_SDO},
+    {"read", cmdRead, CMD_SDO},
+#endif
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_NMT
+    {"reset", cmdReset, 0},
+#endif
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO_BATCH
+    {"rm", cmdReadBatch, CMD_SDO},
+#endif
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SCAN
+    {"scan", cmdScan, 0},
+#endif
+    {"set", cmdSet, 0},
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_NMT
+    {"start", cmdStart, 0},
+    {"stop", cmdStop, 0},
+#endif
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SUBSCRIBE
+    {"subscribe", cmdSubscribe, 0},
+    {"unsubscribe", cmdUnsubscribe, 0},
+#endif
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO
+    {"w", cmdWrite, CMD_SDO},
+#endif
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO_BATCH
+    {"wm", cmdWriteBatch, CMD_SDO},
+#endif
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO
+    {"write", cmdWrite, CMD_SDO}
+#endif
+};
 
-            /* initiate upload */
-            SDO_ret = CO_SDOclientUploadInitiate(gtwa->SDO_C, idx, subidx,
-                                                 gtwa->SDOtimeoutTime,
-                                                 gtwa->SDOblockTransferEnable);
-            if (SDO_ret != CO_SDO_RT_ok_communicationEnd) {
-                respErrorCode = CO_GTWA_respErrorInternalState;
-                err = true;
-                break;
-            }
+#if (CO_CONFIG_DEBUG) & CO_CONFIG_DEBUG_GTW_TABLES
+/* Verify, that names in the tables for bsearch() are strictly ascending */
+static bool_t tablesSorted(void) {
+    size_t i;
 
-            /* indicate that gateway response didn't start yet */
-            gtwa->SDOdataCopyStatus = false;
-            /* continue with state machine */
-            timeDifference_us = 0;
-            gtwa->state = CO_GTWA_ST_READ;
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO
+    for (i = 1; i < sizeof(dataTypes) / sizeof(dataTypes[0]); i++) {
+        if (strcmp(dataTypes[i - 1].syntax, dataTypes[i].syntax) >= 0) {
+            return false;
+        }
+    }
+#endif
+    for (i = 1; i < sizeof(cmdTable) / sizeof(cmdTable[0]); i++) {
+        if (strcmp(cmdTable[i - 1].name, cmdTable[i].name) >= 0) {
+            return false;
         }
+    }
+    return true;
+}
+#endif
 
-        /* Download SDO comm. - w[rite] <index> <subindex> <datatype> <value> */
-        else if (strcmp(tok, "w") == 0 || strcmp(tok, "write") == 0) {
-            uint16_t idx;
-            uint8_t subidx;
-            CO_fifo_st status;
-            CO_SDO_return_t SDO_ret;
-            size_t size;
-            bool_t NodeErr = checkNetNode(gtwa, net, node, 1, &respErrorCode);
 
-            if (closed != 0 || NodeErr) {
-                err = true;
-                break;
-            }
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_BINARY
+/*******************************************************************************
+ * BINARY FRAMES
+ ******************************************************************************/
+/* Copy data of the binary download request from commFifo into SDO buffer.
+ * Return CO_fifo_st_partial, if more data will follow. */
+static CO_fifo_st binCopy(CO_GTWA_t *gtwa) {
+    gtwa->binRemain -= CO_fifo_cpy(&gtwa->SDO_C->bufFifo, &gtwa->commFifo,
+                                   gtwa->binRemain);
 
-            /* index */
-            closed = 0;
-            CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok), &closed, &err);
-            idx = (uint16_t)getU32(tok, 0, 0xFFFF, &err);
-            if (err) break;
+    return gtwa->binRemain > 0 ? CO_fifo_st_partial : CO_fifo_st_closed;
+}
 
-            /* subindex */
-            closed = 0;
-            n = CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok),
-                                  &closed, &err);
-            subidx = (uint8_t)getU32(tok, 0, 0xFF, &err);
-            if (err) break;
+/* Copy head and arguments of the binary request from commFifo into frame,
+ * without removing them. Return their size, if they are all available, or 0
+ * if request is not complete yet. */
+static size_t binPeek(CO_GTWA_t *gtwa, uint8_t *frame) {
+    uint32_t length;
+    size_t size = CO_GTWA_BIN_HEAD_SIZE + CO_GTWA_BIN_ARGS_SIZE;
+    size_t count = 0;
 
-            /* data type */
-            closed = 0;
-            CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok),
-                              &closed, &err);
-            convertToLower(tok, sizeof(tok));
-            gtwa->SDOdataType = CO_GTWA_getDataType(tok, &err);
-            if (err) break;
+    /* data may wrap in commFifo */
+    while (count < size) {
+        const uint8_t *buf;
+        size_t n = CO_fifo_peek(&gtwa->commFifo, count, &buf);
 
-            /* setup client */
-            SDO_ret = CO_SDOclient_setup(gtwa->SDO_C,
-                                         CO_CAN_ID_SDO_CLI + gtwa->node,
-                                         CO_CAN_ID_SDO_SRV + gtwa->node,
-                                         gtwa->node);
-            if (SDO_ret != CO_SDO_RT_ok_communicationEnd) {
-                respErrorCode = CO_GTWA_respErrorInternalState;
-                err = true;
-                break;
-            }
+        if (n == 0) {
+            break;
+        }
+        if (n > size - count) {
+            n = size - count;
+        }
+        memcpy(&frame[count], buf, n);
+        count += n;
+    }
+    if (count < 4) {
+        return 0;
+    }
+    length = CO_SWAP_32(CO_getUint32(&frame[0]));
+    if (length < (size - 4)) {
+        size = (size_t)length + 4;
+    }
+    return count >= size ? size : 0;
+}
 
-            /* initiate download */
-            SDO_ret =
-            CO_SDOclientDownloadInitiate(gtwa->SDO_C, idx, subidx,
-                                         gtwa->SDOdataType->length,
-                                         gtwa->SDOtimeoutTime,
-                                         gtwa->SDOblockTransferEnable);
-            if (SDO_ret != CO_SDO_RT_ok_communicationEnd) {
-                respErrorCode = CO_GTWA_respErrorInternalState;
-                err = true;
+/* Parse and execute binary requests from commFifo, until state machine is
+ * busy or request is not complete. Return true on error, respErrorCode is then
+ * set and the rest of invalid request will be skipped. */
+static bool_t binParse(CO_GTWA_t *gtwa,
+                       CO_GTWA_respErrorCode_t *respErrorCode,
+                       uint32_t *timeDifference_us)
+{
+    bool_t err = false;
+
+    while (gtwa->binary && gtwa->state == CO_GTWA_ST_IDLE && !gtwa->respHold) {
+        uint8_t frame[CO_GTWA_BIN_HEAD_SIZE + CO_GTWA_BIN_ARGS_SIZE];
+        const uint8_t *arg = &frame[CO_GTWA_BIN_HEAD_SIZE];
+        size_t frameSize;
+        size_t argsSize;
+        uint32_t length;
+        cmdArgs_t args;
+
+        /* purge the rest of the previous invalid request */
+        while (gtwa->binSkip > 0) {
+            size_t n = gtwa->binSkip < sizeof(frame)
+                     ? gtwa->binSkip : sizeof(frame);
+            n = CO_fifo_read(&gtwa->commFifo, frame, n, NULL);
+            if (n == 0) break;
+            gtwa->binSkip -= n;
+        }
+        if (gtwa->binSkip > 0) break;
+
+        frameSize = binPeek(gtwa, frame);
+        if (frameSize == 0) break;
+
+        args.net = gtwa->net_default;
+        args.node = -1;
+        args.closed = 1;
+        args.err = false;
+        args.wait = false;
+        args.respErrorCode = CO_GTWA_respErrorNone;
+        args.timeDifference_us = *timeDifference_us;
+        args.commReadPtr = CO_fifo_getReadMark(&gtwa->commFifo);
+
+        /* remove head and arguments, download data stays in commFifo */
+        CO_fifo_read(&gtwa->commFifo, frame, frameSize, NULL);
+        length = CO_SWAP_32(CO_getUint32(&frame[0]));
+        if (frameSize < CO_GTWA_BIN_HEAD_SIZE) {
+            /* length is too short, there is no sequence */
+            gtwa->sequence = 0;
+            *respErrorCode = CO_GTWA_respErrorSyntax;
+            return true;
+        }
+        /* size of the data, which are still in commFifo */
+        gtwa->binSkip = (size_t)(length - (frameSize - 4));
+        argsSize = (size_t)(length - (CO_GTWA_BIN_HEAD_SIZE - 4));
+        gtwa->sequence = CO_SWAP_32(CO_getUint32(&frame[4]));
+
+        switch (frame[8]) {
+        case CO_GTWA_BIN_REQ_READ:
+            if (argsSize != CO_GTWA_BIN_ARGS_SIZE
+                || checkNetNode(gtwa, args.net, arg[0], 1, &args.respErrorCode)
+            ) {
+                args.err = true;
                 break;
             }
+            gtwa->SDOdataType = &dataTypeGeneric;
+            readInitiate(gtwa, &args, CO_SWAP_16(CO_getUint16(&arg[1])),
+                         arg[3]);
+            break;
 
-            /* copy data from comm to the SDO buffer, according to data type */
-            size = gtwa->SDOdataType->dataTypeScan(&gtwa->SDO_C->bufFifo,
-                                                   &gtwa->commFifo,
-                                                   &status);
-            /* set to true, if command delimiter was found */
-            closed = ((status & CO_fifo_st_closed) == 0) ? 0 : 1;
-            /* set to true, if data are copied only partially */
-            gtwa->SDOdataCopyStatus = (status & CO_fifo_st_partial) != 0;
-
-            /* is syntax error in command or size is zero or not the last token
-             * in command */
-            if ((status & CO_fifo_st_errMask) != 0 || size == 0
-                || (gtwa->SDOdataCopyStatus == false && closed != 1)
+        case CO_GTWA_BIN_REQ_WRITE:
+            if (argsSize <= CO_GTWA_BIN_ARGS_SIZE
+                || checkNetNode(gtwa, args.net, arg[0], 1, &args.respErrorCode)
             ) {
-                err = true;
+                args.err = true;
                 break;
             }
-
-            /* if data size was not known before and is known now, update SDO */
-            if (gtwa->SDOdataType->length == 0 && !gtwa->SDOdataCopyStatus) {
-                CO_SDOclientDownloadInitiateSize(gtwa->SDO_C, size);
+            gtwa->SDOdataType = &dataTypeGeneric;
+            if (writeInitiate(gtwa, &args, gtwa->SDO_C,
+                              CO_SWAP_16(CO_getUint16(&arg[1])), arg[3],
+                              argsSize - CO_GTWA_BIN_ARGS_SIZE)
+            ) {
+                /* data are copied here and in the state machine */
+                gtwa->binRemain = gtwa->binSkip;
+                gtwa->binSkip = 0;
+                gtwa->SDOdataCopyStatus = binCopy(gtwa) == CO_fifo_st_partial;
+                writeContinue(gtwa, &args);
             }
-
-            /* continue with state machine */
-            gtwa->stateTimeoutTmr = 0;
-            timeDifference_us = 0;
-            gtwa->state = CO_GTWA_ST_WRITE;
-        }
-#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO */
+            break;
 
 #if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_NMT
-        /* NMT start node - 'start' */
-        else if (strcmp(tok, "start") == 0) {
-            CO_ReturnError_t ret;
-            bool_t NodeErr = checkNetNode(gtwa, net, node, 0, &respErrorCode);
-            CO_NMT_command_t command2 = CO_NMT_ENTER_OPERATIONAL;
-
-            if (closed != 1 || NodeErr) {
-                err = true;
-                break;
-            }
-            ret = CO_NMT_sendCommand(gtwa->NMT, command2, gtwa->node);
-
-            if (ret == CO_ERROR_NO) {
-                responseWithOK(gtwa);
-            }
-            else {
-                respErrorCode = CO_GTWA_respErrorInternalState;
-                err = true;
+        case CO_GTWA_BIN_REQ_NMT: {
+            CO_NMT_command_t command2 = (CO_NMT_command_t)arg[1];
+
+            if (argsSize != 2
+                || checkNetNode(gtwa, args.net, arg[0], 0, &args.respErrorCode)
+                || (command2 != CO_NMT_ENTER_OPERATIONAL
+                    && command2 != CO_NMT_ENTER_STOPPED
+                    && command2 != CO_NMT_ENTER_PRE_OPERATIONAL
+                    && command2 != CO_NMT_RESET_NODE
+                    && command2 != CO_NMT_RESET_COMMUNICATION)
+            ) {
+                args.err = true;
                 break;
             }
+            nmtCommand(gtwa, &args, command2);
+            break;
         }
+#endif
 
-        /* NMT stop node - 'stop' */
-        else if (strcmp(tok, "stop") == 0) {
-            CO_ReturnError_t ret;
-            bool_t NodeErr = checkNetNode(gtwa, net, node, 0, &respErrorCode);
-            CO_NMT_command_t command2 = CO_NMT_ENTER_STOPPED;
-
-            if (closed != 1 || NodeErr) {
-                err = true;
+        case CO_GTWA_BIN_REQ_ASCII:
+            if (argsSize != 0) {
+                args.err = true;
                 break;
             }
-            ret = CO_NMT_sendCommand(gtwa->NMT, command2, gtwa->node);
+            /* response is still binary frame, next command is ascii */
+            binSwitch(gtwa, &args, false);
+            break;
 
-            if (ret == CO_ERROR_NO) {
-                responseWithOK(gtwa);
-            }
-            else {
-                respErrorCode = CO_GTWA_respErrorInternalState;
-                err = true;
-                break;
-            }
+        default:
+            args.respErrorCode = CO_GTWA_respErrorReqNotSupported;
+            args.err = true;
+            break;
         }
 
-        /* NMT Set node to pre-operational - 'preop[erational]' */
-        else if (strcmp(tok, "preop") == 0 ||
-                 strcmp(tok, "preoperational") == 0
-        ) {
-            CO_ReturnError_t ret;
-            bool_t NodeErr = checkNetNode(gtwa, net, node, 0, &respErrorCode);
-            CO_NMT_command_t command2 = CO_NMT_ENTER_PRE_OPERATIONAL;
+        *timeDifference_us = args.timeDifference_us;
+        if (args.wait) {
+            /* request is back in commFifo */
+            gtwa->binSkip = 0;
+            break;
+        }
+        if (args.err) {
+            *respErrorCode = args.respErrorCode;
+            err = true;
+            break;
+        }
+    }
+    return err;
+}
+#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_BINARY */
 
-            if (closed != 1 || NodeErr) {
-                err = true;
-                break;
-            }
-            ret = CO_NMT_sendCommand(gtwa->NMT, command2, gtwa->node);
 
-            if (ret == CO_ERROR_NO) {
-                responseWithOK(gtwa);
-            }
-            else {
-                respErrorCode = CO_GTWA_respErrorInternalState;
-                err = true;
-                break;
-            }
-        }
+/* Return true, if next command is available in commFifo */
+static inline bool_t commAvailable(CO_GTWA_t *gtwa) {
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_BINARY
+    if (gtwa->binary) {
+        uint8_t frame[CO_GTWA_BIN_HEAD_SIZE + CO_GTWA_BIN_ARGS_SIZE];
+        return gtwa->binSkip > 0 || binPeek(gtwa, frame) > 0;
+    }
+#endif
+    return CO_fifo_CommSearch(&gtwa->commFifo, false);
+}
 
-        /* NMT reset (node or communication) - 'reset <node|comm[unication]>'*/
-        else if (strcmp(tok, "reset") == 0) {
-            CO_ReturnError_t ret;
-            bool_t NodeErr = checkNetNode(gtwa, net, node, 0, &respErrorCode);
-            CO_NMT_command_t command2;
 
-            if (closed != 0 || NodeErr) {
-                err = true;
-                break;
-            }
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SLOTS
+/* Return length of the complete ascii command at offset from the beginning of
+ * commFifo, including the command delimiter, or 0 if it is not complete. */
+static size_t commLength(CO_fifo_t *fifo, size_t offset) {
+    size_t length = 0;
 
-            /* command 2 */
-            closed = 1;
-            CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok), &closed, &err);
-            if (err) break;
+    for (;;) {
+        const uint8_t *buf;
+        const uint8_t *delim;
+        size_t count = CO_fifo_peek(fifo, offset + length, &buf);
 
-            convertToLower(tok, sizeof(tok));
-            if (strcmp(tok, "node") == 0) {
-                command2 = CO_NMT_RESET_NODE;
-            } else if (strcmp(tok, "comm") == 0 ||
-                       strcmp(tok, "communication") == 0
-            ) {
-                command2 = CO_NMT_RESET_COMMUNICATION;
-            } else {
-                err = true;
-                break;
-            }
+        if (count == 0) {
+            return 0;
+        }
+        delim = (const uint8_t *)memchr(buf, '\n', count);
+        if (delim != NULL) {
+            return length + (size_t)(delim - buf) + 1;
+        }
+        length += count;
+    }
+}
+
+#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SLOTS */
 
-            ret = CO_NMT_sendCommand(gtwa->NMT, command2, gtwa->node);
 
-            if (ret == CO_ERROR_NO) {
-                responseWithOK(gtwa);
+/* Purge commands and release slots and subscriptions, if gateway is disabled
+ * or session is reset. */
+static void purge(CO_GTWA_t *gtwa) {
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SCAN
+    if (gtwa->state == CO_GTWA_ST_SCAN) {
+        CO_nodeScan_stop(gtwa->nodeScan);
+    }
+#endif
+    gtwa->state = CO_GTWA_ST_IDLE;
+    CO_fifo_reset(&gtwa->commFifo);
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_BINARY
+    gtwa->binSkip = 0;
+#endif
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SLOTS
+    {
+        uint8_t i;
+        for (i = 0; i < gtwa->slotsCount; i++) {
+            if (gtwa->slots[i].node != 0) {
+                slotRelease(gtwa, &gtwa->slots[i]);
             }
-            else {
-                respErrorCode = CO_GTWA_respErrorInternalState;
-                err = true;
-                break;
+        }
+    }
+#endif
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SUBSCRIBE
+    {
+        uint8_t i;
+        for (i = 0; i < CO_CONFIG_GTWA_SUBSCRIPTIONS; i++) {
+            if (gtwa->subs[i].type != CO_GTWA_SUB_FREE) {
+                subRelease(&gtwa->subs[i]);
             }
         }
-#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_NMT */
+    }
+#endif
+}
 
-#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_LSS
-        /* Switch state global command - 'lss_switch_glob <0|1>' */
-        else if (strcmp(tok, "lss_switch_glob") == 0) {
-            bool_t NodeErr = checkNet(gtwa, net, &respErrorCode);
-            uint8_t select;
 
-            if (closed != 0 || NodeErr) {
-                err = true;
-                break;
-            }
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SESSIONS
+/*******************************************************************************
+ * SESSIONS
+ ******************************************************************************/
+/* If session is idle, release the node of the last SDO command for other
+ * sessions. LSS master is held until 'lss_switch_glob 0', '_lss_unlock' or
+ * reset of the session, because LSS slaves may stay in configuration state
+ * between the commands. */
+static void sessionIdle(CO_GTWA_t *gtwa) {
+    if (gtwa->sessions == NULL || gtwa->state != CO_GTWA_ST_IDLE) {
+        return;
+    }
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO
+    if (gtwa->SDO_C->nodeIDOfTheSDOServer != 0) {
+        clientRelease(gtwa, gtwa->SDO_C);
+    }
+#endif
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SCAN
+    if (gtwa->sessions->scanOwner == gtwa) {
+        gtwa->sessions->scanOwner = NULL;
+    }
+#endif
+}
 
-            /* get value */
-            closed = 1;
-            CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok), &closed, &err);
-            select = (uint8_t)getU32(tok, 0, 1, &err);
-            if (err) break;
 
-            if (select == 0) {
-                /* send non-confirmed message */
-                CO_LSSmaster_return_t ret;
-                ret = CO_LSSmaster_switchStateDeselect(gtwa->LSSmaster);
-                if (ret == CO_LSSmaster_OK) {
-                    responseWithOK(gtwa);
+/******************************************************************************/
+void CO_GTWA_sessionReset(CO_GTWA_t *gtwa) {
+    if (gtwa == NULL) {
+        return;
+    }
+
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO
+    {
+        CO_SDO_abortCode_t abortCode = CO_SDO_AB_DATA_TRANSF;
+
+        /* abort SDO transfers, idle SDO clients are not affected */
+        CO_SDOclientUpload(gtwa->SDO_C, 0, true, &abortCode, NULL, NULL, NULL);
+ #if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SLOTS
+        {
+            uint8_t i;
+            for (i = 0; i < gtwa->slotsCount; i++) {
+                CO_GTWA_slot_t *slot = &gtwa->slots[i];
+                abortCode = CO_SDO_AB_DATA_TRANSF;
+                if (slot->node != 0 && slot->download) {
+                    CO_SDOclientDownload(slot->SDO_C, 0, true, false,
+                                         &abortCode, NULL, NULL);
                 }
-                else {
-                    respErrorCode = CO_GTWA_respErrorInternalState;
-                    err = true;
-                    break;
+                else if (slot->node != 0) {
+                    CO_SDOclientUpload(slot->SDO_C, 0, true,
+                                       &abortCode, NULL, NULL, NULL);
                 }
             }
-            else {
-                /* continue with state machine */
-                gtwa->state = CO_GTWA_ST_LSS_SWITCH_GLOB;
-            }
         }
-        /* Switch state selective command -
-         * 'lss_switch_sel <vendorID> <product code> <revisionNo> <serialNo>' */
-        else if (strcmp(tok, "lss_switch_sel") == 0) {
-            bool_t NodeErr = checkNet(gtwa, net, &respErrorCode);
-            CO_LSS_address_t *addr = &gtwa->lssAddress;
+ #endif
+    }
+#endif
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_LSS
+    if ((gtwa->state >= CO_GTWA_ST_LSS_SWITCH_GLOB
+         && gtwa->state <= CO_GTWA_ST_LSS_ALLNODES)
+        || (gtwa->sessions != NULL && gtwa->sessions->lssOwner == gtwa)
+    ) {
+        CO_LSSmaster_switchStateDeselect(gtwa->LSSmaster);
+    }
+#endif
 
-            if (closed != 0 || NodeErr) {
-                err = true;
-                break;
-            }
+    purge(gtwa);
+    sessionIdle(gtwa);
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_LSS
+    lssRelease(gtwa);
+#endif
 
-            /* get values */
-            closed = 0;
-            CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok), &closed, &err);
-            addr->identity.vendorID = getU32(tok, 0, 0xFFFFFFFF, &err);
-            if (err) break;
+    gtwa->readCallback = NULL;
+    gtwa->readCallbackObject = NULL;
+    gtwa->net_default = -1;
+    gtwa->node_default = -1;
+    gtwa->respBufCount = 0;
+    gtwa->respBufOffset = 0;
+    gtwa->respHold = false;
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_READV
+    gtwa->readvCallback = NULL;
+    gtwa->respFifoCount = 0;
+#endif
+    gtwa->timeDifference_us_cumulative = 0;
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO_BATCH
+    gtwa->SDObatch = false;
+#endif
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_BINARY
+    CO_GTWA_setBinary(gtwa, false);
+    gtwa->binRemain = 0;
+#endif
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_LOG
+    CO_fifo_reset(&gtwa->logFifo);
+#endif
+}
+#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SESSIONS */
 
-            CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok), &closed, &err);
-            addr->identity.productCode = getU32(tok, 0, 0xFFFFFFFF, &err);
-            if (err) break;
 
-            CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok), &closed, &err);
-            addr->identity.revisionNumber = getU32(tok, 0, 0xFFFFFFFF, &err);
-            if (err) break;
+/*******************************************************************************
+ * PROCESS FUNCTION
+ ******************************************************************************/
+void CO_GTWA_process(CO_GTWA_t *gtwa,
+                     bool_t enable,
+                     uint32_t timeDifference_us,
+                     uint32_t *timerNext_us)
+{
+    (void)timerNext_us; /* may be unused */
 
-            closed = 1;
-            CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok), &closed, &err);
-            addr->identity.serialNumber = getU32(tok, 0, 0xFFFFFFFF, &err);
-            if (err) break;
+    bool_t err = false; /* syntax or other error, true or false, I/O variable */
+    int8_t closed; /* indication of command delimiter, I/O variable */
+    CO_GTWA_respErrorCode_t respErrorCode = CO_GTWA_respErrorNone;
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SLOTS
+    /* SDO commands at the beginning of commFifo, which wait for busy node,
+     * their length and nodes. Length of the next command after them. */
+    size_t waitLength = 0;
+    uint32_t waitNodes[4] = {0, 0, 0, 0};
+    size_t nextLength = 0;
+#endif
+
+    if (gtwa == NULL) {
+        return;
+    }
+
+    if (!enable) {
+        purge(gtwa);
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SESSIONS
+        sessionIdle(gtwa);
+#endif
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_LSS
+        lssRelease(gtwa);
+#endif
+        return;
+    }
+
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SESSIONS
+    sessionIdle(gtwa);
+#endif
+
+    /* If there is some more output data for application, read them first.
+     * Hold on this state, if necessary. */
+    if (gtwa->respHold) {
+        timeDifference_us += gtwa->timeDifference_us_cumulative;
 
-            /* continue with state machine */
-            gtwa->state = CO_GTWA_ST_LSS_SWITCH_SEL;
+        respBufTransfer(gtwa);
+        if (gtwa->respHold) {
+            gtwa->timeDifference_us_cumulative = timeDifference_us;
+            return;
+        }
+        else {
+            gtwa->timeDifference_us_cumulative = 0;
         }
-        /* LSS configure node-ID command - 'lss_set_node <node>' */
-        else if (strcmp(tok, "lss_set_node") == 0) {
-            bool_t NodeErr = checkNet(gtwa, net, &respErrorCode);
+    }
 
-            if (closed != 0 || NodeErr) {
-                err = true;
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SUBSCRIBE
+    /* Print values of subscriptions between the responses */
+    subsProcess(gtwa, timeDifference_us, timerNext_us);
+    if (gtwa->respHold) {
+        gtwa->timeDifference_us_cumulative = timeDifference_us;
+        return;
+    }
+#endif
+
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SLOTS
+    /* Process commands in slots first. Wait, if their response is not yet
+     * finished. */
+    slotsProcess(gtwa, timeDifference_us, timerNext_us);
+    if (gtwa->respHold || gtwa->slotResp != NULL) {
+        return;
+    }
+#endif
+
+    /***************************************************************************
+    * COMMAND PARSER
+    ***************************************************************************/
+    /* if idle, search for new command, skip comments or empty lines. Stop,
+     * if response of the previous command is not fully transferred. */
+    while (gtwa->state == CO_GTWA_ST_IDLE && !gtwa->respHold
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_BINARY
+           && !gtwa->binary
+#endif
+           && CO_fifo_CommSearch(&gtwa->commFifo, false)
+    ) {
+        char tok[20];
+        size_t n;
+        uint32_t ui[3];
+        int i;
+        int32_t net = gtwa->net_default;
+        int16_t node = gtwa->node_default;
+        const cmdEntry_t *cmd;
+        cmdArgs_t args;
+        /* beginning of the command, if it has to wait */
+        size_t commReadPtr = CO_fifo_getReadMark(&gtwa->commFifo);
+
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SLOTS
+        if (waitLength > 0) {
+            /* Try the next complete command in front of the waiting ones.
+             * Waiting commands are not removed from commFifo, so new data
+             * can't overwrite them. */
+            nextLength = commLength(&gtwa->commFifo, waitLength);
+            if (nextLength == 0) {
                 break;
             }
-
-            /* get value */
-            closed = 1;
-            CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok), &closed, &err);
-            gtwa->lssNID = (uint8_t)getU32(tok, 0, 0xFF, &err);
-            if (gtwa->lssNID > 0x7F && gtwa->lssNID < 0xFF) err = true;
-            if (err) break;
-
-            /* continue with state machine */
-            gtwa->state = CO_GTWA_ST_LSS_SET_NODE;
+            CO_fifo_swap(&gtwa->commFifo, waitLength, nextLength);
         }
-        /* LSS configure bit-rate command -
-         * 'lss_conf_bitrate <table_selector=0> <table_index>'
-         * table_index: 0=1000 kbit/s, 1=800 kbit/s, 2=500 kbit/s, 3=250 kbit/s,
-         *   4=125 kbit/s, 6=50 kbit/s, 7=20 kbit/s, 8=10 kbit/s, 9=auto */
-        else if (strcmp(tok, "lss_conf_bitrate") == 0) {
-            bool_t NodeErr = checkNet(gtwa, net, &respErrorCode);
-            uint8_t tableIndex;
-            int maxIndex = (sizeof(CO_LSS_bitTimingTableLookup) /
-                            sizeof(CO_LSS_bitTimingTableLookup[0])) - 1;
-
-            if (closed != 0 || NodeErr) {
-                err = true;
-                break;
-            }
-
-            /* First parameter is table selector. We only support the CiA
-             * bit timing table from CiA301 ("0") */
-            closed = 0;
-            CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok), &closed, &err);
-            (void)getU32(tok, 0, 0, &err);
-
-            /* get value */
-            closed = 1;
-            CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok), &closed, &err);
-            tableIndex = (uint8_t)getU32(tok, 0, maxIndex, &err);
-            if (tableIndex == 5) err = true;
-            if (err) break;
-            gtwa->lssBitrate = CO_LSS_bitTimingTableLookup[tableIndex];
+#endif
 
-            /* continue with state machine */
-            gtwa->state = CO_GTWA_ST_LSS_CONF_BITRATE;
+        /* parse mandatory token '"["<sequence>"]"' */
+        closed = -1;
+        n = CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok), &closed, &err);
+        /* Break if error in token or token was found, but closed with
+         * command delimiter. */
+        if (err || (n > 0 && closed != 0)) {
+            err = true;
+            break;
         }
-        /* LSS activate new bit-rate command -
-         * 'lss_activate_bitrate <switch_delay_ms>' */
-        else if (strcmp(tok, "lss_activate_bitrate") == 0) {
-            bool_t NodeErr = checkNet(gtwa, net, &respErrorCode);
-            uint16_t switchDelay;
-            CO_LSSmaster_return_t ret;
-
-            if (closed != 0 || NodeErr) {
-                err = true;
-                break;
-            }
+        /* If empty line or just comment, continue with next command */
+        else if (n == 0 && closed != 0) {
+            responseWithEmpty(gtwa);
+            continue;
+        }
+        if (tok[0] != '[' || tok[strlen(tok)-1] != ']') {
+            err = true;
+            break;
+        }
+        tok[strlen(tok)-1] = '\0';
+        gtwa->sequence = getU32(tok + 1, 0, 0xFFFFFFFF, &err);
+        if (err) break;
 
-            /* get value */
-            closed = 1;
-            CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok), &closed, &err);
-            switchDelay = (uint16_t)getU32(tok, 0, 0xFFFF, &err);
-            if (err) break;
 
-            /* send non-confirmed message */
-            ret = CO_LSSmaster_ActivateBit(gtwa->LSSmaster, switchDelay);
-            if (ret == CO_LSSmaster_OK) {
-                responseWithOK(gtwa);
-            }
-            else {
-                respErrorCode = CO_GTWA_respErrorInternalState;
+        /* parse optional tokens '[[<net>] <node>]', both numerical. Then
+         * follows mandatory token <command>, which is not numerical. */
+        for (i = 0; i < 3; i++) {
+            closed = -1;
+            n = CO_fifo_readToken(&gtwa->commFifo, tok, sizeof(tok),
+                                  &closed, &err);
+            if (err || n == 0) {
+                /* empty token, break on error */
                 err = true;
                 break;
-            }
-        }
-        /* LSS store configuration command - 'lss_store' */
-        else if (strcmp(tok, "lss_store") == 0) {
-            bool_t NodeErr = checkNet(gtwa, net, &respErrorCode);
-
-            if (closed != 1 || NodeErr) {
+            } else if (isdigit((int)tok[0]) == 0) {
+                /* <command> found */
+                break;
+            } else if (closed != 0) {
+                /* numerical value must not be closed */
                 err = true;
                 break;
             }
 
-            /* continue with state machine */
-            gtwa->state = CO_GTWA_ST_LSS_STORE;
+            ui[i] = getU32(tok, 0, 0xFFFFFFFF, &err);
+            if (err) break;
         }
-        /* Inquire LSS address command - 'lss_inquire_addr [<LSSSUB=0..3>]' */
-        else if (strcmp(tok, "lss_inquire_addr") == 0) {
-            bool_t NodeErr = checkNet(gtwa, net, &respErrorCode);
+        if (err) break;
 
-            if (NodeErr) {
+        switch(i) {
+        case 0: /* only <command> (pointed by token) */
+            break;
+        case 1: /* <node> and <command> tokens */
+            if (ui[0] > 127) {
                 err = true;
-                break;
-            }
-
-            if (closed == 0) {
-                uint8_t lsssub;
-                /* get value */
-                closed = 1;
-                CO_fifo_readToken(&gtwa->commFifo,tok,sizeof(tok),&closed,&err);
-                lsssub = (uint8_t)getU32(tok, 0, 3, &err);
-                if (err) break;
-                switch (lsssub) {
-                    case 0: gtwa->lssInquireCs = CO_LSS_INQUIRE_VENDOR; break;
-                    case 1: gtwa->lssInquireCs = CO_LSS_INQUIRE_PRODUCT; break;
-                    case 2: gtwa->lssInquireCs = CO_LSS_INQUIRE_REV; break;
-                    default: gtwa->lssInquireCs = CO_LSS_INQUIRE_SERIAL; break;
-                }
-
-                /* continue with state machine */
-                gtwa->state = CO_GTWA_ST_LSS_INQUIRE;
+                respErrorCode = CO_GTWA_respErrorUnsupportedNode;
             }
             else {
-                /* continue with state machine */
-                gtwa->state = CO_GTWA_ST_LSS_INQUIRE_ADDR_ALL;
+                node = (int16_t) ui[0];
             }
-        }
-        /* LSS inquire node-ID command - 'lss_get_node'*/
-        else if (strcmp(tok, "lss_get_node") == 0) {
-            bool_t NodeErr = checkNet(gtwa, net, &respErrorCode);
-
-            if (closed != 1 || NodeErr) {
+            break;
+        case 2: /* <net>, <node> and <command> tokens */
+            if (ui[0] > 0xFFFF) {
                 err = true;
-                break;
+                respErrorCode = CO_GTWA_respErrorUnsupportedNet;
             }
-
-            /* continue with state machine */
-            gtwa->lssInquireCs = CO_LSS_INQUIRE_NODE_ID;
-            gtwa->state = CO_GTWA_ST_LSS_INQUIRE;
-        }
-        /* LSS identify fastscan. This is a manufacturer specific command as
-         * the one in DSP309 is quite useless - '_lss_fastscan [<timeout_ms>]'*/
-        else if (strcmp(tok, "_lss_fastscan") == 0) {
-            bool_t NodeErr = checkNet(gtwa, net, &respErrorCode);
-            uint16_t timeout_ms = 0;
-
-            if (NodeErr) {
+            else if (ui[1] > 127) {
                 err = true;
-                break;
-            }
-
-            if (closed == 0) {
-                /* get value */
-                closed = 1;
-                CO_fifo_readToken(&gtwa->commFifo,tok,sizeof(tok),&closed,&err);
-                timeout_ms = (uint16_t)getU32(tok, 0, 0xFFFF, &err);
-                if (err) break;
-            }
-
-            /* If timeout not specified, use 100ms. Should work in most cases */
-            if (timeout_ms == 0) {
-                timeout_ms = 100;
+                respErrorCode = CO_GTWA_respErrorUnsupportedNode;
             }
-            CO_LSSmaster_changeTimeout(gtwa->LSSmaster, timeout_ms);
-
-            /* prepare lssFastscan, all zero */
-            memset(&gtwa->lssFastscan, 0, sizeof(gtwa->lssFastscan));
-
-            /* continue with state machine */
-            gtwa->state = CO_GTWA_ST__LSS_FASTSCAN;
-        }
-        /* LSS complete node-ID configuration command - 'lss_allnodes
-         * [<timeout_ms> [<nodeStart=1..127> <store=0|1>
-         * <scanType0=0..2> <vendorId> <scanType1=0..2> <productCode>
-         * <scanType2=0..2> <revisionNo> <scanType3=0..2> <serialNo>]]' */
-        else if (strcmp(tok, "lss_allnodes") == 0) {
-            /* Request node enumeration by LSS identify fastscan.
-             * This initiates node enumeration by the means of LSS fastscan
-             * mechanism. When this function is finished:
-             * - All nodes that match the given criteria are assigned a node ID
-             *   beginning with nodeId. If 127 is reached, the process
-             *   is stopped, no matter if there are nodes remaining or not.
-             * - No IDs are assigned because:
-             *   - the given criteria do not match any node,
-             *   - all nodes are already configured.
-             * This function needs that no node is selected when starting the
-             * scan process. */
-            bool_t NodeErr = checkNet(gtwa, net, &respErrorCode);
-            uint16_t timeout_ms = 0;
-
-            if (NodeErr) {
-                err = true;
-                break;
+            else {
+                net = (int32_t) ui[0];
+                node = (int16_t) ui[1];
             }
+            break;
+        case 3: /* <command> token contains digit */
+            err = true;
+            break;
+        }
+        if (err) break;
 
-            if (closed == 0) {
-                /* get optional token timeout (non standard) */
-                closed = -1;
-                CO_fifo_readToken(&gtwa->commFifo,tok,sizeof(tok),&closed,&err);
-                timeout_ms = (uint16_t)getU32(tok, 0, 0xFFFF, &err);
-                if (err) break;
-
-            }
-            /* If timeout not specified, use 100ms. Should work in most cases */
-            gtwa->lssTimeout_ms = timeout_ms == 0 ? 100 : timeout_ms;
-            CO_LSSmaster_changeTimeout(gtwa->LSSmaster, gtwa->lssTimeout_ms);
-            gtwa->lssNodeCount = 0;
-            gtwa->lssSubState = 0;
-
-            if (closed == 1) {
-                /* No other arguments, as by CiA specification for this command.
-                 * Do full scan. */
-                /* use start node ID 2. Should work in most cases */
-                gtwa->lssNID = 2;
-                /* store node ID in node's NVM */
-                gtwa->lssStore = true;
-                /* prepare lssFastscan, all zero */
-                memset(&gtwa->lssFastscan, 0, sizeof(gtwa->lssFastscan));
-            }
-            if (closed == 0) {
-                /* more arguments follow */
-                CO_fifo_readToken(&gtwa->commFifo,tok,sizeof(tok),&closed,&err);
-                gtwa->lssNID = (uint8_t)getU32(tok, 1, 127, &err);
-                if (err) break;
-
-                closed = -1;
-                CO_fifo_readToken(&gtwa->commFifo,tok,sizeof(tok),&closed,&err);
-                gtwa->lssStore = (bool_t)getU32(tok, 0, 1, &err);
-                if (err) break;
-
-                if (closed == 1) {
-                    /* No other arguments, prepare lssFastscan, all zero */
-                    memset(&gtwa->lssFastscan, 0, sizeof(gtwa->lssFastscan));
-                }
-            }
-            if (closed == 0) {
-                /* more arguments follow */
-                CO_LSSmaster_fastscan_t *fs = &gtwa->lssFastscan;
-
-                CO_fifo_readToken(&gtwa->commFifo,tok,sizeof(tok),&closed,&err);
-                fs->scan[CO_LSS_FASTSCAN_VENDOR_ID] = getU32(tok, 0, 2, &err);
-                if (err) break;
-
-                CO_fifo_readToken(&gtwa->commFifo,tok,sizeof(tok),&closed,&err);
-                fs->match.identity.vendorID = getU32(tok, 0, 0xFFFFFFFF, &err);
-                if (err) break;
-
-                CO_fifo_readToken(&gtwa->commFifo,tok,sizeof(tok),&closed,&err);
-                fs->scan[CO_LSS_FASTSCAN_PRODUCT] = getU32(tok, 0, 2, &err);
-                if (err) break;
-
-                CO_fifo_readToken(&gtwa->commFifo,tok,sizeof(tok),&closed,&err);
-                fs->match.identity.productCode = getU32(tok,0,0xFFFFFFFF, &err);
-                if (err) break;
-
-                CO_fifo_readToken(&gtwa->commFifo,tok,sizeof(tok),&closed,&err);
-                fs->scan[CO_LSS_FASTSCAN_REV] = getU32(tok, 0, 2, &err);
-                if (err) break;
-
-                CO_fifo_readToken(&gtwa->commFifo,tok,sizeof(tok),&closed,&err);
-                fs->match.identity.revisionNumber=getU32(tok,0,0xFFFFFFFF,&err);
-                if (err) break;
-
-                CO_fifo_readToken(&gtwa->commFifo,tok,sizeof(tok),&closed,&err);
-                fs->scan[CO_LSS_FASTSCAN_SERIAL] = getU32(tok, 0, 2, &err);
-                if (err) break;
-
-                closed = 1;
-                CO_fifo_readToken(&gtwa->commFifo,tok,sizeof(tok),&closed,&err);
-                fs->match.identity.serialNumber = getU32(tok,0,0xFFFFFFFF,&err);
-                if (err) break;
-            }
+        /* command is case insensitive */
+        convertToLower(tok, sizeof(tok));
 
-            /* continue with state machine */
-            gtwa->state = CO_GTWA_ST_LSS_ALLNODES;
+        /* find command handler and execute it */
+        cmd = (const cmdEntry_t *)bsearch(tok, cmdTable,
+                                          sizeof(cmdTable) / sizeof(cmdEntry_t),
+                                          sizeof(cmdEntry_t), tableCompare);
+        if (cmd == NULL) {
+            respErrorCode = CO_GTWA_respErrorReqNotSupported;
+            err = true;
+            break;
         }
-#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_LSS */
-
-#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_LOG
-        /* Print message log */
-        else if (strcmp(tok, "log") == 0) {
-            if (closed == 0) {
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SLOTS
+        /* Only SDO commands for other nodes may pass the waiting commands */
+        if (waitLength > 0 && ((cmd->flags & CMD_SDO) == 0U || (node >= 0
+            && (waitNodes[node >> 5] & (1UL << (node & 0x1F))) != 0))
+        ) {
+            if (!CO_fifo_rewind(&gtwa->commFifo, commReadPtr)) {
+                respErrorCode = CO_GTWA_respErrorInternalState;
                 err = true;
                 break;
             }
-            gtwa->state = CO_GTWA_ST_LOG;
+            CO_fifo_swap(&gtwa->commFifo, nextLength, waitLength);
+            break;
         }
-#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_LOG */
-
-#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_PRINT_HELP
-        /* Print help */
-        else if (strcmp(tok, "help") == 0) {
-            if (closed == 1) {
-                gtwa->helpString = CO_GTWA_helpString;
-            }
-            else {
-                /* get second token */
-                closed = 1;
-                CO_fifo_readToken(&gtwa->commFifo,tok,sizeof(tok),&closed,&err);
-                if (err) break;
-
-                convertToLower(tok, sizeof(tok));
-                if (strcmp(tok, "datatype") == 0) {
-                    gtwa->helpString = CO_GTWA_helpStringDatatypes;
-                }
-                else if (strcmp(tok, "lss") == 0) {
-                    gtwa->helpString = CO_GTWA_helpStringLss;
-                }
-                else {
+#endif
+#if ((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SESSIONS) \
+    && ((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_LSS)
+        /* LSS master is used by one session at a time */
+        if (gtwa->sessions != NULL && (cmd->flags & CMD_LSS) != 0U) {
+            if (gtwa->sessions->lssOwner != NULL
+                && gtwa->sessions->lssOwner != gtwa
+            ) {
+                /* leave the command in commFifo and try again later */
+                if (!CO_fifo_rewind(&gtwa->commFifo, commReadPtr)) {
+                    respErrorCode = CO_GTWA_respErrorInternalState;
                     err = true;
-                    break;
                 }
-            }
-            /* continue with state machine */
-            gtwa->helpStringOffset = 0;
-            gtwa->state = CO_GTWA_ST_HELP;
-        }
-#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_PRINT_HELP */
-
-#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_PRINT_LEDS
-        /* Print status led diodes */
-        else if (strcmp(tok, "led") == 0) {
-            if (closed == 0) {
-                err = true;
                 break;
             }
-            gtwa->ledStringPreviousIndex = 0xFF;
-            gtwa->state = CO_GTWA_ST_LED;
+            gtwa->sessions->lssOwner = gtwa;
         }
-#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_PRINT_LEDS */
+#endif
 
-        /* Unrecognized command */
-        else {
-            respErrorCode = CO_GTWA_respErrorReqNotSupported;
-            err = true;
-            break;
+        args.net = net;
+        args.node = node;
+        args.closed = closed;
+        args.err = false;
+        args.wait = false;
+        args.respErrorCode = CO_GTWA_respErrorNone;
+        args.timeDifference_us = timeDifference_us;
+        args.commReadPtr = commReadPtr;
+        cmd->handler(gtwa, &args);
+        closed = args.closed;
+        err = args.err;
+        respErrorCode = args.respErrorCode;
+        timeDifference_us = args.timeDifference_us;
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SLOTS
+        /* Keep waiting SDO command in commFifo and continue with the next */
+        if (args.wait && (cmd->flags & CMD_SDO) != 0U && node >= 0) {
+            size_t length = waitLength > 0
+                          ? nextLength : commLength(&gtwa->commFifo, 0);
+            if (length > 0) {
+                /* waiting commands keep their order */
+                if (waitLength > 0) {
+                    CO_fifo_swap(&gtwa->commFifo, length, waitLength);
+                }
+                waitLength += length;
+                waitNodes[node >> 5] |= 1UL << (node & 0x1F);
+                continue;
+            }
         }
+#endif
+        if (err || args.wait) break;
     } /* while CO_GTWA_ST_IDLE && CO_fifo_CommSearch */
 
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_BINARY
+    /* binary requests, also after 'set binary 1' command */
+    if (!err && gtwa->binary) {
+        closed = 1; /* invalid request is skipped by binParse() */
+        err = binParse(gtwa, &respErrorCode, &timeDifference_us);
+    }
+#endif
+
 
 
     /***************************************************************************
@@ -1549,71 +3900,66 @@ void CO_GTWA_process(CO_GTWA_t *gtwa,
     /* SDO upload state */
     case CO_GTWA_ST_READ: {
         CO_SDO_abortCode_t abortCode;
-        size_t sizeTransferred;
         CO_SDO_return_t ret;
+        bool_t next; /* next object of the batch command is initiated */
 
-        ret = CO_SDOclientUpload(gtwa->SDO_C,
-                                 timeDifference_us,
-                                 false,
-                                 &abortCode,
-                                 NULL,
-                                 &sizeTransferred,
-                                 timerNext_us);
-
-        if (ret < 0) {
-            responseWithErrorSDO(gtwa, abortCode, gtwa->SDOdataCopyStatus);
-            gtwa->state = CO_GTWA_ST_IDLE;
-        }
-        /* Response data must be read, partially or whole */
-        else if (ret == CO_SDO_RT_uploadDataBufferFull
-                 || ret == CO_SDO_RT_ok_communicationEnd
-        ) {
-            size_t fifoRemain;
-
-            /* write response head first */
-            if (!gtwa->SDOdataCopyStatus) {
-                gtwa->respBufCount = snprintf(gtwa->respBuf,
-                                              CO_GTWA_RESP_BUF_SIZE - 2,
-                                              "[%"PRId32"] ",
-                                              gtwa->sequence);
-                gtwa->SDOdataCopyStatus = true;
-            }
-
-            /* Empty SDO fifo buffer in multiple cycles. Repeat until
-             * application runs out of space (respHold) or fifo empty. */
-            do {
-                /* read SDO fifo (partially) and print specific data type as
-                 * ascii into intermediate respBuf */
-                gtwa->respBufCount += gtwa->SDOdataType->dataTypePrint(
-                    &gtwa->SDO_C->bufFifo,
-                    &gtwa->respBuf[gtwa->respBufCount],
-                    CO_GTWA_RESP_BUF_SIZE - 2 - gtwa->respBufCount,
-                    ret == CO_SDO_RT_ok_communicationEnd);
-                fifoRemain = CO_fifo_getOccupied(&gtwa->SDO_C->bufFifo);
-
-                /* end of communication, print newline and enter idle state */
-                if (ret == CO_SDO_RT_ok_communicationEnd && fifoRemain == 0) {
-                    gtwa->respBufCount +=
-                        sprintf(&gtwa->respBuf[gtwa->respBufCount], "\r\n");
+        /* Objects of the batch command are processed back to back. Local
+         * transfers may finish all of them in single call. */
+        do {
+            bool_t *started = &gtwa->SDOdataCopyStatus;
+            bool_t last = true;
+            next = false;
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO_BATCH
+            if (gtwa->SDObatch) {
+                if (!batchNext(gtwa, false)) {
                     gtwa->state = CO_GTWA_ST_IDLE;
+                    break;
                 }
+                started = &gtwa->SDObatchRespStarted;
+                last = gtwa->SDObatchLast;
+            }
+#endif
+
+            ret = clientUpload(gtwa->SDO_C, timeDifference_us, &abortCode,
+                               timerNext_us);
+            timeDifference_us = 0;
 
-                /* transfer response to the application */
-                if (respBufTransfer(gtwa) == false) {
-                    /* broken communication, send SDO abort and force finish. */
-                    abortCode = CO_SDO_AB_DATA_TRANSF;
-                    CO_SDOclientUpload(gtwa->SDO_C,
-                                       0,
-                                       true,
-                                       &abortCode,
-                                       NULL,
-                                       NULL,
-                                       NULL);
+            if (ret < 0) {
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO_BATCH
+                if (gtwa->SDObatch) {
+                    responseBatch(gtwa, abortCode, CO_GTWA_respErrorNone);
+                    next = batchFinished(gtwa);
+                }
+                else
+#endif
+                {
+                    responseWithErrorSDO(gtwa, gtwa->sequence, abortCode,
+                                         gtwa->SDOdataCopyStatus);
+                }
+                if (!next) {
                     gtwa->state = CO_GTWA_ST_IDLE;
-                    break;
                 }
-            } while (gtwa->respHold == false && fifoRemain > 0);
-        }
+            }
+            /* Response data must be read, partially or whole */
+            else if (ret == CO_SDO_RT_uploadDataBufferFull
+                     || ret == CO_SDO_RT_ok_communicationEnd
+            ) {
+                /* Empty SDO fifo buffer in multiple cycles, enter idle state
+                 * at the end of communication. */
+                if (responseUpload(gtwa, gtwa->SDO_C, gtwa->SDOdataType,
+                                   gtwa->sequence, started,
+                                   ret == CO_SDO_RT_ok_communicationEnd, last)
+                ) {
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO_BATCH
+                    next = ret == CO_SDO_RT_ok_communicationEnd
+                           && batchFinished(gtwa);
+#endif
+                    if (!next) {
+                        gtwa->state = CO_GTWA_ST_IDLE;
+                    }
+                }
+            }
+        } while (next && !gtwa->respHold);
         break;
     }
 
@@ -1621,86 +3967,137 @@ void CO_GTWA_process(CO_GTWA_t *gtwa,
     case CO_GTWA_ST_WRITE:
     case CO_GTWA_ST_WRITE_ABORTED: {
         CO_SDO_abortCode_t abortCode;
-        size_t sizeTransferred;
-        bool_t abort = false;
-        bool_t hold = false;
         CO_SDO_return_t ret;
+        bool_t next; /* next object of the batch command is initiated */
 
-        /* copy data to the SDO buffer if previous dataTypeScan was partial */
-        if (gtwa->SDOdataCopyStatus) {
-            CO_fifo_st status;
-            gtwa->SDOdataType->dataTypeScan(&gtwa->SDO_C->bufFifo,
-                                            &gtwa->commFifo,
-                                            &status);
-            /* set to true, if command delimiter was found */
-            closed = ((status & CO_fifo_st_closed) == 0) ? 0 : 1;
-            /* set to true, if data are copied only partially */
-            gtwa->SDOdataCopyStatus = (status & CO_fifo_st_partial) != 0;
-
-            /* is syntax error in command or not the last token in command */
-            if ((status & CO_fifo_st_errMask) != 0
-                || (gtwa->SDOdataCopyStatus == false && closed != 1)
-            ) {
-                abortCode = CO_SDO_AB_DEVICE_INCOMPAT;
-                abort = true; /* abort SDO communication */
-                /* clear the rest of the command, if necessary */
-                if (closed != 1)
-                    CO_fifo_CommSearch(&gtwa->commFifo, true);
-            }
-            if (gtwa->state == CO_GTWA_ST_WRITE_ABORTED) {
-                /* Stay in this state, until all data transferred via commFifo
-                 * will be purged. */
-                if (!CO_fifo_purge(&gtwa->SDO_C->bufFifo) || closed == 1) {
-                    gtwa->state = CO_GTWA_ST_IDLE;
-                }
+        /* Objects of the batch command are processed back to back. */
+        do {
+            bool_t abort = false;
+            bool_t hold = false;
+            next = false;
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO_BATCH
+            if (!batchNext(gtwa, true)) {
+                gtwa->state = CO_GTWA_ST_IDLE;
                 break;
             }
-        }
-        /* If not all data were transferred, make sure, there is enough data in
-         * SDO buffer, to continue communication. Otherwise wait and check for
-         * timeout */
-        if (gtwa->SDOdataCopyStatus
-            && CO_fifo_getOccupied(&gtwa->SDO_C->bufFifo) <
-               (CO_CONFIG_GTW_BLOCK_DL_LOOP * 7)
-        ) {
-            if (gtwa->stateTimeoutTmr > CO_GTWA_STATE_TIMEOUT_TIME_US) {
-                abortCode = CO_SDO_AB_DEVICE_INCOMPAT;
-                abort = true;
-            }
-            else {
-                gtwa->stateTimeoutTmr += timeDifference_us;
-                hold = true;
-            }
-        }
-        if (!hold || abort) {
-            /* if OS has CANtx queue, speedup block transfer */
-            int loop = 0;
-            do {
-                ret = CO_SDOclientDownload(gtwa->SDO_C,
-                                           timeDifference_us,
-                                           abort,
-                                           gtwa->SDOdataCopyStatus,
-                                           &abortCode,
-                                           &sizeTransferred,
-                                           timerNext_us);
-                if (++loop >= CO_CONFIG_GTW_BLOCK_DL_LOOP) {
+#endif
+
+            /* copy data to the SDO buffer if previous dataTypeScan was
+             * partial */
+            if (gtwa->SDOdataCopyStatus) {
+                CO_fifo_st status;
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_BINARY
+                if (gtwa->binary) {
+                    status = binCopy(gtwa);
+                }
+                else
+#endif
+                gtwa->SDOdataType->dataTypeScan(&gtwa->SDO_C->bufFifo,
+                                                &gtwa->commFifo,
+                                                &status);
+                /* set to true, if command delimiter was found */
+                closed = ((status & CO_fifo_st_closed) == 0) ? 0 : 1;
+                /* set to true, if data are copied only partially */
+                gtwa->SDOdataCopyStatus = (status & CO_fifo_st_partial) != 0;
+
+                /* is syntax error in command or not the last token in
+                 * command */
+                if ((status & CO_fifo_st_errMask) != 0
+                    || (gtwa->SDOdataCopyStatus == false && closed != 1
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO_BATCH
+                        /* batch command may continue with the next object */
+                        && !(gtwa->SDObatch && gtwa->state == CO_GTWA_ST_WRITE)
+#endif
+                       )
+                ) {
+                    abortCode = CO_SDO_AB_DEVICE_INCOMPAT;
+                    abort = true; /* abort SDO communication */
+                    /* clear the rest of the command, if necessary */
+                    if (closed != 1)
+                        CO_fifo_CommSearch(&gtwa->commFifo, true);
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO_BATCH
+                    gtwa->SDObatchLast = true;
+#endif
+                }
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO_BATCH
+                else if (gtwa->SDOdataCopyStatus == false) {
+                    gtwa->SDObatchLast = closed == 1;
+                }
+#endif
+                if (gtwa->state == CO_GTWA_ST_WRITE_ABORTED) {
+                    /* Stay in this state, until all data transferred via
+                     * commFifo will be purged. */
+                    if (!CO_fifo_purge(&gtwa->SDO_C->bufFifo) || closed == 1) {
+                        gtwa->state = CO_GTWA_ST_IDLE;
+                    }
                     break;
                 }
-            } while (ret == CO_SDO_RT_blockDownldInProgress);
-
-            /* send response in case of error or finish */
-            if (ret < 0) {
-                responseWithErrorSDO(gtwa, abortCode, false);
-                /* purge remaining data if necessary */
-                gtwa->state = gtwa->SDOdataCopyStatus
-                              ? CO_GTWA_ST_WRITE_ABORTED
-                              : CO_GTWA_ST_IDLE;
             }
-            else if (ret == CO_SDO_RT_ok_communicationEnd) {
-                responseWithOK(gtwa);
-                gtwa->state = CO_GTWA_ST_IDLE;
+            /* If not all data were transferred, make sure, there is enough
+             * data in SDO buffer, to continue communication. Otherwise wait
+             * and check for timeout */
+            if (gtwa->SDOdataCopyStatus
+                && CO_fifo_getOccupied(&gtwa->SDO_C->bufFifo) <
+                   (CO_CONFIG_GTW_BLOCK_DL_LOOP * 7)
+            ) {
+                if (gtwa->stateTimeoutTmr > CO_GTWA_STATE_TIMEOUT_TIME_US) {
+                    abortCode = CO_SDO_AB_DEVICE_INCOMPAT;
+                    abort = true;
+                }
+                else {
+                    gtwa->stateTimeoutTmr += timeDifference_us;
+                    hold = true;
+                }
             }
-        }
+            if (!hold || abort) {
+                ret = clientDownload(gtwa->SDO_C, timeDifference_us, abort,
+                                     gtwa->SDOdataCopyStatus, &abortCode,
+                                     timerNext_us);
+                timeDifference_us = 0;
+
+                /* send response in case of error or finish */
+                if (ret < 0) {
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO_BATCH
+                    if (gtwa->SDObatch) {
+                        /* rest of partially copied data will be purged together
+                         * with the rest of the command */
+                        if (gtwa->SDOdataCopyStatus) {
+                            gtwa->SDObatchLast = true;
+                        }
+                        responseBatch(gtwa, abortCode, CO_GTWA_respErrorNone);
+                        next = batchFinished(gtwa);
+                    }
+                    else
+#endif
+                    {
+                        responseWithErrorSDO(gtwa, gtwa->sequence, abortCode,
+                                             false);
+                    }
+                    /* purge remaining data if necessary */
+                    if (!next) {
+                        gtwa->state = gtwa->SDOdataCopyStatus
+                                      ? CO_GTWA_ST_WRITE_ABORTED
+                                      : CO_GTWA_ST_IDLE;
+                    }
+                }
+                else if (ret == CO_SDO_RT_ok_communicationEnd) {
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO_BATCH
+                    if (gtwa->SDObatch) {
+                        responseBatch(gtwa, CO_SDO_AB_NONE,
+                                      CO_GTWA_respErrorNone);
+                        next = batchFinished(gtwa);
+                    }
+                    else
+#endif
+                    {
+                        responseWithOK(gtwa);
+                    }
+                    if (!next) {
+                        gtwa->state = CO_GTWA_ST_IDLE;
+                    }
+                }
+            }
+        } while (next && !gtwa->respHold);
         break;
     }
 #endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO */
@@ -1982,6 +4379,119 @@ void CO_GTWA_process(CO_GTWA_t *gtwa,
     } /* CO_GTWA_ST_LSS_ALLNODES */
 #endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_LSS */
 
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SCAN
+    /* network scan, print node table, when finished */
+    case CO_GTWA_ST_SCAN: {
+        if (CO_nodeScan_process(gtwa->nodeScan,
+                                timeDifference_us, timerNext_us)
+        ) {
+            break;
+        }
+        while (gtwa->respHold == false) {
+            const CO_nodeScan_node_t *scanNode;
+            const char *stateStr;
+            size_t len;
+            uint8_t i;
+
+            if (gtwa->scanNodeId > CO_NODE_SCAN_NODE_MAX) {
+                gtwa->respBufCount =
+                    snprintf(gtwa->respBuf, CO_GTWA_RESP_BUF_SIZE,
+                             "# Found %d nodes.\n[%"PRId32"] OK\r\n",
+                             gtwa->nodeScan->nodesFound, gtwa->sequence);
+                respBufTransfer(gtwa);
+                gtwa->state = CO_GTWA_ST_IDLE;
+                break;
+            }
+            scanNode = &gtwa->nodeScan->nodes[gtwa->scanNodeId - 1];
+            if (scanNode->flags == 0) {
+                gtwa->scanNodeId++;
+                continue;
+            }
+
+            switch (scanNode->NMTstate) {
+                case CO_NMT_INITIALIZING:
+                    stateStr = "boot-up"; break;
+                case CO_NMT_PRE_OPERATIONAL:
+                    stateStr = "pre-operational"; break;
+                case CO_NMT_OPERATIONAL:
+                    stateStr = "operational"; break;
+                case CO_NMT_STOPPED:
+                    stateStr = "stopped"; break;
+                default:
+                    stateStr = "unknown"; break;
+            }
+            len = (size_t)snprintf(gtwa->respBuf, CO_GTWA_RESP_BUF_SIZE,
+                                   "# %d %s", gtwa->scanNodeId, stateStr);
+            for (i = 0; i < 4; i++) {
+                uint8_t flag = (uint8_t)(CO_NODE_SCAN_FLAG_VENDOR_ID << i);
+                if ((scanNode->flags & flag) != 0) {
+                    len += (size_t)snprintf(&gtwa->respBuf[len],
+                                            CO_GTWA_RESP_BUF_SIZE - len,
+                                            " 0x%08"PRIX32,
+                                            scanNode->identity[i]);
+                }
+                else {
+                    len += (size_t)snprintf(&gtwa->respBuf[len],
+                                            CO_GTWA_RESP_BUF_SIZE - len, " -");
+                }
+            }
+            len += (size_t)snprintf(&gtwa->respBuf[len],
+                                    CO_GTWA_RESP_BUF_SIZE - len, "\n");
+            gtwa->respBufCount = len;
+            respBufTransfer(gtwa);
+            gtwa->scanNodeId++;
+        }
+        break;
+    }
+#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SCAN */
+
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_HB_STAT
+    /* print Heartbeat statistics of monitored nodes */
+    case CO_GTWA_ST_HBSTAT: {
+        while (gtwa->respHold == false) {
+            const CO_HBconsNode_t *monitoredNode;
+            const CO_HBconsStat_t *stat;
+            size_t len;
+            uint8_t i;
+
+            if (gtwa->hbStatIdx >= gtwa->HBcons->numberOfMonitoredNodes) {
+                gtwa->respBufCount =
+                    snprintf(gtwa->respBuf, CO_GTWA_RESP_BUF_SIZE,
+                             "[%"PRId32"] OK\r\n", gtwa->sequence);
+                respBufTransfer(gtwa);
+                gtwa->state = CO_GTWA_ST_IDLE;
+                break;
+            }
+            monitoredNode = &gtwa->HBcons->monitoredNodes[gtwa->hbStatIdx];
+            gtwa->hbStatIdx++;
+            if (monitoredNode->HBstate == CO_HBconsumer_UNCONFIGURED
+                || (gtwa->hbStatNodeId != 0
+                    && gtwa->hbStatNodeId != monitoredNode->nodeId)
+            ) {
+                continue;
+            }
+
+            stat = &monitoredNode->stat;
+            len = (size_t)snprintf(gtwa->respBuf, CO_GTWA_RESP_BUF_SIZE,
+                                   "# %d %"PRIu32" %"PRIu32" %"PRIu32
+                                   " %"PRIu32" %d", monitoredNode->nodeId,
+                                   stat->count, stat->intervalMin_us,
+                                   stat->intervalAvg_us, stat->intervalMax_us,
+                                   stat->late);
+            for (i = 0; i < CO_HBCONS_STAT_BINS; i++) {
+                len += (size_t)snprintf(&gtwa->respBuf[len],
+                                        CO_GTWA_RESP_BUF_SIZE - len,
+                                        " %d", stat->histogram[i]);
+            }
+            len += (size_t)snprintf(&gtwa->respBuf[len],
+                                    CO_GTWA_RESP_BUF_SIZE - len, "\n");
+            gtwa->respBufCount = len;
+            respBufTransfer(gtwa);
+        }
+        break;
+    }
+#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_HB_STAT */
+
 #if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_LOG
     /* print message log */
     case CO_GTWA_ST_LOG: {
@@ -2062,10 +4572,14 @@ void CO_GTWA_process(CO_GTWA_t *gtwa,
     }
     } /* switch (gtwa->state) */
 
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SESSIONS
+    sessionIdle(gtwa);
+#endif
+
     /* execute next CANopen processing immediately, if idle and more commands
      * available */
     if (timerNext_us != NULL && gtwa->state == CO_GTWA_ST_IDLE
-        && CO_fifo_CommSearch(&gtwa->commFifo, false)
+        && commAvailable(gtwa)
     ) {
         *timerNext_us = 0;
     }
@@ -31,6 +31,8 @@
 #include "301/CO_fifo.h"
 #include "301/CO_SDOclient.h"
 #include "301/CO_NMT_Heartbeat.h"
+#include "301/CO_PDO.h"
+#include "301/CO_nodeScan.h"
 #include "305/CO_LSSmaster.h"
 #include "303/CO_LEDs.h"
 
@@ -38,6 +40,51 @@
 #ifndef CO_CONFIG_GTW
 #define CO_CONFIG_GTW (0)
 #endif
+#ifndef CO_CONFIG_GTWA_SLOTS
+#define CO_CONFIG_GTWA_SLOTS 4
+#endif
+#ifndef CO_CONFIG_GTWA_SUBSCRIPTIONS
+#define CO_CONFIG_GTWA_SUBSCRIPTIONS 8
+#endif
+
+#if ((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SLOTS) \
+    && !((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO)
+#error CO_CONFIG_GTW_ASCII_SLOTS requires CO_CONFIG_GTW_ASCII_SDO
+#endif
+#if ((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO_BATCH) \
+    && !((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO)
+#error CO_CONFIG_GTW_ASCII_SDO_BATCH requires CO_CONFIG_GTW_ASCII_SDO
+#endif
+#if ((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SUBSCRIBE) \
+    && !((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO)
+#error CO_CONFIG_GTW_ASCII_SUBSCRIBE requires CO_CONFIG_GTW_ASCII_SDO
+#endif
+#if ((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_BINARY) \
+    && !((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO)
+#error CO_CONFIG_GTW_ASCII_BINARY requires CO_CONFIG_GTW_ASCII_SDO
+#endif
+#if ((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SCAN) \
+    && !((CO_CONFIG_NODE_SCAN) & CO_CONFIG_NODE_SCAN_ENABLE)
+#error CO_CONFIG_GTW_ASCII_SCAN requires CO_CONFIG_NODE_SCAN_ENABLE
+#endif
+#if ((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_HB_STAT) \
+    && !((CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_STATISTICS)
+#error CO_CONFIG_GTW_ASCII_HB_STAT requires CO_CONFIG_HB_CONS_STATISTICS
+#endif
+
+/* RPDO and TPDO events are available for subscriptions */
+#if ((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SUBSCRIBE) \
+    && ((CO_CONFIG_PDO) & CO_CONFIG_PDO_CALLBACK_EVENT)
+#if (CO_CONFIG_PDO) & CO_CONFIG_RPDO_ENABLE
+#define CO_GTWA_SUBSCRIBE_RPDO
+#endif
+#if (CO_CONFIG_PDO) & CO_CONFIG_TPDO_ENABLE
+#define CO_GTWA_SUBSCRIBE_TPDO
+#endif
+#if (CO_CONFIG_PDO) & (CO_CONFIG_RPDO_ENABLE | CO_CONFIG_TPDO_ENABLE)
+#define CO_GTWA_SUBSCRIBE_PDO
+#endif
+#endif
 
 #if ((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII) || defined CO_DOXYGEN
 
@@ -77,6 +124,17 @@ extern "C" {
 Command strings start with '"["<sequence>"]"' followed by:
 [[<net>] <node>] r[ead] <index> <subindex> [<datatype>]        # SDO upload.
 [[<net>] <node>] w[rite] <index> <subindex> <datatype> <value> # SDO download.
+[[<net>] <node>] rm <index> <subindex> <datatype> \\
+                    [<index> <subindex> <datatype> ...]    # SDO upload batch.
+[[<net>] <node>] wm <index> <subindex> <datatype> <value> \\
+                    [<index> <subindex> <datatype> <value> ...]
+                                                # SDO download batch.
+
+subscribe od <index> <subindex> <datatype> [<interval_ms>]
+                                         # Subscribe to local OD variable.
+subscribe rpdo|tpdo <number> [<interval_ms>]
+                                         # Subscribe to RPDO or TPDO.
+unsubscribe [<sequence>]                 # Cancel one or all subscriptions.
 
 [[<net>] <node>] start                   # NMT Start node.
 [[<net>] <node>] stop                    # NMT Stop node.
@@ -88,6 +146,10 @@ Command strings start with '"["<sequence>"]"' followed by:
 [<net>] set node <value>                 # Set default node.
 [<net>] set sdo_timeout <value>          # Configure SDO time-out.
 [<net>] set sdo_block <value>            # Enable/disable SDO block transfer.
+set binary <0|1>                         # Switch to binary framing.
+
+[<net>] scan [<timeout_ms>]              # Scan network, print node table.
+[<net>] hbstat [<node>]                  # Print Heartbeat statistics.
 
 help [datatype|lss]                      # Print this or datatype or lss help.
 led                                      # Print status LED diodes.
@@ -105,6 +167,27 @@ Response:
   disabled by default.
 * If '<net>' or '<node>' is not specified within commands, then value defined
   by 'set network' or 'set node' command is used.
+* 'rm' and 'wm' are non-standard. Objects are transferred one after another,
+  response is one line with space separated result of each object:
+  <value> or OK or ERROR:<SDO-abort-code>. After syntax error in the object
+  list, ERROR:<internal-error-code> is the last result. In 'wm' command, value
+  of the string datatype (vs, os, us, d, hex) must be the last one.
+* 'subscribe' and 'unsubscribe' are non-standard. After 'OK' response, gateway
+  prints asynchronous lines "["<sequence>"]" <value>, tagged with sequence of
+  the subscribe command: on change of local OD variable (up to 8 bytes long),
+  on received RPDO or on sent TPDO (<value> is hex PDO data). Lines are not
+  printed more often than <interval_ms>, only the latest value is printed.
+* 'set binary 1' is non-standard. After 'OK' response, commands and responses
+  are binary frames, see CO_GTWA_setBinary().
+* 'scan' is non-standard. Identity of all nodes is read concurrently, nodes
+  which don't respond within <timeout_ms> (100 by default) are absent. Before
+  'OK' response, gateway prints one comment line for each found node:
+  "# "<node> <NMT-state> <vendorId> <productCode> <revisionNo> <serialNo>.
+  NMT state is from Heartbeat or boot-up, unknown values are printed as '-'.
+* 'hbstat' is non-standard. Before 'OK' response, gateway prints one comment
+  line for each monitored node (or only for <node>): "# "<node> <count>
+  <min_us> <avg_us> <max_us> <late> <h0> ... <h7>. Histogram bin <hN> counts
+  intervals from N/8 to (N+1)/8 of the consumer time, <h7> also longer ones.
 
 Datatypes:
 b                  # Boolean.
@@ -153,6 +236,62 @@ lss_allnodes [<timeout_ms> [<nodeStart=1..127> <store=0|1>\\
 #endif
 
 
+#if ((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_READV) || defined CO_DOXYGEN
+/** Maximum number of data blocks passed to readvCallback at once: rest of the
+ * response buffer and up to two blocks of data from the fifo, if data wraps
+ * around its end. */
+#define CO_GTWA_IOV_MAX 3
+
+/**
+ * Block of response data for vectored read, see CO_GTWA_initReadv()
+ */
+typedef struct {
+    /** Pointer to the data */
+    const char *buf;
+    /** Count of bytes at buf */
+    size_t count;
+} CO_GTWA_iovec_t;
+#endif
+
+
+#if ((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_BINARY) || defined CO_DOXYGEN
+/** Size of the binary frame head: length (4 bytes), sequence (4 bytes) and
+ * code (1 byte). Length counts bytes after the length field. */
+#define CO_GTWA_BIN_HEAD_SIZE 9
+
+/** Maximum size of the binary request arguments, which are parsed at once.
+ * Data of the SDO download request follows the arguments. */
+#define CO_GTWA_BIN_ARGS_SIZE 4
+
+/**
+ * Codes of the binary frames, see CO_GTWA_setBinary()
+ */
+typedef enum {
+    /** Request SDO upload, arguments: node, index (2 bytes), subindex */
+    CO_GTWA_BIN_REQ_READ = 0x01U,
+    /** Request SDO download, arguments: node, index (2 bytes), subindex,
+     * followed by data */
+    CO_GTWA_BIN_REQ_WRITE = 0x02U,
+    /** Request NMT command, arguments: node (0 for all nodes) and
+     * @ref CO_NMT_command_t */
+    CO_GTWA_BIN_REQ_NMT = 0x10U,
+    /** Request switch back to ascii commands, no arguments */
+    CO_GTWA_BIN_REQ_ASCII = 0x7FU,
+    /** Response success, followed by uploaded data, if any */
+    CO_GTWA_BIN_RESP_OK = 0x00U,
+    /** Response with part of uploaded data, more frames will follow */
+    CO_GTWA_BIN_RESP_PARTIAL = 0x01U,
+    /** Response SDO abort, followed by @ref CO_SDO_abortCode_t (4 bytes) */
+    CO_GTWA_BIN_RESP_ABORT = 0x02U,
+    /** Response gateway error, followed by @ref CO_GTWA_respErrorCode_t
+     * (2 bytes) */
+    CO_GTWA_BIN_RESP_ERROR = 0x03U,
+    /** Value of the subscription, followed by data */
+    CO_GTWA_BIN_RESP_SUBSCRIPTION = 0x04U
+} CO_GTWA_binCode_t;
+#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_BINARY */
+
+
 /** Timeout time in microseconds for some internal states. */
 #ifndef CO_GTWA_STATE_TIMEOUT_TIME_US
 #define CO_GTWA_STATE_TIMEOUT_TIME_US 1200000
@@ -254,6 +393,10 @@ typedef enum {
     CO_GTWA_ST__LSS_FASTSCAN = 0x30U,
     /** LSS 'lss_allnodes' */
     CO_GTWA_ST_LSS_ALLNODES = 0x31U,
+    /** network 'scan' */
+    CO_GTWA_ST_SCAN = 0x40U,
+    /** Heartbeat statistics 'hbstat' */
+    CO_GTWA_ST_HBSTAT = 0x41U,
     /** print message 'log' */
     CO_GTWA_ST_LOG = 0x80U,
     /** print 'help' text */
@@ -291,6 +434,98 @@ typedef struct {
 #endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO */
 
 
+#if ((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SLOTS) || defined CO_DOXYGEN
+/**
+ * Command slot of the Gateway-ascii object, see CO_GTWA_initSlots()
+ */
+typedef struct {
+    /** SDO client object from CO_GTWA_initSlots() */
+    CO_SDOclient_t *SDO_C;
+    /** Sequence number of the command executed in this slot */
+    uint32_t sequence;
+    /** CANopen Node ID of the SDO server, 0 if slot is free */
+    uint8_t node;
+    /** Data type of variable in current SDO communication */
+    const CO_GTWA_dataType_t *SDOdataType;
+    /** True, if response has started */
+    bool_t SDOdataCopyStatus;
+    /** True, if SDO communication ended with error, which is not reported
+     * yet. Abort code is in abortCode. */
+    bool_t aborted;
+    /** SDO abort code, valid if aborted is true */
+    CO_SDO_abortCode_t abortCode;
+    /** True for SDO download, false for SDO upload */
+    bool_t download;
+} CO_GTWA_slot_t;
+#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SLOTS */
+
+
+#if ((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SUBSCRIBE) || defined CO_DOXYGEN
+/**
+ * Type of the subscription in Gateway-ascii object
+ */
+typedef enum {
+    /** Subscription is free */
+    CO_GTWA_SUB_FREE = 0,
+    /** Change of local OD variable */
+    CO_GTWA_SUB_OD = 1,
+    /** Received RPDO */
+    CO_GTWA_SUB_RPDO = 2,
+    /** Sent TPDO */
+    CO_GTWA_SUB_TPDO = 3
+} CO_GTWA_subType_t;
+
+/**
+ * Subscription of the Gateway-ascii object, see CO_GTWA_initSubscribe()
+ */
+typedef struct {
+    /** Type of the subscription, CO_GTWA_SUB_FREE if not used */
+    CO_GTWA_subType_t type;
+    /** Sequence number of the subscribe command, printed with each value */
+    uint32_t sequence;
+    /** Minimum interval between printed values in microseconds */
+    uint32_t interval_us;
+    /** Time since the last printed value or since the last sample of the OD
+     * variable in microseconds */
+    uint32_t timer_us;
+    /** Data type of the printed value */
+    const CO_GTWA_dataType_t *dataType;
+    /** IO access to the subscribed OD variable */
+    OD_IO_t OD_IO;
+#if defined CO_GTWA_SUBSCRIBE_PDO || defined CO_DOXYGEN
+    /** Subscribed RPDO or TPDO */
+    CO_PDO_common_t *PDO;
+    /** Variable indicates, if new PDO event is received from callback */
+    volatile void *eventNew;
+#endif
+    /** Length of the data */
+    uint8_t dataLength;
+    /** Latest data from PDO event or OD variable */
+    uint8_t data[8];
+} CO_GTWA_sub_t;
+#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SUBSCRIBE */
+
+
+#if ((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SESSIONS) || defined CO_DOXYGEN
+/**
+ * Resources shared by the sessions of the gateway, see CO_GTWA_initSessions()
+ */
+typedef struct {
+    /** One bit for each node ID, set if SDO client of any session or slot is
+     * configured for the node */
+    uint32_t nodeBusy[4];
+    /** Session, which owns LSS master from its first LSS command until
+     * 'lss_switch_glob 0', '_lss_unlock' or session reset, NULL if free */
+    const void *lssOwner;
+#if ((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SCAN) || defined CO_DOXYGEN
+    /** Session, which executes 'scan' command, NULL if none. SDO commands of
+     * other sessions wait meanwhile. */
+    const void *scanOwner;
+#endif
+} CO_GTWA_sessions_t;
+#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SESSIONS */
+
+
 /**
  * CANopen Gateway-ascii object
  */
@@ -312,6 +547,25 @@ typedef struct {
     /** Pointer to object, which will be used inside readCallback, from
      * CO_GTWA_init() */
     void *readCallbackObject;
+#if ((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_READV) || defined CO_DOXYGEN
+    /** Pointer to external function for vectored reading of response from
+     * Gateway-ascii object, used instead of readCallback. Pointer is
+     * initialized in CO_GTWA_initReadv(). Data blocks point directly into
+     * internal buffers, they are valid only during the call.
+     *
+     * @param object Void pointer to custom object (readCallbackObject)
+     * @param iov Array of data blocks, which follow each other in the stream
+     * @param iovCount Number of blocks in iov, up to #CO_GTWA_IOV_MAX
+     * @param [out] connectionOK different than 0 indicates connection is OK.
+     *
+     * @return Count of bytes actually transferred, counted from the start of
+     * the first block.
+     */
+    size_t (*readvCallback)(void *object,
+                            const CO_GTWA_iovec_t *iov,
+                            uint8_t iovCount,
+                            uint8_t *connectionOK);
+#endif
     /** Sequence number of the command */
     uint32_t sequence;
     /** Default CANopen Net number is undefined (-1) at startup */
@@ -337,6 +591,15 @@ typedef struct {
     size_t respBufOffset;
     /** See respBufOffset above */
     bool_t respHold;
+#if ((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_READV) || defined CO_DOXYGEN
+    /** Fifo with the rest of the response, which follows the data in respBuf.
+     * Used with readvCallback for data of binary upload, which is then read
+     * directly from the SDO client buffer. */
+    CO_fifo_t *respFifo;
+    /** Count of bytes of the response in respFifo, respHold is set while
+     * there are some. */
+    size_t respFifoCount;
+#endif
     /** Sum of time difference from CO_GTWA_process() in case of respHold */
     uint32_t timeDifference_us_cumulative;
     /** Current state of the gateway object */
@@ -357,6 +620,60 @@ typedef struct {
     /** Data type of variable in current SDO communication */
     const CO_GTWA_dataType_t *SDOdataType;
 #endif
+#if ((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO_BATCH) || defined CO_DOXYGEN
+    /** True, if 'rm' or 'wm' command is processing */
+    bool_t SDObatch;
+    /** True, if current object is the last one in 'rm' or 'wm' command */
+    bool_t SDObatchLast;
+    /** True, if next object of 'rm' or 'wm' command has to be started */
+    bool_t SDObatchNext;
+    /** True, if response to 'rm' or 'wm' command has started */
+    bool_t SDObatchRespStarted;
+#endif
+#if ((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SLOTS) || defined CO_DOXYGEN
+    /** Command slots of usable size @ref CO_CONFIG_GTWA_SLOTS */
+    CO_GTWA_slot_t slots[CO_CONFIG_GTWA_SLOTS];
+    /** Number of slots initialized by CO_GTWA_initSlots() */
+    uint8_t slotsCount;
+    /** Slot, which has started its response and didn't finish it yet. Other
+     * responses must wait. NULL if none. */
+    CO_GTWA_slot_t *slotResp;
+#endif
+#if ((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SUBSCRIBE) || defined CO_DOXYGEN
+    /** Subscriptions of usable size @ref CO_CONFIG_GTWA_SUBSCRIPTIONS */
+    CO_GTWA_sub_t subs[CO_CONFIG_GTWA_SUBSCRIPTIONS];
+    /** Index of the last printed subscription, subscriptions are printed in
+     * round robin order */
+    uint8_t subsLast;
+    /** Object dictionary from CO_GTWA_initSubscribe() */
+    OD_t *OD;
+    /** CAN module from CO_GTWA_initSubscribe(), used for CO_LOCK_OD() */
+    CO_CANmodule_t *subsCANdev;
+#ifdef CO_GTWA_SUBSCRIBE_RPDO
+    /** RPDO objects from CO_GTWA_initSubscribe() */
+    CO_RPDO_t *RPDO;
+    /** Number of RPDO objects */
+    uint16_t RPDOcount;
+#endif
+#ifdef CO_GTWA_SUBSCRIBE_TPDO
+    /** TPDO objects from CO_GTWA_initSubscribe() */
+    CO_TPDO_t *TPDO;
+    /** Number of TPDO objects */
+    uint16_t TPDOcount;
+#endif
+#endif
+#if ((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_BINARY) || defined CO_DOXYGEN
+    /** True, if commands and responses are binary frames */
+    bool_t binary;
+    /** Number of bytes of invalid binary frame, which are not purged yet */
+    size_t binSkip;
+    /** Number of bytes of SDO download data, which are not copied yet */
+    size_t binRemain;
+#endif
+#if ((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SESSIONS) || defined CO_DOXYGEN
+    /** Shared resources from CO_GTWA_initSessions(), NULL if not used */
+    CO_GTWA_sessions_t *sessions;
+#endif
 #if ((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_NMT) || defined CO_DOXYGEN
     /** NMT object from CO_GTWA_init() */
     CO_NMT_t *NMT;
@@ -383,6 +700,20 @@ typedef struct {
     /** LSS allnodes timeout parameter */
     uint16_t lssTimeout_ms;
 #endif
+#if ((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SCAN) || defined CO_DOXYGEN
+    /** Network scan object from CO_GTWA_initScan() */
+    CO_nodeScan_t *nodeScan;
+    /** Node ID of the next node to print from the node table */
+    uint8_t scanNodeId;
+#endif
+#if ((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_HB_STAT) || defined CO_DOXYGEN
+    /** Heartbeat consumer object from CO_GTWA_initHBstat() */
+    CO_HBconsumer_t *HBcons;
+    /** Index of the next monitored node to print */
+    uint8_t hbStatIdx;
+    /** Node ID from 'hbstat' command, 0 for all monitored nodes */
+    uint8_t hbStatNodeId;
+#endif
 #if ((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_LOG) || defined CO_DOXYGEN
     /** Message log buffer of usable size @ref CO_CONFIG_GTWA_LOG_BUF_SIZE */
     uint8_t logBuf[CO_CONFIG_GTWA_LOG_BUF_SIZE + 1];
@@ -414,7 +745,9 @@ typedef struct {
  * @param LEDs LEDs object
  * @param dummy dummy argument, set to 0
  *
- * @return #CO_ReturnError_t: CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT
+ * @return #CO_ReturnError_t: CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT.
+ * CO_ERROR_DATA_CORRUPT, if @ref CO_CONFIG_DEBUG_GTW_TABLES is enabled and
+ * internal tables are not sorted.
  */
 CO_ReturnError_t CO_GTWA_init(CO_GTWA_t* gtwa,
 #if ((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO) || defined CO_DOXYGEN
@@ -434,13 +767,175 @@ CO_ReturnError_t CO_GTWA_init(CO_GTWA_t* gtwa,
                               uint8_t dummy);
 
 
+#if ((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SLOTS) || defined CO_DOXYGEN
+/**
+ * Initialize command slots in Gateway-ascii object
+ *
+ * Each slot has own SDO client and executes one SDO upload (read) or SDO
+ * download (write) command. Write command is executed in the slot, if all its
+ * data fit into the SDO buffer of the slot, larger data and binary write
+ * requests are streamed by the SDO client from CO_GTWA_init(). Commands for
+ * different nodes then run concurrently and their responses are sent in order
+ * of completion, tagged with own sequence number, as allowed by CiA 309-3. If
+ * there is no free slot or if node is already busy, SDO command waits in the
+ * command buffer, while following SDO commands for other nodes are executed.
+ * Other commands (NMT, LSS, set, ...) and SDO commands for the node of any
+ * waiting command keep their order. Batch commands are executed by the SDO
+ * client from CO_GTWA_init(). If no slots are initialized, gateway works as
+ * without CO_CONFIG_GTW_ASCII_SLOTS.
+ *
+ * Function must be called after CO_GTWA_init().
+ *
+ * @param gtwa This object
+ * @param SDO_C Array of SDO client objects, one for each slot. They must not be
+ * used by other parts of the application.
+ * @param count Number of SDO client objects in array. Up to
+ * @ref CO_CONFIG_GTWA_SLOTS are used, others are ignored.
+ *
+ * @return #CO_ReturnError_t: CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT
+ */
+CO_ReturnError_t CO_GTWA_initSlots(CO_GTWA_t* gtwa,
+                                   CO_SDOclient_t* SDO_C,
+                                   uint8_t count);
+#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SLOTS */
+
+
+#if ((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SUBSCRIBE) || defined CO_DOXYGEN
+/**
+ * Initialize subscriptions in Gateway-ascii object
+ *
+ * Command 'subscribe' registers local OD variable, RPDO or TPDO. OD variables
+ * are sampled from CO_GTWA_process() once per interval of the subscription,
+ * when output is free, and printed if changed. Subscription with zero interval
+ * is sampled in each CO_GTWA_process() call with free output. PDOs register
+ * own event callback with CO_PDO_initCallbackEvent(), so it must not be used
+ * by application for subscribed PDO. Values are printed between the responses
+ * to other commands. If value changes faster than the interval of the
+ * subscription, only the latest value is printed, when interval expires.
+ *
+ * Function must be called after CO_GTWA_init(). Subscriptions are cleared by
+ * CO_GTWA_init() and when gateway is disabled.
+ *
+ * @param gtwa This object
+ * @param RPDO Array of RPDO objects, may be NULL.
+ * @param RPDOcount Number of RPDO objects in array.
+ * @param TPDO Array of TPDO objects, may be NULL.
+ * @param TPDOcount Number of TPDO objects in array.
+ * @param CANdev CAN module, which processes PDOs of this device. It is used
+ * for CO_LOCK_OD() when sampling the OD variables mappable to PDO.
+ * @param OD Object Dictionary of this device.
+ *
+ * @return #CO_ReturnError_t: CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT
+ */
+CO_ReturnError_t CO_GTWA_initSubscribe(CO_GTWA_t* gtwa,
+#if defined CO_GTWA_SUBSCRIBE_RPDO || defined CO_DOXYGEN
+                                       CO_RPDO_t *RPDO,
+                                       uint16_t RPDOcount,
+#endif
+#if defined CO_GTWA_SUBSCRIBE_TPDO || defined CO_DOXYGEN
+                                       CO_TPDO_t *TPDO,
+                                       uint16_t TPDOcount,
+#endif
+                                       CO_CANmodule_t *CANdev,
+                                       OD_t *OD);
+#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SUBSCRIBE */
+
+
+#if ((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SCAN) || defined CO_DOXYGEN
+/**
+ * Initialize network scan in Gateway-ascii object
+ *
+ * Command 'scan' starts CO_nodeScan_start() for all node IDs and prints the
+ * node table, when it is finished. Scan waits, until SDO commands in slots
+ * (and in other sessions) are finished, because responses of all SDO servers
+ * are received by the scan. With sessions, SDO commands of other sessions wait
+ * until scan is finished.
+ *
+ * Function must be called after CO_GTWA_init().
+ *
+ * @param gtwa This object
+ * @param nodeScan Network scan object, initialized by CO_nodeScan_init(). It
+ * may be shared by sessions, but must not be used by the application.
+ *
+ * @return #CO_ReturnError_t: CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT
+ */
+CO_ReturnError_t CO_GTWA_initScan(CO_GTWA_t* gtwa, CO_nodeScan_t *nodeScan);
+#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SCAN */
+
+
+#if ((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_HB_STAT) || defined CO_DOXYGEN
+/**
+ * Initialize Heartbeat statistics in Gateway-ascii object
+ *
+ * Command 'hbstat' prints statistics of Heartbeat intervals of nodes, which
+ * are monitored by Heartbeat consumer, see @ref CO_HBconsStat_t.
+ *
+ * Function must be called after CO_GTWA_init().
+ *
+ * @param gtwa This object
+ * @param HBcons Heartbeat consumer object, initialized by
+ * CO_HBconsumer_init().
+ *
+ * @return #CO_ReturnError_t: CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT
+ */
+CO_ReturnError_t CO_GTWA_initHBstat(CO_GTWA_t* gtwa, CO_HBconsumer_t *HBcons);
+#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_HB_STAT */
+
+
+#if ((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SESSIONS) || defined CO_DOXYGEN
+/**
+ * Join Gateway-ascii objects into sessions of one gateway
+ *
+ * Each object is then one session, for example one client connection of the
+ * socket server in the OS. Session has own command buffer, read callback,
+ * default net and node, framing, subscriptions and own SDO client (and slots),
+ * so commands from different clients are executed concurrently. Access to the
+ * shared resources is arbitrated: SDO command for the node, which is accessed
+ * from other session, and LSS command, while LSS master is owned by other
+ * session, wait in the command buffer of own session. Session owns LSS master
+ * from its first LSS command until 'lss_switch_glob 0', '_lss_unlock' or
+ * session reset, so LSS slaves in configuration state are not accessed by
+ * other sessions. NMT commands are sent immediately. PDO can be subscribed
+ * from one session only.
+ *
+ * Function must be called after CO_GTWA_init() (and CO_GTWA_initSlots()) of all
+ * objects. SDO clients of the sessions are disabled between the commands.
+ *
+ * @param gtwa Array of Gateway-ascii objects.
+ * @param count Number of objects in array.
+ * @param sessions Object for shared resources, will be initialized.
+ *
+ * @return #CO_ReturnError_t: CO_ERROR_NO or CO_ERROR_ILLEGAL_ARGUMENT
+ */
+CO_ReturnError_t CO_GTWA_initSessions(CO_GTWA_t* gtwa,
+                                      uint8_t count,
+                                      CO_GTWA_sessions_t *sessions);
+
+
+/**
+ * Reset the session, when its client connection is closed
+ *
+ * Ongoing SDO transfers of the session are aborted, LSS slaves are switched to
+ * waiting state and LSS master is released, if owned by the session,
+ * subscriptions are released, command and response buffers are purged.
+ * Default net and node and ascii framing are restored. SDO timeout and block transfer settings are kept. Read
+ * callback is cleared, CO_GTWA_initRead() should be called for the next
+ * connection.
+ *
+ * @param gtwa This object
+ */
+void CO_GTWA_sessionReset(CO_GTWA_t* gtwa);
+#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SESSIONS */
+
+
 /**
  * Initialize read callback in Gateway-ascii object
  *
  * Callback will be used for transfer data to output stream of the application.
  * It will be called from CO_GTWA_process() zero or multiple times, depending on
  * the data available. If readCallback is uninitialized or NULL, then output
- * data will be purged.
+ * data will be purged. Previously set readvCallback (see CO_GTWA_initReadv())
+ * is cleared.
  *
  * @param gtwa This object will be initialized
  * @param readCallback Pointer to external function for reading response from
@@ -456,6 +951,33 @@ void CO_GTWA_initRead(CO_GTWA_t* gtwa,
                       void *readCallbackObject);
 
 
+#if ((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_READV) || defined CO_DOXYGEN
+/**
+ * Initialize vectored read callback in Gateway-ascii object
+ *
+ * Same as CO_GTWA_initRead(), but response is passed to the application as
+ * array of data blocks, which point directly into the internal buffers. In
+ * binary mode (see CO_GTWA_setBinary()) data of the upload response is passed
+ * from the SDO client buffer as one frame, without copying into intermediate
+ * response buffer. If application reads only part of the data, the rest stays
+ * in place until the next call. Previously set readCallback is cleared.
+ *
+ * @param gtwa This object will be initialized
+ * @param readvCallback Pointer to external function for reading response from
+ * Gateway-ascii object. See #CO_GTWA_t for parameters. If NULL, output data
+ * will be purged.
+ * @param readCallbackObject Pointer to object, which will be used inside
+ * readvCallback
+ */
+void CO_GTWA_initReadv(CO_GTWA_t* gtwa,
+                       size_t (*readvCallback)(void *object,
+                                               const CO_GTWA_iovec_t *iov,
+                                               uint8_t iovCount,
+                                               uint8_t *connectionOK),
+                       void *readCallbackObject);
+#endif
+
+
 /**
  * Get free write buffer space
  *
@@ -491,6 +1013,34 @@ static inline size_t CO_GTWA_write(CO_GTWA_t* gtwa,
 }
 
 
+#if ((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_BINARY) || defined CO_DOXYGEN
+/**
+ * Select binary or ascii framing of commands and responses
+ *
+ * Binary frame is: length (4 bytes), sequence (4 bytes), code (1 byte) and
+ * arguments or data. Multi-byte values are little endian and length counts
+ * all bytes after the length field. Requests and responses use the same
+ * sequence numbers, the same SDO client, slots and NMT master as ascii
+ * commands, see @ref CO_GTWA_binCode_t. Uploaded data and data to download
+ * are raw bytes of any length. Upload response may be split into multiple
+ * frames. Invalid frame is responded with error and skipped. Values of the
+ * subscriptions are binary frames too. Other commands are available in ascii
+ * mode only.
+ *
+ * Framing can also be changed by command 'set binary 1' and by binary request
+ * CO_GTWA_BIN_REQ_ASCII. Function should be called, when new connection is
+ * established, before the first command.
+ *
+ * @param gtwa This object
+ * @param enable True for binary framing, false for ascii commands
+ */
+static inline void CO_GTWA_setBinary(CO_GTWA_t* gtwa, bool_t enable) {
+    gtwa->binary = enable;
+    gtwa->binSkip = 0;
+}
+#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_BINARY */
+
+
 #if ((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_LOG) || defined CO_DOXYGEN
 /**
  * Print message log string into fifo buffer
@@ -67,7 +67,11 @@
  #if OD_CNT_ARR_1016 < 1 || OD_CNT_ARR_1016 > 127
   #error OD_CNT_ARR_1016 is not defined in Object Dictionary or value is wrong!
  #endif
- #define CO_RX_CNT_HB_CONS OD_CNT_ARR_1016
+ #if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_NODE_INDEXED
+  #define CO_RX_CNT_HB_CONS 1
+ #else
+  #define CO_RX_CNT_HB_CONS OD_CNT_ARR_1016
+ #endif
 #else
  #define CO_RX_CNT_HB_CONS 0
 #endif
@@ -242,8 +246,26 @@
 #define CO_RX_CNT_LSS_MST OD_CNT_LSS_MST
 #define CO_TX_CNT_LSS_MST OD_CNT_LSS_MST
 
+#if (CO_CONFIG_NODE_SCAN) & CO_CONFIG_NODE_SCAN_ENABLE
+ #if !defined OD_CNT_NODE_SCAN
+  #define OD_CNT_NODE_SCAN 1
+ #elif OD_CNT_NODE_SCAN < 0 || OD_CNT_NODE_SCAN > 1
+  #error OD_CNT_NODE_SCAN not correct!
+ #endif
+ #define CO_RX_CNT_NODE_SCAN OD_CNT_NODE_SCAN
+ #define CO_TX_CNT_NODE_SCAN OD_CNT_NODE_SCAN
+#else
+ #define CO_RX_CNT_NODE_SCAN 0
+ #define CO_TX_CNT_NODE_SCAN 0
+#endif
+
 #if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII
- #define OD_CNT_GTWA 1
+ #if !defined OD_CNT_GTWA
+  #define OD_CNT_GTWA 1
+ #elif OD_CNT_GTWA < 1 || (OD_CNT_GTWA > 1 \
+                          && !((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SESSIONS))
+  #error OD_CNT_GTWA not correct!
+ #endif
 #endif
 
 #if (CO_CONFIG_TRACE) & CO_CONFIG_TRACE_ENABLE
@@ -265,9 +287,11 @@
 #define CO_RX_IDX_SRDO      (CO_RX_IDX_GFC      + CO_RX_CNT_GFC)
 #define CO_RX_IDX_RPDO      (CO_RX_IDX_SRDO     + CO_RX_CNT_SRDO * 2)
 #define CO_RX_IDX_SDO_SRV   (CO_RX_IDX_RPDO     + CO_RX_CNT_RPDO)
-#define CO_RX_IDX_SDO_CLI   (CO_RX_IDX_SDO_SRV  + CO_RX_CNT_SDO_SRV)
+#define CO_RX_IDX_SCAN_SDO  (CO_RX_IDX_SDO_SRV  + CO_RX_CNT_SDO_SRV)
+#define CO_RX_IDX_SDO_CLI   (CO_RX_IDX_SCAN_SDO + CO_RX_CNT_NODE_SCAN)
 #define CO_RX_IDX_HB_CONS   (CO_RX_IDX_SDO_CLI  + CO_RX_CNT_SDO_CLI)
-#define CO_RX_IDX_LSS_SLV   (CO_RX_IDX_HB_CONS  + CO_RX_CNT_HB_CONS)
+#define CO_RX_IDX_SCAN_HB   (CO_RX_IDX_HB_CONS  + CO_RX_CNT_HB_CONS)
+#define CO_RX_IDX_LSS_SLV   (CO_RX_IDX_SCAN_HB  + CO_RX_CNT_NODE_SCAN)
 #define CO_RX_IDX_LSS_MST   (CO_RX_IDX_LSS_SLV  + CO_RX_CNT_LSS_SLV)
 #define CO_CNT_ALL_RX_MSGS  (CO_RX_IDX_LSS_MST  + CO_RX_CNT_LSS_MST)
 
@@ -280,12 +304,21 @@
 #define CO_TX_IDX_TPDO      (CO_TX_IDX_SRDO     + CO_TX_CNT_SRDO * 2)
 #define CO_TX_IDX_SDO_SRV   (CO_TX_IDX_TPDO     + CO_TX_CNT_TPDO)
 #define CO_TX_IDX_SDO_CLI   (CO_TX_IDX_SDO_SRV  + CO_TX_CNT_SDO_SRV)
-#define CO_TX_IDX_HB_PROD   (CO_TX_IDX_SDO_CLI  + CO_TX_CNT_SDO_CLI)
+#define CO_TX_IDX_NODE_SCAN (CO_TX_IDX_SDO_CLI  + CO_TX_CNT_SDO_CLI)
+#define CO_TX_IDX_HB_PROD   (CO_TX_IDX_NODE_SCAN + CO_TX_CNT_NODE_SCAN)
 #define CO_TX_IDX_LSS_SLV   (CO_TX_IDX_HB_PROD  + CO_TX_CNT_HB_PROD)
 #define CO_TX_IDX_LSS_MST   (CO_TX_IDX_LSS_SLV  + CO_TX_CNT_LSS_SLV)
 #define CO_CNT_ALL_TX_MSGS  (CO_TX_IDX_LSS_MST  + CO_TX_CNT_LSS_MST)
 #endif /* #ifdef #else CO_MULTIPLE_OD */
 
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_INDEXED
+/* Number of SDO servers, which share the same pending flag. Up to 128 SDO
+ * servers fit into 16 bits of CO_t.SDOserverActive. */
+#define CO_SDO_SRV_PENDING_GROUP 8
+#define CO_SDO_SRV_PENDING_CNT(cnt) \
+    (((cnt) + CO_SDO_SRV_PENDING_GROUP - 1) / CO_SDO_SRV_PENDING_GROUP)
+#endif
+
 
 /* Objects from heap **********************************************************/
 #ifndef CO_USE_GLOBALS
@@ -345,7 +378,12 @@ CO_t *CO_new(CO_config_t *config, uint32_t *heapMemoryUsed) {
             || config->CNT_TIME > 1 || config->CNT_LEDS > 1
             || config->CNT_GFC > 1 || config->CNT_SRDO > 64
             || config->CNT_LSS_SLV > 1 || config->CNT_LSS_MST > 1
+            || config->CNT_NODE_SCAN > 1
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SESSIONS
+            || config->CNT_GTWA > 128
+#else
             || config->CNT_GTWA > 1
+#endif
         ) {
             break;
         }
@@ -379,7 +417,12 @@ CO_t *CO_new(CO_config_t *config, uint32_t *heapMemoryUsed) {
             uint8_t countOfMonitoredNodes = CO_GET_CNT(ARR_1016);
             CO_alloc_break_on_fail(co->HBcons, CO_GET_CNT(HB_CONS), sizeof(*co->HBcons));
             CO_alloc_break_on_fail(co->HBconsMonitoredNodes, countOfMonitoredNodes, sizeof(*co->HBconsMonitoredNodes));
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_NODE_INDEXED
+            /* all monitored nodes share one receive buffer */
+            ON_MULTI_OD(RX_CNT_HB_CONS = 1);
+#else
             ON_MULTI_OD(RX_CNT_HB_CONS = countOfMonitoredNodes);
+#endif
         }
 #endif
 
@@ -407,6 +450,11 @@ CO_t *CO_new(CO_config_t *config, uint32_t *heapMemoryUsed) {
         ON_MULTI_OD(uint8_t TX_CNT_SDO_SRV = 0);
         if (CO_GET_CNT(SDO_SRV) > 0) {
             CO_alloc_break_on_fail(co->SDOserver, CO_GET_CNT(SDO_SRV), sizeof(*co->SDOserver));
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_INDEXED
+            CO_alloc_break_on_fail(co->SDOserverPending,
+                                   CO_SDO_SRV_PENDING_CNT(CO_GET_CNT(SDO_SRV)),
+                                   sizeof(*co->SDOserverPending));
+#endif
             ON_MULTI_OD(RX_CNT_SDO_SRV = config->CNT_SDO_SRV);
             ON_MULTI_OD(TX_CNT_SDO_SRV = config->CNT_SDO_SRV);
         }
@@ -508,9 +556,22 @@ CO_t *CO_new(CO_config_t *config, uint32_t *heapMemoryUsed) {
         }
 #endif
 
+#if (CO_CONFIG_NODE_SCAN) & CO_CONFIG_NODE_SCAN_ENABLE
+        ON_MULTI_OD(uint8_t RX_CNT_NODE_SCAN = 0);
+        ON_MULTI_OD(uint8_t TX_CNT_NODE_SCAN = 0);
+        if (CO_GET_CNT(NODE_SCAN) == 1) {
+            CO_alloc_break_on_fail(co->nodeScan, CO_GET_CNT(NODE_SCAN), sizeof(*co->nodeScan));
+            ON_MULTI_OD(RX_CNT_NODE_SCAN = 1);
+            ON_MULTI_OD(TX_CNT_NODE_SCAN = 1);
+        }
+#endif
+
 #if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII
-        if (CO_GET_CNT(GTWA) == 1) {
+        if (CO_GET_CNT(GTWA) > 0) {
             CO_alloc_break_on_fail(co->gtwa, CO_GET_CNT(GTWA), sizeof(*co->gtwa));
+ #if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SESSIONS
+            CO_alloc_break_on_fail(co->gtwaSessions, 1, sizeof(*co->gtwaSessions));
+ #endif
         }
 #endif
 
@@ -543,12 +604,18 @@ CO_t *CO_new(CO_config_t *config, uint32_t *heapMemoryUsed) {
         co->RX_IDX_RPDO = idxRx; idxRx += RX_CNT_RPDO;
 #endif
         co->RX_IDX_SDO_SRV = idxRx; idxRx += RX_CNT_SDO_SRV;
+#if (CO_CONFIG_NODE_SCAN) & CO_CONFIG_NODE_SCAN_ENABLE
+        co->RX_IDX_SCAN_SDO = idxRx; idxRx += RX_CNT_NODE_SCAN;
+#endif
 #if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_ENABLE
         co->RX_IDX_SDO_CLI = idxRx; idxRx += RX_CNT_SDO_CLI;
 #endif
 #if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_ENABLE
         co->RX_IDX_HB_CONS = idxRx; idxRx += RX_CNT_HB_CONS;
 #endif
+#if (CO_CONFIG_NODE_SCAN) & CO_CONFIG_NODE_SCAN_ENABLE
+        co->RX_IDX_SCAN_HB = idxRx; idxRx += RX_CNT_NODE_SCAN;
+#endif
 #if (CO_CONFIG_LSS) & CO_CONFIG_LSS_SLAVE
         co->RX_IDX_LSS_SLV = idxRx; idxRx += RX_CNT_LSS_SLV;
 #endif
@@ -578,6 +645,9 @@ CO_t *CO_new(CO_config_t *config, uint32_t *heapMemoryUsed) {
         co->TX_IDX_SDO_SRV = idxTx; idxTx += TX_CNT_SDO_SRV;
 #if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_ENABLE
         co->TX_IDX_SDO_CLI = idxTx; idxTx += TX_CNT_SDO_CLI;
+#endif
+#if (CO_CONFIG_NODE_SCAN) & CO_CONFIG_NODE_SCAN_ENABLE
+        co->TX_IDX_NODE_SCAN = idxTx; idxTx += TX_CNT_NODE_SCAN;
 #endif
         co->TX_IDX_HB_PROD = idxTx; idxTx += TX_CNT_HB_PROD;
 #if (CO_CONFIG_LSS) & CO_CONFIG_LSS_SLAVE
@@ -629,9 +699,16 @@ void CO_delete(CO_t *co) {
 #endif
 
 #if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII
+ #if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SESSIONS
+    CO_free(co->gtwaSessions);
+ #endif
     CO_free(co->gtwa);
 #endif
 
+#if (CO_CONFIG_NODE_SCAN) & CO_CONFIG_NODE_SCAN_ENABLE
+    CO_free(co->nodeScan);
+#endif
+
 #if (CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER
     CO_free(co->LSSmaster);
 #endif
@@ -675,6 +752,9 @@ void CO_delete(CO_t *co) {
 
     /* SDOserver */
     CO_free(co->SDOserver);
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_INDEXED
+    CO_free(co->SDOserverPending);
+#endif
 
     /* Emergency */
     CO_free(co->em);
@@ -715,6 +795,10 @@ void CO_delete(CO_t *co) {
     static CO_EM_fifo_t COO_EM_FIFO[CO_GET_CNT(ARR_1003) + 1];
 #endif
     static CO_SDOserver_t COO_SDOserver[OD_CNT_SDO_SRV];
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_INDEXED
+    static volatile void *COO_SDOserverPending[
+        CO_SDO_SRV_PENDING_CNT(OD_CNT_SDO_SRV)];
+#endif
 #if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_ENABLE
     static CO_SDOclient_t COO_SDOclient[OD_CNT_SDO_CLI];
 #endif
@@ -746,8 +830,14 @@ void CO_delete(CO_t *co) {
 #if (CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER
     static CO_LSSmaster_t COO_LSSmaster;
 #endif
+#if (CO_CONFIG_NODE_SCAN) & CO_CONFIG_NODE_SCAN_ENABLE
+    static CO_nodeScan_t COO_nodeScan;
+#endif
 #if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII
-    static CO_GTWA_t COO_gtwa;
+    static CO_GTWA_t COO_gtwa[OD_CNT_GTWA];
+ #if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SESSIONS
+    static CO_GTWA_sessions_t COO_gtwaSessions;
+ #endif
 #endif
 #if (CO_CONFIG_TRACE) & CO_CONFIG_TRACE_ENABLE
   #ifndef CO_TRACE_BUFFER_SIZE_FIXED
@@ -777,6 +867,9 @@ CO_t *CO_new(CO_config_t *config, uint32_t *heapMemoryUsed) {
     co->em_fifo = &COO_EM_FIFO[0];
 #endif
     co->SDOserver = &COO_SDOserver[0];
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_INDEXED
+    co->SDOserverPending = &COO_SDOserverPending[0];
+#endif
 #if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_ENABLE
     co->SDOclient = &COO_SDOclient[0];
 #endif
@@ -808,8 +901,14 @@ CO_t *CO_new(CO_config_t *config, uint32_t *heapMemoryUsed) {
 #if (CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER
     co->LSSmaster = &COO_LSSmaster;
 #endif
+#if (CO_CONFIG_NODE_SCAN) & CO_CONFIG_NODE_SCAN_ENABLE
+    co->nodeScan = &COO_nodeScan;
+#endif
 #if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII
-    co->gtwa = &COO_gtwa;
+    co->gtwa = &COO_gtwa[0];
+ #if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SESSIONS
+    co->gtwaSessions = &COO_gtwaSessions;
+ #endif
 #endif
 #if (CO_CONFIG_TRACE) & CO_CONFIG_TRACE_ENABLE
     co->trace = &COO_trace[0];
@@ -1031,7 +1130,17 @@ CO_ReturnError_t CO_CANopenInit(CO_t *co,
                                     CO_GET_CO(TX_IDX_SDO_SRV) + i,
                                     errInfo);
             if (err) return err;
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_INDEXED
+            CO_FLAG_CLEAR(co->SDOserverPending[i / CO_SDO_SRV_PENDING_GROUP]);
+            CO_SDOserver_initPending(&co->SDOserver[i],
+                &co->SDOserverPending[i / CO_SDO_SRV_PENDING_GROUP],
+                &co->SDOserverPendingAny);
+#endif
         }
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_INDEXED
+        CO_FLAG_CLEAR(co->SDOserverPendingAny);
+        co->SDOserverActive = 0;
+#endif
     }
 
 #if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_ENABLE
@@ -1152,11 +1261,36 @@ CO_ReturnError_t CO_CANopenInit(CO_t *co,
     }
 #endif
 
+#if (CO_CONFIG_NODE_SCAN) & CO_CONFIG_NODE_SCAN_ENABLE
+    if (CO_GET_CNT(NODE_SCAN) == 1) {
+        err = CO_nodeScan_init(co->nodeScan,
+ #if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_ENABLE
+                               CO_GET_CNT(HB_CONS) == 1 ? co->HBcons : NULL,
+ #endif
+ #if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_ENABLE
+                               co->SDOclient,
+                               CO_GET_CNT(SDO_CLI),
+ #endif
+                               co->CANmodule,
+                               CO_GET_CO(RX_IDX_SCAN_SDO),
+                               CO_GET_CO(RX_IDX_SCAN_HB),
+                               co->CANmodule,
+                               CO_GET_CO(TX_IDX_NODE_SCAN));
+        if (err) return err;
+    }
+#endif
+
 #if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII
-    if (CO_GET_CNT(GTWA) == 1) {
-        err = CO_GTWA_init(co->gtwa,
  #if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO
-                           &co->SDOclient[0],
+    /* each gateway session needs own SDO client */
+    if (CO_GET_CNT(GTWA) > CO_GET_CNT(SDO_CLI)) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+ #endif
+    for (uint16_t i = 0; i < CO_GET_CNT(GTWA); i++) {
+        err = CO_GTWA_init(&co->gtwa[i],
+ #if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO
+                           &co->SDOclient[i],
                            SDOclientTimeoutTime_ms,
                            SDOclientBlockTransfer,
  #endif
@@ -1171,7 +1305,54 @@ CO_ReturnError_t CO_CANopenInit(CO_t *co,
  #endif
                            0);
         if (err) return err;
+ #if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SLOTS
+        /* other SDO clients are shared evenly by slots of the sessions */
+        {
+            uint16_t slots = (CO_GET_CNT(SDO_CLI) - CO_GET_CNT(GTWA))
+                             / CO_GET_CNT(GTWA);
+            if (slots > 0) {
+                err = CO_GTWA_initSlots(&co->gtwa[i],
+                                        &co->SDOclient[CO_GET_CNT(GTWA)
+                                                       + i * slots],
+                                        (uint8_t)(slots > 0xFF ? 0xFF : slots));
+                if (err) return err;
+            }
+        }
+ #endif
+ #if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SCAN
+        if (CO_GET_CNT(NODE_SCAN) == 1) {
+            err = CO_GTWA_initScan(&co->gtwa[i], co->nodeScan);
+            if (err) return err;
+        }
+ #endif
+ #if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_HB_STAT
+        if (CO_GET_CNT(HB_CONS) == 1) {
+            err = CO_GTWA_initHBstat(&co->gtwa[i], co->HBcons);
+            if (err) return err;
+        }
+ #endif
+ #if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SUBSCRIBE
+        err = CO_GTWA_initSubscribe(&co->gtwa[i],
+  #ifdef CO_GTWA_SUBSCRIBE_RPDO
+                                    co->RPDO,
+                                    CO_GET_CNT(RPDO),
+  #endif
+  #ifdef CO_GTWA_SUBSCRIBE_TPDO
+                                    co->TPDO,
+                                    CO_GET_CNT(TPDO),
+  #endif
+                                    co->CANmodule,
+                                    od);
+        if (err) return err;
+ #endif
+    }
+ #if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SESSIONS
+    if (CO_GET_CNT(GTWA) > 0) {
+        err = CO_GTWA_initSessions(co->gtwa, (uint8_t)CO_GET_CNT(GTWA),
+                                   co->gtwaSessions);
+        if (err) return err;
     }
+ #endif
 #endif
 
 #if (CO_CONFIG_TRACE) & CO_CONFIG_TRACE_ENABLE
@@ -1369,12 +1550,55 @@ CO_NMT_reset_cmd_t CO_process(CO_t *co,
                              || NMTstate == CO_NMT_OPERATIONAL);
 
     /* SDOserver */
+#if (CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_INDEXED
+    /* Groups of SDO servers with received message are added to the mask of
+     * active groups. Flags are cleared before processing, so message received
+     * meanwhile sets them again. */
+    if (CO_FLAG_READ(co->SDOserverPendingAny)) {
+        CO_FLAG_CLEAR(co->SDOserverPendingAny);
+        for (uint8_t g = 0; g < CO_SDO_SRV_PENDING_CNT(CO_GET_CNT(SDO_SRV)); g++) {
+            if (CO_FLAG_READ(co->SDOserverPending[g])) {
+                CO_FLAG_CLEAR(co->SDOserverPending[g]);
+                co->SDOserverActive |= (uint32_t)1 << g;
+            }
+        }
+    }
+
+    /* Process only active groups, group stays active while any of its SDO
+     * servers has transfer in progress. */
+    uint32_t activeMask = co->SDOserverActive;
+    for (uint8_t g = 0; activeMask != 0; g++, activeMask >>= 1) {
+        if ((activeMask & 1U) == 0) {
+            continue;
+        }
+
+        bool_t active = false;
+        uint8_t iEnd = (g + 1) * CO_SDO_SRV_PENDING_GROUP;
+        if (iEnd > CO_GET_CNT(SDO_SRV)) {
+            iEnd = CO_GET_CNT(SDO_SRV);
+        }
+        for (uint8_t i = g * CO_SDO_SRV_PENDING_GROUP; i < iEnd; i++) {
+            CO_SDOserver_t *SDO = &co->SDOserver[i];
+            CO_SDOserver_process(SDO,
+                                 NMTisPreOrOperational,
+                                 timeDifference_us,
+                                 timerNext_us);
+            if (SDO->state != CO_SDO_ST_IDLE || CO_FLAG_READ(SDO->CANrxNew)) {
+                active = true;
+            }
+        }
+        if (!active) {
+            co->SDOserverActive &= ~((uint32_t)1 << g);
+        }
+    }
+#else
     for (uint8_t i = 0; i < CO_GET_CNT(SDO_SRV); i++) {
         CO_SDOserver_process(&co->SDOserver[i],
                              NMTisPreOrOperational,
                              timeDifference_us,
                              timerNext_us);
     }
+#endif
 
 #if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_ENABLE
     if (CO_GET_CNT(HB_CONS) == 1) {
@@ -1392,8 +1616,8 @@ CO_NMT_reset_cmd_t CO_process(CO_t *co,
 #endif
 
 #if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII
-    if (CO_GET_CNT(GTWA) == 1) {
-        CO_GTWA_process(co->gtwa,
+    for (uint16_t i = 0; i < CO_GET_CNT(GTWA); i++) {
+        CO_GTWA_process(&co->gtwa[i],
                         enableGateway,
                         timeDifference_us,
                         timerNext_us);
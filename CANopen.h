@@ -43,6 +43,7 @@
 #include "304/CO_SRDO.h"
 #include "305/CO_LSSslave.h"
 #include "305/CO_LSSmaster.h"
+#include "301/CO_nodeScan.h"
 #include "309/CO_gateway_ascii.h"
 #include "extra/CO_trace.h"
 
@@ -262,7 +263,11 @@ typedef struct {
     uint8_t CNT_LSS_SLV;
     /** Number of LSSmaster objects, 0 or 1 (CANrx + CANtx). */
     uint8_t CNT_LSS_MST;
-    /** Number of gateway ascii objects, 0 or 1. */
+    /** Number of network scan objects, 0 or 1 (2*CANrx + CANtx). */
+    uint8_t CNT_NODE_SCAN;
+    /** Number of gateway ascii objects, 0 or 1. With
+     * CO_CONFIG_GTW_ASCII_SESSIONS up to 128 sessions, each needs own SDO
+     * client. Remaining SDO clients are shared evenly by slots of sessions. */
     uint8_t CNT_GTWA;
     /** Number of trace objects, 0 or more. */
     uint16_t CNT_TRACE;
@@ -317,6 +322,16 @@ typedef struct {
 #endif
     /** SDO server objects, initialised by @ref CO_SDOserver_init() */
     CO_SDOserver_t *SDOserver;
+#if ((CO_CONFIG_SDO_SRV) & CO_CONFIG_SDO_SRV_INDEXED) || defined CO_DOXYGEN
+    /** Pending flags for groups of SDO servers, see
+     * @ref CO_SDOserver_initPending() */
+    volatile void **SDOserverPending;
+    /** Set together with any of SDOserverPending flags */
+    volatile void *SDOserverPendingAny;
+    /** Bit mask of groups of SDO servers with transfer in progress, processed
+     * in CO_process() */
+    uint32_t SDOserverActive;
+#endif
  #if defined CO_MULTIPLE_OD || defined CO_DOXYGEN
     uint16_t RX_IDX_SDO_SRV; /**< Start index in CANrx. */
     uint16_t TX_IDX_SDO_SRV; /**< Start index in CANtx. */
@@ -398,9 +413,24 @@ typedef struct {
     uint16_t TX_IDX_LSS_MST; /**< Start index in CANtx. */
  #endif
 #endif
+#if ((CO_CONFIG_NODE_SCAN) & CO_CONFIG_NODE_SCAN_ENABLE) || defined CO_DOXYGEN
+    /** Network scan object, initialised by @ref CO_nodeScan_init(). */
+    CO_nodeScan_t *nodeScan;
+ #if defined CO_MULTIPLE_OD || defined CO_DOXYGEN
+    uint16_t RX_IDX_SCAN_SDO; /**< Index in CANrx for SDO responses. */
+    uint16_t RX_IDX_SCAN_HB; /**< Index in CANrx for Heartbeats. */
+    uint16_t TX_IDX_NODE_SCAN; /**< Start index in CANtx. */
+ #endif
+#endif
 #if ((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII) || defined CO_DOXYGEN
-    /** Gateway-ascii object, initialised by @ref CO_GTWA_init(). */
+    /** Gateway-ascii object, initialised by @ref CO_GTWA_init(). With
+     * CO_CONFIG_GTW_ASCII_SESSIONS array of CNT_GTWA sessions. */
     CO_GTWA_t *gtwa;
+ #if ((CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SESSIONS) || defined CO_DOXYGEN
+    /** Resources shared by gateway sessions, initialised by
+     * @ref CO_GTWA_initSessions(). */
+    CO_GTWA_sessions_t *gtwaSessions;
+ #endif
  #if defined CO_MULTIPLE_OD || defined CO_DOXYGEN
  #endif
 #endif
@@ -0,0 +1,236 @@
+/*
+ * Definitions for CANopenNode on the virtual (in-process) CAN bus, used by
+ * the benchmark.
+ *
+ * @file        CO_driver_target.h
+ * @author      J-Weisberg
+ * @copyright   2026 J-Weisberg
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef CO_DRIVER_TARGET_H
+#define CO_DRIVER_TARGET_H
+
+/* This file contains device and application specific definitions.
+ * It is included from CO_driver.h, which contains documentation
+ * for common definitions below. */
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <pthread.h>
+
+#ifdef CO_DRIVER_CUSTOM
+#include "CO_driver_custom.h"
+#endif
+
+/* Stack configuration for the benchmark. Objects, which are not necessary,
+ * are disabled. SDO buffer sizes, indexed dispatch of SDO servers, adaptive SDO
+ * block transfer, node-ID indexed Heartbeat consumer, lock-free emergency,
+ * exact printing of real numbers, strict range of parsed integers and adaptive
+ * LSS fastscan may be overridden from the command line, see "make benchmark".
+ */
+#ifndef BENCHMARK_SDO_SRV_INDEXED
+#define BENCHMARK_SDO_SRV_INDEXED CO_CONFIG_SDO_SRV_INDEXED
+#endif
+#ifndef BENCHMARK_SDO_CLI_ADAPTIVE
+#define BENCHMARK_SDO_CLI_ADAPTIVE CO_CONFIG_SDO_CLI_BLOCK_ADAPTIVE
+#endif
+#ifndef BENCHMARK_HB_CONS_NODE_INDEXED
+#define BENCHMARK_HB_CONS_NODE_INDEXED CO_CONFIG_HB_CONS_NODE_INDEXED
+#endif
+#ifndef BENCHMARK_EM_LOCK_FREE
+#define BENCHMARK_EM_LOCK_FREE CO_CONFIG_EM_LOCK_FREE
+#endif
+#ifndef BENCHMARK_FIFO_STRICT_RANGE
+#define BENCHMARK_FIFO_STRICT_RANGE CO_CONFIG_FIFO_ASCII_STRICT_RANGE
+#endif
+#ifndef BENCHMARK_LSS_FS_ADAPTIVE
+#define BENCHMARK_LSS_FS_ADAPTIVE CO_CONFIG_LSS_MASTER_FASTSCAN_ADAPTIVE
+#endif
+#define CO_CONFIG_EM (CO_CONFIG_EM_PRODUCER | \
+                      CO_CONFIG_EM_PROD_INHIBIT | \
+                      CO_CONFIG_EM_PROD_RATE_LIMIT | \
+                      CO_CONFIG_EM_HISTORY | \
+                      CO_CONFIG_EM_CONSUMER | \
+                      CO_CONFIG_EM_HISTORY_STORE | \
+                      BENCHMARK_EM_LOCK_FREE)
+#define CO_CONFIG_EM_AGG CO_CONFIG_EM_AGG_ENABLE
+#define CO_CONFIG_SDO_SRV (CO_CONFIG_SDO_SRV_SEGMENTED | \
+                           CO_CONFIG_SDO_SRV_BLOCK | \
+                           BENCHMARK_SDO_SRV_INDEXED)
+#ifndef CO_CONFIG_SDO_SRV_BUFFER_SIZE
+#define CO_CONFIG_SDO_SRV_BUFFER_SIZE 900
+#endif
+#ifndef CO_CONFIG_SDO_CLI
+#define CO_CONFIG_SDO_CLI (CO_CONFIG_SDO_CLI_ENABLE | \
+                           CO_CONFIG_SDO_CLI_SEGMENTED | \
+                           CO_CONFIG_SDO_CLI_BLOCK | \
+                           CO_CONFIG_SDO_CLI_LOCAL | \
+                           BENCHMARK_SDO_CLI_ADAPTIVE)
+#endif
+#ifndef CO_CONFIG_SDO_CLI_BUFFER_SIZE
+#define CO_CONFIG_SDO_CLI_BUFFER_SIZE 1000
+#endif
+#define CO_CONFIG_FIFO (CO_CONFIG_FIFO_ENABLE | \
+                        CO_CONFIG_FIFO_ALT_READ | \
+                        CO_CONFIG_FIFO_CRC16_CCITT | \
+                        CO_CONFIG_FIFO_ASCII_COMMANDS | \
+                        CO_CONFIG_FIFO_ASCII_DATATYPES | \
+                        BENCHMARK_FIFO_STRICT_RANGE)
+#define CO_CONFIG_CRC16 CO_CONFIG_CRC16_ENABLE
+#define CO_CONFIG_NMT CO_CONFIG_NMT_MASTER
+#define CO_CONFIG_HB_CONS (CO_CONFIG_HB_CONS_ENABLE | \
+                           CO_CONFIG_HB_CONS_QUERY_FUNCT | \
+                           CO_CONFIG_HB_CONS_STATE_TRACKER | \
+                           CO_CONFIG_HB_CONS_STATISTICS | \
+                           BENCHMARK_HB_CONS_NODE_INDEXED)
+#define CO_CONFIG_TIME 0
+#define CO_CONFIG_OD CO_CONFIG_OD_DOMAIN_FILE
+#define CO_CONFIG_SYNC 0
+#define CO_CONFIG_PDO (CO_CONFIG_RPDO_ENABLE | \
+                       CO_CONFIG_TPDO_ENABLE | \
+                       CO_CONFIG_PDO_CALLBACK_EVENT)
+#define CO_CONFIG_LEDS 0
+#define CO_CONFIG_LSS (CO_CONFIG_LSS_SLAVE | \
+                       CO_CONFIG_LSS_MASTER | \
+                       BENCHMARK_LSS_FS_ADAPTIVE)
+#define CO_CONFIG_LSS_COMM CO_CONFIG_LSS_COMM_ENABLE
+#define CO_CONFIG_NODE_SCAN CO_CONFIG_NODE_SCAN_ENABLE
+#define CO_CONFIG_NMT_SEQ CO_CONFIG_NMT_SEQ_ENABLE
+#define CO_CONFIG_GTW (CO_CONFIG_GTW_ASCII | \
+                       CO_CONFIG_GTW_ASCII_SDO | \
+                       CO_CONFIG_GTW_ASCII_SDO_BATCH | \
+                       CO_CONFIG_GTW_ASCII_SUBSCRIBE | \
+                       CO_CONFIG_GTW_ASCII_BINARY | \
+                       CO_CONFIG_GTW_ASCII_READV | \
+                       CO_CONFIG_GTW_ASCII_SCAN | \
+                       CO_CONFIG_GTW_ASCII_HB_STAT | \
+                       CO_CONFIG_GTW_ASCII_LSS | \
+                       CO_CONFIG_GTW_ASCII_SESSIONS | \
+                       CO_CONFIG_GTW_ASCII_SLOTS)
+#define CO_CONFIG_GTW_BLOCK_DL_LOOP 1
+#define CO_CONFIG_DEBUG CO_CONFIG_DEBUG_GTW_TABLES
+#define CO_CONFIG_GTWA_COMM_BUF_SIZE 2000
+#define CO_CONFIG_STORAGE CO_CONFIG_STORAGE_ENABLE
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Stack configuration override default values.
+ * For more information see file CO_config.h. */
+
+
+/* Basic definitions. If big endian, CO_SWAP_xx macros must swap bytes. */
+#define CO_LITTLE_ENDIAN
+#define CO_SWAP_16(x) x
+#define CO_SWAP_32(x) x
+#define CO_SWAP_64(x) x
+/* NULL is defined in stddef.h */
+/* true and false are defined in stdbool.h */
+/* int8_t to uint64_t are defined in stdint.h */
+typedef uint_fast8_t            bool_t;
+typedef float                   float32_t;
+typedef double                  float64_t;
+
+
+/* CAN message on the virtual bus */
+typedef struct {
+    uint32_t ident;
+    uint8_t DLC;
+    uint8_t data[8];
+} CO_CANrxMsg_t;
+
+/* Access to received CAN message */
+#define CO_CANrxMsg_readIdent(msg) ((uint16_t)(((CO_CANrxMsg_t *)(msg))->ident))
+#define CO_CANrxMsg_readDLC(msg)   ((uint8_t)(((CO_CANrxMsg_t *)(msg))->DLC))
+#define CO_CANrxMsg_readData(msg)  ((uint8_t *)(((CO_CANrxMsg_t *)(msg))->data))
+
+/* Received message object */
+typedef struct {
+    uint16_t ident;
+    uint16_t mask;
+    void *object;
+    void (*CANrx_callback)(void *object, void *message);
+} CO_CANrx_t;
+
+/* Transmit message object */
+typedef struct {
+    uint32_t ident;
+    uint8_t DLC;
+    uint8_t data[8];
+    volatile bool_t bufferFull;
+    volatile bool_t syncFlag;
+} CO_CANtx_t;
+
+/* CAN module object */
+typedef struct {
+    void *CANptr;
+    CO_CANrx_t *rxArray;
+    uint16_t rxSize;
+    CO_CANtx_t *txArray;
+    uint16_t txSize;
+    uint16_t CANerrorStatus;
+    volatile bool_t CANnormal;
+    volatile bool_t useCANrxFilters;
+    volatile bool_t bufferInhibitFlag;
+    volatile bool_t firstCANtxMessage;
+    volatile uint16_t CANtxCount;
+    uint32_t errOld;
+} CO_CANmodule_t;
+
+
+/* Data storage object for one entry */
+typedef struct {
+    void *addr;
+    size_t len;
+    uint8_t subIndexOD;
+    uint8_t attr;
+    /* Additional variables (target specific) */
+    void *addrNV;
+} CO_storage_entry_t;
+
+
+/* (un)lock critical section in CO_CANsend() */
+#define CO_LOCK_CAN_SEND(CAN_MODULE)
+#define CO_UNLOCK_CAN_SEND(CAN_MODULE)
+
+/* (un)lock critical section in CO_errorReport() or CO_errorReset(). Benchmark
+ * reports errors from several threads. */
+extern pthread_mutex_t bench_emcyMutex;
+#define CO_LOCK_EMCY(CAN_MODULE) pthread_mutex_lock(&bench_emcyMutex)
+#define CO_UNLOCK_EMCY(CAN_MODULE) pthread_mutex_unlock(&bench_emcyMutex)
+
+/* (un)lock critical section when accessing Object Dictionary */
+#define CO_LOCK_OD(CAN_MODULE)
+#define CO_UNLOCK_OD(CAN_MODULE)
+
+/* Synchronization between CAN receive and message processing threads. */
+#define CO_MemoryBarrier()
+#define CO_FLAG_READ(rxNew) ((rxNew) != NULL)
+#define CO_FLAG_SET(rxNew) {CO_MemoryBarrier(); rxNew = (void*)1L;}
+#define CO_FLAG_CLEAR(rxNew) {CO_MemoryBarrier(); rxNew = NULL;}
+
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* CO_DRIVER_TARGET_H */
@@ -0,0 +1,313 @@
+/*
+ * CAN module object for the virtual (in-process) CAN bus.
+ *
+ * All CAN modules, initialized with CO_CANmodule_init(), are connected to the
+ * same virtual bus. Transmitted messages are stored into the queue and are
+ * delivered to the receive buffers of all other modules by CO_vbus_deliver().
+ * Used by the benchmark, where several CANopen devices run in one process.
+ *
+ * @file        CO_driver_vbus.c
+ * @ingroup     CO_driver
+ * @author      J-Weisberg
+ * @copyright   2026 J-Weisberg
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string.h>
+
+#include "301/CO_driver.h"
+#include "CO_driver_vbus.h"
+
+
+/* Maximum number of CAN modules connected to the virtual bus, enough for a
+ * module per simulated LSS slave */
+#define CO_VBUS_MODULES 128
+/* Size of the queue of CAN messages, which are not delivered yet */
+#define CO_VBUS_QUEUE 4096
+
+static struct {
+    CO_CANmodule_t *modules[CO_VBUS_MODULES];
+    uint8_t modulesCount;
+    struct {
+        CO_CANmodule_t *src;
+        CO_CANrxMsg_t msg;
+    } queue[CO_VBUS_QUEUE];
+    uint16_t queueRd;
+    uint16_t queueWr;
+    uint16_t dropIdent;
+    uint32_t dropBurst;
+    uint32_t dropCount;
+    CO_vbus_stat_t stat;
+} vbus;
+
+
+/******************************************************************************/
+void CO_vbus_reset(void) {
+    memset(&vbus, 0, sizeof(vbus));
+}
+
+
+/******************************************************************************/
+const CO_vbus_stat_t *CO_vbus_getStat(void) {
+    return &vbus.stat;
+}
+
+
+/******************************************************************************/
+void CO_vbus_setDrop(uint16_t ident, uint32_t burst) {
+    vbus.dropIdent = ident;
+    vbus.dropBurst = burst;
+    vbus.dropCount = 0;
+}
+
+
+/******************************************************************************/
+uint32_t CO_vbus_deliver(void) {
+    uint32_t count = 0;
+
+    while (vbus.queueRd != vbus.queueWr) {
+        CO_CANrxMsg_t *msg = &vbus.queue[vbus.queueRd].msg;
+        CO_CANmodule_t *src = vbus.queue[vbus.queueRd].src;
+        bool_t lost = false;
+        uint8_t i;
+
+        /* Lost message is not received by any module */
+        if (msg->ident != vbus.dropIdent) {
+            vbus.dropCount = 0;
+        }
+        else if (vbus.dropBurst > 0 && ++vbus.dropCount > vbus.dropBurst) {
+            vbus.stat.dropped++;
+            lost = true;
+        }
+
+        for (i = 0; !lost && i < vbus.modulesCount; i++) {
+            CO_CANmodule_t *CANmodule = vbus.modules[i];
+            CO_CANrx_t *buffer = &CANmodule->rxArray[0];
+            uint16_t index;
+
+            if (CANmodule == src || !CANmodule->CANnormal) {
+                continue;
+            }
+            /* Search rxArray for the same CAN-ID, as without hardware
+             * filters. */
+            for (index = CANmodule->rxSize; index > 0U; index--) {
+                if (((msg->ident ^ buffer->ident) & buffer->mask) == 0U
+                    && buffer->CANrx_callback != NULL
+                ) {
+                    buffer->CANrx_callback(buffer->object, (void *)msg);
+                    break;
+                }
+                buffer++;
+            }
+        }
+
+        vbus.queueRd = (vbus.queueRd + 1) % CO_VBUS_QUEUE;
+        count++;
+    }
+
+    return count;
+}
+
+
+/******************************************************************************/
+void CO_CANsetConfigurationMode(void *CANptr) {
+    (void)CANptr;
+}
+
+
+/******************************************************************************/
+void CO_CANsetNormalMode(CO_CANmodule_t *CANmodule) {
+    CANmodule->CANnormal = true;
+}
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_CANmodule_init(CO_CANmodule_t *CANmodule,
+                                   void *CANptr,
+                                   CO_CANrx_t rxArray[],
+                                   uint16_t rxSize,
+                                   CO_CANtx_t txArray[],
+                                   uint16_t txSize,
+                                   uint16_t CANbitRate)
+{
+    uint16_t i;
+    bool_t connected = false;
+
+    (void)CANbitRate;
+
+    /* verify arguments */
+    if (CANmodule == NULL || rxArray == NULL || txArray == NULL) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    /* Configure object variables */
+    CANmodule->CANptr = CANptr;
+    CANmodule->rxArray = rxArray;
+    CANmodule->rxSize = rxSize;
+    CANmodule->txArray = txArray;
+    CANmodule->txSize = txSize;
+    CANmodule->CANerrorStatus = 0;
+    CANmodule->CANnormal = false;
+    CANmodule->useCANrxFilters = false;
+    CANmodule->bufferInhibitFlag = false;
+    CANmodule->firstCANtxMessage = true;
+    CANmodule->CANtxCount = 0U;
+    CANmodule->errOld = 0U;
+
+    for (i = 0U; i < rxSize; i++) {
+        rxArray[i].ident = 0U;
+        rxArray[i].mask = 0xFFFFU;
+        rxArray[i].object = NULL;
+        rxArray[i].CANrx_callback = NULL;
+    }
+    for (i = 0U; i < txSize; i++) {
+        txArray[i].bufferFull = false;
+    }
+
+    /* connect to the virtual bus */
+    for (i = 0U; i < vbus.modulesCount; i++) {
+        if (vbus.modules[i] == CANmodule) {
+            connected = true;
+        }
+    }
+    if (!connected) {
+        if (vbus.modulesCount >= CO_VBUS_MODULES) {
+            return CO_ERROR_OUT_OF_MEMORY;
+        }
+        vbus.modules[vbus.modulesCount++] = CANmodule;
+    }
+
+    return CO_ERROR_NO;
+}
+
+
+/******************************************************************************/
+void CO_CANmodule_disable(CO_CANmodule_t *CANmodule) {
+    uint8_t i;
+
+    if (CANmodule == NULL) {
+        return;
+    }
+
+    /* disconnect from the virtual bus */
+    for (i = 0U; i < vbus.modulesCount; i++) {
+        if (vbus.modules[i] == CANmodule) {
+            vbus.modules[i] = vbus.modules[--vbus.modulesCount];
+            break;
+        }
+    }
+}
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_CANrxBufferInit(CO_CANmodule_t *CANmodule,
+                                    uint16_t index,
+                                    uint16_t ident,
+                                    uint16_t mask,
+                                    bool_t rtr,
+                                    void *object,
+                                    void (*CANrx_callback)(void *object,
+                                                           void *message))
+{
+    CO_ReturnError_t ret = CO_ERROR_NO;
+
+    if (CANmodule != NULL && object != NULL && CANrx_callback != NULL
+        && index < CANmodule->rxSize
+    ) {
+        CO_CANrx_t *buffer = &CANmodule->rxArray[index];
+
+        buffer->object = object;
+        buffer->CANrx_callback = CANrx_callback;
+        buffer->ident = ident & 0x07FFU;
+        if (rtr) {
+            buffer->ident |= 0x0800U;
+        }
+        buffer->mask = (mask & 0x07FFU) | 0x0800U;
+    }
+    else {
+        ret = CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    return ret;
+}
+
+
+/******************************************************************************/
+CO_CANtx_t *CO_CANtxBufferInit(CO_CANmodule_t *CANmodule,
+                               uint16_t index,
+                               uint16_t ident,
+                               bool_t rtr,
+                               uint8_t noOfBytes,
+                               bool_t syncFlag)
+{
+    CO_CANtx_t *buffer = NULL;
+
+    if (CANmodule != NULL && index < CANmodule->txSize) {
+        buffer = &CANmodule->txArray[index];
+
+        /* CAN identifier, RTR bit and DLC, as read by CO_CANsend() */
+        buffer->ident = ((uint32_t)ident & 0x07FFU)
+                      | ((uint32_t)(rtr ? 0x0800U : 0U))
+                      | ((uint32_t)(((uint32_t)noOfBytes & 0xFU) << 12U));
+        buffer->bufferFull = false;
+        buffer->syncFlag = syncFlag;
+    }
+
+    return buffer;
+}
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_CANsend(CO_CANmodule_t *CANmodule, CO_CANtx_t *buffer) {
+    uint16_t queueWrNext = (vbus.queueWr + 1) % CO_VBUS_QUEUE;
+    CO_CANrxMsg_t *msg;
+
+    /* Queue full, message is lost, as on a real bus without free buffers */
+    if (queueWrNext == vbus.queueRd) {
+        CANmodule->CANerrorStatus |= CO_CAN_ERRTX_OVERFLOW;
+        vbus.stat.overflows++;
+        return CO_ERROR_TX_OVERFLOW;
+    }
+
+    CO_LOCK_CAN_SEND(CANmodule);
+    msg = &vbus.queue[vbus.queueWr].msg;
+    msg->ident = buffer->ident & 0x0FFFU;
+    msg->DLC = (uint8_t)((buffer->ident >> 12U) & 0xFU);
+    memcpy(msg->data, buffer->data, sizeof(msg->data));
+    vbus.queue[vbus.queueWr].src = CANmodule;
+    vbus.queueWr = queueWrNext;
+    CANmodule->firstCANtxMessage = false;
+    CO_UNLOCK_CAN_SEND(CANmodule);
+
+    vbus.stat.frames++;
+    vbus.stat.bits += 47U + 8U * msg->DLC;
+
+    return CO_ERROR_NO;
+}
+
+
+/******************************************************************************/
+void CO_CANclearPendingSyncPDOs(CO_CANmodule_t *CANmodule) {
+    (void)CANmodule;
+}
+
+
+/******************************************************************************/
+void CO_CANmodule_process(CO_CANmodule_t *CANmodule) {
+    (void)CANmodule;
+}
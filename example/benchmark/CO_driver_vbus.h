@@ -0,0 +1,94 @@
+/*
+ * Virtual (in-process) CAN bus for CANopenNode.
+ *
+ * @file        CO_driver_vbus.h
+ * @ingroup     CO_driver
+ * @author      J-Weisberg
+ * @copyright   2026 J-Weisberg
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CO_DRIVER_VBUS_H
+#define CO_DRIVER_VBUS_H
+
+#include "301/CO_driver.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Statistics of the virtual CAN bus.
+ */
+typedef struct {
+    /** Number of CAN messages transmitted */
+    uint32_t frames;
+    /** Number of bits on the bus (without stuff bits) */
+    uint64_t bits;
+    /** Number of messages lost because of full queue */
+    uint32_t overflows;
+    /** Number of messages transmitted, but not received, see CO_vbus_setDrop()
+     */
+    uint32_t dropped;
+} CO_vbus_stat_t;
+
+
+/**
+ * Disconnect all CAN modules, empty the queue and clear statistics.
+ */
+void CO_vbus_reset(void);
+
+
+/**
+ * Simulate lost CAN messages because of receiver overrun.
+ *
+ * Receivers accept at most burst consecutive messages with CAN identifier
+ * ident. Further consecutive messages with the same identifier are
+ * transmitted on the bus, but are not received by any CAN module. Any other
+ * message on the bus ends the burst. Setting is cleared by CO_vbus_reset().
+ *
+ * @param ident CAN identifier of the messages to drop.
+ * @param burst Number of consecutive messages received, 0 disables dropping.
+ */
+void CO_vbus_setDrop(uint16_t ident, uint32_t burst);
+
+
+/**
+ * Deliver all queued CAN messages to the connected CAN modules.
+ *
+ * Receive callbacks are called from this function, so it replaces the CAN
+ * receive interrupt. Messages transmitted from inside callbacks are also
+ * delivered.
+ *
+ * @return Number of delivered messages.
+ */
+uint32_t CO_vbus_deliver(void);
+
+
+/**
+ * Get statistics of the virtual CAN bus.
+ *
+ * @return Pointer to statistics, cleared by CO_vbus_reset().
+ */
+const CO_vbus_stat_t *CO_vbus_getStat(void);
+
+#ifdef __cplusplus
+}
+#endif /*__cplusplus*/
+
+#endif /* CO_DRIVER_VBUS_H */
@@ -0,0 +1,247 @@
+/*
+ * Benchmark of CANopenNode on the virtual CAN bus.
+ *
+ * CANopen devices run in one process and are connected with the virtual CAN
+ * bus from CO_driver_vbus.c. Each stack module is measured and verified by own
+ * file, this file contains common functions and main(). Program fails, if any
+ * verification fails.
+ *
+ * @file        benchmark.c
+ * @author      J-Weisberg
+ * @copyright   2026 J-Weisberg
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <time.h>
+#if defined __x86_64__ || defined __i386__
+#include <x86intrin.h>
+#endif
+
+#include "benchmark.h"
+
+
+uint32_t testU32;
+OD_obj_var_t testU32Var = {&testU32, ODA_SDO_RW | ODA_MB, 4};
+uint8_t domain[DOMAIN_SIZE_MAX];
+OD_obj_var_t domainVar = {domain, ODA_SDO_RW, DOMAIN_SIZE_MAX};
+
+uint8_t dataTx[DOMAIN_SIZE_MAX];
+uint8_t dataRx[DOMAIN_SIZE_MAX];
+
+
+/* Time measurement ***********************************************************/
+uint64_t time_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000U + (uint64_t)ts.tv_nsec;
+}
+
+uint64_t cycles(void) {
+#if defined __x86_64__ || defined __i386__
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+
+/* Create object dictionary with sdoSrvCount SDO servers **********************/
+void bench_OD_init(bench_OD_t *bod, uint8_t sdoSrvCount) {
+    uint16_t n = 0;
+    uint8_t i;
+
+    memset(bod, 0, sizeof(*bod));
+    bod->srvParMaxSub = 3;
+
+    for (uint16_t j = 0; j < OD->size; j++) {
+        OD_entry_t *entry = &bod->list[n++];
+
+        *entry = OD->list[j];
+        entry->extension = NULL;
+
+        if (entry->index != OD_H1200_SDO_SERVER_1_PARAM) {
+            continue;
+        }
+        /* additional SDO servers with CAN identifiers, which don't collide
+         * with other devices on the virtual bus */
+        for (i = 0; i < (sdoSrvCount - 1); i++) {
+            OD_obj_record_t *rec = bod->srvPar[i];
+            uint8_t k = i + 1;
+
+            bod->srvParCobId[i][0] = 0x640U + k;
+            bod->srvParCobId[i][1] = 0x4C0U + k;
+            bod->srvParNodeId[i] = NODE_ID_CLIENT;
+            rec[0] = (OD_obj_record_t){&bod->srvParMaxSub, 0, ODA_SDO_R, 1};
+            rec[1] = (OD_obj_record_t){&bod->srvParCobId[i][0], 1,
+                                       ODA_SDO_RW | ODA_MB, 4};
+            rec[2] = (OD_obj_record_t){&bod->srvParCobId[i][1], 2,
+                                       ODA_SDO_RW | ODA_MB, 4};
+            rec[3] = (OD_obj_record_t){&bod->srvParNodeId[i], 3,
+                                       ODA_SDO_RW, 1};
+            bod->list[n++] = (OD_entry_t){OD_H1200_SDO_SERVER_1_PARAM + k, 4,
+                                          ODT_REC, rec, NULL};
+        }
+    }
+    bod->list[n++] = (OD_entry_t){0x2000, 1, ODT_VAR, &domainVar, NULL};
+    bod->list[n++] = (OD_entry_t){0x2001, 1, ODT_VAR, &testU32Var, NULL};
+    bod->od.size = n;
+    bod->od.list = bod->list;
+
+    /* configuration for CO_new(), only necessary objects */
+    CO_config_t *config = &bod->config;
+    OD_t *od = &bod->od;
+    config->CNT_NMT = 1;
+    config->ENTRY_H1017 = OD_find(od, 0x1017);
+    config->CNT_EM = 1;
+    config->ENTRY_H1001 = OD_find(od, 0x1001);
+    config->ENTRY_H1014 = OD_find(od, 0x1014);
+    config->ENTRY_H1015 = OD_find(od, 0x1015);
+    config->CNT_ARR_1003 = OD_CNT_ARR_1003;
+    config->ENTRY_H1003 = OD_find(od, 0x1003);
+    config->CNT_SDO_SRV = sdoSrvCount;
+    config->ENTRY_H1200 = OD_find(od, 0x1200);
+    config->CNT_SDO_CLI = 1;
+    config->ENTRY_H1280 = OD_find(od, 0x1280);
+}
+
+
+/* Add SDO clients to object dictionary ***************************************/
+void bench_OD_sdoClients(bench_OD_t *bod, uint8_t sdoCliCount) {
+    OD_entry_t *entry = OD_find(&bod->od, OD_H1280_SDO_CLIENT_1_PARAM);
+    uint16_t n = (uint16_t)(entry - bod->list) + 1;
+    uint8_t i;
+
+    if (sdoCliCount > SDO_CLI_MAX) {
+        sdoCliCount = SDO_CLI_MAX;
+    }
+    /* make space for additional entries after the first SDO client */
+    memmove(&bod->list[n + sdoCliCount - 1], &bod->list[n],
+            (bod->od.size - n) * sizeof(OD_entry_t));
+    for (i = 0; i < (sdoCliCount - 1); i++) {
+        OD_obj_record_t *rec = bod->cliPar[i];
+
+        bod->cliParCobId[i][0] = 0x80000000U;
+        bod->cliParCobId[i][1] = 0x80000000U;
+        bod->cliParNodeId[i] = 0;
+        rec[0] = (OD_obj_record_t){&bod->srvParMaxSub, 0, ODA_SDO_R, 1};
+        rec[1] = (OD_obj_record_t){&bod->cliParCobId[i][0], 1,
+                                   ODA_SDO_RW | ODA_MB, 4};
+        rec[2] = (OD_obj_record_t){&bod->cliParCobId[i][1], 2,
+                                   ODA_SDO_RW | ODA_MB, 4};
+        rec[3] = (OD_obj_record_t){&bod->cliParNodeId[i], 3, ODA_SDO_RW, 1};
+        bod->list[n + i] = (OD_entry_t){OD_H1280_SDO_CLIENT_1_PARAM + i + 1,
+                                        4, ODT_REC, rec, NULL};
+    }
+    bod->od.size += sdoCliCount - 1;
+
+    bod->config.CNT_SDO_CLI = sdoCliCount;
+    bod->config.ENTRY_H1280 = OD_find(&bod->od, OD_H1280_SDO_CLIENT_1_PARAM);
+}
+
+
+/* Create and initialize CANopen device ***************************************/
+CO_t *bench_device(bench_OD_t *bod, uint8_t nodeId) {
+    uint32_t heapMemoryUsed, errInfo = 0;
+    CO_ReturnError_t err;
+    CO_t *co = CO_new(&bod->config, &heapMemoryUsed);
+
+    if (co == NULL) {
+        log_printf("Error: Can't allocate memory\n");
+        exit(EXIT_FAILURE);
+    }
+    err = CO_CANinit(co, NULL, 1000);
+    if (err == CO_ERROR_NO) {
+        err = CO_CANopenInit(co, NULL, NULL, &bod->od, NULL,
+                             CO_NMT_STARTUP_TO_OPERATIONAL, 0,
+                             SDO_TIMEOUT_MS, SDO_TIMEOUT_MS, true,
+                             nodeId, &errInfo);
+    }
+    if (err == CO_ERROR_NO) {
+        err = CO_CANopenInitPDO(co, co->em, &bod->od, nodeId, &errInfo);
+    }
+    if (err != CO_ERROR_NO) {
+        log_printf("Error: CANopen initialization failed: %d, 0x%X\n",
+                   err, errInfo);
+        exit(EXIT_FAILURE);
+    }
+    CO_CANsetNormalMode(co->CANmodule);
+
+    return co;
+}
+
+
+/* main ***********************************************************************/
+int main(int argc, char *argv[]) {
+    uint32_t repeat = 1000;
+    int errors;
+
+    if (argc > 1) {
+        repeat = (uint32_t)strtoul(argv[1], NULL, 0);
+        if (repeat == 0) {
+            log_printf("Usage: %s [repeat]\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    errors = bench_sdo(repeat);
+    errors += bench_sdoLossy();
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_LOCAL
+    errors += bench_sdoLocal(repeat);
+#endif
+#if (CO_CONFIG_OD) & CO_CONFIG_OD_DOMAIN_FILE
+    errors += bench_domainFile(repeat);
+#endif
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_BINARY
+    errors += bench_gateway(repeat);
+#endif
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII
+    errors += bench_gtwcmd();
+#endif
+#if (CO_CONFIG_FIFO) & CO_CONFIG_FIFO_ASCII_DATATYPES
+    errors += bench_codecs(repeat);
+    errors += bench_numeric(repeat);
+#endif
+    errors += bench_servers();
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_ENABLE
+    errors += bench_hbcons();
+#endif
+#if (CO_CONFIG_NMT_SEQ) & CO_CONFIG_NMT_SEQ_ENABLE
+    errors += bench_nmtseq();
+#endif
+#if (CO_CONFIG_NODE_SCAN) & CO_CONFIG_NODE_SCAN_ENABLE
+    errors += bench_scan();
+#endif
+#if (CO_CONFIG_EM) & CO_CONFIG_EM_PRODUCER
+    errors += bench_emcy();
+#endif
+#if (CO_CONFIG_EM) & CO_CONFIG_EM_PROD_RATE_LIMIT
+    errors += bench_emrate();
+#endif
+#if (CO_CONFIG_EM_AGG) & CO_CONFIG_EM_AGG_ENABLE
+    errors += bench_emagg();
+#endif
+#if (CO_CONFIG_EM) & CO_CONFIG_EM_HISTORY_STORE
+    errors += bench_emhist();
+#endif
+#if (CO_CONFIG_LSS_COMM) & CO_CONFIG_LSS_COMM_ENABLE
+    errors += bench_lsscomm();
+#endif
+
+    return errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
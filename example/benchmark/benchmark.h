@@ -0,0 +1,127 @@
+/*
+ * Common definitions for the benchmark on the virtual CAN bus.
+ *
+ * @file        benchmark.h
+ * @author      J-Weisberg
+ * @copyright   2026 J-Weisberg
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define OD_DEFINITION
+#include "CANopen.h"
+#include "OD.h"
+#include "CO_driver_vbus.h"
+
+#ifndef CO_MULTIPLE_OD
+#error benchmark must be compiled with CO_MULTIPLE_OD
+#endif
+
+
+#define log_printf(macropar_message, ...) \
+        printf(macropar_message, ##__VA_ARGS__)
+
+#define NODE_ID_SERVER 0x20
+#define NODE_ID_CLIENT 0x01
+#define SDO_TIMEOUT_MS 1000
+/* simulated time between two processing cycles */
+#define CYCLE_US 100
+/* maximum size of the DOMAIN object on the server */
+#define DOMAIN_SIZE_MAX 65536
+/* maximum number of SDO clients of one device */
+#define SDO_CLI_MAX 8
+
+
+/* Object dictionary for one device: copy of entries from example OD.c with
+ * additional SDO server parameters and test objects. Each device has its own
+ * copy of the entries, because OD extensions are stored in the entries. */
+typedef struct {
+    OD_t od;
+    OD_entry_t list[OD_CNT_SDO_SRV + 128 + 40];
+    OD_obj_record_t srvPar[127][4];
+    uint8_t srvParMaxSub;
+    uint32_t srvParCobId[127][2];
+    uint8_t srvParNodeId[127];
+    OD_obj_record_t cliPar[SDO_CLI_MAX - 1][4];
+    uint32_t cliParCobId[SDO_CLI_MAX - 1][2];
+    uint8_t cliParNodeId[SDO_CLI_MAX - 1];
+    CO_config_t config;
+} bench_OD_t;
+
+/* Test objects in OD: 0x2000 is DOMAIN, 0x2001 is UNSIGNED32 */
+extern uint32_t testU32;
+extern OD_obj_var_t testU32Var;
+extern uint8_t domain[DOMAIN_SIZE_MAX];
+extern OD_obj_var_t domainVar;
+
+/* Result of repeated transfers */
+typedef struct {
+    uint32_t frames;
+    uint64_t bits;
+    uint64_t ns;
+    uint64_t cycles;
+} bench_result_t;
+
+/* Random data to transfer and buffer for received data */
+extern uint8_t dataTx[DOMAIN_SIZE_MAX];
+extern uint8_t dataRx[DOMAIN_SIZE_MAX];
+
+
+/* Monotonic time in nanoseconds */
+uint64_t time_ns(void);
+
+/* CPU cycles, 0 if not available */
+uint64_t cycles(void);
+
+/* Create object dictionary with sdoSrvCount SDO servers */
+void bench_OD_init(bench_OD_t *bod, uint8_t sdoSrvCount);
+
+/* Add SDO clients to object dictionary, up to SDO_CLI_MAX together. Entries
+ * after 0x1280 are moved, they must be configured after this call. */
+void bench_OD_sdoClients(bench_OD_t *bod, uint8_t sdoCliCount);
+
+/* Create and initialize CANopen device, exit on error */
+CO_t *bench_device(bench_OD_t *bod, uint8_t nodeId);
+
+
+/* Benchmarks from other files. Each returns number of errors. */
+int bench_sdo(uint32_t repeat);
+int bench_sdoLossy(void);
+int bench_sdoLocal(uint32_t repeat);
+int bench_domainFile(uint32_t repeat);
+int bench_servers(void);
+int bench_gateway(uint32_t repeat);
+int bench_gtwcmd(void);
+int bench_codecs(uint32_t repeat);
+int bench_numeric(uint32_t repeat);
+int bench_hbcons(void);
+int bench_nmtseq(void);
+int bench_scan(void);
+int bench_emcy(void);
+int bench_emrate(void);
+int bench_emagg(void);
+int bench_emhist(void);
+int bench_lsscomm(void);
+
+#endif /* BENCHMARK_H */
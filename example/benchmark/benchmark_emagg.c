@@ -0,0 +1,266 @@
+/*
+ * Benchmark of the network-wide Emergency aggregator.
+ *
+ * Emergency storm from many simulated nodes is compared with reference model
+ * of the aggregator tables.
+ *
+ * @file        benchmark_emagg.c
+ * @author      J-Weisberg
+ * @copyright   2026 J-Weisberg
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "benchmark.h"
+#include "301/CO_EMaggregator.h"
+
+#if (CO_CONFIG_EM_AGG) & CO_CONFIG_EM_AGG_ENABLE
+/* Emergency storm from many simulated nodes into the aggregator **************/
+#define AGG_NODES 120
+#define AGG_CODES 8
+#define AGG_BURST 16
+#define AGG_CYCLES 2000
+
+/* Reference model of the aggregator tables */
+typedef struct {
+    bool_t active[AGG_NODES + 1][AGG_CODES];
+    uint32_t count[AGG_NODES + 1][AGG_CODES];
+    uint8_t errorRegister[AGG_NODES + 1];
+    uint16_t lost[AGG_NODES + 1];
+    uint32_t activeTotal;
+    uint32_t changed[4];
+} bench_aggModel_t;
+
+static bench_aggModel_t aggModel;
+static uint32_t aggCallbacks, aggErrors;
+static uint32_t aggSeed;
+
+static uint32_t bench_aggRand(void) {
+    aggSeed = aggSeed * 1664525U + 1013904223U;
+    return aggSeed >> 8;
+}
+
+static void bench_aggChanged(uint8_t nodeId, void *object) {
+    (void)object;
+    aggCallbacks++;
+    if ((aggModel.changed[nodeId >> 5] & (1U << (nodeId & 0x1F))) == 0) {
+        aggErrors++;
+    }
+}
+
+/* Send one random Emergency message and update the model. Most messages
+ * repeat active errors, some reset one or all errors of the node. */
+static void bench_aggSend(CO_CANmodule_t *CANsim, uint32_t limit) {
+    bench_aggModel_t *m = &aggModel;
+    uint32_t r = bench_aggRand();
+    uint8_t id = (uint8_t)(r % AGG_NODES + 1);
+    uint8_t code = (uint8_t)((r >> 8) % AGG_CODES);
+    uint32_t action = (r >> 12) % 100;
+    uint16_t errorCode = 0;
+    uint8_t errorBit = 0;
+    uint8_t errorRegister = 0;
+    bool_t changed = false;
+    uint8_t activeCount = 0;
+
+    for (uint8_t c = 0; c < AGG_CODES; c++) {
+        if (m->active[id][c]) activeCount++;
+    }
+
+    if (action < 85) {
+        errorCode = CO_EMC_DEVICE_SPECIFIC | code;
+        errorBit = CO_EM_MANUFACTURER_START + code;
+        errorRegister = CO_ERR_REG_MANUFACTURER;
+        if (m->active[id][code]) {
+            m->count[id][code]++;
+        }
+        else if (m->activeTotal < limit) {
+            m->active[id][code] = true;
+            m->count[id][code] = 1;
+            m->activeTotal++;
+            changed = true;
+        }
+        else {
+            m->lost[id]++;
+        }
+    }
+    else if (action < 95) {
+        /* reset of one error, register is cleared with the last one */
+        errorBit = CO_EM_MANUFACTURER_START + code;
+        if (m->active[id][code]) {
+            activeCount--;
+        }
+        errorRegister = activeCount > 0 ? CO_ERR_REG_MANUFACTURER : 0;
+    }
+    if (errorCode == 0) {
+        for (uint8_t c = 0; c < AGG_CODES; c++) {
+            if (m->active[id][c] && (errorRegister == 0 || c == code)) {
+                m->active[id][c] = false;
+                m->activeTotal--;
+                changed = true;
+            }
+        }
+    }
+    if (m->errorRegister[id] != errorRegister) {
+        m->errorRegister[id] = errorRegister;
+        changed = true;
+    }
+    if (changed) {
+        m->changed[id >> 5] |= 1U << (id & 0x1F);
+    }
+
+    CO_CANtx_t *tx = CO_CANtxBufferInit(CANsim, 0, CO_CAN_ID_EMERGENCY + id,
+                                        false, 8, false);
+    CO_setUint16(&tx->data[0], errorCode);
+    tx->data[2] = errorRegister;
+    tx->data[3] = errorBit;
+    CO_setUint32(&tx->data[4], r);
+    CO_CANsend(CANsim, tx);
+}
+
+/* Compare the aggregator with the model */
+static uint32_t bench_aggVerify(CO_EMagg_t *agg) {
+    uint32_t wrong = 0;
+
+    for (uint8_t id = 1; id <= AGG_NODES; id++) {
+        const CO_EMagg_node_t *node = CO_EMagg_getNode(agg, id);
+        uint8_t activeCount = 0, listed = 0;
+
+        for (uint8_t c = 0; c < AGG_CODES; c++) {
+            const CO_EMagg_entry_t *e =
+                CO_EMagg_find(agg, id, CO_EMC_DEVICE_SPECIFIC | c);
+            if (aggModel.active[id][c]) {
+                activeCount++;
+                if (e == NULL || e->count != aggModel.count[id][c]
+                    || e->errorBit != CO_EM_MANUFACTURER_START + c
+                ) {
+                    wrong++;
+                }
+            }
+            else if (e != NULL) {
+                wrong++;
+            }
+        }
+        for (const CO_EMagg_entry_t *e = CO_EMagg_first(agg, id); e != NULL;
+             e = CO_EMagg_next(agg, e)
+        ) {
+            if (e->nodeId != id) wrong++;
+            listed++;
+        }
+        if (node->activeCount != activeCount || listed != activeCount
+            || CO_EMagg_isActive(agg, id) != (activeCount > 0)
+            || node->errorRegister != aggModel.errorRegister[id]
+            || node->lost != aggModel.lost[id]
+        ) {
+            wrong++;
+        }
+    }
+    return wrong;
+}
+
+int bench_emagg(void) {
+    static const uint16_t sizes[] = {2048, 64};
+    bench_OD_t *od = calloc(1, sizeof(bench_OD_t));
+    CO_EMagg_t *agg = calloc(1, sizeof(CO_EMagg_t));
+    CO_EMagg_entry_t *entries = calloc(sizes[0], sizeof(CO_EMagg_entry_t));
+    int errors = 0;
+
+    if (od == NULL || agg == NULL || entries == NULL) {
+        log_printf("Error: Can't allocate memory\n");
+        return 1;
+    }
+
+    log_printf("\nEmergency aggregator, %u nodes, %u messages per %u us "
+               "cycle\n", AGG_NODES, AGG_BURST, CYCLE_US);
+    log_printf("%-8s %10s %10s %10s %10s %10s %12s\n", "entries", "messages",
+               "active", "lost", "changes", "overflow", "ns/msg");
+
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        CO_CANrx_t simRx[1];
+        CO_CANtx_t simTx[1];
+        CO_CANmodule_t CANsim;
+        uint32_t limit = sizes[s] - sizes[s] / 4U;
+        uint32_t lost = 0, changes = 0;
+        uint64_t ns = 0;
+
+        CO_vbus_reset();
+        bench_OD_init(od, 1);
+        CO_t *co = bench_device(od, NODE_ID_CLIENT);
+        CO_CANmodule_init(&CANsim, NULL, simRx, 1, simTx, 1, 1000);
+        CO_CANsetNormalMode(&CANsim);
+        CO_EMagg_init(agg, co->em, entries, sizes[s]);
+        CO_EMagg_initCallbackChanged(agg, NULL, bench_aggChanged);
+        memset(&aggModel, 0, sizeof(aggModel));
+        aggCallbacks = aggErrors = 0;
+        aggSeed = 1;
+
+        for (uint32_t cyc = 0; cyc < AGG_CYCLES; cyc++) {
+            uint32_t expected = 0;
+
+            for (uint8_t i = 0; i < AGG_BURST; i++) {
+                bench_aggSend(&CANsim, limit);
+            }
+            for (uint8_t w = 0; w < 4; w++) {
+                expected += (uint32_t)__builtin_popcount(aggModel.changed[w]);
+            }
+            CO_vbus_deliver();
+            aggCallbacks = 0;
+            uint64_t ns0 = time_ns();
+            CO_EMagg_process(agg, CYCLE_US, NULL);
+            ns += time_ns() - ns0;
+            if (aggCallbacks != expected) {
+                aggErrors++;
+            }
+            changes += aggCallbacks;
+            memset(aggModel.changed, 0, sizeof(aggModel.changed));
+        }
+        aggErrors += bench_aggVerify(agg);
+        for (uint8_t id = 1; id <= AGG_NODES; id++) {
+            lost += aggModel.lost[id];
+        }
+
+        /* clearing all nodes signals each node with active errors */
+        uint32_t activeNodes = 0;
+        for (uint8_t id = 1; id <= AGG_NODES; id++) {
+            if (CO_EMagg_isActive(agg, id)) {
+                aggModel.changed[id >> 5] |= 1U << (id & 0x1F);
+                activeNodes++;
+            }
+        }
+        CO_EMagg_clear(agg, 0);
+        aggCallbacks = 0;
+        CO_EMagg_process(agg, CYCLE_US, NULL);
+        if (aggErrors != 0 || agg->rxOverflow != 0 || agg->entriesUsed != 0
+            || aggCallbacks != activeNodes || (s > 0 && lost == 0)
+        ) {
+            log_printf("Error: Emergency aggregator, %u wrong\n", aggErrors);
+            errors++;
+        }
+
+        log_printf("%-8u %10u %10u %10u %10u %10u %12.1f\n", sizes[s],
+                   AGG_CYCLES * AGG_BURST, aggModel.activeTotal, lost,
+                   changes, agg->rxOverflow,
+                   (double)ns / (AGG_CYCLES * AGG_BURST));
+        CO_delete(co);
+    }
+
+    free(entries);
+    free(agg);
+    free(od);
+    return errors;
+}
+#endif /* (CO_CONFIG_EM_AGG) & CO_CONFIG_EM_AGG_ENABLE */
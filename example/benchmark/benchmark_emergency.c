@@ -0,0 +1,418 @@
+/*
+ * Benchmark of the Emergency producer.
+ *
+ * Emergency reporting is measured from several threads at once, with or
+ * without CO_CONFIG_EM_LOCK_FREE. Threads toggle own error bits or one shared
+ * error bit. Emergency rate limiting is measured with one
+ * noisy error among important errors.
+ *
+ * @file        benchmark_emergency.c
+ * @author      J-Weisberg
+ * @copyright   2026 J-Weisberg
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <time.h>
+#include <pthread.h>
+
+#include "benchmark.h"
+
+#if (CO_CONFIG_EM) & CO_CONFIG_EM_PRODUCER
+/* Emergency reporting from several threads ***********************************/
+#define EM_THREADS 4
+#define EM_CALLS 5000
+#define EM_PAUSE_US 10
+#define EM_SHARED_BIT (CO_EM_MANUFACTURER_START + EM_THREADS)
+
+#if !((CO_CONFIG_EM) & CO_CONFIG_EM_LOCK_FREE)
+pthread_mutex_t bench_emcyMutex = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+typedef struct {
+    CO_EM_t *em;
+    uint8_t thread;
+    uint32_t pause_us;
+    bool_t shared;
+    uint64_t ns;
+    uint64_t nsMax;
+} bench_emThread_t;
+
+static uint32_t emThreadsDone;
+static uint32_t emFrames, emDropped, emBufferFull, emErrors;
+static int32_t emLast[EM_THREADS];
+static uint32_t emResync;
+static bool_t emSharedState;
+
+/* Each thread toggles own error bit. Info code counts the calls, so even
+ * count is report and odd count is reset. Shared error bit is toggled by all
+ * threads, so most of the calls don't change it. */
+static void *bench_emProducer(void *arg) {
+    bench_emThread_t *t = arg;
+    uint8_t errorBit = t->shared ? EM_SHARED_BIT
+                                 : CO_EM_MANUFACTURER_START + t->thread;
+    uint32_t phase = t->shared ? t->thread : 0;
+
+    for (uint32_t n = 0; n < EM_CALLS; n++) {
+        uint64_t ns0 = time_ns();
+        CO_error(t->em, ((n + phase) & 1) == 0, errorBit,
+                 CO_EMC_DEVICE_SPECIFIC | t->thread,
+                 ((uint32_t)t->thread << 24) | n);
+        uint64_t ns = time_ns() - ns0;
+        t->ns += ns;
+        if (ns > t->nsMax) t->nsMax = ns;
+
+        /* some other work */
+        if (t->pause_us > 0) {
+            struct timespec pause = {0, (long)t->pause_us * 1000};
+            nanosleep(&pause, NULL);
+        }
+    }
+    __atomic_add_fetch(&emThreadsDone, 1, __ATOMIC_RELEASE);
+    return NULL;
+}
+
+/* Verify each received Emergency message */
+static void bench_emReceive(void *object, void *msg) {
+    uint8_t *data = CO_CANrxMsg_readData(msg);
+    uint16_t errorCode = CO_getUint16(&data[0]);
+    uint8_t errorBit = data[3];
+    uint32_t info = CO_getUint32(&data[4]);
+    uint8_t t = (uint8_t)(errorBit - CO_EM_MANUFACTURER_START);
+    int32_t n = (int32_t)(info & 0xFFFFFF);
+    (void)object;
+
+    if (errorBit == CO_EM_EMERGENCY_BUFFER_FULL) {
+        if (errorCode != 0) emBufferFull++;
+        return;
+    }
+    if (errorBit == EM_SHARED_BIT) {
+        emFrames++;
+        emSharedState = errorCode != 0;
+        return;
+    }
+    /* After fifo overflow, actual state may be repeated: the last processed
+     * report or reset with zero info code, see CO_EM_process() */
+    if (t < EM_THREADS && (info >> 24) == t && n <= emLast[t]
+        && errorCode == CO_EMC_DEVICE_SPECIFIC + t && (n & 1) == 0
+    ) {
+        emResync++;
+        return;
+    }
+    if (t < EM_THREADS && errorCode == 0 && info == 0) {
+        emResync++;
+        return;
+    }
+    emFrames++;
+    /* messages of one thread come in order and are not mixed */
+    if (t >= EM_THREADS || (info >> 24) != t || n <= emLast[t]
+        || errorCode != ((n & 1) == 0 ? (CO_EMC_DEVICE_SPECIFIC | t) : 0)
+    ) {
+        emErrors++;
+        return;
+    }
+    emDropped += (uint32_t)(n - emLast[t] - 1);
+    emLast[t] = n;
+}
+
+#if (CO_CONFIG_EM) & CO_CONFIG_EM_LOCK_FREE
+/* Emulate the last message of the shared error bit, which is reserved in fifo
+ * before the message of the previous bit change. Error bit is changed without
+ * fifo entry, CO_EM_process() must then send the actual state again. */
+static int bench_emResync(CO_EM_t *em) {
+    uint8_t index = EM_SHARED_BIT >> 3;
+    uint8_t bitmask = 1 << (EM_SHARED_BIT & 0x7);
+    int errors = 0;
+
+    for (uint8_t i = 0; i < 2; i++) {
+        __atomic_xor_fetch(&em->errorStatusBits[index], bitmask,
+                           __ATOMIC_ACQ_REL);
+        for (uint8_t c = 0; c < 4; c++) {
+            CO_EM_process(em, true, CYCLE_US, NULL);
+            CO_vbus_deliver();
+        }
+        if (emSharedState != CO_isError(em, EM_SHARED_BIT)) {
+            log_printf("Error: Emergency state not repeated\n");
+            errors++;
+        }
+    }
+    return errors;
+}
+#endif
+
+int bench_emcy(void) {
+    static const uint32_t pauses_us[] = {EM_PAUSE_US, 0, EM_PAUSE_US};
+    static const bool_t shared[] = {false, false, true};
+    bench_OD_t *od = calloc(1, sizeof(bench_OD_t));
+    int errors = 0;
+
+    if (od == NULL) {
+        log_printf("Error: Can't allocate memory\n");
+        return 1;
+    }
+
+    log_printf("\nEmergency reporting with EM_LOCK_FREE=%d, %u threads, "
+               "%u calls each\n", (CO_CONFIG_EM & CO_CONFIG_EM_LOCK_FREE) != 0,
+               EM_THREADS, EM_CALLS);
+    log_printf("%-10s %10s %10s %10s %10s %12s %12s\n", "pause_us", "frames",
+               "dropped", "overflows", "repeated", "ns/call", "max_ns/call");
+
+    for (size_t p = 0; p < sizeof(pauses_us) / sizeof(pauses_us[0]); p++) {
+        bench_emThread_t threads[EM_THREADS];
+        pthread_t tid[EM_THREADS];
+        CO_CANrx_t monRx[1];
+        CO_CANtx_t monTx[1];
+        CO_CANmodule_t CANmon;
+        uint64_t ns = 0, nsMax = 0;
+        char name[16];
+
+        CO_vbus_reset();
+        bench_OD_init(od, 1);
+        CO_t *co = bench_device(od, NODE_ID_CLIENT);
+#if (CO_CONFIG_EM) & CO_CONFIG_EM_PROD_RATE_LIMIT
+        /* each message is verified, see bench_emrate() for rate limiting */
+        CO_EM_setRateLimit(co->em, 0);
+#endif
+        CO_CANmodule_init(&CANmon, NULL, monRx, 1, monTx, 1, 1000);
+        CO_CANrxBufferInit(&CANmon, 0, CO_CAN_ID_EMERGENCY + NODE_ID_CLIENT,
+                           0x7FF, false, &emFrames, bench_emReceive);
+        CO_CANsetNormalMode(&CANmon);
+        emThreadsDone = 0;
+        emFrames = emDropped = emBufferFull = emErrors = emResync = 0;
+        emSharedState = false;
+        for (uint8_t i = 0; i < EM_THREADS; i++) {
+            emLast[i] = -1;
+            threads[i] = (bench_emThread_t){co->em, i, pauses_us[p],
+                                            shared[p], 0, 0};
+            if (pthread_create(&tid[i], NULL, bench_emProducer, &threads[i])
+                != 0
+            ) {
+                log_printf("Error: Can't create thread\n");
+                exit(EXIT_FAILURE);
+            }
+        }
+
+        /* this thread sends Emergency messages, one per cycle. When producers
+         * are finished, fifo and buffer full condition are emptied. */
+        while (__atomic_load_n(&emThreadsDone, __ATOMIC_ACQUIRE) < EM_THREADS) {
+            CO_EM_process(co->em, true, CYCLE_US, NULL);
+            CO_vbus_deliver();
+        }
+        for (uint16_t i = 0; i < 2U * co->em->fifoSize + 2U; i++) {
+            CO_EM_process(co->em, true, CYCLE_US, NULL);
+            CO_vbus_deliver();
+        }
+        for (uint8_t i = 0; i < EM_THREADS; i++) {
+            pthread_join(tid[i], NULL);
+            ns += threads[i].ns;
+            if (threads[i].nsMax > nsMax) nsMax = threads[i].nsMax;
+            if (CO_isError(co->em, CO_EM_MANUFACTURER_START + i)) {
+                emErrors++;
+            }
+            /* the last messages may also be dropped */
+            if (!shared[p]) {
+                emDropped += (uint32_t)(EM_CALLS - 1 - emLast[i]);
+            }
+        }
+        /* each call is either received or dropped. Last message of shared
+         * error bit matches its state. */
+        if (emErrors != 0 || CO_isError(co->em, CO_EM_EMERGENCY_BUFFER_FULL)
+            || (!shared[p] && emFrames + emDropped != EM_THREADS * EM_CALLS)
+            || (emDropped > 0 && emBufferFull == 0)
+            || emSharedState != CO_isError(co->em, EM_SHARED_BIT)
+        ) {
+            log_printf("Error: Emergency messages, %u wrong\n", emErrors);
+            errors++;
+        }
+#if (CO_CONFIG_EM) & CO_CONFIG_EM_LOCK_FREE
+        if (shared[p]) {
+            errors += bench_emResync(co->em);
+        }
+#endif
+
+        snprintf(name, sizeof(name), shared[p] ? "%u shared" : "%u",
+                 pauses_us[p]);
+        log_printf("%-10s %10u %10u %10u %10u %12.1f %12.1f\n", name,
+                   emFrames, emDropped, emBufferFull, emResync,
+                   (double)ns / (EM_THREADS * EM_CALLS), (double)nsMax);
+
+        CO_delete(co);
+    }
+
+    free(od);
+    return errors;
+}
+#endif /* (CO_CONFIG_EM) & CO_CONFIG_EM_PRODUCER */
+
+
+#if (CO_CONFIG_EM) & CO_CONFIG_EM_PROD_RATE_LIMIT
+/* Noisy error among important errors with emergency rate limiting ***********/
+#define RATE_CYCLES 20000
+#define RATE_DRAIN_CYCLES 3000
+#define RATE_INHIBIT_100US 10
+#define RATE_IMPORTANT 4
+/* important error is set and reset 150 ms later, each 200 ms */
+#define RATE_IMPORTANT_PERIOD 2000
+#define RATE_IMPORTANT_RESET 1500
+#define RATE_NOISY_BIT CO_EM_MANUFACTURER_START
+#define RATE_NOISY_FIRST 0x80000000U
+
+typedef struct {
+    uint32_t cycle;
+    uint32_t frames;
+    uint32_t noisyFirst;
+    uint32_t noisySummaries;
+    uint32_t noisyCounted;
+    uint16_t noisyLastCode;
+    uint32_t important;
+    uint32_t importantLatencyMax;
+    uint32_t overflows;
+    uint32_t errors;
+} bench_rate_t;
+
+static bench_rate_t rate;
+
+/* Noisy messages have RATE_NOISY_FIRST in info code, summary messages have the
+ * number of counted messages. Important messages have cycle of the report. */
+static void bench_rateReceive(void *object, void *msg) {
+    uint8_t *data = CO_CANrxMsg_readData(msg);
+    uint16_t errorCode = CO_getUint16(&data[0]);
+    uint8_t errorBit = data[3];
+    uint32_t info = CO_getUint32(&data[4]);
+    (void)object;
+
+    rate.frames++;
+    if (errorBit == CO_EM_EMERGENCY_BUFFER_FULL) {
+        if (errorCode != 0) rate.overflows++;
+    }
+    else if (errorBit == RATE_NOISY_BIT) {
+        if ((info & RATE_NOISY_FIRST) != 0) {
+            rate.noisyFirst++;
+        }
+        else {
+            rate.noisySummaries++;
+            rate.noisyCounted += info;
+        }
+        rate.noisyLastCode = errorCode;
+    }
+    else if (errorBit > RATE_NOISY_BIT
+             && errorBit <= RATE_NOISY_BIT + RATE_IMPORTANT
+             && info <= rate.cycle
+    ) {
+        uint32_t latency = rate.cycle - info;
+        rate.important++;
+        if (latency > rate.importantLatencyMax) {
+            rate.importantLatencyMax = latency;
+        }
+    }
+    else {
+        rate.errors++;
+    }
+}
+
+int bench_emrate(void) {
+    static const uint16_t windows_ms[] = {0, 10, 100};
+    bench_OD_t *od = calloc(1, sizeof(bench_OD_t));
+    int errors = 0;
+
+    if (od == NULL) {
+        log_printf("Error: Can't allocate memory\n");
+        return 1;
+    }
+
+    log_printf("\nEmergency rate limiting, inhibit time %u us, noisy error "
+               "each %u us, %u important errors\n", RATE_INHIBIT_100US * 100,
+               CYCLE_US, 2 * RATE_CYCLES / RATE_IMPORTANT_PERIOD);
+    log_printf("%-10s %8s %8s %10s %10s %10s %10s %14s\n", "window_ms",
+               "frames", "noisy", "summaries", "overflows", "important",
+               "lost", "max_latency_us");
+
+    for (size_t w = 0; w < sizeof(windows_ms) / sizeof(windows_ms[0]); w++) {
+        CO_CANrx_t monRx[1];
+        CO_CANtx_t monTx[1];
+        CO_CANmodule_t CANmon;
+        uint32_t noisyCalls = 0, importantCalls = 0;
+
+        CO_vbus_reset();
+        bench_OD_init(od, 1);
+        CO_t *co = bench_device(od, NODE_ID_CLIENT);
+        OD_entry_t *entry1015 = OD_find(&od->od, 0x1015);
+        OD_set_u16(entry1015, 0, RATE_INHIBIT_100US, false);
+        CO_EM_setRateLimit(co->em, windows_ms[w]);
+        CO_CANmodule_init(&CANmon, NULL, monRx, 1, monTx, 1, 1000);
+        CO_CANrxBufferInit(&CANmon, 0, CO_CAN_ID_EMERGENCY + NODE_ID_CLIENT,
+                           0x7FF, false, &rate, bench_rateReceive);
+        CO_CANsetNormalMode(&CANmon);
+        memset(&rate, 0, sizeof(rate));
+
+        for (rate.cycle = 0; rate.cycle < RATE_CYCLES + RATE_DRAIN_CYCLES;
+             rate.cycle++
+        ) {
+            uint32_t cyc = rate.cycle;
+            if (cyc < RATE_CYCLES) {
+                CO_error(co->em, (cyc & 1) == 0, RATE_NOISY_BIT,
+                         CO_EMC_DEVICE_SPECIFIC, RATE_NOISY_FIRST | cyc);
+                noisyCalls++;
+
+                uint32_t phase = cyc % RATE_IMPORTANT_PERIOD;
+                uint8_t bit = RATE_NOISY_BIT + 1
+                    + (cyc / RATE_IMPORTANT_PERIOD) % RATE_IMPORTANT;
+                if (phase == 0 || phase == RATE_IMPORTANT_RESET) {
+                    CO_error(co->em, phase == 0, bit, CO_EMC_HARDWARE, cyc);
+                    importantCalls++;
+                }
+            }
+            CO_EM_process(co->em, true, CYCLE_US, NULL);
+            CO_vbus_deliver();
+        }
+
+        /* With rate limiting all noisy messages are sent or counted and the
+         * last summary shows actual state. Important messages are not lost and
+         * wait for the inhibit time of the noisy message at most. */
+        uint32_t lost = importantCalls - rate.important;
+        uint32_t latency_us = rate.importantLatencyMax * CYCLE_US;
+        uint32_t noisy = rate.noisyFirst + rate.noisySummaries;
+        if (rate.errors != 0
+            || (windows_ms[w] != 0
+                && (rate.overflows != 0 || lost != 0
+                    || rate.noisyFirst + rate.noisyCounted != noisyCalls
+                    || co->em->rateLimitCoalesced + rate.noisyFirst
+                       != noisyCalls
+                    || rate.noisyLastCode != 0
+                    || latency_us > 3U * RATE_INHIBIT_100US * 100
+                    || noisy > 2U + (RATE_CYCLES + RATE_DRAIN_CYCLES)
+                                    * CYCLE_US / (windows_ms[w] * 1000U)))
+        ) {
+            log_printf("Error: rate limiting with window %u ms\n",
+                       windows_ms[w]);
+            errors++;
+        }
+
+        log_printf("%-10u %8u %8u %10u %10u %10u %10u %14u\n", windows_ms[w],
+                   rate.frames, noisy, rate.noisySummaries, rate.overflows,
+                   rate.important, lost, latency_us);
+
+        /* inhibit time is in the OD, shared with other devices */
+        OD_set_u16(entry1015, 0, 0, true);
+        CO_delete(co);
+    }
+
+    free(od);
+    return errors;
+}
+#endif /* (CO_CONFIG_EM) & CO_CONFIG_EM_PROD_RATE_LIMIT */
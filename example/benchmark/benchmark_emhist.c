@@ -0,0 +1,266 @@
+/*
+ * Benchmark of the persistent error history.
+ *
+ * Error history is stored in simulated flash and restored after different
+ * kinds of reset.
+ *
+ * @file        benchmark_emhist.c
+ * @author      J-Weisberg
+ * @copyright   2026 J-Weisberg
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "benchmark.h"
+#include "storage/CO_storageEmHistory.h"
+
+#if (CO_CONFIG_EM) & CO_CONFIG_EM_HISTORY_STORE
+/* Error history in simulated flash, across resets ****************************/
+#define EH_SECTOR_SIZE 256
+#define EH_SECTORS 4
+#define EH_ERRORS 500
+#define EH_FLUSH_MS 10
+/* sub-index of the error history in OD objects 0x1010 and 0x1011 */
+#define EH_STORAGE_SUB 4
+
+static uint8_t ehFlash[EH_SECTORS * EH_SECTOR_SIZE];
+static uint32_t ehErases[EH_SECTORS];
+
+static bool_t bench_ehRead(void *storageModule, size_t addr,
+                           uint8_t *buf, size_t len)
+{
+    (void)storageModule;
+    memcpy(buf, &ehFlash[addr], len);
+    return true;
+}
+
+/* flash may only be written, where it is erased */
+static bool_t bench_ehWrite(void *storageModule, size_t addr,
+                            const uint8_t *buf, size_t len)
+{
+    (void)storageModule;
+    for (size_t i = 0; i < len; i++) {
+        if (ehFlash[addr + i] != 0xFF) {
+            return false;
+        }
+    }
+    memcpy(&ehFlash[addr], buf, len);
+    return true;
+}
+
+static bool_t bench_ehErase(void *storageModule, size_t addr, size_t len) {
+    (void)storageModule;
+    memset(&ehFlash[addr], 0xFF, len);
+    ehErases[addr / EH_SECTOR_SIZE]++;
+    return true;
+}
+
+/* Register error history as the only entry of the data storage */
+static void bench_ehStorage(bench_OD_t *od, CO_t *co, CO_storageEmHist_t *hist,
+                            CO_storage_t *storage, CO_storage_entry_t *entry)
+{
+    memset(entry, 0, sizeof(*entry));
+    entry->addr = hist;
+    entry->len = sizeof(*hist);
+    entry->subIndexOD = EH_STORAGE_SUB;
+    entry->attr = CO_storage_cmd | CO_storage_auto | CO_storage_restore;
+    CO_storage_init(storage, co->CANmodule, OD_find(&od->od, 0x1010),
+                    OD_find(&od->od, 0x1011), CO_storageEmHist_store,
+                    CO_storageEmHist_restoreDefault, entry, 1);
+    storage->enabled = true;
+}
+
+/* Read OD object 0x1003, newest entry first. Return number of entries. */
+static uint8_t bench_ehHistory(OD_entry_t *entry, uint32_t *list) {
+    uint8_t count = 0;
+
+    OD_get_u8(entry, 0, &count, false);
+    for (uint8_t i = 0; i < count; i++) {
+        OD_get_u32(entry, i + 1, &list[i], false);
+    }
+    return count;
+}
+
+int bench_emhist(void) {
+    static const char *resets[] = {"shutdown", "power loss", "torn write",
+                                   "cleared"};
+    bench_OD_t *od = calloc(1, sizeof(bench_OD_t));
+    CO_storageEmHist_t *hist = calloc(1, sizeof(CO_storageEmHist_t));
+    CO_storage_t storage;
+    CO_storage_entry_t storageEntry;
+    uint32_t before[OD_CNT_ARR_1003], after[OD_CNT_ARR_1003];
+    uint32_t seed = 1;
+    int errors = 0;
+
+    if (od == NULL || hist == NULL) {
+        log_printf("Error: Can't allocate memory\n");
+        return 1;
+    }
+
+    log_printf("\nError history in %u sectors of %u bytes, batch %u, "
+               "%u errors before each reset\n", EH_SECTORS, EH_SECTOR_SIZE,
+               CO_CONFIG_STORAGE_EM_HISTORY_BATCH, EH_ERRORS);
+    log_printf("%-11s %8s %8s %8s %6s %9s %14s %14s\n", "reset", "restored",
+               "writes", "erases", "lost", "boot_us", "max_ns/em_proc",
+               "max_ns/st_proc");
+
+    memset(ehFlash, 0, sizeof(ehFlash)); /* unknown content */
+    memset(ehErases, 0, sizeof(ehErases));
+    CO_vbus_reset();
+    bench_OD_init(od, 1);
+    CO_t *co = bench_device(od, NODE_ID_CLIENT);
+    OD_entry_t *entry1003 = OD_find(&od->od, 0x1003);
+    uint64_t ns0 = time_ns();
+    CO_storageEmHist_init(hist, NULL, bench_ehRead, bench_ehWrite,
+                          bench_ehErase, 0, EH_SECTOR_SIZE, EH_SECTORS,
+                          EH_FLUSH_MS);
+    CO_storageEmHist_restore(hist, co->em);
+    uint64_t bootNs = time_ns() - ns0;
+    bench_ehStorage(od, co, hist, &storage, &storageEntry);
+
+    for (size_t r = 0; r < sizeof(resets) / sizeof(resets[0]); r++) {
+        uint32_t errorsCount = (r == 3) ? 3 : EH_ERRORS;
+        uint64_t emNsMax = 0, stNsMax = 0;
+
+        if (r == 3) {
+            /* clear history from OD, only the new errors remain */
+            OD_set_u8(entry1003, 0, 0, false);
+        }
+
+        /* toggle manufacturer error bits, one change in three cycles */
+        for (uint32_t cyc = 0; cyc < errorsCount * 3; cyc++) {
+            if (cyc % 3 == 0) {
+                seed = seed * 1664525U + 1013904223U;
+                uint8_t bit = CO_EM_MANUFACTURER_START + (seed >> 24) % 8;
+                CO_error(co->em, !CO_isError(co->em, bit), bit,
+                         CO_EMC_DEVICE_SPECIFIC | bit, cyc);
+            }
+            ns0 = time_ns();
+            CO_EM_process(co->em, true, CYCLE_US, NULL);
+            uint64_t ns = time_ns() - ns0;
+            if (ns > emNsMax) emNsMax = ns;
+            ns0 = time_ns();
+            CO_storageEmHist_process(hist, CYCLE_US, false);
+            ns = time_ns() - ns0;
+            if (ns > stNsMax) stNsMax = ns;
+            CO_vbus_deliver();
+        }
+        uint8_t countBefore = bench_ehHistory(entry1003, before);
+
+        /* records, which are not in the flash after the reset */
+        uint8_t missing = 0;
+        if (r == 0) {
+            /* 'save' into 0x1010 writes the batch */
+            OD_set_u32(OD_find(&od->od, 0x1010), EH_STORAGE_SUB, 0x65766173,
+                       false);
+        }
+        else if (r == 3) {
+            CO_storageEmHist_process(hist, 0, true);
+        }
+        else {
+            missing = hist->batchCount;
+        }
+        if (r == 2) {
+            /* newest record in the flash is only partially written */
+            uint16_t sector = hist->sector;
+            uint16_t record = hist->record;
+            if (record == 0) {
+                sector = (sector + EH_SECTORS - 1) % EH_SECTORS;
+                record = EH_SECTOR_SIZE / CO_STORAGE_EM_HISTORY_RECORD_SIZE;
+            }
+            memset(&ehFlash[sector * EH_SECTOR_SIZE
+                            + (record - 1) * CO_STORAGE_EM_HISTORY_RECORD_SIZE
+                            + 4], 0, 4);
+            missing++;
+        }
+        uint32_t writes = hist->writes, erases = hist->erases;
+        uint32_t lost = hist->lost;
+
+        /* reset: new device and storage object from the same flash */
+        CO_delete(co);
+        CO_vbus_reset();
+        bench_OD_init(od, 1);
+        co = bench_device(od, NODE_ID_CLIENT);
+        entry1003 = OD_find(&od->od, 0x1003);
+        ns0 = time_ns();
+        CO_storageEmHist_init(hist, NULL, bench_ehRead, bench_ehWrite,
+                              bench_ehErase, 0, EH_SECTOR_SIZE, EH_SECTORS,
+                              EH_FLUSH_MS);
+        uint16_t restored = CO_storageEmHist_restore(hist, co->em);
+        bootNs = time_ns() - ns0;
+        bench_ehStorage(od, co, hist, &storage, &storageEntry);
+        uint8_t countAfter = bench_ehHistory(entry1003, after);
+
+        /* restored history is the old one without the missing records */
+        bool_t ok = lost == 0 && !hist->hwError && countAfter == restored
+                    && (r != 3 || countAfter == errorsCount)
+                    && countAfter >= countBefore - missing;
+        for (uint8_t i = 0; ok && i + missing < countBefore; i++) {
+            if (after[i] != before[i + missing]) {
+                ok = false;
+            }
+        }
+        if (!ok) {
+            log_printf("Error: error history after %s, %u of %u entries\n",
+                       resets[r], countAfter, countBefore);
+            errors++;
+        }
+
+        log_printf("%-11s %8u %8u %8u %6u %9.1f %14.0f %14.0f\n", resets[r],
+                   restored, writes, erases, lost, (double)bootNs / 1000.0,
+                   (double)emNsMax, (double)stNsMax);
+    }
+
+    /* 'load' into 0x1011 clears the history restored after the next reset */
+    if (OD_set_u32(OD_find(&od->od, 0x1011), EH_STORAGE_SUB, 0x64616F6C,
+                   false) != ODR_OK
+    ) {
+        log_printf("Error: error history, restore defaults failed\n");
+        errors++;
+    }
+    CO_delete(co);
+    CO_vbus_reset();
+    bench_OD_init(od, 1);
+    co = bench_device(od, NODE_ID_CLIENT);
+    CO_storageEmHist_init(hist, NULL, bench_ehRead, bench_ehWrite,
+                          bench_ehErase, 0, EH_SECTOR_SIZE, EH_SECTORS,
+                          EH_FLUSH_MS);
+    if (CO_storageEmHist_restore(hist, co->em) != 0) {
+        log_printf("Error: error history not cleared by restore defaults\n");
+        errors++;
+    }
+
+    /* sectors are erased evenly */
+    uint32_t erasesMin = ehErases[0], erasesMax = ehErases[0];
+    for (uint8_t s = 1; s < EH_SECTORS; s++) {
+        if (ehErases[s] < erasesMin) erasesMin = ehErases[s];
+        if (ehErases[s] > erasesMax) erasesMax = ehErases[s];
+    }
+    if (erasesMax - erasesMin > 1) {
+        log_printf("Error: uneven wear, %u to %u erases\n",
+                   erasesMin, erasesMax);
+        errors++;
+    }
+    log_printf("sector erases from %u to %u\n", erasesMin, erasesMax);
+
+    CO_delete(co);
+    free(hist);
+    free(od);
+    return errors;
+}
+#endif /* (CO_CONFIG_EM) & CO_CONFIG_EM_HISTORY_STORE */
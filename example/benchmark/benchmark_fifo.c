@@ -0,0 +1,589 @@
+/*
+ * Benchmark of the CO_fifo converters, used by the gateway.
+ *
+ * Hex and base64 codecs, used for DOMAIN and OCTET_STRING data, are measured
+ * in MB/s, as well as printing and parsing of numbers of basic data types.
+ * Round trip of numbers is verified for all 8 and 16 bit values and for
+ * special and random values of larger types.
+ *
+ * @file        benchmark_fifo.c
+ * @author      J-Weisberg
+ * @copyright   2026 J-Weisberg
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "benchmark.h"
+#include <float.h>
+#include <math.h>
+
+#if (CO_CONFIG_FIFO) & CO_CONFIG_FIFO_ASCII_DATATYPES
+/* Benchmark of hex and base64 codecs, used by gateway for DOMAIN and
+ * OCTET_STRING data **********************************************************/
+/* size of the fifo buffers, data wraps in them as in SDO client */
+#define CODEC_FIFO_SIZE 1024
+/* size of the text chunks, approximately as gateway response buffer */
+#define CODEC_CHUNK 200
+
+typedef size_t (*bench_enc_t)(CO_fifo_t *fifo, char *buf, size_t count,
+                              bool_t end);
+typedef size_t (*bench_dec_t)(CO_fifo_t *dest, CO_fifo_t *src,
+                              CO_fifo_st *status);
+
+static char codecText[DOMAIN_SIZE_MAX * 3 + 2];
+
+/* Encode size bytes from dataTx into codecText, return length of the text */
+static size_t bench_encode(bench_enc_t enc, size_t size) {
+    static uint8_t buf[CODEC_FIFO_SIZE];
+    CO_fifo_t fifo;
+    size_t written = 0;
+    size_t len = 0;
+
+    CO_fifo_init(&fifo, buf, sizeof(buf));
+    CO_fifo_reset(&fifo);
+    do {
+        written += CO_fifo_write(&fifo, &dataTx[written], size - written,
+                                 NULL);
+        len += enc(&fifo, &codecText[len], CODEC_CHUNK, written == size);
+    } while (written < size || CO_fifo_getOccupied(&fifo) > 0);
+
+    return len;
+}
+
+/* Decode text from codecText into dataRx, return size of data or 0 on error */
+static size_t bench_decode(bench_dec_t dec, size_t len) {
+    static uint8_t srcBuf[CODEC_FIFO_SIZE];
+    static uint8_t destBuf[CODEC_FIFO_SIZE];
+    CO_fifo_t src, dest;
+    CO_fifo_st st;
+    size_t written = 0;
+    size_t size = 0;
+
+    CO_fifo_init(&src, srcBuf, sizeof(srcBuf));
+    CO_fifo_reset(&src);
+    CO_fifo_init(&dest, destBuf, sizeof(destBuf));
+    CO_fifo_reset(&dest);
+    do {
+        written += CO_fifo_write(&src, (const uint8_t *)&codecText[written],
+                                 len - written, NULL);
+        dec(&dest, &src, &st);
+        size += CO_fifo_read(&dest, &dataRx[size], sizeof(dataRx) - size,
+                             NULL);
+    } while ((st & (CO_fifo_st_closed | CO_fifo_st_errMask)) == 0);
+
+    return (st & CO_fifo_st_errMask) == 0 ? size : 0;
+}
+
+int bench_codecs(uint32_t repeat) {
+    static const struct {
+        const char *name;
+        bench_enc_t enc;
+        bench_dec_t dec;
+    } codecs[] = {
+        {"hex", CO_fifo_readHex2a, CO_fifo_cpyTok2Hex},
+        {"base64", CO_fifo_readB642a, CO_fifo_cpyTok2B64}
+    };
+    static const size_t sizes[] = {64, 889, DOMAIN_SIZE_MAX};
+    int errors = 0;
+
+    log_printf("\nHex and base64 codecs\n");
+    log_printf("%-12s %8s %10s %12s %12s\n", "codec", "size", "text_B",
+               "enc_MB/s", "dec_MB/s");
+
+    for (size_t c = 0; c < sizeof(codecs) / sizeof(codecs[0]); c++) {
+        for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+            uint32_t rep = (uint32_t)((repeat * 1024ULL) / sizes[s]) + 1;
+            uint64_t nsEnc = 0, nsDec = 0;
+            size_t len = 0, size = 0;
+
+            for (uint32_t r = 0; r < rep; r++) {
+                uint64_t ns0 = time_ns();
+                len = bench_encode(codecs[c].enc, sizes[s]);
+                uint64_t ns1 = time_ns();
+                codecText[len] = '\n';
+                size = bench_decode(codecs[c].dec, len + 1);
+                nsDec += time_ns() - ns1;
+                nsEnc += ns1 - ns0;
+            }
+            if (size != sizes[s] || memcmp(dataRx, dataTx, size) != 0) {
+                log_printf("Error: %s codec, size %lu, data mismatch\n",
+                           codecs[c].name, (unsigned long)sizes[s]);
+                errors++;
+            }
+            log_printf("%-12s %8lu %10lu %12.1f %12.1f\n", codecs[c].name,
+                       (unsigned long)sizes[s], (unsigned long)len,
+                       (double)sizes[s] * rep * 1000.0 / (double)nsEnc,
+                       (double)sizes[s] * rep * 1000.0 / (double)nsDec);
+        }
+    }
+
+    return errors;
+}
+
+/* Benchmark of number conversions, used by gateway for basic data types. Each
+ * value is printed from the fifo and parsed back, as in gateway polling with
+ * 'r' and 'w' commands. Real numbers are compared with a baseline of a single
+ * sprintf("%g") and strtod(), which doesn't always read back the same value.
+ * Printed real numbers must read back to the same value. Values, which are not
+ * printed with the shortest digits, are counted in 'longer' column.
+ ******************************************************************************/
+#define NUMERIC_VALUES 1024
+/* number of random values for round trip verification of large types */
+#define NUMERIC_RANDOM 100000
+
+typedef struct {
+    const char *name;
+    size_t size;
+    bool_t real;
+    /* baseline, uses the same values as the type before it */
+    bool_t base;
+    /* printed string reads back to the same value, verify round trip */
+    bool_t exact;
+    size_t (*print)(CO_fifo_t *fifo, char *buf, size_t count, bool_t end);
+    size_t (*parse)(CO_fifo_t *dest, CO_fifo_t *src, CO_fifo_st *status);
+} bench_numType_t;
+
+static size_t baseReadR322a(CO_fifo_t *fifo, char *buf, size_t count,
+                            bool_t end)
+{
+    float32_t n = 0;
+    (void)count; (void)end;
+    CO_fifo_read(fifo, (uint8_t *)&n, sizeof(n), NULL);
+    return (size_t)sprintf(buf, "%g", CO_SWAP_32(n));
+}
+
+static size_t baseReadR642a(CO_fifo_t *fifo, char *buf, size_t count,
+                            bool_t end)
+{
+    float64_t n = 0;
+    (void)count; (void)end;
+    CO_fifo_read(fifo, (uint8_t *)&n, sizeof(n), NULL);
+    return (size_t)sprintf(buf, "%g", CO_SWAP_64(n));
+}
+
+static size_t baseCpyTok2R32(CO_fifo_t *dest, CO_fifo_t *src,
+                             CO_fifo_st *status)
+{
+    char buf[30];
+    int8_t closed = -1;
+    bool_t err = 0;
+    CO_fifo_readToken(src, buf, sizeof(buf), &closed, &err);
+    float32_t n = CO_SWAP_32((float32_t)strtod(buf, NULL));
+    *status = (CO_fifo_st)closed;
+    return CO_fifo_write(dest, (uint8_t *)&n, sizeof(n), NULL);
+}
+
+static size_t baseCpyTok2R64(CO_fifo_t *dest, CO_fifo_t *src,
+                             CO_fifo_st *status)
+{
+    char buf[40];
+    int8_t closed = -1;
+    bool_t err = 0;
+    CO_fifo_readToken(src, buf, sizeof(buf), &closed, &err);
+    float64_t n = CO_SWAP_64(strtod(buf, NULL));
+    *status = (CO_fifo_st)closed;
+    return CO_fifo_write(dest, (uint8_t *)&n, sizeof(n), NULL);
+}
+
+/* Values of real type, which are printed with more than the shortest digits */
+static uint32_t numLonger;
+
+/* Number of significant digits in printed real number */
+static int numDigits(const char *text, size_t len) {
+    int digits = 0, zeros = 0;
+    bool_t leading = true;
+
+    for (size_t i = 0; i < len && text[i] != 'e'; i++) {
+        if (text[i] < '0' || text[i] > '9' || (leading && text[i] == '0')) {
+            continue;
+        }
+        leading = false;
+        if (text[i] == '0') {
+            zeros++;
+        }
+        else {
+            digits += zeros + 1;
+            zeros = 0;
+        }
+    }
+    return digits;
+}
+
+/* Smallest number of significant digits, which reads back to the same value,
+ * found with sprintf() and strtod() */
+static int numDigitsShortest(const uint8_t *value, size_t size) {
+    char text[40];
+    int prec;
+
+    for (prec = 1; prec < 17; prec++) {
+        if (size == 4) {
+            float32_t f32;
+            memcpy(&f32, value, sizeof(f32));
+            f32 = CO_SWAP_32(f32);
+            sprintf(text, "%.*e", prec - 1, f32);
+            if (strtof(text, NULL) == f32) break;
+        }
+        else {
+            float64_t f64;
+            memcpy(&f64, value, sizeof(f64));
+            f64 = CO_SWAP_64(f64);
+            sprintf(text, "%.*e", prec - 1, f64);
+            if (strtod(text, NULL) == f64) break;
+        }
+    }
+    return prec;
+}
+
+/* Print value with type->print and parse the text back with type->parse.
+ * Return false, if the same bytes are not read back. Real number, which is not
+ * printed with the shortest digits, is counted in numLonger. */
+static bool_t numRoundTrip(const bench_numType_t *type, const uint8_t *value) {
+    uint8_t fifoBuf[40];
+    uint8_t destBuf[10];
+    CO_fifo_t fifo, dest;
+    char text[32];
+    uint8_t back[8];
+    CO_fifo_st st;
+    size_t len;
+
+    CO_fifo_init(&fifo, fifoBuf, sizeof(fifoBuf));
+    CO_fifo_init(&dest, destBuf, sizeof(destBuf));
+    CO_fifo_write(&fifo, value, type->size, NULL);
+    len = type->print(&fifo, text, sizeof(text) - 1, true);
+    CO_fifo_reset(&fifo);
+    CO_fifo_write(&fifo, (const uint8_t *)text, len, NULL);
+    CO_fifo_putc(&fifo, '\n');
+    type->parse(&dest, &fifo, &st);
+    if ((st & CO_fifo_st_errMask) != 0
+        || CO_fifo_read(&dest, back, sizeof(back), NULL) != type->size
+        || memcmp(back, value, type->size) != 0
+    ) {
+        log_printf("Error: %s round trip of '%.*s'\n", type->name,
+                   (int)len, text);
+        return false;
+    }
+    if (type->real && text[len - 1] != 'n' && text[len - 1] != 'f') {
+        int digits = numDigits(text, len);
+        int shortest = numDigitsShortest(value, type->size);
+        if (digits > (type->size == 4 ? 9 : 17)
+            || (digits < shortest && digits > 0)
+        ) {
+            log_printf("Error: %s '%.*s' has %d digits, shortest %d\n",
+                       type->name, (int)len, text, digits, shortest);
+            return false;
+        }
+        if (digits > shortest) {
+            numLonger++;
+        }
+    }
+    return true;
+}
+
+/* Verify round trip of all 8 and 16 bit values, special and random values of
+ * larger types. Return number of verified values, 0 on error. */
+static uint32_t numVerify(const bench_numType_t *type) {
+    static const float32_t specR32[] = {
+        0.0f, -0.0f, NAN, -NAN, INFINITY, -INFINITY, FLT_MIN, -FLT_MIN,
+        FLT_MAX, -FLT_MAX, FLT_TRUE_MIN, -FLT_TRUE_MIN,
+        FLT_MIN - FLT_TRUE_MIN, FLT_EPSILON, 1.0f + FLT_EPSILON, 0.1f, 1e6f
+    };
+    static const float64_t specR64[] = {
+        0.0, -0.0, NAN, -NAN, INFINITY, -INFINITY, DBL_MIN, -DBL_MIN,
+        DBL_MAX, -DBL_MAX, DBL_TRUE_MIN, -DBL_TRUE_MIN,
+        DBL_MIN - DBL_TRUE_MIN, DBL_EPSILON, 1.0 + DBL_EPSILON, 0.1, 1e6
+    };
+    uint8_t value[8];
+    uint32_t count = 0;
+
+    if (!type->real && type->size <= 2) {
+        for (uint32_t v = 0; v < (1UL << (type->size * 8)); v++) {
+            for (size_t b = 0; b < type->size; b++) {
+                value[b] = (uint8_t)(v >> (b * 8));
+            }
+            if (!numRoundTrip(type, value)) {
+                return 0;
+            }
+            count++;
+        }
+        return count;
+    }
+
+    if (type->real) {
+        size_t n = type->size == 4 ? sizeof(specR32) / sizeof(specR32[0])
+                                   : sizeof(specR64) / sizeof(specR64[0]);
+        for (size_t i = 0; i < n; i++) {
+            if (type->size == 4) {
+                float32_t f32 = CO_SWAP_32(specR32[i]);
+                memcpy(value, &f32, sizeof(f32));
+            }
+            else {
+                float64_t f64 = CO_SWAP_64(specR64[i]);
+                memcpy(value, &f64, sizeof(f64));
+            }
+            if (!numRoundTrip(type, value)) {
+                return 0;
+            }
+            count++;
+        }
+    }
+    else {
+        /* zero, all ones and both limits of signed numbers, little endian */
+        static const uint8_t edge[][2] = {
+            {0x00, 0x00}, {0xFF, 0xFF}, {0xFF, 0x7F}, {0x00, 0x80}
+        };
+        for (size_t i = 0; i < sizeof(edge) / sizeof(edge[0]); i++) {
+            memset(value, edge[i][0], type->size);
+            value[type->size - 1] = edge[i][1];
+            if (!numRoundTrip(type, value)) {
+                return 0;
+            }
+            count++;
+        }
+    }
+
+    /* random bit patterns, NaNs with payload are skipped */
+    for (uint32_t i = 0; i < NUMERIC_RANDOM; i++) {
+        for (size_t b = 0; b < type->size; b++) {
+            value[b] = (uint8_t)rand();
+        }
+        if (type->real) {
+            float32_t f32;
+            float64_t f64;
+            memcpy(&f32, value, sizeof(f32));
+            memcpy(&f64, value, sizeof(f64));
+            if (type->size == 4 ? CO_SWAP_32(f32) != CO_SWAP_32(f32)
+                                : CO_SWAP_64(f64) != CO_SWAP_64(f64)
+            ) {
+                continue;
+            }
+        }
+        if (!numRoundTrip(type, value)) {
+            return 0;
+        }
+        count++;
+    }
+    return count;
+}
+
+/* Values out of range, which must be rejected by the parser. Without
+ * CO_CONFIG_FIFO_ASCII_STRICT_RANGE some of them are accepted for 32 and 64 bit
+ * types and converted with two's complement. Return number of errors. */
+static int numVerifyRange(void) {
+    static const struct {
+        const char *name;
+        size_t (*parse)(CO_fifo_t *dest, CO_fifo_t *src, CO_fifo_st *status);
+        const char *text;
+        /* wraps without strict range, value in little endian */
+        bool_t wraps;
+        uint8_t value[8];
+    } rejects[] = {
+        {"u8", CO_fifo_cpyTok2U8, "-1", false, {0}},
+        {"u16", CO_fifo_cpyTok2U16, "-1", false, {0}},
+        {"u32", CO_fifo_cpyTok2U32, "-1", true, {0xFF, 0xFF, 0xFF, 0xFF}},
+        {"u32", CO_fifo_cpyTok2U32, "-4294967295", true, {1, 0, 0, 0}},
+        {"u64", CO_fifo_cpyTok2U64, "-1", true,
+         {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF}},
+        {"u8", CO_fifo_cpyTok2U8, "256", false, {0}},
+        {"u16", CO_fifo_cpyTok2U16, "0x10000", false, {0}},
+        {"u32", CO_fifo_cpyTok2U32, "4294967296", false, {0}},
+        {"u64", CO_fifo_cpyTok2U64, "0x10000000000000000", false, {0}},
+        {"i8", CO_fifo_cpyTok2I8, "0x80", false, {0}},
+        {"i16", CO_fifo_cpyTok2I16, "0x8000", false, {0}},
+        {"i32", CO_fifo_cpyTok2I32, "0x80000000", true, {0, 0, 0, 0x80}},
+        {"i32", CO_fifo_cpyTok2I32, "0xFFFFFFFF", true,
+         {0xFF, 0xFF, 0xFF, 0xFF}},
+        {"i32", CO_fifo_cpyTok2I32, "0x100000000", false, {0}},
+        {"i64", CO_fifo_cpyTok2I64, "0x8000000000000000", true,
+         {0, 0, 0, 0, 0, 0, 0, 0x80}},
+        {"i8", CO_fifo_cpyTok2I8, "-129", false, {0}},
+        {"i32", CO_fifo_cpyTok2I32, "-2147483649", false, {0}},
+        {"i64", CO_fifo_cpyTok2I64, "-9223372036854775809", false, {0}},
+        {"r32", CO_fifo_cpyTok2R32, "1,5", false, {0}},
+        {"r32", CO_fifo_cpyTok2R32, "1.5e", false, {0}},
+        {"r64", CO_fifo_cpyTok2R64, ".", false, {0}},
+        {"r64", CO_fifo_cpyTok2R64, "1.5.0", false, {0}}
+    };
+    bool_t strict =
+        ((CO_CONFIG_FIFO) & CO_CONFIG_FIFO_ASCII_STRICT_RANGE) != 0;
+    uint8_t fifoBuf[40];
+    uint8_t destBuf[10];
+    CO_fifo_t fifo, dest;
+    int errors = 0;
+
+    CO_fifo_init(&fifo, fifoBuf, sizeof(fifoBuf));
+    CO_fifo_init(&dest, destBuf, sizeof(destBuf));
+    for (size_t i = 0; i < sizeof(rejects) / sizeof(rejects[0]); i++) {
+        uint8_t back[8];
+        size_t size;
+        CO_fifo_st st;
+        CO_fifo_reset(&fifo);
+        CO_fifo_reset(&dest);
+        CO_fifo_write(&fifo, (const uint8_t *)rejects[i].text,
+                      strlen(rejects[i].text), NULL);
+        CO_fifo_putc(&fifo, '\n');
+        size = rejects[i].parse(&dest, &fifo, &st);
+        if (rejects[i].wraps && !strict) {
+            if ((st & CO_fifo_st_errMask) != 0
+                || CO_fifo_read(&dest, back, sizeof(back), NULL) != size
+                || memcmp(back, rejects[i].value, size) != 0
+            ) {
+                log_printf("Error: %s didn't wrap '%s'\n", rejects[i].name,
+                           rejects[i].text);
+                errors++;
+            }
+        }
+        else if (size != 0 || (st & CO_fifo_st_errVal) == 0) {
+            log_printf("Error: %s accepted '%s'\n", rejects[i].name,
+                       rejects[i].text);
+            errors++;
+        }
+    }
+    return errors;
+}
+
+int bench_numeric(uint32_t repeat) {
+    static const bench_numType_t types[] = {
+        {"u8", 1, false, false, true, CO_fifo_readU82a, CO_fifo_cpyTok2U8},
+        {"i8", 1, false, false, true, CO_fifo_readI82a, CO_fifo_cpyTok2I8},
+        {"u16", 2, false, false, true, CO_fifo_readU162a, CO_fifo_cpyTok2U16},
+        {"i16", 2, false, false, true, CO_fifo_readI162a, CO_fifo_cpyTok2I16},
+        {"u32", 4, false, false, true, CO_fifo_readU322a, CO_fifo_cpyTok2U32},
+        {"i32", 4, false, false, true, CO_fifo_readI322a, CO_fifo_cpyTok2I32},
+        {"x32", 4, false, false, true, CO_fifo_readX322a, CO_fifo_cpyTok2U32},
+        {"u64", 8, false, false, true, CO_fifo_readU642a, CO_fifo_cpyTok2U64},
+        {"i64", 8, false, false, true, CO_fifo_readI642a, CO_fifo_cpyTok2I64},
+        {"x64", 8, false, false, true, CO_fifo_readX642a, CO_fifo_cpyTok2U64},
+        {"r32", 4, true, false, true, CO_fifo_readR322a,
+         CO_fifo_cpyTok2R32},
+        {"r32_base", 4, true, true, false, baseReadR322a, baseCpyTok2R32},
+        {"r64", 8, true, false, true, CO_fifo_readR642a,
+         CO_fifo_cpyTok2R64},
+        {"r64_base", 8, true, true, false, baseReadR642a, baseCpyTok2R64}
+    };
+    static uint8_t values[NUMERIC_VALUES][8];
+    static char text[NUMERIC_VALUES][32];
+    static size_t textLen[NUMERIC_VALUES];
+    uint8_t fifoBuf[40];
+    uint8_t destBuf[10];
+    CO_fifo_t fifo, dest;
+    uint32_t rep = repeat / 10 + 1;
+    int errors = 0;
+
+    CO_fifo_init(&fifo, fifoBuf, sizeof(fifoBuf));
+    CO_fifo_init(&dest, destBuf, sizeof(destBuf));
+
+    log_printf("\nNumber conversions, %d values\n", NUMERIC_VALUES);
+    log_printf("%-12s %12s %12s %10s %10s %10s\n", "type", "print_ns",
+               "parse_ns", "text_B", "verified", "longer");
+
+    for (size_t t = 0; t < sizeof(types) / sizeof(types[0]); t++) {
+        const bench_numType_t *type = &types[t];
+        uint64_t nsPrint, nsParse, ns0;
+        uint32_t verified = 0;
+        size_t textBytes = 0;
+
+        /* random integers or decimal fractions as typical process values */
+        for (uint32_t i = 0; !type->base && i < NUMERIC_VALUES; i++) {
+            if (type->real) {
+                float64_t f = (float64_t)(rand() % 2000001 - 1000000) / 1000.;
+                if (type->size == 4) {
+                    float32_t f32 = (float32_t)f;
+                    memcpy(values[i], &f32, sizeof(f32));
+                }
+                else {
+                    memcpy(values[i], &f, sizeof(f));
+                }
+            }
+            else {
+                for (size_t b = 0; b < type->size; b++) {
+                    values[i][b] = (uint8_t)rand();
+                }
+            }
+        }
+
+        ns0 = time_ns();
+        for (uint32_t r = 0; r < rep; r++) {
+            for (uint32_t i = 0; i < NUMERIC_VALUES; i++) {
+                CO_fifo_reset(&fifo);
+                CO_fifo_write(&fifo, values[i], type->size, NULL);
+                textLen[i] = type->print(&fifo, text[i], sizeof(text[i]) - 1,
+                                         true);
+            }
+        }
+        nsPrint = time_ns() - ns0;
+
+        ns0 = time_ns();
+        for (uint32_t r = 0; r < rep; r++) {
+            for (uint32_t i = 0; i < NUMERIC_VALUES; i++) {
+                CO_fifo_st st;
+                CO_fifo_reset(&fifo);
+                CO_fifo_reset(&dest);
+                CO_fifo_write(&fifo, (const uint8_t *)text[i], textLen[i],
+                              NULL);
+                CO_fifo_putc(&fifo, '\n');
+                type->parse(&dest, &fifo, &st);
+            }
+        }
+        nsParse = time_ns() - ns0;
+
+        /* verify round trip of all values */
+        for (uint32_t i = 0; i < NUMERIC_VALUES; i++) {
+            uint8_t back[8];
+            CO_fifo_st st;
+            textBytes += textLen[i];
+            if (!type->exact) {
+                continue;
+            }
+            CO_fifo_reset(&fifo);
+            CO_fifo_reset(&dest);
+            CO_fifo_write(&fifo, (const uint8_t *)text[i], textLen[i], NULL);
+            CO_fifo_putc(&fifo, '\n');
+            type->parse(&dest, &fifo, &st);
+            if (CO_fifo_read(&dest, back, sizeof(back), NULL) != type->size
+                || memcmp(back, values[i], type->size) != 0
+            ) {
+                log_printf("Error: %s round trip of '%.*s'\n", type->name,
+                           (int)textLen[i], text[i]);
+                errors++;
+                break;
+            }
+        }
+        numLonger = 0;
+        if (type->exact) {
+            verified = numVerify(type);
+            if (verified == 0) {
+                errors++;
+            }
+        }
+
+        log_printf("%-12s %12.1f %12.1f %10.1f %10u %10u\n", type->name,
+                   (double)nsPrint / rep / NUMERIC_VALUES,
+                   (double)nsParse / rep / NUMERIC_VALUES,
+                   (double)textBytes / NUMERIC_VALUES, (unsigned)verified,
+                   (unsigned)numLonger);
+    }
+
+    int rangeErrors = numVerifyRange();
+    if (rangeErrors == 0) {
+        log_printf("out of range values %s OK\n",
+                   ((CO_CONFIG_FIFO) & CO_CONFIG_FIFO_ASCII_STRICT_RANGE)
+                   ? "rejected" : "rejected or wrapped");
+    }
+    return errors + rangeErrors;
+}
+#endif /* (CO_CONFIG_FIFO) & CO_CONFIG_FIFO_ASCII_DATATYPES */
@@ -0,0 +1,406 @@
+/*
+ * Gateway benchmark on the virtual CAN bus.
+ *
+ * The same SDO transfers as in benchmark_sdo.c are made through the gateway of
+ * the client device, with ascii commands and with binary frames, for
+ * comparison of stream size and processing time. Time of the client device,
+ * which runs the gateway and the SDO client, is measured separately from the
+ * SDO server device. The same transfer is also made directly with the SDO
+ * client, so the framing cost of the gateway is shown without the SDO stack.
+ *
+ * @file        benchmark_gateway.c
+ * @author      J-Weisberg
+ * @copyright   2026 J-Weisberg
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "benchmark.h"
+
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_BINARY
+/* Benchmark of gateway, ascii commands vs. binary frames *********************/
+static char gtwComm[DOMAIN_SIZE_MAX * 2];
+static char gtwResp[DOMAIN_SIZE_MAX * 2];
+static size_t gtwRespCount;
+static size_t gtwRespScan;
+static uint8_t gtwFifoBuf[DOMAIN_SIZE_MAX + 1];
+
+static size_t bench_gtwRead(void *object, const char *buf, size_t count,
+                            uint8_t *connectionOK)
+{
+    (void)object; (void)connectionOK;
+
+    if (count > sizeof(gtwResp) - gtwRespCount) {
+        count = sizeof(gtwResp) - gtwRespCount;
+    }
+    memcpy(&gtwResp[gtwRespCount], buf, count);
+    gtwRespCount += count;
+    return count;
+}
+
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_READV
+static size_t bench_gtwReadv(void *object, const CO_GTWA_iovec_t *iov,
+                             uint8_t iovCount, uint8_t *connectionOK)
+{
+    size_t countRead = 0;
+
+    for (uint8_t i = 0; i < iovCount; i++) {
+        size_t count = bench_gtwRead(object, iov[i].buf, iov[i].count,
+                                     connectionOK);
+        countRead += count;
+        if (count < iov[i].count) {
+            break;
+        }
+    }
+    return countRead;
+}
+#endif
+
+/* Return true, if response in gtwResp is complete */
+static bool_t bench_gtwDone(bool_t binary) {
+    if (!binary) {
+        return gtwRespCount > 0 && gtwResp[gtwRespCount - 1] == '\n';
+    }
+    while (gtwRespScan + CO_GTWA_BIN_HEAD_SIZE <= gtwRespCount) {
+        uint32_t length = CO_SWAP_32(CO_getUint32(&gtwResp[gtwRespScan]));
+
+        if (gtwRespScan + 4 + length > gtwRespCount) {
+            break;
+        }
+        if (gtwResp[gtwRespScan + 8] != CO_GTWA_BIN_RESP_PARTIAL) {
+            return true;
+        }
+        gtwRespScan += 4 + length;
+    }
+    return false;
+}
+
+/* Copy data of binary response frames into dataRx, return size or -1 if
+ * response is not OK */
+static long bench_gtwBinData(void) {
+    size_t offset = 0, size = 0;
+
+    while (offset < gtwRespCount) {
+        uint32_t length = CO_SWAP_32(CO_getUint32(&gtwResp[offset]));
+        uint8_t code = (uint8_t)gtwResp[offset + 8];
+        size_t count = length - (CO_GTWA_BIN_HEAD_SIZE - 4);
+
+        if (code != CO_GTWA_BIN_RESP_OK && code != CO_GTWA_BIN_RESP_PARTIAL) {
+            return -1;
+        }
+        memcpy(&dataRx[size], &gtwResp[offset + CO_GTWA_BIN_HEAD_SIZE], count);
+        size += count;
+        offset += 4 + length;
+    }
+    return (long)size;
+}
+
+/* Write command into gtwComm, return its size */
+static size_t bench_gtwCommand(bool_t binary, bool_t download,
+                               uint16_t index, size_t size, const char *b64)
+{
+    size_t n;
+
+    if (!binary) {
+        const char *type = index == 0x2000 ? "d" : "u32";
+
+        n = (size_t)sprintf(gtwComm, "[1] %d %s 0x%04X 0 %s", NODE_ID_SERVER,
+                            download ? "w" : "r", index, type);
+        if (download && index == 0x2000) {
+            gtwComm[n++] = ' ';
+            memcpy(&gtwComm[n], b64, strlen(b64));
+            n += strlen(b64);
+        }
+        else if (download) {
+            n += (size_t)sprintf(&gtwComm[n], " %lu",
+                                 (unsigned long)CO_getUint32(dataTx));
+        }
+        gtwComm[n++] = '\n';
+        return n;
+    }
+
+    n = CO_GTWA_BIN_HEAD_SIZE;
+    gtwComm[n++] = NODE_ID_SERVER;
+    n += CO_setUint16(&gtwComm[n], CO_SWAP_16(index));
+    gtwComm[n++] = 0;
+    if (download) {
+        memcpy(&gtwComm[n], dataTx, size);
+        n += size;
+    }
+    CO_setUint32(&gtwComm[0], CO_SWAP_32((uint32_t)(n - 4)));
+    CO_setUint32(&gtwComm[4], CO_SWAP_32(1));
+    gtwComm[8] = download ? CO_GTWA_BIN_REQ_WRITE : CO_GTWA_BIN_REQ_READ;
+    return n;
+}
+
+/* Run one transfer through the gateway of the client device. Response is
+ * verified against expected ascii response or against data in OD. Loop ends
+ * with the gateway response, which is also sent on SDO or gateway timeout.
+ * Time of the client device (gateway with SDO client) is added to res->ns and
+ * time of the server device with the virtual bus to stackNs. */
+static int bench_gtwTransfer(CO_t *coCli, CO_t *coSrv, bool_t binary,
+                             bool_t download, uint16_t index, size_t size,
+                             const char *b64, bench_result_t *res,
+                             uint64_t *stackNs, uint64_t *streamBytes)
+{
+    size_t commSize = bench_gtwCommand(binary, download, index, size, b64);
+    size_t commOffset = 0;
+    uint32_t cyc = 0;
+    bool_t done;
+
+    gtwRespCount = 0;
+    gtwRespScan = 0;
+    do {
+        uint64_t ns0 = time_ns();
+        commOffset += CO_GTWA_write(coCli->gtwa, &gtwComm[commOffset],
+                                    commSize - commOffset);
+        CO_process(coCli, true, CYCLE_US, NULL);
+        uint64_t ns1 = time_ns();
+        CO_vbus_deliver();
+        CO_process(coSrv, false, CYCLE_US, NULL);
+        CO_vbus_deliver();
+        *stackNs += time_ns() - ns1;
+        res->ns += ns1 - ns0;
+        done = bench_gtwDone(binary);
+        cyc++;
+    } while (!done);
+
+    res->frames += cyc;
+    *streamBytes += commSize + gtwRespCount;
+
+    /* verify response */
+    const uint8_t *dataOD = index == 0x2000 ? domain : (uint8_t *)&testU32;
+    bool_t ok = done;
+    if (ok && download) {
+        ok = memcmp(dataTx, dataOD, size) == 0
+             && (binary ? bench_gtwBinData() == 0
+                        : strncmp(gtwResp, "[1] OK\r\n", gtwRespCount) == 0);
+    }
+    else if (ok && binary) {
+        ok = bench_gtwBinData() == (long)size
+             && memcmp(dataRx, dataOD, size) == 0;
+    }
+    else if (ok) {
+        char expect[32];
+        const char *value = b64;
+
+        if (index != 0x2000) {
+            sprintf(expect, "%lu", (unsigned long)testU32);
+            value = expect;
+        }
+        ok = gtwRespCount == strlen(value) + 6
+             && strncmp(&gtwResp[4], value, strlen(value)) == 0;
+    }
+    if (!ok) {
+        log_printf("Error: gateway %s %s 0x%04X, size %lu: %.*s\n",
+                   binary ? "binary" : "ascii",
+                   download ? "download" : "upload", index,
+                   (unsigned long)size,
+                   (int)(gtwRespCount > 40 ? 40 : gtwRespCount), gtwResp);
+        return 1;
+    }
+    return 0;
+}
+
+/* Run the same transfer directly with the second SDO client of the client
+ * device, without the gateway, as a reference for bench_gtwTransfer(). SDO
+ * client of the gateway is not used, because the idle gateway releases it. */
+static int bench_gtwSdo(CO_t *coCli, CO_t *coSrv, bool_t download,
+                        uint16_t index, size_t size, bench_result_t *res,
+                        uint64_t *stackNs)
+{
+    CO_SDOclient_t *SDO_C = &coCli->SDOclient[1];
+    CO_SDO_abortCode_t abortCode = CO_SDO_AB_NONE;
+    CO_SDO_return_t ret;
+    size_t offset = 0;
+    uint32_t cyc = 0;
+    uint64_t ns0 = time_ns();
+
+    CO_SDOclient_setup(SDO_C, CO_CAN_ID_SDO_CLI + NODE_ID_SERVER,
+                       CO_CAN_ID_SDO_SRV + NODE_ID_SERVER, NODE_ID_SERVER);
+    if (download) {
+        ret = CO_SDOclientDownloadInitiate(SDO_C, index, 0, size,
+                                           SDO_TIMEOUT_MS,
+                                           coCli->gtwa->SDOblockTransferEnable);
+    }
+    else {
+        ret = CO_SDOclientUploadInitiate(SDO_C, index, 0, SDO_TIMEOUT_MS,
+                                         coCli->gtwa->SDOblockTransferEnable);
+    }
+
+    while (ret == CO_SDO_RT_ok_communicationEnd || ret > 0) {
+        uint64_t ns1;
+        if (download) {
+            offset += CO_SDOclientDownloadBufWrite(SDO_C, &dataTx[offset],
+                                                   size - offset);
+            ret = CO_SDOclientDownload(SDO_C, CYCLE_US, false, offset < size,
+                                       &abortCode, NULL, NULL);
+        }
+        else {
+            ret = CO_SDOclientUpload(SDO_C, CYCLE_US, false,
+                                     &abortCode, NULL, NULL, NULL);
+            if (ret != CO_SDO_RT_blockUploadInProgress) {
+                offset += CO_SDOclientUploadBufRead(SDO_C, &dataRx[offset],
+                                                    sizeof(dataRx) - offset);
+            }
+        }
+        CO_process(coCli, true, CYCLE_US, NULL);
+        ns1 = time_ns();
+        res->ns += ns1 - ns0;
+        CO_vbus_deliver();
+        CO_process(coSrv, false, CYCLE_US, NULL);
+        CO_vbus_deliver();
+        ns0 = time_ns();
+        *stackNs += ns0 - ns1;
+        cyc++;
+        if (ret <= 0) {
+            break;
+        }
+    }
+    res->frames += cyc;
+
+    const uint8_t *dataOD = index == 0x2000 ? domain : (uint8_t *)&testU32;
+    if (ret < 0 || offset != size
+        || memcmp(download ? dataTx : dataRx, dataOD, size) != 0
+    ) {
+        log_printf("Error: SDO %s 0x%04X without gateway, size %lu\n",
+                   download ? "download" : "upload", index,
+                   (unsigned long)size);
+        return 1;
+    }
+    return 0;
+}
+
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_READV
+#define GTW_MODES 4
+#else
+#define GTW_MODES 3
+#endif
+
+int bench_gateway(uint32_t repeat) {
+    static const size_t sizes[] = {4, 64, 889, 4096};
+    static const char *modeNames[] = {"sdo", "asc", "bin", "binv"};
+    static char b64[DOMAIN_SIZE_MAX * 2];
+    bench_OD_t *odSrv = calloc(1, sizeof(bench_OD_t));
+    bench_OD_t *odCli = calloc(1, sizeof(bench_OD_t));
+    int errors = 0;
+
+    if (odSrv == NULL || odCli == NULL) {
+        log_printf("Error: Can't allocate memory\n");
+        return 1;
+    }
+
+    CO_vbus_reset();
+    bench_OD_init(odSrv, 1);
+    bench_OD_init(odCli, 1);
+    odCli->config.CNT_GTWA = 1;
+    odCli->config.CNT_LSS_MST = 1;
+    bench_OD_sdoClients(odCli, 2);
+    CO_t *coSrv = bench_device(odSrv, NODE_ID_SERVER);
+    CO_t *coCli = bench_device(odCli, NODE_ID_CLIENT);
+    CO_GTWA_initRead(coCli->gtwa, bench_gtwRead, NULL);
+    CO_process(coSrv, false, CYCLE_US, NULL);
+    CO_process(coCli, false, CYCLE_US, NULL);
+    CO_vbus_deliver();
+
+    log_printf("\nGateway, ascii commands vs. binary frames, client with "
+               "gateway and SDO server processed separately\n");
+    log_printf("%-12s %8s %10s %8s %12s %12s %12s %14s\n", "transfer", "size",
+               "stream_B", "cycles", "client_us", "server_us", "framing_us",
+               "framing_B/s");
+
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        uint16_t index = sizes[s] == 4 ? 0x2001 : 0x2000;
+        uint32_t rep = (repeat * 64) / (sizes[s] + 64) + 1;
+        CO_fifo_t fifo;
+
+        /* data as base64 string for ascii commands */
+        CO_fifo_init(&fifo, gtwFifoBuf, sizes[s] + 1);
+        CO_fifo_reset(&fifo);
+        CO_fifo_write(&fifo, dataTx, sizes[s], NULL);
+        b64[CO_fifo_readB642a(&fifo, b64, sizeof(b64) - 1, true)] = 0;
+        domainVar.dataLength = (OD_size_t)sizes[s];
+
+        /* SDO client without gateway as reference for the framing cost,
+         * ascii, binary and binary with vectored read of the response */
+        uint64_t sdoNs[2] = {0, 0};
+        for (int mode = 0; mode < GTW_MODES; mode++) {
+            bool_t binary = mode > 1;
+
+            CO_GTWA_setBinary(coCli->gtwa, binary);
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_READV
+            if (mode == 3) {
+                CO_GTWA_initReadv(coCli->gtwa, bench_gtwReadv, NULL);
+            }
+            else {
+                CO_GTWA_initRead(coCli->gtwa, bench_gtwRead, NULL);
+            }
+#endif
+            for (int dl = 1; dl >= 0; dl--) {
+                bench_result_t res = {0};
+                uint64_t stackNs = 0;
+                uint64_t streamBytes = 0;
+                char name[20];
+
+                for (uint32_t r = 0; r < rep; r++) {
+                    if (mode == 0
+                        ? bench_gtwSdo(coCli, coSrv, dl, index, sizes[s],
+                                       &res, &stackNs)
+                        : bench_gtwTransfer(coCli, coSrv, binary, dl, index,
+                                            sizes[s], b64, &res, &stackNs,
+                                            &streamBytes)
+                    ) {
+                        errors++;
+                        break;
+                    }
+                }
+                sprintf(name, "%s_%s", modeNames[mode], dl ? "dl" : "ul");
+                log_printf("%-12s %8lu %10.1f %8.1f %12.3f %12.3f",
+                           name, (unsigned long)sizes[s],
+                           (double)streamBytes / rep,
+                           (double)res.frames / rep,
+                           (double)res.ns / 1000.0 / rep,
+                           (double)stackNs / 1000.0 / rep);
+                if (mode == 0) {
+                    sdoNs[dl] = res.ns;
+                    log_printf(" %12s %14s\n", "-", "-");
+                }
+                else {
+                    /* below measurement noise, if not positive */
+                    double framingNs = (double)res.ns - (double)sdoNs[dl];
+                    log_printf(" %12.3f", framingNs / 1000.0 / rep);
+                    if (framingNs > 0) {
+                        log_printf(" %14.0f\n", (double)sizes[s] * rep
+                                                * 1000000000.0 / framingNs);
+                    }
+                    else {
+                        log_printf(" %14s\n", "-");
+                    }
+                }
+            }
+        }
+    }
+    domainVar.dataLength = DOMAIN_SIZE_MAX;
+
+    CO_delete(coCli);
+    CO_delete(coSrv);
+    free(odCli);
+    free(odSrv);
+    return errors;
+}
+#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_BINARY */
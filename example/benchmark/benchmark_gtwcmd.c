@@ -0,0 +1,841 @@
+/*
+ * Verification of the gateway commands on the virtual CAN bus.
+ *
+ * Client device with the gateway and some server devices are connected on the
+ * virtual bus. Non-standard gateway commands are executed and their responses
+ * are compared with the expected ones.
+ *
+ * @file        benchmark_gtwcmd.c
+ * @author      J-Weisberg
+ * @copyright   2026 J-Weisberg
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "benchmark.h"
+
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII
+/* Devices and responses of the gateway sessions ******************************/
+#define GC_SRV_COUNT 3
+#define GC_RESP_SIZE 4096
+#define GC_WAIT_MAX_US 3000000
+#define GC_HB_PRODUCER_MS 10
+#define GC_HB_CONSUMER_MS 25
+
+/* Node-IDs of the server devices. NODE_ID_SERVER is the first one. */
+static const uint8_t gcSrvIds[GC_SRV_COUNT] = {NODE_ID_SERVER, 5, 100};
+
+typedef struct {
+    char buf[GC_RESP_SIZE + 1];
+    size_t count;
+    /* if throttle is true, only 'lines' more writes are accepted */
+    bool_t throttle;
+    uint32_t lines;
+} gc_resp_t;
+
+static bench_OD_t *gcOD;
+static CO_t *gcCli;
+static CO_t *gcSrv[GC_SRV_COUNT];
+static OD_PERSIST_COMM_t gcPersist;
+
+static size_t gc_read(void *object, const char *buf, size_t count,
+                      uint8_t *connectionOK)
+{
+    gc_resp_t *resp = (gc_resp_t *)object;
+    (void)connectionOK;
+
+    if (resp->throttle) {
+        if (resp->lines == 0) {
+            return 0;
+        }
+        resp->lines--;
+    }
+    if (count > GC_RESP_SIZE - resp->count) {
+        count = GC_RESP_SIZE - resp->count;
+    }
+    memcpy(&resp->buf[resp->count], buf, count);
+    resp->count += count;
+    resp->buf[resp->count] = 0;
+    return count;
+}
+
+/* Prepare object dictionaries of client (gcOD[0]) and servers. Heartbeat
+ * producers and identities are configured in common OD_PERSIST_COMM, client
+ * monitors heartbeats of all servers. Configuration of the client may be
+ * modified before gc_create(). */
+static bench_OD_t *gc_init(void) {
+    gcOD = calloc(GC_SRV_COUNT + 1, sizeof(bench_OD_t));
+    if (gcOD == NULL) {
+        log_printf("Error: Can't allocate memory\n");
+        exit(EXIT_FAILURE);
+    }
+    gcPersist = OD_PERSIST_COMM;
+    OD_PERSIST_COMM.x1017_producerHeartbeatTime = GC_HB_PRODUCER_MS;
+    for (int i = 0; i < GC_SRV_COUNT; i++) {
+        OD_PERSIST_COMM.x1016_consumerHeartbeatTime[i] =
+            ((uint32_t)gcSrvIds[i] << 16) | GC_HB_CONSUMER_MS;
+    }
+    OD_PERSIST_COMM.x1018_identity.vendor_ID = 0x12345678;
+    OD_PERSIST_COMM.x1018_identity.productCode = 2;
+    OD_PERSIST_COMM.x1018_identity.revisionNumber = 3;
+    OD_PERSIST_COMM.x1018_identity.serialNumber = 0x9ABCDEF0;
+
+    for (int i = 0; i <= GC_SRV_COUNT; i++) {
+        bench_OD_init(&gcOD[i], 1);
+    }
+    CO_config_t *config = &gcOD[0].config;
+    config->CNT_GTWA = 1;
+    config->CNT_LSS_MST = 1;
+    config->CNT_NODE_SCAN = 1;
+    config->CNT_HB_CONS = 1;
+    config->CNT_ARR_1016 = OD_CNT_ARR_1016;
+    config->ENTRY_H1016 = OD_find(&gcOD[0].od, 0x1016);
+    return &gcOD[0];
+}
+
+/* Create devices and connect read callbacks of the sessions to resp[] */
+static void gc_create(gc_resp_t *resp) {
+    CO_vbus_reset();
+    gcCli = bench_device(&gcOD[0], NODE_ID_CLIENT);
+    for (int i = 0; i < GC_SRV_COUNT; i++) {
+        gcSrv[i] = bench_device(&gcOD[i + 1], gcSrvIds[i]);
+    }
+    for (uint8_t i = 0; i < gcOD[0].config.CNT_GTWA; i++) {
+        CO_GTWA_initRead(&gcCli->gtwa[i], gc_read, &resp[i]);
+    }
+    CO_vbus_deliver();
+}
+
+static void gc_end(void) {
+    CO_delete(gcCli);
+    for (int i = 0; i < GC_SRV_COUNT; i++) {
+        CO_delete(gcSrv[i]);
+    }
+    free(gcOD);
+    OD_PERSIST_COMM = gcPersist;
+}
+
+static void gc_cycle(void) {
+    CO_process(gcCli, true, CYCLE_US, NULL);
+#if (CO_CONFIG_PDO) & CO_CONFIG_RPDO_ENABLE
+    CO_process_RPDO(gcCli, false, CYCLE_US, NULL);
+#endif
+    CO_vbus_deliver();
+    for (int i = 0; i < GC_SRV_COUNT; i++) {
+        CO_process(gcSrv[i], false, CYCLE_US, NULL);
+#if (CO_CONFIG_PDO) & CO_CONFIG_TPDO_ENABLE
+        CO_process_TPDO(gcSrv[i], false, CYCLE_US, NULL);
+#endif
+    }
+    CO_vbus_deliver();
+}
+
+static void gc_run(uint32_t time_us) {
+    for (uint32_t t = 0; t < time_us; t += CYCLE_US) {
+        gc_cycle();
+    }
+}
+
+static void gc_clear(gc_resp_t *resp) {
+    resp->count = 0;
+    resp->buf[0] = 0;
+}
+
+/* Clear response and write command into the gateway session */
+static void gc_cmd(CO_GTWA_t *gtwa, gc_resp_t *resp, const char *cmd) {
+    gc_clear(resp);
+    CO_GTWA_write(gtwa, cmd, strlen(cmd));
+}
+
+/* Number of occurrences of the string str in the response */
+static uint32_t gc_count(const gc_resp_t *resp, const char *str) {
+    const char *c = resp->buf;
+    uint32_t n = 0;
+
+    while ((c = strstr(c, str)) != NULL) {
+        c += strlen(str);
+        n++;
+    }
+    return n;
+}
+
+/* Process devices until response contains the string end */
+static bool_t gc_wait(gc_resp_t *resp, const char *end) {
+    for (uint32_t t = 0; t < GC_WAIT_MAX_US; t += CYCLE_US) {
+        if (strstr(resp->buf, end) != NULL) {
+            return true;
+        }
+        gc_cycle();
+    }
+    return strstr(resp->buf, end) != NULL;
+}
+
+/* Process devices until all count responses contain "\r\n". Cycle number of
+ * the completion of each response is stored into done[]. */
+static bool_t gc_waitAll(gc_resp_t *resp, uint8_t count, uint32_t *done) {
+    uint8_t remain = count;
+    uint8_t i;
+
+    for (i = 0; i < count; i++) {
+        done[i] = 0;
+    }
+    for (uint32_t c = 1; c <= GC_WAIT_MAX_US / CYCLE_US && remain > 0; c++) {
+        gc_cycle();
+        for (i = 0; i < count; i++) {
+            if (done[i] == 0 && strstr(resp[i].buf, "\r\n") != NULL) {
+                done[i] = c;
+                remain--;
+            }
+        }
+    }
+    return remain == 0;
+}
+
+/* Compare the response with the expected one */
+static int gc_expect(gc_resp_t *resp, const char *expect, const char *name) {
+    if (strcmp(resp->buf, expect) != 0) {
+        log_printf("Error: gateway %s, response:\n%s\nexpected:\n%s\n",
+                   name, resp->buf, expect);
+        return 1;
+    }
+    return 0;
+}
+
+
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SCAN
+/* 'scan' prints identity and NMT state of all present nodes ******************/
+static int gc_scan(void) {
+    static gc_resp_t resp[1];
+    char expect[512];
+    size_t n = 0;
+    int errors = 0;
+
+    gc_init();
+    gc_create(resp);
+    /* NMT state of the servers is known from their heartbeats */
+    gc_run(GC_HB_PRODUCER_MS * 3000);
+
+    gc_cmd(gcCli->gtwa, resp, "[1] scan 50\n");
+    gc_wait(resp, "\r\n");
+    for (uint8_t id = CO_NODE_SCAN_NODE_MIN; id <= CO_NODE_SCAN_NODE_MAX;
+         id++) {
+        for (int i = 0; i < GC_SRV_COUNT; i++) {
+            if (gcSrvIds[i] == id) {
+                n += (size_t)sprintf(&expect[n], "# %d operational 0x12345678 "
+                                     "0x00000002 0x00000003 0x9ABCDEF0\n", id);
+            }
+        }
+    }
+    sprintf(&expect[n], "# Found %d nodes.\n[1] OK\r\n", GC_SRV_COUNT);
+    errors += gc_expect(resp, expect, "scan");
+
+    /* stopped node does not respond to SDO, it is found by its heartbeat */
+    CO_NMT_sendCommand(gcCli->NMT, CO_NMT_ENTER_STOPPED, gcSrvIds[2]);
+    gc_run(GC_HB_PRODUCER_MS * 3000);
+    gc_cmd(gcCli->gtwa, resp, "[2] scan\n");
+    gc_wait(resp, "\r\n");
+    sprintf(expect, "# %d operational 0x12345678 0x00000002 0x00000003 "
+            "0x9ABCDEF0\n# %d operational 0x12345678 0x00000002 0x00000003 "
+            "0x9ABCDEF0\n# %d stopped - - - -\n# Found %d nodes.\n[2] OK\r\n",
+            gcSrvIds[1], gcSrvIds[0], gcSrvIds[2], GC_SRV_COUNT);
+    errors += gc_expect(resp, expect, "scan, stopped node");
+
+    gc_cmd(gcCli->gtwa, resp, "[3] scan 0\n");
+    gc_wait(resp, "\r\n");
+    errors += gc_expect(resp, "[3] ERROR:101\r\n", "scan, timeout 0");
+
+    gc_end();
+    return errors;
+}
+#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SCAN */
+
+
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_HB_STAT
+/* 'hbstat' prints statistics of heartbeat intervals **************************/
+#define GC_HB_RUN_US 1000000
+
+/* Print expected 'hbstat' line of the monitored node, return its length */
+static size_t gc_hbstatLine(char *buf, const CO_HBconsNode_t *node) {
+    const CO_HBconsStat_t *stat = &node->stat;
+    size_t n = (size_t)sprintf(buf, "# %d %lu %lu %lu %lu %d", node->nodeId,
+                               (unsigned long)stat->count,
+                               (unsigned long)stat->intervalMin_us,
+                               (unsigned long)stat->intervalAvg_us,
+                               (unsigned long)stat->intervalMax_us,
+                               stat->late);
+    for (uint8_t i = 0; i < CO_HBCONS_STAT_BINS; i++) {
+        n += (size_t)sprintf(&buf[n], " %d", stat->histogram[i]);
+    }
+    buf[n++] = '\n';
+    buf[n] = 0;
+    return n;
+}
+
+static int gc_hbstat(void) {
+    static gc_resp_t resp[1];
+    char expect[512];
+    size_t n = 0;
+    int errors = 0;
+
+    gc_init();
+    gc_create(resp);
+    gc_run(GC_HB_RUN_US);
+
+    gc_cmd(gcCli->gtwa, resp, "[1] hbstat\n");
+    gc_wait(resp, "\r\n");
+    for (int i = 0; i < GC_SRV_COUNT; i++) {
+        const CO_HBconsNode_t *node = &gcCli->HBcons->monitoredNodes[i];
+        const CO_HBconsStat_t *stat = &node->stat;
+        uint32_t count = GC_HB_RUN_US / 1000 / GC_HB_PRODUCER_MS;
+        /* interval is 0.4 of the consumer time */
+        int bin = GC_HB_PRODUCER_MS * CO_HBCONS_STAT_BINS / GC_HB_CONSUMER_MS;
+
+        n += gc_hbstatLine(&expect[n], node);
+        if (stat->count + 2 < count || stat->count > count
+            || stat->intervalMin_us < GC_HB_PRODUCER_MS * 1000 - CYCLE_US
+            || stat->intervalMax_us > GC_HB_PRODUCER_MS * 1000 + CYCLE_US
+            || stat->late != 0 || stat->histogram[bin] != stat->count
+        ) {
+            log_printf("Error: gateway hbstat, node %d statistics\n",
+                       node->nodeId);
+            errors++;
+        }
+    }
+    sprintf(&expect[n], "[1] OK\r\n");
+    errors += gc_expect(resp, expect, "hbstat");
+
+    /* statistics of one node */
+    gc_run(GC_HB_RUN_US / 10);
+    gc_cmd(gcCli->gtwa, resp, "[2] hbstat 5\n");
+    gc_wait(resp, "\r\n");
+    n = gc_hbstatLine(expect, &gcCli->HBcons->monitoredNodes[1]);
+    sprintf(&expect[n], "[2] OK\r\n");
+    errors += gc_expect(resp, expect, "hbstat 5");
+
+    /* node, which is not monitored, and invalid node */
+    gc_cmd(gcCli->gtwa, resp, "[3] hbstat 6\n");
+    gc_wait(resp, "\r\n");
+    errors += gc_expect(resp, "[3] OK\r\n", "hbstat 6");
+    gc_cmd(gcCli->gtwa, resp, "[4] hbstat 128\n");
+    gc_wait(resp, "\r\n");
+    errors += gc_expect(resp, "[4] ERROR:101\r\n", "hbstat 128");
+
+    gc_end();
+    return errors;
+}
+#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_HB_STAT */
+
+
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO_BATCH
+/* 'rm' and 'wm' print results of all objects in one line *********************/
+static int gc_batch(void) {
+    static gc_resp_t resp[1];
+    char expect[128];
+    int errors = 0;
+
+    gc_init();
+    gc_create(resp);
+    testU32 = 0x12345678;
+
+    /* values, SDO aborts and different data types */
+    gc_cmd(gcCli->gtwa, resp, "[1] 32 rm 0x2001 0 u32 0x1018 9 u32 "
+                              "0x1018 1 x32 0x2002 0 u8 0x1018 2 u32\n");
+    gc_wait(resp, "\r\n");
+    errors += gc_expect(resp, "[1] 305419896 ERROR:0x06090011 0x12345678 "
+                        "ERROR:0x06020000 2\r\n", "rm");
+
+    /* failed object does not stop the batch */
+    gc_cmd(gcCli->gtwa, resp, "[2] 5 wm 0x2001 0 u32 7 0x1018 1 u32 5 "
+                              "0x2001 0 u32 9\n");
+    gc_wait(resp, "\r\n");
+    errors += gc_expect(resp, "[2] OK ERROR:0x06010002 OK\r\n", "wm");
+    if (testU32 != 9) {
+        log_printf("Error: gateway wm, value %lu\n", (unsigned long)testU32);
+        errors++;
+    }
+
+    /* syntax error ends the batch, the rest of the command is ignored */
+    gc_cmd(gcCli->gtwa, resp, "[3] 32 wm 0x2001 0 u32 11 0x2001 zz u32 12 "
+                              "0x2001 0 u32 13\n");
+    gc_wait(resp, "\r\n");
+    errors += gc_expect(resp, "[3] OK ERROR:101\r\n", "wm, syntax error");
+    gc_cmd(gcCli->gtwa, resp, "[4] 32 rm 0x2001 0 u32 0x2001 0 abc "
+                              "0x2001 0 u32\n");
+    gc_wait(resp, "\r\n");
+    errors += gc_expect(resp, "[4] 11 ERROR:101\r\n", "rm, syntax error");
+    gc_cmd(gcCli->gtwa, resp, "[5] 32 wm 0x2001 0 u32 xyz\n");
+    gc_wait(resp, "\r\n");
+    errors += gc_expect(resp, "[5] ERROR:101\r\n", "wm, first object");
+    gc_cmd(gcCli->gtwa, resp, "[6] 32 r 0x2001 0 u32\n");
+    gc_wait(resp, "\r\n");
+    errors += gc_expect(resp, "[6] 11\r\n", "r, after batch");
+
+    /* own object dictionary, accessed by local transfers */
+    gc_cmd(gcCli->gtwa, resp, "[7] 1 wm 0x2001 0 u32 21 0x1018 1 u32 0 "
+                              "0x2001 0 u32 22\n"
+                              "[8] 1 rm 0x1018 2 u32 0x1018 7 u32 "
+                              "0x2001 0 x32\n");
+    gc_wait(resp, "0x00000016\r\n");
+    sprintf(expect, "[7] OK ERROR:0x%08X OK\r\n"
+            "[8] 2 ERROR:0x06090011 0x00000016\r\n",
+            (unsigned)CO_SDO_AB_READONLY);
+    errors += gc_expect(resp, expect, "wm, rm, local node");
+
+    gc_end();
+    return errors;
+}
+#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO_BATCH */
+
+
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SUBSCRIBE
+/* 'subscribe' prints changed values between the responses ********************/
+#define GC_SUB_INTERVAL_MS 10
+#define GC_SUB_CHANGES_MS 50
+
+/* Variable mapped to TPDO of the server and RPDO of the client */
+static uint32_t gcPdoU32;
+static OD_obj_var_t gcPdoVar = {&gcPdoU32, ODA_SDO_RW | ODA_TRPDO | ODA_MB, 4};
+
+static void gc_addPdoVar(bench_OD_t *bod) {
+    bod->list[bod->od.size++] = (OD_entry_t){0x2100, 1, ODT_VAR, &gcPdoVar,
+                                             NULL};
+}
+
+/* Variable with counted reads, sampled by the subscription */
+static uint32_t gcSampledU32, gcSampledReads;
+static OD_obj_var_t gcSampledVar = {&gcSampledU32, ODA_SDO_RW | ODA_MB, 4};
+
+static ODR_t gc_readSampled(OD_stream_t *stream, void *buf, OD_size_t count,
+                            OD_size_t *countRead)
+{
+    gcSampledReads++;
+    return OD_readOriginal(stream, buf, count, countRead);
+}
+
+static OD_extension_t gcSampledExt = {.read = gc_readSampled,
+                                      .write = OD_writeOriginal};
+
+static void gc_addSampledVar(bench_OD_t *bod) {
+    bod->list[bod->od.size++] = (OD_entry_t){0x2101, 1, ODT_VAR,
+                                             &gcSampledVar, &gcSampledExt};
+}
+
+static int gc_subscribe(void) {
+    static gc_resp_t resp[1];
+    char expect[128];
+    uint32_t lines = 0, last = 0;
+    uint32_t c;
+    int errors = 0;
+
+    /* RPDO 1 of the client receives TPDO 1 of the server NODE_ID_SERVER */
+    bench_OD_t *od = gc_init();
+    bench_OD_t *odSrv = &gcOD[1];
+    gc_addPdoVar(od);
+    gc_addPdoVar(odSrv);
+    gc_addSampledVar(od);
+    od->config.CNT_RPDO = 1;
+    od->config.ENTRY_H1400 = OD_find(&od->od, 0x1400);
+    od->config.ENTRY_H1600 = OD_find(&od->od, 0x1600);
+    odSrv->config.CNT_TPDO = 1;
+    odSrv->config.ENTRY_H1800 = OD_find(&odSrv->od, 0x1800);
+    odSrv->config.ENTRY_H1A00 = OD_find(&odSrv->od, 0x1A00);
+    OD_PERSIST_COMM.x1400_RPDOCommunicationParameter.COB_IDUsedByRPDO =
+        CO_CAN_ID_TPDO_1 + NODE_ID_SERVER;
+    OD_PERSIST_COMM.x1600_RPDOMappingParameter
+        .numberOfMappedApplicationObjectsInPDO = 1;
+    OD_PERSIST_COMM.x1600_RPDOMappingParameter.applicationObject_1 =
+        0x21000020;
+    OD_PERSIST_COMM.x1800_TPDOCommunicationParameter.COB_IDUsedByTPDO =
+        CO_CAN_ID_TPDO_1;
+    OD_PERSIST_COMM.x1A00_TPDOMappingParameter
+        .numberOfMappedApplicationObjectsInPDO = 1;
+    OD_PERSIST_COMM.x1A00_TPDOMappingParameter.applicationObject_1 =
+        0x21000020;
+    gc_create(resp);
+
+    /* current value is printed after OK, then each change */
+    testU32 = 5;
+    gc_cmd(gcCli->gtwa, resp, "[1] subscribe od 0x2001 0 u32\n");
+    gc_wait(resp, "[1] 5\r\n");
+    testU32 = 6;
+    gc_wait(resp, "[1] 6\r\n");
+    gc_run(CYCLE_US * 10);
+    errors += gc_expect(resp, "[1] OK\r\n[1] 5\r\n[1] 6\r\n",
+                        "subscribe od");
+    gc_cmd(gcCli->gtwa, resp, "[2] unsubscribe 1\n");
+    gc_wait(resp, "\r\n");
+    testU32 = 7;
+    gc_run(CYCLE_US * 10);
+    errors += gc_expect(resp, "[2] OK\r\n", "unsubscribe");
+
+    /* Value changes in each cycle, lines are printed in intervals, the last
+     * one after changes stop. */
+    gc_cmd(gcCli->gtwa, resp, "[3] subscribe od 0x2001 0 u32 10\n");
+    gc_wait(resp, "[3] 7\r\n");
+    gc_clear(resp);
+    for (c = 1; c <= (GC_SUB_CHANGES_MS + GC_SUB_INTERVAL_MS) * 1000
+                     / CYCLE_US; c++) {
+        if (c <= GC_SUB_CHANGES_MS * 1000 / CYCLE_US) {
+            testU32 = 1000 + c;
+        }
+        gc_cycle();
+        if (gc_count(resp, "\r\n") > lines) {
+            if (lines > 0 && c - last < GC_SUB_INTERVAL_MS * 1000 / CYCLE_US) {
+                log_printf("Error: gateway subscribe, interval %lu us\n",
+                           (unsigned long)(c - last) * CYCLE_US);
+                errors++;
+            }
+            lines++;
+            last = c;
+        }
+    }
+    sprintf(expect, "[3] %lu\r\n", (unsigned long)testU32);
+    if (lines != GC_SUB_CHANGES_MS / GC_SUB_INTERVAL_MS
+        || strstr(resp->buf, expect) == NULL
+    ) {
+        log_printf("Error: gateway subscribe, %lu lines, last value %lu:\n"
+                   "%s\n", (unsigned long)lines, (unsigned long)testU32,
+                   resp->buf);
+        errors++;
+    }
+
+    /* Output accepts one line per cycle, two subscriptions of the always
+     * changing value are printed in turn. */
+    gc_cmd(gcCli->gtwa, resp, "[4] unsubscribe\n"
+                              "[5] subscribe od 0x2001 0 u32\n"
+                              "[6] subscribe od 0x2001 0 x32\n");
+    gc_wait(resp, "[6] OK\r\n");
+    gc_run(CYCLE_US * 10);
+    gc_clear(resp);
+    resp->throttle = true;
+    for (c = 0; c < 100; c++) {
+        testU32 = 2000 + c;
+        resp->lines = 1;
+        gc_cycle();
+    }
+    resp->throttle = false;
+    gc_run(CYCLE_US * 10);
+    uint32_t n5 = gc_count(resp, "[5] "), n6 = gc_count(resp, "[6] ");
+    if (n5 + n6 < 100 || n5 > n6 + 1 || n6 > n5 + 1) {
+        log_printf("Error: gateway subscribe, round-robin %lu, %lu lines\n",
+                   (unsigned long)n5, (unsigned long)n6);
+        errors++;
+    }
+
+    /* PDO data are printed as hex bytes */
+    gc_cmd(gcCli->gtwa, resp, "[7] unsubscribe\n"
+                              "[8] subscribe rpdo 1\n"
+                              "[9] subscribe rpdo 1\n"
+                              "[10] subscribe rpdo 2\n");
+    gc_wait(resp, "[10] ERROR:100\r\n");
+    gcPdoU32 = 0x11223344;
+    CO_TPDOsendRequest(&gcSrv[0]->TPDO[0]);
+    gc_wait(resp, "[8] 44");
+    gc_run(CYCLE_US * 10);
+    errors += gc_expect(resp, "[7] OK\r\n[8] OK\r\n[9] ERROR:400\r\n"
+                        "[10] ERROR:100\r\n[8] 44 33 22 11\r\n",
+                        "subscribe rpdo");
+
+    /* Unchanged OD variable is sampled once per interval, not in each cycle */
+    gcSampledU32 = 9;
+    gc_cmd(gcCli->gtwa, resp, "[11] unsubscribe\n"
+                              "[12] subscribe od 0x2101 0 u32 10\n");
+    gc_wait(resp, "[12] 9\r\n");
+    gc_clear(resp);
+    gcSampledReads = 0;
+    gc_run(GC_SUB_CHANGES_MS * 1000);
+    if (gcSampledReads > GC_SUB_CHANGES_MS / GC_SUB_INTERVAL_MS + 1) {
+        log_printf("Error: gateway subscribe, %lu reads in %d ms\n",
+                   (unsigned long)gcSampledReads, GC_SUB_CHANGES_MS);
+        errors++;
+    }
+    gcSampledU32 = 10;
+    gc_run(GC_SUB_INTERVAL_MS * 1000 + CYCLE_US * 10);
+    errors += gc_expect(resp, "[12] 10\r\n", "subscribe od sampled");
+
+    gc_end();
+    return errors;
+}
+#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SUBSCRIBE */
+
+
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SLOTS
+/* Reads in slots run concurrently, absent node doesn't block others **********/
+#define GC_SLOTS 3
+#define GC_SLOTS_LIVE_MAX_US 20000
+
+static int gc_slots(void) {
+    static gc_resp_t resp[1];
+    char expect[128];
+    uint32_t t;
+    int errors = 0;
+
+    bench_OD_t *od = gc_init();
+    bench_OD_sdoClients(od, 1 + GC_SLOTS);
+    gc_create(resp);
+    if (gcCli->gtwa->slotsCount != GC_SLOTS) {
+        log_printf("Error: gateway slots not initialized\n");
+        gc_end();
+        return 1;
+    }
+    testU32 = 0x12345678;
+
+    /* node 7 is absent, node 32 is accessed twice */
+    gc_cmd(gcCli->gtwa, resp, "[1] 7 r 0x1017 0 u16\n"
+                              "[2] 32 r 0x2001 0 u32\n"
+                              "[3] 5 r 0x1018 1 x32\n"
+                              "[4] 32 r 0x1018 4 x32\n");
+    for (t = 0; t < GC_WAIT_MAX_US; t += CYCLE_US) {
+        if (strstr(resp->buf, "[4]") != NULL) {
+            break;
+        }
+        gc_cycle();
+    }
+    if (t > GC_SLOTS_LIVE_MAX_US) {
+        log_printf("Error: gateway slots, live nodes waited %lu us\n",
+                   (unsigned long)t);
+        errors++;
+    }
+    gc_wait(resp, "\r\n[1] ERROR:0x05040000\r\n");
+    sprintf(expect, "[2] %lu\r\n[3] 0x12345678\r\n[4] 0x9ABCDEF0\r\n"
+            "[1] ERROR:0x05040000\r\n", (unsigned long)testU32);
+    errors += gc_expect(resp, expect, "slots");
+
+    /* Write runs in the slot. Commands for the absent node 7 and for the
+     * busy node 5 wait, following commands for other nodes pass them. Other
+     * command keeps its order, it is executed after [6] is started. */
+    bool_t slotWrite = false;
+    gc_cmd(gcCli->gtwa, resp, "[5] 7 r 0x1017 0 u16\n"
+                              "[6] 7 w 0x1017 0 u16 100\n"
+                              "[7] 5 w 0x2001 0 u32 85\n"
+                              "[8] 5 r 0x2001 0 u32\n"
+                              "[9] 32 r 0x1018 4 x32\n"
+                              "[10] set sdo_timeout 500\n");
+    for (t = 0; t < GC_WAIT_MAX_US; t += CYCLE_US) {
+        for (uint8_t i = 0; i < gcCli->gtwa->slotsCount; i++) {
+            CO_GTWA_slot_t *slot = &gcCli->gtwa->slots[i];
+            if (slot->node == 5 && slot->download) {
+                slotWrite = true;
+            }
+        }
+        if (strstr(resp->buf, "[8]") != NULL
+            && strstr(resp->buf, "[9]") != NULL
+        ) {
+            break;
+        }
+        gc_cycle();
+    }
+    if (t > GC_SLOTS_LIVE_MAX_US || !slotWrite) {
+        log_printf("Error: gateway slots, write in slot %d, live nodes "
+                   "waited %lu us\n", slotWrite, (unsigned long)t);
+        errors++;
+    }
+    gc_wait(resp, "[6] ERROR");
+    gc_run(CYCLE_US * 10);
+    if (strstr(resp->buf, "[7] OK\r\n") == NULL
+        || strstr(resp->buf, "[8] 85\r\n") == NULL
+        || strstr(resp->buf, "[9] 0x9ABCDEF0\r\n") == NULL
+        || strstr(resp->buf, "[5] ERROR:0x05040000\r\n[10] OK\r\n"
+                             "[6] ERROR:0x05040000\r\n") == NULL
+        || strstr(resp->buf, "[8]") > strstr(resp->buf, "[5]")
+    ) {
+        log_printf("Error: gateway slots, waiting commands:\n%s\n",
+                   resp->buf);
+        errors++;
+    }
+
+    /* own object dictionary, accessed by local transfers in the slot */
+    gc_cmd(gcCli->gtwa, resp, "[11] 1 w 0x2001 0 u32 33\n"
+                              "[12] 1 r 0x2001 0 u32\n");
+    gc_wait(resp, "[12] 33\r\n");
+    errors += gc_expect(resp, "[11] OK\r\n[12] 33\r\n", "slots, local node");
+
+    gc_end();
+    return errors;
+}
+#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SLOTS */
+
+
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SESSIONS
+/* Two sessions share the nodes and the LSS master ****************************/
+#define GC_DOMAIN_SIZE 1024
+#define GC_LSS_HOLD_US 100000
+
+static int gc_sessions(void) {
+    static gc_resp_t resp[2];
+    static char expectDomain[GC_DOMAIN_SIZE * 2];
+    static uint8_t fifoBuf[GC_DOMAIN_SIZE + 1];
+    CO_GTWA_sessions_t *sessions;
+    CO_GTWA_t *gtwaA, *gtwaB;
+    CO_fifo_t fifo;
+    uint32_t done[2];
+    char expect[64];
+    size_t n;
+    int errors = 0;
+
+    bench_OD_t *od = gc_init();
+    bench_OD_sdoClients(od, 2);
+    od->config.CNT_GTWA = 2;
+    gc_create(resp);
+    gtwaA = &gcCli->gtwa[0];
+    gtwaB = &gcCli->gtwa[1];
+    sessions = gtwaA->sessions;
+
+    /* domain on the server and its expected response */
+    for (n = 0; n < GC_DOMAIN_SIZE; n++) {
+        domain[n] = (uint8_t)(n * 7);
+    }
+    domainVar.dataLength = GC_DOMAIN_SIZE;
+    CO_fifo_init(&fifo, fifoBuf, sizeof(fifoBuf));
+    CO_fifo_reset(&fifo);
+    CO_fifo_write(&fifo, domain, GC_DOMAIN_SIZE, NULL);
+    n = (size_t)sprintf(expectDomain, "[1] ");
+    n += CO_fifo_readB642a(&fifo, &expectDomain[n], sizeof(expectDomain) - n,
+                           true);
+    sprintf(&expectDomain[n], "\r\n");
+    testU32 = 0x12345678;
+    sprintf(expect, "[2] %lu\r\n", (unsigned long)testU32);
+
+    /* A reads domain from node 32, B reads other node concurrently */
+    gc_cmd(gtwaA, &resp[0], "[1] 32 r 0x2000 0 d\n");
+    gc_cmd(gtwaB, &resp[1], "[2] 5 r 0x2001 0 u32\n");
+    gc_waitAll(resp, 2, done);
+    errors += gc_expect(&resp[0], expectDomain, "session A, other node");
+    errors += gc_expect(&resp[1], expect, "session B, other node");
+    if (done[1] >= done[0]) {
+        log_printf("Error: gateway session B waited for other node\n");
+        errors++;
+    }
+
+    /* domain from own object dictionary is larger than the SDO buffer */
+    gc_cmd(gtwaA, &resp[0], "[1] 1 r 0x2000 0 d\n");
+    gc_wait(&resp[0], "\r\n");
+    errors += gc_expect(&resp[0], expectDomain, "session A, local node");
+
+    /* B waits, while node 32 is held by A */
+    gc_cmd(gtwaA, &resp[0], "[1] 32 r 0x2000 0 d\n");
+    gc_cmd(gtwaB, &resp[1], "[2] 32 r 0x2001 0 u32\n");
+    gc_waitAll(resp, 2, done);
+    errors += gc_expect(&resp[0], expectDomain, "session A, same node");
+    errors += gc_expect(&resp[1], expect, "session B, same node");
+    if (done[1] <= done[0]) {
+        log_printf("Error: gateway session B didn't wait for node\n");
+        errors++;
+    }
+
+    /* A is reset during transfer, B then gets the node */
+    gc_cmd(gtwaA, &resp[0], "[1] 32 r 0x2000 0 d\n");
+    gc_cmd(gtwaB, &resp[1], "[2] 32 r 0x2001 0 u32\n");
+    gc_run(CYCLE_US * 4);
+    CO_GTWA_sessionReset(gtwaA);
+    gc_wait(&resp[1], "\r\n");
+    errors += gc_expect(&resp[1], expect, "session B after reset of A");
+    if (resp[0].count != 0 && strstr(resp[0].buf, "\r\n") != NULL) {
+        log_printf("Error: gateway session A responded after reset\n");
+        errors++;
+    }
+
+    /* A holds the LSS master between commands, until it unlocks it */
+    CO_GTWA_initRead(gtwaA, gc_read, &resp[0]);
+    gc_cmd(gtwaA, &resp[0], "[3] lss_switch_glob 1\n");
+    gc_wait(&resp[0], "\r\n");
+    errors += gc_expect(&resp[0], "[3] OK\r\n", "session A, LSS select");
+    gc_cmd(gtwaB, &resp[1], "[4] lss_switch_glob 0\n");
+    gc_run(GC_LSS_HOLD_US);
+    if (resp[1].count != 0 || sessions->lssOwner != gtwaA) {
+        log_printf("Error: gateway sessions, LSS master not held by A\n");
+        errors++;
+    }
+    gc_cmd(gtwaA, &resp[0], "[5] _lss_unlock\n");
+    gc_wait(&resp[1], "\r\n");
+    errors += gc_expect(&resp[0], "[5] OK\r\n", "session A, LSS unlock");
+    errors += gc_expect(&resp[1], "[4] OK\r\n", "session B, LSS unlocked");
+    if (sessions->lssOwner != NULL) {
+        log_printf("Error: gateway sessions, LSS master not released\n");
+        errors++;
+    }
+
+    /* A holds the LSS master, B waits until A is reset */
+    CO_GTWA_initRead(gtwaA, gc_read, &resp[0]);
+    gc_cmd(gtwaA, &resp[0], "[3] _lss_fastscan 1000\n");
+    gc_cmd(gtwaB, &resp[1], "[4] lss_switch_glob 0\n");
+    gc_run(GC_LSS_HOLD_US);
+    if (resp[0].count != 0 || resp[1].count != 0
+        || sessions->lssOwner != gtwaA
+    ) {
+        log_printf("Error: gateway sessions, LSS master not held by A\n");
+        errors++;
+    }
+    CO_GTWA_sessionReset(gtwaA);
+    gc_wait(&resp[1], "\r\n");
+    errors += gc_expect(&resp[1], "[4] OK\r\n", "session B, LSS");
+    gc_run(CYCLE_US * 2);
+    if (resp[0].count != 0 || sessions->lssOwner != NULL) {
+        log_printf("Error: gateway sessions, LSS master not released\n");
+        errors++;
+    }
+
+    /* A is usable again after reset, default node is cleared */
+    CO_GTWA_initRead(gtwaA, gc_read, &resp[0]);
+    gc_cmd(gtwaA, &resp[0], "[5] r 0x2001 0 u32\n");
+    gc_wait(&resp[0], "\r\n");
+    errors += gc_expect(&resp[0], "[5] ERROR:105\r\n", "session A, no node");
+    gc_cmd(gtwaA, &resp[0], "[6] 32 r 0x2001 0 u32\n");
+    gc_wait(&resp[0], "\r\n");
+    sprintf(expect, "[6] %lu\r\n", (unsigned long)testU32);
+    errors += gc_expect(&resp[0], expect, "session A after reset");
+
+    domainVar.dataLength = DOMAIN_SIZE_MAX;
+    gc_end();
+    return errors;
+}
+#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SESSIONS */
+
+
+/* Print result of the check */
+static int gc_report(const char *name, int errors) {
+    log_printf("%-12s %s\n", name, errors == 0 ? "OK" : "FAILED");
+    return errors;
+}
+
+int bench_gtwcmd(void) {
+    int errors = 0;
+
+    log_printf("\nGateway commands\n");
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SCAN
+    errors += gc_report("scan", gc_scan());
+#endif
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_HB_STAT
+    errors += gc_report("hbstat", gc_hbstat());
+#endif
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SDO_BATCH
+    errors += gc_report("batch", gc_batch());
+#endif
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SUBSCRIBE
+    errors += gc_report("subscribe", gc_subscribe());
+#endif
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SLOTS
+    errors += gc_report("slots", gc_slots());
+#endif
+#if (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII_SESSIONS
+    errors += gc_report("sessions", gc_sessions());
+#endif
+
+    return errors;
+}
+#endif /* (CO_CONFIG_GTW) & CO_CONFIG_GTW_ASCII */
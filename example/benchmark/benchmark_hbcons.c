@@ -0,0 +1,281 @@
+/*
+ * Benchmark of the Heartbeat consumer with many monitored nodes.
+ *
+ * Processing time per cycle is measured with and without
+ * CO_CONFIG_HB_CONS_NODE_INDEXED, as well as queries of the network state
+ * tracker. Timeout of the node and statistics of Heartbeat intervals are
+ * verified.
+ *
+ * @file        benchmark_hbcons.c
+ * @author      J-Weisberg
+ * @copyright   2026 J-Weisberg
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "benchmark.h"
+
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_ENABLE
+/* Heartbeat consumer with many monitored nodes *******************************/
+#define HB_NODES_MAX 127
+#define HB_PERIOD_CYCLES 100
+#define HB_CONSUMER_MS 25
+#define HB_CYCLES 20000
+
+static CO_CANrx_t hbRx[HB_NODES_MAX];
+static CO_CANtx_t hbTx[1];
+static CO_CANrx_t hbProdRx[1];
+static CO_CANtx_t hbProdTx[1];
+static CO_HBconsNode_t hbNodes[HB_NODES_MAX];
+static uint32_t hbTime[HB_NODES_MAX];
+static uint8_t hbTimeMaxSub;
+
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_STATE_TRACKER
+#define HB_QUERIES 100000
+static uint32_t hbNotifications;
+
+static void bench_hbStateChanged(const CO_HBconsSnapshot_t *snapshot,
+                                 void *object) {
+    (void)snapshot; (void)object;
+    hbNotifications++;
+}
+
+/* Time "all nodes operational" query, per node and with state tracker */
+static void bench_hbQuery(CO_HBconsumer_t *HBcons, uint8_t count,
+                          double *nsNodes, double *nsBitmap) {
+    CO_HBconsBitmap_t group = {{0}};
+    volatile uint32_t sink = 0;
+    uint64_t ns0;
+
+    for (uint8_t i = 0; i < count; i++) {
+        CO_HBconsumer_bitmapSet(&group, i + 1);
+    }
+
+    ns0 = time_ns();
+    for (uint32_t q = 0; q < HB_QUERIES; q++) {
+        bool_t all = true;
+        for (uint8_t i = 0; i < count; i++) {
+            CO_NMT_internalState_t state;
+            if (CO_HBconsumer_getNmtState(HBcons, i, &state) != 0
+                || state != CO_NMT_OPERATIONAL
+            ) {
+                all = false;
+                break;
+            }
+        }
+        sink += all;
+    }
+    *nsNodes = (double)(time_ns() - ns0) / HB_QUERIES;
+
+    /* volatile pointers, so query is not moved out of the loop */
+    CO_HBconsumer_t *volatile HBconsQ = HBcons;
+    CO_HBconsBitmap_t *volatile groupQ = &group;
+    ns0 = time_ns();
+    for (uint32_t q = 0; q < HB_QUERIES; q++) {
+        sink += CO_HBconsumer_allInState(HBconsQ, groupQ,
+                                         CO_HBCONS_TRACK_OPERATIONAL);
+    }
+    *nsBitmap = (double)(time_ns() - ns0) / HB_QUERIES;
+    (void)sink;
+}
+#endif
+
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_STATISTICS
+static uint8_t hbStatMaxSub;
+static uint8_t hbStatData[HB_NODES_MAX][CO_HBCONS_STAT_OD_SIZE];
+
+/* Verify statistics of the last monitored node, also read through OD */
+static int bench_hbStat(CO_HBconsumer_t *HBcons, uint8_t count) {
+    OD_obj_array_t statArr = {&hbStatMaxSub, hbStatData, ODA_SDO_R, ODA_SDO_R,
+                              CO_HBCONS_STAT_OD_SIZE, CO_HBCONS_STAT_OD_SIZE};
+    OD_entry_t entry = {0x2110, count + 1, ODT_ARR, &statArr, NULL};
+    const CO_HBconsStat_t *stat = &HBcons->monitoredNodes[count - 1].stat;
+    uint32_t period_us = HB_PERIOD_CYCLES * CYCLE_US;
+    uint8_t buf[CO_HBCONS_STAT_OD_SIZE];
+    OD_size_t countRd = 0;
+    uint8_t bin = (uint8_t)(period_us * CO_HBCONS_STAT_BINS
+                            / (HB_CONSUMER_MS * 1000));
+    OD_IO_t io;
+
+    hbStatMaxSub = count;
+    if (CO_HBconsumer_initStatistics(HBcons, &entry, NULL) != CO_ERROR_NO
+        || OD_getSub(&entry, count, &io, false) != ODR_OK
+        || io.read(&io.stream, buf, sizeof(buf), &countRd) != ODR_OK
+        || countRd != CO_HBCONS_STAT_OD_SIZE
+    ) {
+        log_printf("Error: Heartbeat statistics, OD read\n");
+        return 1;
+    }
+
+    /* all Heartbeats come exactly in time */
+    if (stat->count != HB_CYCLES / HB_PERIOD_CYCLES - 1
+        || stat->intervalMin_us != period_us
+        || stat->intervalAvg_us != period_us
+        || stat->intervalMax_us != period_us
+        || stat->late != 0
+        || stat->histogram[bin] != stat->count
+        || CO_getUint32(&buf[0]) != stat->count
+        || CO_getUint32(&buf[8]) != period_us
+        || CO_getUint16(&buf[18 + 2 * bin]) != stat->count
+    ) {
+        log_printf("Error: Heartbeat statistics, %u nodes\n", count);
+        return 1;
+    }
+    return 0;
+}
+#endif
+
+/* Send Heartbeat of each producer, whose turn is in this cycle */
+static void bench_hbSend(CO_CANmodule_t *CANprod, uint8_t count, uint32_t cyc) {
+    for (uint8_t i = 0; i < count; i++) {
+        if ((cyc + i) % HB_PERIOD_CYCLES == 0) {
+            CO_CANtx_t *tx = CO_CANtxBufferInit(CANprod, 0,
+                                                CO_CAN_ID_HEARTBEAT + i + 1,
+                                                false, 1, false);
+            tx->data[0] = CO_NMT_OPERATIONAL;
+            CO_CANsend(CANprod, tx);
+        }
+    }
+}
+
+int bench_hbcons(void) {
+    static const uint8_t counts[] = {8, 32, 127};
+    bench_OD_t *od = calloc(1, sizeof(bench_OD_t));
+    OD_obj_array_t hbArr = {&hbTimeMaxSub, hbTime, ODA_SDO_R,
+                            ODA_SDO_RW | ODA_MB, 4, sizeof(uint32_t)};
+    int errors = 0;
+
+    if (od == NULL) {
+        log_printf("Error: Can't allocate memory\n");
+        return 1;
+    }
+
+    log_printf("\nHeartbeat consumer with HB_CONS_NODE_INDEXED=%d, "
+               "producer time %u ms\n",
+               (CO_CONFIG_HB_CONS & CO_CONFIG_HB_CONS_NODE_INDEXED) != 0,
+               HB_PERIOD_CYCLES * CYCLE_US / 1000);
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_STATE_TRACKER
+    log_printf("%-12s %10s %14s %14s %14s\n", "monitored", "rx_buffers",
+               "ns/cycle", "query_nodes_ns", "query_map_ns");
+#else
+    log_printf("%-12s %10s %14s\n", "monitored", "rx_buffers", "ns/cycle");
+#endif
+
+    for (size_t c = 0; c < sizeof(counts) / sizeof(counts[0]); c++) {
+        uint8_t count = counts[c];
+        OD_entry_t entry = {0x1016, count + 1, ODT_ARR, &hbArr, NULL};
+        CO_CANmodule_t CANcons, CANprod;
+        CO_HBconsumer_t HBcons;
+        uint32_t errInfo = 0;
+        uint64_t ns = 0;
+        uint32_t cyc;
+
+        CO_vbus_reset();
+        bench_OD_init(od, 1);
+        CO_t *co = bench_device(od, NODE_ID_CLIENT);
+        hbTimeMaxSub = count;
+        for (uint8_t i = 0; i < count; i++) {
+            hbTime[i] = ((uint32_t)(i + 1) << 16) | HB_CONSUMER_MS;
+        }
+        CO_CANmodule_init(&CANcons, NULL, hbRx, count, hbTx, 1, 1000);
+        CO_CANmodule_init(&CANprod, NULL, hbProdRx, 1, hbProdTx, 1, 1000);
+        if (CO_HBconsumer_init(&HBcons, co->em, hbNodes, count, &entry,
+                               &CANcons, 0, &errInfo) != CO_ERROR_NO
+        ) {
+            log_printf("Error: Heartbeat consumer init, 0x%X\n", errInfo);
+            errors++;
+            CO_delete(co);
+            continue;
+        }
+        CO_CANsetNormalMode(&CANcons);
+        CO_CANsetNormalMode(&CANprod);
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_STATE_TRACKER
+        CO_HBconsumer_initCallbackStateChanged(&HBcons, NULL,
+                                               bench_hbStateChanged);
+        hbNotifications = 0;
+#endif
+        CO_HBconsumer_process(&HBcons, true, 0, NULL);
+
+        /* all nodes send Heartbeats */
+        for (cyc = 0; cyc < HB_CYCLES; cyc++) {
+            bench_hbSend(&CANprod, count, cyc);
+            uint64_t ns0 = time_ns();
+            CO_vbus_deliver();
+            CO_HBconsumer_process(&HBcons, true, CYCLE_US, NULL);
+            ns += time_ns() - ns0;
+        }
+        if (!HBcons.allMonitoredActive || !HBcons.allMonitoredOperational
+            || CO_HBconsumer_getIdxByNodeId(&HBcons, count) != count - 1
+        ) {
+            log_printf("Error: Heartbeat consumer, %u nodes not active\n",
+                       count);
+            errors++;
+        }
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_STATISTICS
+        errors += bench_hbStat(&HBcons, count);
+#endif
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_STATE_TRACKER
+        double nsNodes, nsBitmap;
+        bench_hbQuery(&HBcons, count, &nsNodes, &nsBitmap);
+        uint32_t notifications = hbNotifications;
+#endif
+
+        /* the last node stops, it must time out */
+        for (cyc = 0; cyc < HB_CONSUMER_MS * 2000 / CYCLE_US; cyc++) {
+            bench_hbSend(&CANprod, count - 1, cyc);
+            CO_vbus_deliver();
+            CO_HBconsumer_process(&HBcons, true, CYCLE_US, NULL);
+        }
+        if (HBcons.allMonitoredActive
+            || CO_HBconsumer_getState(&HBcons, count - 1)
+               != CO_HBconsumer_TIMEOUT
+            || CO_HBconsumer_getState(&HBcons, 0) != CO_HBconsumer_ACTIVE
+        ) {
+            log_printf("Error: Heartbeat consumer, %u nodes timeout\n",
+                       count);
+            errors++;
+        }
+#if (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_STATE_TRACKER
+        /* timeout of the last node is one notification */
+        if (hbNotifications != notifications + 1
+            || !CO_HBconsumer_bitmapTest(&HBcons.tracker.changed, count)
+            || !CO_HBconsumer_bitmapTest(
+                   &HBcons.tracker.state[CO_HBCONS_TRACK_TIMEOUT], count)
+            || CO_HBconsumer_bitmapTest(
+                   &HBcons.tracker.state[CO_HBCONS_TRACK_OPERATIONAL], count)
+        ) {
+            log_printf("Error: Heartbeat consumer, %u nodes tracker\n",
+                       count);
+            errors++;
+        }
+
+        log_printf("%-12u %10u %14.1f %14.1f %14.1f\n", count,
+                   (CO_CONFIG_HB_CONS & CO_CONFIG_HB_CONS_NODE_INDEXED) != 0
+                   ? 1U : count, (double)ns / HB_CYCLES, nsNodes, nsBitmap);
+#else
+        log_printf("%-12u %10u %14.1f\n", count,
+                   (CO_CONFIG_HB_CONS & CO_CONFIG_HB_CONS_NODE_INDEXED) != 0
+                   ? 1U : count, (double)ns / HB_CYCLES);
+#endif
+        CO_delete(co);
+    }
+
+    free(od);
+    return errors;
+}
+#endif /* (CO_CONFIG_HB_CONS) & CO_CONFIG_HB_CONS_ENABLE */
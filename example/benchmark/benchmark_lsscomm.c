@@ -0,0 +1,363 @@
+/*
+ * Benchmark of the LSS batch commissioning.
+ *
+ * Node-IDs are assigned to 100 simulated LSS slaves by list or by fastscan,
+ * with or without CO_CONFIG_LSS_MASTER_FASTSCAN_ADAPTIVE.
+ *
+ * @file        benchmark_lsscomm.c
+ * @author      J-Weisberg
+ * @copyright   2026 J-Weisberg
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "benchmark.h"
+#include "305/CO_LSScommission.h"
+
+#if (CO_CONFIG_LSS_COMM) & CO_CONFIG_LSS_COMM_ENABLE
+/* LSS commissioning of many unconfigured nodes *******************************/
+#define LSS_NODES 100
+#define LSS_NODES_FIXED 4
+#define LSS_ABSENT 2
+#define LSS_MUTE_EVERY 30
+#define LSS_SLOW_NODES 8
+#define LSS_SLOW_CYCLES 5
+#define LSS_SLOW_TIMEOUT_MS 10
+#define LSS_TIMEOUT_MIN_MS 1
+#define LSS_TIMEOUT_MAX_MS 100
+#define LSS_TIME_MAX_US 100000000
+
+/* Simulated unconfigured node, each on own CAN module */
+typedef struct {
+    CO_CANmodule_t CANmodule;
+    CO_CANrx_t rx[1];
+    CO_CANtx_t tx[1];
+    CO_LSSslave_t LSSslave;
+    CO_LSS_address_t address;
+    uint16_t pendingBitRate;
+    uint8_t pendingNodeId;
+    uint8_t storedNodeId;
+    /* node answers fastscan, but not the configuration of node-ID */
+    bool_t mute;
+    /* node answers each request after so many cycles */
+    uint8_t delay;
+    uint8_t delayed;
+} bench_lssSlave_t;
+
+static bool_t bench_lssStore(void *object, uint8_t id, uint16_t bitRate) {
+    bench_lssSlave_t *slave = object;
+    (void)bitRate;
+    slave->storedNodeId = id;
+    return true;
+}
+
+static void bench_lssAddress(CO_LSS_address_t *address, uint16_t i) {
+    address->identity.vendorID = 0x12345678;
+    address->identity.productCode = 0x1000U + i % 3U;
+    address->identity.revisionNumber = 0x00010000U + i % 2U;
+    /* unique serial numbers without pattern */
+    address->identity.serialNumber = (i + 1U) * 2654435761U;
+}
+
+static void bench_lssSlaves(bench_lssSlave_t *slaves, uint16_t count) {
+    for (uint16_t i = 0; i < count; i++) {
+        bench_lssSlave_t *s = &slaves[i];
+
+        memset(s, 0, sizeof(*s));
+        bench_lssAddress(&s->address, i);
+        s->pendingNodeId = CO_LSS_NODE_ID_ASSIGNMENT;
+        s->storedNodeId = CO_LSS_NODE_ID_ASSIGNMENT;
+        CO_CANmodule_init(&s->CANmodule, NULL, s->rx, 1, s->tx, 1, 1000);
+        CO_LSSslave_init(&s->LSSslave, &s->address, &s->pendingBitRate,
+                         &s->pendingNodeId, &s->CANmodule, 0,
+                         CO_CAN_ID_LSS_MST, &s->CANmodule, 0,
+                         CO_CAN_ID_LSS_SLV);
+        CO_LSSslave_initCfgStoreCallback(&s->LSSslave, s, bench_lssStore);
+        CO_CANsetNormalMode(&s->CANmodule);
+    }
+}
+
+static void bench_lssSlavesProcess(bench_lssSlave_t *slaves, uint16_t count) {
+    for (uint16_t i = 0; i < count; i++) {
+        CO_LSSslave_t *LSSslave = &slaves[i].LSSslave;
+
+        if (slaves[i].mute && CO_FLAG_READ(LSSslave->sendResponse)
+            && LSSslave->service == CO_LSS_CFG_NODE_ID
+        ) {
+            /* drop the request */
+            CO_FLAG_CLEAR(LSSslave->sendResponse);
+        }
+        if (slaves[i].delay > 0 && CO_FLAG_READ(LSSslave->sendResponse)
+            && slaves[i].delayed++ < slaves[i].delay
+        ) {
+            continue;
+        }
+        slaves[i].delayed = 0;
+        CO_LSSslave_process(LSSslave);
+    }
+}
+
+/* Each slave must have unique stored node-ID, the same as in the table. Mute
+ * slave must stay unconfigured and be reported. */
+static int bench_lssVerify(const CO_LSScomm_t *comm,
+                           const bench_lssSlave_t *slaves, uint16_t count)
+{
+    uint32_t used[4] = {0};
+    int errors = 0;
+
+    for (uint16_t i = 0; i < count; i++) {
+        const bench_lssSlave_t *s = &slaves[i];
+        uint8_t id = s->storedNodeId;
+        bool_t found = false;
+
+        for (uint8_t j = 0; j < comm->nodesCount; j++) {
+            const CO_LSScomm_node_t *node = &comm->nodes[j];
+            if (CO_LSS_ADDRESS_EQUAL(node->address, s->address)) {
+                found = s->mute
+                        ? node->result == CO_LSScomm_NODE_TIMEOUT
+                        : (node->nodeId == id
+                           && node->result == CO_LSScomm_NODE_DONE);
+            }
+        }
+        if (s->mute) {
+            if (!found || s->pendingNodeId != CO_LSS_NODE_ID_ASSIGNMENT) {
+                errors++;
+            }
+        }
+        else if (!found || id != s->pendingNodeId || !CO_LSS_NODE_ID_VALID(id)
+            || id == CO_LSS_NODE_ID_ASSIGNMENT
+            || (used[id >> 5] & (1UL << (id & 0x1F))) != 0
+        ) {
+            errors++;
+        }
+        else {
+            used[id >> 5] |= 1UL << (id & 0x1F);
+        }
+    }
+    return errors;
+}
+
+/* Fastscan, node-ID and deselect for one node after another, as "lss_allnodes"
+ * in gateway does. Every other node responds late, so the response time,
+ * measured on the fast nodes, is too short for them. Fastscan must not fail,
+ * gateway does not repeat it. */
+static int bench_lssSlow(bench_lssSlave_t *slaves) {
+    CO_CANrx_t mstRx[1];
+    CO_CANtx_t mstTx[1];
+    CO_CANmodule_t CANmst;
+    CO_LSSmaster_t LSSmaster;
+    CO_LSSmaster_fastscan_t fastscan;
+    CO_LSSmaster_return_t ret = CO_LSSmaster_WAIT_SLAVE;
+    uint32_t timeDifference_us = 0;
+    uint32_t time_us = 0;
+    uint8_t step = 0;
+    uint8_t nodeId = 1;
+    uint8_t done = 0;
+
+    CO_vbus_reset();
+    bench_lssSlaves(slaves, LSS_SLOW_NODES);
+    for (uint16_t i = 1; i < LSS_SLOW_NODES; i += 2) {
+        slaves[i].delay = LSS_SLOW_CYCLES;
+    }
+    CO_CANmodule_init(&CANmst, NULL, mstRx, 1, mstTx, 1, 1000);
+    CO_LSSmaster_init(&LSSmaster, LSS_SLOW_TIMEOUT_MS, &CANmst, 0,
+                      CO_CAN_ID_LSS_SLV, &CANmst, 0, CO_CAN_ID_LSS_MST);
+    CO_CANsetNormalMode(&CANmst);
+    memset(&fastscan, 0, sizeof(fastscan));
+
+    while (time_us < LSS_TIME_MAX_US) {
+        if (step == 0) {
+            ret = CO_LSSmaster_IdentifyFastscan(&LSSmaster, timeDifference_us,
+                                                &fastscan);
+            if (ret == CO_LSSmaster_SCAN_FINISHED) {
+                step = 1;
+                timeDifference_us = 0;
+            }
+        }
+        else if (step == 1) {
+            ret = CO_LSSmaster_configureNodeId(&LSSmaster, timeDifference_us,
+                                               nodeId);
+            if (ret == CO_LSSmaster_OK) {
+                CO_LSSmaster_switchStateDeselect(&LSSmaster);
+                nodeId++;
+                step = 0;
+                timeDifference_us = 0;
+            }
+        }
+        if (ret != CO_LSSmaster_WAIT_SLAVE && ret != CO_LSSmaster_OK
+            && ret != CO_LSSmaster_SCAN_FINISHED
+        ) {
+            break;
+        }
+        timeDifference_us = CYCLE_US;
+        CO_vbus_deliver();
+        bench_lssSlavesProcess(slaves, LSS_SLOW_NODES);
+        CO_vbus_deliver();
+        time_us += CYCLE_US;
+    }
+
+    for (uint16_t i = 0; i < LSS_SLOW_NODES; i++) {
+        if (slaves[i].pendingNodeId != CO_LSS_NODE_ID_ASSIGNMENT) {
+            done++;
+        }
+    }
+    log_printf("%-12s %6u %6u %8s %10.1f %10.2f\n", "slow", LSS_SLOW_NODES,
+               done, "-", (double)time_us / 1000.0,
+               (double)time_us / 1000.0 / LSS_SLOW_NODES);
+#if (CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER_FASTSCAN_ADAPTIVE
+    log_printf("  fastscan: %u scans, %u restarts, response %u us\n",
+               LSSmaster.fsStat.scans, LSSmaster.fsStat.restarts,
+               LSSmaster.fsResponse_us);
+#endif
+
+    /* end of scan, each node has its node-ID */
+    if (ret != CO_LSSmaster_SCAN_NOACK || done != LSS_SLOW_NODES
+        || nodeId != LSS_SLOW_NODES + 1
+    ) {
+        log_printf("Error: LSS slow %d, %u done\n", ret, done);
+        return 1;
+    }
+    return 0;
+}
+
+int bench_lsscomm(void) {
+    bench_lssSlave_t *slaves = calloc(LSS_NODES, sizeof(bench_lssSlave_t));
+    CO_LSScomm_t *comm = calloc(1, sizeof(CO_LSScomm_t));
+    CO_CANrx_t mstRx[1];
+    CO_CANtx_t mstTx[1];
+    int errors = 0;
+
+    if (slaves == NULL || comm == NULL) {
+        log_printf("Error: Can't allocate memory\n");
+        return 1;
+    }
+
+    log_printf("\nLSS commissioning of unconfigured nodes, timeout %u to %u ms"
+               "\n", LSS_TIMEOUT_MIN_MS, LSS_TIMEOUT_MAX_MS);
+    log_printf("%-12s %6s %6s %8s %10s %10s %8s %8s %10s\n", "method",
+               "nodes", "done", "frames", "bus_ms", "ms/node", "timeouts",
+               "rtt_us", "cpu_ms");
+
+    /* list: all LSS addresses are known,
+     * fastscan: nothing is known,
+     * mixed: some listed with fixed node-ID and some absent, rest fastscan,
+     * fixed: fastscan with constant timeout as "lss_allnodes" in gateway,
+     * mute: fastscan, some nodes do not confirm node-ID and are skipped */
+    for (int method = 0; method < 5; method++) {
+        static const char *names[] = {"list", "fastscan", "mixed", "fixed",
+                                      "mute"};
+        uint16_t count = method == 3 ? LSS_NODES_FIXED : LSS_NODES;
+        uint8_t expect = (uint8_t)count;
+        uint8_t mute = 0;
+        CO_CANmodule_t CANmst;
+        CO_LSSmaster_t LSSmaster;
+        CO_LSScomm_return_t ret = CO_LSScomm_BUSY;
+        uint8_t flags = CO_LSS_COMM_FLAG_STORE;
+        uint16_t timeoutMin = LSS_TIMEOUT_MIN_MS;
+        uint32_t time_us = 0;
+        uint32_t frames0;
+        uint64_t ns = 0;
+
+        CO_vbus_reset();
+        bench_lssSlaves(slaves, count);
+        if (method == 4) {
+            for (uint16_t i = 0; i < count; i += LSS_MUTE_EVERY) {
+                slaves[i].mute = true;
+                mute++;
+            }
+            expect -= mute;
+        }
+        CO_CANmodule_init(&CANmst, NULL, mstRx, 1, mstTx, 1, 1000);
+        CO_LSSmaster_init(&LSSmaster, LSS_TIMEOUT_MAX_MS, &CANmst, 0,
+                          CO_CAN_ID_LSS_SLV, &CANmst, 0, CO_CAN_ID_LSS_MST);
+        CO_CANsetNormalMode(&CANmst);
+        CO_LSScomm_init(comm, &LSSmaster);
+
+        if (method == 0) {
+            for (uint16_t i = 0; i < count; i++) {
+                CO_LSScomm_addNode(comm, &slaves[i].address, 0);
+            }
+        }
+        else if (method == 2) {
+            for (uint16_t i = 0; i < count / 2; i++) {
+                CO_LSScomm_addNode(comm, &slaves[i * 2].address,
+                                   (uint8_t)(127 - i));
+            }
+            for (uint16_t i = 0; i < LSS_ABSENT; i++) {
+                CO_LSS_address_t absent;
+                bench_lssAddress(&absent, LSS_NODES + i);
+                CO_LSScomm_addNode(comm, &absent, 0);
+            }
+        }
+        if (method != 0) {
+            flags |= CO_LSS_COMM_FLAG_FASTSCAN;
+        }
+        if (method == 3) {
+            timeoutMin = LSS_TIMEOUT_MAX_MS;
+        }
+
+        frames0 = CO_vbus_getStat()->frames;
+        CO_LSScomm_start(comm, flags, 1, 127, timeoutMin, LSS_TIMEOUT_MAX_MS,
+                         1);
+        while (ret == CO_LSScomm_BUSY && time_us < LSS_TIME_MAX_US) {
+            uint64_t ns0 = time_ns();
+            ret = CO_LSScomm_process(comm, CYCLE_US, NULL);
+            ns += time_ns() - ns0;
+            CO_vbus_deliver();
+            bench_lssSlavesProcess(slaves, count);
+            CO_vbus_deliver();
+            time_us += CYCLE_US;
+        }
+        uint32_t frames = CO_vbus_getStat()->frames - frames0;
+
+        /* absent listed and mute nodes are reported, all others are
+         * commissioned */
+        int err = bench_lssVerify(comm, slaves, count);
+        if (err > 0 || comm->nodesDone != expect
+            || ret != ((method == 2 || method == 4)
+                       ? CO_LSScomm_ERROR : CO_LSScomm_DONE)
+            || (method == 2
+                && comm->nodes[count / 2].result != CO_LSScomm_NODE_NOT_FOUND)
+        ) {
+            log_printf("Error: LSS %s %d, %u done, %d wrong\n", names[method],
+                       ret, comm->nodesDone, err);
+            errors++;
+        }
+        log_printf("%-12s %6u %6u %8u %10.1f %10.2f %8u %8u %10.2f\n",
+                   names[method], count, comm->nodesDone, frames,
+                   (double)time_us / 1000.0,
+                   (double)time_us / 1000.0 / count, comm->timeouts,
+                   comm->rttMax_us, (double)ns / 1000000.0);
+#if (CO_CONFIG_LSS) & CO_CONFIG_LSS_MASTER_FASTSCAN_ADAPTIVE
+        const CO_LSSmaster_fsStat_t *fs = &LSSmaster.fsStat;
+        if (fs->scans > 0) {
+            log_printf("  fastscan: %u scans, %.1f requests/scan, %u responses,"
+                       " %u parts predicted, %u bits skipped, response %u us"
+                       "\n", fs->scans, (double)fs->requests / fs->scans,
+                       fs->responses, fs->predicted, fs->bitsSkipped,
+                       LSSmaster.fsResponse_us);
+        }
+#endif
+    }
+    errors += bench_lssSlow(slaves);
+
+    free(comm);
+    free(slaves);
+    return errors;
+}
+#endif /* (CO_CONFIG_LSS_COMM) & CO_CONFIG_LSS_COMM_ENABLE */
@@ -0,0 +1,216 @@
+/*
+ * Benchmark of the NMT master startup sequencer.
+ *
+ * Simulated nodes in three dependent groups are configured and started with
+ * per-node NMT commands. One more simulated node is not managed by the
+ * sequencer and must stay in NMT pre-operational state. Without that node the
+ * last wave is started with single command to all nodes. If the node is
+ * monitored, sequencer must fall back to per-node commands.
+ *
+ * @file        benchmark_nmtseq.c
+ * @author      J-Weisberg
+ * @copyright   2026 J-Weisberg
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "benchmark.h"
+#include "301/CO_NMTsequencer.h"
+
+#if (CO_CONFIG_NMT_SEQ) & CO_CONFIG_NMT_SEQ_ENABLE
+/* NMT startup of simulated nodes in three dependent groups *******************/
+#define SEQ_NODES 60
+/* Node-IDs of the last nodes in the first and in the second group */
+#define SEQ_GROUP0_LAST 4
+#define SEQ_GROUP1_LAST 40
+#define SEQ_CONFIG_CYCLES 20
+#define SEQ_TIME_MAX_US 10000000
+#define SEQ_HB_PERIOD_CYCLES 100
+#define SEQ_HB_CONSUMER_MS 25
+/* Node-ID of the simulated node, which is not added to the sequencer */
+#define SEQ_NODE_UNMANAGED (SEQ_NODES + 1)
+
+static CO_CANrx_t seqRx[SEQ_NODE_UNMANAGED];
+static CO_CANtx_t seqTx[1];
+static CO_CANrx_t seqSimRx[1];
+static CO_CANtx_t seqSimTx[1];
+static CO_HBconsNode_t seqHbNodes[SEQ_NODE_UNMANAGED];
+static uint32_t seqHbTime[SEQ_NODE_UNMANAGED];
+static uint8_t seqHbTimeMaxSub;
+
+/* Number of simulated nodes on the bus, SEQ_NODES or SEQ_NODE_UNMANAGED */
+static uint8_t seqSimNodes;
+static CO_NMT_internalState_t seqSimState[SEQ_NODE_UNMANAGED + 1];
+static bool_t seqSimChanged[SEQ_NODE_UNMANAGED + 1];
+static uint8_t seqConfigPolls[SEQ_NODES + 1];
+
+/* NMT command received by the simulated nodes */
+static void bench_seqReceiveNMT(void *object, void *msg) {
+    uint8_t *data = CO_CANrxMsg_readData(msg);
+    (void)object;
+
+    for (uint8_t id = 1; id <= seqSimNodes; id++) {
+        if ((data[1] == 0 || data[1] == id)
+            && data[0] == CO_NMT_ENTER_OPERATIONAL
+        ) {
+            seqSimState[id] = CO_NMT_OPERATIONAL;
+            seqSimChanged[id] = true;
+        }
+    }
+}
+
+/* Simulated nodes send Heartbeat periodically and after state change */
+static void bench_seqSend(CO_CANmodule_t *CANsim, uint32_t cyc) {
+    for (uint8_t id = 1; id <= seqSimNodes; id++) {
+        if (seqSimChanged[id] || (cyc + id) % SEQ_HB_PERIOD_CYCLES == 0) {
+            CO_CANtx_t *tx = CO_CANtxBufferInit(CANsim, 0,
+                                                CO_CAN_ID_HEARTBEAT + id,
+                                                false, 1, false);
+            tx->data[0] = seqSimState[id];
+            CO_CANsend(CANsim, tx);
+            seqSimChanged[id] = false;
+        }
+    }
+}
+
+/* Configuration of each node takes some cycles, like SDO transfers */
+static CO_NMTseq_config_t bench_seqConfigure(uint8_t nodeId, void *object) {
+    (void)object;
+    return ++seqConfigPolls[nodeId] >= SEQ_CONFIG_CYCLES
+           ? CO_NMTseq_CONFIG_DONE : CO_NMTseq_CONFIG_BUSY;
+}
+
+int bench_nmtseq(void) {
+    /* per-node commands, unmanaged node on the bus, not monitored;
+     * broadcast, all nodes managed; broadcast, unmanaged node monitored */
+    static const char *const names[] = {"per-node", "broadcast", "bc-fallback"};
+    static const uint8_t simNodes[] = {SEQ_NODE_UNMANAGED, SEQ_NODES,
+                                       SEQ_NODE_UNMANAGED};
+    static const uint8_t monitored[] = {SEQ_NODES, SEQ_NODES,
+                                        SEQ_NODE_UNMANAGED};
+    static const uint8_t flags[] = {0, CO_NMT_SEQ_FLAG_BROADCAST,
+                                    CO_NMT_SEQ_FLAG_BROADCAST};
+    /* the last wave needs one command, if it is started by broadcast */
+    static const uint16_t commands[] = {SEQ_NODES, SEQ_GROUP1_LAST + 1,
+                                        SEQ_NODES};
+    bench_OD_t *od = calloc(1, sizeof(bench_OD_t));
+    OD_obj_array_t hbArr = {&seqHbTimeMaxSub, seqHbTime, ODA_SDO_R,
+                            ODA_SDO_RW | ODA_MB, 4, sizeof(uint32_t)};
+    OD_entry_t entry = {0x1016, SEQ_NODE_UNMANAGED + 1, ODT_ARR, &hbArr, NULL};
+    CO_NMTseq_t *seq = calloc(1, sizeof(CO_NMTseq_t));
+    int errors = 0;
+
+    if (od == NULL || seq == NULL) {
+        log_printf("Error: Can't allocate memory\n");
+        return 1;
+    }
+
+    log_printf("\nNMT startup sequence, %u nodes in 3 dependent groups, "
+               "configuration %u ms each\n", SEQ_NODES,
+               SEQ_CONFIG_CYCLES * CYCLE_US / 1000);
+    log_printf("%-12s %8s %8s %10s %12s\n", "method", "nmt_tx", "waves",
+               "bus_ms", "cpu_us");
+
+    for (uint8_t v = 0; v < sizeof(names) / sizeof(names[0]); v++) {
+        CO_CANmodule_t CANcons, CANsim;
+        CO_HBconsumer_t HBcons;
+        CO_NMTseq_return_t ret = CO_NMTseq_BUSY;
+        uint32_t time_us = 0;
+        uint64_t ns = 0;
+
+        CO_vbus_reset();
+        bench_OD_init(od, 1);
+        CO_t *co = bench_device(od, NODE_ID_CLIENT);
+        /* this node enters NMT operational state */
+        CO_process(co, false, 0, NULL);
+        seqSimNodes = simNodes[v];
+        seqHbTimeMaxSub = monitored[v];
+        for (uint8_t id = 1; id <= SEQ_NODE_UNMANAGED; id++) {
+            seqHbTime[id - 1] = ((uint32_t)id << 16) | SEQ_HB_CONSUMER_MS;
+            seqSimState[id] = CO_NMT_PRE_OPERATIONAL;
+            seqSimChanged[id] = false;
+        }
+        memset(seqConfigPolls, 0, sizeof(seqConfigPolls));
+        CO_CANmodule_init(&CANcons, NULL, seqRx, SEQ_NODE_UNMANAGED,
+                          seqTx, 1, 1000);
+        CO_CANmodule_init(&CANsim, NULL, seqSimRx, 1, seqSimTx, 1, 1000);
+        CO_CANrxBufferInit(&CANsim, 0, CO_CAN_ID_NMT_SERVICE, 0x7FF, false,
+                           seqSimState, bench_seqReceiveNMT);
+        CO_HBconsumer_init(&HBcons, co->em, seqHbNodes, monitored[v], &entry,
+                           &CANcons, 0, NULL);
+        CO_CANsetNormalMode(&CANcons);
+        CO_CANsetNormalMode(&CANsim);
+        CO_HBconsumer_process(&HBcons, true, 0, NULL);
+
+        /* supplies, then drives, then I/O modules */
+        CO_NMTseq_init(seq, co->NMT, &HBcons);
+        for (uint8_t id = 1; id <= SEQ_NODES; id++) {
+            CO_NMTseq_addNode(seq, id, id <= SEQ_GROUP0_LAST ? 0
+                                       : (id <= SEQ_GROUP1_LAST ? 1 : 2));
+        }
+        CO_NMTseq_setDependency(seq, 1, 0x01);
+        CO_NMTseq_setDependency(seq, 2, 0x02);
+        CO_NMTseq_initCallbackConfigure(seq, NULL, bench_seqConfigure);
+        CO_NMTseq_start(seq, flags[v], SEQ_HB_CONSUMER_MS * 4, 2);
+
+        for (uint32_t cyc = 0; ret == CO_NMTseq_BUSY
+             && time_us < SEQ_TIME_MAX_US; cyc++
+        ) {
+            bench_seqSend(&CANsim, cyc);
+            CO_vbus_deliver();
+            CO_HBconsumer_process(&HBcons, true, CYCLE_US, NULL);
+            uint64_t ns0 = time_ns();
+            ret = CO_NMTseq_process(seq, CYCLE_US, NULL);
+            ns += time_ns() - ns0;
+            CO_vbus_deliver();
+            time_us += CYCLE_US;
+        }
+
+        /* nodes must be operational in order of groups, node, which is not
+         * managed by the sequencer, must not be started */
+        bool_t allOperational = true;
+        for (uint8_t id = 1; id <= SEQ_NODES; id++) {
+            if (seqSimState[id] != CO_NMT_OPERATIONAL) {
+                allOperational = false;
+            }
+        }
+        if (ret != CO_NMTseq_DONE || !allOperational
+            || seq->commandsSent != commands[v]
+            || seqSimState[SEQ_NODE_UNMANAGED] != CO_NMT_PRE_OPERATIONAL
+        ) {
+            log_printf("Error: NMT sequence %s %d, %u commands\n",
+                       names[v], ret, seq->commandsSent);
+            errors++;
+        }
+        log_printf("%-12s %8u %8u %10.1f %12.1f\n", names[v],
+                   seq->commandsSent, seq->waves, (double)time_us / 1000.0,
+                   (double)ns / 1000.0);
+        CO_delete(co);
+    }
+
+    /* one node at a time: configure, start and wait for Heartbeat */
+    log_printf("%-12s %8u %8u %10.1f %12s\n", "sequential",
+               SEQ_NODES, SEQ_NODES,
+               (double)SEQ_NODES * (SEQ_CONFIG_CYCLES + 2) * CYCLE_US / 1000.0,
+               "-");
+
+    free(seq);
+    free(od);
+    return errors;
+}
+#endif /* (CO_CONFIG_NMT_SEQ) & CO_CONFIG_NMT_SEQ_ENABLE */
@@ -0,0 +1,191 @@
+/*
+ * Benchmark of the concurrent network scan.
+ *
+ * Network with some SDO servers is scanned and the node table is verified.
+ * One more simulated node sends only Heartbeats. SDO client of the scanning
+ * device reads a server meanwhile.
+ *
+ * @file        benchmark_nodescan.c
+ * @author      J-Weisberg
+ * @copyright   2026 J-Weisberg
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "benchmark.h"
+
+#if (CO_CONFIG_NODE_SCAN) & CO_CONFIG_NODE_SCAN_ENABLE
+/* Network scan of the virtual bus with some SDO servers **********************/
+#define SCAN_TIMEOUT_MS 100
+#define SCAN_TIME_MAX_US 10000000
+#define SCAN_HB_PERIOD_CYCLES 100
+/* Node-ID of the simulated node without SDO server */
+#define SCAN_NODE_HB_ONLY 80
+/* Heartbeat of this node is monitored by the scanning device */
+#define SCAN_NODE_MONITORED 17
+/* SDO client of the scanning device reads 0x2001 from this node */
+#define SCAN_NODE_SDO 42
+#define SCAN_SDO_VALUE 0x5A5AA5A5U
+
+static CO_CANmodule_t scanCANsim;
+static CO_CANrx_t scanSimRx[1];
+static CO_CANtx_t scanSimTx[1];
+
+int bench_scan(void) {
+    static const uint8_t nodeIds[] = {2, 17, 42, 64, 99, 127};
+    enum { SRV_COUNT = sizeof(nodeIds) / sizeof(nodeIds[0]) };
+    bench_OD_t *odSrv = calloc(SRV_COUNT, sizeof(bench_OD_t));
+    bench_OD_t *odCli = calloc(1, sizeof(bench_OD_t));
+    CO_t *coSrv[SRV_COUNT];
+    CO_nodeScan_t *scan;
+    CO_SDOclient_t *SDO_C;
+    CO_SDO_return_t retSDO = CO_SDO_RT_waitingResponse;
+    CO_SDO_abortCode_t abortCode = CO_SDO_AB_NONE;
+    bool_t SDOstarted = false;
+    uint32_t value = 0;
+    uint32_t time_us = 0;
+    uint32_t cyc = 0;
+    uint32_t frames0;
+    uint64_t ns0;
+    int errors = 0;
+    size_t i;
+
+    if (odSrv == NULL || odCli == NULL) {
+        log_printf("Error: Can't allocate memory\n");
+        return 1;
+    }
+
+    /* all devices produce Heartbeats, scanning device monitors one node */
+    CO_vbus_reset();
+    OD_PERSIST_COMM.x1017_producerHeartbeatTime =
+        SCAN_HB_PERIOD_CYCLES * CYCLE_US / 1000;
+    OD_PERSIST_COMM.x1016_consumerHeartbeatTime[0] =
+        ((uint32_t)SCAN_NODE_MONITORED << 16) | (SCAN_TIMEOUT_MS * 2);
+    bench_OD_init(odCli, 1);
+    odCli->config.CNT_NODE_SCAN = 1;
+    odCli->config.CNT_HB_CONS = 1;
+    odCli->config.CNT_ARR_1016 = OD_CNT_ARR_1016;
+    odCli->config.ENTRY_H1016 = OD_find(&odCli->od, 0x1016);
+    CO_t *coCli = bench_device(odCli, NODE_ID_CLIENT);
+    for (i = 0; i < SRV_COUNT; i++) {
+        bench_OD_init(&odSrv[i], 1);
+        coSrv[i] = bench_device(&odSrv[i], nodeIds[i]);
+    }
+    CO_CANmodule_init(&scanCANsim, NULL, scanSimRx, 1, scanSimTx, 1, 1000);
+    CO_CANsetNormalMode(&scanCANsim);
+    CO_CANtx_t *txSim = CO_CANtxBufferInit(&scanCANsim, 0,
+                                           CO_CAN_ID_HEARTBEAT
+                                           + SCAN_NODE_HB_ONLY,
+                                           false, 1, false);
+    txSim->data[0] = CO_NMT_PRE_OPERATIONAL;
+    CO_vbus_deliver();
+    OD_PERSIST_COMM.x1018_identity.vendor_ID = 0x12345678;
+    OD_PERSIST_COMM.x1018_identity.serialNumber = 0x9ABCDEF0;
+    testU32 = SCAN_SDO_VALUE;
+    scan = coCli->nodeScan;
+    SDO_C = &coCli->SDOclient[0];
+    CO_SDOclient_setup(SDO_C, CO_CAN_ID_SDO_CLI + SCAN_NODE_SDO,
+                       CO_CAN_ID_SDO_SRV + SCAN_NODE_SDO, SCAN_NODE_SDO);
+
+    frames0 = CO_vbus_getStat()->frames;
+    ns0 = time_ns();
+    CO_nodeScan_start(scan, CO_NODE_SCAN_NODE_MIN, CO_NODE_SCAN_NODE_MAX,
+                      SCAN_TIMEOUT_MS);
+    while (CO_nodeScan_process(scan, CYCLE_US, NULL)
+           && time_us < SCAN_TIME_MAX_US
+    ) {
+        if (cyc++ % SCAN_HB_PERIOD_CYCLES == 0) {
+            CO_CANsend(&scanCANsim, txSim);
+        }
+        /* start, when scan of the node is finished, SDO server is free then */
+        if (!SDOstarted && scan->req[SCAN_NODE_SDO - 1].subIndex == 0U) {
+            CO_SDOclientUploadInitiate(SDO_C, 0x2001, 0, SDO_TIMEOUT_MS, false);
+            SDOstarted = true;
+        }
+        else if (SDOstarted && retSDO > 0) {
+            retSDO = CO_SDOclientUpload(SDO_C, CYCLE_US, false, &abortCode,
+                                        NULL, NULL, NULL);
+        }
+        CO_vbus_deliver();
+        CO_process(coCli, false, CYCLE_US, NULL);
+        for (i = 0; i < SRV_COUNT; i++) {
+            CO_process(coSrv[i], false, CYCLE_US, NULL);
+        }
+        CO_vbus_deliver();
+        time_us += CYCLE_US;
+    }
+    uint64_t ns = time_ns() - ns0;
+    uint32_t frames = CO_vbus_getStat()->frames - frames0;
+
+    /* SDO transfer is not disturbed by the scan */
+    CO_SDOclientUploadBufRead(SDO_C, (uint8_t *)&value, sizeof(value));
+    if (retSDO != CO_SDO_RT_ok_communicationEnd || value != SCAN_SDO_VALUE) {
+        log_printf("Error: SDO upload during scan: %d, 0x%08X\n",
+                   retSDO, (unsigned)abortCode);
+        errors++;
+    }
+    CO_SDOclientClose(SDO_C);
+
+    /* verify node table */
+    if (scan->running || scan->nodesFound != SRV_COUNT + 1) {
+        log_printf("Error: scan found %u nodes\n", scan->nodesFound);
+        errors++;
+    }
+    if (scan->nodes[SCAN_NODE_HB_ONLY - 1].flags != CO_NODE_SCAN_FLAG_HB
+        || (scan->nodes[SCAN_NODE_MONITORED - 1].flags & CO_NODE_SCAN_FLAG_HB)
+           == 0
+    ) {
+        log_printf("Error: scan, Heartbeat not observed\n");
+        errors++;
+    }
+    for (i = 0; i < SRV_COUNT; i++) {
+        const CO_nodeScan_node_t *node = &scan->nodes[nodeIds[i] - 1];
+        if ((node->flags & 0xF0U) != 0xF0U
+            || node->identity[0] != 0x12345678
+            || node->identity[3] != 0x9ABCDEF0
+        ) {
+            log_printf("Error: scan, node %u identity\n", nodeIds[i]);
+            errors++;
+        }
+    }
+    OD_PERSIST_COMM.x1018_identity.vendor_ID = 0;
+    OD_PERSIST_COMM.x1018_identity.serialNumber = 0;
+    OD_PERSIST_COMM.x1017_producerHeartbeatTime = 0;
+    OD_PERSIST_COMM.x1016_consumerHeartbeatTime[0] = 0;
+
+    log_printf("\nNetwork scan, %u of %u nodes present, timeout %u ms\n",
+               (unsigned)SRV_COUNT + 1, CO_NODE_SCAN_NODE_MAX, SCAN_TIMEOUT_MS);
+    log_printf("%-12s %8s %10s %12s\n", "method", "frames", "bus_ms",
+               "cpu_us");
+    log_printf("%-12s %8u %10.1f %12.1f\n", "concurrent", frames,
+               (double)time_us / 1000.0, (double)ns / 1000.0);
+    /* sequential SDO client: each absent node costs one timeout */
+    log_printf("%-12s %8s %10.1f %12s\n", "sequential", "-",
+               (double)(CO_NODE_SCAN_NODE_MAX - SRV_COUNT - 1)
+               * SCAN_TIMEOUT_MS,
+               "-");
+
+    CO_delete(coCli);
+    for (i = 0; i < SRV_COUNT; i++) {
+        CO_delete(coSrv[i]);
+    }
+    free(odCli);
+    free(odSrv);
+    return errors;
+}
+#endif /* (CO_CONFIG_NODE_SCAN) & CO_CONFIG_NODE_SCAN_ENABLE */
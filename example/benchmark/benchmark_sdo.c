@@ -0,0 +1,806 @@
+/*
+ * SDO throughput and latency benchmark on the virtual CAN bus.
+ *
+ * Client device transfers data to and from the SDO server device. Benchmark
+ * measures expedited round-trip latency, segmented and block throughput for
+ * different object sizes and processing cost of CO_process() for different
+ * number of SDO servers. Block upload is also run with lost frames, to show
+ * adaptation of blksize (CO_CONFIG_SDO_CLI_BLOCK_ADAPTIVE).
+ *
+ * Results are number of CAN frames, throughput limited by the CAN bus
+ * (1 Mbit/s, without stuff bits), throughput limited by the CPU and CPU cycles
+ * per byte (x86 only). Block size for upload is set by
+ * CO_CONFIG_SDO_CLI_BUFFER_SIZE and buffer for OD access on the server by
+ * CO_CONFIG_SDO_SRV_BUFFER_SIZE, see "make benchmark" in example/Makefile.
+ *
+ * @file        benchmark_sdo.c
+ * @author      J-Weisberg
+ * @copyright   2026 J-Weisberg
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "benchmark.h"
+
+#if (CO_CONFIG_OD) & CO_CONFIG_OD_DOMAIN_FILE
+#include <unistd.h>
+#endif
+
+/* number of cycles for CO_process() cost measurement */
+#define PROCESS_CYCLES 100000
+/* block size, calculated by SDO server and client from their buffer sizes */
+#define BLKSIZE_MAX(bufSize) ((bufSize) / 7 > 127 ? 127 : (bufSize) / 7)
+#define BLKSIZE_DOWNLOAD BLKSIZE_MAX(CO_CONFIG_SDO_SRV_BUFFER_SIZE - 2)
+#define BLKSIZE_UPLOAD BLKSIZE_MAX(CO_CONFIG_SDO_CLI_BUFFER_SIZE - 1)
+
+
+/* Run one SDO transfer *******************************************************/
+static CO_SDO_return_t bench_transfer(CO_t *coCli, CO_t *coSrv,
+                                      bool_t download, uint16_t index,
+                                      size_t size, bool_t block,
+                                      bench_result_t *res)
+{
+    CO_SDOclient_t *SDO_C = &coCli->SDOclient[0];
+    CO_SDO_abortCode_t abortCode = CO_SDO_AB_NONE;
+    CO_SDO_return_t ret;
+    size_t offset = 0;
+    uint32_t frames0 = CO_vbus_getStat()->frames;
+    uint64_t bits0 = CO_vbus_getStat()->bits;
+    uint64_t ns0 = time_ns();
+    uint64_t cycles0 = cycles();
+
+    if (download) {
+        ret = CO_SDOclientDownloadInitiate(SDO_C, index, 0, size,
+                                           SDO_TIMEOUT_MS, block);
+    }
+    else {
+        ret = CO_SDOclientUploadInitiate(SDO_C, index, 0,
+                                         SDO_TIMEOUT_MS, block);
+    }
+
+    while (ret == CO_SDO_RT_ok_communicationEnd || ret > 0) {
+        if (download) {
+            offset += CO_SDOclientDownloadBufWrite(SDO_C, &dataTx[offset],
+                                                   size - offset);
+            ret = CO_SDOclientDownload(SDO_C, CYCLE_US, false, offset < size,
+                                       &abortCode, NULL, NULL);
+        }
+        else {
+            ret = CO_SDOclientUpload(SDO_C, CYCLE_US, false,
+                                     &abortCode, NULL, NULL, NULL);
+            if (ret != CO_SDO_RT_blockUploadInProgress) {
+                offset += CO_SDOclientUploadBufRead(SDO_C, &dataRx[offset],
+                                                    sizeof(dataRx) - offset);
+            }
+        }
+        CO_vbus_deliver();
+        CO_process(coSrv, false, CYCLE_US, NULL);
+        CO_vbus_deliver();
+        if (ret <= 0) {
+            break;
+        }
+    }
+
+    res->cycles += cycles() - cycles0;
+    res->ns += time_ns() - ns0;
+    res->frames += CO_vbus_getStat()->frames - frames0;
+    res->bits += CO_vbus_getStat()->bits - bits0;
+
+    /* verify data in OD object, other objects are verified by the caller */
+    const uint8_t *dataOD = index == 0x2000 ? domain
+                          : index == 0x2001 ? (uint8_t *)&testU32 : NULL;
+    const uint8_t *data = download ? dataTx : dataRx;
+    if (ret < 0) {
+        log_printf("Error: SDO %s 0x%04X, size %lu, abort code 0x%08X\n",
+                   download ? "download" : "upload", index,
+                   (unsigned long)size, (unsigned)abortCode);
+    }
+    else if (offset != size
+             || (dataOD != NULL && memcmp(data, dataOD, size) != 0)
+    ) {
+        log_printf("Error: SDO %s 0x%04X, size %lu, data mismatch\n",
+                   download ? "download" : "upload", index,
+                   (unsigned long)size);
+        ret = CO_SDO_RT_endedWithClientAbort;
+    }
+
+    return ret;
+}
+
+
+static void bench_print(const char *name, size_t size, uint32_t count,
+                        const bench_result_t *res)
+{
+    double bytes = (double)size * count;
+    double busBps = bytes * 1000000.0 / (double)res->bits;
+    double cpuBps = bytes * 1000000000.0 / (double)res->ns;
+
+    log_printf("%-12s %8lu %8.1f %12.0f %14.0f",
+               name, (unsigned long)size, (double)res->frames / count,
+               busBps, cpuBps);
+    if (res->cycles > 0) {
+        log_printf(" %12.1f\n", (double)res->cycles / bytes);
+    }
+    else {
+        log_printf(" %12s\n", "n/a");
+    }
+}
+
+
+/* Benchmark of SDO transfers *************************************************/
+int bench_sdo(uint32_t repeat) {
+    static const size_t sizes[] = {8, 64, 889, 4096, DOMAIN_SIZE_MAX};
+    bench_OD_t *odSrv = calloc(1, sizeof(bench_OD_t));
+    bench_OD_t *odCli = calloc(1, sizeof(bench_OD_t));
+    int errors = 0;
+
+    if (odSrv == NULL || odCli == NULL) {
+        log_printf("Error: Can't allocate memory\n");
+        return 1;
+    }
+
+    CO_vbus_reset();
+    bench_OD_init(odSrv, 1);
+    bench_OD_init(odCli, 1);
+    CO_t *coSrv = bench_device(odSrv, NODE_ID_SERVER);
+    CO_t *coCli = bench_device(odCli, NODE_ID_CLIENT);
+    CO_SDOclient_setup(&coCli->SDOclient[0],
+                       CO_CAN_ID_SDO_CLI + NODE_ID_SERVER,
+                       CO_CAN_ID_SDO_SRV + NODE_ID_SERVER,
+                       NODE_ID_SERVER);
+
+    /* bootup and NMT start of the server */
+    CO_process(coSrv, false, CYCLE_US, NULL);
+    CO_process(coCli, false, CYCLE_US, NULL);
+    CO_vbus_deliver();
+
+    for (size_t i = 0; i < sizeof(dataTx); i++) {
+        dataTx[i] = (uint8_t)rand();
+    }
+
+    log_printf("\nSDO_SRV_BUFFER_SIZE=%d (download blksize=%d), "
+               "SDO_CLI_BUFFER_SIZE=%d (upload blksize=%d)\n",
+               CO_CONFIG_SDO_SRV_BUFFER_SIZE, BLKSIZE_DOWNLOAD,
+               CO_CONFIG_SDO_CLI_BUFFER_SIZE, BLKSIZE_UPLOAD);
+    log_printf("%-12s %8s %8s %12s %14s %12s\n", "transfer", "size",
+               "frames", "bus_B/s", "cpu_B/s", "cycles/B");
+
+    /* expedited round-trip latency, bus time at 1 Mbit/s is bits in us */
+    for (int dl = 1; dl >= 0; dl--) {
+        bench_result_t res = {0};
+        for (uint32_t r = 0; r < repeat; r++) {
+            if (bench_transfer(coCli, coSrv, dl, 0x2001, 4, false, &res) < 0) {
+                errors++;
+                break;
+            }
+        }
+        bench_print(dl ? "exp_dl" : "exp_ul", 4, repeat, &res);
+        log_printf("%-12s bus %.1f us, cpu %.3f us\n", "  round-trip",
+                   (double)res.bits / repeat,
+                   (double)res.ns / 1000.0 / repeat);
+    }
+
+    /* segmented and block transfers of different sizes */
+    for (int block = 0; block <= 1; block++) {
+        for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+            for (int dl = 1; dl >= 0; dl--) {
+                bench_result_t res = {0};
+                uint32_t rep = (repeat * 64) / (sizes[s] + 64) + 1;
+                char name[20];
+
+                domainVar.dataLength = (OD_size_t)sizes[s];
+                for (uint32_t r = 0; r < rep; r++) {
+                    memset(dataRx, 0, sizes[s]);
+                    if (bench_transfer(coCli, coSrv, dl, 0x2000, sizes[s],
+                                       block, &res) < 0
+                    ) {
+                        errors++;
+                        break;
+                    }
+                }
+                sprintf(name, "%s_%s", block ? "blk" : "seg", dl ? "dl" : "ul");
+                bench_print(name, sizes[s], rep, &res);
+            }
+        }
+    }
+    domainVar.dataLength = DOMAIN_SIZE_MAX;
+
+    CO_delete(coCli);
+    CO_delete(coSrv);
+    free(odCli);
+    free(odSrv);
+    return errors;
+}
+
+
+/* Block upload with lost CAN frames *****************************************/
+/* client receives at most LOSSY_BURST consecutive frames from the SDO server */
+#define LOSSY_BURST 10
+#define LOSSY_SIZE 4096
+#define LOSSY_TRANSFERS 4
+#define LOSSY_TIME_FACTOR 2
+
+/* Block upload of LOSSY_SIZE bytes from 0x2000. Get the smallest blksize used
+ * by the client and the duration of the transfer. */
+static CO_SDO_return_t bench_lossyUpload(CO_t *coCli, CO_t *coSrv,
+                                         uint8_t *blksizeMin, uint32_t *time_us)
+{
+    CO_SDOclient_t *SDO_C = &coCli->SDOclient[0];
+    CO_SDO_abortCode_t abortCode = CO_SDO_AB_NONE;
+    CO_SDO_return_t ret;
+    size_t offset = 0;
+
+    *blksizeMin = 127;
+    *time_us = 0;
+    memset(dataRx, 0, LOSSY_SIZE);
+    ret = CO_SDOclientUploadInitiate(SDO_C, 0x2000, 0, SDO_TIMEOUT_MS, true);
+
+    while (ret == CO_SDO_RT_ok_communicationEnd || ret > 0) {
+        ret = CO_SDOclientUpload(SDO_C, CYCLE_US, false,
+                                 &abortCode, NULL, NULL, NULL);
+        if (ret == CO_SDO_RT_blockUploadInProgress) {
+            if (SDO_C->block_blksize < *blksizeMin) {
+                *blksizeMin = SDO_C->block_blksize;
+            }
+        }
+        else {
+            offset += CO_SDOclientUploadBufRead(SDO_C, &dataRx[offset],
+                                                sizeof(dataRx) - offset);
+        }
+        CO_vbus_deliver();
+        CO_process(coSrv, false, CYCLE_US, NULL);
+        CO_vbus_deliver();
+        *time_us += CYCLE_US;
+        if (ret <= 0) {
+            break;
+        }
+    }
+
+    if (ret < 0) {
+        log_printf("Error: lossy SDO upload, abort code 0x%08X\n",
+                   (unsigned)abortCode);
+    }
+    else if (offset != LOSSY_SIZE || memcmp(dataRx, domain, LOSSY_SIZE) != 0) {
+        log_printf("Error: lossy SDO upload, data mismatch\n");
+        ret = CO_SDO_RT_endedWithClientAbort;
+    }
+    return ret;
+}
+
+
+/* Block uploads from two SDO servers, client can't receive long sub-blocks
+ * from the first one. Lost segments are detected by sub-block timeout and are
+ * retransmitted. With CO_CONFIG_SDO_CLI_BLOCK_ADAPTIVE blksize for the first
+ * server is reduced and remembered, the second server is still accessed with
+ * the maximum blksize. Only the first transfer from the first server may lose
+ * frames, later transfers must take at most LOSSY_TIME_FACTOR times longer than
+ * transfers from the second server. */
+int bench_sdoLossy(void) {
+    bench_OD_t *odSrv[2];
+    bench_OD_t *odCli = calloc(1, sizeof(bench_OD_t));
+    CO_t *coSrv[2];
+    int errors = 0;
+
+    odSrv[0] = calloc(1, sizeof(bench_OD_t));
+    odSrv[1] = calloc(1, sizeof(bench_OD_t));
+    if (odSrv[0] == NULL || odSrv[1] == NULL || odCli == NULL) {
+        log_printf("Error: Can't allocate memory\n");
+        return 1;
+    }
+
+    CO_vbus_reset();
+    for (int n = 0; n < 2; n++) {
+        bench_OD_init(odSrv[n], 1);
+        coSrv[n] = bench_device(odSrv[n], NODE_ID_SERVER + n);
+        CO_process(coSrv[n], false, CYCLE_US, NULL);
+    }
+    bench_OD_init(odCli, 1);
+    CO_t *coCli = bench_device(odCli, NODE_ID_CLIENT);
+    CO_process(coCli, false, CYCLE_US, NULL);
+    CO_vbus_deliver();
+
+    domainVar.dataLength = LOSSY_SIZE;
+    memcpy(domain, dataTx, LOSSY_SIZE);
+
+    log_printf("\nSDO block upload %d bytes, overrun after %d segments, "
+               "adaptive blksize %s\n", LOSSY_SIZE, LOSSY_BURST,
+               ((CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_BLOCK_ADAPTIVE)
+               ? "on" : "off");
+    log_printf("%-12s %8s %8s %8s %8s %8s\n", "transfer", "frames", "lost",
+               "time_ms", "blk_min", "blk_last");
+
+    /* Second server (without loss) after the first and the first again */
+    static const uint8_t server[] = {0, 1, 0};
+    uint8_t blksizeLast[3];
+    uint32_t lostAdapted = 0;
+    uint32_t timeAdapted = 0;
+    uint32_t timeClean = 0;
+    for (int s = 0; s < 3; s++) {
+        uint8_t nodeId = NODE_ID_SERVER + server[s];
+        CO_SDOclient_setup(&coCli->SDOclient[0],
+                           CO_CAN_ID_SDO_CLI + nodeId,
+                           CO_CAN_ID_SDO_SRV + nodeId,
+                           nodeId);
+        CO_vbus_setDrop(server[s] == 0 ? CO_CAN_ID_SDO_SRV + nodeId : 0,
+                        server[s] == 0 ? LOSSY_BURST : 0);
+
+        for (int t = 0; t < LOSSY_TRANSFERS; t++) {
+            uint32_t frames0 = CO_vbus_getStat()->frames;
+            uint32_t dropped0 = CO_vbus_getStat()->dropped;
+            uint8_t blksizeMin;
+            uint32_t time_us;
+            char name[20];
+
+            if (bench_lossyUpload(coCli, coSrv[server[s]],
+                                  &blksizeMin, &time_us) < 0
+            ) {
+                errors++;
+                break;
+            }
+            uint32_t lost = CO_vbus_getStat()->dropped - dropped0;
+            blksizeLast[s] = coCli->SDOclient[0].block_blksize;
+            sprintf(name, "srv%d_ul%d", server[s], t);
+            log_printf("%-12s %8u %8u %8u %8u %8u\n", name,
+                       (unsigned)(CO_vbus_getStat()->frames - frames0),
+                       (unsigned)lost, (unsigned)(time_us / 1000),
+                       blksizeMin, blksizeLast[s]);
+
+            if (server[s] != 0) {
+                if (time_us > timeClean) {
+                    timeClean = time_us;
+                }
+            }
+            else if (s > 0 || t > 0) {
+                lostAdapted += lost;
+                if (time_us > timeAdapted) {
+                    timeAdapted = time_us;
+                }
+            }
+        }
+    }
+    CO_vbus_setDrop(0, 0);
+    domainVar.dataLength = DOMAIN_SIZE_MAX;
+
+    /* verify, if blksize adapts to the lossy server only */
+    bool_t adaptive =
+        ((CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_BLOCK_ADAPTIVE) != 0;
+    if (errors == 0
+        && ((blksizeLast[0] < BLKSIZE_UPLOAD) != adaptive
+            || blksizeLast[1] != BLKSIZE_UPLOAD
+            || (blksizeLast[2] < BLKSIZE_UPLOAD) != adaptive)
+    ) {
+        log_printf("Error: lossy SDO upload, blksize %u %u %u\n",
+                   blksizeLast[0], blksizeLast[1], blksizeLast[2]);
+        errors++;
+    }
+    if (errors == 0 && adaptive
+        && (lostAdapted > 0 || timeAdapted > timeClean * LOSSY_TIME_FACTOR)
+    ) {
+        log_printf("Error: lossy SDO upload, after adaptation %u frames lost, "
+                   "time %u ms, without loss %u ms\n", (unsigned)lostAdapted,
+                   (unsigned)(timeAdapted / 1000),
+                   (unsigned)(timeClean / 1000));
+        errors++;
+    }
+
+    CO_delete(coCli);
+    CO_delete(coSrv[1]);
+    CO_delete(coSrv[0]);
+    free(odCli);
+    free(odSrv[1]);
+    free(odSrv[0]);
+    return errors;
+}
+
+
+#if (CO_CONFIG_SDO_CLI) & CO_CONFIG_SDO_CLI_LOCAL
+/* Run one SDO transfer to own object dictionary. If direct, then data are
+ * transferred with CO_SDOclientDownloadLocal() or CO_SDOclientUploadLocal(),
+ * otherwise through the client buffer with regular functions. */
+static CO_SDO_return_t bench_local(CO_SDOclient_t *SDO_C, bool_t direct,
+                                   bool_t download, uint16_t index,
+                                   uint8_t subIndex, size_t size,
+                                   CO_SDO_abortCode_t *abortCode)
+{
+    CO_SDO_return_t ret;
+    size_t offset = 0;
+
+    *abortCode = CO_SDO_AB_NONE;
+    if (download) {
+        ret = CO_SDOclientDownloadInitiate(SDO_C, index, subIndex, size,
+                                           SDO_TIMEOUT_MS, false);
+        if (ret == CO_SDO_RT_ok_communicationEnd && direct) {
+            ret = CO_SDOclientDownloadLocal(SDO_C, dataTx, size, abortCode);
+            offset = size;
+        }
+        else while (ret == CO_SDO_RT_ok_communicationEnd || ret > 0) {
+            offset += CO_SDOclientDownloadBufWrite(SDO_C, &dataTx[offset],
+                                                   size - offset);
+            ret = CO_SDOclientDownload(SDO_C, CYCLE_US, false, offset < size,
+                                       abortCode, NULL, NULL);
+            if (ret <= 0) {
+                break;
+            }
+        }
+    }
+    else {
+        ret = CO_SDOclientUploadInitiate(SDO_C, index, subIndex,
+                                         SDO_TIMEOUT_MS, false);
+        if (ret == CO_SDO_RT_ok_communicationEnd && direct) {
+            ret = CO_SDOclientUploadLocal(SDO_C, dataRx, sizeof(dataRx),
+                                          &offset, abortCode);
+        }
+        else while (ret == CO_SDO_RT_ok_communicationEnd || ret > 0) {
+            ret = CO_SDOclientUpload(SDO_C, CYCLE_US, false,
+                                     abortCode, NULL, NULL, NULL);
+            offset += CO_SDOclientUploadBufRead(SDO_C, &dataRx[offset],
+                                                sizeof(dataRx) - offset);
+            if (ret <= 0) {
+                break;
+            }
+        }
+    }
+
+    /* verify data in OD object */
+    if (ret >= 0) {
+        const uint8_t *dataOD = index == 0x2000 ? domain : (uint8_t *)&testU32;
+        const uint8_t *data = download ? dataTx : dataRx;
+        if (offset != size || memcmp(data, dataOD, size) != 0) {
+            log_printf("Error: local SDO %s 0x%04X, size %lu, data mismatch\n",
+                       download ? "download" : "upload", index,
+                       (unsigned long)size);
+            ret = CO_SDO_RT_endedWithClientAbort;
+        }
+    }
+
+    return ret;
+}
+
+
+/* Benchmark of SDO transfers to own object dictionary ************************/
+int bench_sdoLocal(uint32_t repeat) {
+    static const size_t sizes[] = {4, 64, 889, 4096};
+    /* transfers, which must be aborted by local access to OD */
+    static const struct {
+        bool_t download;
+        uint16_t index;
+        uint8_t subIndex;
+        size_t size;
+        CO_SDO_abortCode_t abortCode;
+    } aborts[] = {
+        {false, 0x2001, 1, 4, CO_SDO_AB_SUB_UNKNOWN},
+        {true,  0x2001, 1, 4, CO_SDO_AB_SUB_UNKNOWN},
+        {false, 0x2002, 0, 4, CO_SDO_AB_NOT_EXIST},
+        {true,  0x1018, 1, 4, CO_SDO_AB_READONLY},
+        {true,  0x2001, 0, 2, CO_SDO_AB_DATA_SHORT}
+    };
+    bench_OD_t *od = calloc(1, sizeof(bench_OD_t));
+    int errors = 0;
+
+    if (od == NULL) {
+        log_printf("Error: Can't allocate memory\n");
+        return 1;
+    }
+
+    CO_vbus_reset();
+    bench_OD_init(od, 1);
+    CO_t *co = bench_device(od, NODE_ID_CLIENT);
+    CO_SDOclient_t *SDO_C = &co->SDOclient[0];
+    CO_SDOclient_setup(SDO_C, CO_CAN_ID_SDO_CLI + NODE_ID_CLIENT,
+                       CO_CAN_ID_SDO_SRV + NODE_ID_CLIENT, NODE_ID_CLIENT);
+    uint32_t frames0 = CO_vbus_getStat()->frames;
+
+    log_printf("\nSDO client transfers to own object dictionary\n");
+    log_printf("%-12s %8s %14s %14s\n", "transfer", "size",
+               "buf_cpu_B/s", "direct_cpu_B/s");
+
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        uint16_t index = sizes[s] == 4 ? 0x2001 : 0x2000;
+        uint32_t rep = (repeat * 64) / (sizes[s] + 64) + 1;
+
+        for (int dl = 1; dl >= 0; dl--) {
+            uint64_t ns[2] = {0, 0};
+
+            for (int direct = 0; direct <= 1; direct++) {
+                uint64_t ns0 = time_ns();
+
+                domainVar.dataLength = (OD_size_t)sizes[s];
+                for (uint32_t r = 0; r < rep; r++) {
+                    CO_SDO_abortCode_t abortCode;
+                    CO_SDO_return_t ret;
+
+                    memset(dataRx, 0, sizes[s]);
+                    ret = bench_local(SDO_C, direct, dl, index, 0, sizes[s],
+                                      &abortCode);
+                    if (ret < 0) {
+                        log_printf("Error: local SDO %s 0x%04X, size %lu, "
+                                   "%s, abort code 0x%08X\n",
+                                   dl ? "download" : "upload", index,
+                                   (unsigned long)sizes[s],
+                                   direct ? "direct" : "buffered",
+                                   (unsigned)abortCode);
+                        errors++;
+                        break;
+                    }
+                }
+                ns[direct] = time_ns() - ns0;
+            }
+            log_printf("%-12s %8lu %14.0f %14.0f\n", dl ? "local_dl" : "local_ul",
+                       (unsigned long)sizes[s],
+                       (double)sizes[s] * rep * 1000000000.0 / (double)ns[0],
+                       (double)sizes[s] * rep * 1000000000.0 / (double)ns[1]);
+        }
+    }
+    domainVar.dataLength = DOMAIN_SIZE_MAX;
+
+    /* object dictionary access errors, both ways of the transfer */
+    for (size_t a = 0; a < sizeof(aborts) / sizeof(aborts[0]); a++) {
+        for (int direct = 0; direct <= 1; direct++) {
+            CO_SDO_abortCode_t abortCode;
+            CO_SDO_return_t ret;
+
+            ret = bench_local(SDO_C, direct, aborts[a].download,
+                              aborts[a].index, aborts[a].subIndex,
+                              aborts[a].size, &abortCode);
+            if (ret >= 0 || abortCode != aborts[a].abortCode
+                || SDO_C->state != CO_SDO_ST_IDLE
+            ) {
+                log_printf("Error: local SDO %s 0x%04X:%02X, %s, abort code "
+                           "0x%08X, expected 0x%08X\n",
+                           aborts[a].download ? "download" : "upload",
+                           aborts[a].index, aborts[a].subIndex,
+                           direct ? "direct" : "buffered", (unsigned)abortCode,
+                           (unsigned)aborts[a].abortCode);
+                errors++;
+            }
+        }
+    }
+
+    /* local transfers must not use CAN */
+    if (CO_vbus_getStat()->frames != frames0) {
+        log_printf("Error: local SDO transfers sent %u CAN frames\n",
+                   (unsigned)(CO_vbus_getStat()->frames - frames0));
+        errors++;
+    }
+
+    log_printf("%-12s %s\n", "local_abort", errors == 0 ? "OK" : "FAILED");
+
+    CO_delete(co);
+    free(od);
+    return errors;
+}
+#endif
+
+
+#if (CO_CONFIG_OD) & CO_CONFIG_OD_DOMAIN_FILE
+/* SDO transfers of DOMAIN object stored in file ******************************/
+#define FILE_INDEX 0x2010
+#define FILE_SIZE (DOMAIN_SIZE_MAX / 2)
+#define FILE_ABORT_AFTER (CO_CONFIG_SDO_SRV_BUFFER_SIZE * 2)
+
+static uint8_t fileBuf[256];
+static OD_domainFile_t fileDomain;
+static OD_obj_var_t fileVar = {NULL, ODA_SDO_RW, 0};
+
+/* Return true, if the file contains size bytes of data */
+static bool_t file_equals(const char *name, const uint8_t *data, size_t size) {
+    FILE *f = fopen(name, "rb");
+    size_t n;
+
+    if (f == NULL) {
+        return false;
+    }
+    n = fread(dataRx, 1, sizeof(dataRx), f);
+    fclose(f);
+    return n == size && memcmp(dataRx, data, size) == 0;
+}
+
+int bench_domainFile(uint32_t repeat) {
+    bench_OD_t *odSrv = calloc(1, sizeof(bench_OD_t));
+    bench_OD_t *odCli = calloc(1, sizeof(bench_OD_t));
+    char dir[] = "/tmp/canopennode_benchmark_XXXXXX";
+    char fileName[64];
+    int errors = 0;
+
+    if (odSrv == NULL || odCli == NULL || mkdtemp(dir) == NULL) {
+        log_printf("Error: Can't allocate memory or create directory\n");
+        return 1;
+    }
+    sprintf(fileName, "%s/domain.bin", dir);
+
+    CO_vbus_reset();
+    bench_OD_init(odSrv, 1);
+    bench_OD_init(odCli, 1);
+    odSrv->list[odSrv->od.size++] = (OD_entry_t){FILE_INDEX, 1, ODT_VAR,
+                                                 &fileVar, NULL};
+    if (OD_domainFile_init(&fileDomain, OD_find(&odSrv->od, FILE_INDEX),
+                           fileName, fileBuf, sizeof(fileBuf)) != ODR_OK
+    ) {
+        log_printf("Error: OD_domainFile_init() failed\n");
+        return 1;
+    }
+    CO_t *coSrv = bench_device(odSrv, NODE_ID_SERVER);
+    CO_t *coCli = bench_device(odCli, NODE_ID_CLIENT);
+    CO_SDOclient_t *SDO_C = &coCli->SDOclient[0];
+    CO_SDOclient_setup(SDO_C, CO_CAN_ID_SDO_CLI + NODE_ID_SERVER,
+                       CO_CAN_ID_SDO_SRV + NODE_ID_SERVER, NODE_ID_SERVER);
+    CO_process(coSrv, false, CYCLE_US, NULL);
+    CO_process(coCli, false, CYCLE_US, NULL);
+    CO_vbus_deliver();
+
+    log_printf("\nDOMAIN object stored in file, write buffer %lu bytes\n",
+               (unsigned long)sizeof(fileBuf));
+    log_printf("%-12s %8s %8s %12s %14s %12s\n", "transfer", "size",
+               "frames", "bus_B/s", "cpu_B/s", "cycles/B");
+
+    /* download and upload, file contains the data of the last download */
+    for (int block = 0; block <= 1; block++) {
+        for (int dl = 1; dl >= 0; dl--) {
+            bench_result_t res = {0};
+            uint32_t rep = (repeat * 64) / (FILE_SIZE + 64) + 1;
+            char name[20];
+
+            for (uint32_t r = 0; r < rep; r++) {
+                memset(dataRx, 0, FILE_SIZE);
+                if (bench_transfer(coCli, coSrv, dl, FILE_INDEX, FILE_SIZE,
+                                   block, &res) < 0
+                    || (dl && !file_equals(fileName, dataTx, FILE_SIZE))
+                    || (!dl && memcmp(dataRx, dataTx, FILE_SIZE) != 0)
+                ) {
+                    log_printf("Error: file %s, data mismatch\n",
+                               dl ? "download" : "upload");
+                    errors++;
+                    break;
+                }
+            }
+            sprintf(name, "file_%s_%s", block ? "blk" : "seg",
+                    dl ? "dl" : "ul");
+            bench_print(name, FILE_SIZE, rep, &res);
+        }
+    }
+
+    /* Aborted download of other data: data are in the temporary file, which
+     * is deleted when closed, original file is not changed. */
+    CO_SDO_abortCode_t abortCode;
+    CO_SDO_return_t ret;
+    size_t offset = 0, sizeTransferred = 0;
+
+    ret = CO_SDOclientDownloadInitiate(SDO_C, FILE_INDEX, 0, FILE_SIZE,
+                                       SDO_TIMEOUT_MS, false);
+    while (ret >= 0 && sizeTransferred < FILE_ABORT_AFTER) {
+        offset += CO_SDOclientDownloadBufWrite(SDO_C, &dataTx[FILE_SIZE
+                                                              + offset],
+                                               FILE_SIZE - offset);
+        ret = CO_SDOclientDownload(SDO_C, CYCLE_US, false, offset < FILE_SIZE,
+                                   &abortCode, &sizeTransferred, NULL);
+        CO_vbus_deliver();
+        CO_process(coSrv, false, CYCLE_US, NULL);
+        CO_vbus_deliver();
+    }
+    CO_SDOclientDownload(SDO_C, CYCLE_US, true, false, &abortCode, NULL, NULL);
+    CO_vbus_deliver();
+    CO_process(coSrv, false, CYCLE_US, NULL);
+    CO_vbus_deliver();
+    bool_t tmpExists = access(fileDomain.tmpName, F_OK) == 0;
+    OD_domainFile_close(&fileDomain);
+    if (ret < 0 || !tmpExists || access(fileDomain.tmpName, F_OK) == 0
+        || !file_equals(fileName, dataTx, FILE_SIZE)
+    ) {
+        log_printf("Error: file download abort, temporary file %s\n",
+                   tmpExists ? "not deleted" : "missing");
+        errors++;
+    }
+    /* upload after the abort */
+    bench_result_t res = {0};
+    memset(dataRx, 0, FILE_SIZE);
+    if (bench_transfer(coCli, coSrv, false, FILE_INDEX, FILE_SIZE, true, &res)
+            < 0 || memcmp(dataRx, dataTx, FILE_SIZE) != 0
+    ) {
+        log_printf("Error: file upload after abort, data mismatch\n");
+        errors++;
+    }
+    log_printf("%-12s %s\n", "file_abort", errors == 0 ? "OK" : "FAILED");
+
+    CO_delete(coCli);
+    CO_delete(coSrv);
+    (void)unlink(fileName);
+    (void)rmdir(dir);
+    free(odCli);
+    free(odSrv);
+    return errors;
+}
+#endif
+
+
+/* Benchmark of CO_process() for different number of SDO servers **************/
+static uint64_t bench_process(CO_t *co) {
+    uint64_t ns0 = time_ns();
+
+    for (uint32_t i = 0; i < PROCESS_CYCLES; i++) {
+        CO_process(co, false, 0, NULL);
+    }
+
+    return time_ns() - ns0;
+}
+
+int bench_servers(void) {
+    static const uint8_t counts[] = {1, 8, 32, 128};
+    bench_OD_t *odSrv = calloc(1, sizeof(bench_OD_t));
+    bench_OD_t *odCli = calloc(1, sizeof(bench_OD_t));
+    int errors = 0;
+
+    if (odSrv == NULL || odCli == NULL) {
+        log_printf("Error: Can't allocate memory\n");
+        return 1;
+    }
+
+    log_printf("\nCO_process() with SDO_SRV_INDEXED=%d\n",
+               (CO_CONFIG_SDO_SRV & CO_CONFIG_SDO_SRV_INDEXED) != 0);
+    log_printf("%-12s %14s %14s\n", "SDO_servers", "idle_ns/cyc",
+               "active_ns/cyc");
+
+    for (size_t c = 0; c < sizeof(counts) / sizeof(counts[0]); c++) {
+        uint8_t count = counts[c];
+        uint8_t k = count - 1;
+        CO_SDO_abortCode_t abortCode;
+
+        CO_vbus_reset();
+        bench_OD_init(odSrv, count);
+        bench_OD_init(odCli, 1);
+        CO_t *coSrv = bench_device(odSrv, NODE_ID_SERVER);
+        CO_t *coCli = bench_device(odCli, NODE_ID_CLIENT);
+        CO_process(coSrv, false, CYCLE_US, NULL);
+        CO_vbus_deliver();
+
+        /* all SDO servers are idle */
+        uint64_t nsIdle = bench_process(coSrv);
+
+        /* Last SDO server is in the middle of segmented upload and waits for
+         * the client. (Time does not run, so it does not time out.) */
+        CO_SDOclient_setup(&coCli->SDOclient[0],
+                           k == 0 ? CO_CAN_ID_SDO_CLI + NODE_ID_SERVER
+                                  : 0x640U + k,
+                           k == 0 ? CO_CAN_ID_SDO_SRV + NODE_ID_SERVER
+                                  : 0x4C0U + k,
+                           NODE_ID_SERVER);
+        domainVar.dataLength = DOMAIN_SIZE_MAX;
+        CO_SDOclientUploadInitiate(&coCli->SDOclient[0], 0x2000, 0,
+                                   SDO_TIMEOUT_MS, false);
+        CO_SDOclientUpload(&coCli->SDOclient[0], CYCLE_US, false,
+                           &abortCode, NULL, NULL, NULL);
+        CO_vbus_deliver();
+        CO_process(coSrv, false, CYCLE_US, NULL);
+        if (coSrv->SDOserver[k].state == CO_SDO_ST_IDLE) {
+            log_printf("Error: SDO server %u is not active\n", k + 1);
+            errors++;
+        }
+
+        uint64_t nsActive = bench_process(coSrv);
+
+        log_printf("%-12u %14.1f %14.1f\n", count,
+                   (double)nsIdle / PROCESS_CYCLES,
+                   (double)nsActive / PROCESS_CYCLES);
+
+        CO_delete(coCli);
+        CO_delete(coSrv);
+    }
+
+    free(odCli);
+    free(odSrv);
+    return errors;
+}
@@ -0,0 +1,424 @@
+/*
+ * CANopen error history storage, non-standard.
+ *
+ * @file        CO_storageEmHistory.c
+ * @author      J-Weisberg
+ * @copyright   2026 J-Weisberg
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string.h>
+
+#include "storage/CO_storageEmHistory.h"
+#include "301/crc16-ccitt.h"
+
+#if ((CO_CONFIG_STORAGE) & CO_CONFIG_STORAGE_ENABLE) \
+    && ((CO_CONFIG_EM) & CO_CONFIG_EM_HISTORY_STORE)
+
+#if !((CO_CONFIG_CRC16) & CO_CONFIG_CRC16_ENABLE)
+#error CO_CONFIG_CRC16_ENABLE must be enabled for error history storage!
+#endif
+#if CO_CONFIG_STORAGE_EM_HISTORY_BATCH < 1 \
+    || CO_CONFIG_STORAGE_EM_HISTORY_BATCH > 255
+#error CO_CONFIG_STORAGE_EM_HISTORY_BATCH is not correct!
+#endif
+
+/* Record layout: seq (4 bytes), msg (4), info (4), type (1), 0xFF (1) and
+ * CRC16 of the previous bytes (2). Erased record is all 0xFF. */
+#define REC_SEQ 0
+#define REC_MSG 4
+#define REC_INFO 8
+#define REC_TYPE 12
+#define REC_CRC 14
+
+#define REC_TYPE_ENTRY 0x01U
+#define REC_TYPE_CLEAR 0x02U
+
+typedef enum {
+    REC_EMPTY,
+    REC_VALID,
+    REC_INVALID
+} recState_t;
+
+
+/* Verify record read from the storage */
+static recState_t recordState(const uint8_t *rec) {
+    bool_t empty = true;
+
+    for (uint8_t i = 0; i < CO_STORAGE_EM_HISTORY_RECORD_SIZE; i++) {
+        if (rec[i] != 0xFF) {
+            empty = false;
+            break;
+        }
+    }
+    if (empty) {
+        return REC_EMPTY;
+    }
+    if (CO_getUint16(&rec[REC_CRC]) != crc16_ccitt(rec, REC_CRC, 0)
+        || (rec[REC_TYPE] != REC_TYPE_ENTRY && rec[REC_TYPE] != REC_TYPE_CLEAR)
+    ) {
+        return REC_INVALID;
+    }
+    return REC_VALID;
+}
+
+
+/* Read one record from the storage. Return false on hardware error. */
+static bool_t recordRead(CO_storageEmHist_t *hist,
+                         uint16_t sector, uint16_t record, uint8_t *rec)
+{
+    size_t addr = hist->regionAddr + hist->sectorSize * sector
+                  + (size_t)CO_STORAGE_EM_HISTORY_RECORD_SIZE * record;
+
+    if (!hist->read(hist->storageModule, addr, rec,
+                    CO_STORAGE_EM_HISTORY_RECORD_SIZE)
+    ) {
+        hist->hwError = true;
+        return false;
+    }
+    return true;
+}
+
+
+/* Move position to the previous record in the region */
+static void positionPrev(CO_storageEmHist_t *hist,
+                         uint16_t *sector, uint16_t *record)
+{
+    if (*record > 0) {
+        (*record)--;
+    }
+    else {
+        *sector = (*sector > 0) ? (*sector - 1U) : (hist->sectorCount - 1U);
+        *record = hist->sectorRecords - 1U;
+    }
+}
+
+
+/* Move position to the next record in the region */
+static void positionNext(CO_storageEmHist_t *hist,
+                         uint16_t *sector, uint16_t *record)
+{
+    if (++(*record) >= hist->sectorRecords) {
+        *record = 0;
+        if (++(*sector) >= hist->sectorCount) {
+            *sector = 0;
+        }
+    }
+}
+
+
+/* Add record into the batch */
+static void batchAdd(CO_storageEmHist_t *hist,
+                     uint8_t type, uint32_t msg, uint32_t info)
+{
+    if (hist->batchCount >= CO_CONFIG_STORAGE_EM_HISTORY_BATCH) {
+        hist->lost++;
+        return;
+    }
+
+    uint8_t *rec = hist->batch[hist->batchCount];
+
+    if (hist->batchCount == 0) {
+        hist->batchTimer_us = 0;
+    }
+    CO_setUint32(&rec[REC_SEQ], hist->seq++);
+    CO_setUint32(&rec[REC_MSG], msg);
+    CO_setUint32(&rec[REC_INFO], info);
+    rec[REC_TYPE] = type;
+    rec[REC_TYPE + 1] = 0xFF;
+    CO_setUint16(&rec[REC_CRC], crc16_ccitt(rec, REC_CRC, 0));
+    hist->batchCount++;
+}
+
+
+/* Callbacks from CO_EM_process() and OD object 0x1003 */
+static void historyAppend(void *object, uint32_t msg, uint32_t info) {
+    batchAdd((CO_storageEmHist_t *)object, REC_TYPE_ENTRY, msg, info);
+}
+
+static void historyClear(void *object) {
+    batchAdd((CO_storageEmHist_t *)object, REC_TYPE_CLEAR, 0, 0);
+}
+
+
+/******************************************************************************/
+CO_ReturnError_t CO_storageEmHist_init(CO_storageEmHist_t *hist,
+                                       void *storageModule,
+                                       bool_t (*read)(void *storageModule,
+                                                      size_t addr,
+                                                      uint8_t *buf,
+                                                      size_t len),
+                                       bool_t (*write)(void *storageModule,
+                                                       size_t addr,
+                                                       const uint8_t *buf,
+                                                       size_t len),
+                                       bool_t (*erase)(void *storageModule,
+                                                       size_t addr,
+                                                       size_t len),
+                                       size_t regionAddr,
+                                       size_t sectorSize,
+                                       uint16_t sectorCount,
+                                       uint16_t flushDelay_ms)
+{
+    uint8_t rec[CO_STORAGE_EM_HISTORY_RECORD_SIZE];
+    size_t sectorRecords = sectorSize / CO_STORAGE_EM_HISTORY_RECORD_SIZE;
+
+    /* verify arguments */
+    if (hist == NULL || read == NULL || write == NULL || erase == NULL
+        || (sectorSize % CO_STORAGE_EM_HISTORY_RECORD_SIZE) != 0
+        || sectorRecords < 2 || sectorRecords > 0xFFFFU || sectorCount < 2
+    ) {
+        return CO_ERROR_ILLEGAL_ARGUMENT;
+    }
+
+    memset(hist, 0, sizeof(CO_storageEmHist_t));
+    hist->storageModule = storageModule;
+    hist->read = read;
+    hist->write = write;
+    hist->erase = erase;
+    hist->regionAddr = regionAddr;
+    hist->sectorSize = sectorSize;
+    hist->sectorCount = sectorCount;
+    hist->sectorRecords = (uint16_t)sectorRecords;
+    hist->flushDelay_us = (uint32_t)flushDelay_ms * 1000U;
+
+    /* newest sector has the highest sequence number in the first record */
+    bool_t found = false;
+    uint32_t seqMax = 0;
+    for (uint16_t s = 0; s < sectorCount; s++) {
+        if (!recordRead(hist, s, 0, rec)) {
+            return CO_ERROR_DATA_CORRUPT;
+        }
+        uint32_t seq = CO_getUint32(&rec[REC_SEQ]);
+        if (recordState(rec) == REC_VALID && (!found || seq > seqMax)) {
+            found = true;
+            seqMax = seq;
+            hist->sector = s;
+        }
+    }
+
+    if (!found) {
+        /* empty or unknown storage */
+        hist->sector = 0;
+        hist->record = 0;
+        hist->seq = 1;
+        hist->eraseNeeded = true;
+        return CO_ERROR_NO;
+    }
+
+    /* next record is behind the last written one, also if it is corrupt */
+    uint16_t last = 0;
+    for (uint16_t r = hist->sectorRecords - 1U; r > 0; r--) {
+        if (!recordRead(hist, hist->sector, r, rec)) {
+            return CO_ERROR_DATA_CORRUPT;
+        }
+        if (recordState(rec) != REC_EMPTY) {
+            last = r;
+            break;
+        }
+    }
+    for (uint16_t r = 1; r <= last; r++) {
+        if (!recordRead(hist, hist->sector, r, rec)) {
+            return CO_ERROR_DATA_CORRUPT;
+        }
+        uint32_t seq = CO_getUint32(&rec[REC_SEQ]);
+        if (recordState(rec) == REC_VALID && seq > seqMax) {
+            seqMax = seq;
+        }
+    }
+    hist->seq = seqMax + 1U;
+    hist->record = last;
+    positionNext(hist, &hist->sector, &hist->record);
+    hist->eraseNeeded = hist->record == 0;
+
+    return CO_ERROR_NO;
+}
+
+
+/******************************************************************************/
+uint16_t CO_storageEmHist_restore(CO_storageEmHist_t *hist, CO_EM_t *em) {
+    uint8_t rec[CO_STORAGE_EM_HISTORY_RECORD_SIZE];
+    uint16_t restored = 0;
+    uint16_t count = 0;
+
+    if (hist == NULL || em == NULL) {
+        return 0;
+    }
+
+    /* records after the last clear record in the batch */
+    uint8_t batchFirst = 0;
+    for (uint8_t i = 0; i < hist->batchCount; i++) {
+        if (hist->batch[i][REC_TYPE] == REC_TYPE_CLEAR) {
+            batchFirst = i + 1U;
+        }
+    }
+
+    /* Walk back from the newest record in the storage and count valid
+     * entries. Stop at the empty or clear record, at older part of the
+     * region or if history is full. */
+    uint16_t sector = hist->sector;
+    uint16_t record = hist->record;
+    uint32_t steps = (uint32_t)hist->sectorCount * hist->sectorRecords;
+    uint32_t seqPrev = hist->seq;
+
+    while (batchFirst == 0 && !hist->hwError && em->fifoSize >= 2
+           && count < (em->fifoSize - 1U) && steps-- > 0
+    ) {
+        positionPrev(hist, &sector, &record);
+        if (!recordRead(hist, sector, record, rec)) {
+            break;
+        }
+        recState_t state = recordState(rec);
+        uint32_t seq = CO_getUint32(&rec[REC_SEQ]);
+
+        if (state == REC_INVALID) {
+            continue;
+        }
+        if (state == REC_EMPTY || seq >= seqPrev
+            || rec[REC_TYPE] == REC_TYPE_CLEAR
+        ) {
+            positionNext(hist, &sector, &record);
+            break;
+        }
+        seqPrev = seq;
+        count++;
+    }
+
+    /* put entries into the history from the oldest one */
+    while (count > 0 && !hist->hwError) {
+        if (!recordRead(hist, sector, record, rec)) {
+            break;
+        }
+        if (recordState(rec) == REC_VALID) {
+            if (CO_EM_historyRestore(em, CO_getUint32(&rec[REC_MSG]),
+                                     CO_getUint32(&rec[REC_INFO]))
+            ) {
+                restored++;
+            }
+            count--;
+        }
+        positionNext(hist, &sector, &record);
+    }
+    for (uint8_t i = batchFirst; i < hist->batchCount; i++) {
+        if (CO_EM_historyRestore(em, CO_getUint32(&hist->batch[i][REC_MSG]),
+                                 CO_getUint32(&hist->batch[i][REC_INFO]))
+        ) {
+            restored++;
+        }
+    }
+
+    CO_EM_initHistoryStore(em, hist, historyAppend, historyClear);
+
+    return restored;
+}
+
+
+/******************************************************************************/
+void CO_storageEmHist_process(CO_storageEmHist_t *hist,
+                              uint32_t timeDifference_us,
+                              bool_t flushAll)
+{
+    if (hist == NULL || hist->hwError || hist->batchCount == 0) {
+        return;
+    }
+
+    hist->batchTimer_us += timeDifference_us;
+    if (!flushAll && hist->batchCount < CO_CONFIG_STORAGE_EM_HISTORY_BATCH
+        && hist->batchTimer_us < hist->flushDelay_us
+    ) {
+        return;
+    }
+
+    do {
+        size_t sectorAddr = hist->regionAddr + hist->sectorSize * hist->sector;
+
+        if (hist->eraseNeeded) {
+            /* the oldest records are erased, when sector is entered */
+            if (!hist->erase(hist->storageModule, sectorAddr,
+                             hist->sectorSize)
+            ) {
+                hist->hwError = true;
+                return;
+            }
+            hist->eraseNeeded = false;
+            hist->erases++;
+            continue;
+        }
+
+        /* write as many records as fit into the sector */
+        uint16_t n = hist->sectorRecords - hist->record;
+        if (n > hist->batchCount) {
+            n = hist->batchCount;
+        }
+        if (!hist->write(hist->storageModule,
+                         sectorAddr + (size_t)CO_STORAGE_EM_HISTORY_RECORD_SIZE
+                                      * hist->record,
+                         hist->batch[0],
+                         (size_t)CO_STORAGE_EM_HISTORY_RECORD_SIZE * n)
+        ) {
+            hist->hwError = true;
+            return;
+        }
+        hist->writes++;
+        hist->batchCount -= (uint8_t)n;
+        memmove(hist->batch[0], hist->batch[n],
+                (size_t)CO_STORAGE_EM_HISTORY_RECORD_SIZE * hist->batchCount);
+
+        hist->record += n;
+        if (hist->record >= hist->sectorRecords) {
+            hist->record = 0;
+            if (++hist->sector >= hist->sectorCount) {
+                hist->sector = 0;
+            }
+            hist->eraseNeeded = true;
+        }
+    } while (flushAll && hist->batchCount > 0);
+}
+
+
+/******************************************************************************/
+ODR_t CO_storageEmHist_store(CO_storage_entry_t *entry,
+                             CO_CANmodule_t *CANmodule)
+{
+    (void)CANmodule;
+    if (entry == NULL || entry->addr == NULL) {
+        return ODR_DEV_INCOMPAT;
+    }
+
+    CO_storageEmHist_t *hist = (CO_storageEmHist_t *)entry->addr;
+
+    CO_storageEmHist_process(hist, 0, true);
+    return (hist->hwError || hist->batchCount > 0) ? ODR_HW : ODR_OK;
+}
+
+
+/******************************************************************************/
+ODR_t CO_storageEmHist_restoreDefault(CO_storage_entry_t *entry,
+                                      CO_CANmodule_t *CANmodule)
+{
+    if (entry == NULL || entry->addr == NULL) {
+        return ODR_DEV_INCOMPAT;
+    }
+
+    /* make room for the clear record in the batch */
+    CO_storageEmHist_process((CO_storageEmHist_t *)entry->addr, 0, true);
+    historyClear(entry->addr);
+    return CO_storageEmHist_store(entry, CANmodule);
+}
+
+#endif /* (CO_CONFIG_STORAGE) & CO_CONFIG_STORAGE_ENABLE ... */
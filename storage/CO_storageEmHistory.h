@@ -0,0 +1,259 @@
+/**
+ * CANopen error history storage, non-standard.
+ *
+ * @file        CO_storageEmHistory.h
+ * @ingroup     CO_storage_emHistory
+ * @author      J-Weisberg
+ * @copyright   2026 J-Weisberg
+ *
+ * This file is part of CANopenNode, an opensource CANopen Stack.
+ * Project home page is <https://github.com/CANopenNode/CANopenNode>.
+ * For more information on CANopen see <http://www.can-cia.org/>.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CO_STORAGE_EM_HISTORY_H
+#define CO_STORAGE_EM_HISTORY_H
+
+#include "storage/CO_storage.h"
+#include "301/CO_Emergency.h"
+
+/* default configuration, see CO_config.h */
+#ifndef CO_CONFIG_STORAGE_EM_HISTORY_BATCH
+#define CO_CONFIG_STORAGE_EM_HISTORY_BATCH 8
+#endif
+
+#if (((CO_CONFIG_STORAGE) & CO_CONFIG_STORAGE_ENABLE) \
+     && ((CO_CONFIG_EM) & CO_CONFIG_EM_HISTORY_STORE)) || defined CO_DOXYGEN
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup CO_storage_emHistory Error history storage
+ * Persistent error history, OD object 0x1003, non-standard.
+ *
+ * @ingroup CO_CANopen_storage
+ * @{
+ *
+ * Error history from @ref CO_Emergency is kept in RAM and is lost on reset.
+ * This module writes each entry of the error history into the storage region
+ * and puts the history back into OD object 0x1003 after reset.
+ *
+ * Storage region is given by the application with the target specific read,
+ * write and erase functions. It is divided into sectors, which are erased
+ * separately, like in flash memory. Erased memory must read as 0xFF. Records
+ * of fixed size (@ref CO_STORAGE_EM_HISTORY_RECORD_SIZE) are only appended:
+ * - Each record contains sequence number, history entry and CRC16.
+ * - Records are written sequentially into the sector. When sector is full,
+ *   the next sector (with the oldest records) is erased and used. So each
+ *   sector is erased once per pass through the region.
+ * - Clearing the history (write 0 to 0x1003,00) appends a clear record.
+ *
+ * Entries are passed from CO_EM_process() by callback, which only copies the
+ * record into RAM batch of @ref CO_CONFIG_STORAGE_EM_HISTORY_BATCH records.
+ * CO_storageEmHist_process() writes the batch in one block, if it is full or
+ * if the flush delay has elapsed since the first record in the batch. Each
+ * call performs at most one sector erase or one block write. If batch is full
+ * before it is written, new records are counted as lost.
+ *
+ * On startup CO_storageEmHist_init() finds the newest sector by sequence
+ * numbers and the next free record in it. Record, which was partially written
+ * during power loss, has wrong CRC and is skipped. CO_storageEmHist_restore()
+ * must be called after each CO_CANopenInit(). It reads the newest records up
+ * to the last clear record and the size of the error history and puts them
+ * into OD object 0x1003.
+ *
+ * Error history may be registered in @ref CO_storage as one of the entries
+ * passed to CO_storage_init(), with entry->addr pointing to this object and
+ * entry->len set to its size. Records are appended by the module itself, so
+ * the entry is not stored as a block of RAM data. Instead, the target specific
+ * store and restore functions call CO_storageEmHist_store() and
+ * CO_storageEmHist_restoreDefault() for this entry. Recommended attributes
+ * are CO_storage_cmd | CO_storage_auto | CO_storage_restore.
+ */
+
+/** Size of one record in the storage */
+#define CO_STORAGE_EM_HISTORY_RECORD_SIZE 16U
+
+
+/**
+ * Error history storage object.
+ */
+typedef struct {
+    /** From CO_storageEmHist_init() */
+    void *storageModule;
+    /** From CO_storageEmHist_init() */
+    bool_t (*read)(void *storageModule, size_t addr,
+                   uint8_t *buf, size_t len);
+    /** From CO_storageEmHist_init() */
+    bool_t (*write)(void *storageModule, size_t addr,
+                    const uint8_t *buf, size_t len);
+    /** From CO_storageEmHist_init() */
+    bool_t (*erase)(void *storageModule, size_t addr, size_t len);
+    /** Address of the storage region, from CO_storageEmHist_init() */
+    size_t regionAddr;
+    /** Size of one sector, from CO_storageEmHist_init() */
+    size_t sectorSize;
+    /** Number of sectors, from CO_storageEmHist_init() */
+    uint16_t sectorCount;
+    /** Number of records in one sector */
+    uint16_t sectorRecords;
+    /** Sector, where the next record will be written */
+    uint16_t sector;
+    /** Position of the next record inside the sector */
+    uint16_t record;
+    /** True, if sector must be erased before the first record is written */
+    bool_t eraseNeeded;
+    /** True after read, write or erase function failed. Nothing is written
+     * any more. */
+    bool_t hwError;
+    /** Sequence number of the next record */
+    uint32_t seq;
+    /** Records, which are not yet written */
+    uint8_t batch[CO_CONFIG_STORAGE_EM_HISTORY_BATCH]
+                 [CO_STORAGE_EM_HISTORY_RECORD_SIZE];
+    /** Number of records in the batch */
+    uint8_t batchCount;
+    /** Time since the first record was added to the empty batch */
+    uint32_t batchTimer_us;
+    /** Flush delay, from CO_storageEmHist_init() */
+    uint32_t flushDelay_us;
+    /** Number of records, which were lost, because batch was full */
+    uint32_t lost;
+    /** Number of block writes */
+    uint32_t writes;
+    /** Number of sector erases */
+    uint32_t erases;
+} CO_storageEmHist_t;
+
+
+/**
+ * Initialize error history storage object.
+ *
+ * This function should be called by application after the program startup,
+ * before @ref CO_CANopenInit(). It finds the position of the next record in
+ * the storage region.
+ *
+ * @param hist This object will be initialized. It must be defined by
+ * application and must exist permanently.
+ * @param storageModule Pointer to storage module passed to the functions
+ * below.
+ * @param read Target specific function, which reads len bytes from the
+ * storage address addr into buf. Returns true on success.
+ * @param write Target specific function, which writes len bytes from buf into
+ * the erased storage at address addr. Returns true on success.
+ * @param erase Target specific function, which erases len bytes of the storage
+ * (one sector) at address addr to 0xFF. Returns true on success.
+ * @param regionAddr Address of the storage region, aligned to sector.
+ * @param sectorSize Size of one sector, multiple of
+ * @ref CO_STORAGE_EM_HISTORY_RECORD_SIZE, at least two records.
+ * @param sectorCount Number of sectors in the region, at least 2.
+ * @param flushDelay_ms Maximum time, records wait in RAM batch, if batch is
+ * not full.
+ *
+ * @return CO_ERROR_NO, CO_ERROR_ILLEGAL_ARGUMENT or CO_ERROR_DATA_CORRUPT, if
+ * storage can not be read.
+ */
+CO_ReturnError_t CO_storageEmHist_init(CO_storageEmHist_t *hist,
+                                       void *storageModule,
+                                       bool_t (*read)(void *storageModule,
+                                                      size_t addr,
+                                                      uint8_t *buf,
+                                                      size_t len),
+                                       bool_t (*write)(void *storageModule,
+                                                       size_t addr,
+                                                       const uint8_t *buf,
+                                                       size_t len),
+                                       bool_t (*erase)(void *storageModule,
+                                                       size_t addr,
+                                                       size_t len),
+                                       size_t regionAddr,
+                                       size_t sectorSize,
+                                       uint16_t sectorCount,
+                                       uint16_t flushDelay_ms);
+
+
+/**
+ * Restore error history and connect to Emergency object.
+ *
+ * Function must be called after each CO_CANopenInit(), before errors are
+ * reported. It puts the stored history and records from the batch into OD
+ * object 0x1003 with CO_EM_historyRestore() and initializes callbacks with
+ * CO_EM_initHistoryStore().
+ *
+ * @param hist This object.
+ * @param em Emergency object.
+ *
+ * @return Number of restored entries.
+ */
+uint16_t CO_storageEmHist_restore(CO_storageEmHist_t *hist, CO_EM_t *em);
+
+
+/**
+ * Write records from the batch into the storage.
+ *
+ * Should be called cyclically by program, from the same thread as
+ * CO_EM_process(). Each call performs at most one sector erase or one block
+ * write of the batch.
+ *
+ * @param hist This object.
+ * @param timeDifference_us Time difference from previous function call.
+ * @param flushAll If true, all records are written, useful on program end.
+ */
+void CO_storageEmHist_process(CO_storageEmHist_t *hist,
+                              uint32_t timeDifference_us,
+                              bool_t flushAll);
+
+
+/**
+ * Store the error history entry of @ref CO_storage.
+ *
+ * Called on write of 'save' into OD object 0x1010. All records from the batch
+ * are written into the storage immediately.
+ *
+ * @param entry Storage entry, entry->addr points to CO_storageEmHist_t.
+ * @param CANmodule Not used.
+ *
+ * @return ODR_OK or ODR_HW, if storage has failed.
+ */
+ODR_t CO_storageEmHist_store(CO_storage_entry_t *entry,
+                             CO_CANmodule_t *CANmodule);
+
+
+/**
+ * Restore default of the error history entry of @ref CO_storage.
+ *
+ * Called on write of 'load' into OD object 0x1011. Clear record is appended
+ * and written into the storage immediately, so history restored after the
+ * next reset is empty. Error history in OD object 0x1003 is not changed.
+ *
+ * @param entry Storage entry, entry->addr points to CO_storageEmHist_t.
+ * @param CANmodule Not used.
+ *
+ * @return ODR_OK or ODR_HW, if storage has failed.
+ */
+ODR_t CO_storageEmHist_restoreDefault(CO_storage_entry_t *entry,
+                                      CO_CANmodule_t *CANmodule);
+
+/** @} */ /* CO_storage_emHistory */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* (CO_CONFIG_STORAGE) & CO_CONFIG_STORAGE_ENABLE ... */
+
+#endif /* CO_STORAGE_EM_HISTORY_H */